@@ -3,6 +3,7 @@
 
 #include <rtthread.h>
 #include <rtdevice.h>
+#include "pv_sampler.h"
 
 #define VOLTAGE_REF         3300    // 参考电压 3.3V (mV)
 #define ADC_MAX_VALUE       65535   // 16位ADC最大值
@@ -17,27 +18,38 @@
  */
 static rt_uint32_t adc_read_average(rt_adc_device_t adc_dev, rt_uint8_t channel, rt_uint8_t count)
 {
-    rt_uint32_t sum = 0;
+    rt_uint32_t sum = 0, value = 0;
+    rt_uint8_t done = 0;
     if (adc_dev == RT_NULL || count == 0) {
         return 0;
     }
 
     /* 使能ADC通道 */
     rt_err_t result = rt_adc_enable(adc_dev, channel);
+    if (result == -RT_EBUSY) {
+        /* ADC1正被采样服务的扫描组占用, 改读其最新帧 (已滤波平均) */
+        if (pv_sampler_get_raw(channel, &value) != RT_EOK) {
+            rt_kprintf("Error: adc channel(%d) busy, no sampler frame!\n", channel);
+        }
+        return value;
+    }
     if (result != RT_EOK) {
         rt_kprintf("Error: enable adc channel(%d) failed!\n", channel);
         return 0;
     }
 
     for (int i = 0; i < count; i++) {
-        sum += rt_adc_read(adc_dev, channel);
+        if (rt_adc_convert(adc_dev, channel, &value) == RT_EOK) {
+            sum += value;
+            done++;
+        }
         rt_thread_mdelay(1); // 每次采样间隔1ms
     }
 
     /* 关闭ADC通道 */
     rt_adc_disable(adc_dev, channel);
 
-    return sum / count;
+    return done ? sum / done : 0;
 }
 
 /**
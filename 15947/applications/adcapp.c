@@ -2,7 +2,12 @@
 
 #include <rtthread.h>
 #include <rtdevice.h>
+#include <stdlib.h>
 #include "pv_diagnosis.h"
+#include "pv_sampler.h"
+#include "pv_stream.h"
+#include "pv_topology.h"
+#include "pv_cloud_config.h"
 
 /* 外部函数声明 - 故障检测模块 */
 extern void pv_fault_detector_init(void);
@@ -12,54 +17,150 @@ extern const char* pv_fault_get_multi_status_string(void);
 extern int pv_fault_get_count(void);
 extern void pv_fault_analyze_pattern(void);
 extern rt_bool_t pv_fault_is_baseline_ready(void);
+extern const pv_topology_t *pv_fault_topology(void);
+extern pv_panel_mask_t pv_fault_get_mask(void);
 
 /* ADC参数定义 */
-#define VOLTAGE_REF         3300    // 参考电压 3.3V (mV)
-#define ADC_MAX_VALUE       65535   // 16位ADC最大值
 #define READ_INTERVAL_MS    1000    // 读取间隔 (ms)
-#define SAMPLE_COUNT        19      // 采样次数 (取19次平均值)
-
-/* ADC1的正确通道号 */
-#define ADC1_CHANNEL_PA0    0       // PA0 -> ADC1_IN0 (实测验证)
-#define ADC1_CHANNEL_PA1    1       // PA1 -> ADC1_IN1 (实测验证)
-#define ADC1_CHANNEL_PB0    9       // PB0 -> ADC1_INP9 (P2 Pin38)
-#define ADC1_CHANNEL_PB1    5       // PB1 -> ADC1_INP5 (P2 Pin37)
-#define ADC1_CHANNEL_PA6    3       // PA6 -> ADC1_INP3 (P2 Pin23)
-#define ADC1_CHANNEL_PA7    7       // PA7 -> ADC1_INP7 (P2 Pin21)
 
 /* 全局变量 */
 rt_bool_t voltage_detection_enabled = RT_FALSE;  // 电压检测循环开关，初始关闭（全局可访问）
 
+/* 人类可读输出: 默认关闭, 打开后按最小间隔限速, 结果始终写入二进制遥测通道 */
+static rt_bool_t adc_human_enabled = PV_HUMAN_OUTPUT_DEFAULT;
+static rt_uint32_t adc_human_interval_ms = PV_HUMAN_INTERVAL_MS;
+static rt_tick_t adc_human_last = 0;
+
+/* 引脚名 (PV_SAMPLER_CH_* 顺序) */
+static const char *const adc_pin_names[PV_SAMPLER_CH_NUM] = { "PA0", "PA1", "PB0", "PB1", "PA6", "PA7" };
+
 /* 函数声明 */
 void adc_display_with_diagnosis(rt_uint32_t* adc_values, rt_uint32_t* voltages, pv_diagnosis_result_t* diag_result);
 
 /**
- * @brief 多次采样取平均值 (这个辅助函数很好，我们保留)
+ * @brief 从共享采样服务读取最新一帧 (数组下标顺序: PA0, PA1, PB0, PB1, PA6, PA7)
  */
-static rt_uint32_t adc_read_average(rt_adc_device_t adc_dev, rt_uint8_t channel, rt_uint8_t count)
+static rt_err_t adc_read_frame(rt_uint32_t* adc_values, rt_uint32_t* voltages)
 {
-    rt_uint32_t sum = 0;
-    if (adc_dev == RT_NULL || count == 0) {
-        return 0;
+    pv_sample_frame_t frame;
+
+    if (pv_sampler_read(&frame, PV_SAMPLER_READ_TIMEOUT_MS) != RT_EOK) {
+        return -RT_ERROR;
     }
 
-    /* 使能ADC通道 */
-    rt_err_t result = rt_adc_enable(adc_dev, channel);
-    if (result != RT_EOK)
-    {
-        rt_kprintf("Error: enable adc channel(%d) failed!\n", channel);
+    for (int i = 0; i < PV_SAMPLER_CH_NUM; i++) {
+        adc_values[i] = frame.raw[i];
+    }
+
+    voltages[PV_SAMPLER_CH_PA0] = frame.data.v_a1_mv;
+    voltages[PV_SAMPLER_CH_PA1] = frame.data.v_a2_mv;
+    voltages[PV_SAMPLER_CH_PB0] = frame.data.v_b1_mv;
+    voltages[PV_SAMPLER_CH_PB1] = frame.data.v_b2_mv;
+    voltages[PV_SAMPLER_CH_PA6] = frame.data.v_c1_mv;
+    voltages[PV_SAMPLER_CH_PA7] = frame.data.v_c2_mv;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 按拓扑计算每块板的电压, 拓扑表非法时全部为0
+ * @return 板数
+ */
+static int adc_panel_voltages(const rt_uint32_t* voltages, int32_t* panel_mv)
+{
+    const pv_topology_t *topo = pv_fault_topology();
+    int32_t channel_mv[PV_SAMPLER_CH_NUM];
+
+    if (topo == RT_NULL) {
         return 0;
     }
 
-    for (int i = 0; i < count; i++) {
-        sum += rt_adc_read(adc_dev, channel);
-        rt_thread_mdelay(1); // 每次采样间隔1ms
+    for (int i = 0; i < PV_SAMPLER_CH_NUM; i++) {
+        channel_mv[i] = (int32_t)voltages[i];
     }
+    pv_topology_panel_mv(topo, channel_mv, panel_mv);
 
-    /* 关闭ADC通道 */
-    rt_adc_disable(adc_dev, channel);
+    return topo->panels;
+}
+
+/**
+ * @brief 按组串、抽头深度排列通道显示顺序, 未接通道排在最后
+ * @return 通道数
+ */
+static int adc_display_order(const pv_topology_t *topo, int order[PV_SAMPLER_CH_NUM])
+{
+    int n = 0;
 
-    return sum / count;
+    for (int s = 0; s < topo->strings; s++) {
+        for (int d = 1; d <= topo->string_panels[s]; d++) {
+            for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+                if (topo->channel_depth[ch] == d && topo->channel_string[ch] == s) {
+                    order[n++] = ch;
+                }
+            }
+        }
+    }
+    for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+        if (topo->channel_depth[ch] == 0) {
+            order[n++] = ch;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief 人类可读输出是否到期 (到期时更新时间戳)
+ */
+static rt_bool_t adc_human_due(void)
+{
+    rt_tick_t now = rt_tick_get();
+
+    if (!adc_human_enabled) {
+        return RT_FALSE;
+    }
+    if (adc_human_last != 0 && now - adc_human_last < rt_tick_from_millisecond(adc_human_interval_ms)) {
+        return RT_FALSE;
+    }
+    adc_human_last = now;
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief 把一次检测结果写入二进制遥测通道, 每 PV_STREAM_DIAG_GROUP 块板一条记录
+ */
+static void adc_stream_diag(const int32_t *pv_mv, int panels, int fault_code, int fault_count)
+{
+    pv_stream_diag_t diag;
+    pv_panel_mask_t fault_mask;
+    rt_uint8_t flags;
+
+    if (!pv_stream_running()) {
+        return;
+    }
+
+    fault_mask = pv_fault_get_mask();
+    flags = pv_fault_is_baseline_ready() ? PV_STREAM_DIAG_BASELINE_READY : 0;
+
+    for (int first = 0; first < panels; first += PV_STREAM_DIAG_GROUP) {
+        rt_memset(&diag, 0, sizeof(diag));
+        diag.first_panel = (rt_uint8_t)first;
+        diag.panel_count = (rt_uint8_t)((panels - first < PV_STREAM_DIAG_GROUP) ? panels - first
+                                                                             : PV_STREAM_DIAG_GROUP);
+        diag.panels = (rt_uint8_t)panels;
+        diag.flags = flags;
+        diag.fault_code = (rt_uint8_t)fault_code;
+        diag.fault_count = (rt_uint8_t)fault_count;
+        diag.fault_mask = (rt_uint8_t)(fault_mask >> first);
+        for (int i = 0; i < diag.panel_count; i++) {
+            int32_t mv = pv_mv[first + i];
+            /* 超出 int16 的读数按饱和处理, 不回绕 */
+            diag.pv_mv[i] = (rt_int16_t)(mv > 32767 ? 32767 : (mv < -32768 ? -32768 : mv));
+        }
+
+        pv_stream_push(PV_STREAM_REC_DIAG, &diag, sizeof(diag));
+    }
 }
 
 /**
@@ -70,21 +171,15 @@ static void adc_thread_entry(void *parameter)
     rt_uint32_t adc_values[6];
     rt_uint32_t voltages[6];
 
-    /* 查找ADC设备句柄 */
-    rt_adc_device_t adc1_dev = (rt_adc_device_t)rt_device_find("adc1");
-
-    /* 检查设备是否找到 */
-    if (adc1_dev == RT_NULL) {
-        rt_kprintf("Warning: rt_device_find('adc1') failed.\n");
+    /* 启动共享采样服务 */
+    if (pv_sampler_start() != RT_EOK) {
+        rt_kprintf("Warning: PV sampler start failed.\n");
         return;
     }
 
     rt_kprintf("ADC monitoring thread started. Reading every %dms.\n", READ_INTERVAL_MS);
     rt_kprintf("📌 Voltage detection is DISABLED by default. Use 'Enable_Voltage_Detection' to start.\n");
-    rt_kprintf("--------------------------------------------------------------------\n");
-    rt_kprintf(" Pin |  Raw ADC Value | Voltage \n");
-    rt_kprintf("--------------------------------------------------------------------\n");
-
+    rt_kprintf("📌 Results go to 'pv_stream_start'; use 'adc_human on' for console tables.\n");
 
     /* 主循环 */
     while (1)
@@ -92,17 +187,10 @@ static void adc_thread_entry(void *parameter)
         /* 检查电压检测是否启用 */
         if (voltage_detection_enabled)
         {
-            /* 读取ADC1的六个通道 */
-            adc_values[0] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA0, SAMPLE_COUNT);
-            adc_values[1] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA1, SAMPLE_COUNT);
-            adc_values[2] = adc_read_average(adc1_dev, ADC1_CHANNEL_PB0, SAMPLE_COUNT);
-            adc_values[3] = adc_read_average(adc1_dev, ADC1_CHANNEL_PB1, SAMPLE_COUNT);
-            adc_values[4] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA6, SAMPLE_COUNT);
-            adc_values[5] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA7, SAMPLE_COUNT);
-
-            /* 转换为电压值 */
-            for (int i = 0; i < 6; i++) {
-                voltages[i] = (adc_values[i] * VOLTAGE_REF) / ADC_MAX_VALUE;
+            /* 读取ADC1六个通道的最新一帧 */
+            if (adc_read_frame(adc_values, voltages) != RT_EOK) {
+                rt_thread_mdelay(READ_INTERVAL_MS);
+                continue;
             }
 
             /* 原有故障检测 */
@@ -113,23 +201,40 @@ static void adc_thread_entry(void *parameter)
             int fault_code = pv_fault_detection_run();
             const char* fault_status = pv_fault_get_status_string();
 
+            /* 计算独立光伏板电压 (映射关系见 pv_cloud_config.h 中的 PV_TOPO_*) */
+            int32_t pv_mv[PV_TOPO_MAX_PANELS];
+            int panels = adc_panel_voltages(voltages, pv_mv);
+
+            int fault_count = pv_fault_get_count();
+
+            /* 结果写入二进制通道, 不做格式化 */
+            adc_stream_diag(pv_mv, panels, fault_code, fault_count);
+
+            if (!adc_human_due()) {
+                rt_thread_mdelay(READ_INTERVAL_MS);
+                continue;
+            }
+
             /* 显示格式化的结果，带异常标注 */
+            rt_kprintf("--------------------------------------------------------------------\n");
+            rt_kprintf(" Pin |  Raw ADC Value | Voltage \n");
+            rt_kprintf("--------------------------------------------------------------------\n");
             adc_display_with_diagnosis(adc_values, voltages, &diag_result);
 
-            /* 计算并显示独立光伏板电压 */
-            int pv1 = voltages[0];                          // PV1 = va1
-            int pv2 = voltages[1] - voltages[0];            // PV2 = va2 - va1
-            int pv3 = voltages[4] - voltages[1];            // PV3 = va3 - va2 (va3是voltages[4])
-            int pv4 = voltages[5];                          // PV4 = vb1 (vb1是voltages[5])
-            int pv5 = voltages[2] - voltages[5];            // PV5 = vb2 - vb1 (vb2是voltages[2])
-            int pv6 = voltages[3] - voltages[2];            // PV6 = vb3 - vb2 (vb3是voltages[3])
-
-            rt_kprintf("Individual PV: PV1=%dmV PV2=%dmV PV3=%dmV | PV4=%dmV PV5=%dmV PV6=%dmV\n",
-                       pv1, pv2, pv3, pv4, pv5, pv6);
+            const pv_topology_t *topo = pv_fault_topology();
+            rt_kprintf("Individual PV:");
+            for (int s = 0; panels > 0 && s < topo->strings; s++) {
+                if (s > 0) {
+                    rt_kprintf(" |");
+                }
+                for (int i = topo->string_first[s]; i < topo->string_first[s] + topo->string_panels[s]; i++) {
+                    rt_kprintf(" PV%d=%dmV", i + 1, pv_mv[i]);
+                }
+            }
+            rt_kprintf("\n");
 
             /* 显示高级故障检测结果 */
             const char* multi_status = pv_fault_get_multi_status_string();
-            int fault_count = pv_fault_get_count();
 
             if (pv_fault_is_baseline_ready()) {
                 if (fault_code != 0) {  // 0 = PV_FAULT_NONE
@@ -175,7 +280,7 @@ int adc_start(void)
     adc_thread = rt_thread_create("adc_reader",      // 线程名
                                   adc_thread_entry,  // 线程入口
                                   RT_NULL,           // 参数
-                                  2048,              // 栈大小
+                                  3072,              // 栈大小
                                   25,                // 优先级
                                   10);               // 时间片
 
@@ -196,28 +301,18 @@ int adc_start(void)
  */
 rt_err_t adc_get_pv_data(pv_adc_data_t* data)
 {
-    rt_adc_device_t adc1_dev = (rt_adc_device_t)rt_device_find("adc1");
+    pv_sample_frame_t frame;
 
-    if (adc1_dev == RT_NULL || data == RT_NULL) {
+    if (data == RT_NULL) {
         return -RT_ERROR;
     }
 
-    /* 读取六个ADC通道并转换为电压值 */
-    rt_uint32_t adc_values[6];
-    adc_values[0] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA0, SAMPLE_COUNT);
-    adc_values[1] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA1, SAMPLE_COUNT);
-    adc_values[2] = adc_read_average(adc1_dev, ADC1_CHANNEL_PB0, SAMPLE_COUNT);
-    adc_values[3] = adc_read_average(adc1_dev, ADC1_CHANNEL_PB1, SAMPLE_COUNT);
-    adc_values[4] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA6, SAMPLE_COUNT);
-    adc_values[5] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA7, SAMPLE_COUNT);
-
-    /* 转换为电压值 (mV) */
-    data->v_a1_mv = (adc_values[0] * VOLTAGE_REF) / ADC_MAX_VALUE;
-    data->v_a2_mv = (adc_values[1] * VOLTAGE_REF) / ADC_MAX_VALUE;
-    data->v_b1_mv = (adc_values[2] * VOLTAGE_REF) / ADC_MAX_VALUE;
-    data->v_b2_mv = (adc_values[3] * VOLTAGE_REF) / ADC_MAX_VALUE;
-    data->v_c1_mv = (adc_values[4] * VOLTAGE_REF) / ADC_MAX_VALUE;
-    data->v_c2_mv = (adc_values[5] * VOLTAGE_REF) / ADC_MAX_VALUE;
+    /* 直接返回共享采样服务的最新一帧, 不再单独占用ADC */
+    if (pv_sampler_read(&frame, PV_SAMPLER_READ_TIMEOUT_MS) != RT_EOK) {
+        return -RT_ERROR;
+    }
+
+    *data = frame.data;
 
     return RT_EOK;
 }
@@ -230,76 +325,39 @@ rt_err_t adc_get_pv_data(pv_adc_data_t* data)
  */
 void adc_display_with_diagnosis(rt_uint32_t* adc_values, rt_uint32_t* voltages, pv_diagnosis_result_t* diag_result)
 {
-    /* 检查每个面板是否有故障 */
-    rt_bool_t panel_faults[7] = {RT_FALSE}; // 索引1-6对应Panel 1-6
-
-    if (diag_result->fault_count > 0) {
-        for (int i = 0; i < diag_result->fault_count; i++) {
-            int panel_num = diag_result->faulty_panels[i];
-            if (panel_num >= 1 && panel_num <= 6) {
-                panel_faults[panel_num] = RT_TRUE;
-            }
-        }
-    }
-
-    /* 根据面板故障情况确定通道异常标注 */
-    rt_bool_t channel_abnormal[6] = {RT_FALSE};
-
-    // PA0 (va1): PV1 - 如果PV1故障则标注异常
-    if (panel_faults[1]) {
-        channel_abnormal[0] = RT_TRUE;
-    }
-
-    // PA1 (va2): PV1+PV2 - 如果PV1或PV2故障则标注异常
-    if (panel_faults[1] || panel_faults[2]) {
-        channel_abnormal[1] = RT_TRUE;
+    const pv_topology_t *topo = pv_fault_topology();
+    pv_panel_mask_t panel_faults = 0;
+    pv_panel_mask_t channel_abnormal;
+    int order[PV_SAMPLER_CH_NUM];
+    int count;
+    char label[32];
+
+    if (topo == RT_NULL) {
+        return;
     }
 
-    // PA6 (va3): PV1+PV2+PV3 - 如果PV1、PV2或PV3故障则标注异常
-    if (panel_faults[1] || panel_faults[2] || panel_faults[3]) {
-        channel_abnormal[4] = RT_TRUE;  // PA6是adc_values[4]
+    /* 检查每个面板是否有故障 */
+    for (int i = 0; i < diag_result->fault_count; i++) {
+        int panel_num = diag_result->faulty_panels[i];
+        if (panel_num >= 1 && panel_num <= topo->panels) {
+            panel_faults |= (pv_panel_mask_t)1 << (panel_num - 1);
+        }
     }
 
-    // PA7 (vb1): PV4 - 如果PV4故障则标注异常
-    if (panel_faults[4]) {
-        channel_abnormal[5] = RT_TRUE;  // PA7是adc_values[5]
-    }
+    /* 读数包含故障板的通道标注异常 */
+    channel_abnormal = pv_topology_abnormal_channels(topo, panel_faults);
 
-    // PB0 (vb2): PV4+PV5 - 如果PV4或PV5故障则标注异常
-    if (panel_faults[4] || panel_faults[5]) {
-        channel_abnormal[2] = RT_TRUE;  // PB0是adc_values[2]
-    }
+    /* 显示格式化的结果 - 按组串和测量点顺序 */
+    count = adc_display_order(topo, order);
+    for (int i = 0; i < count; i++) {
+        int ch = order[i];
 
-    // PB1 (vb3): PV4+PV5+PV6 - 如果PV4、PV5或PV6故障则标注异常
-    if (panel_faults[4] || panel_faults[5] || panel_faults[6]) {
-        channel_abnormal[3] = RT_TRUE;  // PB1是adc_values[3]
+        pv_topology_channel_label(topo, ch, label, sizeof(label));
+        rt_kprintf(" %s | %14d | %4dmV  [%s]%s\n",
+                   adc_pin_names[ch], adc_values[ch], voltages[ch], label,
+                   (channel_abnormal & ((pv_panel_mask_t)1 << ch)) ? " (abnormality)" : "");
     }
 
-    /* 显示格式化的结果 - 按照正确的光伏板测量点逻辑 */
-    rt_kprintf(" PA0 | %14d | %4dmV  [va1: PV1]%s\n",
-               adc_values[0], voltages[0],
-               channel_abnormal[0] ? " (abnormality)" : "");
-
-    rt_kprintf(" PA1 | %14d | %4dmV  [va2: PV1+PV2]%s\n",
-               adc_values[1], voltages[1],
-               channel_abnormal[1] ? " (abnormality)" : "");
-
-    rt_kprintf(" PA6 | %14d | %4dmV  [va3: PV1+PV2+PV3]%s\n",
-               adc_values[4], voltages[4],
-               channel_abnormal[4] ? " (abnormality)" : "");
-
-    rt_kprintf(" PA7 | %14d | %4dmV  [vb1: PV4]%s\n",
-               adc_values[5], voltages[5],
-               channel_abnormal[5] ? " (abnormality)" : "");
-
-    rt_kprintf(" PB0 | %14d | %4dmV  [vb2: PV4+PV5]%s\n",
-               adc_values[2], voltages[2],
-               channel_abnormal[2] ? " (abnormality)" : "");
-
-    rt_kprintf(" PB1 | %14d | %4dmV  [vb3: PV4+PV5+PV6]%s\n",
-               adc_values[3], voltages[3],
-               channel_abnormal[3] ? " (abnormality)" : "");
-
     rt_kprintf("--------------------------------------------------------------------\n");
 
     /* 如果检测到故障，显示故障摘要 */
@@ -328,37 +386,28 @@ void adc_pv_integration_init(void)
  */
 int adc_pv_snapshot(void)
 {
-    rt_adc_device_t adc1_dev = (rt_adc_device_t)rt_device_find("adc1");
-
-    if (adc1_dev == RT_NULL) {
-        rt_kprintf("Error: ADC1 device not found\n");
-        return -1;
-    }
-
     /* 读取ADC数据 */
+    const pv_topology_t *topo = pv_fault_topology();
     rt_uint32_t adc_values[6];
     rt_uint32_t voltages[6];
+    int order[PV_SAMPLER_CH_NUM];
+    int count;
+    char label[32];
 
-    adc_values[0] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA0, SAMPLE_COUNT);
-    adc_values[1] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA1, SAMPLE_COUNT);
-    adc_values[2] = adc_read_average(adc1_dev, ADC1_CHANNEL_PB0, SAMPLE_COUNT);
-    adc_values[3] = adc_read_average(adc1_dev, ADC1_CHANNEL_PB1, SAMPLE_COUNT);
-    adc_values[4] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA6, SAMPLE_COUNT);
-    adc_values[5] = adc_read_average(adc1_dev, ADC1_CHANNEL_PA7, SAMPLE_COUNT);
-
-    /* 转换为电压值 */
-    for (int i = 0; i < 6; i++) {
-        voltages[i] = (adc_values[i] * VOLTAGE_REF) / ADC_MAX_VALUE;
+    if (adc_read_frame(adc_values, voltages) != RT_EOK) {
+        rt_kprintf("Error: ADC1 sample not available\n");
+        return -1;
     }
 
-    /* 显示ADC数据 - 按照正确的光伏板测量点逻辑 */
+    /* 显示ADC数据 - 按组串和测量点顺序 */
     rt_kprintf("\n=== ADC Snapshot ===\n");
-    rt_kprintf("PA0: %5d (%4dmV) [va1: PV1]\n", adc_values[0], voltages[0]);
-    rt_kprintf("PA1: %5d (%4dmV) [va2: PV1+PV2]\n", adc_values[1], voltages[1]);
-    rt_kprintf("PA6: %5d (%4dmV) [va3: PV1+PV2+PV3]\n", adc_values[4], voltages[4]);
-    rt_kprintf("PA7: %5d (%4dmV) [vb1: PV4]\n", adc_values[5], voltages[5]);
-    rt_kprintf("PB0: %5d (%4dmV) [vb2: PV4+PV5]\n", adc_values[2], voltages[2]);
-    rt_kprintf("PB1: %5d (%4dmV) [vb3: PV4+PV5+PV6]\n", adc_values[3], voltages[3]);
+    count = (topo != RT_NULL) ? adc_display_order(topo, order) : 0;
+    for (int i = 0; i < count; i++) {
+        int ch = order[i];
+
+        pv_topology_channel_label(topo, ch, label, sizeof(label));
+        rt_kprintf("%s: %5d (%4dmV) [%s]\n", adc_pin_names[ch], adc_values[ch], voltages[ch], label);
+    }
 
     /* 执行PV诊断 */
     pv_diagnosis_result_t result;
@@ -437,6 +486,8 @@ int voltage_detection_status(void)
     rt_kprintf("\n=== Voltage Detection Status ===\n");
     rt_kprintf("Status: %s\n", voltage_detection_enabled ? "✅ Enabled" : "❌ Disabled");
     rt_kprintf("Update Interval: %d ms\n", READ_INTERVAL_MS);
+    rt_kprintf("Console Tables: %s (every %d ms)\n", adc_human_enabled ? "On" : "Off", adc_human_interval_ms);
+    rt_kprintf("Binary Stream: %s\n", pv_stream_running() ? "Running" : "Stopped");
     rt_kprintf("Channels: PA0, PA1, PB0, PB1, PA6, PA7\n");
     rt_kprintf("PV Diagnosis: %s\n", voltage_detection_enabled ? "Active" : "Inactive");
     rt_kprintf("===============================\n");
@@ -444,9 +495,33 @@ int voltage_detection_status(void)
     return 0;
 }
 
+/**
+ * @brief 打开/关闭人类可读的控制台表格
+ * 用法: adc_human <on|off> [interval_ms]
+ */
+static int adc_human(int argc, char **argv)
+{
+    if (argc < 2) {
+        rt_kprintf("Usage: adc_human <on|off> [interval_ms]\n");
+        rt_kprintf("Console tables: %s, every %d ms\n", adc_human_enabled ? "on" : "off", adc_human_interval_ms);
+        return 0;
+    }
+
+    adc_human_enabled = (rt_strcmp(argv[1], "on") == 0);
+    if (argc > 2 && atoi(argv[2]) > 0) {
+        adc_human_interval_ms = atoi(argv[2]);
+    }
+    adc_human_last = 0;
+
+    rt_kprintf("Console tables %s (every %d ms)\n", adc_human_enabled ? "enabled" : "disabled", adc_human_interval_ms);
+
+    return 0;
+}
+
 /* 导出到MSH命令 */
 MSH_CMD_EXPORT(adc_start, Start ADC value monitoring);
 MSH_CMD_EXPORT(adc_pv_snapshot, Take ADC snapshot and run PV diagnosis);
 MSH_CMD_EXPORT_ALIAS(enable_voltage_detection, Enable_Voltage_Detection, Enable voltage detection loop);
 MSH_CMD_EXPORT_ALIAS(disable_voltage_sense, Disable_Voltage_Sense, Disable voltage detection loop);
 MSH_CMD_EXPORT(voltage_detection_status, Show voltage detection status);
+MSH_CMD_EXPORT(adc_human, Enable rate-limited console tables: adc_human <on|off> [interval_ms]);
@@ -0,0 +1,32 @@
+/* applications/host/fal.h */
+/* FAL 分区接口的主机替身, 分区数据在 fal_mock.c 提供的内存中 */
+
+#ifndef FAL_H
+#define FAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FAL_DEV_NAME_MAX    24
+
+struct fal_partition {
+    uint32_t magic_word;
+    char name[FAL_DEV_NAME_MAX];
+    char flash_name[FAL_DEV_NAME_MAX];
+    long offset;
+    size_t len;
+    uint32_t reserved;
+};
+
+int fal_init(void);
+const struct fal_partition *fal_partition_find(const char *name);
+int fal_partition_read(const struct fal_partition *part, uint32_t addr, uint8_t *buf, size_t size);
+int fal_partition_write(const struct fal_partition *part, uint32_t addr, const uint8_t *buf, size_t size);
+int fal_partition_erase(const struct fal_partition *part, uint32_t addr, size_t size);
+
+/**
+ * @brief 用 mem 作为分区 name 的内容, 大小 size 字节; mem 为 NULL 时分区不存在
+ */
+void fal_mock_init(const char *name, uint8_t *mem, size_t size);
+
+#endif // FAL_H
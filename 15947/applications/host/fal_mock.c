@@ -0,0 +1,74 @@
+/* applications/host/fal_mock.c */
+/*
+ * 一个 FAL 分区的主机替身。按 NOR 闪存的规则: 擦除以4KB扇区为单位置为0xFF,
+ * 写入只能把1改成0。内存由测试提供, 可以是 fork 前映射的共享内存,
+ * 以此模拟掉电重启后闪存内容仍在。
+ */
+
+#include <string.h>
+#include "fal.h"
+
+#define FAL_MOCK_SECTOR     4096
+
+static struct fal_partition mock_part;
+static uint8_t *mock_mem;
+
+void fal_mock_init(const char *name, uint8_t *mem, size_t size)
+{
+    memset(&mock_part, 0, sizeof(mock_part));
+    strncpy(mock_part.name, name, FAL_DEV_NAME_MAX - 1);
+    strncpy(mock_part.flash_name, "host", FAL_DEV_NAME_MAX - 1);
+    mock_part.len = size;
+    mock_mem = mem;
+}
+
+int fal_init(void)
+{
+    return 1;
+}
+
+int fal_init_check(void)
+{
+    return 1;
+}
+
+const struct fal_partition *fal_partition_find(const char *name)
+{
+    if (mock_mem == NULL || strcmp(name, mock_part.name) != 0) {
+        return NULL;
+    }
+    return &mock_part;
+}
+
+int fal_partition_read(const struct fal_partition *part, uint32_t addr, uint8_t *buf, size_t size)
+{
+    if (addr + size > part->len) {
+        return -1;
+    }
+    memcpy(buf, mock_mem + addr, size);
+    return (int)size;
+}
+
+int fal_partition_write(const struct fal_partition *part, uint32_t addr, const uint8_t *buf, size_t size)
+{
+    if (addr + size > part->len) {
+        return -1;
+    }
+    for (size_t i = 0; i < size; i++) {
+        mock_mem[addr + i] &= buf[i];
+    }
+    return (int)size;
+}
+
+int fal_partition_erase(const struct fal_partition *part, uint32_t addr, size_t size)
+{
+    uint32_t start = addr - addr % FAL_MOCK_SECTOR;
+    uint32_t end = addr + size;
+
+    end += (FAL_MOCK_SECTOR - end % FAL_MOCK_SECTOR) % FAL_MOCK_SECTOR;
+    if (end > part->len) {
+        return -1;
+    }
+    memset(mock_mem + start, 0xFF, end - start);
+    return (int)size;
+}
@@ -0,0 +1,163 @@
+/* applications/host/fault_bench.c */
+/* 故障引擎主机基准: 每帧耗时 (ns/frame), 含拓扑换算和不含两种 */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../pv_fault_engine.h"
+#include "../pv_topology.h"
+
+/* 板上的拓扑, 与 pv_cloud_config.h 的 PV_TOPO_* 相同 */
+static const uint8_t bench_board_panels[] = {3, 2};
+static const pv_topo_tap_t bench_board_taps[] = {{0, 1}, {0, 2}, {1, 2}, {0, 0}, {0, 3}, {1, 1}};
+
+/* 每帧一组通道电压, 预先生成, 计时不含随机数 */
+#define BENCH_FRAME_SET     1024
+
+typedef struct {
+    const char *name;
+    pv_topology_t topo;
+    int32_t channel_mv[BENCH_FRAME_SET][PV_TOPO_MAX_CHANNELS];
+} bench_case_t;
+
+static uint32_t bench_seed = 1;
+
+static uint32_t bench_rand(void)
+{
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return bench_seed >> 8;
+}
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* 每块板约 panel_mv, 噪声 ±1%, fault_pct% 的帧中有一块板掉到10% */
+static void bench_frames(bench_case_t *bc, int32_t panel_mv, int fault_pct)
+{
+    const pv_topology_t *topo = &bc->topo;
+
+    for (int f = 0; f < BENCH_FRAME_SET; f++) {
+        int32_t panel[PV_TOPO_MAX_PANELS];
+        int bad = ((int)(bench_rand() % 100) < fault_pct) ? (int)(bench_rand() % topo->panels) : -1;
+
+        for (int j = 0; j < topo->panels; j++) {
+            panel[j] = panel_mv + (int32_t)((int64_t)panel_mv * ((int)(bench_rand() % 201) - 100) / 10000);
+            if (j == bad) {
+                panel[j] /= 10;
+            }
+        }
+        /* 通道读数 = 所在组串从负端到抽头的累计电压 */
+        for (int c = 0; c < topo->channels; c++) {
+            int32_t sum = 0;
+
+            for (int d = 0; d < topo->channel_depth[c]; d++) {
+                sum += panel[topo->string_first[topo->channel_string[c]] + d];
+            }
+            bc->channel_mv[f][c] = sum;
+        }
+    }
+}
+
+static void bench_run(bench_case_t *bc, long frames)
+{
+    static pv_fault_engine_t engine;
+    int32_t panel_mv[BENCH_FRAME_SET][PV_TOPO_MAX_PANELS];
+    pv_panel_mask_t sink = 0;
+    uint64_t start, topo_ns, engine_ns;
+
+    for (int f = 0; f < BENCH_FRAME_SET; f++) {
+        pv_topology_panel_mv(&bc->topo, bc->channel_mv[f], panel_mv[f]);
+    }
+
+    /* 基准学习完成后再计时 */
+    pv_fault_engine_init(&engine, NULL, bc->topo.panels, NULL, NULL);
+    for (int f = 0; f < 100; f++) {
+        pv_fault_engine_process(&engine, panel_mv[f]);
+    }
+
+    start = bench_now_ns();
+    for (long n = 0; n < frames; n++) {
+        int32_t panel[PV_TOPO_MAX_PANELS];
+
+        pv_topology_panel_mv(&bc->topo, bc->channel_mv[n % BENCH_FRAME_SET], panel);
+        sink ^= pv_fault_engine_process(&engine, panel);
+    }
+    topo_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (long n = 0; n < frames; n++) {
+        sink ^= pv_fault_engine_process(&engine, panel_mv[n % BENCH_FRAME_SET]);
+    }
+    engine_ns = bench_now_ns() - start;
+
+    printf("%-22s %6d %8d %14.1f %14.1f %10.2f   (%llx)\n", bc->name, bc->topo.channels, bc->topo.panels,
+           (double)topo_ns / frames, (double)engine_ns / frames,
+           (double)engine_ns / frames / bc->topo.panels, (unsigned long long)(sink & 0xF));
+}
+
+int main(int argc, char **argv)
+{
+    static bench_case_t bc;
+    long frames = 2000000;
+    int fault_pct = 5;
+    int c;
+
+    while ((c = getopt(argc, argv, "n:f:h")) != -1) {
+        switch (c) {
+        case 'n': frames = strtol(optarg, NULL, 0); break;
+        case 'f': fault_pct = atoi(optarg); break;
+        default:
+            printf("usage: %s [-n frames] [-f fault%%]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (frames <= 0) {
+        return 1;
+    }
+
+    printf("%ld frames, a panel at 10%% in %d%% of the frames\n", frames, fault_pct);
+    printf("case                   channels panels  topo+engine ns  engine ns/frame  ns/panel\n");
+
+    /* 板上的阵列: 2串 3+2 块, 6个通道 */
+    {
+        const pv_topology_desc_t desc = {2, bench_board_panels, 6, bench_board_taps};
+
+        bc.name = "board 3+2";
+        pv_topology_compile(&bc.topo, &desc);
+        bench_frames(&bc, 1800, fault_pct);
+        bench_run(&bc, frames);
+
+        bc.name = "board 3+2, 40 V";
+        bench_frames(&bc, 40000, fault_pct);
+        bench_run(&bc, frames);
+    }
+
+    /* 每块板一个抽头的大阵列: 4串x16块 */
+    {
+        static uint8_t panels[4];
+        static pv_topo_tap_t taps[64];
+        const pv_topology_desc_t desc = {4, panels, 64, taps};
+
+        for (int s = 0; s < 4; s++) {
+            panels[s] = 16;
+            for (int d = 0; d < 16; d++) {
+                taps[s * 16 + d].string = (uint8_t)s;
+                taps[s * 16 + d].depth = (uint8_t)(d + 1);
+            }
+        }
+        bc.name = "4 x 16, tap per panel";
+        pv_topology_compile(&bc.topo, &desc);
+        bench_frames(&bc, 1800, fault_pct);
+        bench_run(&bc, frames);
+    }
+
+    return 0;
+}
@@ -0,0 +1,295 @@
+/* applications/host/fault_engine_test.c */
+/* 故障引擎主机测试: 合成的逐板电压序列逐帧送入引擎, 检查上报的事件 */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "../pv_fault_engine.h"
+
+#define TEST_MAX_EVENTS     64
+
+typedef struct {
+    pv_fault_event_t event;
+    int panel;
+    uint32_t frame;
+    int32_t value_mv;
+    int32_t baseline_mv;
+} test_event_t;
+
+typedef struct {
+    pv_fault_engine_t engine;
+    test_event_t events[TEST_MAX_EVENTS];
+    int event_count;
+    int32_t panel_mv[PV_FAULT_ENGINE_MAX_PANELS];
+    uint32_t seed;
+} test_run_t;
+
+static int test_errors;
+
+#define TEST_CHECK(expr)                                            \
+    do {                                                            \
+        if (!(expr)) {                                              \
+            printf("  line %d: %s\n", __LINE__, #expr);             \
+            test_errors++;                                          \
+        }                                                           \
+    } while (0)
+
+static void test_on_event(void *user_data, pv_fault_event_t event, int panel,
+                          int32_t value_mv, int32_t baseline_mv)
+{
+    test_run_t *run = user_data;
+
+    if (run->event_count < TEST_MAX_EVENTS) {
+        test_event_t *e = &run->events[run->event_count];
+
+        e->event = event;
+        e->panel = panel;
+        e->frame = run->engine.frames;
+        e->value_mv = value_mv;
+        e->baseline_mv = baseline_mv;
+    }
+    run->event_count++;
+}
+
+/* 确定性的伪随机数, 各平台结果一致 */
+static uint32_t test_rand(test_run_t *run)
+{
+    run->seed = run->seed * 1664525u + 1013904223u;
+    return run->seed >> 8;
+}
+
+static void test_start(test_run_t *run, int panels, const pv_fault_engine_config_t *cfg)
+{
+    memset(run, 0, sizeof(*run));
+    run->seed = 1;
+    pv_fault_engine_init(&run->engine, cfg, panels, test_on_event, run);
+}
+
+/* 每块板电压为 mv[i] 加 ±noise_pct% 的噪声, 送入 frames 帧 */
+static pv_panel_mask_t test_feed(test_run_t *run, const int32_t *mv, int noise_pct, int frames)
+{
+    pv_panel_mask_t mask = 0;
+
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < run->engine.panels; i++) {
+            int64_t noise = 0;
+
+            if (noise_pct > 0) {
+                noise = (int64_t)mv[i] * noise_pct * ((int)(test_rand(run) % 2001) - 1000) / 100000;
+            }
+            run->panel_mv[i] = (int32_t)(mv[i] + noise);
+        }
+        mask = pv_fault_engine_process(&run->engine, run->panel_mv);
+    }
+
+    return mask;
+}
+
+/* 第一个 event 事件的序号, 没有返回 -1 */
+static int test_find(const test_run_t *run, pv_fault_event_t event, int panel)
+{
+    for (int i = 0; i < run->event_count && i < TEST_MAX_EVENTS; i++) {
+        if (run->events[i].event == event && run->events[i].panel == panel) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void test_steady(void)
+{
+    static test_run_t run;
+    const int32_t mv[5] = {1800, 1820, 1790, 2400, 2380};
+
+    test_start(&run, 5, NULL);
+    TEST_CHECK(test_feed(&run, mv, 2, 20000) == 0);
+    TEST_CHECK(run.event_count == 1);
+    TEST_CHECK(run.events[0].event == PV_FAULT_EVENT_BASELINE);
+    TEST_CHECK(run.events[0].frame == 10);
+    TEST_CHECK(run.engine.primary == 0);
+    for (int i = 0; i < 5; i++) {
+        int32_t base = pv_fault_engine_baseline_mv(&run.engine, i);
+
+        TEST_CHECK(base > mv[i] * 98 / 100 && base < mv[i] * 102 / 100);
+        TEST_CHECK(pv_fault_engine_sigma_mv(&run.engine, i) < (uint32_t)mv[i] / 50);
+    }
+}
+
+static void test_open_panel(void)
+{
+    static test_run_t run;
+    int32_t mv[5] = {1800, 1800, 1800, 1800, 1800};
+    int set, clear;
+
+    test_start(&run, 5, NULL);
+    test_feed(&run, mv, 1, 200);
+
+    /* PV3 掉到10%, 当帧即判故障 */
+    mv[2] = 180;
+    TEST_CHECK(test_feed(&run, mv, 1, 1) == (1u << 2));
+    TEST_CHECK(run.engine.primary == 3);
+    test_feed(&run, mv, 1, 100);
+    set = test_find(&run, PV_FAULT_EVENT_SET, 2);
+    TEST_CHECK(set >= 0 && run.events[set].frame == 201);
+    TEST_CHECK(set >= 0 && run.events[set].baseline_mv > 1750);
+
+    /* 故障期间基准不被拉低; 恢复后CUSUM从上限 2h 按松弛量回落到 h/2 以下才清除, 约15帧 */
+    TEST_CHECK(pv_fault_engine_baseline_mv(&run.engine, 2) > 1750);
+    mv[2] = 1800;
+    TEST_CHECK(test_feed(&run, mv, 1, 20) == 0);
+    clear = test_find(&run, PV_FAULT_EVENT_CLEAR, 2);
+    TEST_CHECK(clear > set && run.events[clear].frame <= 320);
+    TEST_CHECK(run.event_count == 3);
+}
+
+static void test_cusum(void)
+{
+    static test_run_t run;
+    int32_t mv[5] = {2000, 2000, 2000, 2000, 2000};
+    int set;
+
+    test_start(&run, 5, NULL);
+    test_feed(&run, mv, 1, 100);
+
+    /* 下降35%: 低于瞬时阈值, 由CUSUM在约 2.0/(0.35-0.20) 帧后判出 */
+    mv[1] = 1300;
+    TEST_CHECK(test_feed(&run, mv, 1, 5) == 0);
+    test_feed(&run, mv, 1, 30);
+    set = test_find(&run, PV_FAULT_EVENT_SET, 1);
+    TEST_CHECK(set >= 0 && run.events[set].frame >= 110 && run.events[set].frame <= 120);
+    TEST_CHECK(run.engine.fault_mask == (1u << 1));
+}
+
+static void test_cloud(void)
+{
+    static test_run_t run;
+    int32_t mv[5] = {2000, 2000, 2000, 2000, 2000};
+
+    test_start(&run, 5, NULL);
+    test_feed(&run, mv, 1, 100);
+
+    /* 全部板下降15%的云影, 在松弛量以内, 不报故障, 基准跟随 */
+    for (int i = 0; i < 5; i++) {
+        mv[i] = 1700;
+    }
+    TEST_CHECK(test_feed(&run, mv, 1, 1000) == 0);
+    TEST_CHECK(pv_fault_engine_baseline_mv(&run.engine, 0) < 1750);
+    for (int i = 0; i < 5; i++) {
+        mv[i] = 2000;
+    }
+    TEST_CHECK(test_feed(&run, mv, 1, 1000) == 0);
+    TEST_CHECK(run.event_count == 1);
+}
+
+static void test_negative(void)
+{
+    static test_run_t run;
+    int32_t mv[5] = {1500, 1500, 1500, 1500, 1500};
+
+    test_start(&run, 5, NULL);
+    test_feed(&run, mv, 1, 50);
+
+    /* PV1 降到40%, PV4 反向 -500mV, 主故障为反向的 PV4 */
+    mv[0] = 600;
+    mv[3] = -500;
+    TEST_CHECK(test_feed(&run, mv, 0, 1) == ((1u << 0) | (1u << 3)));
+    TEST_CHECK(run.engine.primary == 4);
+}
+
+static void test_learning_dip(void)
+{
+    static test_run_t run;
+    int32_t mv[3] = {1000, 1000, 1000};
+
+    test_start(&run, 3, NULL);
+    test_feed(&run, mv, 0, 4);
+
+    /* 学习期的骤降被标记, 不计入基准 */
+    mv[1] = 100;
+    TEST_CHECK(test_feed(&run, mv, 0, 1) == (1u << 1));
+    mv[1] = 1000;
+    test_feed(&run, mv, 0, 20);
+    TEST_CHECK(run.engine.baseline_ready);
+    TEST_CHECK(pv_fault_engine_baseline_mv(&run.engine, 1) == 1000);
+    TEST_CHECK(run.engine.fault_mask == 0);
+}
+
+/* 单块板超过32767mV时Q16电压超出int32, 检测必须与低压时一致 */
+static void test_high_voltage(void)
+{
+    static test_run_t run;
+    int32_t mv[4] = {40000, 41000, 39500, 600000};
+    int set;
+
+    test_start(&run, 4, NULL);
+    TEST_CHECK(test_feed(&run, mv, 2, 2000) == 0);
+    TEST_CHECK(run.event_count == 1);
+    TEST_CHECK(pv_fault_engine_baseline_mv(&run.engine, 0) > 39000);
+    TEST_CHECK(pv_fault_engine_baseline_mv(&run.engine, 3) > 590000);
+    TEST_CHECK(pv_fault_engine_sigma_mv(&run.engine, 3) > 1000 && pv_fault_engine_sigma_mv(&run.engine, 3) < 12000);
+
+    mv[1] = 4000;
+    TEST_CHECK(test_feed(&run, mv, 2, 1) == (1u << 1));
+    set = test_find(&run, PV_FAULT_EVENT_SET, 1);
+    TEST_CHECK(set >= 0 && run.events[set].baseline_mv > 40000);
+    mv[1] = 41000;
+    TEST_CHECK(test_feed(&run, mv, 2, 20) == 0);
+
+    /* 超出量程的读数被限幅, 不溢出 */
+    mv[3] = INT32_MAX;
+    test_feed(&run, mv, 0, 100);
+    TEST_CHECK(run.engine.last_mv[3] == PV_FAULT_ENGINE_MAX_MV);
+    mv[3] = INT32_MIN;
+    TEST_CHECK(test_feed(&run, mv, 0, 1) == (1u << 3));
+    TEST_CHECK(run.engine.primary == 4);
+}
+
+static void test_max_panels(void)
+{
+    static test_run_t run;
+    int32_t mv[PV_FAULT_ENGINE_MAX_PANELS];
+
+    for (int i = 0; i < PV_FAULT_ENGINE_MAX_PANELS; i++) {
+        mv[i] = 1000 + 10 * i;
+    }
+    test_start(&run, PV_FAULT_ENGINE_MAX_PANELS + 5, NULL);
+    TEST_CHECK(run.engine.panels == PV_FAULT_ENGINE_MAX_PANELS);
+    test_feed(&run, mv, 1, 100);
+
+    mv[63] = 0;
+    TEST_CHECK(test_feed(&run, mv, 1, 1) == ((pv_panel_mask_t)1 << 63));
+    TEST_CHECK(run.engine.primary == 64);
+    TEST_CHECK(test_find(&run, PV_FAULT_EVENT_SET, 63) >= 0);
+}
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} test_cases[] = {
+    {"steady with noise", test_steady},
+    {"open panel", test_open_panel},
+    {"slow drop by CUSUM", test_cusum},
+    {"cloud on all panels", test_cloud},
+    {"negative panel", test_negative},
+    {"dip while learning", test_learning_dip},
+    {"panels above 32767 mV", test_high_voltage},
+    {"64 panels", test_max_panels},
+};
+
+int main(void)
+{
+    int i, errors, failed = 0;
+
+    for (i = 0; i < (int)(sizeof(test_cases) / sizeof(test_cases[0])); i++) {
+        errors = test_errors;
+        test_cases[i].run();
+        printf("%-32s %s\n", test_cases[i].name, test_errors == errors ? "ok" : "FAILED");
+        if (test_errors != errors) {
+            failed++;
+        }
+    }
+    printf("%d of %d passed\n", i - failed, i);
+
+    return failed ? 1 : 0;
+}
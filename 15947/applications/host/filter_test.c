@@ -0,0 +1,325 @@
+/* applications/host/filter_test.c */
+/*
+ * pv_filter 的主机测试: 默认滤波链 (5点中值 + IIR k=2) 与固定的参考向量比较,
+ * 各级再与逐样本的朴素参考实现比较长的随机序列, 并检查分块方式不影响输出。
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../pv_cloud_config.h"
+#include "../pv_filter.h"
+
+#define TEST_LEN            4096
+
+static int test_errors;
+static uint32_t test_seed = 1;
+
+#define TEST_CHECK(expr)                                            \
+    do {                                                            \
+        if (!(expr)) {                                              \
+            printf("  line %d: %s\n", __LINE__, #expr);             \
+            test_errors++;                                          \
+        }                                                           \
+    } while (0)
+
+/* 稳定读数中夹着满量程、0和台阶 */
+static const rt_int32_t ref_input[] = {
+    2000, 2003, 1998, 4095, 2001, 2002,    0, 1999, 2004, 2000, 2000, 3000,
+    3000, 2001, 1997, 2002,  500, 2000, 2003, 2001, 2100, 2100, 2100, 2100,
+};
+static const rt_int32_t ref_median5[] = {
+    2000, 2003, 2000, 2003, 2001, 2002, 2001, 2001, 2001, 2000, 2000, 2000,
+    2004, 2001, 2001, 2002, 2001, 2000, 2000, 2001, 2001, 2003, 2100, 2100,
+};
+static const rt_int32_t ref_iir2[] = {
+    2000, 2001, 2000, 2524, 2393, 2295, 1721, 1791, 1844, 1883, 1912, 2184,
+    2388, 2291, 2218, 2164, 1748, 1811, 1859, 1894, 1946, 1984, 2013, 2035,
+};
+static const rt_int32_t ref_median5_iir2[] = {
+    2000, 2001, 2001, 2001, 2001, 2001, 2001, 2001, 2001, 2001, 2001, 2000,
+    2001, 2001, 2001, 2001, 2001, 2001, 2001, 2001, 2001, 2001, 2026, 2045,
+};
+
+#define REF_LEN     ((int)(sizeof(ref_input) / sizeof(ref_input[0])))
+
+static uint32_t test_rand(void)
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return test_seed >> 8;
+}
+
+/* 12位ADC读数: 慢变的信号, 噪声, 偶尔的尖峰 */
+static void test_signal(rt_int32_t *x, int len)
+{
+    for (int n = 0; n < len; n++) {
+        x[n] = 2000 + (n / 256) * 37 % 900 + (rt_int32_t)(test_rand() % 41) - 20;
+        if (test_rand() % 50 == 0) {
+            x[n] = (test_rand() & 1) ? 4095 : 0;
+        }
+    }
+}
+
+/* ========== 朴素参考实现 ========== */
+
+static int cmp_int32(const void *a, const void *b)
+{
+    rt_int32_t x = *(const rt_int32_t *)a, y = *(const rt_int32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* 每个输出把窗口 (未满时为已有样本) 重新排序, 取下标 fill/2 */
+static void ref_median(const rt_int32_t *x, rt_int32_t *y, int len, int window)
+{
+    rt_int32_t sorted[PV_FILTER_MEDIAN_MAX];
+
+    for (int n = 0; n < len; n++) {
+        int fill = n + 1 < window ? n + 1 : window;
+
+        memcpy(sorted, x + n + 1 - fill, fill * sizeof(rt_int32_t));
+        qsort(sorted, fill, sizeof(rt_int32_t), cmp_int32);
+        y[n] = sorted[fill / 2];
+    }
+}
+
+static void ref_average(const rt_int32_t *x, rt_int32_t *y, int len, int window)
+{
+    for (int n = 0; n < len; n++) {
+        int fill = n + 1 < window ? n + 1 : window;
+        rt_int32_t sum = 0;
+
+        for (int i = n + 1 - fill; i <= n; i++) {
+            sum += x[i];
+        }
+        y[n] = sum / fill;
+    }
+}
+
+static void ref_iir(const rt_int32_t *x, rt_int32_t *y, int len, int k)
+{
+    rt_int32_t acc = x[0] * 256;
+
+    for (int n = 0; n < len; n++) {
+        acc += (x[n] * 256 - acc) >> k;
+        y[n] = (acc + 128) >> 8;
+    }
+}
+
+static int ref_decimate(const rt_int32_t *x, rt_int32_t *y, int len, int factor)
+{
+    int out = 0;
+
+    for (int n = factor - 1; n < len; n += factor) {
+        rt_int32_t sum = 0;
+
+        for (int i = n + 1 - factor; i <= n; i++) {
+            sum += x[i];
+        }
+        y[out++] = sum / factor;
+    }
+
+    return out;
+}
+
+/* ========== 用例 ========== */
+
+/* 按 block 大小分块处理, 返回输出数 */
+static int test_process(const pv_filter_config_t *config, int stages, const rt_int32_t *x, rt_int32_t *y,
+                        int len, int block)
+{
+    pv_filter_chain_t chain;
+    int out = 0;
+
+    TEST_CHECK(pv_filter_chain_init(&chain, config, stages) == RT_EOK);
+    memcpy(y, x, len * sizeof(rt_int32_t));
+    for (int n = 0; n < len; n += block) {
+        int count = len - n < block ? len - n : block;
+
+        /* 输出写在输入块的前部, 挪到已输出部分之后 */
+        int produced = (int)pv_filter_chain_process(&chain, y + n, count);
+        memmove(y + out, y + n, produced * sizeof(rt_int32_t));
+        out += produced;
+    }
+
+    return out;
+}
+
+static int test_equal(const rt_int32_t *a, const rt_int32_t *b, int len)
+{
+    for (int n = 0; n < len; n++) {
+        if (a[n] != b[n]) {
+            printf("  sample %d: %d, expected %d\n", n, (int)a[n], (int)b[n]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_reference_vectors(void)
+{
+    static const pv_filter_config_t median5[] = {{PV_FILTER_MEDIAN, 5}};
+    static const pv_filter_config_t iir2[] = {{PV_FILTER_IIR, 2}};
+    static const pv_filter_config_t chain[] = PV_FILTER_DEFAULT_CHAIN;
+    rt_int32_t y[REF_LEN];
+
+    TEST_CHECK(test_process(median5, 1, ref_input, y, REF_LEN, REF_LEN) == REF_LEN);
+    TEST_CHECK(test_equal(y, ref_median5, REF_LEN));
+    TEST_CHECK(test_process(iir2, 1, ref_input, y, REF_LEN, REF_LEN) == REF_LEN);
+    TEST_CHECK(test_equal(y, ref_iir2, REF_LEN));
+    TEST_CHECK(test_process(chain, 2, ref_input, y, REF_LEN, REF_LEN) == REF_LEN);
+    TEST_CHECK(test_equal(y, ref_median5_iir2, REF_LEN));
+}
+
+static void test_median(void)
+{
+    static rt_int32_t x[TEST_LEN], y[TEST_LEN], expect[TEST_LEN];
+
+    test_signal(x, TEST_LEN);
+    for (int window = 3; window <= PV_FILTER_MEDIAN_MAX; window += 2) {
+        pv_filter_config_t config = {PV_FILTER_MEDIAN, (rt_uint8_t)window};
+
+        ref_median(x, expect, TEST_LEN, window);
+        TEST_CHECK(test_process(&config, 1, x, y, TEST_LEN, 64) == TEST_LEN);
+        TEST_CHECK(test_equal(y, expect, TEST_LEN));
+    }
+}
+
+static void test_average(void)
+{
+    static rt_int32_t x[TEST_LEN], y[TEST_LEN], expect[TEST_LEN];
+
+    test_signal(x, TEST_LEN);
+    for (int window = 2; window <= PV_FILTER_AVG_MAX; window += 5) {
+        pv_filter_config_t config = {PV_FILTER_AVERAGE, (rt_uint8_t)window};
+
+        ref_average(x, expect, TEST_LEN, window);
+        TEST_CHECK(test_process(&config, 1, x, y, TEST_LEN, 64) == TEST_LEN);
+        TEST_CHECK(test_equal(y, expect, TEST_LEN));
+    }
+}
+
+static void test_iir(void)
+{
+    static rt_int32_t x[TEST_LEN], y[TEST_LEN], expect[TEST_LEN];
+
+    test_signal(x, TEST_LEN);
+    for (int k = 1; k <= 8; k++) {
+        pv_filter_config_t config = {PV_FILTER_IIR, (rt_uint8_t)k};
+
+        ref_iir(x, expect, TEST_LEN, k);
+        TEST_CHECK(test_process(&config, 1, x, y, TEST_LEN, 64) == TEST_LEN);
+        TEST_CHECK(test_equal(y, expect, TEST_LEN));
+    }
+}
+
+static void test_decimate(void)
+{
+    static rt_int32_t x[TEST_LEN], y[TEST_LEN], expect[TEST_LEN];
+
+    test_signal(x, TEST_LEN);
+    for (int factor = 2; factor <= 10; factor++) {
+        pv_filter_config_t config = {PV_FILTER_DECIMATE, (rt_uint8_t)factor};
+        int out = ref_decimate(x, expect, TEST_LEN, factor);
+
+        /* 抽取相位跨块保留 */
+        TEST_CHECK(test_process(&config, 1, x, y, TEST_LEN, 64) == out);
+        TEST_CHECK(test_equal(y, expect, out));
+    }
+}
+
+/* 默认链加一级抽取, 按 DMA 半缓冲 (64帧)、逐样本、整段等不同分块处理, 输出相同 */
+static void test_block_sizes(void)
+{
+    static const pv_filter_config_t chain[] = {{PV_FILTER_MEDIAN, 5}, {PV_FILTER_IIR, 2}, {PV_FILTER_DECIMATE, 4}};
+    static const int blocks[] = {1, 7, 64, TEST_LEN};
+    static rt_int32_t x[TEST_LEN], y[TEST_LEN], expect[TEST_LEN];
+    int out;
+
+    test_signal(x, TEST_LEN);
+    out = test_process(chain, 3, x, expect, TEST_LEN, TEST_LEN);
+    TEST_CHECK(out == TEST_LEN / 4);
+    for (int i = 0; i < (int)(sizeof(blocks) / sizeof(blocks[0])); i++) {
+        TEST_CHECK(test_process(chain, 3, x, y, TEST_LEN, blocks[i]) == out);
+        TEST_CHECK(test_equal(y, expect, out));
+    }
+}
+
+static void test_config(void)
+{
+    static const pv_filter_config_t bad[] = {
+        {PV_FILTER_MEDIAN, 4}, {PV_FILTER_MEDIAN, 11}, {PV_FILTER_MEDIAN, 1},
+        {PV_FILTER_AVERAGE, 1}, {PV_FILTER_AVERAGE, 33},
+        {PV_FILTER_IIR, 0}, {PV_FILTER_IIR, 9},
+        {PV_FILTER_DECIMATE, 1}, {PV_FILTER_NONE, 0}, {9, 1},
+    };
+    static const pv_filter_config_t chain[] = PV_FILTER_DEFAULT_CHAIN;
+    pv_filter_config_t many[PV_FILTER_MAX_STAGES + 1];
+    pv_filter_chain_t c;
+    rt_int32_t y[REF_LEN];
+
+    TEST_CHECK(pv_filter_chain_init(&c, chain, 2) == RT_EOK);
+    for (int i = 0; i < (int)(sizeof(bad) / sizeof(bad[0])); i++) {
+        /* 非法配置不改动原来的链 */
+        TEST_CHECK(pv_filter_chain_init(&c, &bad[i], 1) == -RT_EINVAL);
+        TEST_CHECK(c.count == 2 && c.stages[0].config.type == PV_FILTER_MEDIAN);
+    }
+    for (int i = 0; i <= PV_FILTER_MAX_STAGES; i++) {
+        many[i].type = PV_FILTER_IIR;
+        many[i].param = 1;
+    }
+    TEST_CHECK(pv_filter_chain_init(&c, many, PV_FILTER_MAX_STAGES + 1) == -RT_EINVAL);
+    TEST_CHECK(pv_filter_chain_init(&c, many, PV_FILTER_MAX_STAGES) == RT_EOK);
+
+    /* 直通 */
+    TEST_CHECK(pv_filter_chain_init(&c, RT_NULL, 0) == RT_EOK);
+    memcpy(y, ref_input, sizeof(y));
+    TEST_CHECK(pv_filter_chain_process(&c, y, REF_LEN) == REF_LEN);
+    TEST_CHECK(test_equal(y, ref_input, REF_LEN));
+
+    /* 清空状态后与新链的输出相同 */
+    TEST_CHECK(pv_filter_chain_init(&c, chain, 2) == RT_EOK);
+    memcpy(y, ref_input, sizeof(y));
+    pv_filter_chain_process(&c, y, REF_LEN);
+    pv_filter_chain_reset(&c);
+    memcpy(y, ref_input, sizeof(y));
+    pv_filter_chain_process(&c, y, REF_LEN);
+    TEST_CHECK(test_equal(y, ref_median5_iir2, REF_LEN));
+
+    TEST_CHECK(pv_filter_type_parse("median") == PV_FILTER_MEDIAN);
+    TEST_CHECK(pv_filter_type_parse("decim") == PV_FILTER_DECIMATE);
+    TEST_CHECK(pv_filter_type_parse("none") == PV_FILTER_NONE);
+    TEST_CHECK(strcmp(pv_filter_type_name(PV_FILTER_IIR), "iir") == 0);
+}
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} test_cases[] = {
+    {"reference vectors", test_reference_vectors},
+    {"median vs sorted window", test_median},
+    {"average vs window sum", test_average},
+    {"iir vs recurrence", test_iir},
+    {"decimate vs block mean", test_decimate},
+    {"block size independent", test_block_sizes},
+    {"config and reset", test_config},
+};
+
+int main(void)
+{
+    int i, failed = 0;
+
+    for (i = 0; i < (int)(sizeof(test_cases) / sizeof(test_cases[0])); i++) {
+        int before = test_errors;
+
+        test_cases[i].run();
+        printf("%-32s %s\n", test_cases[i].name, test_errors == before ? "ok" : "FAILED");
+        if (test_errors != before) {
+            failed++;
+        }
+    }
+    printf("%d of %d passed\n", i - failed, i);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,339 @@
+/* applications/host/host_stub.c */
+/*
+ * 应用模块在主机上用到的内核服务。线程用 pthread 实现, 互斥量和信号量按对象地址
+ * 对应到 pthread 互斥量和条件变量; rt_tick 由单调时钟乘以 host_time_scale 得到,
+ * 带超时的等待按同样的倍数缩短。
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <rtthread.h>
+#include <rthw.h>
+#include <sal_socket.h>
+#include "host_stub.h"
+
+#define HOST_IPC_MAX        32
+
+typedef struct {
+    const void *object;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    long value;
+    pthread_t owner;
+} host_ipc_t;
+
+volatile int host_time_scale = 1;
+volatile int host_quiet = 0;
+
+static host_ipc_t host_ipc[HOST_IPC_MAX];
+static pthread_mutex_t host_ipc_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t host_irq_lock;
+static pthread_once_t host_irq_once = PTHREAD_ONCE_INIT;
+
+static uint64_t host_real_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* 把 tick 数换算成真实时间的截止时刻 */
+static void host_deadline(struct timespec *ts, rt_int32_t ticks)
+{
+    uint64_t ns = (uint64_t)ticks * (1000000000ull / RT_TICK_PER_SECOND) / host_time_scale;
+
+    clock_gettime(CLOCK_REALTIME, ts);
+    ns += ts->tv_nsec;
+    ts->tv_sec += ns / 1000000000ull;
+    ts->tv_nsec = ns % 1000000000ull;
+}
+
+static host_ipc_t *host_ipc_get(const void *object, int create)
+{
+    host_ipc_t *found = RT_NULL;
+
+    pthread_mutex_lock(&host_ipc_lock);
+    for (int i = 0; i < HOST_IPC_MAX && found == RT_NULL; i++) {
+        if (host_ipc[i].object == object) {
+            found = &host_ipc[i];
+        }
+    }
+    for (int i = 0; i < HOST_IPC_MAX && found == RT_NULL && create; i++) {
+        if (host_ipc[i].object == RT_NULL) {
+            found = &host_ipc[i];
+            found->object = object;
+            pthread_mutex_init(&found->lock, RT_NULL);
+            pthread_cond_init(&found->cond, RT_NULL);
+            found->value = 0;
+        }
+    }
+    pthread_mutex_unlock(&host_ipc_lock);
+
+    if (found == RT_NULL) {
+        fprintf(stderr, "host_stub: %s IPC object %p\n", create ? "too many" : "unknown", object);
+        abort();
+    }
+
+    return found;
+}
+
+static void host_ipc_put(const void *object)
+{
+    host_ipc_t *ipc = host_ipc_get(object, 0);
+
+    pthread_mutex_lock(&host_ipc_lock);
+    pthread_cond_destroy(&ipc->cond);
+    pthread_mutex_destroy(&ipc->lock);
+    ipc->object = RT_NULL;
+    pthread_mutex_unlock(&host_ipc_lock);
+}
+
+/* 等待 value > 0 并减一, 返回 RT_EOK 或 -RT_ETIMEOUT */
+static rt_err_t host_ipc_take(host_ipc_t *ipc, rt_int32_t timeout)
+{
+    struct timespec ts;
+    rt_err_t result = RT_EOK;
+
+    if (timeout > 0) {
+        host_deadline(&ts, timeout);
+    }
+
+    pthread_mutex_lock(&ipc->lock);
+    while (ipc->value <= 0 && result == RT_EOK) {
+        if (timeout == 0) {
+            result = -RT_ETIMEOUT;
+        } else if (timeout < 0) {
+            pthread_cond_wait(&ipc->cond, &ipc->lock);
+        } else if (pthread_cond_timedwait(&ipc->cond, &ipc->lock, &ts) != 0) {
+            result = (ipc->value > 0) ? RT_EOK : -RT_ETIMEOUT;
+        }
+    }
+    if (result == RT_EOK) {
+        ipc->value--;
+    }
+    pthread_mutex_unlock(&ipc->lock);
+
+    return result;
+}
+
+static void host_ipc_give(host_ipc_t *ipc)
+{
+    pthread_mutex_lock(&ipc->lock);
+    ipc->value++;
+    pthread_cond_signal(&ipc->cond);
+    pthread_mutex_unlock(&ipc->lock);
+}
+
+/* ========== 中断锁 ========== */
+
+/* 关中断可以嵌套, 用递归互斥量 */
+static void host_irq_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&host_irq_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    pthread_once(&host_irq_once, host_irq_init);
+    pthread_mutex_lock(&host_irq_lock);
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    (void)level;
+    pthread_mutex_unlock(&host_irq_lock);
+}
+
+/* ========== 信号量与互斥量 ========== */
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    (void)flag;
+    rt_strncpy(sem->parent.parent.name, name, RT_NAME_MAX - 1);
+    host_ipc_get(sem, 1)->value = value;
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    host_ipc_put(sem);
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    return host_ipc_take(host_ipc_get(sem, 0), time);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    host_ipc_give(host_ipc_get(sem, 0));
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
+{
+    (void)flag;
+    rt_strncpy(mutex->parent.parent.name, name, RT_NAME_MAX - 1);
+    host_ipc_get(mutex, 1)->value = 1;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex)
+{
+    host_ipc_put(mutex);
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    host_ipc_t *ipc = host_ipc_get(mutex, 0);
+    rt_bool_t owned;
+    rt_err_t result;
+
+    /* RT-Thread 的互斥量可以递归持有 */
+    pthread_mutex_lock(&ipc->lock);
+    owned = ipc->value <= 0 && pthread_equal(ipc->owner, pthread_self());
+    pthread_mutex_unlock(&ipc->lock);
+    if (owned) {
+        mutex->hold++;
+        return RT_EOK;
+    }
+
+    result = host_ipc_take(ipc, time);
+    if (result == RT_EOK) {
+        pthread_mutex_lock(&ipc->lock);
+        ipc->owner = pthread_self();
+        pthread_mutex_unlock(&ipc->lock);
+        mutex->hold = 1;
+    }
+    return result;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    host_ipc_t *ipc = host_ipc_get(mutex, 0);
+
+    if (--mutex->hold == 0) {
+        pthread_mutex_lock(&ipc->lock);
+        ipc->owner = (pthread_t)0;
+        pthread_mutex_unlock(&ipc->lock);
+        host_ipc_give(ipc);
+    }
+    return RT_EOK;
+}
+
+/* ========== 线程与时间 ========== */
+
+static void *host_thread_entry(void *arg)
+{
+    rt_thread_t thread = arg;
+
+    ((void (*)(void *))thread->entry)(thread->parameter);
+    return RT_NULL;
+}
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick)
+{
+    rt_thread_t thread = calloc(1, sizeof(struct rt_thread));
+
+    (void)stack_size;
+    (void)tick;
+    if (thread != RT_NULL) {
+        rt_strncpy(thread->name, name, RT_NAME_MAX - 1);
+        thread->entry = (void *)entry;
+        thread->parameter = parameter;
+        thread->current_priority = priority;
+    }
+    return thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    pthread_t tid;
+
+    if (pthread_create(&tid, RT_NULL, host_thread_entry, thread) != 0) {
+        return -RT_ERROR;
+    }
+    pthread_detach(tid);
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick)
+{
+    usleep((useconds_t)((uint64_t)tick * (1000000 / RT_TICK_PER_SECOND) / host_time_scale));
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms)
+{
+    return rt_thread_delay(rt_tick_from_millisecond(ms));
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    return (rt_tick_t)(host_real_ms() * host_time_scale);
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    return (ms < 0) ? (rt_tick_t)RT_WAITING_FOREVER : (rt_tick_t)((rt_int64_t)ms * RT_TICK_PER_SECOND / 1000);
+}
+
+/* ========== 内存与输出 ========== */
+
+void *rt_malloc(rt_size_t size)
+{
+    return malloc(size);
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    return calloc(count, size);
+}
+
+void rt_free(void *ptr)
+{
+    free(ptr);
+}
+
+int rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+    int length = 0;
+
+    if (!host_quiet) {
+        va_start(args, fmt);
+        length = vprintf(fmt, args);
+        va_end(args);
+    }
+    return length;
+}
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    printf("(%s) assertion failed at function:%s, line number:%lu\n", ex, func, (unsigned long)line);
+    abort();
+}
+
+/* ========== 网络 ========== */
+
+/* sal_netbuf.c 的 sal_netbuf_send() 引用, 应用的主机测试不经过套接字发送 */
+int sal_sendmsg(int socket, const struct msghdr *message, int flags)
+{
+    return -1;
+}
@@ -0,0 +1,12 @@
+/* applications/host/host_stub.h */
+/* 主机构建的内核替身: 线程为 pthread, 时间可以加速 */
+
+#ifndef HOST_STUB_H
+#define HOST_STUB_H
+
+/* rt_tick 的速度是真实时间的倍数, 秒级的重试间隔在测试中只需几十毫秒 */
+extern volatile int host_time_scale;
+/* 为1时不输出 rt_kprintf */
+extern volatile int host_quiet;
+
+#endif // HOST_STUB_H
@@ -0,0 +1,323 @@
+/* applications/host/json_bench.c */
+/*
+ * pv_json 主机基准: 字段表序列化与原来的 snprintf("%.3f") 负载生成比较 (ns/payload)。
+ * 两种负载的结构体和格式串与 onenet_dp_uploader.c / pv_cloud_uploader.c 改用 pv_json
+ * 之前相同; 计时前先逐条比较两种方法的输出, 不一致时返回1。
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../pv_json.h"
+
+#define BENCH_DATA_SET      1024
+#define BENCH_BUF_SIZE      1024
+
+/* onenet_dp_uploader.c 的 DP 负载 */
+typedef struct {
+    rt_int32_t va1_mv, va2_mv, va3_mv;
+    rt_int32_t vb1_mv, vb2_mv;
+    rt_int32_t message_id;
+    rt_int32_t fault_code_id;
+    char fault_code_str[32];
+    rt_int32_t fault_count;
+    char fault_list[64];
+    char fault_code_str1[32];
+    char fault_code_str2[32];
+    char fault_code_str3[32];
+    char fault_code_str4[32];
+} bench_dp_t;
+
+/* 改用 pv_json 之前的 DP 结构体, 电压为 V */
+typedef struct {
+    float va1, va2, va3;
+    float vb1, vb2;
+} bench_dp_float_t;
+
+static const pv_json_field_t bench_dp_fields[] = {
+    PV_JSON_FIELD_FIXED(bench_dp_t, va1_mv, "va1", 3),
+    PV_JSON_FIELD_FIXED(bench_dp_t, va2_mv, "va2", 3),
+    PV_JSON_FIELD_FIXED(bench_dp_t, va3_mv, "va3", 3),
+    PV_JSON_FIELD_FIXED(bench_dp_t, vb1_mv, "vb1", 3),
+    PV_JSON_FIELD_FIXED(bench_dp_t, vb2_mv, "vb2", 3),
+    PV_JSON_FIELD_INT(bench_dp_t, fault_code_id, "fault_code_id"),
+    PV_JSON_FIELD_STRING(bench_dp_t, fault_code_str, "fault_code_str"),
+    PV_JSON_FIELD_INT(bench_dp_t, fault_count, "fault_count"),
+    PV_JSON_FIELD_STRING(bench_dp_t, fault_list, "fault_list"),
+    PV_JSON_FIELD_STRING(bench_dp_t, fault_code_str1, "fault_code_str1"),
+    PV_JSON_FIELD_STRING(bench_dp_t, fault_code_str2, "fault_code_str2"),
+    PV_JSON_FIELD_STRING(bench_dp_t, fault_code_str3, "fault_code_str3"),
+    PV_JSON_FIELD_STRING(bench_dp_t, fault_code_str4, "fault_code_str4"),
+};
+static const pv_json_schema_t bench_dp_schema = PV_JSON_SCHEMA(bench_dp_fields, PV_JSON_LAYOUT_DP);
+
+/* pv_cloud_uploader.c 的 params 负载 */
+typedef struct {
+    rt_uint32_t volt_va1, volt_va2, volt_va3;
+    rt_uint32_t volt_vb1, volt_vb2, volt_vb3;
+    rt_uint32_t volt_pv1, volt_pv2, volt_pv3;
+    rt_uint32_t volt_pv4, volt_pv5, volt_pv6;
+    rt_int32_t fault_g1, fault_g2;
+    rt_int32_t timestamp;
+} bench_params_t;
+
+static const pv_json_field_t bench_params_fields[] = {
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_va1, "va1", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_va2, "va2", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_va3, "va3", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_vb1, "vb1", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_vb2, "vb2", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_vb3, "vb3", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_pv1, "pv1", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_pv2, "pv2", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_pv3, "pv3", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_pv4, "pv4", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_pv5, "pv5", 3),
+    PV_JSON_FIELD_FIXED(bench_params_t, volt_pv6, "pv6", 3),
+    PV_JSON_FIELD_INT(bench_params_t, fault_g1, "fault_g1"),
+    PV_JSON_FIELD_INT(bench_params_t, fault_g2, "fault_g2"),
+    PV_JSON_FIELD_INT(bench_params_t, timestamp, "timestamp"),
+};
+static const pv_json_schema_t bench_params_schema = PV_JSON_SCHEMA(bench_params_fields, PV_JSON_LAYOUT_PARAMS);
+
+static bench_dp_t bench_dp[BENCH_DATA_SET];
+static bench_dp_float_t bench_dp_float[BENCH_DATA_SET];
+static bench_params_t bench_params[BENCH_DATA_SET];
+static uint32_t bench_seed = 1;
+
+static uint32_t bench_rand(void)
+{
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return bench_seed >> 8;
+}
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* ========== 改用 pv_json 之前的负载生成 ========== */
+
+static int bench_dp_snprintf(const bench_dp_t *data, const bench_dp_float_t *volt, char *buf, size_t size)
+{
+    return snprintf(buf, size,
+        "{"
+        "\"id\":%d,"
+        "\"dp\":{"
+        "\"va1\":[{\"v\":%.3f}],"
+        "\"va2\":[{\"v\":%.3f}],"
+        "\"va3\":[{\"v\":%.3f}],"
+        "\"vb1\":[{\"v\":%.3f}],"
+        "\"vb2\":[{\"v\":%.3f}],"
+        "\"fault_code_id\":[{\"v\":%d}],"
+        "\"fault_code_str\":[{\"v\":\"%s\"}],"
+        "\"fault_count\":[{\"v\":%d}],"
+        "\"fault_list\":[{\"v\":\"%s\"}],"
+        "\"fault_code_str1\":[{\"v\":\"%s\"}],"
+        "\"fault_code_str2\":[{\"v\":\"%s\"}],"
+        "\"fault_code_str3\":[{\"v\":\"%s\"}],"
+        "\"fault_code_str4\":[{\"v\":\"%s\"}]"
+        "}"
+        "}",
+        (int)data->message_id,
+        volt->va1, volt->va2, volt->va3,
+        volt->vb1, volt->vb2,
+        (int)data->fault_code_id, data->fault_code_str,
+        (int)data->fault_count, data->fault_list,
+        data->fault_code_str1, data->fault_code_str2,
+        data->fault_code_str3, data->fault_code_str4);
+}
+
+static int bench_params_snprintf(const bench_params_t *data, char *buf, size_t size)
+{
+    return snprintf(buf, size,
+        "{"
+            "\"params\":{"
+                "\"va1\":%.3f,"
+                "\"va2\":%.3f,"
+                "\"va3\":%.3f,"
+                "\"vb1\":%.3f,"
+                "\"vb2\":%.3f,"
+                "\"vb3\":%.3f,"
+                "\"pv1\":%.3f,"
+                "\"pv2\":%.3f,"
+                "\"pv3\":%.3f,"
+                "\"pv4\":%.3f,"
+                "\"pv5\":%.3f,"
+                "\"pv6\":%.3f,"
+                "\"fault_g1\":%d,"
+                "\"fault_g2\":%d,"
+                "\"timestamp\":%d"
+            "}"
+        "}",
+        data->volt_va1 / 1000.0f, data->volt_va2 / 1000.0f, data->volt_va3 / 1000.0f,
+        data->volt_vb1 / 1000.0f, data->volt_vb2 / 1000.0f, data->volt_vb3 / 1000.0f,
+        data->volt_pv1 / 1000.0f, data->volt_pv2 / 1000.0f, data->volt_pv3 / 1000.0f,
+        data->volt_pv4 / 1000.0f, data->volt_pv5 / 1000.0f, data->volt_pv6 / 1000.0f,
+        (int)data->fault_g1, (int)data->fault_g2, (int)data->timestamp);
+}
+
+/* ========== 数据 ========== */
+
+static void bench_fault_strings(bench_dp_t *d)
+{
+    int mask = (bench_rand() % 4 == 0) ? (int)(bench_rand() % 32) : 0;
+    int slot = 0;
+    char *slots[4] = {d->fault_code_str1, d->fault_code_str2, d->fault_code_str3, d->fault_code_str4};
+
+    d->fault_count = 0;
+    d->fault_code_id = 0;
+    strcpy(d->fault_list, mask ? "" : "NONE");
+    for (int i = 0; i < 5; i++) {
+        if (mask & (1 << i)) {
+            if (d->fault_count++ == 0) {
+                d->fault_code_id = i + 1;
+            }
+            sprintf(d->fault_list + strlen(d->fault_list), "%sPV%d", d->fault_count > 1 ? "," : "", i + 1);
+            if (slot < 4) {
+                sprintf(slots[slot++], "FAULT_PV%d", i + 1);
+            }
+        }
+    }
+    while (slot < 4) {
+        strcpy(slots[slot++], "PANEL_OK");
+    }
+    if (d->fault_code_id) {
+        sprintf(d->fault_code_str, "FAULT_PV%d", (int)d->fault_code_id);
+    } else {
+        strcpy(d->fault_code_str, "PANEL_OK");
+    }
+}
+
+/* 5倍分压后的节点电压, 每块板 0 ~ 40 V */
+static void bench_data(void)
+{
+    for (int n = 0; n < BENCH_DATA_SET; n++) {
+        bench_dp_t *d = &bench_dp[n];
+        bench_params_t *p = &bench_params[n];
+        rt_uint32_t *volt = &p->volt_va1;
+
+        d->va1_mv = (rt_int32_t)(bench_rand() % 40000);
+        d->va2_mv = d->va1_mv + (rt_int32_t)(bench_rand() % 40000);
+        d->va3_mv = d->va2_mv + (rt_int32_t)(bench_rand() % 40000);
+        d->vb1_mv = (rt_int32_t)(bench_rand() % 40000);
+        d->vb2_mv = d->vb1_mv + (rt_int32_t)(bench_rand() % 40000);
+        d->message_id = n + 1;
+        bench_fault_strings(d);
+
+        bench_dp_float[n].va1 = d->va1_mv / 1000.0f;
+        bench_dp_float[n].va2 = d->va2_mv / 1000.0f;
+        bench_dp_float[n].va3 = d->va3_mv / 1000.0f;
+        bench_dp_float[n].vb1 = d->vb1_mv / 1000.0f;
+        bench_dp_float[n].vb2 = d->vb2_mv / 1000.0f;
+
+        for (int i = 0; i < 12; i++) {
+            volt[i] = bench_rand() % 120000;
+        }
+        p->fault_g1 = (rt_int32_t)(bench_rand() % 4);
+        p->fault_g2 = (rt_int32_t)(bench_rand() % 3);
+        p->timestamp = (rt_int32_t)(bench_rand() * 7);
+    }
+}
+
+/* 两种方法的输出逐条一致 */
+static int bench_check(void)
+{
+    char a[BENCH_BUF_SIZE], b[BENCH_BUF_SIZE];
+    int errors = 0;
+
+    for (int n = 0; n < BENCH_DATA_SET && errors < 3; n++) {
+        int la = bench_dp_snprintf(&bench_dp[n], &bench_dp_float[n], a, sizeof(a));
+        int lb = pv_json_write(&bench_dp_schema, &bench_dp[n], bench_dp[n].message_id, b, sizeof(b));
+
+        if (la != lb || strcmp(a, b) != 0 ||
+            pv_json_schema_size(&bench_dp_schema, &bench_dp[n], bench_dp[n].message_id) != (rt_size_t)lb) {
+            printf("dp %d differs:\n  %s\n  %s\n", n, a, b);
+            errors++;
+        }
+
+        la = bench_params_snprintf(&bench_params[n], a, sizeof(a));
+        lb = pv_json_write(&bench_params_schema, &bench_params[n], 0, b, sizeof(b));
+        if (la != lb || strcmp(a, b) != 0) {
+            printf("params %d differs:\n  %s\n  %s\n", n, a, b);
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+static void bench_report(const char *name, uint64_t ns, long payloads, unsigned sink)
+{
+    printf("%-26s %10.1f   (%x)\n", name, (double)ns / payloads, sink & 0xF);
+}
+
+int main(int argc, char **argv)
+{
+    static char buf[BENCH_BUF_SIZE];
+    long payloads = 500000;
+    unsigned sink = 0;
+    uint64_t start;
+    int c;
+
+    while ((c = getopt(argc, argv, "n:h")) != -1) {
+        switch (c) {
+        case 'n': payloads = strtol(optarg, NULL, 0); break;
+        default:
+            printf("usage: %s [-n payloads]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (payloads <= 0) {
+        return 1;
+    }
+
+    bench_data();
+    if (bench_check() != 0) {
+        return 1;
+    }
+
+    printf("%ld payloads, outputs of snprintf and pv_json identical\n", payloads);
+    printf("case                       ns/payload\n");
+
+    start = bench_now_ns();
+    for (long n = 0; n < payloads; n++) {
+        int i = n % BENCH_DATA_SET;
+        sink += bench_dp_snprintf(&bench_dp[i], &bench_dp_float[i], buf, sizeof(buf));
+    }
+    bench_report("dp snprintf", bench_now_ns() - start, payloads, sink);
+
+    start = bench_now_ns();
+    for (long n = 0; n < payloads; n++) {
+        int i = n % BENCH_DATA_SET;
+        sink += pv_json_write(&bench_dp_schema, &bench_dp[i], bench_dp[i].message_id, buf, sizeof(buf));
+    }
+    bench_report("dp pv_json_write", bench_now_ns() - start, payloads, sink);
+
+    start = bench_now_ns();
+    for (long n = 0; n < payloads; n++) {
+        int i = n % BENCH_DATA_SET;
+        sink += pv_json_schema_size(&bench_dp_schema, &bench_dp[i], bench_dp[i].message_id);
+    }
+    bench_report("dp pv_json_schema_size", bench_now_ns() - start, payloads, sink);
+
+    start = bench_now_ns();
+    for (long n = 0; n < payloads; n++) {
+        sink += bench_params_snprintf(&bench_params[n % BENCH_DATA_SET], buf, sizeof(buf));
+    }
+    bench_report("params snprintf", bench_now_ns() - start, payloads, sink);
+
+    start = bench_now_ns();
+    for (long n = 0; n < payloads; n++) {
+        sink += pv_json_write(&bench_params_schema, &bench_params[n % BENCH_DATA_SET], 0, buf, sizeof(buf));
+    }
+    bench_report("params pv_json_write", bench_now_ns() - start, payloads, sink);
+
+    return 0;
+}
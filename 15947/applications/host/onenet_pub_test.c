@@ -0,0 +1,470 @@
+/* applications/host/onenet_pub_test.c */
+/*
+ * OneNET发布队列的主机测试。直接包含 pv_onenet_client.c, 由测试启动发布队列,
+ * 发送函数换成记录消息的替身: 可以让发送失败, 也可以卡住发送模拟模块无响应。
+ * 模组链路查询打开编译, AT客户端换成按脚本应答的替身。
+ * 每个用例在 fork 出的子进程中运行, 模块的静态变量都是新的。
+ */
+
+#define RT_USING_AT
+#define AT_USING_CLIENT
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include "host_stub.h"
+
+#include "../pv_onenet_client.c"
+
+/* sal.h 中声明, 板子上由 sal_init() 调用 */
+int sal_netbuf_init(void);
+
+#define TEST_MAX_SENDS      64
+
+/*
+ * AT客户端替身: at_obj_exec_cmd_async() 记录命令, 按 modem_csq / modem_cgatt 立即应答
+ * 并调用请求的回调, 也就是回调在入队返回之前执行。modem_up 为0时没有AT客户端。
+ */
+static int modem_up;
+static int modem_csq = 20;
+static int modem_cgatt = 1;
+static char modem_cmds[TEST_MAX_SENDS][16];
+static int modem_cmd_count;
+static struct at_client modem_client;
+
+at_client_t at_client_get_first(void)
+{
+    return modem_up ? &modem_client : RT_NULL;
+}
+
+at_response_t at_create_resp(rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+    at_response_t resp = calloc(1, sizeof(struct at_response));
+
+    resp->buf = calloc(1, buf_size);
+    resp->buf_size = buf_size;
+    resp->line_num = line_num;
+    resp->timeout = timeout;
+    return resp;
+}
+
+void at_cmd_req_init(at_cmd_req_t req, at_response_t resp, at_cmd_cb_t callback, void *user_data)
+{
+    memset(req, 0, sizeof(struct at_cmd_req));
+    req->resp = resp;
+    req->callback = callback;
+    req->user_data = user_data;
+}
+
+int at_obj_exec_cmd_async(at_client_t client, at_cmd_req_t req, const char *cmd_expr, ...)
+{
+    va_list args;
+
+    va_start(args, cmd_expr);
+    vsnprintf(req->cmd, sizeof(req->cmd), cmd_expr, args);
+    va_end(args);
+    if (modem_cmd_count < TEST_MAX_SENDS) {
+        snprintf(modem_cmds[modem_cmd_count], sizeof(modem_cmds[0]), "%.15s", req->cmd);
+    }
+    modem_cmd_count++;
+
+    if (strcmp(req->cmd, "AT+CSQ") == 0) {
+        snprintf(req->resp->buf, req->resp->buf_size, "+CSQ: %d,99", modem_csq);
+    } else {
+        snprintf(req->resp->buf, req->resp->buf_size, "+CGATT: %d", modem_cgatt);
+    }
+    req->result = RT_EOK;
+    req->callback(client, req, RT_EOK);
+
+    return RT_EOK;
+}
+
+/* 替身的应答只有一行 */
+int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const char *resp_expr, ...)
+{
+    va_list args;
+    int count;
+
+    if (strstr(resp->buf, keyword) == RT_NULL) {
+        return -1;
+    }
+    va_start(args, resp_expr);
+    count = vsscanf(resp->buf, resp_expr, args);
+    va_end(args);
+    return count;
+}
+
+
+/* 发送函数替身 */
+static pthread_mutex_t stub_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t stub_cond = PTHREAD_COND_INITIALIZER;
+static char stub_sent[TEST_MAX_SENDS][64];     // 按发送顺序记录的负载
+static const rt_uint8_t *stub_data[TEST_MAX_SENDS];    // 负载的地址
+static int stub_calls;
+static int stub_fail;                          // 为1时发送失败
+static int stub_hold;                          // 为1时发送卡住, 直到清零
+static pthread_t stub_thread;                  // 第一次发送所在的线程
+static int stub_other_thread;                  // 在其他线程中被调用的次数
+
+static int test_errors;
+
+#define TEST_CHECK(expr)                                            \
+    do {                                                            \
+        if (!(expr)) {                                              \
+            printf("  line %d: %s\n", __LINE__, #expr);             \
+            test_errors++;                                          \
+        }                                                           \
+    } while (0)
+
+static int stub_transport(rt_uint8_t kind, const char *topic, const rt_uint8_t *payload, rt_size_t len)
+{
+    int result;
+
+    pthread_mutex_lock(&stub_lock);
+    if (stub_calls == 0) {
+        stub_thread = pthread_self();
+    } else if (!pthread_equal(stub_thread, pthread_self())) {
+        stub_other_thread++;
+    }
+    if (stub_calls < TEST_MAX_SENDS) {
+        snprintf(stub_sent[stub_calls], sizeof(stub_sent[0]), "%.*s", (int)len, (const char *)payload);
+        stub_data[stub_calls] = payload;
+    }
+    stub_calls++;
+    pthread_cond_broadcast(&stub_cond);
+    while (stub_hold) {
+        pthread_cond_wait(&stub_cond, &stub_lock);
+    }
+    result = stub_fail ? -1 : 0;
+    pthread_mutex_unlock(&stub_lock);
+
+    return result;
+}
+
+static void stub_set(int *flag, int value)
+{
+    pthread_mutex_lock(&stub_lock);
+    *flag = value;
+    pthread_cond_broadcast(&stub_cond);
+    pthread_mutex_unlock(&stub_lock);
+}
+
+/* 等到替身被调用了 calls 次 */
+static void stub_wait_calls(int calls)
+{
+    pthread_mutex_lock(&stub_lock);
+    while (stub_calls < calls) {
+        pthread_cond_wait(&stub_cond, &stub_lock);
+    }
+    pthread_mutex_unlock(&stub_lock);
+}
+
+/* 等到队列清空 (最多约1s) */
+static void test_wait_idle(void)
+{
+    for (int i = 0; i < 1000 && pv_onenet_publish_backlog() > 0; i++) {
+        usleep(1000);
+    }
+}
+
+/* 正在使用的网络缓冲数 */
+static int test_netbuf_used(void)
+{
+    struct sal_netbuf_stats stats;
+
+    sal_netbuf_get_stats(&stats);
+    return stats.used;
+}
+
+static void test_start(void)
+{
+    sal_netbuf_init();
+    pv_onenet_set_transport(stub_transport);
+    TEST_CHECK(pub_queue_init() == RT_EOK);
+    onenet_connected = RT_TRUE;
+}
+
+static void test_async_order(void)
+{
+    char text[16];
+
+    test_start();
+    for (int i = 0; i < PV_ONENET_PUB_POOL; i++) {
+        snprintf(text, sizeof(text), "m%d", i);
+        TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", text, strlen(text)) == RT_EOK);
+    }
+    test_wait_idle();
+
+    TEST_CHECK(stub_calls == PV_ONENET_PUB_POOL);
+    for (int i = 0; i < PV_ONENET_PUB_POOL && i < stub_calls; i++) {
+        snprintf(text, sizeof(text), "m%d", i);
+        TEST_CHECK(strcmp(stub_sent[i], text) == 0);
+    }
+    TEST_CHECK(pub_stat_sent == PV_ONENET_PUB_POOL);
+}
+
+static void test_pool_full(void)
+{
+    test_start();
+    stub_set(&stub_hold, 1);
+
+    /* 第一条被发布线程取走并卡住, 之后的填满缓冲池 */
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "x", 1) == RT_EOK);
+    stub_wait_calls(1);
+    for (int i = 1; i < PV_ONENET_PUB_POOL; i++) {
+        TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "x", 1) == RT_EOK);
+    }
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "x", 1) == -RT_EFULL);
+    TEST_CHECK(pv_onenet_publish_backlog() == PV_ONENET_PUB_POOL);
+
+    stub_set(&stub_hold, 0);
+    test_wait_idle();
+    TEST_CHECK(stub_calls == PV_ONENET_PUB_POOL);
+    TEST_CHECK(pub_stat_rejected == 1);
+    TEST_CHECK(test_netbuf_used() == 0);
+}
+
+static void test_publish_netbuf(void)
+{
+    struct sal_netbuf *nb, *full[SAL_NETBUF_BLOCK_NUM];
+    int i;
+
+    test_start();
+    stub_set(&stub_hold, 1);
+
+    /* 负载写在网络缓冲中, 发布线程拿到的是同一块内存 */
+    nb = sal_netbuf_alloc();
+    TEST_CHECK(nb != RT_NULL);
+    nb->len = snprintf((char *)nb->payload, sal_netbuf_space(nb), "{\"pv1\":1}");
+    TEST_CHECK(pv_onenet_publish_netbuf(PV_ONENET_PUB_STRING, "t", nb) == RT_EOK);
+    stub_wait_calls(1);
+    TEST_CHECK(stub_data[0] == nb->payload);
+    TEST_CHECK(strcmp(stub_sent[0], "{\"pv1\":1}") == 0);
+
+    /* 调用者放掉自己的引用后, 队列的引用还在, 发出后缓冲才回到池中 */
+    TEST_CHECK(nb->ref == 2);
+    TEST_CHECK(sal_netbuf_free(nb) == 0);
+    TEST_CHECK(test_netbuf_used() == 1);
+    stub_set(&stub_hold, 0);
+    test_wait_idle();
+    TEST_CHECK(pub_stat_sent == 1);
+    TEST_CHECK(test_netbuf_used() == 0);
+
+    /* 多于一个缓冲的链不收 */
+    nb = RT_NULL;
+    TEST_CHECK(sal_netbuf_append(&nb, "ab", 2) == 2);
+    sal_netbuf_cat(nb, sal_netbuf_alloc());
+    TEST_CHECK(pv_onenet_publish_netbuf(PV_ONENET_PUB_RAW, "t", nb) == -RT_EINVAL);
+    TEST_CHECK(nb->ref == 1);
+    TEST_CHECK(sal_netbuf_free(nb) == 2);
+
+    /* 网络缓冲用完时拷贝入队返回 -RT_EFULL */
+    for (i = 0; i < SAL_NETBUF_BLOCK_NUM; i++) {
+        full[i] = sal_netbuf_alloc();
+    }
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "x", 1) == -RT_EFULL);
+    TEST_CHECK(pub_stat_rejected == 1);
+    for (i = 0; i < SAL_NETBUF_BLOCK_NUM; i++) {
+        sal_netbuf_free(full[i]);
+    }
+    TEST_CHECK(test_netbuf_used() == 0);
+}
+
+static void test_async_retry(void)
+{
+    test_start();
+    stub_set(&stub_fail, 1);
+
+    /* 第一次发送加 PV_ONENET_PUB_RETRY_MAX 次重发, 之后丢弃 */
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "lost", 4) == RT_EOK);
+    test_wait_idle();
+    TEST_CHECK(stub_calls == PV_ONENET_PUB_RETRY_MAX + 1);
+    TEST_CHECK(pub_stat_expired == 1);
+
+    /* 失败一次后恢复, 重发成功 */
+    pthread_mutex_lock(&stub_lock);
+    stub_calls = 0;
+    pthread_mutex_unlock(&stub_lock);
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "kept", 4) == RT_EOK);
+    stub_wait_calls(1);
+    stub_set(&stub_fail, 0);
+    test_wait_idle();
+    TEST_CHECK(stub_calls == 2);
+    TEST_CHECK(strcmp(stub_sent[1], "kept") == 0);
+    TEST_CHECK(pub_stat_sent == 1);
+}
+
+/* 模组报告未附着时发送失败不计重发次数, 链路恢复后发出 */
+static void test_link_down(void)
+{
+    modem_up = 1;
+    modem_cgatt = 0;
+    test_start();
+    stub_set(&stub_fail, 1);
+
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "held", 4) == RT_EOK);
+    stub_wait_calls(PV_ONENET_PUB_RETRY_MAX + 3);
+    stub_set(&stub_fail, 0);
+    test_wait_idle();
+
+    TEST_CHECK(pub_stat_expired == 0);
+    TEST_CHECK(pub_stat_sent == 1);
+    TEST_CHECK(pub_stat_link_down >= PV_ONENET_PUB_RETRY_MAX + 2);
+    TEST_CHECK(strcmp(stub_sent[stub_calls - 1], "held") == 0);
+    /* 每次失败查询一次, 两条命令按顺序入队 */
+    TEST_CHECK(link_probes == stub_calls - 1);
+    TEST_CHECK(modem_cmd_count == 2 * (stub_calls - 1));
+    TEST_CHECK(strcmp(modem_cmds[0], "AT+CSQ") == 0);
+    TEST_CHECK(strcmp(modem_cmds[1], "AT+CGATT?") == 0);
+    TEST_CHECK(link_rssi == 20 && link_attached == 0);
+    TEST_CHECK(test_netbuf_used() == 0);
+
+    /* 已附着但无信号也算链路断开; 信号和附着都正常时照常计重发次数并丢弃 */
+    pthread_mutex_lock(&stub_lock);
+    stub_calls = 0;
+    pthread_mutex_unlock(&stub_lock);
+    modem_cgatt = 1;
+    modem_csq = 99;
+    stub_set(&stub_fail, 1);
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "lost", 4) == RT_EOK);
+    stub_wait_calls(2);
+    modem_csq = 20;
+    test_wait_idle();
+    TEST_CHECK(pub_stat_expired == 1);
+    TEST_CHECK(stub_calls == PV_ONENET_PUB_RETRY_MAX + 2 || stub_calls == PV_ONENET_PUB_RETRY_MAX + 3);
+}
+
+static void test_publish_wait(void)
+{
+    static char big[PV_ONENET_PUB_PAYLOAD_SIZE * 4];
+
+    test_start();
+
+    /* 未连接时异步消息留在队列中, 等待发送的消息照常发出 */
+    onenet_connected = RT_FALSE;
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "async", 5) == RT_EOK);
+    TEST_CHECK(pv_onenet_publish(PV_ONENET_PUB_RAW, "t", "sync", 4, RT_WAITING_FOREVER) == RT_EOK);
+    TEST_CHECK(stub_calls == 1);
+    TEST_CHECK(strcmp(stub_sent[0], "sync") == 0);
+    TEST_CHECK(pv_onenet_publish_backlog() == 1);
+
+    onenet_connected = RT_TRUE;
+    rt_sem_release(&pub_sem);
+    test_wait_idle();
+    TEST_CHECK(stub_calls == 2);
+
+    /* 负载不拷贝, 不受缓冲大小限制 */
+    memset(big, 'b', sizeof(big));
+    TEST_CHECK(pv_onenet_publish(PV_ONENET_PUB_RAW, "t", big, sizeof(big), RT_WAITING_FOREVER) == RT_EOK);
+    TEST_CHECK(stub_calls == 3);
+
+    /* 发送失败立即返回, 不在队列中重发 */
+    stub_set(&stub_fail, 1);
+    TEST_CHECK(pv_onenet_publish(PV_ONENET_PUB_RAW, "t", "fail", 4, RT_WAITING_FOREVER) == -RT_ERROR);
+    TEST_CHECK(stub_calls == 4);
+    TEST_CHECK(pv_onenet_publish_backlog() == 0);
+    TEST_CHECK(pub_stat_retransmits == 0);
+}
+
+static void test_publish_timeout(void)
+{
+    test_start();
+    stub_set(&stub_hold, 1);
+
+    /* 发送卡住时, 排在后面的消息超时撤回, 不会再被发送 */
+    TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "stuck", 5) == RT_EOK);
+    stub_wait_calls(1);
+    TEST_CHECK(pv_onenet_publish(PV_ONENET_PUB_RAW, "t", "late", 4, rt_tick_from_millisecond(50)) == -RT_ETIMEOUT);
+    TEST_CHECK(pv_onenet_publish_backlog() == 1);
+
+    stub_set(&stub_hold, 0);
+    test_wait_idle();
+    TEST_CHECK(stub_calls == 1);
+}
+
+static void *test_publisher_entry(void *arg)
+{
+    char text[16];
+
+    for (int i = 0; i < 8; i++) {
+        snprintf(text, sizeof(text), "w%ld.%d", (long)(intptr_t)arg, i);
+        TEST_CHECK(pv_onenet_publish(PV_ONENET_PUB_RAW, "t", text, strlen(text), RT_WAITING_FOREVER) == RT_EOK);
+    }
+    return NULL;
+}
+
+static void test_single_sender(void)
+{
+    pthread_t threads[3];
+
+    test_start();
+    for (int i = 0; i < 3; i++) {
+        pthread_create(&threads[i], NULL, test_publisher_entry, (void *)(intptr_t)i);
+    }
+    for (int i = 0; i < 3; i++) {
+        TEST_CHECK(pv_onenet_publish_async(PV_ONENET_PUB_RAW, "t", "a", 1) == RT_EOK);
+    }
+    for (int i = 0; i < 3; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    test_wait_idle();
+
+    TEST_CHECK(stub_calls == 3 * 8 + 3);
+    TEST_CHECK(stub_other_thread == 0);
+    TEST_CHECK(!pthread_equal(stub_thread, pthread_self()));
+}
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} test_cases[] = {
+    {"async in order", test_async_order},
+    {"pool full", test_pool_full},
+    {"publish netbuf", test_publish_netbuf},
+    {"async retry and expire", test_async_retry},
+    {"link down not counted", test_link_down},
+    {"publish and wait", test_publish_wait},
+    {"publish timeout", test_publish_timeout},
+    {"one sending thread", test_single_sender},
+};
+
+/* 在子进程中运行用例, 返回0表示通过 */
+static int test_run(void (*run)(void))
+{
+    pid_t pid;
+    int status;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0) {
+        host_time_scale = 100;
+        host_quiet = 1;
+        run();
+        fflush(stdout);
+        _exit(test_errors ? 1 : 0);
+    }
+    if (pid < 0 || waitpid(pid, &status, 0) != pid) {
+        return -1;
+    }
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+}
+
+int main(void)
+{
+    int i, result, failed = 0;
+
+    for (i = 0; i < (int)(sizeof(test_cases) / sizeof(test_cases[0])); i++) {
+        result = test_run(test_cases[i].run);
+        printf("%-32s %s\n", test_cases[i].name, result == 0 ? "ok" : "FAILED");
+        if (result != 0) {
+            failed++;
+        }
+    }
+    printf("%d of %d passed\n", i - failed, i);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+/* applications/host/rtconfig.h */
+/* 主机构建使用的配置, 代替BSP的 rtconfig.h, 只打开应用模块用到的内核功能 */
+
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_EVENT
+#define RT_USING_MAILBOX
+#define RT_USING_MESSAGEQUEUE
+#define RT_USING_HEAP
+#define RT_USING_DEVICE
+#define RT_USING_CONSOLE
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMSET
+#define RT_KSERVICE_USING_STDLIB_MEMCPY
+
+/* 闪存分区由 fal_mock.c 模拟 */
+#define RT_USING_FAL
+
+/* 发布队列的负载放在SAL网络缓冲池中, 与板子相同 */
+#define SAL_USING_NETBUF
+#define SAL_NETBUF_BLOCK_SIZE 512
+#define SAL_NETBUF_BLOCK_NUM 8
+
+#endif /* RT_CONFIG_H__ */
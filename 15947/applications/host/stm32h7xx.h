@@ -0,0 +1,34 @@
+/* applications/host/stm32h7xx.h */
+/*
+ * 主机构建中代替CMSIS设备头文件, 只提供 pv_trace.c 用到的DWT周期计数器。
+ * SystemCoreClock 为1GHz, 每次读 DWT 时 CYCCNT 更新为单调时钟的纳秒数,
+ * 回放统计中的"周期"即纳秒。
+ */
+
+#ifndef STM32H7XX_H
+#define STM32H7XX_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+    volatile uint32_t LAR;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24)
+
+extern uint32_t SystemCoreClock;
+extern CoreDebug_Type host_core_debug;
+
+DWT_Type *host_dwt(void);
+
+#define DWT                 (host_dwt())
+#define CoreDebug           (&host_core_debug)
+
+#endif // STM32H7XX_H
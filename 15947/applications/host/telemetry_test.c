@@ -0,0 +1,490 @@
+/* applications/host/telemetry_test.c */
+/*
+ * 遥测存储转发的主机测试。发布函数换成本地MQTT替身: 链路可以断开, 收到的消息按主题
+ * 记录并解码 (JSON取 va1 数据流的时间戳, 增量二进制完整解码)。闪存分区由 fal_mock.c
+ * 模拟在共享内存中, 每个用例在 fork 出的子进程中运行, 模块的静态变量都是新的,
+ * 闪存内容则可以跨"重启"保留。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "../pv_cloud_config.h"
+#include "../pv_telemetry.h"
+#include "fal.h"
+#include "host_stub.h"
+
+#define TEST_FLASH_SIZE     (16 * 4096)
+#define TEST_MAX_RECORDS    1024
+#define TEST_MAX_MESSAGES   1024
+#define TEST_TIME0          1700000000UL
+
+/* 闪存日志格式, 与 pv_telemetry.c 一致 */
+#define TEST_SECTOR_SIZE    4096
+#define TEST_HEADER_SIZE    16
+#define TEST_SLOTS          ((TEST_SECTOR_SIZE - TEST_HEADER_SIZE) / sizeof(pv_telemetry_record_t))
+#define TEST_FLASH_MAGIC    0x50564C47
+
+typedef struct {
+    int delta;                                  // 1: 增量二进制主题
+    int count;                                  // 消息中的记录数
+    int len;                                    // 负载长度
+} test_message_t;
+
+/* 本地MQTT替身 */
+static pthread_mutex_t broker_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile int broker_up = 1;
+static test_message_t broker_messages[TEST_MAX_MESSAGES];
+static int broker_message_count;
+static pv_telemetry_record_t broker_records[TEST_MAX_RECORDS];
+static int broker_record_count;
+static int broker_bad_payloads;
+
+static uint8_t *test_flash;
+static int test_errors;
+
+#define TEST_CHECK(expr)                                            \
+    do {                                                            \
+        if (!(expr)) {                                              \
+            printf("  line %d: %s\n", __LINE__, #expr);             \
+            test_errors++;                                          \
+        }                                                           \
+    } while (0)
+
+static void broker_add_record(const pv_telemetry_record_t *record)
+{
+    if (broker_record_count < TEST_MAX_RECORDS) {
+        broker_records[broker_record_count] = *record;
+    }
+    broker_record_count++;
+}
+
+/* 从 va1 数据流取出每个数据点的时间戳, 返回数据点数, 格式不对时返回-1 */
+static int broker_decode_json(const char *payload, int len)
+{
+    const char *p = strstr(payload, "\"va1\":[");
+    int count = 0;
+
+    if (len < 2 || strncmp(payload, "{\"id\":", 6) != 0 || strcmp(payload + len - 2, "}}") != 0 || p == NULL) {
+        return -1;
+    }
+    p += 7;
+    while (*p == '{') {
+        pv_telemetry_record_t record;
+        unsigned long long t;
+        unsigned int volts, millivolts;
+        int used;
+
+        if (sscanf(p, "{\"v\":%u.%3u,\"t\":%llu}%n", &volts, &millivolts, &t, &used) != 3) {
+            return -1;
+        }
+        memset(&record, 0, sizeof(record));
+        record.timestamp = (uint32_t)(t / 1000);
+        record.mv[PV_TELEMETRY_VA1] = (uint16_t)(volts * 1000 + millivolts);
+        broker_add_record(&record);
+        count++;
+        p += used;
+        if (*p == ',') {
+            p++;
+        }
+    }
+
+    return (*p == ']') ? count : -1;
+}
+
+static uint32_t broker_get_varint(const uint8_t **p)
+{
+    uint32_t value = 0;
+
+    for (int shift = 0; ; shift += 7) {
+        uint8_t b = *(*p)++;
+
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return value;
+        }
+    }
+}
+
+static int32_t broker_get_signed(const uint8_t **p)
+{
+    uint32_t v = broker_get_varint(p);
+
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static uint32_t broker_get_le(const uint8_t **p, int bytes)
+{
+    uint32_t value = 0;
+
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint32_t)*(*p)++ << (8 * i);
+    }
+
+    return value;
+}
+
+/* 完整解码增量二进制负载, 返回记录数, 格式不对时返回-1 */
+static int broker_decode_delta(const uint8_t *payload, int len)
+{
+    const uint8_t *p = payload + 2;
+    pv_telemetry_record_t record;
+    int n;
+
+    if (len < 2 || payload[0] != PV_TELEMETRY_DELTA_VERSION || payload[1] == 0) {
+        return -1;
+    }
+    n = payload[1];
+
+    memset(&record, 0, sizeof(record));
+    record.timestamp = broker_get_le(&p, 4);
+    for (int ch = 0; ch < PV_TELEMETRY_CHANNELS; ch++) {
+        record.mv[ch] = (uint16_t)broker_get_le(&p, 2);
+    }
+    record.fault_code = *p++;
+    record.fault_mask = *p++;
+    record.flags = *p++;
+    broker_add_record(&record);
+
+    for (int i = 1; i < n; i++) {
+        record.timestamp += (uint32_t)broker_get_signed(&p);
+        for (int ch = 0; ch < PV_TELEMETRY_CHANNELS; ch++) {
+            record.mv[ch] = (uint16_t)(record.mv[ch] + broker_get_signed(&p));
+        }
+        if (*p++) {
+            record.fault_code = *p++;
+            record.fault_mask = *p++;
+            record.flags = *p++;
+        }
+        broker_add_record(&record);
+    }
+
+    return (p == payload + len) ? n : -1;
+}
+
+static int broker_publish(const char *topic, const rt_uint8_t *payload, rt_size_t len)
+{
+    test_message_t *m;
+    int count;
+
+    if (!broker_up) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&broker_lock);
+    m = &broker_messages[broker_message_count % TEST_MAX_MESSAGES];
+    m->len = (int)len;
+    if (strcmp(topic, PV_TELEMETRY_DELTA_TOPIC) == 0) {
+        m->delta = 1;
+        count = broker_decode_delta(payload, (int)len);
+    } else if (strcmp(topic, PV_TELEMETRY_TOPIC) == 0) {
+        /* 负载以 '\0' 结尾, 但长度不含它 */
+        m->delta = 0;
+        count = (payload[len] == '\0') ? broker_decode_json((const char *)payload, (int)len) : -1;
+    } else {
+        count = -1;
+    }
+    m->count = count;
+    if (count <= 0) {
+        broker_bad_payloads++;
+    }
+    broker_message_count++;
+    pthread_mutex_unlock(&broker_lock);
+
+    return 0;
+}
+
+/* 第 i 条测试记录: 电压缓慢变化, 每50条切换一次故障状态 */
+static void test_make_record(pv_telemetry_record_t *record, int i)
+{
+    memset(record, 0, sizeof(*record));
+    record->timestamp = TEST_TIME0 + i;
+    record->mv[PV_TELEMETRY_VA1] = (uint16_t)(1000 + i);
+    for (int ch = 1; ch < PV_TELEMETRY_CHANNELS; ch++) {
+        record->mv[ch] = (uint16_t)(ch * 9000 + (i * 7 % 23) - 11);
+    }
+    if ((i / 50) & 1) {
+        record->fault_code = 2;
+        record->fault_mask = 0x02;
+    }
+    record->flags = PV_TELEMETRY_FLAG_HAS_VB3 | PV_TELEMETRY_FLAG_BASELINE;
+}
+
+static void test_push(int first, int count)
+{
+    pv_telemetry_record_t record;
+
+    for (int i = first; i < first + count; i++) {
+        test_make_record(&record, i);
+        TEST_CHECK(pv_telemetry_push(&record) == RT_EOK);
+        usleep(200);
+    }
+}
+
+/* 等待积压清空, 返回0表示成功; 之后替身记录的消息可以直接读 */
+static int test_wait_drained(void)
+{
+    for (int i = 0; i < 5000; i++) {
+        pthread_mutex_lock(&broker_lock);
+        rt_uint32_t backlog = pv_telemetry_backlog();
+        pthread_mutex_unlock(&broker_lock);
+        if (backlog == 0) {
+            return 0;
+        }
+        usleep(1000);
+    }
+    return -1;
+}
+
+/*
+ * 检查收到的记录: 每条恰好是 first 起连续 count 条中的一条, 全部收到,
+ * 首次收到的顺序与压入顺序一致; 重复 (至少一次语义) 的条数不超过 max_dup
+ */
+static void test_check_received(int first, int count, int max_dup)
+{
+    int next = first, dup = 0;
+
+    for (int i = 0; i < broker_record_count && i < TEST_MAX_RECORDS; i++) {
+        int seq = (int)(broker_records[i].timestamp - TEST_TIME0);
+
+        if (seq == next) {
+            next++;
+        } else if (seq >= first && seq < next) {
+            dup++;
+        } else {
+            printf("  record %d: seq %d, expected %d\n", i, seq, next);
+            test_errors++;
+            return;
+        }
+    }
+    TEST_CHECK(next == first + count);
+    TEST_CHECK(dup <= max_dup);
+    TEST_CHECK(broker_bad_payloads == 0);
+}
+
+static void test_link_up(void)
+{
+    TEST_CHECK(pv_telemetry_init() == RT_EOK);
+    pv_telemetry_set_publisher(broker_publish);
+
+    test_push(0, 300);
+    TEST_CHECK(test_wait_drained() == 0);
+
+    test_check_received(0, 300, 0);
+    for (int i = 0; i < broker_message_count && i < TEST_MAX_MESSAGES; i++) {
+        TEST_CHECK(broker_messages[i].count <= PV_TELEMETRY_BATCH_MAX);
+    }
+}
+
+static void test_outage(void)
+{
+    TEST_CHECK(pv_telemetry_init() == RT_EOK);
+    pv_telemetry_set_publisher(broker_publish);
+
+    /* 断网期间的记录超过RAM缓冲, 转存到闪存 */
+    broker_up = 0;
+    test_push(0, 3 * PV_TELEMETRY_RAM_RECORDS);
+    usleep(100 * 1000);
+    TEST_CHECK(pv_telemetry_backlog() == 3 * PV_TELEMETRY_RAM_RECORDS);
+    TEST_CHECK(broker_message_count == 0);
+
+    broker_up = 1;
+    TEST_CHECK(test_wait_drained() == 0);
+    test_check_received(0, 3 * PV_TELEMETRY_RAM_RECORDS, PV_TELEMETRY_SPILL_BATCH);
+
+    /* 恢复后的新记录排在积压之后 */
+    broker_record_count = 0;
+    test_push(3 * PV_TELEMETRY_RAM_RECORDS, 20);
+    TEST_CHECK(test_wait_drained() == 0);
+    test_check_received(3 * PV_TELEMETRY_RAM_RECORDS, 20, 0);
+}
+
+/* 断网时压入记录后直接退出, 相当于掉电: 只有已转存到闪存的记录留下 */
+static void test_reboot_before(void)
+{
+    TEST_CHECK(pv_telemetry_init() == RT_EOK);
+    pv_telemetry_set_publisher(broker_publish);
+
+    broker_up = 0;
+    test_push(0, 200);
+    usleep(100 * 1000);
+}
+
+static void test_reboot_after(void)
+{
+    int received;
+
+    host_quiet = 1;
+    TEST_CHECK(pv_telemetry_init() == RT_EOK);
+    host_quiet = 0;
+    TEST_CHECK(pv_telemetry_backlog() >= 200 - PV_TELEMETRY_SPILL_BATCH);
+    pv_telemetry_set_publisher(broker_publish);
+
+    /* 推一条记录唤醒上传线程 */
+    test_push(1000, 1);
+    TEST_CHECK(test_wait_drained() == 0);
+
+    /* 闪存中的记录 0 ~ k-1 都收到, 然后是新记录 */
+    received = broker_record_count - 1;
+    TEST_CHECK(received >= 200 - PV_TELEMETRY_SPILL_BATCH && received % PV_TELEMETRY_SPILL_BATCH == 0);
+    broker_record_count = received;
+    test_check_received(0, received, 0);
+}
+
+/* 再次重启: 已发布的记录不再发布 */
+static void test_reboot_again(void)
+{
+    host_quiet = 1;
+    TEST_CHECK(pv_telemetry_init() == RT_EOK);
+    host_quiet = 0;
+    TEST_CHECK(pv_telemetry_backlog() == 0);
+}
+
+/* 直接写一个写满的日志扇区, 记录 first 起; acked 为1时最后一条已确认发布 */
+static void test_write_sector(uint32_t seq, int first, int acked)
+{
+    uint8_t *sector = test_flash + seq * TEST_SECTOR_SIZE;
+    uint32_t header[4] = {TEST_FLASH_MAGIC, seq, 0, 0};
+    pv_telemetry_record_t record;
+
+    memcpy(sector, header, sizeof(header));
+    for (int i = 0; i < (int)TEST_SLOTS; i++) {
+        test_make_record(&record, first + i);
+        if (!acked || i != (int)TEST_SLOTS - 1) {
+            record.flags |= PV_TELEMETRY_FLAG_PENDING;
+        }
+        memcpy(sector + TEST_HEADER_SIZE + i * sizeof(record), &record, sizeof(record));
+    }
+}
+
+/* 最新扇区恰好写满且已全部发布: 恢复后没有积压, 新记录写到下一扇区 */
+static void test_reboot_full_sector(void)
+{
+    test_write_sector(0, 0, 1);
+    test_write_sector(1, TEST_SLOTS, 1);
+
+    host_quiet = 1;
+    TEST_CHECK(pv_telemetry_init() == RT_EOK);
+    host_quiet = 0;
+    TEST_CHECK(pv_telemetry_backlog() == 0);
+    pv_telemetry_set_publisher(broker_publish);
+
+    test_push(1000, 1);
+    TEST_CHECK(test_wait_drained() == 0);
+    test_check_received(1000, 1, 0);
+}
+
+static void test_delta(void)
+{
+    pv_telemetry_record_t expect;
+    int records = 0, bytes = 0, json_bytes = 0;
+
+    TEST_CHECK(pv_telemetry_init() == RT_EOK);
+    pv_telemetry_set_publisher(broker_publish);
+
+    /* 同样的记录先以JSON发布一次, 比较负载大小 (JSON一批放不下16条, 会分成几条消息) */
+    broker_up = 0;
+    test_push(0, PV_TELEMETRY_BATCH_MAX);
+    broker_up = 1;
+    TEST_CHECK(test_wait_drained() == 0);
+    test_check_received(0, PV_TELEMETRY_BATCH_MAX, 0);
+    for (int i = 0; i < broker_message_count && i < TEST_MAX_MESSAGES; i++) {
+        TEST_CHECK(!broker_messages[i].delta && broker_messages[i].len < PV_TELEMETRY_PAYLOAD_SIZE);
+        json_bytes += broker_messages[i].len;
+    }
+
+    broker_message_count = 0;
+    broker_record_count = 0;
+    TEST_CHECK(pv_telemetry_set_format(PV_TELEMETRY_FORMAT_DELTA) == RT_EOK);
+    TEST_CHECK(pv_telemetry_set_format(7) == -RT_EINVAL);
+    broker_up = 0;
+    test_push(0, 120);
+    broker_up = 1;
+    TEST_CHECK(test_wait_drained() == 0);
+
+    /* 逐字段一致, 只有 PENDING 标志去掉 */
+    TEST_CHECK(broker_record_count == 120);
+    for (int i = 0; i < broker_record_count && i < 120; i++) {
+        test_make_record(&expect, i);
+        if (memcmp(&broker_records[i], &expect, sizeof(expect)) != 0) {
+            printf("  record %d differs\n", i);
+            test_errors++;
+            break;
+        }
+    }
+    for (int i = 0; i < broker_message_count && i < TEST_MAX_MESSAGES; i++) {
+        TEST_CHECK(broker_messages[i].delta);
+        records += broker_messages[i].count;
+        bytes += broker_messages[i].len;
+    }
+    TEST_CHECK(records == 120);
+    TEST_CHECK(broker_message_count == (120 + PV_TELEMETRY_BATCH_MAX - 1) / PV_TELEMETRY_BATCH_MAX);
+    printf("  JSON %d bytes/record, delta %d bytes/record\n",
+           json_bytes / PV_TELEMETRY_BATCH_MAX, bytes / records);
+}
+
+/* erase 为1的用例从擦除过的闪存开始, 其余沿用上一个用例留下的闪存 */
+static const struct {
+    const char *name;
+    void (*run)(void);
+    int erase;
+} test_cases[] = {
+    {"link up", test_link_up, 1},
+    {"outage spills and drains", test_outage, 1},
+    {"power loss while offline", test_reboot_before, 1},
+    {"recovered from flash", test_reboot_after, 0},
+    {"published records not resent", test_reboot_again, 0},
+    {"full head sector not resent", test_reboot_full_sector, 1},
+    {"delta binary payload", test_delta, 1},
+};
+
+/* 在子进程中运行用例, 返回0表示通过 */
+static int test_run(void (*run)(void))
+{
+    pid_t pid;
+    int status;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0) {
+        host_time_scale = 100;
+        host_quiet = 1;
+        fal_mock_init(PV_TELEMETRY_PARTITION, test_flash, TEST_FLASH_SIZE);
+        run();
+        fflush(stdout);
+        _exit(test_errors ? 1 : 0);
+    }
+    if (pid < 0 || waitpid(pid, &status, 0) != pid) {
+        return -1;
+    }
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+}
+
+int main(void)
+{
+    int i, result, failed = 0;
+
+    test_flash = mmap(NULL, TEST_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (test_flash == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    for (i = 0; i < (int)(sizeof(test_cases) / sizeof(test_cases[0])); i++) {
+        if (test_cases[i].erase) {
+            memset(test_flash, 0xFF, TEST_FLASH_SIZE);
+        }
+        result = test_run(test_cases[i].run);
+        printf("%-32s %s\n", test_cases[i].name, result == 0 ? "ok" : "FAILED");
+        if (result != 0) {
+            failed++;
+        }
+    }
+    printf("%d of %d passed\n", i - failed, i);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+/* applications/host/trace_replay.c */
+/*
+ * pv_trace 录制文件的主机回放: 与板上的 pv_trace_replay 命令是同一份代码
+ * (直接包含 pv_trace.c), 录制文件从板上的DFS拷出后在 PC 上调阈值。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* 主机上文件由 libc 读写, 相当于启用了DFS */
+#define RT_USING_DFS
+#include "../pv_trace.c"
+#include "trace_synth.h"
+
+static void usage(const char *name)
+{
+    printf("usage: %s [-d drop%%] [-s slack%%] file...   回放录制文件\n", name);
+    printf("       %s -g file                          写一个合成的录制文件\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    const char *synth = NULL;
+    int drop_pct = 0, slack_pct = 0, failed = 0;
+    int c;
+
+    while ((c = getopt(argc, argv, "d:s:g:h")) != -1) {
+        switch (c) {
+        case 'd': drop_pct = atoi(optarg); break;
+        case 's': slack_pct = atoi(optarg); break;
+        case 'g': synth = optarg; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (synth != NULL) {
+        if (trace_synth_write(synth, TRACE_SYNTH_DAY_SECONDS, 900, trace_synth_day, trace_synth_day_count) != 0) {
+            perror(synth);
+            return 1;
+        }
+        return 0;
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    for (int i = optind; i < argc; i++) {
+        if (trace_replay(argv[i], drop_pct, slack_pct) != 0) {
+            failed++;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+/* applications/host/trace_replay_test.c */
+/*
+ * 回放的主机测试: 写合成的录制文件, 经 pv_trace.c 的回放 (拓扑换算+故障引擎+诊断模块)
+ * 后检查引擎的检测数、漏检、延迟和误报帧数。回放结果从输出中解析。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define RT_USING_DFS
+#include "../pv_trace.c"
+#include "trace_synth.h"
+
+#define TEST_PANEL_MV       900
+
+typedef struct {
+    int result;
+    int frames;
+    int detected;
+    int missed;
+    int latency_avg_ms;
+    int latency_max_ms;
+    int fp_frames;
+    int anomaly_missed;                 // 基本异常检测的漏检数, 没有输出时为-1
+} test_replay_t;
+
+static char test_path[64];
+static int test_errors;
+
+#define TEST_CHECK(expr)                                            \
+    do {                                                            \
+        if (!(expr)) {                                              \
+            printf("  line %d: %s\n", __LINE__, #expr);             \
+            test_errors++;                                          \
+        }                                                           \
+    } while (0)
+
+/* 回放并从输出中取出故障引擎的统计 */
+static void test_replay(test_replay_t *r, int drop_pct, int slack_pct)
+{
+    FILE *out = tmpfile();
+    char line[512];
+    int saved;
+
+    memset(r, 0, sizeof(*r));
+    r->detected = r->missed = r->anomaly_missed = -1;
+
+    fflush(stdout);
+    saved = dup(STDOUT_FILENO);
+    dup2(fileno(out), STDOUT_FILENO);
+    r->result = trace_replay(test_path, drop_pct, slack_pct);
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+
+    rewind(out);
+    while (fgets(line, sizeof(line), out) != NULL) {
+        sscanf(line, "Replayed %*s %d frames", &r->frames);
+        sscanf(line, "engine detected %d, missed %d, latency avg %d ms max %d ms, false positive frames %d",
+               &r->detected, &r->missed, &r->latency_avg_ms, &r->latency_max_ms, &r->fp_frames);
+        sscanf(line, "anomaly detected %*d, missed %d", &r->anomaly_missed);
+    }
+    fclose(out);
+}
+
+static void test_day(void)
+{
+    test_replay_t r;
+
+    TEST_CHECK(trace_synth_write(test_path, TRACE_SYNTH_DAY_SECONDS, TEST_PANEL_MV,
+                                 trace_synth_day, trace_synth_day_count) == 0);
+    test_replay(&r, 0, 0);
+
+    TEST_CHECK(r.result == 0);
+    TEST_CHECK(r.frames == TRACE_SYNTH_DAY_SECONDS * 1000 / PV_SAMPLER_PERIOD_MS);
+    TEST_CHECK(r.detected == 2 && r.missed == 0);
+    /* 开路当帧判出, 35%的下降由CUSUM在20帧内判出 */
+    TEST_CHECK(r.latency_max_ms <= 20 * PV_SAMPLER_PERIOD_MS);
+    /* 误报只来自恢复后CUSUM回落的几十帧, 云影不报 */
+    TEST_CHECK(r.fp_frames <= 50);
+    printf("  detected %d, latency avg %d ms max %d ms, false positive frames %d\n",
+           r.detected, r.latency_avg_ms, r.latency_max_ms, r.fp_frames);
+}
+
+/* 全部板同时下降且在CUSUM松弛量 (20%) 以内的云影不报 */
+static void test_cloud(void)
+{
+    static const trace_synth_event_t events[] = {
+        {30, 60, TRACE_SYNTH_ALL, 85, 0},
+        {90, 100, TRACE_SYNTH_ALL, 82, 0},
+    };
+    test_replay_t r;
+
+    TEST_CHECK(trace_synth_write(test_path, 120, TEST_PANEL_MV, events, 2) == 0);
+    test_replay(&r, 0, 0);
+
+    TEST_CHECK(r.result == 0);
+    TEST_CHECK(r.detected == 0 && r.missed == 0 && r.fp_frames == 0);
+}
+
+/* 阈值覆盖: 瞬时下降阈值调到30%时开路 (剩10%) 仍判出;
+ * CUSUM松弛量调到50%时不再累计35%的下降, 记为漏检 */
+static void test_override(void)
+{
+    test_replay_t r;
+
+    TEST_CHECK(trace_synth_write(test_path, TRACE_SYNTH_DAY_SECONDS, TEST_PANEL_MV,
+                                 trace_synth_day, trace_synth_day_count) == 0);
+    test_replay(&r, 30, 0);
+    TEST_CHECK(r.result == 0 && r.detected == 2 && r.missed == 0);
+
+    test_replay(&r, 0, 50);
+    TEST_CHECK(r.result == 0 && r.detected == 1 && r.missed == 1);
+}
+
+/* 版本1的文件: 标注只有 mask 字段的8位, 结果与版本2相同; 基本异常检测也参与回放 */
+static void test_version1(void)
+{
+    test_replay_t r;
+    FILE *fp;
+
+    TEST_CHECK(trace_synth_write(test_path, TRACE_SYNTH_DAY_SECONDS, TEST_PANEL_MV,
+                                 trace_synth_day, trace_synth_day_count) == 0);
+    test_replay(&r, 0, 0);
+    TEST_CHECK(r.result == 0 && r.detected == 2 && r.missed == 0);
+    TEST_CHECK(r.anomaly_missed >= 0);
+
+    fp = fopen(test_path, "r+b");
+    TEST_CHECK(fp != NULL);
+    if (fp == NULL) {
+        return;
+    }
+    fseek(fp, offsetof(pv_trace_header_t, version), SEEK_SET);
+    fwrite(&(rt_uint16_t){1}, sizeof(rt_uint16_t), 1, fp);
+    fclose(fp);
+
+    test_replay(&r, 0, 0);
+    TEST_CHECK(r.result == 0 && r.detected == 2 && r.missed == 0);
+}
+
+/* 录制中断: 文件头记录数为0, 最后一条记录不完整 */
+static void test_truncated(void)
+{
+    test_replay_t r;
+    FILE *fp;
+    long size;
+
+    TEST_CHECK(trace_synth_write(test_path, 10, TEST_PANEL_MV, NULL, 0) == 0);
+    fp = fopen(test_path, "r+b");
+    TEST_CHECK(fp != NULL);
+    if (fp == NULL) {
+        return;
+    }
+    fseek(fp, offsetof(pv_trace_header_t, records), SEEK_SET);
+    fwrite(&(rt_uint32_t){0}, sizeof(rt_uint32_t), 1, fp);
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fclose(fp);
+    TEST_CHECK(truncate(test_path, size - 5) == 0);
+
+    test_replay(&r, 0, 0);
+    TEST_CHECK(r.result == 0);
+    TEST_CHECK(r.frames == 10 * 1000 / PV_SAMPLER_PERIOD_MS - 1);
+}
+
+static void test_not_a_trace(void)
+{
+    test_replay_t r;
+    FILE *fp = fopen(test_path, "wb");
+
+    TEST_CHECK(fp != NULL);
+    if (fp == NULL) {
+        return;
+    }
+    fputs("not a trace, just some text that is longer than a header", fp);
+    fclose(fp);
+
+    test_replay(&r, 0, 0);
+    TEST_CHECK(r.result != 0);
+
+    unlink(test_path);
+    test_replay(&r, 0, 0);
+    TEST_CHECK(r.result != 0);
+}
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} test_cases[] = {
+    {"open panel and slow drop", test_day},
+    {"clouds are not faults", test_cloud},
+    {"threshold override", test_override},
+    {"version 1 trace", test_version1},
+    {"interrupted recording", test_truncated},
+    {"not a trace", test_not_a_trace},
+};
+
+int main(void)
+{
+    int i, errors, failed = 0;
+
+    snprintf(test_path, sizeof(test_path), "/tmp/pv_trace_test.%d", (int)getpid());
+
+    for (i = 0; i < (int)(sizeof(test_cases) / sizeof(test_cases[0])); i++) {
+        errors = test_errors;
+        test_cases[i].run();
+        printf("%-32s %s\n", test_cases[i].name, test_errors == errors ? "ok" : "FAILED");
+        if (test_errors != errors) {
+            failed++;
+        }
+    }
+    printf("%d of %d passed\n", i - failed, i);
+    unlink(test_path);
+
+    return failed ? 1 : 0;
+}
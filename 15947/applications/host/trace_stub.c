@@ -0,0 +1,98 @@
+/* applications/host/trace_stub.c */
+/*
+ * pv_trace.c 在主机上用到的其余接口: DWT周期计数器、阵列拓扑 (与 pv_fault_detection.c
+ * 相同, 取自 pv_cloud_config.h), 以及只有录制才用到的采样服务和消息队列。
+ * 主机上只回放, 录制相关的接口都返回 -RT_ENOSYS。
+ */
+
+#include <time.h>
+#include <rtthread.h>
+#include "stm32h7xx.h"
+#include "../pv_cloud_config.h"
+#include "../pv_sampler.h"
+#include "../pv_topology.h"
+
+uint32_t SystemCoreClock = 1000000000UL;
+CoreDebug_Type host_core_debug;
+
+static DWT_Type host_dwt_regs;
+
+DWT_Type *host_dwt(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    host_dwt_regs.CYCCNT = (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec);
+
+    return &host_dwt_regs;
+}
+
+/* ========== 阵列拓扑 ========== */
+
+static const rt_uint8_t trace_topo_panels[PV_TOPO_STRINGS] = PV_TOPO_PANELS;
+static const pv_topo_tap_t trace_topo_taps[PV_SAMPLER_CH_NUM] = PV_TOPO_TAPS;
+
+const pv_topology_t *pv_fault_topology(void)
+{
+    static pv_topology_t topo;
+    static rt_bool_t ready = RT_FALSE;
+
+    if (!ready) {
+        const pv_topology_desc_t desc = {
+            .strings = PV_TOPO_STRINGS,
+            .panels = trace_topo_panels,
+            .channels = PV_SAMPLER_CH_NUM,
+            .taps = trace_topo_taps,
+        };
+
+        if (pv_topology_compile(&topo, &desc) != 0) {
+            rt_kprintf("PV topology: invalid PV_TOPO_* table in pv_cloud_config.h\n");
+            return RT_NULL;
+        }
+        ready = RT_TRUE;
+    }
+
+    return &topo;
+}
+
+/* ========== 录制 (主机上不可用) ========== */
+
+rt_err_t pv_sampler_start(void)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t pv_sampler_subscribe(pv_sampler_callback_t callback, void *user_data)
+{
+    return -RT_ENOSYS;
+}
+
+void pv_sampler_unsubscribe(pv_sampler_callback_t callback, void *user_data)
+{
+}
+
+rt_err_t rt_mq_init(rt_mq_t mq, const char *name, void *msgpool, rt_size_t msg_size,
+                    rt_size_t pool_size, rt_uint8_t flag)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_mq_detach(rt_mq_t mq)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_mq_recv(rt_mq_t mq, void *buffer, rt_size_t size, rt_int32_t timeout)
+{
+    return -RT_ENOSYS;
+}
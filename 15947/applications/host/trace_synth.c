@@ -0,0 +1,118 @@
+/* applications/host/trace_synth.c */
+/* 合成的 pv_trace 录制文件 */
+
+#include <stdio.h>
+#include <string.h>
+#include <rtthread.h>
+#include "../pv_cloud_config.h"
+#include "../pv_topology.h"
+#include "../pv_trace.h"
+#include "trace_synth.h"
+
+extern const pv_topology_t *pv_fault_topology(void);
+
+const trace_synth_event_t trace_synth_day[] = {
+    {40, 60, TRACE_SYNTH_ALL, 80, 0},   // 云影, 不是故障
+    {80, 120, 1, 10, 1},                // PV2 开路
+    {160, 220, 4, 65, 1},               // PV5 缓慢下降 (低于瞬时阈值, 由CUSUM判出)
+};
+const int trace_synth_day_count = sizeof(trace_synth_day) / sizeof(trace_synth_day[0]);
+
+static uint32_t synth_seed;
+
+static int32_t synth_noise(int32_t mv, int permille)
+{
+    synth_seed = synth_seed * 1664525u + 1013904223u;
+    return (int32_t)((int64_t)mv * permille * ((int)((synth_seed >> 8) % 2001) - 1000) / 1000000);
+}
+
+int trace_synth_write(const char *path, uint32_t seconds, int32_t panel_mv,
+                      const trace_synth_event_t *events, int count)
+{
+    const pv_topology_t *topo = pv_fault_topology();
+    pv_trace_header_t header;
+    pv_trace_record_t record;
+    uint32_t frames = seconds * 1000 / PV_SAMPLER_PERIOD_MS;
+    pv_panel_mask_t truth = 0;
+    FILE *fp;
+
+    if (topo == RT_NULL || (fp = fopen(path, "wb")) == NULL) {
+        return -1;
+    }
+
+    synth_seed = 1;
+    memset(&header, 0, sizeof(header));
+    header.magic = PV_TRACE_MAGIC;
+    header.version = PV_TRACE_VERSION;
+    header.record_size = sizeof(pv_trace_record_t);
+    header.start_time = 1700000000UL;
+    header.period_ms = PV_SAMPLER_PERIOD_MS;
+    header.vref_mv = PV_VOLTAGE_REF;
+    header.adc_max = PV_ADC_MAX_VALUE;
+    header.records = 0;
+    fwrite(&header, sizeof(header), 1, fp);
+
+    for (uint32_t f = 0; f < frames; f++) {
+        uint32_t now_ms = f * PV_SAMPLER_PERIOD_MS;
+        int32_t panel[PV_TOPO_MAX_PANELS];
+        uint16_t dt = f ? PV_SAMPLER_PERIOD_MS : 0;
+        pv_panel_mask_t mask = 0;
+
+        for (int i = 0; i < topo->panels; i++) {
+            panel[i] = panel_mv;
+        }
+        for (int e = 0; e < count; e++) {
+            const trace_synth_event_t *ev = &events[e];
+
+            if (now_ms < ev->start_s * 1000 || now_ms >= ev->end_s * 1000) {
+                continue;
+            }
+            for (int i = 0; i < topo->panels; i++) {
+                if (ev->panel == TRACE_SYNTH_ALL || ev->panel == i) {
+                    panel[i] = panel[i] * ev->pct / 100;
+                }
+            }
+            if (ev->fault && ev->panel < topo->panels) {
+                mask |= (pv_panel_mask_t)1 << ev->panel;
+            }
+        }
+
+        /* 真实故障变化时在这一帧之前写标注 */
+        if (mask != truth) {
+            memset(&record, 0, sizeof(record));
+            record.dt_ms = dt;
+            record.type = PV_TRACE_MARK;
+            record.mask = (uint8_t)mask;
+            for (int i = 0; i < 4; i++) {
+                record.raw[i] = (uint16_t)(mask >> (16 * i));
+            }
+            fwrite(&record, sizeof(record), 1, fp);
+            header.records++;
+            truth = mask;
+            dt = 0;
+        }
+
+        /* 通道读数 = 所在组串从负端到抽头的累计电压 */
+        memset(&record, 0, sizeof(record));
+        record.dt_ms = dt;
+        record.type = PV_TRACE_FRAME;
+        for (int c = 0; c < topo->channels; c++) {
+            int32_t mv = 0;
+            int64_t raw;
+
+            for (int d = 0; d < topo->channel_depth[c]; d++) {
+                int32_t p = panel[topo->string_first[topo->channel_string[c]] + d];
+                mv += p + synth_noise(p, 10);
+            }
+            raw = ((int64_t)mv * PV_ADC_MAX_VALUE + PV_VOLTAGE_REF / 2) / PV_VOLTAGE_REF;
+            record.raw[c] = (uint16_t)(raw < 0 ? 0 : raw > PV_ADC_MAX_VALUE ? PV_ADC_MAX_VALUE : raw);
+        }
+        fwrite(&record, sizeof(record), 1, fp);
+        header.records++;
+    }
+
+    fseek(fp, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, fp);
+
+    return (fclose(fp) == 0) ? 0 : -1;
+}
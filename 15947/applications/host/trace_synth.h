@@ -0,0 +1,32 @@
+/* applications/host/trace_synth.h */
+/* 合成的 pv_trace 录制文件: 按 pv_cloud_config.h 的阵列拓扑生成ADC原始值和标注 */
+
+#ifndef TRACE_SYNTH_H
+#define TRACE_SYNTH_H
+
+#include <stdint.h>
+
+#define TRACE_SYNTH_ALL     0xFF        // 事件作用于全部板 (光照变化)
+
+// 一个事件: 从 start_s 到 end_s, 板 panel 的电压为正常的 pct%
+typedef struct {
+    uint32_t start_s;
+    uint32_t end_s;
+    uint8_t panel;                      // 0起的板号, TRACE_SYNTH_ALL 为全部板
+    int8_t pct;                         // 负数为反向电压
+    uint8_t fault;                      // 1: 真实故障, 写入标注
+} trace_synth_event_t;
+
+/**
+ * @brief 写一个录制文件: 每块板约 panel_mv (ADC引脚上), ±1%噪声, 帧周期 PV_SAMPLER_PERIOD_MS
+ * @return 0 成功, -1 写文件失败
+ */
+int trace_synth_write(const char *path, uint32_t seconds, int32_t panel_mv,
+                      const trace_synth_event_t *events, int count);
+
+/* 测试和示例用的场景: 一段云影, 一块板开路, 一块板缓慢下降35% */
+extern const trace_synth_event_t trace_synth_day[];
+extern const int trace_synth_day_count;
+#define TRACE_SYNTH_DAY_SECONDS     300
+
+#endif // TRACE_SYNTH_H
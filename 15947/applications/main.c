@@ -11,6 +11,10 @@ extern void adc_pv_integration_init(void);
 /* UART1应用函数声明 */
 #include "uart1_app.h"
 
+/* 本地时序存储 */
+#include "pv_cloud_config.h"
+#include "pv_tsdb.h"
+
 
 /* * ======================================================================
  * 第一部分：必须保留的板级初始化代码 (The Lifeline)
@@ -54,6 +58,11 @@ int main(void)
     /* 启动ADC应用 (但电压检测循环初始为关闭状态) */
     adc_start();
 
+#if PV_ENABLE_LOCAL_STORAGE
+    /* 启动本地时序存储 (未启用FAL时不可用) */
+    pv_tsdb_init();
+#endif
+
     rt_kprintf("✅ ADC system initialized. Use 'Enable_Voltage_Detection' to start monitoring.\n");
     rt_kprintf("📋 Quick commands: adc_quick_test, test_pa6_pa7_channels, help_adc\n");
     rt_kprintf("🎯 Type 'clear_welcome' for a clean start!\n");
@@ -7,22 +7,26 @@
 #include <stdio.h>
 #include <string.h>
 #include "pv_diagnosis.h"
+#include "pv_telemetry.h"
+#include "pv_json.h"
+#include "pv_cloud_config.h"
+#include "pv_onenet_client.h"
 
 #ifdef PKG_USING_ONENET
 #include <onenet.h>
 #endif
 
 /* 外部函数声明 */
-extern int pv_onenet_init(void);
 extern rt_err_t adc_get_pv_data(pv_adc_data_t* data);
 
 /* 故障检测模块函数声明 */
 extern void pv_fault_detector_init(void);
-extern int pv_fault_detection_run(void);
+extern int pv_fault_detection_run_frame(const pv_adc_data_t* adc_data);
 extern int pv_fault_get_count(void);
 extern const char* pv_fault_get_multi_status_string(void);
 extern rt_bool_t pv_fault_is_baseline_ready(void);
 extern rt_bool_t pv_fault_get_individual_status(int pv_index);  // 获取单个PV故障状态
+extern int pv_fault_get_panel_count(void);
 
 
 
@@ -33,14 +37,14 @@ extern rt_bool_t pv_fault_get_individual_status(int pv_index);  // 获取单个P
 
 /* 电压数据结构 (5个光伏板) */
 typedef struct {
-    float va1, va2, va3;  // 节点电压 (V)
-    float vb1, vb2;       // vb3已移除 - 现在只有5个光伏板
-    int message_id;       // 消息ID
+    rt_int32_t va1_mv, va2_mv, va3_mv;  // 节点电压 (mV, 上传时以V为单位保留3位小数)
+    rt_int32_t vb1_mv, vb2_mv;          // vb3已移除 - 现在只有5个光伏板
+    rt_int32_t message_id;              // 消息ID
 
     /* 故障检测相关 */
-    int fault_code_id;        // 主故障码 (0=正常, 1=PV1故障, 2=PV2故障, ...)
+    rt_int32_t fault_code_id; // 主故障码 (0=正常, 1=PV1故障, 2=PV2故障, ...)
     char fault_code_str[32];  // 故障码字符串 ("PANEL_OK", "FAULT_PV1", ...)
-    int fault_count;          // 故障数量
+    rt_int32_t fault_count;   // 故障数量
     char fault_list[64];      // 故障列表 ("PV2,PV6" 或 "NONE")
 
     /* 4个独立的故障字符串数据流 */
@@ -50,6 +54,24 @@ typedef struct {
     char fault_code_str4[32]; // 第4个故障状态字符串
 } voltage_dp_data_t;
 
+/* DP负载字段表 (顺序即JSON中的顺序) */
+static const pv_json_field_t dp_json_fields[] = {
+    PV_JSON_FIELD_FIXED(voltage_dp_data_t, va1_mv, "va1", 3),
+    PV_JSON_FIELD_FIXED(voltage_dp_data_t, va2_mv, "va2", 3),
+    PV_JSON_FIELD_FIXED(voltage_dp_data_t, va3_mv, "va3", 3),
+    PV_JSON_FIELD_FIXED(voltage_dp_data_t, vb1_mv, "vb1", 3),
+    PV_JSON_FIELD_FIXED(voltage_dp_data_t, vb2_mv, "vb2", 3),
+    PV_JSON_FIELD_INT(voltage_dp_data_t, fault_code_id, "fault_code_id"),
+    PV_JSON_FIELD_STRING(voltage_dp_data_t, fault_code_str, "fault_code_str"),
+    PV_JSON_FIELD_INT(voltage_dp_data_t, fault_count, "fault_count"),
+    PV_JSON_FIELD_STRING(voltage_dp_data_t, fault_list, "fault_list"),
+    PV_JSON_FIELD_STRING(voltage_dp_data_t, fault_code_str1, "fault_code_str1"),
+    PV_JSON_FIELD_STRING(voltage_dp_data_t, fault_code_str2, "fault_code_str2"),
+    PV_JSON_FIELD_STRING(voltage_dp_data_t, fault_code_str3, "fault_code_str3"),
+    PV_JSON_FIELD_STRING(voltage_dp_data_t, fault_code_str4, "fault_code_str4"),
+};
+static const pv_json_schema_t dp_json_schema = PV_JSON_SCHEMA(dp_json_fields, PV_JSON_LAYOUT_DP);
+
 /* 上传线程控制 */
 static rt_thread_t dp_upload_thread = RT_NULL;
 static rt_bool_t dp_upload_running = RT_FALSE;
@@ -68,18 +90,18 @@ static int collect_voltage_dp_data(voltage_dp_data_t *data)
         return -1;
     }
     
-    /* 映射ADC数据到电压标识符 (mV -> V, 乘以5倍) - 按照正确的测量点映射 */
-    data->va1 = (adc_data.v_a1_mv * 5.0f) / 1000.0f;  // PA0 -> va1 (PV1) (x5)
-    data->va2 = (adc_data.v_a2_mv * 5.0f) / 1000.0f;  // PA1 -> va2 (PV1+PV2) (x5)
-    data->va3 = (adc_data.v_c1_mv * 5.0f) / 1000.0f;  // PA6 -> va3 (PV1+PV2+PV3) (x5)
-    data->vb1 = (adc_data.v_c2_mv * 5.0f) / 1000.0f;  // PA7 -> vb1 (PV4) (x5)
-    data->vb2 = (adc_data.v_b1_mv * 5.0f) / 1000.0f;  // PB0 -> vb2 (PV4+PV5) (x5)
+    /* 映射ADC数据到电压标识符 (乘以5倍) - 按照正确的测量点映射 */
+    data->va1_mv = adc_data.v_a1_mv * 5;  // PA0 -> va1 (PV1) (x5)
+    data->va2_mv = adc_data.v_a2_mv * 5;  // PA1 -> va2 (PV1+PV2) (x5)
+    data->va3_mv = adc_data.v_c1_mv * 5;  // PA6 -> va3 (PV1+PV2+PV3) (x5)
+    data->vb1_mv = adc_data.v_c2_mv * 5;  // PA7 -> vb1 (PV4) (x5)
+    data->vb2_mv = adc_data.v_b1_mv * 5;  // PB0 -> vb2 (PV4+PV5) (x5)
     // vb3 已移除 - 现在只有5个光伏板
 
     data->message_id = global_message_id++;
 
     /* OneNET内置故障检测 - 独立运行，不依赖Enable_Voltage_Detection */
-    int fault_code = pv_fault_detection_run();  // 直接运行故障检测
+    int fault_code = pv_fault_detection_run_frame(&adc_data);  // 对同一帧运行故障检测
     data->fault_code_id = fault_code;
     data->fault_count = pv_fault_get_count();
 
@@ -94,15 +116,11 @@ static int collect_voltage_dp_data(voltage_dp_data_t *data)
             strcpy(data->fault_code_str, "PANEL_OK");
             strcpy(data->fault_list, "NONE");
         } else {
-            /* 根据故障码设置字符串 */
-            switch (data->fault_code_id) {
-                case 1: strcpy(data->fault_code_str, "FAULT_PV1"); break;
-                case 2: strcpy(data->fault_code_str, "FAULT_PV2"); break;
-                case 3: strcpy(data->fault_code_str, "FAULT_PV3"); break;
-                case 4: strcpy(data->fault_code_str, "FAULT_PV4"); break;
-                case 5: strcpy(data->fault_code_str, "FAULT_PV5"); break;
-                case 6: strcpy(data->fault_code_str, "FAULT_PV6"); break;
-                default: strcpy(data->fault_code_str, "FAULT_UNKNOWN"); break;
+            /* 根据故障码设置字符串 (故障码即主故障板编号) */
+            if (data->fault_code_id >= 1 && data->fault_code_id <= pv_fault_get_panel_count()) {
+                snprintf(data->fault_code_str, sizeof(data->fault_code_str), "FAULT_PV%d", (int)data->fault_code_id);
+            } else {
+                strcpy(data->fault_code_str, "FAULT_UNKNOWN");
             }
 
             /* 解析故障列表 */
@@ -122,14 +140,13 @@ static int collect_voltage_dp_data(voltage_dp_data_t *data)
         }
 
         /* 生成4个故障字符串数据流 */
-        rt_bool_t fault_status[6];
         int fault_slots[4] = {-1, -1, -1, -1};  // 存储故障PV索引，-1表示无故障
         int slot_index = 0;
+        int panels = pv_fault_get_panel_count();
 
         /* 收集所有故障PV */
-        for (int i = 0; i < 6; i++) {
-            fault_status[i] = pv_fault_get_individual_status(i);
-            if (fault_status[i] && slot_index < 4) {
+        for (int i = 0; i < panels; i++) {
+            if (pv_fault_get_individual_status(i) && slot_index < 4) {
                 fault_slots[slot_index] = i;
                 slot_index++;
             }
@@ -176,37 +193,12 @@ static int collect_voltage_dp_data(voltage_dp_data_t *data)
  */
 static int generate_dp_json(voltage_dp_data_t *data, char *json_buf, size_t buf_size)
 {
-    /* 生成标准OneNET DP格式JSON - 包含故障检测数据和4个故障字符串 */
-    int len = snprintf(json_buf, buf_size,
-        "{"
-        "\"id\":%d,"
-        "\"dp\":{"
-        "\"va1\":[{\"v\":%.3f}],"
-        "\"va2\":[{\"v\":%.3f}],"
-        "\"va3\":[{\"v\":%.3f}],"
-        "\"vb1\":[{\"v\":%.3f}],"
-        "\"vb2\":[{\"v\":%.3f}],"
-        "\"fault_code_id\":[{\"v\":%d}],"
-        "\"fault_code_str\":[{\"v\":\"%s\"}],"
-        "\"fault_count\":[{\"v\":%d}],"
-        "\"fault_list\":[{\"v\":\"%s\"}],"
-        "\"fault_code_str1\":[{\"v\":\"%s\"}],"
-        "\"fault_code_str2\":[{\"v\":\"%s\"}],"
-        "\"fault_code_str3\":[{\"v\":\"%s\"}],"
-        "\"fault_code_str4\":[{\"v\":\"%s\"}]"
-        "}"
-        "}",
-        data->message_id,
-        data->va1, data->va2, data->va3,
-        data->vb1, data->vb2,
-        data->fault_code_id, data->fault_code_str,
-        data->fault_count, data->fault_list,
-        data->fault_code_str1, data->fault_code_str2,
-        data->fault_code_str3, data->fault_code_str4
-    );
-    
-    if (len >= buf_size) {
-        rt_kprintf("❌ JSON缓冲区太小\n");
+    /* 按字段表生成标准OneNET DP格式JSON - 包含故障检测数据和4个故障字符串 */
+    int len = pv_json_write(&dp_json_schema, data, data->message_id, json_buf, buf_size);
+
+    if (len < 0) {
+        rt_kprintf("❌ JSON缓冲区太小 (需要%d字节)\n",
+                   (int)pv_json_schema_size(&dp_json_schema, data, data->message_id) + 1);
         return -1;
     }
     
@@ -219,24 +211,37 @@ static int generate_dp_json(voltage_dp_data_t *data, char *json_buf, size_t buf_
 static int publish_dp_data(voltage_dp_data_t *data)
 {
 #ifdef PKG_USING_ONENET
-    char json_payload[512];
-    
+    struct sal_netbuf *nb;
+    int json_len;
+    rt_err_t result;
+
+    /* JSON直接生成在网络缓冲中, 发布队列持有同一个缓冲, 不再拷贝 */
+    nb = sal_netbuf_alloc();
+    if (nb == RT_NULL) {
+        rt_kprintf("ERROR: no network buffer for DP data\n");
+        return -1;
+    }
+
     /* 生成JSON数据 */
-    int json_len = generate_dp_json(data, json_payload, sizeof(json_payload));
+    json_len = generate_dp_json(data, (char *)nb->payload, PV_ONENET_PUB_PAYLOAD_SIZE + 1);
     if (json_len < 0) {
+        sal_netbuf_free(nb);
         return -1;
     }
-    
+    nb->len = (rt_uint16_t)json_len;
+
     rt_kprintf("Publishing DP data to OneNET:\n");
     rt_kprintf("   Topic: %s\n", ONENET_DP_TOPIC);
-    rt_kprintf("   Payload: %s\n", json_payload);
+    rt_kprintf("   Payload: %s\n", (const char *)nb->payload);
 
-    /* 使用OneNET MQTT发布 */
-    if (onenet_mqtt_publish(ONENET_DP_TOPIC, (uint8_t*)json_payload, json_len) == 0) {
-        rt_kprintf("SUCCESS: DP data published\n");
+    /* 压入发布队列, 由发布线程发送, 采集不等待网络 */
+    result = pv_onenet_publish_netbuf(PV_ONENET_PUB_RAW, ONENET_DP_TOPIC, nb);
+    sal_netbuf_free(nb);
+    if (result == RT_EOK) {
+        rt_kprintf("SUCCESS: DP data queued (backlog %d)\n", pv_onenet_publish_backlog());
         return 0;
     } else {
-        rt_kprintf("ERROR: DP data publish failed\n");
+        rt_kprintf("ERROR: DP data queue full\n");
         return -1;
     }
 #else
@@ -245,6 +250,34 @@ static int publish_dp_data(voltage_dp_data_t *data)
 #endif
 }
 
+/**
+ * @brief 把一次采集结果压入遥测存储转发队列, 由遥测线程批量发布
+ */
+static int queue_dp_data(voltage_dp_data_t *data)
+{
+    pv_telemetry_record_t record;
+
+    rt_memset(&record, 0, sizeof(record));
+    record.mv[PV_TELEMETRY_VA1] = (rt_uint16_t)data->va1_mv;
+    record.mv[PV_TELEMETRY_VA2] = (rt_uint16_t)data->va2_mv;
+    record.mv[PV_TELEMETRY_VA3] = (rt_uint16_t)data->va3_mv;
+    record.mv[PV_TELEMETRY_VB1] = (rt_uint16_t)data->vb1_mv;
+    record.mv[PV_TELEMETRY_VB2] = (rt_uint16_t)data->vb2_mv;
+    record.fault_code = (rt_uint8_t)data->fault_code_id;
+
+    if (pv_fault_is_baseline_ready()) {
+        record.flags |= PV_TELEMETRY_FLAG_BASELINE;
+        /* 遥测记录的掩码只有8位 */
+        for (int i = 0; i < pv_fault_get_panel_count() && i < 8; i++) {
+            if (pv_fault_get_individual_status(i)) {
+                record.fault_mask |= (rt_uint8_t)(1u << i);
+            }
+        }
+    }
+
+    return (pv_telemetry_push(&record) == RT_EOK) ? 0 : -1;
+}
+
 /**
  * @brief DP数据上传线程
  */
@@ -255,6 +288,9 @@ static void dp_upload_thread_entry(void *parameter)
     rt_kprintf("Format: OneNET Standard DP Format\n");
     rt_kprintf("Built-in Fault Detection: Enabled\n");
 
+    /* 启动遥测存储转发 (断网时缓存, 恢复后批量补传) */
+    pv_telemetry_init();
+
     /* 初始化内置故障检测器 */
     pv_fault_detector_init();
     rt_kprintf("Fault detector initialized. Establishing baseline...\n");
@@ -266,9 +302,9 @@ static void dp_upload_thread_entry(void *parameter)
         if (collect_voltage_dp_data(&dp_data) == 0) {
             rt_kprintf("\n=== Voltage Data Collection (x5) ===\n");
             rt_kprintf("   va1: %dmV  va2: %dmV  va3: %dmV\n",
-                       (int)(dp_data.va1 * 1000), (int)(dp_data.va2 * 1000), (int)(dp_data.va3 * 1000));
+                       (int)dp_data.va1_mv, (int)dp_data.va2_mv, (int)dp_data.va3_mv);
             rt_kprintf("   vb1: %dmV  vb2: %dmV\n",
-                       (int)(dp_data.vb1 * 1000), (int)(dp_data.vb2 * 1000));
+                       (int)dp_data.vb1_mv, (int)dp_data.vb2_mv);
             rt_kprintf("   Message ID: %d\n", dp_data.message_id);
 
             /* 显示故障检测信息 */
@@ -283,11 +319,11 @@ static void dp_upload_thread_entry(void *parameter)
             rt_kprintf("   Fault Code Str3: %s\n", dp_data.fault_code_str3);
             rt_kprintf("   Fault Code Str4: %s\n", dp_data.fault_code_str4);
             
-            /* 发布到OneNET */
-            if (publish_dp_data(&dp_data) == 0) {
-                rt_kprintf("SUCCESS: Data uploaded\n");
+            /* 加入批量上传队列 */
+            if (queue_dp_data(&dp_data) == 0) {
+                rt_kprintf("SUCCESS: Data queued (backlog %d)\n", pv_telemetry_backlog());
             } else {
-                rt_kprintf("ERROR: Data upload failed\n");
+                rt_kprintf("ERROR: Data queue failed\n");
             }
         } else {
             rt_kprintf("ERROR: Voltage data collection failed\n");
@@ -311,8 +347,8 @@ int test_dp_json_format(void)
     rt_kprintf("\n🧪 === DP格式JSON测试 ===\n");
     
     voltage_dp_data_t test_data = {
-        .va1 = 6.170, .va2 = 11.725, .va3 = 17.280,  // 示例：原始值x5
-        .vb1 = 22.835, .vb2 = 28.390,                // vb3已移除
+        .va1_mv = 6170, .va2_mv = 11725, .va3_mv = 17280,  // 示例：原始值x5
+        .vb1_mv = 22835, .vb2_mv = 28390,                  // vb3已移除
         .message_id = 12345,
         .fault_code_id = 2,                           // 测试：PV2主故障
         .fault_code_str = "FAULT_PV2",
@@ -350,9 +386,9 @@ int test_dp_upload_once(void)
     if (collect_voltage_dp_data(&dp_data) == 0) {
         rt_kprintf("Collected voltage data (x5):\n");
         rt_kprintf("   va1: %dmV  va2: %dmV  va3: %dmV\n",
-                   (int)(dp_data.va1 * 1000), (int)(dp_data.va2 * 1000), (int)(dp_data.va3 * 1000));
+                   (int)dp_data.va1_mv, (int)dp_data.va2_mv, (int)dp_data.va3_mv);
         rt_kprintf("   vb1: %dmV  vb2: %dmV\n",
-                   (int)(dp_data.vb1 * 1000), (int)(dp_data.vb2 * 1000));
+                   (int)dp_data.vb1_mv, (int)dp_data.vb2_mv);
 
         /* 显示故障检测信息 */
         rt_kprintf("Fault Detection Status:\n");
@@ -19,6 +19,12 @@
 #define PV_ADC_MAX_VALUE          65535   // 16位ADC的最大值
 #define PV_SAMPLE_COUNT           19      // 采样次数
 
+/* ADC硬件过采样与数字滤波 */
+#define PV_ADC_OVERSAMPLING_RATIO 16      // 硬件过采样倍数, 1为关闭
+#define PV_ADC_OVERSAMPLING_SHIFT 4       // 累加结果右移位数, 2^shift 等于倍数时量程不变
+// 每通道默认滤波链 (按顺序执行, 类型见 pv_filter.h), 可用 pv_filter 命令逐通道修改
+#define PV_FILTER_DEFAULT_CHAIN   { {PV_FILTER_MEDIAN, 5}, {PV_FILTER_IIR, 2} }
+
 /* 分压电路配置 */
 // 如果您的光伏板电压超过3.3V，需要使用分压电路
 // 例如：10:1分压电路，则设置为10.0f
@@ -33,6 +39,50 @@
 #define PV_UPLOAD_INTERVAL_MS     60000   // 上传间隔 (毫秒) - 改为60秒提高稳定性
 #define PV_JSON_BUFFER_SIZE       1024    // JSON缓冲区大小
 
+/* 遥测存储转发配置 */
+#define PV_TELEMETRY_TOPIC        "$sys/81kgVdJcL2/voltage/dp/post/json"
+#define PV_TELEMETRY_RAM_RECORDS  128     // RAM环形缓冲记录数
+#define PV_TELEMETRY_BATCH_MAX    16      // 每次发布最多打包的记录数
+#define PV_TELEMETRY_SPILL_BATCH  32      // 断网时每攒够多少条写一次闪存
+#define PV_TELEMETRY_PAYLOAD_SIZE 2048    // 单次发布的最大负载 (字节)
+#define PV_TELEMETRY_PARTITION    "easyflash"  // 闪存积压分区 (复用未启用的EasyFlash分区)
+#define PV_TELEMETRY_RETRY_MS     5000    // 发布失败后的重试间隔
+#define PV_TELEMETRY_DRAIN_GAP_MS 200     // 清积压时两次发布的间隔
+// 负载格式: PV_TELEMETRY_FORMAT_JSON (OneNET DP数组) 或 PV_TELEMETRY_FORMAT_DELTA (增量二进制),
+// OneNET的 dp/post 只接受JSON, 增量二进制负载发往 PV_TELEMETRY_DELTA_TOPIC, 由自建网关解码
+#define PV_TELEMETRY_FORMAT       PV_TELEMETRY_FORMAT_JSON
+#define PV_TELEMETRY_DELTA_TOPIC  "pv/voltage/telemetry/delta"
+
+/* OneNET异步发布队列配置 */
+#define PV_ONENET_PUB_POOL        8       // 预分配的消息数, 负载在SAL网络缓冲池中 (SAL_NETBUF_BLOCK_NUM)
+#define PV_ONENET_PUB_PAYLOAD_SIZE 511    // 单条消息的最大负载 (字节), 须小于 SAL_NETBUF_BLOCK_SIZE
+#define PV_ONENET_PUB_RETRY_MAX   3       // 发送失败后的最大重发次数, 超过后丢弃
+#define PV_ONENET_PUB_RETRY_MS    2000    // 发送失败后给模块的恢复时间
+
+/* 本地时序存储配置 (分区按扇区划分给各层, 扇区数之和不能超过分区大小) */
+#define PV_TSDB_PARTITION         "pv_tsdb"   // 时序数据分区
+#define PV_TSDB_RAW_SECTORS       192     // 原始帧循环日志 (100帧/秒时约保留6.5分钟)
+#define PV_TSDB_1S_SECTORS        256     // 1秒层 (约6.5小时)
+#define PV_TSDB_1MIN_SECTORS      48      // 1分钟层 (约3天)
+#define PV_TSDB_1H_SECTORS        16      // 1小时层 (约61天)
+#define PV_TSDB_PAGE_SIZE         256     // 写入批量: 攒满一个NOR页再写
+#define PV_TSDB_FLUSH_MS          60000   // 未满一页的数据最多在RAM中停留的时间
+#define PV_TSDB_QUEUE_DEPTH       64      // 采样帧队列深度
+
+/* 采样帧录制/回放配置 */
+#define PV_TRACE_DEFAULT_FILE     "/pv_trace.bin"   // 默认录制文件
+#define PV_TRACE_QUEUE_DEPTH      64      // 采样帧队列深度
+#define PV_TRACE_WRITE_BATCH      32      // 每次写文件的记录数
+
+/* 二进制遥测通道配置 (COBS成帧, 主机端用 pv_stream_decode.py 解码) */
+#define PV_STREAM_DEVICE          RT_CONSOLE_DEVICE_NAME  // 默认输出串口, 可用 pv_stream_start <dev> 指定
+#define PV_STREAM_RING_SIZE       128     // 记录环形缓冲大小 (必须为2的幂)
+#define PV_STREAM_FLUSH_MS        20      // 发送线程轮询间隔
+#define PV_STREAM_TX_BATCH        16      // 每次写串口最多编码的记录数
+#define PV_STREAM_HELLO_MS        5000    // 周期性发送描述记录, 便于主机中途同步
+#define PV_HUMAN_OUTPUT_DEFAULT   0       // 人类可读表格默认关闭, 用 adc_human on 打开
+#define PV_HUMAN_INTERVAL_MS      5000    // 人类可读表格的最小打印间隔
+
 /* OneNET平台配置 */
 #ifdef PKG_USING_ONENET
 #define PV_ONENET_DEVICE_ID       "2454811797"
@@ -104,7 +154,13 @@
 #define PV_ENABLE_FAULT_DETECTION 1          // 启用故障检测
 #define PV_ENABLE_DATA_LOGGING    1          // 启用数据记录
 #define PV_ENABLE_CLOUD_UPLOAD    1          // 启用云平台上传
-#define PV_ENABLE_LOCAL_STORAGE   0          // 启用本地存储
+// 本地存储 (闪存时序数据库) 由 BSP_USING_PV_TSDB 打开, 它同时从 filesystem 分区末尾划出
+// pv_tsdb 分区 (见 board/port/fal_cfg.h), 切换后 /flash 会被重新格式化
+#ifdef BSP_USING_PV_TSDB
+#define PV_ENABLE_LOCAL_STORAGE   1          // 启用本地存储
+#else
+#define PV_ENABLE_LOCAL_STORAGE   0
+#endif
 
 /* 上传方式选择 */
 #define PV_UPLOAD_METHOD_ONENET   1          // 使用OneNET SDK (已修复，启用)
@@ -134,6 +190,18 @@
 #define PV_PANEL_COUNT_GROUP1     3          // 组1光伏板数量
 #define PV_PANEL_COUNT_GROUP2     3          // 组2光伏板数量
 
+/*
+ * 阵列拓扑 (pv_topology.h)
+ * PV_TOPO_PANELS: 每个组串的板数, 板按组串顺序编号 PV1, PV2, ...
+ * PV_TOPO_TAPS:   每个采样通道 (PV_SAMPLER_CH_* 顺序: PA0 PA1 PB0 PB1 PA6 PA7)
+ *                 测量的 {组串, 从负端起的累计板数}, 累计板数为0表示通道未接
+ * 当前接线: va1=PA0 va2=PA1 va3=PA6 (组串A, PV1~PV3), vb1=PA7 vb2=PB0 (组串B, PV4~PV5), PB1未接。
+ * 恢复PV6时把组串B改为3块板, 并把PB1改为 {1, 3}。
+ */
+#define PV_TOPO_STRINGS           2
+#define PV_TOPO_PANELS            { 3, 2 }
+#define PV_TOPO_TAPS              { {0, 1}, {0, 2}, {1, 2}, {0, 0}, {0, 3}, {1, 1} }
+
 /* 自定义故障检测参数 */
 #define PV_FAULT_CHECK_INTERVAL   5000       // 故障检测间隔 (ms)
 #define PV_FAULT_RECOVERY_THRESHOLD 5000     // 故障恢复阈值 (mV)
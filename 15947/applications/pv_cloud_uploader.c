@@ -6,25 +6,9 @@
 #include <stdio.h>
 #include <string.h>
 #include "pv_cloud_config.h"
-
-/* 外部函数声明 */
-extern int pv_onenet_upload_pv_batch(float va1, float va2, float va3,
-                                      float vb1, float vb2, float vb3,
-                                      float pv1, float pv2, float pv3,
-                                      float pv4, float pv5, float pv6,
-                                      int fault_g1, int fault_g2);
-
-/* ADC配置 */
-#define ADC_DEV_NAME           "adc1"
-#define SAMPLE_COUNT           19      // 采样次数，与现有系统保持一致
-
-/* ADC通道定义 - 重新映射为光伏测量点 */
-#define ADC_CH_VA1    0       // PA0 -> 测量点va1 (PV1)
-#define ADC_CH_VA2    1       // PA1 -> 测量点va2 (PV1+PV2)
-#define ADC_CH_VA3    3       // PA6 -> 测量点va3 (PV1+PV2+PV3)
-#define ADC_CH_VB1    7       // PA7 -> 测量点vb1 (PV4)
-#define ADC_CH_VB2    9       // PB0 -> 测量点vb2 (PV4+PV5)
-#define ADC_CH_VB3    5       // PB1 -> 测量点vb3 (PV4+PV5+PV6)
+#include "pv_sampler.h"
+#include "pv_telemetry.h"
+#include "pv_json.h"
 
 /* 参数定义 */
 #define VOLTAGE_REF            3300    // ADC参考电压 (mV)
@@ -47,9 +31,30 @@ typedef struct {
     rt_uint32_t volt_pv1, volt_pv2, volt_pv3;  // 单块光伏板电压 (mV)
     rt_uint32_t volt_pv4, volt_pv5, volt_pv6;
     
-    int fault_g1, fault_g2;  // 故障码
+    rt_int32_t fault_g1, fault_g2;  // 故障码
+    rt_int32_t timestamp;           // 构建负载时的系统tick
 } pv_data_t;
 
+/* params负载字段表, 电压以V为单位保留3位小数 (mV数值小于2^31, 按有符号读取) */
+static const pv_json_field_t pv_json_fields[] = {
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_va1, "va1", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_va2, "va2", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_va3, "va3", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_vb1, "vb1", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_vb2, "vb2", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_vb3, "vb3", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_pv1, "pv1", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_pv2, "pv2", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_pv3, "pv3", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_pv4, "pv4", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_pv5, "pv5", 3),
+    PV_JSON_FIELD_FIXED(pv_data_t, volt_pv6, "pv6", 3),
+    PV_JSON_FIELD_INT(pv_data_t, fault_g1, "fault_g1"),
+    PV_JSON_FIELD_INT(pv_data_t, fault_g2, "fault_g2"),
+    PV_JSON_FIELD_INT(pv_data_t, timestamp, "timestamp"),
+};
+static const pv_json_schema_t pv_json_schema = PV_JSON_SCHEMA(pv_json_fields, PV_JSON_LAYOUT_PARAMS);
+
 /* 内部函数声明 */
 static int collect_pv_data(pv_data_t *pv_data);
 
@@ -57,52 +62,26 @@ static int collect_pv_data(pv_data_t *pv_data);
 static rt_thread_t pv_upload_thread = RT_NULL;
 static rt_bool_t upload_enabled = RT_FALSE;
 
-/**
- * @brief 多次采样取平均值
- */
-static rt_uint32_t adc_read_average(rt_adc_device_t adc_dev, rt_uint8_t channel, rt_uint8_t count)
-{
-    rt_uint32_t sum = 0;
-    if (adc_dev == RT_NULL || count == 0) {
-        return 0;
-    }
-
-    /* 使能ADC通道 */
-    rt_err_t result = rt_adc_enable(adc_dev, channel);
-    if (result != RT_EOK) {
-        rt_kprintf("Error: enable adc channel(%d) failed!\n", channel);
-        return 0;
-    }
-
-    for (int i = 0; i < count; i++) {
-        sum += rt_adc_read(adc_dev, channel);
-        rt_thread_mdelay(1);
-    }
-
-    /* 关闭ADC通道 */
-    rt_adc_disable(adc_dev, channel);
-
-    return sum / count;
-}
-
 /**
  * @brief 读取所有光伏测量点数据
  */
 static rt_err_t read_pv_data(pv_data_t *data)
 {
-    rt_adc_device_t adc_dev = (rt_adc_device_t)rt_device_find(ADC_DEV_NAME);
-    if (adc_dev == RT_NULL) {
-        rt_kprintf("Error: can't find ADC device %s\n", ADC_DEV_NAME);
+    pv_sample_frame_t frame;
+
+    /* 从共享采样服务读取最新一帧 */
+    if (pv_sampler_read(&frame, PV_SAMPLER_READ_TIMEOUT_MS) != RT_EOK) {
+        rt_kprintf("Error: PV sampler frame not available\n");
         return -RT_ERROR;
     }
 
-    /* 读取所有节点的原始ADC值 */
-    data->raw_va1 = adc_read_average(adc_dev, ADC_CH_VA1, SAMPLE_COUNT);
-    data->raw_va2 = adc_read_average(adc_dev, ADC_CH_VA2, SAMPLE_COUNT);
-    data->raw_va3 = adc_read_average(adc_dev, ADC_CH_VA3, SAMPLE_COUNT);
-    data->raw_vb1 = adc_read_average(adc_dev, ADC_CH_VB1, SAMPLE_COUNT);
-    data->raw_vb2 = adc_read_average(adc_dev, ADC_CH_VB2, SAMPLE_COUNT);
-    data->raw_vb3 = adc_read_average(adc_dev, ADC_CH_VB3, SAMPLE_COUNT);
+    /* 各节点的原始ADC值 */
+    data->raw_va1 = frame.raw[PV_SAMPLER_CH_PA0];
+    data->raw_va2 = frame.raw[PV_SAMPLER_CH_PA1];
+    data->raw_va3 = frame.raw[PV_SAMPLER_CH_PA6];
+    data->raw_vb1 = frame.raw[PV_SAMPLER_CH_PA7];
+    data->raw_vb2 = frame.raw[PV_SAMPLER_CH_PB0];
+    data->raw_vb3 = frame.raw[PV_SAMPLER_CH_PB1];
 
     /* 将ADC值转换为实际节点电压 (mV) */
     data->volt_va1 = (rt_uint32_t)((data->raw_va1 * VOLTAGE_REF * VOLTAGE_DIVIDER_RATIO) / ADC_MAX_VALUE);
@@ -154,33 +133,12 @@ static void diagnose_pv_faults(pv_data_t *data)
  */
 static void build_json_payload(pv_data_t *data, char *json_buffer, size_t buffer_size)
 {
-    snprintf(json_buffer, buffer_size,
-        "{"
-            "\"params\":{"
-                "\"va1\":%.3f,"
-                "\"va2\":%.3f,"
-                "\"va3\":%.3f,"
-                "\"vb1\":%.3f,"
-                "\"vb2\":%.3f,"
-                "\"vb3\":%.3f,"
-                "\"pv1\":%.3f,"
-                "\"pv2\":%.3f,"
-                "\"pv3\":%.3f,"
-                "\"pv4\":%.3f,"
-                "\"pv5\":%.3f,"
-                "\"pv6\":%.3f,"
-                "\"fault_g1\":%d,"
-                "\"fault_g2\":%d,"
-                "\"timestamp\":%d"
-            "}"
-        "}",
-        data->volt_va1 / 1000.0f, data->volt_va2 / 1000.0f, data->volt_va3 / 1000.0f,
-        data->volt_vb1 / 1000.0f, data->volt_vb2 / 1000.0f, data->volt_vb3 / 1000.0f,
-        data->volt_pv1 / 1000.0f, data->volt_pv2 / 1000.0f, data->volt_pv3 / 1000.0f,
-        data->volt_pv4 / 1000.0f, data->volt_pv5 / 1000.0f, data->volt_pv6 / 1000.0f,
-        data->fault_g1, data->fault_g2,
-        (int)rt_tick_get()
-    );
+    data->timestamp = (rt_int32_t)rt_tick_get();
+
+    if (pv_json_write(&pv_json_schema, data, 0, json_buffer, buffer_size) < 0) {
+        rt_kprintf("Error: JSON buffer too small (%d bytes needed)\n",
+                   (int)pv_json_schema_size(&pv_json_schema, data, 0) + 1);
+    }
 }
 
 /**
@@ -208,6 +166,33 @@ static void display_pv_data(pv_data_t *data)
     rt_kprintf("==========================\n");
 }
 
+/**
+ * @brief 把一次采集结果压入遥测存储转发队列
+ */
+static rt_err_t queue_pv_data(pv_data_t *data)
+{
+    pv_telemetry_record_t record;
+
+    rt_memset(&record, 0, sizeof(record));
+    record.mv[PV_TELEMETRY_VA1] = (rt_uint16_t)data->volt_va1;
+    record.mv[PV_TELEMETRY_VA2] = (rt_uint16_t)data->volt_va2;
+    record.mv[PV_TELEMETRY_VA3] = (rt_uint16_t)data->volt_va3;
+    record.mv[PV_TELEMETRY_VB1] = (rt_uint16_t)data->volt_vb1;
+    record.mv[PV_TELEMETRY_VB2] = (rt_uint16_t)data->volt_vb2;
+    record.mv[PV_TELEMETRY_VB3] = (rt_uint16_t)data->volt_vb3;
+    record.fault_code = (rt_uint8_t)(data->fault_g1 ? data->fault_g1 : data->fault_g2);
+    if (data->fault_g1) {
+        record.fault_mask |= (rt_uint8_t)(1u << (data->fault_g1 - 1));
+    }
+    if (data->fault_g2) {
+        record.fault_mask |= (rt_uint8_t)(1u << (data->fault_g2 - 1));
+    }
+    /* 阈值诊断不需要基准 */
+    record.flags = PV_TELEMETRY_FLAG_HAS_VB3 | PV_TELEMETRY_FLAG_BASELINE;
+
+    return pv_telemetry_push(&record);
+}
+
 /**
  * @brief 云平台数据上传线程
  */
@@ -241,16 +226,11 @@ static void pv_upload_thread_entry(void *parameter)
         
         /* 上传到云平台 */
 #if PV_UPLOAD_METHOD_ONENET
-        /* 使用OneNET上传 */
-        if (pv_onenet_upload_pv_batch(
-                pv_data.volt_va1 / 1000.0f, pv_data.volt_va2 / 1000.0f, pv_data.volt_va3 / 1000.0f,
-                pv_data.volt_vb1 / 1000.0f, pv_data.volt_vb2 / 1000.0f, pv_data.volt_vb3 / 1000.0f,
-                pv_data.volt_pv1 / 1000.0f, pv_data.volt_pv2 / 1000.0f, pv_data.volt_pv3 / 1000.0f,
-                pv_data.volt_pv4 / 1000.0f, pv_data.volt_pv5 / 1000.0f, pv_data.volt_pv6 / 1000.0f,
-                pv_data.fault_g1, pv_data.fault_g2) == 0) {
-            rt_kprintf("✅ Data uploaded to OneNET successfully\n\n");
+        /* 加入遥测存储转发队列, 由遥测线程批量发布到OneNET */
+        if (queue_pv_data(&pv_data) == RT_EOK) {
+            rt_kprintf("✅ Data queued for OneNET (backlog %d)\n\n", pv_telemetry_backlog());
         } else {
-            rt_kprintf("❌ Failed to upload data to OneNET\n\n");
+            rt_kprintf("❌ Failed to queue data for OneNET\n\n");
         }
 #else
         /* 其他上传方式 */
@@ -0,0 +1,306 @@
+/* applications/pv_fault_engine.c */
+/* 光伏板流式故障检测引擎 */
+
+#include <stddef.h>
+#include "pv_fault_engine.h"
+
+/* 默认检测参数 */
+#define DEFAULT_BASELINE_FRAMES     10                  // 基准值采样次数
+#define DEFAULT_EWMA_SHIFT          6                   // alpha = 1/64
+#define DEFAULT_MIN_BASELINE_MV     20                  // 最小有效基准电压 (20mV)
+#define DEFAULT_NEGATIVE_MV         (-100)              // 严重负电压阈值 (-100mV)
+#define DEFAULT_RECOVER_MIN_MV      50                  // 0~50mV视为异常低, 不恢复
+#define DEFAULT_DROP_THRESHOLD      PV_Q16(0.50)        // 相对基准下降50%以上
+#define DEFAULT_CLEAR_THRESHOLD     PV_Q16(0.40)        // 80%的阈值，避免抖动
+#define DEFAULT_CUSUM_SLACK         PV_Q16(0.20)        // 忽略20%以内的下降 (云影等)
+#define DEFAULT_CUSUM_LIMIT         PV_Q16(2.00)        // 累计下降达到2倍基准时判故障
+
+/* 基准学习期至少积累的帧数, 之后才开始过滤异常样本 */
+#define LEARN_FILTER_FRAMES         3
+
+void pv_fault_engine_default_config(pv_fault_engine_config_t *cfg)
+{
+    cfg->baseline_frames = DEFAULT_BASELINE_FRAMES;
+    cfg->ewma_shift = DEFAULT_EWMA_SHIFT;
+    cfg->min_baseline_mv = DEFAULT_MIN_BASELINE_MV;
+    cfg->negative_mv = DEFAULT_NEGATIVE_MV;
+    cfg->recover_min_mv = DEFAULT_RECOVER_MIN_MV;
+    cfg->drop_threshold = DEFAULT_DROP_THRESHOLD;
+    cfg->clear_threshold = DEFAULT_CLEAR_THRESHOLD;
+    cfg->cusum_slack = DEFAULT_CUSUM_SLACK;
+    cfg->cusum_limit = DEFAULT_CUSUM_LIMIT;
+}
+
+void pv_fault_engine_init(pv_fault_engine_t *engine, const pv_fault_engine_config_t *cfg, int panels,
+                          pv_fault_engine_callback_t callback, void *user_data)
+{
+    if (cfg != NULL) {
+        engine->cfg = *cfg;
+    } else {
+        pv_fault_engine_default_config(&engine->cfg);
+    }
+
+    if (engine->cfg.baseline_frames == 0) {
+        engine->cfg.baseline_frames = 1;
+    }
+
+    if (panels < 0) {
+        panels = 0;
+    } else if (panels > PV_FAULT_ENGINE_MAX_PANELS) {
+        panels = PV_FAULT_ENGINE_MAX_PANELS;
+    }
+
+    engine->panels = (uint8_t)panels;
+    engine->callback = callback;
+    engine->user_data = user_data;
+    pv_fault_engine_reset_baseline(engine);
+}
+
+void pv_fault_engine_reset_baseline(pv_fault_engine_t *engine)
+{
+    for (int i = 0; i < engine->panels; i++) {
+        engine->mean[i] = 0;
+        engine->var[i] = 0;
+        engine->cusum[i] = 0;
+        engine->last_mv[i] = 0;
+        engine->baseline_sum[i] = 0;
+    }
+
+    engine->frames = 0;
+    engine->learned = 0;
+    engine->baseline_ready = 0;
+    engine->fault_mask = 0;
+    engine->primary = 0;
+}
+
+/**
+ * @brief 上报故障掩码的变化 (只在变化时调用, 不在常规路径上)
+ */
+static void notify_transitions(pv_fault_engine_t *engine, pv_panel_mask_t changed, pv_panel_mask_t mask)
+{
+    if (engine->callback == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < engine->panels; i++) {
+        if (changed & ((pv_panel_mask_t)1 << i)) {
+            engine->callback(engine->user_data,
+                             (mask & ((pv_panel_mask_t)1 << i)) ? PV_FAULT_EVENT_SET : PV_FAULT_EVENT_CLEAR,
+                             i, engine->last_mv[i], pv_fault_engine_baseline_mv(engine, i));
+        }
+    }
+}
+
+/**
+ * @brief 选出最严重的故障板 (只在有故障时调用)
+ *
+ * 负电压的相对下降必然大于100%, 因此自然排在普通下降之前。
+ */
+static uint8_t select_primary(const pv_fault_engine_t *engine, pv_panel_mask_t mask)
+{
+    int64_t worst = -1;
+    uint8_t primary = 0;
+
+    for (int i = 0; i < engine->panels; i++) {
+        if (!(mask & ((pv_panel_mask_t)1 << i))) {
+            continue;
+        }
+
+        const int64_t mean = engine->mean[i];
+        const int32_t last_mv = engine->last_mv[i];
+        int64_t x = (int64_t)last_mv * PV_Q16_ONE;
+        int64_t severity;
+
+        if (mean > (int64_t)engine->cfg.min_baseline_mv * PV_Q16_ONE) {
+            severity = ((mean - x) * PV_Q16_ONE) / mean;
+        } else {
+            severity = (last_mv < 0) ? 2 * (int64_t)PV_Q16_ONE - last_mv : 0;
+        }
+
+        if (severity > worst) {
+            worst = severity;
+            primary = (uint8_t)(i + 1);
+        }
+    }
+
+    return primary;
+}
+
+/**
+ * @brief 基准学习期: 累加有效样本, 过滤并标记明显的骤降
+ */
+static pv_panel_mask_t learn_baseline(pv_fault_engine_t *engine, const int32_t *x)
+{
+    const pv_fault_engine_config_t *cfg = &engine->cfg;
+    int64_t n = engine->learned;
+    pv_panel_mask_t mask = 0;
+    int accept = 1;
+
+    if (n >= LEARN_FILTER_FRAMES) {
+        for (int i = 0; i < engine->panels; i++) {
+            int64_t sum = engine->baseline_sum[i];
+
+            /* 临时平均值 sum/n 足够大才有意义, 用乘法代替除法比较 */
+            if (sum > (int64_t)cfg->min_baseline_mv * n) {
+                int64_t dev = sum - (int64_t)x[i] * n;
+                int64_t band = (sum * cfg->drop_threshold) >> 16;
+
+                if (dev > band) {
+                    mask |= (pv_panel_mask_t)1 << i;
+                }
+                if (dev > band || -dev > band) {
+                    accept = 0;
+                }
+            }
+        }
+    }
+
+    if (accept) {
+        for (int i = 0; i < engine->panels; i++) {
+            engine->baseline_sum[i] += x[i];
+        }
+        engine->learned++;
+    }
+
+    if (engine->learned >= cfg->baseline_frames) {
+        for (int i = 0; i < engine->panels; i++) {
+            engine->mean[i] = (engine->baseline_sum[i] * PV_Q16_ONE) / engine->learned;
+            engine->var[i] = 0;
+            engine->cusum[i] = 0;
+        }
+        engine->baseline_ready = 1;
+
+        if (engine->callback != NULL) {
+            engine->callback(engine->user_data, PV_FAULT_EVENT_BASELINE, -1, 0, 0);
+        }
+    }
+
+    return mask;
+}
+
+pv_panel_mask_t pv_fault_engine_process(pv_fault_engine_t *engine, const int32_t *panel_mv)
+{
+    const pv_fault_engine_config_t *cfg = &engine->cfg;
+    const int64_t min_baseline = (int64_t)cfg->min_baseline_mv * PV_Q16_ONE;
+    const pv_panel_mask_t mask = engine->fault_mask;
+    const int32_t *x = engine->last_mv;
+    pv_panel_mask_t next = 0;
+
+    engine->frames++;
+
+    for (int i = 0; i < engine->panels; i++) {
+        int32_t v = panel_mv[i];
+
+        if (v > PV_FAULT_ENGINE_MAX_MV) {
+            v = PV_FAULT_ENGINE_MAX_MV;
+        } else if (v < -PV_FAULT_ENGINE_MAX_MV) {
+            v = -PV_FAULT_ENGINE_MAX_MV;
+        }
+        engine->last_mv[i] = v;
+    }
+
+    if (!engine->baseline_ready) {
+        next = learn_baseline(engine, x);
+    } else {
+        for (int i = 0; i < engine->panels; i++) {
+            const pv_panel_mask_t bit = (pv_panel_mask_t)1 << i;
+            /* Q16 mV 超过 ±32767mV 就超出int32, 与 select_primary() 一样用int64计算 */
+            const int64_t b = engine->mean[i];
+            const int64_t xq = (int64_t)x[i] * PV_Q16_ONE;
+            const int64_t drop = b - xq;
+            const int64_t drop_scaled = drop * PV_Q16_ONE;
+            const int valid = b > min_baseline;
+
+            /* 下降超过恢复阈值 (滞回下沿) */
+            const int holding = valid && drop_scaled > b * cfg->clear_threshold;
+
+            /* CUSUM: s = max(0, s + drop - k), 上限 2h 以便故障消失后能较快回落 */
+            const int64_t k = (b * cfg->cusum_slack) >> 16;
+            const int64_t h = (b * cfg->cusum_limit) >> 16;
+            int64_t s = engine->cusum[i] + drop - k;
+            if (s < 0) {
+                s = 0;
+            } else if (s > 2 * h) {
+                s = 2 * h;
+            }
+
+            int faulted;
+            if (mask & bit) {
+                int low = valid ? (x[i] < cfg->recover_min_mv) : (x[i] < 0);
+                faulted = holding || low || s > (h >> 1);
+                if (!faulted) {
+                    s = 0;
+                }
+            } else {
+                faulted = (valid && drop_scaled > b * cfg->drop_threshold) ||
+                          (valid && s > h) ||
+                          (x[i] < cfg->negative_mv);
+            }
+
+            if (faulted) {
+                next |= bit;
+            } else if (s == 0) {
+                /* 下降未超过松弛量时基准才缓慢跟踪光照变化, 避免把故障吸收进基准 */
+                /* (drop/2^8)^2 即 drop^2/2^16, 限幅后的电压下不会溢出 */
+                int64_t sq = (drop >> 8) * (drop >> 8);
+                engine->mean[i] = b - (drop >> cfg->ewma_shift);
+                engine->var[i] += (sq - engine->var[i]) >> cfg->ewma_shift;
+            }
+
+            engine->cusum[i] = s;
+        }
+    }
+
+    engine->fault_mask = next;
+    if (next != 0) {
+        engine->primary = select_primary(engine, next);
+    } else {
+        engine->primary = 0;
+    }
+
+    if (next != mask) {
+        notify_transitions(engine, next ^ mask, next);
+    }
+
+    return next;
+}
+
+int32_t pv_fault_engine_baseline_mv(const pv_fault_engine_t *engine, int panel)
+{
+    if (panel < 0 || panel >= engine->panels) {
+        return 0;
+    }
+
+    if (!engine->baseline_ready) {
+        return engine->learned ? (int32_t)(engine->baseline_sum[panel] / engine->learned) : 0;
+    }
+
+    return (int32_t)(engine->mean[panel] / PV_Q16_ONE);
+}
+
+uint32_t pv_fault_engine_sigma_mv(const pv_fault_engine_t *engine, int panel)
+{
+    if (panel < 0 || panel >= engine->panels) {
+        return 0;
+    }
+
+    /* 整数开方 */
+    uint64_t v = (uint64_t)(engine->var[panel] > 0 ? engine->var[panel] : 0) >> 16;
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
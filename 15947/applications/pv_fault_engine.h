@@ -0,0 +1,108 @@
+/*
+ * pv_fault_engine.h
+ *
+ * 光伏板流式故障检测引擎 (Q16定点, 无动态内存, 无打印)
+ * 每帧一次性处理全部光伏板: EWMA基准、方差、CUSUM下降累计,
+ * 故障状态变化时通过回调上报。板数在初始化时给定, 每块板的统计量按
+ * 字段分别存放成数组, 逐板循环顺序访问。只依赖 <stdint.h>, 可在主机上直接编译。
+ */
+
+#ifndef PV_FAULT_ENGINE_H
+#define PV_FAULT_ENGINE_H
+
+#include <stdint.h>
+#include "pv_topology.h"
+
+#define PV_FAULT_ENGINE_MAX_PANELS  PV_TOPO_MAX_PANELS
+/* 输入电压的限幅 (mV), 超出的读数按此值处理, 保证Q16中间量不溢出int64 */
+#define PV_FAULT_ENGINE_MAX_MV      2000000
+
+/* Q16定点数: 1.0 = 65536 */
+typedef int32_t pv_q16_t;
+#define PV_Q16_ONE                  65536
+#define PV_Q16(x)                   ((pv_q16_t)((x) * 65536.0 + 0.5))
+
+// 回调事件类型
+typedef enum {
+    PV_FAULT_EVENT_BASELINE = 0,    // 基准建立完成 (panel = -1)
+    PV_FAULT_EVENT_SET,             // 光伏板进入故障
+    PV_FAULT_EVENT_CLEAR,           // 光伏板故障恢复
+} pv_fault_event_t;
+
+/**
+ * @brief 故障状态变化回调, 只在状态变化时调用
+ * @param panel 光伏板索引 (0=PV1), 基准事件为-1
+ * @param value_mv 当前独立电压 (mV)
+ * @param baseline_mv 当前基准电压 (mV)
+ */
+typedef void (*pv_fault_engine_callback_t)(void *user_data, pv_fault_event_t event, int panel,
+                                           int32_t value_mv, int32_t baseline_mv);
+
+// 检测参数
+typedef struct {
+    uint16_t baseline_frames;       // 建立基准所需的有效帧数
+    uint8_t  ewma_shift;            // EWMA系数 alpha = 2^-shift
+    int32_t  min_baseline_mv;       // 基准低于此值不做相对检测 (mV)
+    int32_t  negative_mv;           // 独立电压低于此值直接判故障 (mV)
+    int32_t  recover_min_mv;        // 恢复所需的最低独立电压 (mV)
+    pv_q16_t drop_threshold;        // 瞬时相对下降阈值
+    pv_q16_t clear_threshold;       // 恢复阈值 (小于 drop_threshold, 形成滞回)
+    pv_q16_t cusum_slack;           // CUSUM 松弛量 k (相对基准)
+    pv_q16_t cusum_limit;           // CUSUM 判决门限 h (相对基准)
+} pv_fault_engine_config_t;
+
+// 引擎实例, 由调用者静态分配; 逐板统计量按字段成组存放
+typedef struct {
+    pv_fault_engine_config_t cfg;
+    uint8_t panels;                                         // 板数
+    int64_t mean[PV_FAULT_ENGINE_MAX_PANELS];               // EWMA基准 (Q16 mV)
+    int64_t var[PV_FAULT_ENGINE_MAX_PANELS];                // EWMA方差 (Q16 mV^2)
+    int64_t cusum[PV_FAULT_ENGINE_MAX_PANELS];              // 下降累计和 (Q16 mV)
+    int32_t last_mv[PV_FAULT_ENGINE_MAX_PANELS];            // 最近一帧独立电压 (mV)
+    int64_t baseline_sum[PV_FAULT_ENGINE_MAX_PANELS];       // 基准学习期累加 (mV)
+    uint32_t frames;                // 已处理帧数
+    uint16_t learned;               // 基准学习期已接受的帧数
+    uint8_t baseline_ready;
+    uint8_t primary;                // 主故障 0=无, i=PV(i)
+    pv_panel_mask_t fault_mask;     // bit i = PV(i+1) 故障
+    pv_fault_engine_callback_t callback;
+    void *user_data;
+} pv_fault_engine_t;
+
+/**
+ * @brief 填充默认检测参数
+ */
+void pv_fault_engine_default_config(pv_fault_engine_config_t *cfg);
+
+/**
+ * @brief 初始化引擎
+ * @param cfg 检测参数, RT_NULL/NULL 使用默认值
+ * @param panels 板数, 超过 PV_FAULT_ENGINE_MAX_PANELS 时截断
+ */
+void pv_fault_engine_init(pv_fault_engine_t *engine, const pv_fault_engine_config_t *cfg, int panels,
+                          pv_fault_engine_callback_t callback, void *user_data);
+
+/**
+ * @brief 丢弃基准和故障状态, 重新学习
+ */
+void pv_fault_engine_reset_baseline(pv_fault_engine_t *engine);
+
+/**
+ * @brief 处理一帧
+ * @param panel_mv 每块板的独立电压 (mV), 长度为 engine->panels, 一般由 pv_topology_panel_mv() 得到,
+ *                 超出 ±PV_FAULT_ENGINE_MAX_MV 的读数被限幅
+ * @return 处理后的故障掩码
+ */
+pv_panel_mask_t pv_fault_engine_process(pv_fault_engine_t *engine, const int32_t *panel_mv);
+
+/**
+ * @brief 获取光伏板当前基准电压 (mV)
+ */
+int32_t pv_fault_engine_baseline_mv(const pv_fault_engine_t *engine, int panel);
+
+/**
+ * @brief 获取光伏板当前噪声标准差 (mV), 仅用于诊断显示
+ */
+uint32_t pv_fault_engine_sigma_mv(const pv_fault_engine_t *engine, int panel);
+
+#endif // PV_FAULT_ENGINE_H
@@ -0,0 +1,213 @@
+/* applications/pv_filter.c */
+/* 光伏采样数字滤波链 */
+
+#include <rtthread.h>
+#include "pv_filter.h"
+
+static const char *const filter_type_names[] = {
+    "none", "median", "avg", "iir", "decim",
+};
+
+static rt_bool_t filter_config_valid(const pv_filter_config_t *config)
+{
+    switch (config->type) {
+    case PV_FILTER_MEDIAN:
+        return config->param >= 3 && config->param <= PV_FILTER_MEDIAN_MAX && (config->param & 1);
+    case PV_FILTER_AVERAGE:
+        return config->param >= 2 && config->param <= PV_FILTER_AVG_MAX;
+    case PV_FILTER_IIR:
+        return config->param >= 1 && config->param <= 8;
+    case PV_FILTER_DECIMATE:
+        return config->param >= 2;
+    default:
+        return RT_FALSE;
+    }
+}
+
+rt_err_t pv_filter_chain_init(pv_filter_chain_t *chain, const pv_filter_config_t *config, int count)
+{
+    RT_ASSERT(chain != RT_NULL);
+
+    if (count < 0 || count > PV_FILTER_MAX_STAGES) {
+        return -RT_EINVAL;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!filter_config_valid(&config[i])) {
+            return -RT_EINVAL;
+        }
+    }
+
+    rt_memset(chain, 0, sizeof(*chain));
+    for (int i = 0; i < count; i++) {
+        chain->stages[i].config = config[i];
+    }
+    chain->count = (rt_uint8_t)count;
+
+    return RT_EOK;
+}
+
+void pv_filter_chain_reset(pv_filter_chain_t *chain)
+{
+    for (int i = 0; i < chain->count; i++) {
+        pv_filter_stage_t *stage = &chain->stages[i];
+        pv_filter_config_t config = stage->config;
+
+        rt_memset(stage, 0, sizeof(*stage));
+        stage->config = config;
+    }
+}
+
+/**
+ * @brief 滑动中值: 有序副本中删除最旧样本再插入新样本, 每样本 O(N)
+ */
+static rt_size_t filter_median(pv_filter_stage_t *stage, rt_int32_t *block, rt_size_t count)
+{
+    rt_int32_t *history = stage->state.median.history;
+    rt_int32_t *sorted = stage->state.median.sorted;
+    rt_uint8_t window = stage->config.param;
+
+    for (rt_size_t n = 0; n < count; n++) {
+        rt_int32_t x = block[n];
+        int i = stage->fill;
+
+        if (stage->fill == window) {
+            /* 窗口已满: 移除最旧样本, 空位移到末尾 */
+            rt_int32_t old = history[stage->pos];
+            int j = 0;
+
+            while (sorted[j] != old) {
+                j++;
+            }
+            for (; j < window - 1; j++) {
+                sorted[j] = sorted[j + 1];
+            }
+            i = window - 1;
+        } else {
+            stage->fill++;
+        }
+
+        /* 插入排序 */
+        while (i > 0 && sorted[i - 1] > x) {
+            sorted[i] = sorted[i - 1];
+            i--;
+        }
+        sorted[i] = x;
+
+        history[stage->pos] = x;
+        if (++stage->pos == window) {
+            stage->pos = 0;
+        }
+
+        block[n] = sorted[stage->fill / 2];
+    }
+
+    return count;
+}
+
+static rt_size_t filter_average(pv_filter_stage_t *stage, rt_int32_t *block, rt_size_t count)
+{
+    rt_int32_t *history = stage->state.average.history;
+    rt_uint8_t window = stage->config.param;
+
+    for (rt_size_t n = 0; n < count; n++) {
+        rt_int32_t x = block[n];
+
+        if (stage->fill == window) {
+            stage->state.average.sum -= history[stage->pos];
+        } else {
+            stage->fill++;
+        }
+        stage->state.average.sum += x;
+
+        history[stage->pos] = x;
+        if (++stage->pos == window) {
+            stage->pos = 0;
+        }
+
+        block[n] = stage->state.average.sum / stage->fill;
+    }
+
+    return count;
+}
+
+static rt_size_t filter_iir(pv_filter_stage_t *stage, rt_int32_t *block, rt_size_t count)
+{
+    rt_int32_t y = stage->state.iir.y;
+    rt_uint8_t k = stage->config.param;
+
+    /* 首个样本直接作为初值, 避免从0爬升 */
+    if (stage->fill == 0 && count > 0) {
+        y = block[0] << 8;
+        stage->fill = 1;
+    }
+
+    for (rt_size_t n = 0; n < count; n++) {
+        y += ((block[n] << 8) - y) >> k;
+        block[n] = (y + 128) >> 8;
+    }
+    stage->state.iir.y = y;
+
+    return count;
+}
+
+static rt_size_t filter_decimate(pv_filter_stage_t *stage, rt_int32_t *block, rt_size_t count)
+{
+    rt_uint8_t factor = stage->config.param;
+    rt_size_t out = 0;
+
+    /* 输出位置不超过输入位置, 可以原地写回 */
+    for (rt_size_t n = 0; n < count; n++) {
+        stage->state.decimate.sum += block[n];
+        if (++stage->pos == factor) {
+            block[out++] = stage->state.decimate.sum / factor;
+            stage->state.decimate.sum = 0;
+            stage->pos = 0;
+        }
+    }
+
+    return out;
+}
+
+rt_size_t pv_filter_chain_process(pv_filter_chain_t *chain, rt_int32_t *block, rt_size_t count)
+{
+    for (int i = 0; i < chain->count && count > 0; i++) {
+        pv_filter_stage_t *stage = &chain->stages[i];
+
+        switch (stage->config.type) {
+        case PV_FILTER_MEDIAN:
+            count = filter_median(stage, block, count);
+            break;
+        case PV_FILTER_AVERAGE:
+            count = filter_average(stage, block, count);
+            break;
+        case PV_FILTER_IIR:
+            count = filter_iir(stage, block, count);
+            break;
+        case PV_FILTER_DECIMATE:
+            count = filter_decimate(stage, block, count);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return count;
+}
+
+const char *pv_filter_type_name(rt_uint8_t type)
+{
+    if (type < sizeof(filter_type_names) / sizeof(filter_type_names[0])) {
+        return filter_type_names[type];
+    }
+    return "?";
+}
+
+rt_uint8_t pv_filter_type_parse(const char *name)
+{
+    for (rt_uint8_t i = 1; i < sizeof(filter_type_names) / sizeof(filter_type_names[0]); i++) {
+        if (rt_strcmp(name, filter_type_names[i]) == 0) {
+            return i;
+        }
+    }
+    return PV_FILTER_NONE;
+}
@@ -0,0 +1,95 @@
+/*
+ * pv_filter.h
+ *
+ * 光伏采样数字滤波链
+ * 每个通道一条由若干级组成的滤波链 (中值/滑动平均/IIR低通/抽取),
+ * 按数据块原地处理, 状态全部保存在链结构体内, 不申请堆内存。
+ * 同一条链不可重入, 采样服务在采样线程中运行 (见 pv_sampler.c)。
+ */
+
+#ifndef PV_FILTER_H
+#define PV_FILTER_H
+
+#include <rtthread.h>
+
+#define PV_FILTER_MAX_STAGES    4       // 每条链的最大级数
+#define PV_FILTER_MEDIAN_MAX    9       // 中值滤波最大窗口
+#define PV_FILTER_AVG_MAX       32      // 滑动平均最大窗口
+
+// 滤波级类型
+typedef enum {
+    PV_FILTER_NONE = 0,
+    PV_FILTER_MEDIAN,                   // 中值: param = 窗口长度 (奇数, 3..PV_FILTER_MEDIAN_MAX)
+    PV_FILTER_AVERAGE,                  // 滑动平均: param = 窗口长度 (2..PV_FILTER_AVG_MAX)
+    PV_FILTER_IIR,                      // 一阶IIR低通: param = k, y += (x - y) / 2^k (1..8)
+    PV_FILTER_DECIMATE,                 // 抽取: param = 因子, 每 param 个输入平均后输出一个
+} pv_filter_type_t;
+
+// 滤波级配置
+typedef struct {
+    rt_uint8_t type;                    // pv_filter_type_t
+    rt_uint8_t param;
+} pv_filter_config_t;
+
+// 滤波级运行状态
+typedef struct {
+    pv_filter_config_t config;
+    rt_uint8_t pos;                     // 历史环形缓冲写位置 / 抽取相位
+    rt_uint8_t fill;                    // 历史中的有效样本数
+    union {
+        struct {
+            rt_int32_t history[PV_FILTER_MEDIAN_MAX];   // 按到达顺序
+            rt_int32_t sorted[PV_FILTER_MEDIAN_MAX];    // 同一窗口的有序副本
+        } median;
+        struct {
+            rt_int32_t history[PV_FILTER_AVG_MAX];
+            rt_int32_t sum;
+        } average;
+        struct {
+            rt_int32_t y;               // Q8 输出
+        } iir;
+        struct {
+            rt_int32_t sum;
+        } decimate;
+    } state;
+} pv_filter_stage_t;
+
+// 滤波链
+typedef struct {
+    pv_filter_stage_t stages[PV_FILTER_MAX_STAGES];
+    rt_uint8_t count;
+} pv_filter_chain_t;
+
+/**
+ * @brief 按配置初始化滤波链并清空状态
+ * @param config 各级配置, 按处理顺序排列
+ * @param count 级数, 0 为直通
+ * @return RT_EOK 成功, -RT_EINVAL 配置非法 (链保持不变)
+ */
+rt_err_t pv_filter_chain_init(pv_filter_chain_t *chain, const pv_filter_config_t *config, int count);
+
+/**
+ * @brief 清空滤波链状态, 配置不变
+ */
+void pv_filter_chain_reset(pv_filter_chain_t *chain);
+
+/**
+ * @brief 原地处理一个数据块
+ * @param block 输入样本, 输出覆盖在前部
+ * @param count 输入样本数
+ * @return 输出样本数 (含抽取级时小于输入)
+ */
+rt_size_t pv_filter_chain_process(pv_filter_chain_t *chain, rt_int32_t *block, rt_size_t count);
+
+/**
+ * @brief 滤波级类型名, 用于打印和命令解析
+ */
+const char *pv_filter_type_name(rt_uint8_t type);
+
+/**
+ * @brief 按名称查找滤波级类型
+ * @return 类型, 未找到返回 PV_FILTER_NONE
+ */
+rt_uint8_t pv_filter_type_parse(const char *name);
+
+#endif // PV_FILTER_H
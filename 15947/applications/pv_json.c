@@ -0,0 +1,270 @@
+/* applications/pv_json.c */
+/* 光伏数据JSON序列化 */
+
+#include <rtthread.h>
+#include "pv_json.h"
+
+static const char hex_digits[] = "0123456789abcdef";
+
+void pv_json_writer_init(pv_json_writer_t *w, char *buf, rt_size_t size)
+{
+    w->buf = buf;
+    w->size = size;
+    w->pos = 0;
+    w->len = 0;
+    w->sink = RT_NULL;
+    w->ctx = RT_NULL;
+    w->err = RT_EOK;
+}
+
+void pv_json_writer_init_count(pv_json_writer_t *w)
+{
+    pv_json_writer_init(w, RT_NULL, 0);
+}
+
+void pv_json_writer_init_stream(pv_json_writer_t *w, char *buf, rt_size_t size,
+                                pv_json_sink_t sink, void *ctx)
+{
+    pv_json_writer_init(w, buf, size);
+    w->sink = sink;
+    w->ctx = ctx;
+}
+
+static void writer_flush(pv_json_writer_t *w)
+{
+    if (w->pos > 0 && w->err == RT_EOK) {
+        w->err = w->sink(w->ctx, w->buf, w->pos);
+    }
+    w->pos = 0;
+}
+
+/**
+ * @brief 所有输出的唯一出口
+ */
+static void writer_emit(pv_json_writer_t *w, const char *data, rt_size_t n)
+{
+    w->len += n;
+
+    if (w->buf == RT_NULL || w->err != RT_EOK) {
+        return;
+    }
+
+    if (w->sink != RT_NULL) {
+        while (n > 0) {
+            rt_size_t chunk = w->size - w->pos;
+            if (chunk > n) {
+                chunk = n;
+            }
+            rt_memcpy(w->buf + w->pos, data, chunk);
+            w->pos += chunk;
+            data += chunk;
+            n -= chunk;
+            if (w->pos == w->size) {
+                writer_flush(w);
+            }
+        }
+        return;
+    }
+
+    /* 保留一个字节给 '\0' */
+    if (w->pos + n >= w->size) {
+        w->err = -RT_EFULL;
+        return;
+    }
+    rt_memcpy(w->buf + w->pos, data, n);
+    w->pos += n;
+}
+
+rt_err_t pv_json_writer_finish(pv_json_writer_t *w)
+{
+    if (w->sink != RT_NULL) {
+        writer_flush(w);
+    } else if (w->buf != RT_NULL && w->size > 0) {
+        w->buf[w->err == RT_EOK ? w->pos : 0] = '\0';
+    }
+
+    return w->err;
+}
+
+void pv_json_put_raw(pv_json_writer_t *w, const char *text)
+{
+    writer_emit(w, text, rt_strlen(text));
+}
+
+void pv_json_put_uint(pv_json_writer_t *w, rt_uint32_t value)
+{
+    char digits[10];
+    int n = sizeof(digits);
+
+    do {
+        digits[--n] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    writer_emit(w, &digits[n], sizeof(digits) - n);
+}
+
+void pv_json_put_int(pv_json_writer_t *w, rt_int32_t value)
+{
+    if (value < 0) {
+        writer_emit(w, "-", 1);
+        pv_json_put_uint(w, 0u - (rt_uint32_t)value);
+    } else {
+        pv_json_put_uint(w, (rt_uint32_t)value);
+    }
+}
+
+void pv_json_put_fixed(pv_json_writer_t *w, rt_int32_t value, rt_uint8_t decimals)
+{
+    rt_uint32_t magnitude;
+    rt_uint32_t divisor = 1;
+    char frac[9];
+
+    if (decimals == 0) {
+        pv_json_put_int(w, value);
+        return;
+    }
+    if (decimals > sizeof(frac)) {
+        decimals = sizeof(frac);
+    }
+
+    for (int i = 0; i < decimals; i++) {
+        divisor *= 10;
+    }
+
+    if (value < 0) {
+        writer_emit(w, "-", 1);
+        magnitude = 0u - (rt_uint32_t)value;
+    } else {
+        magnitude = (rt_uint32_t)value;
+    }
+
+    pv_json_put_uint(w, magnitude / divisor);
+    writer_emit(w, ".", 1);
+
+    /* 小数部分补齐前导0 */
+    magnitude %= divisor;
+    for (int i = decimals - 1; i >= 0; i--) {
+        frac[i] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    writer_emit(w, frac, decimals);
+}
+
+void pv_json_put_string(pv_json_writer_t *w, const char *text)
+{
+    const char *run = text;
+
+    writer_emit(w, "\"", 1);
+
+    /* 无需转义的连续字符一次输出 */
+    for (; *text; text++) {
+        unsigned char c = (unsigned char)*text;
+        char esc[6];
+        rt_size_t n = 2;
+
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        writer_emit(w, run, text - run);
+        run = text + 1;
+
+        esc[0] = '\\';
+        switch (c) {
+        case '"':  esc[1] = '"';  break;
+        case '\\': esc[1] = '\\'; break;
+        case '\n': esc[1] = 'n';  break;
+        case '\r': esc[1] = 'r';  break;
+        case '\t': esc[1] = 't';  break;
+        default:
+            esc[1] = 'u';
+            esc[2] = '0';
+            esc[3] = '0';
+            esc[4] = hex_digits[c >> 4];
+            esc[5] = hex_digits[c & 0x0F];
+            n = 6;
+            break;
+        }
+        writer_emit(w, esc, n);
+    }
+
+    writer_emit(w, run, text - run);
+    writer_emit(w, "\"", 1);
+}
+
+void pv_json_put_value(pv_json_writer_t *w, const pv_json_field_t *field, const void *object)
+{
+    const rt_uint8_t *base = (const rt_uint8_t *)object + field->offset;
+
+    switch (field->type) {
+    case PV_JSON_INT:
+        pv_json_put_int(w, *(const rt_int32_t *)base);
+        break;
+    case PV_JSON_FIXED:
+        pv_json_put_fixed(w, *(const rt_int32_t *)base, field->decimals);
+        break;
+    case PV_JSON_STRING:
+        pv_json_put_string(w, (const char *)base);
+        break;
+    default:
+        pv_json_put_raw(w, "null");
+        break;
+    }
+}
+
+void pv_json_put_schema(pv_json_writer_t *w, const pv_json_schema_t *schema, const void *object, int id)
+{
+    if (schema->layout == PV_JSON_LAYOUT_DP) {
+        pv_json_put_raw(w, "{\"id\":");
+        pv_json_put_int(w, id);
+        pv_json_put_raw(w, ",\"dp\":{");
+    } else {
+        pv_json_put_raw(w, "{\"params\":{");
+    }
+
+    for (int i = 0; i < schema->count; i++) {
+        const pv_json_field_t *field = &schema->fields[i];
+
+        if (i > 0) {
+            writer_emit(w, ",", 1);
+        }
+        writer_emit(w, "\"", 1);
+        pv_json_put_raw(w, field->name);
+
+        if (schema->layout == PV_JSON_LAYOUT_DP) {
+            pv_json_put_raw(w, "\":[{\"v\":");
+            pv_json_put_value(w, field, object);
+            pv_json_put_raw(w, "}]");
+        } else {
+            pv_json_put_raw(w, "\":");
+            pv_json_put_value(w, field, object);
+        }
+    }
+
+    pv_json_put_raw(w, "}}");
+}
+
+rt_size_t pv_json_schema_size(const pv_json_schema_t *schema, const void *object, int id)
+{
+    pv_json_writer_t w;
+
+    pv_json_writer_init_count(&w);
+    pv_json_put_schema(&w, schema, object, id);
+
+    return w.len;
+}
+
+int pv_json_write(const pv_json_schema_t *schema, const void *object, int id, char *buf, rt_size_t size)
+{
+    pv_json_writer_t w;
+
+    pv_json_writer_init(&w, buf, size);
+    pv_json_put_schema(&w, schema, object, id);
+
+    if (pv_json_writer_finish(&w) != RT_EOK) {
+        return -RT_EFULL;
+    }
+
+    return (int)w.len;
+}
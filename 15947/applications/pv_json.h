@@ -0,0 +1,114 @@
+/*
+ * pv_json.h
+ *
+ * 光伏数据JSON序列化 (不使用printf)
+ * 字段表描述结构体中各字段的名称/类型/小数位, 定点数直接转换为十进制文本;
+ * 可写入调用者缓冲区、只计算长度, 或分块流式输出到发送函数。
+ */
+
+#ifndef PV_JSON_H
+#define PV_JSON_H
+
+#include <rtthread.h>
+#include <stddef.h>
+
+// 字段类型
+typedef enum {
+    PV_JSON_INT = 0,        // rt_int32_t
+    PV_JSON_FIXED,          // rt_int32_t 定点数, 值 = raw / 10^decimals
+    PV_JSON_STRING,         // 结构体内的 char 数组
+} pv_json_type_t;
+
+// 负载布局
+typedef enum {
+    PV_JSON_LAYOUT_DP = 0,  // {"id":N,"dp":{"name":[{"v":x}],...}}  (OneNET DP)
+    PV_JSON_LAYOUT_PARAMS,  // {"params":{"name":x,...}}
+} pv_json_layout_t;
+
+// 字段描述
+typedef struct {
+    const char *name;
+    rt_uint16_t offset;
+    rt_uint8_t type;
+    rt_uint8_t decimals;
+} pv_json_field_t;
+
+// 字段表
+typedef struct {
+    const pv_json_field_t *fields;
+    rt_uint16_t count;
+    rt_uint8_t layout;
+} pv_json_schema_t;
+
+/* 字段表生成宏 */
+#define PV_JSON_FIELD_INT(type, member, name)           { name, offsetof(type, member), PV_JSON_INT, 0 }
+#define PV_JSON_FIELD_FIXED(type, member, name, dec)    { name, offsetof(type, member), PV_JSON_FIXED, dec }
+#define PV_JSON_FIELD_STRING(type, member, name)        { name, offsetof(type, member), PV_JSON_STRING, 0 }
+#define PV_JSON_SCHEMA(table, layout)                   { table, sizeof(table) / sizeof(table[0]), layout }
+
+// 分块输出函数
+typedef rt_err_t (*pv_json_sink_t)(void *ctx, const char *chunk, rt_size_t len);
+
+// 输出器
+typedef struct {
+    char *buf;
+    rt_size_t size;
+    rt_size_t pos;          // 缓冲区内已写入的字节
+    rt_size_t len;          // 完整输出的总长度 (溢出后继续计数)
+    pv_json_sink_t sink;
+    void *ctx;
+    rt_err_t err;
+} pv_json_writer_t;
+
+/**
+ * @brief 写入调用者缓冲区, 空间不足时 err = -RT_EFULL 但 len 继续累计所需长度
+ */
+void pv_json_writer_init(pv_json_writer_t *w, char *buf, rt_size_t size);
+
+/**
+ * @brief 只计算长度, 不输出
+ */
+void pv_json_writer_init_count(pv_json_writer_t *w);
+
+/**
+ * @brief 流式输出, buf 作为分块缓冲, 写满即交给 sink
+ */
+void pv_json_writer_init_stream(pv_json_writer_t *w, char *buf, rt_size_t size,
+                                pv_json_sink_t sink, void *ctx);
+
+/**
+ * @brief 结束输出: 缓冲模式补 '\0', 流式模式冲刷剩余数据
+ * @return RT_EOK 成功, -RT_EFULL 缓冲区不足, 其他为 sink 返回的错误
+ */
+rt_err_t pv_json_writer_finish(pv_json_writer_t *w);
+
+/* 基本输出 */
+void pv_json_put_raw(pv_json_writer_t *w, const char *text);
+void pv_json_put_int(pv_json_writer_t *w, rt_int32_t value);
+void pv_json_put_uint(pv_json_writer_t *w, rt_uint32_t value);
+void pv_json_put_fixed(pv_json_writer_t *w, rt_int32_t value, rt_uint8_t decimals);
+void pv_json_put_string(pv_json_writer_t *w, const char *text);
+
+/**
+ * @brief 输出一个字段的值 (不含名称)
+ */
+void pv_json_put_value(pv_json_writer_t *w, const pv_json_field_t *field, const void *object);
+
+/**
+ * @brief 按字段表输出整个对象
+ * @param id DP布局中的消息ID, PARAMS布局忽略
+ */
+void pv_json_put_schema(pv_json_writer_t *w, const pv_json_schema_t *schema, const void *object, int id);
+
+/**
+ * @brief 精确计算按字段表输出的长度 (不含 '\0')
+ */
+rt_size_t pv_json_schema_size(const pv_json_schema_t *schema, const void *object, int id);
+
+/**
+ * @brief 按字段表写入缓冲区
+ * @return 输出长度, 缓冲区不足时返回 -RT_EFULL (不会输出被截断的JSON)
+ */
+int pv_json_write(const pv_json_schema_t *schema, const void *object, int id, char *buf, rt_size_t size);
+
+#endif // PV_JSON_H
@@ -2,26 +2,583 @@
 /* 光伏数据OneNET云平台客户端 */
 
 #include <stdint.h>
+#include <string.h>
 #include <rtthread.h>
 #include <rtdevice.h>
+#include <rthw.h>
+#include <sal_netbuf.h>
 #include "pv_cloud_config.h"
+#include "pv_onenet_client.h"
+
+/* 异步消息的负载放在一个网络缓冲中, 结尾留一字节给 '\0' */
+#ifndef SAL_USING_NETBUF
+#error "pv_onenet_client 的发布队列需要打开 SAL_USING_NETBUF"
+#elif PV_ONENET_PUB_PAYLOAD_SIZE >= SAL_NETBUF_BLOCK_SIZE
+#error "PV_ONENET_PUB_PAYLOAD_SIZE 必须小于 SAL_NETBUF_BLOCK_SIZE"
+#endif
 
 #ifdef PKG_USING_ONENET
 #include <onenet.h>
 #endif
 
+#if defined(RT_USING_AT) && defined(AT_USING_CLIENT)
+#include <at.h>
+#define PUB_USING_LINK_PROBE
+#endif
+
 /* OneNET客户端状态 */
 static rt_bool_t onenet_connected = RT_FALSE;
+#ifdef PKG_USING_ONENET
 static rt_bool_t onenet_initialized = RT_FALSE;
+#endif
 
 /* OneNET连接状态管理 - 简化版本 */
 
+/* ========== 异步发布队列 ========== */
+
+/* 发布线程配置 */
+#define PUB_THREAD_STACK            2048
+#define PUB_THREAD_PRIORITY         17
+#define PUB_THREAD_TICK             20
+
+/* 待发送的消息, 通过 next 串成空闲链表/待发送队列 */
+typedef struct pub_msg {
+    struct pub_msg *next;
+    const char *topic;
+    const rt_uint8_t *data;                 // 负载: 网络缓冲中的数据, 或 pv_onenet_publish() 调用者的缓冲
+    struct sal_netbuf *nb;                  // 异步消息持有的网络缓冲引用, 同步消息为 RT_NULL
+    struct rt_semaphore *done;              // pv_onenet_publish() 等待发送结果, 异步消息为 RT_NULL
+    int result;                             // 发送函数的返回值, 仅 done 非空时有效
+    rt_uint8_t kind;
+    rt_uint8_t retries;                     // 已重发次数
+    rt_uint16_t len;
+    rt_tick_t enqueue_tick;
+} pub_msg_t;
+
+/* 预分配的异步消息, 负载在SAL网络缓冲池中 */
+static pub_msg_t pub_pool[PV_ONENET_PUB_POOL];
+static pub_msg_t *pub_free = RT_NULL;
+static pub_msg_t *pub_head = RT_NULL;       // 待发送队列 (含发送失败待重发的消息)
+static pub_msg_t *pub_tail = RT_NULL;
+static rt_uint32_t pub_pending = 0;
+static rt_uint32_t pub_sending = 0;         // 发布线程正在发送的消息数 (0或1)
+
+static struct rt_mutex pub_lock;
+static struct rt_semaphore pub_sem;
+static rt_thread_t pub_thread = RT_NULL;
+static rt_bool_t pub_initialized = RT_FALSE;
+
+/* 统计, 时延为入队到发出 (ms) */
+static rt_uint32_t pub_stat_enqueued = 0;
+static rt_uint32_t pub_stat_sent = 0;
+static rt_uint32_t pub_stat_rejected = 0;   // 消息或网络缓冲用完
+static rt_uint32_t pub_stat_send_failed = 0;
+static rt_uint32_t pub_stat_retransmits = 0;
+static rt_uint32_t pub_stat_expired = 0;    // 超过重发次数被丢弃
+static rt_uint32_t pub_stat_link_down = 0;  // 模组无信号或未附着时失败, 不计重发次数
+static rt_uint32_t pub_lat_min = 0;
+static rt_uint32_t pub_lat_max = 0;
+static rt_uint32_t pub_lat_last = 0;
+static rt_uint64_t pub_lat_sum = 0;
+
+static int onenet_default_transport(rt_uint8_t kind, const char *topic,
+                                    const rt_uint8_t *payload, rt_size_t len)
+{
+#ifdef PKG_USING_ONENET
+    /* SDK不报告PUBACK, 返回成功只表示报文已交给模块 */
+    if (kind == PV_ONENET_PUB_STRING) {
+        return (onenet_mqtt_upload_string(topic, (const char *)payload) == 0) ? 0 : -1;
+    }
+    return (onenet_mqtt_publish(topic, (rt_uint8_t *)payload, len) == 0) ? 0 : -1;
+#else
+    return -1;
+#endif
+}
+
+static pv_onenet_transport_t pub_transport = onenet_default_transport;
+
+/* ========== 模组链路查询 ========== */
+
+/*
+ * 发送失败后, 发布线程用异步AT命令查询模组的信号和网络附着状态, 不等待应答, 照常
+ * 等待 PV_ONENET_PUB_RETRY_MS。两条命令由AT客户端依次发出, 应答按顺序对应, 结果在
+ * 解析线程的回调中记录, 等待结束后用来决定是否计入重发次数。
+ */
+#define PUB_LINK_RESP_TIMEOUT_MS    300
+
+static rt_int8_t link_rssi = -1;            // AT+CSQ 的信号强度 0~31, 99 无信号, -1 未知
+static rt_int8_t link_attached = -1;        // AT+CGATT? 1 已附着, 0 未附着, -1 未知
+static rt_uint8_t link_probe_pending = 0;   // 已入队未完成的查询命令数
+static rt_uint32_t link_probes = 0;
+
+#ifdef PUB_USING_LINK_PROBE
+static struct at_cmd_req link_csq_req;
+static struct at_cmd_req link_cgatt_req;
+static at_response_t link_csq_resp = RT_NULL;
+static at_response_t link_cgatt_resp = RT_NULL;
+
+/* 以下两个回调在AT客户端解析线程中调用, 只关中断更新结果, 不取应用的锁 */
+static void link_csq_done(at_client_t client, at_cmd_req_t req, int result)
+{
+    int rssi = -1, ber = 0;
+    rt_base_t level;
+
+    if (result != RT_EOK ||
+        at_resp_parse_line_args_by_kw(req->resp, "+CSQ:", "+CSQ: %d,%d", &rssi, &ber) != 2) {
+        rssi = -1;
+    }
+
+    level = rt_hw_interrupt_disable();
+    link_rssi = (rt_int8_t)rssi;
+    link_probe_pending--;
+    rt_hw_interrupt_enable(level);
+}
+
+static void link_cgatt_done(at_client_t client, at_cmd_req_t req, int result)
+{
+    int attached = -1;
+    rt_base_t level;
+
+    if (result != RT_EOK ||
+        at_resp_parse_line_args_by_kw(req->resp, "+CGATT:", "+CGATT: %d", &attached) != 1) {
+        attached = -1;
+    }
+
+    level = rt_hw_interrupt_disable();
+    link_attached = (rt_int8_t)attached;
+    link_probe_pending--;
+    rt_hw_interrupt_enable(level);
+}
+#endif /* PUB_USING_LINK_PROBE */
+
+/**
+ * @brief 异步查询模组链路状态, 只在发布线程中调用, 不持 pub_lock
+ * 上一次查询还没完成时不再查询
+ */
+static void pub_link_probe(void)
+{
+#ifdef PUB_USING_LINK_PROBE
+    at_client_t client = at_client_get_first();
+    rt_base_t level;
+
+    if (client == RT_NULL || link_probe_pending > 0) {
+        return;
+    }
+
+    if (link_csq_resp == RT_NULL) {
+        link_csq_resp = at_create_resp(64, 0, rt_tick_from_millisecond(PUB_LINK_RESP_TIMEOUT_MS));
+    }
+    if (link_cgatt_resp == RT_NULL) {
+        link_cgatt_resp = at_create_resp(64, 0, rt_tick_from_millisecond(PUB_LINK_RESP_TIMEOUT_MS));
+    }
+    if (link_csq_resp == RT_NULL || link_cgatt_resp == RT_NULL) {
+        return;
+    }
+
+    at_cmd_req_init(&link_csq_req, link_csq_resp, link_csq_done, RT_NULL);
+    at_cmd_req_init(&link_cgatt_req, link_cgatt_resp, link_cgatt_done, RT_NULL);
+
+    /* 回调可能在入队返回前就被调用, 先记下待完成数 */
+    level = rt_hw_interrupt_disable();
+    link_rssi = -1;
+    link_attached = -1;
+    link_probe_pending = 2;
+    rt_hw_interrupt_enable(level);
+    link_probes++;
+
+    if (at_obj_exec_cmd_async(client, &link_csq_req, "AT+CSQ") != RT_EOK) {
+        level = rt_hw_interrupt_disable();
+        link_probe_pending--;
+        rt_hw_interrupt_enable(level);
+    }
+    if (at_obj_exec_cmd_async(client, &link_cgatt_req, "AT+CGATT?") != RT_EOK) {
+        level = rt_hw_interrupt_disable();
+        link_probe_pending--;
+        rt_hw_interrupt_enable(level);
+    }
+#endif
+}
+
+/**
+ * @brief 最近一次查询已完成且模组报告无信号或未附着网络
+ */
+static rt_bool_t pub_link_down(void)
+{
+    rt_bool_t down;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    down = (link_probe_pending == 0) && (link_rssi == 99 || link_attached == 0);
+    rt_hw_interrupt_enable(level);
+
+    return down;
+}
+
+/* 以下函数需持有 pub_lock */
+static void pub_push_front(pub_msg_t *msg)
+{
+    msg->next = pub_head;
+    pub_head = msg;
+    if (pub_tail == RT_NULL) {
+        pub_tail = msg;
+    }
+    pub_pending++;
+}
+
+static void pub_push_back(pub_msg_t *msg)
+{
+    msg->next = RT_NULL;
+    if (pub_tail != RT_NULL) {
+        pub_tail->next = msg;
+    } else {
+        pub_head = msg;
+    }
+    pub_tail = msg;
+    pub_pending++;
+    pub_stat_enqueued++;
+}
+
+/**
+ * @brief 从队列中摘下一条消息
+ * @return RT_TRUE 已摘下, RT_FALSE 不在队列中 (已被发布线程取走)
+ */
+static rt_bool_t pub_unlink(pub_msg_t *msg)
+{
+    pub_msg_t *prev = RT_NULL;
+    pub_msg_t *cur;
+
+    for (cur = pub_head; cur != RT_NULL; prev = cur, cur = cur->next) {
+        if (cur == msg) {
+            if (prev != RT_NULL) {
+                prev->next = cur->next;
+            } else {
+                pub_head = cur->next;
+            }
+            if (pub_tail == cur) {
+                pub_tail = prev;
+            }
+            pub_pending--;
+            return RT_TRUE;
+        }
+    }
+    return RT_FALSE;
+}
+
+/**
+ * @brief 取出下一条可以发送的消息
+ * 未调用 pv_onenet_connect() 时异步消息留在队列中; pv_onenet_publish() 的消息照常发送,
+ * 由调用者根据发送结果判断链路
+ */
+static pub_msg_t *pub_pop_ready(void)
+{
+    pub_msg_t *msg;
+
+    for (msg = pub_head; msg != RT_NULL; msg = msg->next) {
+        if (onenet_connected || msg->done != RT_NULL) {
+            pub_unlink(msg);
+            return msg;
+        }
+    }
+    return RT_NULL;
+}
+
+static void pub_release(pub_msg_t *msg)
+{
+    /* 放掉队列的引用, 其他持有者 (如生成负载的线程) 的引用不受影响 */
+    sal_netbuf_free(msg->nb);
+    msg->nb = RT_NULL;
+    msg->next = pub_free;
+    pub_free = msg;
+}
+
+static void pub_account(pub_msg_t *msg)
+{
+    rt_uint32_t latency = (rt_tick_get() - msg->enqueue_tick) * 1000 / RT_TICK_PER_SECOND;
+
+    if (pub_stat_sent == 0 || latency < pub_lat_min) {
+        pub_lat_min = latency;
+    }
+    if (latency > pub_lat_max) {
+        pub_lat_max = latency;
+    }
+    pub_lat_last = latency;
+    pub_lat_sum += latency;
+    pub_stat_sent++;
+}
+
+/**
+ * @brief 发送失败: 放回队首重发, 超过次数则丢弃
+ * 模组报告链路断开时不怪消息, 不计重发次数, 等链路恢复
+ */
+static void pub_retry(pub_msg_t *msg)
+{
+    if (pub_link_down()) {
+        pub_stat_link_down++;
+        pub_stat_retransmits++;
+        pub_push_front(msg);
+        return;
+    }
+
+    if (msg->retries >= PV_ONENET_PUB_RETRY_MAX) {
+        pub_stat_expired++;
+        rt_kprintf("OneNET publish: message dropped after %d retries\n", msg->retries);
+        pub_release(msg);
+        return;
+    }
+
+    msg->retries++;
+    pub_stat_retransmits++;
+    pub_push_front(msg);
+}
+
+static void pub_thread_entry(void *parameter)
+{
+    while (1) {
+        rt_sem_take(&pub_sem, RT_WAITING_FOREVER);
+
+        rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+
+        /* 逐条发送, 发送时不持锁 */
+        while (pub_head != RT_NULL) {
+            pub_msg_t *msg = pub_pop_ready();
+            int result;
+
+            if (msg == RT_NULL) {
+                break;
+            }
+
+            pub_sending = 1;
+            rt_mutex_release(&pub_lock);
+
+            result = pub_transport(msg->kind, msg->topic, msg->data, msg->len);
+
+            rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+            if (result == 0) {
+                pub_account(msg);
+            } else {
+                pub_stat_send_failed++;
+            }
+
+            if (msg->done != RT_NULL) {
+                /* 结果交给等待的调用者, 由调用者重试; 之后不能再访问 msg */
+                pub_sending = 0;
+                msg->result = result;
+                rt_sem_release(msg->done);
+            } else if (result == 0) {
+                pub_sending = 0;
+                pub_release(msg);
+            } else {
+                /* 链路异常时给模块恢复时间, 同时查询模组链路状态; 等待期间消息仍算作正在发送 */
+                rt_mutex_release(&pub_lock);
+                pub_link_probe();
+                rt_thread_mdelay(PV_ONENET_PUB_RETRY_MS);
+                rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+                pub_sending = 0;
+                pub_retry(msg);
+            }
+        }
+        rt_mutex_release(&pub_lock);
+    }
+}
+
+/**
+ * @brief 初始化发布队列和发布线程, 启动时执行一次, 在任何线程发布之前完成
+ */
+static int pub_queue_init(void)
+{
+    rt_uint32_t i;
+
+    for (i = 0; i < PV_ONENET_PUB_POOL; i++) {
+        pub_pool[i].nb = RT_NULL;
+        pub_release(&pub_pool[i]);
+    }
+
+    rt_mutex_init(&pub_lock, "pv_pub", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&pub_sem, "pv_pub", 0, RT_IPC_FLAG_FIFO);
+
+    pub_thread = rt_thread_create("pv_pub",
+                                  pub_thread_entry,
+                                  RT_NULL,
+                                  PUB_THREAD_STACK,
+                                  PUB_THREAD_PRIORITY,
+                                  PUB_THREAD_TICK);
+    if (pub_thread == RT_NULL) {
+        rt_sem_detach(&pub_sem);
+        rt_mutex_detach(&pub_lock);
+        pub_free = RT_NULL;
+        rt_kprintf("Error: Create OneNET publish thread failed!\n");
+        return -RT_ENOMEM;
+    }
+
+    pub_initialized = RT_TRUE;
+    rt_thread_startup(pub_thread);
+
+    return RT_EOK;
+}
+INIT_APP_EXPORT(pub_queue_init);
+
+/**
+ * @brief 把网络缓冲中的负载入队, 接管调用者对 nb 的一个引用
+ * 失败时引用仍归调用者
+ */
+static rt_err_t pub_enqueue(rt_uint8_t kind, const char *topic, struct sal_netbuf *nb)
+{
+    pub_msg_t *msg;
+
+    rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+    msg = pub_free;
+    if (msg == RT_NULL) {
+        pub_stat_rejected++;
+        rt_mutex_release(&pub_lock);
+        return -RT_EFULL;
+    }
+    pub_free = msg->next;
+
+    /* 字符串数据点按C字符串发送, 结尾的 '\0' 写在数据之后, 不改变负载 */
+    nb->payload[nb->len] = '\0';
+    msg->topic = topic;
+    msg->data = nb->payload;
+    msg->nb = nb;
+    msg->done = RT_NULL;
+    msg->kind = kind;
+    msg->retries = 0;
+    msg->len = nb->len;
+    msg->enqueue_tick = rt_tick_get();
+    pub_push_back(msg);
+    rt_mutex_release(&pub_lock);
+
+    rt_sem_release(&pub_sem);
+
+    return RT_EOK;
+}
+
+rt_err_t pv_onenet_publish_async(rt_uint8_t kind, const char *topic, const void *payload, rt_size_t len)
+{
+    struct sal_netbuf *nb;
+    rt_err_t result;
+
+    if (topic == RT_NULL || payload == RT_NULL) {
+        return -RT_EINVAL;
+    }
+    if (len > PV_ONENET_PUB_PAYLOAD_SIZE) {
+        return -RT_EINVAL;
+    }
+    if (!pub_initialized) {
+        return -RT_ERROR;                   // 发布队列未启动
+    }
+
+    nb = sal_netbuf_alloc();
+    if (nb == RT_NULL) {
+        rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+        pub_stat_rejected++;
+        rt_mutex_release(&pub_lock);
+        return -RT_EFULL;
+    }
+    rt_memcpy(nb->payload, payload, len);
+    nb->len = (rt_uint16_t)len;
+
+    result = pub_enqueue(kind, topic, nb);
+    if (result != RT_EOK) {
+        sal_netbuf_free(nb);
+    }
+
+    return result;
+}
+
+rt_err_t pv_onenet_publish_netbuf(rt_uint8_t kind, const char *topic, struct sal_netbuf *nb)
+{
+    rt_err_t result;
+
+    if (topic == RT_NULL || nb == RT_NULL) {
+        return -RT_EINVAL;
+    }
+    /* 发送函数要一段连续的负载, 只收单个缓冲 */
+    if (nb->next != RT_NULL || nb->len > PV_ONENET_PUB_PAYLOAD_SIZE || sal_netbuf_space(nb) == 0) {
+        return -RT_EINVAL;
+    }
+    if (!pub_initialized) {
+        return -RT_ERROR;
+    }
+
+    /* 队列持有自己的引用, 发出后放掉, 调用者照常释放它的引用 */
+    sal_netbuf_ref(nb);
+    result = pub_enqueue(kind, topic, nb);
+    if (result != RT_EOK) {
+        sal_netbuf_free(nb);
+    }
+
+    return result;
+}
+
+rt_err_t pv_onenet_publish(rt_uint8_t kind, const char *topic, const void *payload, rt_size_t len,
+                           rt_int32_t timeout)
+{
+    pub_msg_t msg;
+    struct rt_semaphore done;
+
+    if (topic == RT_NULL || payload == RT_NULL || len > 0xFFFF) {
+        return -RT_EINVAL;
+    }
+    if (!pub_initialized) {
+        return -RT_ERROR;
+    }
+
+    /* 负载留在调用者的缓冲中, 调用者等到发送结束才返回 */
+    rt_sem_init(&done, "pv_pubw", 0, RT_IPC_FLAG_FIFO);
+    msg.topic = topic;
+    msg.data = (const rt_uint8_t *)payload;
+    msg.nb = RT_NULL;
+    msg.done = &done;
+    msg.result = -1;
+    msg.kind = kind;
+    msg.retries = 0;
+    msg.len = (rt_uint16_t)len;
+    msg.enqueue_tick = rt_tick_get();
+
+    rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+    pub_push_back(&msg);
+    rt_mutex_release(&pub_lock);
+
+    rt_sem_release(&pub_sem);
+
+    if (rt_sem_take(&done, timeout) != RT_EOK) {
+        rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+        if (pub_unlink(&msg)) {
+            rt_mutex_release(&pub_lock);
+            rt_sem_detach(&done);
+            return -RT_ETIMEOUT;
+        }
+        rt_mutex_release(&pub_lock);
+
+        /* 发布线程已取走, 等发送函数返回 */
+        rt_sem_take(&done, RT_WAITING_FOREVER);
+    }
+    rt_sem_detach(&done);
+
+    return (msg.result == 0) ? RT_EOK : -RT_ERROR;
+}
+
+void pv_onenet_set_transport(pv_onenet_transport_t transport)
+{
+    pub_transport = (transport != RT_NULL) ? transport : onenet_default_transport;
+}
+
+rt_uint32_t pv_onenet_publish_backlog(void)
+{
+    return pub_pending + pub_sending;
+}
+
 /**
  * @brief 初始化OneNET客户端
  */
 int pv_onenet_init(void)
 {
 #ifdef PKG_USING_ONENET
+    if (!pub_initialized) {
+        rt_kprintf("❌ OneNET publish queue not started\n");
+        return -1;
+    }
+
     if (onenet_initialized) {
         rt_kprintf("OneNET already initialized\n");
         return 0;
@@ -71,6 +628,11 @@ int pv_onenet_connect(void)
     /* OneNET MQTT在初始化时通常已经连接 */
     onenet_connected = RT_TRUE;
     rt_kprintf("✅ OneNET connected successfully\n");
+
+    /* 发送断开期间积压的消息 */
+    if (pub_initialized) {
+        rt_sem_release(&pub_sem);
+    }
     return 0;
 #else
     rt_kprintf("❌ OneNET package not enabled\n");
@@ -117,15 +679,15 @@ int pv_onenet_upload_data(const char *json_data)
         return -1;
     }
 
-    rt_kprintf("📤 Uploading data to OneNET...\n");
+    rt_kprintf("📤 Queueing data for OneNET...\n");
     rt_kprintf("Data: %s\n", json_data);
 
-    /* 使用OneNET字符串上传API */
-    if (onenet_mqtt_upload_string("pv_data", json_data) == 0) {
-        rt_kprintf("✅ Data uploaded successfully\n");
+    /* 由发布线程调用OneNET字符串上传API */
+    if (pv_onenet_publish_async(PV_ONENET_PUB_STRING, "pv_data", json_data, rt_strlen(json_data)) == RT_EOK) {
+        rt_kprintf("✅ Data queued\n");
         return 0;
     } else {
-        rt_kprintf("❌ Data upload failed\n");
+        rt_kprintf("❌ Data queue failed (queue full or data too long)\n");
         return -1;
     }
 #else
@@ -262,6 +824,35 @@ int pv_onenet_status(void)
     return 0;
 }
 
+/**
+ * @brief 查看异步发布队列状态及时延统计
+ */
+int pv_onenet_pubstat(void)
+{
+    rt_kprintf("\n=== OneNET Publish Queue ===\n");
+    if (!pub_initialized) {
+        rt_kprintf("Not started\n");
+        return 0;
+    }
+
+    rt_mutex_take(&pub_lock, RT_WAITING_FOREVER);
+    rt_kprintf("Pending: %d, Sending: %d, Pool: %d\n",
+               pub_pending, pub_sending, PV_ONENET_PUB_POOL);
+    rt_kprintf("Enqueued: %d, Sent: %d, Rejected (pool full): %d\n",
+               pub_stat_enqueued, pub_stat_sent, pub_stat_rejected);
+    rt_kprintf("Send failed: %d, Retransmits: %d, Expired: %d, Link down: %d\n",
+               pub_stat_send_failed, pub_stat_retransmits, pub_stat_expired, pub_stat_link_down);
+    rt_kprintf("Link probes: %d, CSQ: %d, CGATT: %d\n", link_probes, link_rssi, link_attached);
+    if (pub_stat_sent > 0) {
+        rt_kprintf("Latency (ms): min %d, avg %d, max %d, last %d\n",
+                   pub_lat_min, (rt_uint32_t)(pub_lat_sum / pub_stat_sent), pub_lat_max, pub_lat_last);
+    }
+    rt_mutex_release(&pub_lock);
+    rt_kprintf("============================\n");
+
+    return 0;
+}
+
 /**
  * @brief OneNET完整测试
  */
@@ -309,4 +900,5 @@ MSH_CMD_EXPORT(pv_onenet_init, Initialize OneNET client);
 MSH_CMD_EXPORT(pv_onenet_connect, Connect to OneNET platform);
 MSH_CMD_EXPORT(pv_onenet_disconnect, Disconnect from OneNET);
 MSH_CMD_EXPORT(pv_onenet_status, Show OneNET connection status);
+MSH_CMD_EXPORT(pv_onenet_pubstat, Show OneNET publish queue statistics);
 MSH_CMD_EXPORT(pv_onenet_test, Complete OneNET functionality test);
@@ -0,0 +1,76 @@
+/*
+ * pv_onenet_client.h
+ *
+ * 光伏数据OneNET云平台客户端
+ * 采集线程把消息压入预分配的发布队列后立即返回, 由发布线程依次发送, 只有发布线程
+ * 调用OneNET MQTT客户端。队列是发出即忘的: OneNET软件包不报告PUBACK, 发送函数返回
+ * 成功即完成, 只有本地发送失败的消息会重发。统计每条消息从入队到发出的时延。
+ * 异步消息的负载放在SAL网络缓冲 (sal_netbuf) 中, 队列持有缓冲的引用直到发出。
+ * 发送失败后发布线程用异步AT命令查询模组的信号和网络附着状态, 模组报告链路断开时
+ * 失败不计重发次数, 消息留在队列中等链路恢复。
+ */
+
+#ifndef PV_ONENET_CLIENT_H
+#define PV_ONENET_CLIENT_H
+
+#include <rtthread.h>
+#include <sal_netbuf.h>
+
+// 消息类型
+#define PV_ONENET_PUB_RAW           0   // 原样发布到 topic
+#define PV_ONENET_PUB_STRING        1   // 字符串数据点, topic 为数据流名称
+
+/**
+ * @brief 发送函数, 在发布线程中调用
+ * @return 0 已发出, <0 发送失败 (消息稍后重发)
+ * 默认使用 onenet_mqtt_publish() / onenet_mqtt_upload_string()
+ */
+typedef int (*pv_onenet_transport_t)(rt_uint8_t kind, const char *topic,
+                                     const rt_uint8_t *payload, rt_size_t len);
+
+int pv_onenet_init(void);
+int pv_onenet_connect(void);
+int pv_onenet_disconnect(void);
+
+/**
+ * @brief 入队一条消息, 不等待网络
+ * topic 只保存指针, 必须在消息发出前保持有效 (一般为字符串常量)
+ * 发布队列在启动时由 INIT_APP_EXPORT 初始化
+ * 负载拷贝到一个网络缓冲中; 已在网络缓冲中生成的负载用 pv_onenet_publish_netbuf()
+ * @return RT_EOK 已入队, -RT_EFULL 消息或网络缓冲已用完, -RT_EINVAL 负载过长, -RT_ERROR 发布队列未启动
+ */
+rt_err_t pv_onenet_publish_async(rt_uint8_t kind, const char *topic, const void *payload, rt_size_t len);
+
+/**
+ * @brief 入队一个网络缓冲中的负载, 不拷贝
+ * 负载直接写在 nb 中 (如 sal_netbuf_space() 给出的空间), 队列另外持有一个引用直到发出,
+ * 调用者入队后照常用 sal_netbuf_free() 放掉自己的引用, 之后不能再修改缓冲。
+ * 只收单个缓冲, 负载不超过 PV_ONENET_PUB_PAYLOAD_SIZE。
+ * @return 同 pv_onenet_publish_async(), -RT_EINVAL 也表示缓冲链多于一个缓冲
+ */
+rt_err_t pv_onenet_publish_netbuf(rt_uint8_t kind, const char *topic, struct sal_netbuf *nb);
+
+/**
+ * @brief 经发布队列发送一条消息并等待发送结果
+ * 负载不拷贝, 由发布线程直接从调用者的缓冲发送, 不受 PV_ONENET_PUB_PAYLOAD_SIZE 限制。
+ * 未调用 pv_onenet_connect() 时也会发送; 发送失败不重发, 由调用者决定何时重试。
+ * @param timeout 等待排队的最长时间 (tick), 消息已开始发送时等到发送函数返回
+ * @return RT_EOK 已发出, -RT_ERROR 发送失败或发布队列未启动, -RT_ETIMEOUT 超时未发送 (已撤回),
+ *         -RT_EINVAL 参数错误
+ */
+rt_err_t pv_onenet_publish(rt_uint8_t kind, const char *topic, const void *payload, rt_size_t len,
+                           rt_int32_t timeout);
+
+/**
+ * @brief 替换发送函数, 传入 RT_NULL 恢复默认
+ */
+void pv_onenet_set_transport(pv_onenet_transport_t transport);
+
+/**
+ * @brief 获取等待发送及正在发送的消息数
+ */
+rt_uint32_t pv_onenet_publish_backlog(void);
+
+int pv_onenet_upload_data(const char *json_data);
+
+#endif // PV_ONENET_CLIENT_H
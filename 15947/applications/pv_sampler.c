@@ -0,0 +1,758 @@
+/* applications/pv_sampler.c */
+/* 光伏ADC共享采样服务 */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <rthw.h>
+#include <board.h>
+#include <stdlib.h>
+#include "pv_cloud_config.h"
+#include "pv_sampler.h"
+#include "pv_filter.h"
+
+/* 采样线程配置 */
+#define PV_SAMPLER_THREAD_STACK     3072    // 订阅者 (故障检测按拓扑逐板计算) 在本线程运行
+#define PV_SAMPLER_THREAD_PRIORITY  12
+#define PV_SAMPLER_THREAD_TICK      10
+
+/* DMA扫描配置: 每半缓冲的帧数 */
+#define PV_SAMPLER_SCAN_FRAMES      64
+/* 中断交给采样线程的半缓冲副本数, 线程迟到这么多个半缓冲以内不丢数据 */
+#define PV_SAMPLER_SCAN_QUEUE       4
+
+/* 帧内各通道对应的ADC1通道号, 顺序见 pv_sampler.h */
+static const rt_uint8_t pv_sampler_channels[PV_SAMPLER_CH_NUM] =
+{
+    0,      // PA0 -> ADC1_IN0
+    1,      // PA1 -> ADC1_IN1
+    9,      // PB0 -> ADC1_INP9
+    5,      // PB1 -> ADC1_INP5
+    3,      // PA6 -> ADC1_INP3
+    7,      // PA7 -> ADC1_INP7
+};
+
+/* 帧内各通道的引脚名, 用于打印和命令解析 */
+static const char *const pv_sampler_channel_names[PV_SAMPLER_CH_NUM] =
+{
+    "PA0", "PA1", "PB0", "PB1", "PA6", "PA7",
+};
+
+/* 订阅者 */
+typedef struct {
+    pv_sampler_callback_t callback;
+    void *user_data;
+} pv_sampler_subscriber_t;
+
+/* 采样服务状态 */
+static rt_adc_device_t sampler_adc = RT_NULL;
+static rt_thread_t sampler_thread = RT_NULL;
+static volatile rt_bool_t sampler_running = RT_FALSE;
+static rt_bool_t sampler_scan_mode = RT_FALSE;
+/* 启动和停止互斥, 停止等采样线程退出后才返回 */
+static struct rt_mutex sampler_lock;
+static struct rt_semaphore sampler_exit_sem;
+
+/*
+ * 双槽 seqlock: 写者总是写入 (seq+1) 对应的空闲槽, 写完后再发布 seq,
+ * 因此读者即使打断写者, 读到的已发布槽也是完整的; 读完后 seq 未变即成功。
+ */
+static pv_sample_frame_t sampler_slots[2];
+static volatile rt_uint32_t sampler_seq = 0;
+
+static pv_sampler_subscriber_t sampler_subscribers[PV_SAMPLER_MAX_SUBSCRIBERS];
+/* 采样线程调用订阅回调期间持有; 取消订阅拿到它才返回, 之后不会再有该回调在运行 */
+static struct rt_mutex sampler_subscriber_lock;
+
+/* 每通道滤波链, 只在采样线程中运行; 命令替换滤波链时持有 sampler_filter_lock */
+static pv_filter_chain_t sampler_filters[PV_SAMPLER_CH_NUM];
+static struct rt_mutex sampler_filter_lock;
+/* 周期内滤波链没有输出 (抽取) 时沿用上一次的值 */
+static rt_uint16_t sampler_last_raw[PV_SAMPLER_CH_NUM];
+
+/**
+ * @brief 按默认配置初始化所有通道的滤波链
+ */
+static void pv_sampler_filters_init(void)
+{
+    static const pv_filter_config_t defaults[] = PV_FILTER_DEFAULT_CHAIN;
+
+    for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+        if (pv_filter_chain_init(&sampler_filters[ch], defaults,
+                                 sizeof(defaults) / sizeof(defaults[0])) != RT_EOK) {
+            rt_kprintf("Warning: invalid PV_FILTER_DEFAULT_CHAIN, filtering disabled\n");
+            pv_filter_chain_init(&sampler_filters[ch], RT_NULL, 0);
+        }
+    }
+    rt_mutex_init(&sampler_filter_lock, "pv_flt", RT_IPC_FLAG_PRIO);
+}
+
+/**
+ * @brief 滤波一个通道的数据块并求输出平均 (调用者持有 sampler_filter_lock)
+ * @return 输出样本数, 0 时 raw 不变
+ */
+static rt_size_t pv_sampler_filter_block(int ch, rt_int32_t *block, rt_size_t count, rt_uint32_t *sum)
+{
+    rt_size_t n = pv_filter_chain_process(&sampler_filters[ch], block, count);
+
+    for (rt_size_t i = 0; i < n; i++) {
+        *sum += (rt_uint32_t)block[i];
+    }
+
+    return n;
+}
+
+#ifdef BSP_ADC_USING_DMA
+/* DMA双缓冲, 按cache行对齐 */
+ALIGN(32) static rt_uint16_t scan_buffer[2 * PV_SAMPLER_SCAN_FRAMES * PV_SAMPLER_CH_NUM];
+
+/*
+ * 中断只把半缓冲拷进队列 (768字节), 解交织和滤波在采样线程中做。6通道64帧的默认滤波链
+ * 在 PC 上每个半缓冲约 8 us, 拷贝不到 0.1 us (applications/host 的 filter_bench)。
+ * 中断写 scan_head, 线程写 scan_tail。
+ */
+static rt_uint16_t scan_queue[PV_SAMPLER_SCAN_QUEUE][PV_SAMPLER_SCAN_FRAMES * PV_SAMPLER_CH_NUM];
+static rt_uint16_t scan_queue_frames[PV_SAMPLER_SCAN_QUEUE];
+static volatile rt_uint32_t scan_head = 0;
+static volatile rt_uint32_t scan_tail = 0;
+static rt_uint32_t scan_overruns = 0;
+static struct rt_semaphore scan_sem;
+
+/* 线程中把滤波输出累加, 按周期取走 */
+static rt_uint32_t scan_sum[PV_SAMPLER_CH_NUM];
+static rt_uint32_t scan_outputs[PV_SAMPLER_CH_NUM];
+static rt_uint32_t scan_count = 0;
+
+/* 单通道数据块, 仅在采样线程中使用 */
+static rt_int32_t scan_block[PV_SAMPLER_SCAN_FRAMES];
+
+/**
+ * @brief 半缓冲完成回调 (中断上下文), 队列满时丢弃这半个缓冲
+ */
+static void pv_sampler_scan_done(rt_adc_device_t dev, const rt_uint16_t *frames, rt_size_t frame_count, void *user_data)
+{
+    rt_uint32_t head = scan_head;
+
+    if (head - scan_tail >= PV_SAMPLER_SCAN_QUEUE || frame_count > PV_SAMPLER_SCAN_FRAMES) {
+        scan_overruns++;
+        return;
+    }
+
+    rt_memcpy(scan_queue[head % PV_SAMPLER_SCAN_QUEUE], frames, frame_count * PV_SAMPLER_CH_NUM * sizeof(rt_uint16_t));
+    scan_queue_frames[head % PV_SAMPLER_SCAN_QUEUE] = (rt_uint16_t)frame_count;
+
+    /* 副本写完后才发布 */
+    __DMB();
+    scan_head = head + 1;
+    rt_sem_release(&scan_sem);
+}
+
+/**
+ * @brief 滤波队列中的全部半缓冲 (采样线程)
+ */
+static void pv_sampler_scan_drain(void)
+{
+    rt_uint32_t tail = scan_tail;
+
+    rt_mutex_take(&sampler_filter_lock, RT_WAITING_FOREVER);
+    while (tail != scan_head) {
+        const rt_uint16_t *frames = scan_queue[tail % PV_SAMPLER_SCAN_QUEUE];
+        rt_size_t frame_count;
+
+        /* 先看到 scan_head 再读副本 */
+        __DMB();
+        frame_count = scan_queue_frames[tail % PV_SAMPLER_SCAN_QUEUE];
+
+        /* 逐通道解交织后送入滤波链 */
+        for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+            for (rt_size_t f = 0; f < frame_count; f++) {
+                scan_block[f] = frames[f * PV_SAMPLER_CH_NUM + ch];
+            }
+            scan_outputs[ch] += pv_sampler_filter_block(ch, scan_block, frame_count, &scan_sum[ch]);
+        }
+        scan_count += frame_count;
+
+        /* 处理完才归还这个副本 */
+        __DMB();
+        scan_tail = ++tail;
+    }
+    rt_mutex_release(&sampler_filter_lock);
+}
+
+/**
+ * @brief 配置并启动DMA扫描组
+ */
+static rt_err_t pv_sampler_scan_start(void)
+{
+    struct rt_adc_scan_config config;
+    rt_err_t result;
+
+    config.channels = pv_sampler_channels;
+    config.channel_count = PV_SAMPLER_CH_NUM;
+    config.frames_per_half = PV_SAMPLER_SCAN_FRAMES;
+    config.buffer = scan_buffer;
+    config.trigger = RT_ADC_SCAN_TRIGGER_CONTINUOUS;
+    config.frame_done = pv_sampler_scan_done;
+    config.user_data = RT_NULL;
+
+    scan_count = 0;
+    rt_memset(scan_sum, 0, sizeof(scan_sum));
+    rt_memset(scan_outputs, 0, sizeof(scan_outputs));
+    scan_head = scan_tail = 0;
+    rt_sem_control(&scan_sem, RT_IPC_CMD_RESET, RT_NULL);
+
+    result = rt_adc_scan_config(sampler_adc, &config);
+    if (result != RT_EOK) {
+        return result;
+    }
+
+    return rt_adc_scan_start(sampler_adc);
+}
+
+/**
+ * @brief 取走本周期累加的结果并求平均
+ * @return 参与平均的硬件帧数
+ */
+static rt_uint16_t pv_sampler_scan_collect(rt_uint16_t raw[PV_SAMPLER_CH_NUM])
+{
+    rt_uint32_t count = scan_count;
+
+    if (count == 0) {
+        return 0;
+    }
+
+    for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+        if (scan_outputs[ch] > 0) {
+            sampler_last_raw[ch] = (rt_uint16_t)(scan_sum[ch] / scan_outputs[ch]);
+        }
+        raw[ch] = sampler_last_raw[ch];
+    }
+
+    rt_memset(scan_sum, 0, sizeof(scan_sum));
+    rt_memset(scan_outputs, 0, sizeof(scan_outputs));
+    scan_count = 0;
+
+    return count > 0xFFFF ? 0xFFFF : (rt_uint16_t)count;
+}
+
+/**
+ * @brief 扫描模式的一个发布周期: 每来一个半缓冲就滤波, 到周期末取走结果
+ */
+static rt_uint16_t pv_sampler_scan_period(rt_uint16_t raw[PV_SAMPLER_CH_NUM])
+{
+    rt_tick_t deadline = rt_tick_get() + rt_tick_from_millisecond(PV_SAMPLER_PERIOD_MS);
+    rt_int32_t wait;
+
+    while (sampler_running && (wait = (rt_int32_t)(deadline - rt_tick_get())) > 0) {
+        rt_sem_take(&scan_sem, wait);
+        pv_sampler_scan_drain();
+    }
+
+    return pv_sampler_scan_collect(raw);
+}
+#endif /* BSP_ADC_USING_DMA */
+
+/**
+ * @brief 连续采样一个数据块 (轮询模式)
+ */
+static rt_err_t adc_read_block(rt_adc_device_t adc_dev, rt_uint8_t channel, rt_int32_t *block, rt_uint8_t count)
+{
+    if (adc_dev == RT_NULL || count == 0) {
+        return -RT_EINVAL;
+    }
+
+    /* 使能ADC通道 */
+    rt_err_t result = rt_adc_enable(adc_dev, channel);
+    if (result != RT_EOK)
+    {
+        rt_kprintf("Error: enable adc channel(%d) failed!\n", channel);
+        return result;
+    }
+
+    for (int i = 0; i < count; i++) {
+        rt_uint32_t value;
+
+        /* 其他模块占用扫描组时转换失败, 丢弃这一块 */
+        result = rt_adc_convert(adc_dev, channel, &value);
+        if (result != RT_EOK) {
+            break;
+        }
+        block[i] = (rt_int32_t)value;
+        rt_thread_mdelay(1); // 每次采样间隔1ms
+    }
+
+    /* 关闭ADC通道 */
+    rt_adc_disable(adc_dev, channel);
+
+    return result;
+}
+
+/**
+ * @brief 轮询方式采集一帧
+ */
+static rt_uint16_t pv_sampler_poll_collect(rt_uint16_t raw[PV_SAMPLER_CH_NUM])
+{
+    rt_int32_t block[PV_SAMPLE_COUNT];
+
+    for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+        rt_uint32_t sum = 0;
+        rt_size_t n;
+
+        if (adc_read_block(sampler_adc, pv_sampler_channels[ch], block, PV_SAMPLE_COUNT) != RT_EOK) {
+            return 0;
+        }
+        rt_mutex_take(&sampler_filter_lock, RT_WAITING_FOREVER);
+        n = pv_sampler_filter_block(ch, block, PV_SAMPLE_COUNT, &sum);
+        rt_mutex_release(&sampler_filter_lock);
+        if (n > 0) {
+            sampler_last_raw[ch] = (rt_uint16_t)(sum / n);
+        }
+        raw[ch] = sampler_last_raw[ch];
+    }
+
+    return PV_SAMPLE_COUNT;
+}
+
+/**
+ * @brief 发布一帧并通知订阅者
+ */
+static void pv_sampler_publish(const rt_uint16_t raw[PV_SAMPLER_CH_NUM], rt_uint16_t samples)
+{
+    rt_uint32_t seq = sampler_seq + 1;
+    pv_sample_frame_t *slot = &sampler_slots[seq & 1];
+    int mv[PV_SAMPLER_CH_NUM];
+
+    for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+        slot->raw[ch] = raw[ch];
+        mv[ch] = (int)((raw[ch] * PV_VOLTAGE_REF) / PV_ADC_MAX_VALUE);
+    }
+
+    slot->seq = seq;
+    slot->tick = rt_tick_get();
+    slot->samples = samples;
+    slot->data.v_a1_mv = mv[PV_SAMPLER_CH_PA0];
+    slot->data.v_a2_mv = mv[PV_SAMPLER_CH_PA1];
+    slot->data.v_b1_mv = mv[PV_SAMPLER_CH_PB0];
+    slot->data.v_b2_mv = mv[PV_SAMPLER_CH_PB1];
+    slot->data.v_c1_mv = mv[PV_SAMPLER_CH_PA6];
+    slot->data.v_c2_mv = mv[PV_SAMPLER_CH_PA7];
+
+    /* 槽内容写完后才发布序号 */
+    __DMB();
+    sampler_seq = seq;
+
+    rt_mutex_take(&sampler_subscriber_lock, RT_WAITING_FOREVER);
+    for (int i = 0; i < PV_SAMPLER_MAX_SUBSCRIBERS; i++) {
+        pv_sampler_callback_t callback = sampler_subscribers[i].callback;
+        if (callback != RT_NULL) {
+            callback(slot, sampler_subscribers[i].user_data);
+        }
+    }
+    rt_mutex_release(&sampler_subscriber_lock);
+}
+
+/**
+ * @brief 打开ADC硬件过采样 (驱动不支持时只用软件滤波)
+ */
+static void pv_sampler_oversampling_init(void)
+{
+    struct rt_adc_oversampling config;
+    rt_err_t result;
+
+    config.ratio = PV_ADC_OVERSAMPLING_RATIO;
+    config.right_shift = PV_ADC_OVERSAMPLING_SHIFT;
+
+    result = rt_adc_set_oversampling(sampler_adc, &config);
+    if (result != RT_EOK && result != -RT_ENOSYS) {
+        rt_kprintf("Warning: ADC oversampling x%d >> %d rejected (%d)\n",
+                   config.ratio, config.right_shift, result);
+    }
+}
+
+/**
+ * @brief 采样线程入口
+ */
+static void pv_sampler_thread_entry(void *parameter)
+{
+    rt_uint16_t raw[PV_SAMPLER_CH_NUM];
+    rt_uint16_t samples;
+
+    while (sampler_running)
+    {
+#ifdef BSP_ADC_USING_DMA
+        if (sampler_scan_mode) {
+            samples = pv_sampler_scan_period(raw);
+        }
+        else
+#endif
+        {
+            samples = pv_sampler_poll_collect(raw);
+        }
+
+        if (samples > 0) {
+            pv_sampler_publish(raw, samples);
+        }
+
+        if (!sampler_scan_mode) {
+            rt_thread_mdelay(PV_SAMPLER_POLL_PERIOD_MS);
+        }
+    }
+
+#ifdef BSP_ADC_USING_DMA
+    if (sampler_scan_mode) {
+        rt_adc_scan_stop(sampler_adc);
+        sampler_scan_mode = RT_FALSE;
+    }
+#endif
+
+    /* sampler_thread 由 pv_sampler_stop 清除 */
+    rt_sem_release(&sampler_exit_sem);
+}
+
+/**
+ * @brief 启动采样服务, 持有 sampler_lock 时调用
+ */
+static rt_err_t pv_sampler_start_locked(void)
+{
+    if (sampler_thread != RT_NULL) {
+        if (sampler_running) {
+            return RT_EOK;
+        }
+        /* 在采样线程中停止的, 等它退出 */
+        rt_sem_take(&sampler_exit_sem, RT_WAITING_FOREVER);
+        sampler_thread = RT_NULL;
+    }
+
+    sampler_adc = (rt_adc_device_t)rt_device_find(PV_SAMPLER_ADC_NAME);
+    if (sampler_adc == RT_NULL) {
+        rt_kprintf("Warning: rt_device_find('%s') failed.\n", PV_SAMPLER_ADC_NAME);
+        return -RT_ERROR;
+    }
+
+    pv_sampler_oversampling_init();
+
+    sampler_scan_mode = RT_FALSE;
+#ifdef BSP_ADC_USING_DMA
+    rt_err_t result = pv_sampler_scan_start();
+    if (result == RT_EOK) {
+        sampler_scan_mode = RT_TRUE;
+    } else if (result == -RT_EBUSY) {
+        /* 别的模块在ADC上扫描, 轮询也读不到 */
+        rt_kprintf("Error: %s is scanning for another user\n", PV_SAMPLER_ADC_NAME);
+        return result;
+    } else {
+        rt_kprintf("PV sampler: DMA scan unavailable, falling back to polling\n");
+    }
+#endif
+
+    sampler_running = RT_TRUE;
+    sampler_thread = rt_thread_create("pv_smp",
+                                      pv_sampler_thread_entry,
+                                      RT_NULL,
+                                      PV_SAMPLER_THREAD_STACK,
+                                      PV_SAMPLER_THREAD_PRIORITY,
+                                      PV_SAMPLER_THREAD_TICK);
+    if (sampler_thread == RT_NULL) {
+        sampler_running = RT_FALSE;
+#ifdef BSP_ADC_USING_DMA
+        if (sampler_scan_mode) {
+            rt_adc_scan_stop(sampler_adc);
+            sampler_scan_mode = RT_FALSE;
+        }
+#endif
+        rt_kprintf("Error: Create PV sampler thread failed!\n");
+        return -RT_ENOMEM;
+    }
+
+    rt_thread_startup(sampler_thread);
+    rt_kprintf("PV sampler started (%s mode)\n", sampler_scan_mode ? "DMA scan" : "polling");
+
+    return RT_EOK;
+}
+
+rt_err_t pv_sampler_start(void)
+{
+    rt_err_t result;
+
+    rt_mutex_take(&sampler_lock, RT_WAITING_FOREVER);
+    result = pv_sampler_start_locked();
+    rt_mutex_release(&sampler_lock);
+
+    return result;
+}
+
+void pv_sampler_stop(void)
+{
+    rt_mutex_take(&sampler_lock, RT_WAITING_FOREVER);
+    if (sampler_thread != RT_NULL) {
+        sampler_running = RT_FALSE;
+        /* 订阅者在采样线程中调用时不能等自己退出, 线程由下一次启动回收 */
+        if (rt_thread_self() != sampler_thread) {
+            rt_sem_take(&sampler_exit_sem, RT_WAITING_FOREVER);
+            sampler_thread = RT_NULL;
+        }
+    }
+    rt_mutex_release(&sampler_lock);
+}
+
+rt_err_t pv_sampler_get_latest(pv_sample_frame_t *frame)
+{
+    rt_uint32_t seq;
+
+    RT_ASSERT(frame != RT_NULL);
+
+    do {
+        seq = sampler_seq;
+        if (seq == 0) {
+            return -RT_EEMPTY;
+        }
+        __DMB();
+        *frame = sampler_slots[seq & 1];
+        __DMB();
+    } while (seq != sampler_seq);
+
+    return RT_EOK;
+}
+
+rt_err_t pv_sampler_get_raw(rt_uint32_t adc_channel, rt_uint32_t *raw)
+{
+    pv_sample_frame_t frame;
+    rt_err_t result;
+
+    RT_ASSERT(raw != RT_NULL);
+
+    for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+        if (pv_sampler_channels[ch] == adc_channel) {
+            result = pv_sampler_get_latest(&frame);
+            if (result == RT_EOK) {
+                *raw = frame.raw[ch];
+            }
+            return result;
+        }
+    }
+
+    return -RT_EINVAL;
+}
+
+rt_err_t pv_sampler_read(pv_sample_frame_t *frame, rt_int32_t timeout_ms)
+{
+    rt_err_t result = pv_sampler_start();
+    if (result != RT_EOK) {
+        return result;
+    }
+
+    while (pv_sampler_get_latest(frame) != RT_EOK) {
+        if (timeout_ms <= 0) {
+            return -RT_ETIMEOUT;
+        }
+        rt_thread_mdelay(10);
+        timeout_ms -= 10;
+    }
+
+    return RT_EOK;
+}
+
+rt_err_t pv_sampler_set_filter(int channel, const pv_filter_config_t *config, int count)
+{
+    pv_filter_chain_t chain;
+    rt_err_t result;
+
+    if (channel < 0 || channel >= PV_SAMPLER_CH_NUM) {
+        return -RT_EINVAL;
+    }
+
+    result = pv_filter_chain_init(&chain, config, count);
+    if (result != RT_EOK) {
+        return result;
+    }
+
+    /* 采样线程可能正在处理这个通道 */
+    rt_mutex_take(&sampler_filter_lock, RT_WAITING_FOREVER);
+    sampler_filters[channel] = chain;
+    rt_mutex_release(&sampler_filter_lock);
+
+    return RT_EOK;
+}
+
+rt_err_t pv_sampler_subscribe(pv_sampler_callback_t callback, void *user_data)
+{
+    rt_err_t result = -RT_EFULL;
+
+    RT_ASSERT(callback != RT_NULL);
+
+    rt_mutex_take(&sampler_subscriber_lock, RT_WAITING_FOREVER);
+    for (int i = 0; i < PV_SAMPLER_MAX_SUBSCRIBERS; i++) {
+        if (sampler_subscribers[i].callback == RT_NULL) {
+            sampler_subscribers[i].user_data = user_data;
+            sampler_subscribers[i].callback = callback;
+            result = RT_EOK;
+            break;
+        }
+    }
+    rt_mutex_release(&sampler_subscriber_lock);
+
+    return result;
+}
+
+void pv_sampler_unsubscribe(pv_sampler_callback_t callback, void *user_data)
+{
+    /* 回调正在运行时等它返回; 在回调中取消订阅时互斥量可重入, 不会死锁 */
+    rt_mutex_take(&sampler_subscriber_lock, RT_WAITING_FOREVER);
+    for (int i = 0; i < PV_SAMPLER_MAX_SUBSCRIBERS; i++) {
+        if (sampler_subscribers[i].callback == callback &&
+            sampler_subscribers[i].user_data == user_data) {
+            sampler_subscribers[i].callback = RT_NULL;
+            sampler_subscribers[i].user_data = RT_NULL;
+        }
+    }
+    rt_mutex_release(&sampler_subscriber_lock);
+}
+
+void pv_sampler_subscribers_lock(void)
+{
+    rt_mutex_take(&sampler_subscriber_lock, RT_WAITING_FOREVER);
+}
+
+void pv_sampler_subscribers_unlock(void)
+{
+    rt_mutex_release(&sampler_subscriber_lock);
+}
+
+/**
+ * @brief 查看采样服务状态
+ */
+int pv_sampler_status(void)
+{
+    pv_sample_frame_t frame;
+    int subscribers = 0;
+
+    for (int i = 0; i < PV_SAMPLER_MAX_SUBSCRIBERS; i++) {
+        if (sampler_subscribers[i].callback != RT_NULL) {
+            subscribers++;
+        }
+    }
+
+    rt_kprintf("\n=== PV Sampler Status ===\n");
+    rt_kprintf("State: %s\n", sampler_thread != RT_NULL && sampler_running ? "Running" : "Stopped");
+    rt_kprintf("Mode: %s\n", sampler_scan_mode ? "DMA scan" : "Polling");
+    rt_kprintf("Period: %d ms\n", sampler_scan_mode ? PV_SAMPLER_PERIOD_MS : PV_SAMPLER_POLL_PERIOD_MS);
+    rt_kprintf("Subscribers: %d/%d\n", subscribers, PV_SAMPLER_MAX_SUBSCRIBERS);
+    rt_kprintf("Oversampling: x%d >> %d\n", PV_ADC_OVERSAMPLING_RATIO, PV_ADC_OVERSAMPLING_SHIFT);
+#ifdef BSP_ADC_USING_DMA
+    rt_kprintf("Dropped half buffers: %d\n", scan_overruns);
+#endif
+
+    if (pv_sampler_get_latest(&frame) == RT_EOK) {
+        rt_kprintf("Latest frame: seq=%d tick=%d samples=%d\n", frame.seq, frame.tick, frame.samples);
+        rt_kprintf("  PA0=%dmV PA1=%dmV PA6=%dmV | PA7=%dmV PB0=%dmV PB1=%dmV\n",
+                   frame.data.v_a1_mv, frame.data.v_a2_mv, frame.data.v_c1_mv,
+                   frame.data.v_c2_mv, frame.data.v_b1_mv, frame.data.v_b2_mv);
+    } else {
+        rt_kprintf("Latest frame: none\n");
+    }
+    rt_kprintf("=========================\n");
+
+    return 0;
+}
+
+/**
+ * @brief 打印一个通道的滤波链
+ */
+static void pv_sampler_print_filter(int ch)
+{
+    const pv_filter_chain_t *chain = &sampler_filters[ch];
+
+    rt_kprintf("  %s:", pv_sampler_channel_names[ch]);
+    if (chain->count == 0) {
+        rt_kprintf(" none");
+    }
+    for (int i = 0; i < chain->count; i++) {
+        rt_kprintf(" %s %d", pv_filter_type_name(chain->stages[i].config.type),
+                   chain->stages[i].config.param);
+    }
+    rt_kprintf("\n");
+}
+
+/**
+ * @brief 查看或修改通道滤波链
+ * 用法: pv_filter                              查看
+ *       pv_filter <pin|0..5|all> none     直通
+ *       pv_filter <pin|0..5|all> <type> <param> [...]
+ *       pin: PA0/PA1/PB0/PB1/PA6/PA7, type: median/avg/iir/decim
+ */
+static int pv_filter(int argc, char **argv)
+{
+    pv_filter_config_t config[PV_FILTER_MAX_STAGES];
+    int first = 0, last = PV_SAMPLER_CH_NUM - 1;
+    int count = 0;
+    int ch;
+
+    if (argc < 2) {
+        rt_kprintf("Filter chains:\n");
+        for (ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+            pv_sampler_print_filter(ch);
+        }
+        return 0;
+    }
+
+    if (rt_strcmp(argv[1], "all") != 0) {
+        for (ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+            if (rt_strcmp(argv[1], pv_sampler_channel_names[ch]) == 0) {
+                break;
+            }
+        }
+        if (ch == PV_SAMPLER_CH_NUM && argv[1][0] >= '0' && argv[1][0] < '0' + PV_SAMPLER_CH_NUM && argv[1][1] == '\0') {
+            ch = argv[1][0] - '0';
+        }
+        if (ch == PV_SAMPLER_CH_NUM) {
+            rt_kprintf("Unknown channel: %s\n", argv[1]);
+            return -1;
+        }
+        first = last = ch;
+    }
+
+    if (!(argc == 3 && rt_strcmp(argv[2], "none") == 0)) {
+        if (argc < 4 || (argc - 2) % 2 != 0 || (argc - 2) / 2 > PV_FILTER_MAX_STAGES) {
+            rt_kprintf("Usage: pv_filter [<pin|0..5|all> none | <type> <param> ...]\n");
+            rt_kprintf("       type: median/avg/iir/decim, at most %d stages\n", PV_FILTER_MAX_STAGES);
+            return -1;
+        }
+        for (int i = 2; i < argc; i += 2) {
+            config[count].type = pv_filter_type_parse(argv[i]);
+            config[count].param = (rt_uint8_t)atoi(argv[i + 1]);
+            count++;
+        }
+    }
+
+    for (ch = first; ch <= last; ch++) {
+        if (pv_sampler_set_filter(ch, config, count) != RT_EOK) {
+            rt_kprintf("Invalid filter chain\n");
+            return -1;
+        }
+        pv_sampler_print_filter(ch);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 初始化滤波链和扫描队列, 在任何线程使用采样服务之前完成
+ */
+static int pv_sampler_init(void)
+{
+    rt_mutex_init(&sampler_lock, "pv_smpl", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&sampler_exit_sem, "pv_smpx", 0, RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&sampler_subscriber_lock, "pv_sub", RT_IPC_FLAG_PRIO);
+    pv_sampler_filters_init();
+#ifdef BSP_ADC_USING_DMA
+    rt_sem_init(&scan_sem, "pv_scan", 0, RT_IPC_FLAG_PRIO);
+#endif
+
+    return 0;
+}
+INIT_APP_EXPORT(pv_sampler_init);
+
+/* 导出到MSH命令 */
+MSH_CMD_EXPORT(pv_sampler_start, Start shared PV ADC sampling service);
+MSH_CMD_EXPORT(pv_sampler_stop, Stop shared PV ADC sampling service);
+MSH_CMD_EXPORT(pv_sampler_status, Show shared PV ADC sampling service status);
+MSH_CMD_EXPORT(pv_filter, Show or set per-channel PV filter chain);
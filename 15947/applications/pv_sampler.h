@@ -0,0 +1,120 @@
+/*
+ * pv_sampler.h
+ *
+ * 光伏ADC共享采样服务
+ * 唯一拥有ADC的模块, 周期性发布带时间戳和序号的采样帧,
+ * 任意数量的使用者可无锁读取最新帧或订阅每一帧。
+ */
+
+#ifndef PV_SAMPLER_H
+#define PV_SAMPLER_H
+
+#include <stdint.h>
+#include <rtthread.h>
+#include "pv_diagnosis.h"
+#include "pv_filter.h"
+
+#define PV_SAMPLER_ADC_NAME          "adc1"
+#define PV_SAMPLER_PERIOD_MS         10      // DMA扫描模式下的发布周期 (ms)
+#define PV_SAMPLER_POLL_PERIOD_MS    1000    // 轮询模式下的发布周期 (ms)
+#define PV_SAMPLER_READ_TIMEOUT_MS   2000    // 等待首帧的默认超时 (ms)
+#define PV_SAMPLER_MAX_SUBSCRIBERS   4       // 最大订阅者数量
+
+// 帧内通道顺序 (与 pv_adc_data_t 字段顺序一致)
+enum {
+    PV_SAMPLER_CH_PA0 = 0,   // ADC1_IN0  -> v_a1_mv (va1)
+    PV_SAMPLER_CH_PA1,       // ADC1_IN1  -> v_a2_mv (va2)
+    PV_SAMPLER_CH_PB0,       // ADC1_INP9 -> v_b1_mv (vb2)
+    PV_SAMPLER_CH_PB1,       // ADC1_INP5 -> v_b2_mv (vb3)
+    PV_SAMPLER_CH_PA6,       // ADC1_INP3 -> v_c1_mv (va3)
+    PV_SAMPLER_CH_PA7,       // ADC1_INP7 -> v_c2_mv (vb1)
+    PV_SAMPLER_CH_NUM
+};
+
+// 采样帧
+typedef struct {
+    rt_uint32_t seq;                        // 帧序号, 从1开始递增
+    rt_tick_t tick;                         // 发布时刻
+    rt_uint16_t samples;                    // 本帧平均的硬件采样次数
+    rt_uint16_t raw[PV_SAMPLER_CH_NUM];     // 滤波并平均后的原始ADC值
+    pv_adc_data_t data;                     // 换算后的电压 (mV)
+} pv_sample_frame_t;
+
+/**
+ * @brief 把换算后的电压展开成按 PV_SAMPLER_CH_* 排列的通道向量
+ */
+rt_inline void pv_sampler_channel_mv(const pv_adc_data_t *data, int32_t mv[PV_SAMPLER_CH_NUM])
+{
+    mv[PV_SAMPLER_CH_PA0] = data->v_a1_mv;
+    mv[PV_SAMPLER_CH_PA1] = data->v_a2_mv;
+    mv[PV_SAMPLER_CH_PB0] = data->v_b1_mv;
+    mv[PV_SAMPLER_CH_PB1] = data->v_b2_mv;
+    mv[PV_SAMPLER_CH_PA6] = data->v_c1_mv;
+    mv[PV_SAMPLER_CH_PA7] = data->v_c2_mv;
+}
+
+// 订阅回调, 在采样线程上下文中调用, 必须尽快返回
+typedef void (*pv_sampler_callback_t)(const pv_sample_frame_t *frame, void *user_data);
+
+/**
+ * @brief 启动采样服务 (已启动时直接返回)
+ * @return RT_EOK 成功, 其他失败
+ */
+rt_err_t pv_sampler_start(void);
+
+/**
+ * @brief 停止采样服务
+ */
+void pv_sampler_stop(void);
+
+/**
+ * @brief 无锁读取最新一帧
+ * @param frame 输出帧
+ * @return RT_EOK 成功, -RT_EEMPTY 尚无数据
+ */
+rt_err_t pv_sampler_get_latest(pv_sample_frame_t *frame);
+
+/**
+ * @brief 无锁读取最新一帧中某个ADC1通道的原始值
+ *        扫描组运行时ADC1的单次转换返回 -RT_EBUSY, 其他读者由此取值
+ * @param adc_channel ADC1通道号
+ * @param raw 输出原始值
+ * @return RT_EOK 成功, -RT_EEMPTY 尚无数据, -RT_EINVAL 该通道不在采样帧中
+ */
+rt_err_t pv_sampler_get_raw(rt_uint32_t adc_channel, rt_uint32_t *raw);
+
+/**
+ * @brief 读取最新一帧, 必要时启动服务并等待首帧
+ * @param frame 输出帧
+ * @param timeout_ms 等待首帧的超时 (ms)
+ * @return RT_EOK 成功, -RT_ETIMEOUT 超时, 其他失败
+ */
+rt_err_t pv_sampler_read(pv_sample_frame_t *frame, rt_int32_t timeout_ms);
+
+/**
+ * @brief 替换一个通道的滤波链 (状态清零), 采样运行中也可调用
+ * @param channel 帧内通道 PV_SAMPLER_CH_*
+ * @param config 各级配置, count 为 0 时直通
+ * @return RT_EOK 成功, -RT_EINVAL 通道或配置非法
+ */
+rt_err_t pv_sampler_set_filter(int channel, const pv_filter_config_t *config, int count);
+
+/**
+ * @brief 订阅每一帧, 回调在采样线程中运行
+ * @return RT_EOK 成功, -RT_EFULL 订阅表已满
+ */
+rt_err_t pv_sampler_subscribe(pv_sampler_callback_t callback, void *user_data);
+
+/**
+ * @brief 取消订阅, 回调正在运行时等它返回
+ */
+void pv_sampler_unsubscribe(pv_sampler_callback_t callback, void *user_data);
+
+/**
+ * @brief 暂停订阅回调: 加锁期间没有回调在运行, 用于修改回调使用的状态
+ * @note 不能在持锁时等待采样线程 (如 pv_sampler_stop)
+ */
+void pv_sampler_subscribers_lock(void);
+void pv_sampler_subscribers_unlock(void);
+
+#endif // PV_SAMPLER_H
@@ -0,0 +1,369 @@
+/* applications/pv_stream.c */
+/* 光伏二进制遥测通道 */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <board.h>
+#include "pv_cloud_config.h"
+#include "pv_stream.h"
+
+/* 发送线程配置 */
+#define PV_STREAM_THREAD_STACK      1536
+#define PV_STREAM_THREAD_PRIORITY   28
+#define PV_STREAM_THREAD_TICK       10
+
+#if (PV_STREAM_RING_SIZE & (PV_STREAM_RING_SIZE - 1)) != 0
+#error "PV_STREAM_RING_SIZE must be a power of two"
+#endif
+
+/* 记录+CRC, COBS开销1字节, 加0x00分隔符 */
+#define STREAM_RAW_SIZE     (sizeof(pv_stream_record_t) + 2)
+#define STREAM_FRAME_MAX    (STREAM_RAW_SIZE + 2)
+
+/*
+ * 有界多生产者/单消费者环形缓冲 (Vyukov): 每个槽带一个序号,
+ * 生产者用 LDREX/STREX 抢占写位置, 写完后把槽序号置为 pos+1 发布;
+ * 消费者看到 pos+1 才读取, 读完把序号推进一圈归还给生产者。
+ * 生产者之间、生产者与消费者之间都不关中断也不加锁。
+ */
+typedef struct {
+    volatile rt_uint32_t seq;
+    pv_stream_record_t record;
+} stream_cell_t;
+
+static stream_cell_t stream_ring[PV_STREAM_RING_SIZE];
+static volatile rt_uint32_t stream_enqueue_pos = 0;
+static rt_uint32_t stream_dequeue_pos = 0;
+static rt_bool_t stream_ring_ready = RT_FALSE;
+
+/* 通道状态 */
+static volatile rt_bool_t stream_running = RT_FALSE;
+static rt_thread_t stream_thread = RT_NULL;
+static rt_device_t stream_dev = RT_NULL;
+static volatile rt_uint32_t stream_dropped = 0;
+static rt_uint32_t stream_sent = 0;
+static rt_uint16_t stream_tx_seq = 0;
+
+/* 发送缓冲, 仅发送线程使用; 开头多一个0x00, 把之前混入的控制台文本与本批隔开 */
+static rt_uint8_t stream_tx_buf[1 + PV_STREAM_TX_BATCH * STREAM_FRAME_MAX];
+
+static rt_bool_t stream_cas(volatile rt_uint32_t *addr, rt_uint32_t expected, rt_uint32_t desired)
+{
+    if (__LDREXW(addr) != expected) {
+        __CLREX();
+        return RT_FALSE;
+    }
+    return __STREXW(desired, addr) == 0;
+}
+
+static void stream_atomic_inc(volatile rt_uint32_t *addr)
+{
+    rt_uint32_t value;
+
+    do {
+        value = *addr;
+    } while (!stream_cas(addr, value, value + 1));
+}
+
+static void stream_ring_init(void)
+{
+    if (stream_ring_ready) {
+        return;
+    }
+    for (rt_uint32_t i = 0; i < PV_STREAM_RING_SIZE; i++) {
+        stream_ring[i].seq = i;
+    }
+    stream_enqueue_pos = 0;
+    stream_dequeue_pos = 0;
+    stream_ring_ready = RT_TRUE;
+}
+
+rt_err_t pv_stream_push(rt_uint8_t type, const void *payload, rt_uint8_t len)
+{
+    stream_cell_t *cell;
+    rt_uint32_t pos;
+
+    if (!stream_running) {
+        return -RT_ERROR;
+    }
+    if (len > PV_STREAM_PAYLOAD_SIZE) {
+        len = PV_STREAM_PAYLOAD_SIZE;
+    }
+
+    for (;;) {
+        rt_int32_t diff;
+
+        pos = stream_enqueue_pos;
+        cell = &stream_ring[pos & (PV_STREAM_RING_SIZE - 1)];
+        diff = (rt_int32_t)(cell->seq - pos);
+
+        if (diff == 0) {
+            if (stream_cas(&stream_enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* 消费者还没归还这个槽: 缓冲已满 */
+            stream_atomic_inc(&stream_dropped);
+            return -RT_EFULL;
+        }
+        /* diff > 0: 其他生产者已占用该位置, 重试 */
+    }
+
+    cell->record.type = type;
+    cell->record.len = len;
+    cell->record.seq = 0;
+    cell->record.tick = rt_tick_get();
+    rt_memcpy(cell->record.payload, payload, len);
+    rt_memset(cell->record.payload + len, 0, PV_STREAM_PAYLOAD_SIZE - len);
+
+    /* 记录内容写完后才发布 */
+    __DMB();
+    cell->seq = pos + 1;
+
+    return RT_EOK;
+}
+
+static rt_bool_t stream_pop(pv_stream_record_t *record)
+{
+    stream_cell_t *cell = &stream_ring[stream_dequeue_pos & (PV_STREAM_RING_SIZE - 1)];
+
+    if ((rt_int32_t)(cell->seq - (stream_dequeue_pos + 1)) < 0) {
+        return RT_FALSE;
+    }
+
+    __DMB();
+    *record = cell->record;
+    __DMB();
+    cell->seq = stream_dequeue_pos + PV_STREAM_RING_SIZE;
+    stream_dequeue_pos++;
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief CRC16-CCITT (多项式0x1021, 初值0xFFFF)
+ */
+static rt_uint16_t stream_crc16(const rt_uint8_t *data, rt_size_t len)
+{
+    rt_uint16_t crc = 0xFFFF;
+
+    while (len--) {
+        crc ^= (rt_uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (rt_uint16_t)((crc << 1) ^ 0x1021) : (rt_uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief COBS编码并追加0x00分隔符, 输入不超过254字节
+ * @return 输出字节数
+ */
+static rt_size_t stream_cobs_encode(const rt_uint8_t *src, rt_size_t len, rt_uint8_t *dst)
+{
+    rt_size_t code_pos = 0;
+    rt_size_t out = 1;
+    rt_uint8_t code = 1;
+
+    for (rt_size_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        } else {
+            dst[out++] = src[i];
+            code++;
+        }
+    }
+    dst[code_pos] = code;
+    dst[out++] = 0;
+
+    return out;
+}
+
+/**
+ * @brief 记录加CRC后成帧
+ */
+static rt_size_t stream_encode(const pv_stream_record_t *record, rt_uint8_t *dst)
+{
+    rt_uint8_t raw[STREAM_RAW_SIZE];
+    rt_uint16_t crc;
+
+    rt_memcpy(raw, record, sizeof(*record));
+    crc = stream_crc16(raw, sizeof(*record));
+    raw[sizeof(*record)] = (rt_uint8_t)(crc & 0xFF);
+    raw[sizeof(*record) + 1] = (rt_uint8_t)(crc >> 8);
+
+    return stream_cobs_encode(raw, sizeof(raw), dst);
+}
+
+static void stream_push_hello(void)
+{
+    pv_stream_hello_t hello;
+
+    hello.magic = PV_STREAM_MAGIC;
+    hello.version = PV_STREAM_VERSION;
+    hello.tick_hz = RT_TICK_PER_SECOND;
+    hello.vref_mv = PV_VOLTAGE_REF;
+    hello.reserved = 0;
+    hello.adc_max = PV_ADC_MAX_VALUE;
+    hello.dropped = stream_dropped;
+
+    pv_stream_push(PV_STREAM_REC_HELLO, &hello, sizeof(hello));
+}
+
+/**
+ * @brief 采样帧订阅回调 (采样线程上下文), 只拷贝不格式化
+ */
+static void stream_frame_callback(const pv_sample_frame_t *frame, void *user_data)
+{
+    pv_stream_frame_t payload;
+
+    payload.frame_seq = frame->seq;
+    payload.samples = frame->samples;
+    payload.reserved = 0;
+    rt_memcpy(payload.raw, frame->raw, sizeof(payload.raw));
+
+    pv_stream_push(PV_STREAM_REC_FRAME, &payload, sizeof(payload));
+}
+
+/**
+ * @brief 发送线程: 取出记录, 成帧后批量写串口
+ */
+static void pv_stream_thread_entry(void *parameter)
+{
+    rt_tick_t hello_interval = rt_tick_from_millisecond(PV_STREAM_HELLO_MS);
+    rt_tick_t last_hello = rt_tick_get() - hello_interval;
+    pv_stream_record_t record;
+
+    while (stream_running) {
+        rt_size_t tx_len = 1;
+        int count = 0;
+
+        if (rt_tick_get() - last_hello >= hello_interval) {
+            stream_push_hello();
+            last_hello = rt_tick_get();
+        }
+
+        while (count < PV_STREAM_TX_BATCH && stream_pop(&record)) {
+            record.seq = stream_tx_seq++;
+            tx_len += stream_encode(&record, stream_tx_buf + tx_len);
+            count++;
+        }
+
+        if (count > 0) {
+            stream_tx_buf[0] = 0;
+            rt_device_write(stream_dev, 0, stream_tx_buf, tx_len);
+            stream_sent += count;
+        }
+
+        /* 缓冲未取空时立即继续 */
+        if (count < PV_STREAM_TX_BATCH) {
+            rt_thread_mdelay(PV_STREAM_FLUSH_MS);
+        }
+    }
+
+    rt_device_close(stream_dev);
+    stream_dev = RT_NULL;
+    stream_thread = RT_NULL;
+}
+
+rt_err_t pv_stream_start(const char *device)
+{
+    rt_device_t dev;
+
+    if (stream_thread != RT_NULL) {
+        return RT_EOK;
+    }
+    if (device == RT_NULL) {
+        device = PV_STREAM_DEVICE;
+    }
+
+    dev = rt_device_find(device);
+    if (dev == RT_NULL) {
+        rt_kprintf("Error: stream device %s not found\n", device);
+        return -RT_ERROR;
+    }
+    if (rt_device_open(dev, RT_DEVICE_OFLAG_RDWR) != RT_EOK) {
+        rt_kprintf("Error: open stream device %s failed\n", device);
+        return -RT_EIO;
+    }
+
+    stream_ring_init();
+    stream_dev = dev;
+    stream_running = RT_TRUE;
+
+    stream_thread = rt_thread_create("pv_strm",
+                                     pv_stream_thread_entry,
+                                     RT_NULL,
+                                     PV_STREAM_THREAD_STACK,
+                                     PV_STREAM_THREAD_PRIORITY,
+                                     PV_STREAM_THREAD_TICK);
+    if (stream_thread == RT_NULL) {
+        stream_running = RT_FALSE;
+        rt_device_close(dev);
+        stream_dev = RT_NULL;
+        rt_kprintf("Error: Create PV stream thread failed!\n");
+        return -RT_ENOMEM;
+    }
+
+    if (pv_sampler_subscribe(stream_frame_callback, RT_NULL) != RT_EOK) {
+        rt_kprintf("Warning: PV stream could not subscribe to sampler, frames not streamed\n");
+    }
+    pv_sampler_start();
+
+    rt_thread_startup(stream_thread);
+    rt_kprintf("PV stream started on %s\n", device);
+
+    return RT_EOK;
+}
+
+void pv_stream_stop(void)
+{
+    /* 取消订阅会等正在运行的帧回调返回, 之后不会再有帧写入缓冲 */
+    pv_sampler_unsubscribe(stream_frame_callback, RT_NULL);
+    stream_running = RT_FALSE;
+
+    /* 等发送线程写完本批并关闭串口, 返回后可以立即重新启动 */
+    while (stream_thread != RT_NULL && rt_thread_self() != stream_thread) {
+        rt_thread_mdelay(PV_STREAM_FLUSH_MS);
+    }
+}
+
+rt_bool_t pv_stream_running(void)
+{
+    return stream_running;
+}
+
+static int pv_stream_start_cmd(int argc, char **argv)
+{
+    return (pv_stream_start(argc > 1 ? argv[1] : RT_NULL) == RT_EOK) ? 0 : -1;
+}
+MSH_CMD_EXPORT_ALIAS(pv_stream_start_cmd, pv_stream_start, start binary PV telemetry: pv_stream_start [device]);
+
+static int pv_stream_stop_cmd(void)
+{
+    pv_stream_stop();
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(pv_stream_stop_cmd, pv_stream_stop, stop binary PV telemetry);
+
+static int pv_stream_status(void)
+{
+    rt_uint32_t pending = stream_enqueue_pos - stream_dequeue_pos;
+
+    rt_kprintf("\n=== PV Stream Status ===\n");
+    rt_kprintf("State: %s\n", stream_running ? "Running" : "Stopped");
+    if (stream_dev != RT_NULL) {
+        rt_kprintf("Device: %s\n", stream_dev->parent.name);
+    }
+    rt_kprintf("Records sent: %d\n", stream_sent);
+    rt_kprintf("Records dropped: %d\n", stream_dropped);
+    rt_kprintf("Ring usage: %d/%d\n", pending, PV_STREAM_RING_SIZE);
+    rt_kprintf("========================\n");
+
+    return 0;
+}
+MSH_CMD_EXPORT(pv_stream_status, show binary PV telemetry status);
@@ -0,0 +1,101 @@
+/*
+ * pv_stream.h
+ *
+ * 光伏二进制遥测通道
+ * 采样帧和诊断结果以定长二进制记录写入无锁环形缓冲, 由低优先级线程
+ * 加CRC并做COBS成帧后批量写到串口, 主机端用 pv_stream_decode.py 解码。
+ * 采样路径上不再有任何格式化输出。
+ *
+ * 线上格式: COBS(记录 32字节 + CRC16-CCITT 2字节, 小端) + 0x00
+ * 诊断结果按每 PV_STREAM_DIAG_GROUP 块板一条 DIAG 记录发送, 板数不受记录长度限制。
+ */
+
+#ifndef PV_STREAM_H
+#define PV_STREAM_H
+
+#include <rtthread.h>
+#include "pv_sampler.h"
+#include "pv_topology.h"
+
+#define PV_STREAM_MAGIC         0x53545650  // "PVST"
+#define PV_STREAM_VERSION       2           // 2: DIAG 按板分组
+#define PV_STREAM_PAYLOAD_SIZE  24
+
+// 记录类型
+#define PV_STREAM_REC_HELLO     0           // 通道描述, 启动时及周期性发送
+#define PV_STREAM_REC_FRAME     1           // 采样帧
+#define PV_STREAM_REC_DIAG      2           // 诊断结果
+
+// 记录 (32字节)
+typedef struct {
+    rt_uint8_t type;                        // PV_STREAM_REC_*
+    rt_uint8_t len;                         // payload 有效字节数
+    rt_uint16_t seq;                        // 发送序号, 主机据此发现串口丢帧
+    rt_uint32_t tick;                       // 产生时刻 (OS tick)
+    rt_uint8_t payload[PV_STREAM_PAYLOAD_SIZE];
+} pv_stream_record_t;
+
+// HELLO 负载
+typedef struct {
+    rt_uint32_t magic;
+    rt_uint16_t version;
+    rt_uint16_t tick_hz;                    // RT_TICK_PER_SECOND
+    rt_uint16_t vref_mv;                    // mV = raw * vref_mv / adc_max
+    rt_uint16_t reserved;
+    rt_uint32_t adc_max;
+    rt_uint32_t dropped;                    // 环形缓冲满而丢弃的记录总数
+} pv_stream_hello_t;
+
+// FRAME 负载
+typedef struct {
+    rt_uint32_t frame_seq;                  // 采样帧序号
+    rt_uint16_t samples;                    // 本帧平均的硬件采样次数
+    rt_uint16_t reserved;
+    rt_uint16_t raw[PV_SAMPLER_CH_NUM];     // 原始ADC值 (PV_SAMPLER_CH_* 顺序)
+} pv_stream_frame_t;
+
+// DIAG 负载, 一次检测连续发送 ceil(panels / PV_STREAM_DIAG_GROUP) 条
+#define PV_STREAM_DIAG_GROUP    8
+
+typedef struct {
+    rt_uint8_t first_panel;                 // 本组第一块板, 0 = PV1
+    rt_uint8_t panel_count;                 // 本组板数, 1..PV_STREAM_DIAG_GROUP
+    rt_uint8_t panels;                      // 阵列总板数
+    rt_uint8_t flags;                       // PV_STREAM_DIAG_*
+    rt_uint8_t fault_code;                  // 高级故障检测结果码, 0为正常
+    rt_uint8_t fault_count;                 // 高级故障检测的故障板数 (全阵列)
+    rt_uint8_t fault_mask;                  // 本组故障板: bit i = PV(first_panel+i+1)
+    rt_uint8_t reserved;
+    rt_int16_t pv_mv[PV_STREAM_DIAG_GROUP]; // 本组单板电压 (mV)
+} pv_stream_diag_t;
+
+/* 记录定长, 分组必须放得进负载, 总板数必须放得进 panels 字段 */
+typedef char pv_stream_diag_size_check[(sizeof(pv_stream_diag_t) <= PV_STREAM_PAYLOAD_SIZE) ? 1 : -1];
+typedef char pv_stream_diag_panels_check[(PV_TOPO_MAX_PANELS <= 255) ? 1 : -1];
+
+#define PV_STREAM_DIAG_BASELINE_READY   0x01
+
+/**
+ * @brief 打开串口并启动发送线程, 订阅采样帧
+ * @param device 串口设备名, RT_NULL 使用 PV_STREAM_DEVICE
+ * @return RT_EOK 成功
+ */
+rt_err_t pv_stream_start(const char *device);
+
+/**
+ * @brief 停止发送线程并关闭串口
+ */
+void pv_stream_stop(void);
+
+/**
+ * @brief 写入一条记录, 可在任意线程中调用, 不阻塞, 不加锁
+ * @return RT_EOK 成功, -RT_EFULL 缓冲已满 (记录被丢弃), -RT_ERROR 通道未启动
+ */
+rt_err_t pv_stream_push(rt_uint8_t type, const void *payload, rt_uint8_t len);
+
+/**
+ * @brief 通道是否在运行
+ */
+rt_bool_t pv_stream_running(void);
+
+#endif // PV_STREAM_H
@@ -0,0 +1,910 @@
+/* applications/pv_telemetry.c */
+/* 光伏遥测存储转发上传 */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stddef.h>
+#include <time.h>
+#include "pv_cloud_config.h"
+#include "pv_telemetry.h"
+#include "pv_json.h"
+#include "pv_onenet_client.h"
+
+#ifdef RT_USING_FAL
+#include <fal.h>
+extern int fal_init_check(void);
+#endif
+
+/* 上传线程配置 (负载缓冲为静态, 栈不需要很大) */
+#define TELEMETRY_THREAD_STACK      2048
+#define TELEMETRY_THREAD_PRIORITY   16
+#define TELEMETRY_THREAD_TICK       20
+
+/* 与 fix_system_time() 相同的有效时间范围 */
+#define TELEMETRY_TIME_VALID(t)     ((t) >= 1600000000UL && (t) <= 2000000000UL)
+
+/* 批次来源 */
+typedef enum {
+    BATCH_NONE = 0,
+    BATCH_RAM,
+    BATCH_FLASH,
+} batch_source_t;
+
+/* RAM环形缓冲, head/tail 为累计计数, 差值即为记录数 */
+static pv_telemetry_record_t ram_ring[PV_TELEMETRY_RAM_RECORDS];
+static rt_uint32_t ram_head = 0;
+static rt_uint32_t ram_tail = 0;
+
+static struct rt_mutex telemetry_lock;
+static struct rt_semaphore telemetry_sem;
+static rt_thread_t telemetry_thread = RT_NULL;
+static rt_bool_t telemetry_initialized = RT_FALSE;
+static volatile rt_bool_t telemetry_link_up = RT_TRUE;
+
+/* 统计 */
+static rt_uint32_t stat_published = 0;
+static rt_uint32_t stat_messages = 0;
+static rt_uint32_t stat_failed = 0;
+static rt_uint32_t stat_spilled = 0;
+static rt_uint32_t stat_dropped = 0;
+
+/* 仅上传线程使用 */
+static pv_telemetry_record_t batch_buf[PV_TELEMETRY_BATCH_MAX];
+static char payload_buf[PV_TELEMETRY_PAYLOAD_SIZE];
+static int telemetry_message_id = 1;
+static volatile int telemetry_format = PV_TELEMETRY_FORMAT;
+
+static const char *const telemetry_stream_names[PV_TELEMETRY_CHANNELS] =
+{
+    PV_DATASTREAM_VA1, PV_DATASTREAM_VA2, PV_DATASTREAM_VA3,
+    PV_DATASTREAM_VB1, PV_DATASTREAM_VB2, PV_DATASTREAM_VB3,
+};
+
+/* 经OneNET发布队列发送, MQTT客户端只由发布线程调用; 负载缓冲在返回前不会被改写 */
+static int telemetry_default_publish(const char *topic, const rt_uint8_t *payload, rt_size_t len)
+{
+    return (pv_onenet_publish(PV_ONENET_PUB_RAW, topic, payload, len,
+                              rt_tick_from_millisecond(PV_TELEMETRY_RETRY_MS)) == RT_EOK) ? 0 : -1;
+}
+
+static pv_telemetry_publish_t telemetry_publisher = telemetry_default_publish;
+
+/* ========== 闪存积压日志 ========== */
+
+#ifdef RT_USING_FAL
+/*
+ * 分区按扇区组成循环日志。每个扇区以头部 {magic, seq} 开始, 后接定长记录。
+ * 读写位置都是单调递增的绝对槽号, 扇区 seq 存放在物理扇区 seq % N。
+ * 每批确认发布后只清除该批最后一条记录的 PENDING 位, 上电时据此恢复读位置。
+ */
+#define FLASH_SECTOR_SIZE           4096
+#define FLASH_HEADER_SIZE           16
+#define FLASH_SLOTS                 ((FLASH_SECTOR_SIZE - FLASH_HEADER_SIZE) / sizeof(pv_telemetry_record_t))
+#define FLASH_MAGIC                 0x50564C47  // "PVLG"
+#define FLASH_EMPTY                 0xFFFFFFFFUL
+
+typedef struct {
+    rt_uint32_t magic;
+    rt_uint32_t seq;
+    rt_uint32_t reserved[2];
+} flash_sector_header_t;
+
+static const struct fal_partition *flash_part = RT_NULL;
+static rt_uint32_t flash_sectors = 0;
+static rt_uint32_t flash_read = 0;
+static rt_uint32_t flash_write = 0;
+static pv_telemetry_record_t spill_buf[PV_TELEMETRY_SPILL_BATCH];
+
+static rt_uint32_t flash_sector_addr(rt_uint32_t seq)
+{
+    return (seq % flash_sectors) * FLASH_SECTOR_SIZE;
+}
+
+static rt_uint32_t flash_slot_addr(rt_uint32_t idx)
+{
+    return flash_sector_addr(idx / FLASH_SLOTS) + FLASH_HEADER_SIZE +
+           (idx % FLASH_SLOTS) * sizeof(pv_telemetry_record_t);
+}
+
+/**
+ * @brief 当前仍保留在闪存中的最旧槽号
+ */
+static rt_uint32_t flash_oldest(void)
+{
+    rt_uint32_t seq = flash_write / FLASH_SLOTS;
+
+    return (seq >= flash_sectors - 1) ? (seq - (flash_sectors - 1)) * FLASH_SLOTS : 0;
+}
+
+static rt_uint32_t flash_count(void)
+{
+    return (flash_part != RT_NULL) ? flash_write - flash_read : 0;
+}
+
+/**
+ * @brief 追加记录, 跨扇区时先擦除下一个扇区 (覆盖最旧的数据)
+ */
+static rt_err_t flash_append(const pv_telemetry_record_t *records, rt_uint32_t count)
+{
+    while (count > 0) {
+        rt_uint32_t slot = flash_write % FLASH_SLOTS;
+
+        if (slot == 0) {
+            flash_sector_header_t header = {FLASH_MAGIC, flash_write / FLASH_SLOTS, {0, 0}};
+            rt_uint32_t addr = flash_sector_addr(header.seq);
+
+            if (fal_partition_erase(flash_part, addr, FLASH_SECTOR_SIZE) < 0 ||
+                fal_partition_write(flash_part, addr, (const uint8_t *)&header, sizeof(header)) < 0) {
+                return -RT_EIO;
+            }
+        }
+
+        rt_uint32_t chunk = FLASH_SLOTS - slot;
+        if (chunk > count) {
+            chunk = count;
+        }
+
+        if (fal_partition_write(flash_part, flash_slot_addr(flash_write), (const uint8_t *)records,
+                                chunk * sizeof(pv_telemetry_record_t)) < 0) {
+            return -RT_EIO;
+        }
+
+        flash_write += chunk;
+        records += chunk;
+        count -= chunk;
+
+        /* 被覆盖的最旧记录计为丢弃 */
+        rt_uint32_t oldest = flash_oldest();
+        if ((rt_int32_t)(flash_read - oldest) < 0) {
+            stat_dropped += oldest - flash_read;
+            flash_read = oldest;
+        }
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 从读位置读出最多 max 条记录
+ */
+static rt_uint32_t flash_peek(pv_telemetry_record_t *records, rt_uint32_t max)
+{
+    rt_uint32_t idx = flash_read;
+    rt_uint32_t count = flash_count();
+
+    if (count > max) {
+        count = max;
+    }
+
+    for (rt_uint32_t done = 0; done < count; ) {
+        rt_uint32_t chunk = FLASH_SLOTS - (idx % FLASH_SLOTS);
+        if (chunk > count - done) {
+            chunk = count - done;
+        }
+
+        if (fal_partition_read(flash_part, flash_slot_addr(idx), (uint8_t *)&records[done],
+                               chunk * sizeof(pv_telemetry_record_t)) < 0) {
+            return done;
+        }
+
+        idx += chunk;
+        done += chunk;
+    }
+
+    return count;
+}
+
+/**
+ * @brief 确认 [start, start+count) 已发布
+ */
+static void flash_commit(rt_uint32_t start, rt_uint32_t count)
+{
+    rt_uint32_t last = start + count - 1;
+
+    /* 只清除该批最后一条的 PENDING 位 (NOR 允许 1->0 改写) */
+    if ((rt_int32_t)(last - flash_oldest()) >= 0) {
+        pv_telemetry_record_t record;
+        rt_uint32_t addr = flash_slot_addr(last);
+
+        if (fal_partition_read(flash_part, addr, (uint8_t *)&record, sizeof(record)) >= 0) {
+            rt_uint8_t flags = record.flags & ~PV_TELEMETRY_FLAG_PENDING;
+            fal_partition_write(flash_part, addr + offsetof(pv_telemetry_record_t, flags), &flags, 1);
+        }
+    }
+
+    if ((rt_int32_t)(flash_read - (start + count)) < 0) {
+        flash_read = start + count;
+    }
+}
+
+/**
+ * @brief 把RAM中最旧的记录按批写入闪存 (调用者持有锁)
+ */
+static rt_err_t ram_spill(void)
+{
+    rt_uint32_t count = ram_head - ram_tail;
+
+    if (flash_part == RT_NULL || count == 0) {
+        return -RT_ERROR;
+    }
+
+    if (count > PV_TELEMETRY_SPILL_BATCH) {
+        count = PV_TELEMETRY_SPILL_BATCH;
+    }
+
+    for (rt_uint32_t i = 0; i < count; i++) {
+        spill_buf[i] = ram_ring[(ram_tail + i) % PV_TELEMETRY_RAM_RECORDS];
+    }
+
+    if (flash_append(spill_buf, count) != RT_EOK) {
+        rt_kprintf("Telemetry: flash write failed, backlog kept in RAM only\n");
+        return -RT_EIO;
+    }
+
+    ram_tail += count;
+    stat_spilled += count;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief 上电恢复: 找到最新扇区确定写位置, 再向前找最后一个已确认记录确定读位置
+ */
+static void flash_recover(void)
+{
+    flash_sector_header_t header;
+    rt_uint32_t head_seq = 0;
+    rt_uint32_t head_fill;
+    rt_bool_t found = RT_FALSE;
+    pv_telemetry_record_t *sector;
+
+    /* 板上由 SPI FLASH 驱动在 INIT_ENV 阶段初始化FAL, 没有时在这里补上 */
+    if (!fal_init_check()) {
+        fal_init();
+    }
+
+    flash_part = fal_partition_find(PV_TELEMETRY_PARTITION);
+    if (flash_part == RT_NULL) {
+        rt_kprintf("Telemetry: partition '%s' not found, RAM buffer only\n", PV_TELEMETRY_PARTITION);
+        return;
+    }
+
+    flash_sectors = flash_part->len / FLASH_SECTOR_SIZE;
+    sector = rt_malloc(FLASH_SLOTS * sizeof(pv_telemetry_record_t));
+    if (flash_sectors < 2 || sector == RT_NULL) {
+        rt_free(sector);
+        flash_part = RT_NULL;
+        return;
+    }
+
+    for (rt_uint32_t i = 0; i < flash_sectors; i++) {
+        if (fal_partition_read(flash_part, i * FLASH_SECTOR_SIZE, (uint8_t *)&header, sizeof(header)) >= 0 &&
+            header.magic == FLASH_MAGIC && header.seq % flash_sectors == i &&
+            (!found || header.seq > head_seq)) {
+            head_seq = header.seq;
+            found = RT_TRUE;
+        }
+    }
+
+    flash_read = flash_write = 0;
+    if (!found) {
+        rt_free(sector);
+        return;
+    }
+
+    /* 写位置: 最新扇区中的第一个空槽 */
+    fal_partition_read(flash_part, flash_sector_addr(head_seq) + FLASH_HEADER_SIZE,
+                       (uint8_t *)sector, FLASH_SLOTS * sizeof(pv_telemetry_record_t));
+    rt_uint32_t slot = 0;
+    while (slot < FLASH_SLOTS && sector[slot].timestamp != FLASH_EMPTY) {
+        slot++;
+    }
+    head_fill = slot;
+    flash_write = head_seq * FLASH_SLOTS + slot;
+    flash_read = flash_oldest();
+
+    /* 读位置: 从新到旧找最后一个已确认的记录 */
+    for (rt_uint32_t seq = head_seq + 1; seq-- > flash_oldest() / FLASH_SLOTS; ) {
+        rt_uint32_t addr = flash_sector_addr(seq);
+
+        if (fal_partition_read(flash_part, addr, (uint8_t *)&header, sizeof(header)) < 0 ||
+            header.magic != FLASH_MAGIC || header.seq != seq) {
+            flash_read = (seq + 1) * FLASH_SLOTS;
+            break;
+        }
+
+        if (seq != head_seq) {
+            fal_partition_read(flash_part, addr + FLASH_HEADER_SIZE,
+                               (uint8_t *)sector, FLASH_SLOTS * sizeof(pv_telemetry_record_t));
+            slot = FLASH_SLOTS;
+        } else {
+            /* 最新扇区写满时 flash_write 已落在下一扇区, 按实际写入的槽数查找 */
+            slot = head_fill;
+        }
+
+        while (slot-- > 0) {
+            if (sector[slot].timestamp != FLASH_EMPTY && !(sector[slot].flags & PV_TELEMETRY_FLAG_PENDING)) {
+                break;
+            }
+        }
+
+        if (slot != (rt_uint32_t)-1) {
+            flash_read = seq * FLASH_SLOTS + slot + 1;
+            break;
+        }
+    }
+
+    if ((rt_int32_t)(flash_read - flash_write) > 0) {
+        flash_read = flash_write;
+    }
+
+    rt_free(sector);
+    rt_kprintf("Telemetry: recovered %d pending records from flash\n", flash_write - flash_read);
+}
+#else
+static rt_uint32_t flash_count(void)
+{
+    return 0;
+}
+
+static rt_err_t ram_spill(void)
+{
+    return -RT_ERROR;
+}
+#endif /* RT_USING_FAL */
+
+/* ========== 负载生成 ========== */
+
+/**
+ * @brief 追加一个数据点 {"v":..., "t":...} 的时间部分
+ */
+static void payload_put_time(pv_json_writer_t *w, const pv_telemetry_record_t *record)
+{
+    if (TELEMETRY_TIME_VALID(record->timestamp)) {
+        pv_json_put_raw(w, ",\"t\":");
+        pv_json_put_uint(w, record->timestamp);
+        pv_json_put_raw(w, "000}");
+    } else {
+        pv_json_put_raw(w, "}");
+    }
+}
+
+static int popcount8(rt_uint8_t v)
+{
+    int count = 0;
+    for (; v; v &= v - 1) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief 追加 "FAULT_PVn" 字符串值
+ */
+static void payload_put_fault_pv(pv_json_writer_t *w, int pv)
+{
+    pv_json_put_raw(w, "\"FAULT_PV");
+    pv_json_put_uint(w, pv);
+    pv_json_put_raw(w, "\"");
+}
+
+/**
+ * @brief 追加故障字符串数据流 (只描述批次中最新的状态)
+ */
+static void payload_put_fault_strings(pv_json_writer_t *w, const pv_telemetry_record_t *latest)
+{
+    rt_bool_t baseline = (latest->flags & PV_TELEMETRY_FLAG_BASELINE) != 0;
+    rt_uint8_t mask = baseline ? latest->fault_mask : 0;
+    int slot_pv[4];
+    int slots = 0;
+
+    for (int i = 0; i < 6 && slots < 4; i++) {
+        if (mask & (1u << i)) {
+            slot_pv[slots++] = i + 1;
+        }
+    }
+
+    pv_json_put_raw(w, ",\"fault_code_str\":[{\"v\":");
+    if (!baseline) {
+        pv_json_put_string(w, "BASELINE_BUILDING");
+    } else if (latest->fault_code == 0) {
+        pv_json_put_string(w, "PANEL_OK");
+    } else if (latest->fault_code <= 6) {
+        payload_put_fault_pv(w, latest->fault_code);
+    } else {
+        pv_json_put_string(w, "FAULT_UNKNOWN");
+    }
+    payload_put_time(w, latest);
+
+    pv_json_put_raw(w, "],\"fault_list\":[{\"v\":\"");
+    if (mask == 0) {
+        pv_json_put_raw(w, "NONE");
+    } else {
+        rt_bool_t first = RT_TRUE;
+        for (int i = 0; i < 6; i++) {
+            if (mask & (1u << i)) {
+                pv_json_put_raw(w, first ? "PV" : ",PV");
+                pv_json_put_uint(w, i + 1);
+                first = RT_FALSE;
+            }
+        }
+    }
+    pv_json_put_raw(w, "\"");
+    payload_put_time(w, latest);
+    pv_json_put_raw(w, "]");
+
+    for (int i = 0; i < 4; i++) {
+        pv_json_put_raw(w, ",\"fault_code_str");
+        pv_json_put_uint(w, i + 1);
+        pv_json_put_raw(w, "\":[{\"v\":");
+        if (!baseline) {
+            pv_json_put_string(w, "BASELINE_BUILDING");
+        } else if (i < slots) {
+            payload_put_fault_pv(w, slot_pv[i]);
+        } else {
+            pv_json_put_string(w, "NOTFAULT_PVOK");
+        }
+        payload_put_time(w, latest);
+        pv_json_put_raw(w, "]");
+    }
+}
+
+/**
+ * @brief 输出OneNET DP数组格式负载: 每个数据流一个数组, 每条记录一个带时间戳的数据点
+ */
+static void telemetry_put_payload(pv_json_writer_t *w, const pv_telemetry_record_t *records, rt_uint32_t count)
+{
+    const char *sep = "";
+
+    pv_json_put_raw(w, "{\"id\":");
+    pv_json_put_int(w, telemetry_message_id);
+    pv_json_put_raw(w, ",\"dp\":{");
+
+    for (int ch = 0; ch < PV_TELEMETRY_CHANNELS; ch++) {
+        rt_bool_t opened = RT_FALSE;
+
+        for (rt_uint32_t i = 0; i < count; i++) {
+            const pv_telemetry_record_t *r = &records[i];
+
+            if (ch == PV_TELEMETRY_VB3 && !(r->flags & PV_TELEMETRY_FLAG_HAS_VB3)) {
+                continue;
+            }
+
+            if (opened) {
+                pv_json_put_raw(w, ",{\"v\":");
+            } else {
+                pv_json_put_raw(w, sep);
+                pv_json_put_raw(w, "\"");
+                pv_json_put_raw(w, telemetry_stream_names[ch]);
+                pv_json_put_raw(w, "\":[{\"v\":");
+                opened = RT_TRUE;
+                sep = ",";
+            }
+            pv_json_put_fixed(w, r->mv[ch], 3);
+            payload_put_time(w, r);
+        }
+
+        if (opened) {
+            pv_json_put_raw(w, "]");
+        }
+    }
+
+    pv_json_put_raw(w, sep);
+    pv_json_put_raw(w, "\"fault_code_id\":[");
+    for (rt_uint32_t i = 0; i < count; i++) {
+        pv_json_put_raw(w, i ? ",{\"v\":" : "{\"v\":");
+        pv_json_put_uint(w, records[i].fault_code);
+        payload_put_time(w, &records[i]);
+    }
+    pv_json_put_raw(w, "],\"fault_count\":[");
+    for (rt_uint32_t i = 0; i < count; i++) {
+        pv_json_put_raw(w, i ? ",{\"v\":" : "{\"v\":");
+        pv_json_put_uint(w, popcount8(records[i].fault_mask));
+        payload_put_time(w, &records[i]);
+    }
+    pv_json_put_raw(w, "]");
+
+    payload_put_fault_strings(w, &records[count - 1]);
+    pv_json_put_raw(w, "}}");
+}
+
+/**
+ * @brief 精确计算负载长度 (不含 '\0')
+ */
+static rt_size_t telemetry_payload_size(const pv_telemetry_record_t *records, rt_uint32_t count)
+{
+    pv_json_writer_t w;
+
+    pv_json_writer_init_count(&w);
+    telemetry_put_payload(&w, records, count);
+
+    return w.len;
+}
+
+/**
+ * @brief 生成负载: 先精确计算长度, 放不下时按比例减少记录数, 保证缓冲区一次写成
+ * @param count 输入为候选记录数, 输出为实际打包的记录数
+ * @return 负载长度, 单条记录也放不下时返回-1
+ */
+static int telemetry_build_payload(const pv_telemetry_record_t *records, rt_uint32_t *count)
+{
+    pv_json_writer_t w;
+    rt_size_t need;
+
+    while ((need = telemetry_payload_size(records, *count)) >= sizeof(payload_buf)) {
+        rt_uint32_t fit;
+
+        if (*count <= 1) {
+            return -1;
+        }
+        fit = (rt_uint32_t)(((rt_uint64_t)*count * (sizeof(payload_buf) - 1)) / need);
+        *count = (fit < *count) ? (fit ? fit : 1) : *count - 1;
+    }
+
+    pv_json_writer_init(&w, payload_buf, sizeof(payload_buf));
+    telemetry_put_payload(&w, records, *count);
+
+    return (pv_json_writer_finish(&w) == RT_EOK) ? (int)w.len : -1;
+}
+
+/* ========== 增量二进制负载 ========== */
+
+/* 第一条记录的长度, 之后每条记录的最大长度 (varint 每字节7位) */
+#define DELTA_HEADER_SIZE           2
+#define DELTA_FIRST_SIZE            (4 + 2 * PV_TELEMETRY_CHANNELS + 3)
+#define DELTA_RECORD_MAX            (5 + 3 * PV_TELEMETRY_CHANNELS + 4)
+
+#if PV_TELEMETRY_BATCH_MAX > 255
+#error "PV_TELEMETRY_BATCH_MAX must fit the record count byte of the delta payload"
+#endif
+
+static rt_uint8_t *delta_put_varint(rt_uint8_t *p, rt_uint32_t value)
+{
+    while (value >= 0x80) {
+        *p++ = (rt_uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (rt_uint8_t)value;
+
+    return p;
+}
+
+static rt_uint8_t *delta_put_signed(rt_uint8_t *p, rt_int32_t value)
+{
+    return delta_put_varint(p, ((rt_uint32_t)value << 1) ^ (rt_uint32_t)(value >> 31));
+}
+
+static rt_uint8_t *delta_put_le(rt_uint8_t *p, rt_uint32_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (rt_uint8_t)(value >> (8 * i));
+    }
+
+    return p;
+}
+
+/**
+ * @brief 生成增量二进制负载, 放不下的记录留给下一批
+ * @param count 输入为候选记录数, 输出为实际打包的记录数
+ * @return 负载长度
+ */
+static int telemetry_build_delta(const pv_telemetry_record_t *records, rt_uint32_t *count)
+{
+    rt_uint8_t *p = (rt_uint8_t *)payload_buf;
+    const rt_uint8_t *end = p + sizeof(payload_buf);
+    const pv_telemetry_record_t *prev = &records[0];
+    rt_uint32_t n;
+
+    p[0] = PV_TELEMETRY_DELTA_VERSION;
+    p += DELTA_HEADER_SIZE;
+
+    p = delta_put_le(p, prev->timestamp, 4);
+    for (int ch = 0; ch < PV_TELEMETRY_CHANNELS; ch++) {
+        p = delta_put_le(p, prev->mv[ch], 2);
+    }
+    *p++ = prev->fault_code;
+    *p++ = prev->fault_mask;
+    *p++ = prev->flags & ~PV_TELEMETRY_FLAG_PENDING;
+
+    for (n = 1; n < *count && end - p >= DELTA_RECORD_MAX; n++) {
+        const pv_telemetry_record_t *r = &records[n];
+        rt_uint8_t flags = r->flags & ~PV_TELEMETRY_FLAG_PENDING;
+
+        p = delta_put_signed(p, (rt_int32_t)(r->timestamp - prev->timestamp));
+        for (int ch = 0; ch < PV_TELEMETRY_CHANNELS; ch++) {
+            p = delta_put_signed(p, (rt_int32_t)r->mv[ch] - (rt_int32_t)prev->mv[ch]);
+        }
+        if (r->fault_code == prev->fault_code && r->fault_mask == prev->fault_mask &&
+            flags == (prev->flags & ~PV_TELEMETRY_FLAG_PENDING)) {
+            *p++ = 0;
+        } else {
+            *p++ = 1;
+            *p++ = r->fault_code;
+            *p++ = r->fault_mask;
+            *p++ = flags;
+        }
+        prev = r;
+    }
+
+    payload_buf[1] = (char)n;
+    *count = n;
+
+    return (int)(p - (rt_uint8_t *)payload_buf);
+}
+
+/* ========== 上传线程 ========== */
+
+/**
+ * @brief 取出待发布的一批记录: 闪存中的积压总是比RAM中的更旧, 先发闪存
+ */
+static batch_source_t telemetry_peek(rt_uint32_t *start, rt_uint32_t *count)
+{
+    batch_source_t source = BATCH_NONE;
+
+    rt_mutex_take(&telemetry_lock, RT_WAITING_FOREVER);
+
+#ifdef RT_USING_FAL
+    if (flash_count() > 0) {
+        *start = flash_read;
+        *count = flash_peek(batch_buf, PV_TELEMETRY_BATCH_MAX);
+        source = (*count > 0) ? BATCH_FLASH : BATCH_NONE;
+    } else
+#endif
+    if (ram_head != ram_tail) {
+        rt_uint32_t n = ram_head - ram_tail;
+        if (n > PV_TELEMETRY_BATCH_MAX) {
+            n = PV_TELEMETRY_BATCH_MAX;
+        }
+        for (rt_uint32_t i = 0; i < n; i++) {
+            batch_buf[i] = ram_ring[(ram_tail + i) % PV_TELEMETRY_RAM_RECORDS];
+        }
+        *start = ram_tail;
+        *count = n;
+        source = BATCH_RAM;
+    }
+
+    rt_mutex_release(&telemetry_lock);
+
+    return source;
+}
+
+/**
+ * @brief 确认一批记录已发布
+ * @note 发布期间若这些记录被转存到闪存, 会再发布一次 (至少一次语义)
+ */
+static void telemetry_commit(batch_source_t source, rt_uint32_t start, rt_uint32_t count)
+{
+    rt_mutex_take(&telemetry_lock, RT_WAITING_FOREVER);
+
+    if (source == BATCH_RAM) {
+        if ((rt_int32_t)(ram_tail - (start + count)) < 0) {
+            ram_tail = start + count;
+        }
+    }
+#ifdef RT_USING_FAL
+    else if (source == BATCH_FLASH) {
+        flash_commit(start, count);
+    }
+#endif
+
+    stat_published += count;
+    stat_messages++;
+
+    rt_mutex_release(&telemetry_lock);
+}
+
+static void telemetry_thread_entry(void *parameter)
+{
+    rt_tick_t retry_tick = 0;
+
+    while (1)
+    {
+        rt_int32_t timeout;
+
+        if (!telemetry_link_up) {
+            timeout = rt_tick_from_millisecond(PV_TELEMETRY_RETRY_MS);
+        } else if (pv_telemetry_backlog() > 0) {
+            timeout = rt_tick_from_millisecond(PV_TELEMETRY_DRAIN_GAP_MS);
+        } else {
+            timeout = RT_WAITING_FOREVER;
+        }
+        rt_sem_take(&telemetry_sem, timeout);
+
+        if (!telemetry_link_up) {
+            /* 断网期间攒够一批就写入闪存, 掉电也不丢 */
+            rt_mutex_take(&telemetry_lock, RT_WAITING_FOREVER);
+            while (ram_head - ram_tail >= PV_TELEMETRY_SPILL_BATCH && ram_spill() == RT_EOK);
+            rt_mutex_release(&telemetry_lock);
+
+            if ((rt_int32_t)(rt_tick_get() - retry_tick) < 0) {
+                continue;
+            }
+        }
+
+        rt_uint32_t start = 0, count = 0;
+        batch_source_t source = telemetry_peek(&start, &count);
+        if (source == BATCH_NONE) {
+            continue;
+        }
+
+        /* 负载放不下时只打包放得下的前几条, 其余留给下一批 */
+        const char *topic;
+        int len;
+        if (telemetry_format == PV_TELEMETRY_FORMAT_DELTA) {
+            topic = PV_TELEMETRY_DELTA_TOPIC;
+            len = telemetry_build_delta(batch_buf, &count);
+        } else {
+            topic = PV_TELEMETRY_TOPIC;
+            len = telemetry_build_payload(batch_buf, &count);
+        }
+        if (len < 0) {
+            rt_kprintf("Telemetry: payload buffer too small\n");
+            telemetry_commit(source, start, count);
+            continue;
+        }
+
+        if (telemetry_publisher(topic, (const rt_uint8_t *)payload_buf, len) == 0) {
+            telemetry_message_id++;
+            telemetry_commit(source, start, count);
+            if (!telemetry_link_up) {
+                rt_kprintf("Telemetry: link restored, draining %d records\n", pv_telemetry_backlog());
+            }
+            telemetry_link_up = RT_TRUE;
+        } else {
+            stat_failed++;
+            if (telemetry_link_up) {
+                rt_kprintf("Telemetry: publish failed, buffering (backlog %d)\n", pv_telemetry_backlog());
+            }
+            telemetry_link_up = RT_FALSE;
+            retry_tick = rt_tick_get() + rt_tick_from_millisecond(PV_TELEMETRY_RETRY_MS);
+        }
+    }
+}
+
+rt_err_t pv_telemetry_init(void)
+{
+    if (telemetry_initialized) {
+        return RT_EOK;
+    }
+
+    rt_mutex_init(&telemetry_lock, "telem", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&telemetry_sem, "telem", 0, RT_IPC_FLAG_FIFO);
+
+#ifdef RT_USING_FAL
+    flash_recover();
+#endif
+
+    telemetry_thread = rt_thread_create("pv_telem",
+                                        telemetry_thread_entry,
+                                        RT_NULL,
+                                        TELEMETRY_THREAD_STACK,
+                                        TELEMETRY_THREAD_PRIORITY,
+                                        TELEMETRY_THREAD_TICK);
+    if (telemetry_thread == RT_NULL) {
+        rt_sem_detach(&telemetry_sem);
+        rt_mutex_detach(&telemetry_lock);
+        rt_kprintf("Error: Create telemetry thread failed!\n");
+        return -RT_ENOMEM;
+    }
+
+    telemetry_initialized = RT_TRUE;
+    rt_thread_startup(telemetry_thread);
+
+    return RT_EOK;
+}
+
+rt_err_t pv_telemetry_push(const pv_telemetry_record_t *record)
+{
+    pv_telemetry_record_t *slot;
+
+    if (record == RT_NULL) {
+        return -RT_EINVAL;
+    }
+
+    if (!telemetry_initialized && pv_telemetry_init() != RT_EOK) {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(&telemetry_lock, RT_WAITING_FOREVER);
+
+    /* RAM满: 转存到闪存, 闪存不可用时丢弃最旧的记录 */
+    if (ram_head - ram_tail >= PV_TELEMETRY_RAM_RECORDS && ram_spill() != RT_EOK) {
+        ram_tail++;
+        stat_dropped++;
+    }
+
+    slot = &ram_ring[ram_head % PV_TELEMETRY_RAM_RECORDS];
+    *slot = *record;
+    if (slot->timestamp == 0) {
+        slot->timestamp = (rt_uint32_t)time(RT_NULL);
+    }
+    slot->flags |= PV_TELEMETRY_FLAG_PENDING;
+    ram_head++;
+
+    rt_mutex_release(&telemetry_lock);
+
+    if (telemetry_link_up) {
+        rt_sem_release(&telemetry_sem);
+    }
+
+    return RT_EOK;
+}
+
+void pv_telemetry_set_publisher(pv_telemetry_publish_t publish)
+{
+    telemetry_publisher = (publish != RT_NULL) ? publish : telemetry_default_publish;
+}
+
+rt_err_t pv_telemetry_set_format(int format)
+{
+    if (format != PV_TELEMETRY_FORMAT_JSON && format != PV_TELEMETRY_FORMAT_DELTA) {
+        return -RT_EINVAL;
+    }
+
+    telemetry_format = format;
+
+    return RT_EOK;
+}
+
+rt_uint32_t pv_telemetry_backlog(void)
+{
+    rt_uint32_t backlog;
+
+    if (!telemetry_initialized) {
+        return 0;
+    }
+
+    /* 与转存和确认互斥, 不会读到一半更新的读写位置 */
+    rt_mutex_take(&telemetry_lock, RT_WAITING_FOREVER);
+    backlog = (ram_head - ram_tail) + flash_count();
+    rt_mutex_release(&telemetry_lock);
+
+    return backlog;
+}
+
+/**
+ * @brief 查看遥测缓冲状态
+ */
+int pv_telemetry_status(void)
+{
+    rt_kprintf("\n=== PV Telemetry Status ===\n");
+    rt_kprintf("Link: %s\n", telemetry_link_up ? "Up" : "Down (buffering)");
+    rt_kprintf("Format: %s\n", (telemetry_format == PV_TELEMETRY_FORMAT_DELTA) ? "delta binary" : "JSON DP array");
+    rt_kprintf("RAM backlog: %d/%d\n", ram_head - ram_tail, PV_TELEMETRY_RAM_RECORDS);
+#ifdef RT_USING_FAL
+    if (flash_part != RT_NULL) {
+        rt_kprintf("Flash backlog: %d (partition '%s', %d sectors)\n",
+                   flash_count(), PV_TELEMETRY_PARTITION, flash_sectors);
+    } else
+#endif
+    {
+        rt_kprintf("Flash backlog: disabled\n");
+    }
+    rt_kprintf("Published: %d records in %d messages\n", stat_published, stat_messages);
+    rt_kprintf("Failed publishes: %d\n", stat_failed);
+    rt_kprintf("Spilled to flash: %d, Dropped: %d\n", stat_spilled, stat_dropped);
+    rt_kprintf("===========================\n");
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(pv_telemetry_status, Show telemetry store-and-forward status);
+
+/**
+ * @brief 切换负载格式: pv_telemetry_format json|delta
+ */
+static int pv_telemetry_format_cmd(int argc, char **argv)
+{
+    if (argc == 2 && rt_strcmp(argv[1], "json") == 0) {
+        pv_telemetry_set_format(PV_TELEMETRY_FORMAT_JSON);
+    } else if (argc == 2 && rt_strcmp(argv[1], "delta") == 0) {
+        pv_telemetry_set_format(PV_TELEMETRY_FORMAT_DELTA);
+    } else {
+        rt_kprintf("Usage: pv_telemetry_format json|delta\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+MSH_CMD_EXPORT_ALIAS(pv_telemetry_format_cmd, pv_telemetry_format, Select telemetry payload format: json|delta);
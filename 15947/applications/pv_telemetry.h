@@ -0,0 +1,95 @@
+/*
+ * pv_telemetry.h
+ *
+ * 光伏遥测存储转发上传
+ * 采集线程只负责把记录压入RAM环形缓冲; 断网时记录按批写入FAL闪存分区,
+ * 上传线程在链路恢复后按链路能力把积压数据以OneNET DP数组(带时间戳)
+ * 或增量二进制负载批量发布。
+ */
+
+#ifndef PV_TELEMETRY_H
+#define PV_TELEMETRY_H
+
+#include <rtthread.h>
+
+// 记录中的电压通道
+enum {
+    PV_TELEMETRY_VA1 = 0,
+    PV_TELEMETRY_VA2,
+    PV_TELEMETRY_VA3,
+    PV_TELEMETRY_VB1,
+    PV_TELEMETRY_VB2,
+    PV_TELEMETRY_VB3,
+    PV_TELEMETRY_CHANNELS
+};
+
+// 记录标志
+#define PV_TELEMETRY_FLAG_HAS_VB3       0x01    // vb3 通道有效
+#define PV_TELEMETRY_FLAG_BASELINE      0x02    // 故障检测基准已建立
+#define PV_TELEMETRY_FLAG_PENDING       0x80    // 闪存中: 尚未确认发布 (发布后清零)
+
+// 一条遥测记录 (20字节, 同时也是闪存中的存储格式)
+typedef struct {
+    rt_uint32_t timestamp;                      // UNIX时间 (s), 闪存空槽为 0xFFFFFFFF
+    rt_uint16_t mv[PV_TELEMETRY_CHANNELS];      // 上传的节点电压 (mV)
+    rt_uint8_t fault_code;                      // 主故障码 (0=正常, 1~6=PV1~PV6)
+    rt_uint8_t fault_mask;                      // bit i = PV(i+1) 故障
+    rt_uint8_t flags;                           // PV_TELEMETRY_FLAG_*
+    rt_uint8_t reserved;
+} pv_telemetry_record_t;
+
+// 负载格式
+#define PV_TELEMETRY_FORMAT_JSON        0       // OneNET DP数组, 每个数据点带毫秒时间戳
+#define PV_TELEMETRY_FORMAT_DELTA       1       // 增量二进制, 格式见下
+
+/*
+ * 增量二进制负载 (多字节整数均为小端):
+ *   u8  版本 PV_TELEMETRY_DELTA_VERSION
+ *   u8  记录数 n (1 ~ PV_TELEMETRY_BATCH_MAX)
+ *   第一条记录: u32 timestamp, u16 mv[PV_TELEMETRY_CHANNELS], u8 fault_code, u8 fault_mask, u8 flags
+ *   其余每条记录相对上一条:
+ *     varint  timestamp 差值 (zigzag)
+ *     varint  mv[ch] 差值 (zigzag), 每通道一个
+ *     u8      0: 故障码/掩码/标志不变; 1: 其后为新的 fault_code, fault_mask, flags
+ * varint 每字节低7位为数据, 最高位为1表示后面还有字节; zigzag 把有符号数 v 映射为
+ * (v << 1) ^ (v >> 31), 小的正负差值都只占一个字节。flags 不含 PV_TELEMETRY_FLAG_PENDING。
+ * 电压平稳时每条记录8字节; DP数组JSON每条记录约三百字节, 2KB的负载只能放6条。
+ */
+#define PV_TELEMETRY_DELTA_VERSION      1
+
+/**
+ * @brief 发布函数, 返回0表示成功
+ * 默认经 pv_onenet_publish() 由OneNET发布线程发送, 可替换为本地MQTT替身进行调试
+ */
+typedef int (*pv_telemetry_publish_t)(const char *topic, const rt_uint8_t *payload, rt_size_t len);
+
+/**
+ * @brief 初始化缓冲区并从闪存恢复积压数据, 启动上传线程
+ * @return RT_EOK 成功
+ */
+rt_err_t pv_telemetry_init(void);
+
+/**
+ * @brief 压入一条记录 (时间戳为0时自动填充当前时间)
+ * @return RT_EOK 成功
+ */
+rt_err_t pv_telemetry_push(const pv_telemetry_record_t *record);
+
+/**
+ * @brief 替换发布函数
+ */
+void pv_telemetry_set_publisher(pv_telemetry_publish_t publish);
+
+/**
+ * @brief 选择负载格式, 从下一批开始生效
+ * @param format PV_TELEMETRY_FORMAT_JSON / PV_TELEMETRY_FORMAT_DELTA
+ * @return RT_EOK 成功, -RT_EINVAL 格式未知
+ */
+rt_err_t pv_telemetry_set_format(int format);
+
+/**
+ * @brief 获取尚未发布的记录数 (RAM + 闪存)
+ */
+rt_uint32_t pv_telemetry_backlog(void);
+
+#endif // PV_TELEMETRY_H
@@ -0,0 +1,141 @@
+/* applications/pv_topology.c */
+/* 光伏阵列拓扑描述 */
+
+#include <stdio.h>
+#include <string.h>
+#include "pv_topology.h"
+
+/* 标签中逐块列出板号的最大累计深度, 更深的抽头写成区间 */
+#define LABEL_LIST_MAX      3
+
+int pv_topology_compile(pv_topology_t *topo, const pv_topology_desc_t *desc)
+{
+    uint8_t tap_at_depth[PV_TOPO_MAX_PANELS + 1];
+    int total = 0;
+
+    if (desc->strings == 0 || desc->strings > PV_TOPO_MAX_STRINGS ||
+        desc->channels == 0 || desc->channels > PV_TOPO_MAX_CHANNELS) {
+        return -1;
+    }
+
+    memset(topo, 0, sizeof(*topo));
+    topo->strings = desc->strings;
+    topo->channels = desc->channels;
+
+    for (int s = 0; s < desc->strings; s++) {
+        if (desc->panels[s] == 0 || total + desc->panels[s] > PV_TOPO_MAX_PANELS) {
+            return -1;
+        }
+        topo->string_first[s] = (uint8_t)total;
+        topo->string_panels[s] = desc->panels[s];
+        total += desc->panels[s];
+    }
+    topo->panels = (uint8_t)total;
+
+    for (int c = 0; c < desc->channels; c++) {
+        const pv_topo_tap_t *tap = &desc->taps[c];
+
+        if (tap->depth == 0) {
+            continue;
+        }
+        if (tap->string >= desc->strings || tap->depth > desc->panels[tap->string]) {
+            return -1;
+        }
+        topo->channel_string[c] = tap->string;
+        topo->channel_depth[c] = tap->depth;
+        topo->channel_panels[c] = ((tap->depth < 64) ? (((pv_panel_mask_t)1 << tap->depth) - 1) : ~(pv_panel_mask_t)0)
+                                  << topo->string_first[tap->string];
+    }
+
+    /* 每个组串从负端 (0V) 向上, 相邻抽头之间划为一段 */
+    for (int s = 0; s < desc->strings; s++) {
+        uint8_t lower = topo->channels;
+        int lower_depth = 0;
+
+        memset(tap_at_depth, 0xFF, sizeof(tap_at_depth));
+        for (int c = 0; c < desc->channels; c++) {
+            if (topo->channel_depth[c] != 0 && topo->channel_string[c] == s) {
+                if (tap_at_depth[topo->channel_depth[c]] != 0xFF) {
+                    return -1;
+                }
+                tap_at_depth[topo->channel_depth[c]] = (uint8_t)c;
+            }
+        }
+        if (tap_at_depth[desc->panels[s]] == 0xFF) {
+            return -1;
+        }
+
+        for (int d = 1; d <= desc->panels[s]; d++) {
+            uint8_t k;
+
+            if (tap_at_depth[d] == 0xFF) {
+                continue;
+            }
+
+            k = topo->segments++;
+            topo->seg_plus[k] = tap_at_depth[d];
+            topo->seg_minus[k] = lower;
+            for (int p = lower_depth; p < d; p++) {
+                topo->panel_segment[topo->string_first[s] + p] = k;
+                topo->panel_share[topo->string_first[s] + p] = (uint8_t)(d - lower_depth);
+            }
+
+            lower = tap_at_depth[d];
+            lower_depth = d;
+        }
+    }
+
+    return 0;
+}
+
+void pv_topology_panel_mv(const pv_topology_t *topo, const int32_t *channel_mv, int32_t *panel_mv)
+{
+    /* 末尾补一个0V通道, 段表中的组串负端都指向它, 循环里不需要分支 */
+    int32_t ext[PV_TOPO_MAX_CHANNELS + 1];
+
+    for (int c = 0; c < topo->channels; c++) {
+        ext[c] = channel_mv[c];
+    }
+    ext[topo->channels] = 0;
+
+    for (int j = 0; j < topo->panels; j++) {
+        const uint8_t k = topo->panel_segment[j];
+
+        panel_mv[j] = (ext[topo->seg_plus[k]] - ext[topo->seg_minus[k]]) / topo->panel_share[j];
+    }
+}
+
+pv_panel_mask_t pv_topology_abnormal_channels(const pv_topology_t *topo, pv_panel_mask_t panel_mask)
+{
+    pv_panel_mask_t channels = 0;
+
+    for (int c = 0; c < topo->channels; c++) {
+        if (topo->channel_panels[c] & panel_mask) {
+            channels |= (pv_panel_mask_t)1 << c;
+        }
+    }
+
+    return channels;
+}
+
+int pv_topology_channel_label(const pv_topology_t *topo, int channel, char *buf, size_t size)
+{
+    int depth, first, n;
+
+    if (channel < 0 || channel >= topo->channels || topo->channel_depth[channel] == 0) {
+        return snprintf(buf, size, "unused");
+    }
+
+    depth = topo->channel_depth[channel];
+    first = topo->string_first[topo->channel_string[channel]] + 1;
+    n = snprintf(buf, size, "v%c%d: ", 'a' + topo->channel_string[channel], depth);
+
+    if (depth > LABEL_LIST_MAX) {
+        return n + snprintf(buf + n, size > (size_t)n ? size - n : 0, "PV%d..PV%d", first, first + depth - 1);
+    }
+    for (int i = 0; i < depth && (size_t)n < size; i++) {
+        n += snprintf(buf + n, size - n, i ? "+PV%d" : "PV%d", first + i);
+    }
+
+    return n;
+}
@@ -0,0 +1,87 @@
+/*
+ * pv_topology.h
+ *
+ * 光伏阵列拓扑描述
+ * 用 "组串数 + 每串板数 + 每个采样通道测量的累计抽头" 描述阵列, 编译成扁平的
+ * 段表后, 每帧用两次无分支的数组循环就能从通道电压得到全部板电压。
+ * 增加组串或通过外部多路复用器接入更多通道时只需修改描述表。
+ * 只依赖 <stdint.h>, 可在主机上直接编译。
+ */
+
+#ifndef PV_TOPOLOGY_H
+#define PV_TOPOLOGY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PV_TOPO_MAX_STRINGS     16
+#define PV_TOPO_MAX_CHANNELS    64
+#define PV_TOPO_MAX_PANELS      64
+
+typedef uint64_t pv_panel_mask_t;       // bit i = 第 i 块板 (0 = PV1)
+
+// 抽头: 通道测量组串 string 从负端起前 depth 块板的累计电压, depth 为0表示通道未接
+typedef struct {
+    uint8_t string;
+    uint8_t depth;
+} pv_topo_tap_t;
+
+// 拓扑描述
+typedef struct {
+    uint8_t strings;                            // 组串数
+    const uint8_t *panels;                      // panels[strings]: 每串板数
+    uint8_t channels;                           // 采样通道数
+    const pv_topo_tap_t *taps;                  // taps[channels]: 每个通道的抽头
+} pv_topology_desc_t;
+
+/*
+ * 编译后的拓扑。相邻两个抽头之间的板组成一个 "段", 段电压 = 高端抽头 - 低端抽头。
+ * 段内多于一块板时这些板无法单独分辨, 各自按段电压平均分摊。
+ * 板按组串顺序全局编号: 第0串的板在前, 依次类推。
+ */
+typedef struct {
+    uint8_t strings;
+    uint8_t channels;
+    uint8_t panels;                             // 总板数
+    uint8_t segments;                           // 段数
+
+    uint8_t string_first[PV_TOPO_MAX_STRINGS];  // 组串第一块板的全局编号
+    uint8_t string_panels[PV_TOPO_MAX_STRINGS];
+
+    uint8_t seg_plus[PV_TOPO_MAX_PANELS];       // 段高端通道, == channels 表示 0V
+    uint8_t seg_minus[PV_TOPO_MAX_PANELS];      // 段低端通道, == channels 表示 0V (组串负端)
+
+    uint8_t panel_segment[PV_TOPO_MAX_PANELS];  // 板 -> 段
+    uint8_t panel_share[PV_TOPO_MAX_PANELS];    // 所在段的板数
+
+    pv_panel_mask_t channel_panels[PV_TOPO_MAX_CHANNELS];   // 通道读数包含的板
+    uint8_t channel_string[PV_TOPO_MAX_CHANNELS];
+    uint8_t channel_depth[PV_TOPO_MAX_CHANNELS];            // 0 = 未接
+} pv_topology_t;
+
+/**
+ * @brief 校验描述并编译成扁平段表
+ * @return 0 成功, -1 描述非法 (超出上限、抽头越界、同一组串同一深度重复、
+ *         或组串最顶端没有抽头导致末段无法测量)
+ */
+int pv_topology_compile(pv_topology_t *topo, const pv_topology_desc_t *desc);
+
+/**
+ * @brief 由通道电压计算每块板的电压
+ * @param channel_mv 通道电压 (mV), 长度为 topo->channels
+ * @param panel_mv 输出板电压 (mV), 长度为 topo->panels
+ */
+void pv_topology_panel_mv(const pv_topology_t *topo, const int32_t *channel_mv, int32_t *panel_mv);
+
+/**
+ * @brief 由故障板掩码得到读数异常的通道掩码
+ */
+pv_panel_mask_t pv_topology_abnormal_channels(const pv_topology_t *topo, pv_panel_mask_t panel_mask);
+
+/**
+ * @brief 通道标签, 如 "va2: PV1+PV2", 未接通道为 "unused"
+ * @return 写入的字符数
+ */
+int pv_topology_channel_label(const pv_topology_t *topo, int channel, char *buf, size_t size);
+
+#endif // PV_TOPOLOGY_H
@@ -0,0 +1,560 @@
+/* applications/pv_trace.c */
+/* 光伏采样帧录制与回放 */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+#include <time.h>
+#include "stm32h7xx.h"      // DWT周期计数器
+#include "pv_cloud_config.h"
+#include "pv_diagnosis.h"
+#include "pv_fault_engine.h"
+#include "pv_topology.h"
+#include "pv_trace.h"
+
+#ifdef RT_USING_DFS
+#include <fcntl.h>
+#include <unistd.h>
+
+/* 写文件线程配置 */
+#define TRACE_THREAD_STACK          2048
+#define TRACE_THREAD_PRIORITY       20
+#define TRACE_THREAD_TICK           20
+
+#define TRACE_MSG_STOP              0xFF        // 内部消息: 停止录制并关闭文件
+#define TRACE_NOT_PENDING           0xFFFFFFFFUL
+
+/* 阵列拓扑 (pv_fault_detection.c) */
+extern const pv_topology_t *pv_fault_topology(void);
+
+/* 采样回调/标注命令交给写文件线程的消息 */
+typedef struct {
+    rt_tick_t tick;
+    pv_trace_record_t record;
+} trace_msg_t;
+
+static struct rt_messagequeue trace_mq;
+static rt_uint8_t trace_mq_pool[PV_TRACE_QUEUE_DEPTH *
+                                (RT_ALIGN(sizeof(trace_msg_t), RT_ALIGN_SIZE) + sizeof(void *))];
+static rt_thread_t trace_thread = RT_NULL;
+static volatile rt_bool_t trace_recording = RT_FALSE;
+static int trace_fd = -1;
+static rt_tick_t trace_last_tick = 0;
+static rt_tick_t trace_end_tick = 0;
+static rt_uint32_t trace_records = 0;
+static rt_uint32_t trace_dropped = 0;
+
+/* ========== 录制 ========== */
+
+/**
+ * @brief 采样回调: 只复制原始值并入队, 文件写入在写文件线程中完成
+ */
+static void trace_on_frame(const pv_sample_frame_t *frame, void *user_data)
+{
+    trace_msg_t msg;
+
+    msg.tick = frame->tick;
+    msg.record.type = PV_TRACE_FRAME;
+    msg.record.mask = 0;
+    rt_memcpy(msg.record.raw, frame->raw, sizeof(msg.record.raw));
+
+    if (rt_mq_send(&trace_mq, &msg, sizeof(msg)) != RT_EOK) {
+        trace_dropped++;
+    }
+}
+
+/**
+ * @brief 关闭文件, 回写记录数 (写文件线程中调用)
+ */
+static void trace_close(void)
+{
+    pv_trace_header_t header;
+
+    if (trace_fd < 0) {
+        return;
+    }
+
+    if (lseek(trace_fd, 0, SEEK_SET) == 0 && read(trace_fd, &header, sizeof(header)) == sizeof(header)) {
+        header.records = trace_records;
+        lseek(trace_fd, 0, SEEK_SET);
+        write(trace_fd, &header, sizeof(header));
+    }
+    close(trace_fd);
+    trace_fd = -1;
+
+    rt_kprintf("Trace: stopped, %d records, %d frames dropped\n", trace_records, trace_dropped);
+}
+
+static void trace_thread_entry(void *parameter)
+{
+    pv_trace_record_t batch[PV_TRACE_WRITE_BATCH];
+    rt_uint32_t count = 0;
+    trace_msg_t msg;
+
+    while (1) {
+        rt_bool_t stop = RT_FALSE;
+
+        /* 有未写出的记录时最多等待100ms, 队列空闲就先写出 */
+        if (rt_mq_recv(&trace_mq, &msg, sizeof(msg),
+                       count ? rt_tick_from_millisecond(100) : RT_WAITING_FOREVER) == RT_EOK) {
+            if (msg.record.type == TRACE_MSG_STOP) {
+                stop = RT_TRUE;
+            } else if (trace_fd >= 0) {
+                rt_uint32_t dt = (msg.tick - trace_last_tick) * 1000 / RT_TICK_PER_SECOND;
+
+                msg.record.dt_ms = (dt > 0xFFFF) ? 0xFFFF : (rt_uint16_t)dt;
+                trace_last_tick = msg.tick;
+                batch[count++] = msg.record;
+
+                if (trace_end_tick != 0 && (rt_int32_t)(msg.tick - trace_end_tick) >= 0) {
+                    stop = RT_TRUE;
+                } else if (count < PV_TRACE_WRITE_BATCH) {
+                    continue;
+                }
+            }
+        }
+
+        if (count > 0 && trace_fd >= 0) {
+            if (write(trace_fd, batch, count * sizeof(pv_trace_record_t)) != (int)(count * sizeof(pv_trace_record_t))) {
+                rt_kprintf("Trace: write failed, stopping\n");
+                stop = RT_TRUE;
+            } else {
+                trace_records += count;
+            }
+        }
+        count = 0;
+
+        if (stop && trace_fd >= 0) {
+            pv_sampler_unsubscribe(trace_on_frame, RT_NULL);
+            trace_recording = RT_FALSE;
+            trace_close();
+        }
+    }
+}
+
+rt_err_t pv_trace_start(const char *path, rt_uint32_t seconds)
+{
+    pv_trace_header_t header;
+
+    if (trace_recording) {
+        return -RT_EBUSY;
+    }
+
+    if (trace_thread == RT_NULL) {
+        rt_mq_init(&trace_mq, "pv_trace", trace_mq_pool, sizeof(trace_msg_t), sizeof(trace_mq_pool), RT_IPC_FLAG_FIFO);
+        trace_thread = rt_thread_create("pv_trace",
+                                        trace_thread_entry,
+                                        RT_NULL,
+                                        TRACE_THREAD_STACK,
+                                        TRACE_THREAD_PRIORITY,
+                                        TRACE_THREAD_TICK);
+        if (trace_thread == RT_NULL) {
+            rt_mq_detach(&trace_mq);
+            rt_kprintf("Error: Create trace thread failed!\n");
+            return -RT_ENOMEM;
+        }
+        rt_thread_startup(trace_thread);
+    }
+
+    /* 停止时需要回写文件头, 以读写方式打开 */
+    trace_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0);
+    if (trace_fd < 0) {
+        rt_kprintf("Trace: cannot create %s\n", path);
+        return -RT_EIO;
+    }
+
+    rt_memset(&header, 0, sizeof(header));
+    header.magic = PV_TRACE_MAGIC;
+    header.version = PV_TRACE_VERSION;
+    header.record_size = sizeof(pv_trace_record_t);
+    header.start_time = (rt_uint32_t)time(RT_NULL);
+    header.period_ms = PV_SAMPLER_PERIOD_MS;
+    header.vref_mv = PV_VOLTAGE_REF;
+    header.adc_max = PV_ADC_MAX_VALUE;
+    if (write(trace_fd, &header, sizeof(header)) != sizeof(header)) {
+        close(trace_fd);
+        trace_fd = -1;
+        return -RT_EIO;
+    }
+
+    trace_records = 0;
+    trace_dropped = 0;
+    trace_last_tick = rt_tick_get();
+    trace_end_tick = seconds ? trace_last_tick + rt_tick_from_millisecond(seconds * 1000) : 0;
+    trace_recording = RT_TRUE;
+
+    if (pv_sampler_subscribe(trace_on_frame, RT_NULL) != RT_EOK) {
+        trace_recording = RT_FALSE;
+        close(trace_fd);
+        trace_fd = -1;
+        rt_kprintf("Trace: sampler subscription failed\n");
+        return -RT_EFULL;
+    }
+    pv_sampler_start();
+
+    rt_kprintf("Trace: recording to %s%s\n", path, seconds ? "" : " until pv_trace_stop");
+    return RT_EOK;
+}
+
+void pv_trace_stop(void)
+{
+    trace_msg_t msg;
+
+    if (!trace_recording) {
+        return;
+    }
+
+    pv_sampler_unsubscribe(trace_on_frame, RT_NULL);
+
+    rt_memset(&msg, 0, sizeof(msg));
+    msg.tick = rt_tick_get();
+    msg.record.type = TRACE_MSG_STOP;
+    rt_mq_urgent(&trace_mq, &msg, sizeof(msg));
+}
+
+rt_err_t pv_trace_mark(pv_panel_mask_t mask)
+{
+    trace_msg_t msg;
+
+    if (!trace_recording) {
+        return -RT_ERROR;
+    }
+
+    rt_memset(&msg, 0, sizeof(msg));
+    msg.tick = rt_tick_get();
+    msg.record.type = PV_TRACE_MARK;
+    msg.record.mask = (rt_uint8_t)mask;
+    for (int i = 0; i < 4; i++) {
+        msg.record.raw[i] = (rt_uint16_t)(mask >> (16 * i));
+    }
+
+    return rt_mq_send(&trace_mq, &msg, sizeof(msg));
+}
+
+/* ========== 回放 ========== */
+
+/* 单个检测算法的回放统计 */
+typedef struct {
+    const char *name;
+    int panels;                             // 统计的板数
+    pv_panel_mask_t coverage;               // 算法能判断的板
+    pv_panel_mask_t detected;               // 当前检测结果
+    rt_uint32_t fp_frames;                  // 报出了实际正常的板的帧数
+    rt_uint32_t detections;
+    rt_uint32_t missed;
+    rt_uint32_t latency_sum_ms;
+    rt_uint32_t latency_max_ms;
+    rt_uint64_t cycles_sum;
+    rt_uint32_t cycles_max;
+    rt_uint32_t pending_since[PV_TOPO_MAX_PANELS]; // 真实故障出现的时刻, 等待检测
+} replay_stat_t;
+
+static void cycle_counter_enable(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static void replay_stat_init(replay_stat_t *stat, const char *name, int panels, pv_panel_mask_t coverage)
+{
+    rt_memset(stat, 0, sizeof(*stat));
+    stat->name = name;
+    stat->panels = panels;
+    stat->coverage = coverage;
+    for (int i = 0; i < PV_TOPO_MAX_PANELS; i++) {
+        stat->pending_since[i] = TRACE_NOT_PENDING;
+    }
+}
+
+/**
+ * @brief 真实故障状态变化: 新出现的故障开始计时, 未被检测到就消失的计为漏检
+ */
+static void replay_truth_changed(replay_stat_t *stat, pv_panel_mask_t before, pv_panel_mask_t after,
+                                 rt_uint32_t now_ms)
+{
+    for (int i = 0; i < stat->panels; i++) {
+        pv_panel_mask_t bit = (pv_panel_mask_t)1 << i;
+
+        if (!(stat->coverage & bit)) {
+            continue;
+        }
+        if ((after & bit) && !(before & bit)) {
+            stat->pending_since[i] = now_ms;
+        } else if (!(after & bit) && stat->pending_since[i] != TRACE_NOT_PENDING) {
+            stat->missed++;
+            stat->pending_since[i] = TRACE_NOT_PENDING;
+        }
+    }
+}
+
+static void replay_frame_done(replay_stat_t *stat, pv_panel_mask_t truth, rt_uint32_t now_ms, rt_uint32_t cycles)
+{
+    stat->cycles_sum += cycles;
+    if (cycles > stat->cycles_max) {
+        stat->cycles_max = cycles;
+    }
+
+    if (stat->detected & ~truth & stat->coverage) {
+        stat->fp_frames++;
+    }
+
+    for (int i = 0; i < stat->panels; i++) {
+        if (stat->pending_since[i] != TRACE_NOT_PENDING && (stat->detected & ((pv_panel_mask_t)1 << i))) {
+            rt_uint32_t latency = now_ms - stat->pending_since[i];
+
+            stat->detections++;
+            stat->latency_sum_ms += latency;
+            if (latency > stat->latency_max_ms) {
+                stat->latency_max_ms = latency;
+            }
+            stat->pending_since[i] = TRACE_NOT_PENDING;
+        }
+    }
+}
+
+/**
+ * @brief 输出统计, 回放结束时仍未检测到的故障计为漏检
+ */
+static void replay_report(replay_stat_t *stat, rt_uint32_t frames)
+{
+    rt_uint32_t mhz = SystemCoreClock / 1000000;
+    rt_uint32_t fp_permyriad = (rt_uint32_t)((rt_uint64_t)stat->fp_frames * 10000 / frames);
+
+    for (int i = 0; i < stat->panels; i++) {
+        if (stat->pending_since[i] != TRACE_NOT_PENDING) {
+            stat->missed++;
+        }
+    }
+
+    rt_kprintf("%-10s detected %d, missed %d, latency avg %d ms max %d ms, "
+               "false positive frames %d (%d.%02d%%), cpu avg %d cycles max %d (%d MHz)\n",
+               stat->name, stat->detections, stat->missed,
+               stat->detections ? stat->latency_sum_ms / stat->detections : 0, stat->latency_max_ms,
+               stat->fp_frames, fp_permyriad / 100, fp_permyriad % 100,
+               (rt_uint32_t)(stat->cycles_sum / frames), stat->cycles_max, mhz);
+}
+
+/**
+ * @brief 取出标注的真实故障板, 版本1的文件只有前8块板
+ */
+static pv_panel_mask_t replay_mark_mask(const pv_trace_header_t *header, const pv_trace_record_t *r)
+{
+    pv_panel_mask_t mask = 0;
+
+    if (header->version < 2) {
+        return r->mask;
+    }
+    for (int i = 0; i < 4; i++) {
+        mask |= (pv_panel_mask_t)r->raw[i] << (16 * i);
+    }
+    return mask;
+}
+
+/**
+ * @brief 把诊断结果的板号 (1~6) 换成掩码
+ */
+static pv_panel_mask_t replay_diagnosis_mask(const pv_diagnosis_result_t *result)
+{
+    pv_panel_mask_t mask = 0;
+
+    for (int i = 0; i < result->fault_count; i++) {
+        if (result->faulty_panels[i] >= 1 && result->faulty_panels[i] <= 6) {
+            mask |= (pv_panel_mask_t)1 << (result->faulty_panels[i] - 1);
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief 以最快速度回放录制文件, 对比故障引擎、诊断模块和基本异常检测的结果与标注
+ * @param drop_pct 覆盖引擎的下降阈值 (%), 0为默认
+ * @param slack_pct 覆盖引擎的CUSUM松弛量 (%), 0为默认
+ */
+static int trace_replay(const char *path, int drop_pct, int slack_pct)
+{
+    pv_trace_header_t header;
+    pv_trace_record_t records[PV_TRACE_WRITE_BATCH];
+    pv_fault_engine_config_t cfg;
+    pv_fault_engine_t *engine;
+    const pv_topology_t *topo = pv_fault_topology();
+    replay_stat_t stats[3];
+    rt_uint32_t frames = 0, now_ms = 0;
+    pv_panel_mask_t truth = 0, engine_coverage;
+    int fd, n;
+
+    fd = open(path, O_RDONLY, 0);
+    if (fd < 0) {
+        rt_kprintf("Trace: cannot open %s\n", path);
+        return -1;
+    }
+    if (read(fd, &header, sizeof(header)) != sizeof(header) || header.magic != PV_TRACE_MAGIC ||
+        header.record_size != sizeof(pv_trace_record_t) || header.adc_max == 0) {
+        rt_kprintf("Trace: %s is not a PV trace\n", path);
+        close(fd);
+        return -1;
+    }
+    if (topo == RT_NULL) {
+        close(fd);
+        return -1;
+    }
+
+    engine = rt_malloc(sizeof(pv_fault_engine_t));
+    if (engine == RT_NULL) {
+        close(fd);
+        return -1;
+    }
+
+    pv_fault_engine_default_config(&cfg);
+    if (drop_pct > 0) {
+        cfg.drop_threshold = PV_Q16(drop_pct / 100.0);
+    }
+    if (slack_pct > 0) {
+        cfg.cusum_slack = PV_Q16(slack_pct / 100.0);
+    }
+    pv_fault_engine_init(engine, &cfg, topo->panels, RT_NULL, RT_NULL);
+
+    /* 引擎覆盖拓扑中的全部板; 版本1的标注只有8位, 只统计前8块板 */
+    engine_coverage = (topo->panels >= PV_TOPO_MAX_PANELS) ? ~(pv_panel_mask_t)0
+                                                           : ((pv_panel_mask_t)1 << topo->panels) - 1;
+    if (header.version < 2) {
+        engine_coverage &= 0xFF;
+    }
+    replay_stat_init(&stats[0], "engine", topo->panels, engine_coverage);
+    /* 诊断模块按固定的 PV1~PV6 接线判断; 未标定时它内部退回基本异常检测,
+     * 基本异常检测另外单独统计, 标定后两者才有区别 */
+    replay_stat_init(&stats[1], "diagnosis", 6, 0x3F);
+    replay_stat_init(&stats[2], "anomaly", 6, 0x3F);
+    cycle_counter_enable();
+
+    while ((n = read(fd, records, sizeof(records))) >= (int)sizeof(pv_trace_record_t)) {
+        for (int k = 0; k < n / (int)sizeof(pv_trace_record_t); k++) {
+            const pv_trace_record_t *r = &records[k];
+            pv_diagnosis_result_t result;
+            int mv[PV_SAMPLER_CH_NUM];
+            int32_t channel_mv[PV_SAMPLER_CH_NUM];
+            int32_t panel_mv[PV_TOPO_MAX_PANELS];
+            rt_uint32_t start, cycles;
+
+            now_ms += r->dt_ms;
+
+            if (r->type == PV_TRACE_MARK) {
+                pv_panel_mask_t mark = replay_mark_mask(&header, r);
+
+                for (int s = 0; s < 3; s++) {
+                    replay_truth_changed(&stats[s], truth, mark, now_ms);
+                }
+                truth = mark;
+                continue;
+            }
+
+            for (int ch = 0; ch < PV_SAMPLER_CH_NUM; ch++) {
+                mv[ch] = (int)((r->raw[ch] * header.vref_mv) / header.adc_max);
+                channel_mv[ch] = mv[ch];
+            }
+
+            /* 与 pv_fault_detection.c 使用同一张拓扑表, 计时包含逐板换算 */
+            start = DWT->CYCCNT;
+            pv_topology_panel_mv(topo, channel_mv, panel_mv);
+            stats[0].detected = pv_fault_engine_process(engine, panel_mv);
+            replay_frame_done(&stats[0], truth, now_ms, DWT->CYCCNT - start);
+
+            rt_memset(&result, 0, sizeof(result));
+            start = DWT->CYCCNT;
+            pv_diagnose_panels(mv[PV_SAMPLER_CH_PA0], mv[PV_SAMPLER_CH_PA1],
+                               mv[PV_SAMPLER_CH_PB0], mv[PV_SAMPLER_CH_PB1], &result);
+            cycles = DWT->CYCCNT - start;
+            stats[1].detected = replay_diagnosis_mask(&result);
+            replay_frame_done(&stats[1], truth, now_ms, cycles);
+
+            rt_memset(&result, 0, sizeof(result));
+            start = DWT->CYCCNT;
+            pv_basic_anomaly_detection(mv[PV_SAMPLER_CH_PA0], mv[PV_SAMPLER_CH_PA1],
+                                       mv[PV_SAMPLER_CH_PB0], mv[PV_SAMPLER_CH_PB1], &result);
+            cycles = DWT->CYCCNT - start;
+            stats[2].detected = replay_diagnosis_mask(&result);
+            replay_frame_done(&stats[2], truth, now_ms, cycles);
+
+            frames++;
+        }
+    }
+    close(fd);
+    rt_free(engine);
+
+    if (frames == 0) {
+        rt_kprintf("Trace: no frames in %s\n", path);
+        return -1;
+    }
+
+    rt_kprintf("Replayed %s: %d frames, %d.%03d s of data\n", path, frames, now_ms / 1000, now_ms % 1000);
+    for (int s = 0; s < 3; s++) {
+        replay_report(&stats[s], frames);
+    }
+
+    return 0;
+}
+
+/* ========== MSH命令 ========== */
+
+static int pv_trace_start_cmd(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : PV_TRACE_DEFAULT_FILE;
+    rt_uint32_t seconds = (argc > 2) ? (rt_uint32_t)atoi(argv[2]) : 0;
+
+    return (pv_trace_start(path, seconds) == RT_EOK) ? 0 : -1;
+}
+MSH_CMD_EXPORT_ALIAS(pv_trace_start_cmd, pv_trace_start, record PV frames: pv_trace_start [file] [seconds]);
+
+static int pv_trace_stop_cmd(void)
+{
+    pv_trace_stop();
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(pv_trace_stop_cmd, pv_trace_stop, stop PV frame recording);
+
+static int pv_trace_mark_cmd(int argc, char **argv)
+{
+    if (argc < 2) {
+        rt_kprintf("Usage: pv_trace_mark <mask>  (bit0=PV1, bit1=PV2 ..., 0=all healthy)\n");
+        return -1;
+    }
+
+    if (pv_trace_mark((pv_panel_mask_t)strtoull(argv[1], RT_NULL, 0)) != RT_EOK) {
+        rt_kprintf("Trace: not recording\n");
+        return -1;
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(pv_trace_mark_cmd, pv_trace_mark, mark true faulty panels in PV trace);
+
+static int pv_trace_replay_cmd(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : PV_TRACE_DEFAULT_FILE;
+
+    if (trace_recording) {
+        rt_kprintf("Trace: stop recording first\n");
+        return -1;
+    }
+
+    return trace_replay(path, (argc > 2) ? atoi(argv[2]) : 0, (argc > 3) ? atoi(argv[3]) : 0);
+}
+MSH_CMD_EXPORT_ALIAS(pv_trace_replay_cmd, pv_trace_replay, replay PV trace: pv_trace_replay [file] [drop%] [slack%]);
+
+#else
+
+rt_err_t pv_trace_start(const char *path, rt_uint32_t seconds)
+{
+    return -RT_ENOSYS;
+}
+
+void pv_trace_stop(void)
+{
+}
+
+rt_err_t pv_trace_mark(pv_panel_mask_t mask)
+{
+    return -RT_ENOSYS;
+}
+
+#endif /* RT_USING_DFS */
@@ -0,0 +1,65 @@
+/*
+ * pv_trace.h
+ *
+ * 光伏采样帧录制与回放
+ * 把采样服务发布的原始ADC帧连同人工标注的真实故障状态录制到DFS文件,
+ * 之后可按最快速度回放给故障检测算法, 统计检测延迟、误报率和单帧耗时,
+ * 用于在不接实际阵列的情况下调整检测阈值。
+ */
+
+#ifndef PV_TRACE_H
+#define PV_TRACE_H
+
+#include <rtthread.h>
+#include "pv_sampler.h"
+#include "pv_topology.h"
+
+#define PV_TRACE_MAGIC          0x52545650  // "PVTR"
+#define PV_TRACE_VERSION        2           // 2: MARK 记录的完整掩码在 raw[0..3]
+
+// 记录类型
+#define PV_TRACE_FRAME          0           // 采样帧
+#define PV_TRACE_MARK           1           // 标注: 此刻起真实故障板为 mask
+
+// 文件头 (32字节)
+typedef struct {
+    rt_uint32_t magic;
+    rt_uint16_t version;
+    rt_uint16_t record_size;
+    rt_uint32_t start_time;                 // 录制开始的UNIX时间 (s)
+    rt_uint16_t period_ms;                  // 标称帧周期 (ms), 实际间隔见记录
+    rt_uint16_t vref_mv;                    // 原始值换算参数: mV = raw * vref_mv / adc_max
+    rt_uint32_t adc_max;
+    rt_uint32_t records;                    // 记录数 (录制中断时为0, 按文件长度计算)
+    rt_uint32_t reserved[2];
+} pv_trace_header_t;
+
+// 记录 (16字节)
+typedef struct {
+    rt_uint16_t dt_ms;                      // 与上一条记录的间隔 (ms), 饱和于65535
+    rt_uint8_t type;                        // PV_TRACE_FRAME / PV_TRACE_MARK
+    rt_uint8_t mask;                        // MARK: bit i = PV(i+1) 故障, 只有前8块板
+    rt_uint16_t raw[PV_SAMPLER_CH_NUM];     // FRAME: 原始ADC值 (PV_SAMPLER_CH_* 顺序)
+                                            // MARK: 64位故障掩码, 低16位在前 (版本2起)
+} pv_trace_record_t;
+
+/**
+ * @brief 开始录制到文件
+ * @param path 文件路径
+ * @param seconds 录制时长, 0为直到 pv_trace_stop()
+ * @return RT_EOK 成功
+ */
+rt_err_t pv_trace_start(const char *path, rt_uint32_t seconds);
+
+/**
+ * @brief 停止录制并关闭文件
+ */
+void pv_trace_stop(void);
+
+/**
+ * @brief 插入一条标注, 记录当前的真实故障板
+ * @param mask bit i = PV(i+1) 故障, 0 表示全部正常
+ */
+rt_err_t pv_trace_mark(pv_panel_mask_t mask);
+
+#endif // PV_TRACE_H
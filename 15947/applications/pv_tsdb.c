@@ -0,0 +1,751 @@
+/* applications/pv_tsdb.c */
+/* 光伏电压本地时序存储 */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+#include <time.h>
+#include "pv_cloud_config.h"
+#include "pv_sampler.h"
+#include "pv_tsdb.h"
+
+#ifdef RT_USING_FAL
+#include <fal.h>
+#endif
+
+#if defined(RT_USING_FAL) && PV_ENABLE_LOCAL_STORAGE
+
+/* 存储线程配置 */
+#define TSDB_THREAD_STACK           2048
+#define TSDB_THREAD_PRIORITY        18
+#define TSDB_THREAD_TICK            20
+
+/*
+ * 每一层占用分区中连续的一段扇区, 组成与遥测积压日志相同的循环日志:
+ * 扇区以头部 {magic, seq, t_first} 开始, 后接定长记录, 写位置是单调递增的绝对槽号,
+ * 扇区 seq 存放在该层的物理扇区 seq % N。记录按时间递增写入, 因此可以先按扇区头
+ * 的 t_first 二分定位, 再在扇区内顺序读取。
+ */
+#define TSDB_SECTOR_SIZE            4096
+#define TSDB_HEADER_SIZE            16
+#define TSDB_MAGIC                  0x50565453  // "PVTS"
+#define TSDB_EMPTY                  0xFFFFFFFFUL
+
+#define TSDB_TIME_VALID(t)          ((t) >= 1600000000UL && (t) <= 2000000000UL)
+#define TSDB_CLOCK_CHECK_MS         60000       // 检查墙钟与tick偏差的间隔
+
+/* 原始帧在闪存中的格式 (20字节) */
+typedef struct {
+    rt_uint32_t time;
+    rt_uint16_t msec;
+    rt_uint16_t mv[PV_TSDB_CHANNELS];
+    rt_uint16_t reserved;
+} tsdb_raw_record_t;
+
+typedef struct {
+    rt_uint32_t magic;
+    rt_uint32_t seq;
+    rt_uint32_t t_first;        // 扇区内第一条记录的时间
+    rt_uint32_t reserved;
+} tsdb_sector_header_t;
+
+/* 采样回调交给存储线程的消息 */
+typedef struct {
+    rt_tick_t tick;
+    rt_uint16_t mv[PV_TSDB_CHANNELS];
+} tsdb_frame_msg_t;
+
+/* 一层的循环日志 */
+typedef struct {
+    const char *name;
+    rt_uint32_t resolution;                 // 时间桶长度 (s), 原始层为0
+    rt_uint32_t base;                       // 分区内起始偏移
+    rt_uint32_t sectors;
+    rt_uint16_t rec_size;
+    rt_uint16_t slots;                      // 每扇区记录数
+    rt_uint32_t write;                      // 下一个写入闪存的绝对槽号
+    rt_uint32_t batch[PV_TSDB_PAGE_SIZE / 4];   // 尚未写入的记录, 依次对应槽 write, write+1, ...
+    rt_uint16_t batch_count;
+    rt_tick_t batch_tick;                   // 批量缓冲中第一条记录进入的时刻
+} tsdb_region_t;
+
+/* 聚合累加器 */
+typedef struct {
+    rt_uint32_t bucket;
+    rt_uint32_t count;
+    rt_uint64_t sum[PV_TSDB_CHANNELS];
+    rt_uint16_t min[PV_TSDB_CHANNELS];
+    rt_uint16_t max[PV_TSDB_CHANNELS];
+} tsdb_accum_t;
+
+static tsdb_region_t tsdb_regions[PV_TSDB_TIERS] = {
+    {"raw",  0,    0, PV_TSDB_RAW_SECTORS,  sizeof(tsdb_raw_record_t)},
+    {"1s",   1,    0, PV_TSDB_1S_SECTORS,   sizeof(pv_tsdb_point_t)},
+    {"1min", 60,   0, PV_TSDB_1MIN_SECTORS, sizeof(pv_tsdb_point_t)},
+    {"1h",   3600, 0, PV_TSDB_1H_SECTORS,   sizeof(pv_tsdb_point_t)},
+};
+static tsdb_accum_t tsdb_accums[PV_TSDB_TIERS];     // 下标为输出层, 原始层不用
+
+static const struct fal_partition *tsdb_part = RT_NULL;
+static struct rt_mutex tsdb_lock;
+static struct rt_messagequeue tsdb_mq;
+static rt_uint8_t tsdb_mq_pool[PV_TSDB_QUEUE_DEPTH *
+                               (RT_ALIGN(sizeof(tsdb_frame_msg_t), RT_ALIGN_SIZE) + sizeof(void *))];
+static rt_thread_t tsdb_thread = RT_NULL;
+static rt_bool_t tsdb_initialized = RT_FALSE;
+
+/* 墙钟: 以tick推算毫秒, 定期与RTC比对 */
+static rt_bool_t clock_valid = RT_FALSE;
+static rt_uint32_t clock_sync_time = 0;
+static rt_tick_t clock_sync_tick = 0;
+static rt_tick_t clock_check_tick = 0;
+static rt_uint32_t last_time = 0;
+static rt_uint16_t last_msec = 0;
+
+/* 统计 */
+static rt_uint32_t stat_frames = 0;
+static rt_uint32_t stat_dropped = 0;
+static rt_uint32_t stat_no_clock = 0;
+static rt_uint32_t stat_errors = 0;
+
+/* ========== 循环日志 ========== */
+
+static rt_uint32_t region_sector_addr(const tsdb_region_t *r, rt_uint32_t seq)
+{
+    return r->base + (seq % r->sectors) * TSDB_SECTOR_SIZE;
+}
+
+static rt_uint32_t region_slot_addr(const tsdb_region_t *r, rt_uint32_t idx)
+{
+    return region_sector_addr(r, idx / r->slots) + TSDB_HEADER_SIZE + (idx % r->slots) * r->rec_size;
+}
+
+/**
+ * @brief 当前仍保留在闪存中的最旧槽号
+ */
+static rt_uint32_t region_oldest(const tsdb_region_t *r)
+{
+    rt_uint32_t seq = r->write / r->slots;
+
+    return (seq >= r->sectors - 1) ? (seq - (r->sectors - 1)) * r->slots : 0;
+}
+
+/**
+ * @brief 读取扇区第一条记录的时间, 扇区无效时返回 TSDB_EMPTY
+ */
+static rt_uint32_t region_sector_time(const tsdb_region_t *r, rt_uint32_t seq)
+{
+    tsdb_sector_header_t header;
+
+    if (fal_partition_read(tsdb_part, region_sector_addr(r, seq), (uint8_t *)&header, sizeof(header)) < 0 ||
+        header.magic != TSDB_MAGIC || header.seq != seq) {
+        return TSDB_EMPTY;
+    }
+
+    return header.t_first;
+}
+
+/**
+ * @brief 把批量缓冲一次写入闪存, 进入新扇区时先擦除并写扇区头
+ */
+static void region_flush(tsdb_region_t *r)
+{
+    if (r->batch_count == 0) {
+        return;
+    }
+
+    if (r->write % r->slots == 0) {
+        tsdb_sector_header_t header = {TSDB_MAGIC, r->write / r->slots, r->batch[0], 0};
+        rt_uint32_t addr = region_sector_addr(r, header.seq);
+
+        if (fal_partition_erase(tsdb_part, addr, TSDB_SECTOR_SIZE) < 0 ||
+            fal_partition_write(tsdb_part, addr, (const uint8_t *)&header, sizeof(header)) < 0) {
+            stat_errors++;
+            r->batch_count = 0;
+            return;
+        }
+    }
+
+    if (fal_partition_write(tsdb_part, region_slot_addr(r, r->write), (const uint8_t *)r->batch,
+                            r->batch_count * r->rec_size) < 0) {
+        stat_errors++;
+    }
+
+    r->write += r->batch_count;
+    r->batch_count = 0;
+}
+
+/**
+ * @brief 追加一条记录: 攒满一页或到达扇区末尾时写入闪存
+ */
+static void region_append(tsdb_region_t *r, const void *record)
+{
+    if (r->batch_count == 0) {
+        r->batch_tick = rt_tick_get();
+    }
+
+    rt_memcpy((rt_uint8_t *)r->batch + r->batch_count * r->rec_size, record, r->rec_size);
+    r->batch_count++;
+
+    if ((r->batch_count + 1) * r->rec_size > PV_TSDB_PAGE_SIZE ||
+        (r->write + r->batch_count) % r->slots == 0) {
+        region_flush(r);
+    }
+}
+
+/**
+ * @brief 上电恢复: 找到最新扇区, 再二分查找其中第一个空槽
+ */
+static void region_recover(tsdb_region_t *r)
+{
+    tsdb_sector_header_t header;
+    rt_uint32_t head_seq = 0;
+    rt_bool_t found = RT_FALSE;
+
+    r->write = 0;
+    r->batch_count = 0;
+
+    for (rt_uint32_t i = 0; i < r->sectors; i++) {
+        if (fal_partition_read(tsdb_part, r->base + i * TSDB_SECTOR_SIZE, (uint8_t *)&header, sizeof(header)) >= 0 &&
+            header.magic == TSDB_MAGIC && header.seq % r->sectors == i &&
+            (!found || header.seq > head_seq)) {
+            head_seq = header.seq;
+            found = RT_TRUE;
+        }
+    }
+
+    if (!found) {
+        return;
+    }
+
+    /* 扇区头写入时至少已有一条记录, 空槽必在 [1, slots] 内 */
+    rt_uint32_t lo = 1, hi = r->slots;
+    while (lo < hi) {
+        rt_uint32_t mid = lo + (hi - lo) / 2;
+        rt_uint32_t time = TSDB_EMPTY;
+
+        fal_partition_read(tsdb_part, region_slot_addr(r, head_seq * r->slots + mid), (uint8_t *)&time, sizeof(time));
+        if (time == TSDB_EMPTY) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    r->write = head_seq * r->slots + lo;
+}
+
+/**
+ * @brief 把存储格式的记录转换为数据点
+ */
+static void region_decode(const tsdb_region_t *r, const rt_uint8_t *data, pv_tsdb_point_t *point)
+{
+    if (r->resolution == 0) {
+        const tsdb_raw_record_t *raw = (const tsdb_raw_record_t *)data;
+
+        point->time = raw->time;
+        point->count = 1;
+        point->msec = raw->msec;
+        for (int ch = 0; ch < PV_TSDB_CHANNELS; ch++) {
+            point->min[ch] = point->avg[ch] = point->max[ch] = raw->mv[ch];
+        }
+    } else {
+        rt_memcpy(point, data, sizeof(*point));
+    }
+}
+
+/**
+ * @brief 逐条回调一段连续记录中落在时间范围内的部分
+ * @return RT_FALSE 表示已越过结束时间或回调要求停止
+ */
+static rt_bool_t region_emit(const tsdb_region_t *r, const rt_uint8_t *data, rt_uint32_t count,
+                             rt_uint32_t t_from, rt_uint32_t t_to,
+                             pv_tsdb_callback_t callback, void *user_data, int *points)
+{
+    pv_tsdb_point_t point;
+
+    for (rt_uint32_t i = 0; i < count; i++, data += r->rec_size) {
+        rt_uint32_t time = *(const rt_uint32_t *)data;
+
+        if (time == TSDB_EMPTY || time > t_to) {
+            return RT_FALSE;
+        }
+        if (time < t_from) {
+            continue;
+        }
+
+        region_decode(r, data, &point);
+        (*points)++;
+        if (!callback(&point, user_data)) {
+            return RT_FALSE;
+        }
+    }
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief 按时间范围查询一层 (调用者持有锁)
+ */
+static int region_query(const tsdb_region_t *r, rt_uint32_t t_from, rt_uint32_t t_to,
+                        pv_tsdb_callback_t callback, void *user_data)
+{
+    rt_uint32_t buf[PV_TSDB_PAGE_SIZE / 4];
+    rt_uint32_t per_read = PV_TSDB_PAGE_SIZE / r->rec_size;
+    int points = 0;
+
+    if (r->write > 0) {
+        /* 二分查找 t_first <= t_from 的最后一个扇区 */
+        rt_uint32_t lo = region_oldest(r) / r->slots;
+        rt_uint32_t hi = (r->write - 1) / r->slots;
+
+        while (lo < hi) {
+            rt_uint32_t mid = lo + (hi - lo + 1) / 2;
+            rt_uint32_t t_first = region_sector_time(r, mid);
+
+            if (t_first != TSDB_EMPTY && t_first <= t_from) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+
+        for (rt_uint32_t idx = lo * r->slots; idx < r->write; ) {
+            rt_uint32_t chunk = r->slots - idx % r->slots;
+            if (chunk > per_read) {
+                chunk = per_read;
+            }
+            if (chunk > r->write - idx) {
+                chunk = r->write - idx;
+            }
+
+            if (fal_partition_read(tsdb_part, region_slot_addr(r, idx), (uint8_t *)buf, chunk * r->rec_size) < 0 ||
+                !region_emit(r, (const rt_uint8_t *)buf, chunk, t_from, t_to, callback, user_data, &points)) {
+                return points;
+            }
+            idx += chunk;
+        }
+    }
+
+    region_emit(r, (const rt_uint8_t *)r->batch, r->batch_count, t_from, t_to, callback, user_data, &points);
+
+    return points;
+}
+
+/* ========== 聚合 ========== */
+
+static void accum_emit(const tsdb_accum_t *acc, pv_tsdb_point_t *point)
+{
+    point->time = acc->bucket;
+    point->count = (acc->count > 0xFFFF) ? 0xFFFF : (rt_uint16_t)acc->count;
+    point->msec = 0;
+    for (int ch = 0; ch < PV_TSDB_CHANNELS; ch++) {
+        point->min[ch] = acc->min[ch];
+        point->avg[ch] = (rt_uint16_t)((acc->sum[ch] + acc->count / 2) / acc->count);
+        point->max[ch] = acc->max[ch];
+    }
+}
+
+/**
+ * @brief 把一个数据点并入某一层的当前时间桶; 进入新桶时输出旧桶并级联到下一层
+ * @param weight 数据点代表的原始帧数
+ */
+static void tsdb_accumulate(int tier, const pv_tsdb_point_t *point, rt_uint32_t weight)
+{
+    tsdb_region_t *r = &tsdb_regions[tier];
+    tsdb_accum_t *acc = &tsdb_accums[tier];
+    rt_uint32_t bucket = point->time - point->time % r->resolution;
+
+    if (acc->count > 0 && bucket != acc->bucket) {
+        pv_tsdb_point_t out;
+        rt_uint32_t total = acc->count;
+
+        accum_emit(acc, &out);
+        region_append(r, &out);
+        acc->count = 0;
+
+        if (tier + 1 < PV_TSDB_TIERS) {
+            tsdb_accumulate(tier + 1, &out, total);
+        }
+    }
+
+    if (acc->count == 0) {
+        acc->bucket = bucket;
+        for (int ch = 0; ch < PV_TSDB_CHANNELS; ch++) {
+            acc->sum[ch] = 0;
+            acc->min[ch] = point->min[ch];
+            acc->max[ch] = point->max[ch];
+        }
+    }
+
+    acc->count += weight;
+    for (int ch = 0; ch < PV_TSDB_CHANNELS; ch++) {
+        acc->sum[ch] += (rt_uint64_t)point->avg[ch] * weight;
+        if (point->min[ch] < acc->min[ch]) {
+            acc->min[ch] = point->min[ch];
+        }
+        if (point->max[ch] > acc->max[ch]) {
+            acc->max[ch] = point->max[ch];
+        }
+    }
+}
+
+/* ========== 采集 ========== */
+
+/**
+ * @brief 把帧时刻换算为墙钟时间; RTC未校时返回 RT_FALSE
+ *
+ * 两帧间只用tick推算, 避免每帧读RTC; 与RTC偏差超过1秒时重新对齐, 并保证时间不回退。
+ */
+static rt_bool_t tsdb_frame_time(rt_tick_t tick, rt_uint32_t *sec, rt_uint16_t *msec)
+{
+    rt_tick_t now = rt_tick_get();
+
+    if (!clock_valid || (rt_tick_t)(now - clock_check_tick) >= rt_tick_from_millisecond(TSDB_CLOCK_CHECK_MS)) {
+        rt_uint32_t rtc = (rt_uint32_t)time(RT_NULL);
+        rt_uint32_t predicted = clock_sync_time + (now - clock_sync_tick) / RT_TICK_PER_SECOND;
+
+        clock_check_tick = now;
+        if (!TSDB_TIME_VALID(rtc)) {
+            clock_valid = RT_FALSE;
+            return RT_FALSE;
+        }
+        if (!clock_valid || rtc > predicted + 1 || rtc + 1 < predicted) {
+            clock_sync_time = rtc;
+            clock_sync_tick = now;
+        }
+        clock_valid = RT_TRUE;
+    }
+
+    rt_int64_t ms = (rt_int64_t)clock_sync_time * 1000 +
+                    (rt_int64_t)(rt_int32_t)(tick - clock_sync_tick) * 1000 / RT_TICK_PER_SECOND;
+    *sec = (rt_uint32_t)(ms / 1000);
+    *msec = (rt_uint16_t)(ms % 1000);
+
+    if (*sec < last_time || (*sec == last_time && *msec < last_msec)) {
+        *sec = last_time;
+        *msec = last_msec;
+    }
+    last_time = *sec;
+    last_msec = *msec;
+
+    return RT_TRUE;
+}
+
+static void tsdb_ingest(const tsdb_frame_msg_t *msg)
+{
+    tsdb_raw_record_t raw;
+    pv_tsdb_point_t point;
+
+    if (!tsdb_frame_time(msg->tick, &raw.time, &raw.msec)) {
+        stat_no_clock++;
+        return;
+    }
+    rt_memcpy(raw.mv, msg->mv, sizeof(raw.mv));
+    raw.reserved = 0xFFFF;
+
+    rt_mutex_take(&tsdb_lock, RT_WAITING_FOREVER);
+    region_append(&tsdb_regions[PV_TSDB_TIER_RAW], &raw);
+    region_decode(&tsdb_regions[PV_TSDB_TIER_RAW], (const rt_uint8_t *)&raw, &point);
+    tsdb_accumulate(PV_TSDB_TIER_1S, &point, 1);
+    rt_mutex_release(&tsdb_lock);
+
+    stat_frames++;
+}
+
+static rt_uint16_t clamp_mv(int mv)
+{
+    return (mv < 0) ? 0 : (mv > 0xFFFF) ? 0xFFFF : (rt_uint16_t)mv;
+}
+
+/**
+ * @brief 采样回调: 只复制电压并入队, 聚合和闪存写入都在存储线程中完成
+ */
+static void tsdb_on_frame(const pv_sample_frame_t *frame, void *user_data)
+{
+    tsdb_frame_msg_t msg;
+
+    msg.tick = frame->tick;
+    msg.mv[PV_TSDB_VA1] = clamp_mv(frame->data.v_a1_mv);    // PA0
+    msg.mv[PV_TSDB_VA2] = clamp_mv(frame->data.v_a2_mv);    // PA1
+    msg.mv[PV_TSDB_VA3] = clamp_mv(frame->data.v_c1_mv);    // PA6
+    msg.mv[PV_TSDB_VB1] = clamp_mv(frame->data.v_c2_mv);    // PA7
+    msg.mv[PV_TSDB_VB2] = clamp_mv(frame->data.v_b1_mv);    // PB0
+    msg.mv[PV_TSDB_VB3] = clamp_mv(frame->data.v_b2_mv);    // PB1
+
+    if (rt_mq_send(&tsdb_mq, &msg, sizeof(msg)) != RT_EOK) {
+        stat_dropped++;
+    }
+}
+
+static void tsdb_thread_entry(void *parameter)
+{
+    tsdb_frame_msg_t msg;
+
+    while (1) {
+        if (rt_mq_recv(&tsdb_mq, &msg, sizeof(msg), rt_tick_from_millisecond(1000)) == RT_EOK) {
+            tsdb_ingest(&msg);
+        }
+
+        /* 粗粒度层攒满一页需要很久, 超时后把不足一页的数据也写入, 限制掉电损失 */
+        rt_mutex_take(&tsdb_lock, RT_WAITING_FOREVER);
+        for (int tier = 0; tier < PV_TSDB_TIERS; tier++) {
+            tsdb_region_t *r = &tsdb_regions[tier];
+
+            if (r->batch_count > 0 &&
+                (rt_tick_t)(rt_tick_get() - r->batch_tick) >= rt_tick_from_millisecond(PV_TSDB_FLUSH_MS)) {
+                region_flush(r);
+            }
+        }
+        rt_mutex_release(&tsdb_lock);
+    }
+}
+
+/* ========== 接口 ========== */
+
+rt_err_t pv_tsdb_init(void)
+{
+    rt_uint32_t base = 0;
+
+    if (tsdb_initialized) {
+        return RT_EOK;
+    }
+
+    tsdb_part = fal_partition_find(PV_TSDB_PARTITION);
+    if (tsdb_part == RT_NULL) {
+        rt_kprintf("TSDB: partition '%s' not found\n", PV_TSDB_PARTITION);
+        return -RT_ERROR;
+    }
+
+    for (int tier = 0; tier < PV_TSDB_TIERS; tier++) {
+        tsdb_region_t *r = &tsdb_regions[tier];
+
+        r->base = base;
+        r->slots = (TSDB_SECTOR_SIZE - TSDB_HEADER_SIZE) / r->rec_size;
+        base += r->sectors * TSDB_SECTOR_SIZE;
+    }
+    if (base > tsdb_part->len) {
+        rt_kprintf("TSDB: partition too small (%d KB needed)\n", base / 1024);
+        tsdb_part = RT_NULL;
+        return -RT_EFULL;
+    }
+
+    for (int tier = 0; tier < PV_TSDB_TIERS; tier++) {
+        region_recover(&tsdb_regions[tier]);
+    }
+
+    rt_mutex_init(&tsdb_lock, "tsdb", RT_IPC_FLAG_PRIO);
+    rt_mq_init(&tsdb_mq, "tsdb", tsdb_mq_pool, sizeof(tsdb_frame_msg_t), sizeof(tsdb_mq_pool), RT_IPC_FLAG_FIFO);
+
+    tsdb_thread = rt_thread_create("pv_tsdb",
+                                   tsdb_thread_entry,
+                                   RT_NULL,
+                                   TSDB_THREAD_STACK,
+                                   TSDB_THREAD_PRIORITY,
+                                   TSDB_THREAD_TICK);
+    if (tsdb_thread == RT_NULL) {
+        rt_mq_detach(&tsdb_mq);
+        rt_mutex_detach(&tsdb_lock);
+        rt_kprintf("Error: Create tsdb thread failed!\n");
+        return -RT_ENOMEM;
+    }
+
+    tsdb_initialized = RT_TRUE;
+    rt_thread_startup(tsdb_thread);
+
+    if (pv_sampler_subscribe(tsdb_on_frame, RT_NULL) != RT_EOK) {
+        rt_kprintf("TSDB: sampler subscription failed\n");
+    }
+    pv_sampler_start();
+
+    rt_kprintf("TSDB: raw %d, 1s %d, 1min %d, 1h %d records on flash\n",
+               tsdb_regions[PV_TSDB_TIER_RAW].write - region_oldest(&tsdb_regions[PV_TSDB_TIER_RAW]),
+               tsdb_regions[PV_TSDB_TIER_1S].write - region_oldest(&tsdb_regions[PV_TSDB_TIER_1S]),
+               tsdb_regions[PV_TSDB_TIER_1MIN].write - region_oldest(&tsdb_regions[PV_TSDB_TIER_1MIN]),
+               tsdb_regions[PV_TSDB_TIER_1H].write - region_oldest(&tsdb_regions[PV_TSDB_TIER_1H]));
+
+    return RT_EOK;
+}
+
+int pv_tsdb_query(pv_tsdb_tier_t tier, rt_uint32_t t_from, rt_uint32_t t_to,
+                  pv_tsdb_callback_t callback, void *user_data)
+{
+    int points;
+
+    if (!tsdb_initialized) {
+        return -RT_ERROR;
+    }
+    if ((int)tier < 0 || tier >= PV_TSDB_TIERS || callback == RT_NULL || t_from > t_to) {
+        return -RT_EINVAL;
+    }
+
+    rt_mutex_take(&tsdb_lock, RT_WAITING_FOREVER);
+    points = region_query(&tsdb_regions[tier], t_from, t_to, callback, user_data);
+    rt_mutex_release(&tsdb_lock);
+
+    return points;
+}
+
+pv_tsdb_tier_t pv_tsdb_select_tier(rt_uint32_t t_from, rt_uint32_t t_to, rt_uint32_t max_points)
+{
+    pv_tsdb_tier_t selected = PV_TSDB_TIER_1H;
+
+    if (!tsdb_initialized) {
+        return selected;
+    }
+
+    rt_mutex_take(&tsdb_lock, RT_WAITING_FOREVER);
+    for (int tier = PV_TSDB_TIER_1S; tier < PV_TSDB_TIERS; tier++) {
+        const tsdb_region_t *r = &tsdb_regions[tier];
+        rt_uint32_t oldest;
+
+        if ((t_to - t_from) / r->resolution + 1 > max_points) {
+            continue;
+        }
+
+        oldest = (r->write > 0) ? region_sector_time(r, region_oldest(r) / r->slots) : TSDB_EMPTY;
+        if (oldest != TSDB_EMPTY && oldest <= t_from) {
+            selected = (pv_tsdb_tier_t)tier;
+            break;
+        }
+    }
+    rt_mutex_release(&tsdb_lock);
+
+    return selected;
+}
+
+void pv_tsdb_flush(void)
+{
+    if (!tsdb_initialized) {
+        return;
+    }
+
+    rt_mutex_take(&tsdb_lock, RT_WAITING_FOREVER);
+    for (int tier = 0; tier < PV_TSDB_TIERS; tier++) {
+        region_flush(&tsdb_regions[tier]);
+    }
+    rt_mutex_release(&tsdb_lock);
+}
+
+/* ========== MSH命令 ========== */
+
+typedef struct {
+    int printed;
+    int limit;
+} tsdb_dump_ctx_t;
+
+static rt_bool_t tsdb_dump_point(const pv_tsdb_point_t *point, void *user_data)
+{
+    tsdb_dump_ctx_t *ctx = (tsdb_dump_ctx_t *)user_data;
+    time_t t = point->time;
+    struct tm tm;
+
+    localtime_r(&t, &tm);
+    rt_kprintf("%02d:%02d:%02d.%03d n=%-5d", tm.tm_hour, tm.tm_min, tm.tm_sec, point->msec, point->count);
+    for (int ch = 0; ch < PV_TSDB_CHANNELS; ch++) {
+        if (point->count == 1) {
+            rt_kprintf(" %5d", point->avg[ch]);
+        } else {
+            rt_kprintf(" %d/%d/%d", point->min[ch], point->avg[ch], point->max[ch]);
+        }
+    }
+    rt_kprintf("\n");
+
+    return ++ctx->printed < ctx->limit;
+}
+
+static int pv_tsdb_dump(int argc, char **argv)
+{
+    static const char *const tier_names[PV_TSDB_TIERS] = {"raw", "1s", "1min", "1h"};
+    tsdb_dump_ctx_t ctx = {0, 60};
+    pv_tsdb_tier_t tier = PV_TSDB_TIERS;
+    rt_uint32_t seconds;
+    rt_uint32_t now = (rt_uint32_t)time(RT_NULL);
+
+    if (argc < 3) {
+        rt_kprintf("Usage: pv_tsdb_dump <raw|1s|1min|1h|auto> <seconds back> [max points]\n");
+        return -1;
+    }
+
+    seconds = (rt_uint32_t)atoi(argv[2]);
+    if (argc > 3) {
+        ctx.limit = atoi(argv[3]);
+    }
+    if (ctx.limit <= 0 || seconds == 0 || seconds > now) {
+        rt_kprintf("Invalid range\n");
+        return -1;
+    }
+
+    if (rt_strcmp(argv[1], "auto") == 0) {
+        tier = pv_tsdb_select_tier(now - seconds, now, (rt_uint32_t)ctx.limit);
+    } else {
+        for (int i = 0; i < PV_TSDB_TIERS; i++) {
+            if (rt_strcmp(argv[1], tier_names[i]) == 0) {
+                tier = (pv_tsdb_tier_t)i;
+            }
+        }
+    }
+    if (tier == PV_TSDB_TIERS) {
+        rt_kprintf("Unknown tier: %s\n", argv[1]);
+        return -1;
+    }
+
+    rt_kprintf("Tier %s, last %d s (va1 va2 va3 vb1 vb2 vb3, mV, min/avg/max)\n", tier_names[tier], seconds);
+    int points = pv_tsdb_query(tier, now - seconds, now, tsdb_dump_point, &ctx);
+    if (points < 0) {
+        rt_kprintf("Query failed: %d\n", points);
+        return -1;
+    }
+    rt_kprintf("%d points\n", ctx.printed);
+
+    return 0;
+}
+MSH_CMD_EXPORT(pv_tsdb_dump, dump PV time-series window: pv_tsdb_dump <tier|auto> <seconds> [max]);
+
+static int pv_tsdb_status(void)
+{
+    rt_kprintf("\n=== PV Time-Series Store ===\n");
+    rt_kprintf("Partition: %s (%s)\n", PV_TSDB_PARTITION, tsdb_initialized ? "open" : "not initialized");
+    if (!tsdb_initialized) {
+        return 0;
+    }
+
+    rt_mutex_take(&tsdb_lock, RT_WAITING_FOREVER);
+    for (int tier = 0; tier < PV_TSDB_TIERS; tier++) {
+        const tsdb_region_t *r = &tsdb_regions[tier];
+
+        rt_kprintf("  %-5s %3d sectors x %3d slots, %6d on flash, %2d batched\n",
+                   r->name, r->sectors, r->slots, r->write - region_oldest(r), r->batch_count);
+    }
+    rt_mutex_release(&tsdb_lock);
+
+    rt_kprintf("Frames stored: %d, queue drops: %d, no clock: %d, flash errors: %d\n",
+               stat_frames, stat_dropped, stat_no_clock, stat_errors);
+
+    return 0;
+}
+MSH_CMD_EXPORT(pv_tsdb_status, show PV time-series store status);
+
+#else
+
+rt_err_t pv_tsdb_init(void)
+{
+    return -RT_ENOSYS;
+}
+
+int pv_tsdb_query(pv_tsdb_tier_t tier, rt_uint32_t t_from, rt_uint32_t t_to,
+                  pv_tsdb_callback_t callback, void *user_data)
+{
+    return -RT_ENOSYS;
+}
+
+pv_tsdb_tier_t pv_tsdb_select_tier(rt_uint32_t t_from, rt_uint32_t t_to, rt_uint32_t max_points)
+{
+    return PV_TSDB_TIER_1H;
+}
+
+void pv_tsdb_flush(void)
+{
+}
+
+#endif /* RT_USING_FAL && PV_ENABLE_LOCAL_STORAGE */
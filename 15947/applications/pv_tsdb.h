@@ -0,0 +1,75 @@
+/*
+ * pv_tsdb.h
+ *
+ * 光伏电压本地时序存储
+ * 原始采样帧按全速率写入闪存循环日志, 同时增量维护 1秒/1分钟/1小时 三层
+ * min/avg/max 聚合数据。长时间范围的查询直接读取粗粒度层, 不扫描原始帧。
+ */
+
+#ifndef PV_TSDB_H
+#define PV_TSDB_H
+
+#include <rtthread.h>
+
+// 存储层
+typedef enum {
+    PV_TSDB_TIER_RAW = 0,       // 原始帧
+    PV_TSDB_TIER_1S,            // 1秒聚合
+    PV_TSDB_TIER_1MIN,          // 1分钟聚合
+    PV_TSDB_TIER_1H,            // 1小时聚合
+    PV_TSDB_TIERS
+} pv_tsdb_tier_t;
+
+// 电压通道 (与遥测记录顺序一致)
+enum {
+    PV_TSDB_VA1 = 0,
+    PV_TSDB_VA2,
+    PV_TSDB_VA3,
+    PV_TSDB_VB1,
+    PV_TSDB_VB2,
+    PV_TSDB_VB3,
+    PV_TSDB_CHANNELS
+};
+
+// 一个数据点 (44字节, 同时也是聚合层在闪存中的存储格式)
+typedef struct {
+    rt_uint32_t time;                           // UNIX时间 (s), 聚合层为时间桶起点
+    rt_uint16_t count;                          // 聚合的原始帧数 (原始层为1, 超过65535时饱和)
+    rt_uint16_t msec;                           // 原始层: 秒内毫秒; 聚合层为0
+    rt_uint16_t min[PV_TSDB_CHANNELS];          // 节点电压 (mV)
+    rt_uint16_t avg[PV_TSDB_CHANNELS];
+    rt_uint16_t max[PV_TSDB_CHANNELS];
+} pv_tsdb_point_t;
+
+/**
+ * @brief 查询回调, 在持有存储锁时调用, 不能再调用 pv_tsdb 接口
+ * @return RT_TRUE 继续, RT_FALSE 停止查询
+ */
+typedef rt_bool_t (*pv_tsdb_callback_t)(const pv_tsdb_point_t *point, void *user_data);
+
+/**
+ * @brief 打开分区并恢复各层写位置, 订阅采样服务并启动存储线程
+ * @return RT_EOK 成功, -RT_ENOSYS 未启用 BSP_USING_PV_TSDB (或FAL), 其他失败
+ */
+rt_err_t pv_tsdb_init(void);
+
+/**
+ * @brief 按时间范围查询某一层 (含尚在RAM批量缓冲中的数据)
+ * @param t_from 起始时间 (含)
+ * @param t_to 结束时间 (含)
+ * @return 回调的数据点个数, 负数为错误码
+ */
+int pv_tsdb_query(pv_tsdb_tier_t tier, rt_uint32_t t_from, rt_uint32_t t_to,
+                  pv_tsdb_callback_t callback, void *user_data);
+
+/**
+ * @brief 为时间范围选择最细的聚合层: 点数不超过 max_points 且数据仍覆盖起始时间
+ */
+pv_tsdb_tier_t pv_tsdb_select_tier(rt_uint32_t t_from, rt_uint32_t t_to, rt_uint32_t max_points);
+
+/**
+ * @brief 立即把各层批量缓冲写入闪存
+ */
+void pv_tsdb_flush(void);
+
+#endif // PV_TSDB_H
@@ -4,6 +4,7 @@
 #include <rtthread.h>
 #include <rtdevice.h>
 #include <at.h>
+#include "pv_sampler.h"
 
 /**
  * @brief 验证UART1是否已成功释放
@@ -177,17 +178,23 @@ int verify_adc_still_works(void)
     /* 快速测试一个ADC通道 */
     rt_kprintf("📊 Testing ADC channel 0 (PA0)...\n");
     
+    rt_uint32_t adc_value = 0;
     rt_err_t result = rt_adc_enable(adc1_dev, 0);
+    if (result == -RT_EBUSY) {
+        /* ADC1正被采样服务的扫描组占用, 改读其最新帧 */
+        rt_kprintf("• ADC1 is scanning for pv_sampler, reading its latest frame\n");
+        result = pv_sampler_get_raw(0, &adc_value);
+    } else if (result == RT_EOK) {
+        result = rt_adc_convert(adc1_dev, 0, &adc_value);
+        rt_adc_disable(adc1_dev, 0);
+    }
     if (result != RT_EOK) {
-        rt_kprintf("❌ Failed to enable ADC channel 0\n");
+        rt_kprintf("❌ Failed to read ADC channel 0 (%d)\n", result);
         return -1;
     }
     
-    rt_uint32_t adc_value = rt_adc_read(adc1_dev, 0);
     rt_uint32_t voltage = (adc_value * 3300) / 65535;
     
-    rt_adc_disable(adc1_dev, 0);
-    
     rt_kprintf("✅ ADC reading successful!\n");
     rt_kprintf("• Raw value: %d\n", adc_value);
     rt_kprintf("• Voltage: %d mV\n", voltage);
@@ -40,6 +40,18 @@ extern struct fal_flash_dev nor_flash0;
 }
 /* ====================== Partition Configuration ========================== */
 #ifdef FAL_PART_HAS_TABLE_CFG
+#ifdef BSP_USING_PV_TSDB
+/* "pv_tsdb" is the last 2MB of "filesystem", the littlefs on "filesystem" is formatted again */
+#define FAL_PART_TABLE                                                                     \
+{                                                                                          \
+    {FAL_PART_MAGIC_WORD, "wifi_image", NOR_FLASH_DEV_NAME,           0,     512*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "bt_image",   NOR_FLASH_DEV_NAME,    512*1024,     512*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "download",   NOR_FLASH_DEV_NAME,   1024*1024,  2*1024*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "easyflash",  NOR_FLASH_DEV_NAME, 3*1024*1024,  1*1024*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "filesystem", NOR_FLASH_DEV_NAME, 4*1024*1024, 10*1024*1024, 0}, \
+    {FAL_PART_MAGIC_WORD, "pv_tsdb",    NOR_FLASH_DEV_NAME, 14*1024*1024, 2*1024*1024, 0}, \
+}
+#else
 #define FAL_PART_TABLE                                                                     \
 {                                                                                          \
     {FAL_PART_MAGIC_WORD, "wifi_image", NOR_FLASH_DEV_NAME,           0,     512*1024, 0}, \
@@ -48,6 +60,7 @@ extern struct fal_flash_dev nor_flash0;
     {FAL_PART_MAGIC_WORD, "easyflash",  NOR_FLASH_DEV_NAME, 3*1024*1024,  1*1024*1024, 0}, \
     {FAL_PART_MAGIC_WORD, "filesystem", NOR_FLASH_DEV_NAME, 4*1024*1024, 12*1024*1024, 0}, \
 }
+#endif /* BSP_USING_PV_TSDB */
 #endif /* FAL_PART_HAS_TABLE_CFG */
 
 #endif /* _FAL_CFG_H_ */
@@ -16,6 +16,9 @@
 
 #if defined(BSP_USING_ADC1) || defined(BSP_USING_ADC2) || defined(BSP_USING_ADC3)
 #include "drv_config.h"
+#ifdef BSP_ADC_USING_DMA
+#include "drv_dma.h"
+#endif
 
 //#define DRV_DEBUG
 #define LOG_TAG             "drv.adc"
@@ -40,16 +43,143 @@ struct stm32_adc
 {
     ADC_HandleTypeDef ADC_Handler;
     struct rt_adc_device stm32_adc_device;
+    rt_bool_t calibrated;
+#if defined(SOC_SERIES_STM32H7)
+    struct rt_adc_oversampling oversampling;
+#endif
+
+#ifdef BSP_ADC_USING_DMA
+    struct dma_config *dma_config;
+    DMA_HandleTypeDef dma_handle;
+    struct rt_adc_scan_config scan;
+    rt_bool_t scanning;
+#endif
 };
 
 static struct stm32_adc stm32_adc_obj[sizeof(adc_config) / sizeof(adc_config[0])];
 
+#ifdef BSP_ADC_USING_DMA
+static struct dma_config adc_dma_config[] =
+{
+#ifdef BSP_USING_ADC1
+#ifdef BSP_ADC1_USING_DMA
+    ADC1_DMA_CONFIG,
+#else
+    {0},
+#endif
+#endif
+
+#ifdef BSP_USING_ADC2
+#ifdef BSP_ADC2_USING_DMA
+    ADC2_DMA_CONFIG,
+#else
+    {0},
+#endif
+#endif
+
+#ifdef BSP_USING_ADC3
+#ifdef BSP_ADC3_USING_DMA
+    ADC3_DMA_CONFIG,
+#else
+    {0},
+#endif
+#endif
+};
+#endif /* BSP_ADC_USING_DMA */
+
+#if defined(SOC_SERIES_STM32H7)
+/* the calibration only has to run once after power on, not before every conversion */
+static rt_err_t stm32_adc_calibrate(struct stm32_adc *adc)
+{
+    if (adc->calibrated)
+    {
+        return RT_EOK;
+    }
+
+    /* Run the ADC linear calibration in single-ended mode */
+    if (HAL_ADCEx_Calibration_Start(&adc->ADC_Handler, ADC_CALIB_OFFSET_LINEARITY, ADC_SINGLE_ENDED) != HAL_OK)
+    {
+        LOG_E("ADC open linear calibration error!\n");
+        /* Calibration Error */
+        return -RT_ERROR;
+    }
+    adc->calibrated = RT_TRUE;
+
+    return RT_EOK;
+}
+
+/* fold the requested oversampling into hadc->Init, applied by the next HAL_ADC_Init() */
+static void stm32_adc_oversampling_init(struct stm32_adc *adc)
+{
+    ADC_InitTypeDef *init = &adc->ADC_Handler.Init;
+
+    if (adc->oversampling.ratio <= 1 && adc->oversampling.right_shift == 0)
+    {
+        init->OversamplingMode = DISABLE;
+        return;
+    }
+
+    init->OversamplingMode                     = ENABLE;
+    init->Oversampling.Ratio                   = adc->oversampling.ratio;
+    init->Oversampling.RightBitShift           = (rt_uint32_t)adc->oversampling.right_shift << ADC_CFGR2_OVSS_Pos;
+    /* all conversions of one result run back to back on a single trigger */
+    init->Oversampling.TriggeredMode           = ADC_TRIGGEREDMODE_SINGLE_TRIGGER;
+    init->Oversampling.OversamplingStopReset   = ADC_REGOVERSAMPLING_CONTINUED_MODE;
+}
+
+static rt_err_t stm32_adc_oversampling(struct rt_adc_device *device, const struct rt_adc_oversampling *config)
+{
+    struct stm32_adc *adc;
+    ADC_HandleTypeDef *hadc;
+
+    RT_ASSERT(device != RT_NULL);
+    adc = rt_container_of(device, struct stm32_adc, stm32_adc_device);
+    hadc = &adc->ADC_Handler;
+
+    /* the ratio field is 10 bits wide and the shift field 4 bits */
+    if (config->ratio > 1024 || config->right_shift > 11)
+    {
+        return -RT_EINVAL;
+    }
+#ifdef BSP_ADC_USING_DMA
+    if (adc->scanning)
+    {
+        return -RT_EBUSY;
+    }
+#endif
+
+    /* CFGR2 can only be written with the ADC disabled */
+    ADC_Disable(hadc);
+
+    adc->oversampling = *config;
+    stm32_adc_oversampling_init(adc);
+    if (HAL_ADC_Init(hadc) != HAL_OK)
+    {
+        LOG_E("%s oversampling init failed", device->parent.parent.name);
+        return -RT_ERROR;
+    }
+
+    LOG_D("%s oversampling ratio %d, shift %d", device->parent.parent.name,
+          config->ratio, config->right_shift);
+
+    return RT_EOK;
+}
+#endif
+
 static rt_err_t stm32_adc_enabled(struct rt_adc_device *device, rt_uint32_t channel, rt_bool_t enabled)
 {
     ADC_HandleTypeDef *stm32_adc_handler;
     RT_ASSERT(device != RT_NULL);
     stm32_adc_handler = device->parent.user_data;
 
+#ifdef BSP_ADC_USING_DMA
+    if (rt_container_of(device, struct stm32_adc, stm32_adc_device)->scanning)
+    {
+        /* a disable would stop the running scan group */
+        return -RT_EBUSY;
+    }
+#endif
+
     if (enabled)
     {
 #if defined(SOC_SERIES_STM32L4) || defined(SOC_SERIES_STM32G0) || defined(SOC_SERIES_STM32H7)
@@ -147,17 +277,9 @@ static rt_uint32_t stm32_adc_get_channel(rt_uint32_t channel)
     return stm32_channel;
 }
 
-static rt_err_t stm32_get_adc_value(struct rt_adc_device *device, rt_uint32_t channel, rt_uint32_t *value)
+static rt_err_t stm32_adc_channel_conf(ADC_ChannelConfTypeDef *ADC_ChanConf, rt_uint32_t channel, rt_uint32_t rank)
 {
-    ADC_ChannelConfTypeDef ADC_ChanConf;
-    ADC_HandleTypeDef *stm32_adc_handler;
-
-    RT_ASSERT(device != RT_NULL);
-    RT_ASSERT(value != RT_NULL);
-
-    stm32_adc_handler = device->parent.user_data;
-
-    rt_memset(&ADC_ChanConf, 0, sizeof(ADC_ChanConf));
+    rt_memset(ADC_ChanConf, 0, sizeof(*ADC_ChanConf));
 
 #ifndef ADC_CHANNEL_16
     if (channel == 16)
@@ -179,7 +301,7 @@ static rt_err_t stm32_get_adc_value(struct rt_adc_device *device, rt_uint32_t ch
 #endif
     {
         /* set stm32 ADC channel */
-        ADC_ChanConf.Channel =  stm32_adc_get_channel(channel);
+        ADC_ChanConf->Channel =  stm32_adc_get_channel(channel);
     }
     else
     {
@@ -192,40 +314,63 @@ static rt_err_t stm32_get_adc_value(struct rt_adc_device *device, rt_uint32_t ch
 #endif
         return -RT_ERROR;
     }
-#if defined(SOC_SERIES_STM32H7)
-    ADC_ChanConf.Rank = ADC_REGULAR_RANK_1;
-#else
-    ADC_ChanConf.Rank = 1;
-#endif
+    ADC_ChanConf->Rank = rank;
 
 #if defined(SOC_SERIES_STM32F0)
-    ADC_ChanConf.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
+    ADC_ChanConf->SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
 #elif defined(SOC_SERIES_STM32F1)
-    ADC_ChanConf.SamplingTime = ADC_SAMPLETIME_55CYCLES_5;
+    ADC_ChanConf->SamplingTime = ADC_SAMPLETIME_55CYCLES_5;
 #elif defined(SOC_SERIES_STM32F2) || defined(SOC_SERIES_STM32F4) || defined(SOC_SERIES_STM32F7)
-    ADC_ChanConf.SamplingTime = ADC_SAMPLETIME_112CYCLES;
+    ADC_ChanConf->SamplingTime = ADC_SAMPLETIME_112CYCLES;
 #elif defined(SOC_SERIES_STM32L4)
-    ADC_ChanConf.SamplingTime = ADC_SAMPLETIME_247CYCLES_5;
+    ADC_ChanConf->SamplingTime = ADC_SAMPLETIME_247CYCLES_5;
 #elif defined(SOC_SERIES_STM32H7)
-    ADC_ChanConf.SamplingTime = ADC_SAMPLETIME_1CYCLE_5;
+    ADC_ChanConf->SamplingTime = ADC_SAMPLETIME_1CYCLE_5;
 #endif
 #if defined(SOC_SERIES_STM32F2) || defined(SOC_SERIES_STM32F4) || defined(SOC_SERIES_STM32F7) || defined(SOC_SERIES_STM32L4) || defined(SOC_SERIES_STM32H7)
-    ADC_ChanConf.Offset = 0;
+    ADC_ChanConf->Offset = 0;
 #endif
 #ifdef SOC_SERIES_STM32L4
-    ADC_ChanConf.OffsetNumber = ADC_OFFSET_NONE;
-    ADC_ChanConf.SingleDiff = LL_ADC_SINGLE_ENDED;
+    ADC_ChanConf->OffsetNumber = ADC_OFFSET_NONE;
+    ADC_ChanConf->SingleDiff = LL_ADC_SINGLE_ENDED;
 #elif defined(SOC_SERIES_STM32H7)
-    ADC_ChanConf.OffsetNumber = ADC_OFFSET_NONE;  /* ADC channel affected to offset number */
-    ADC_ChanConf.SingleDiff   = ADC_SINGLE_ENDED; /* ADC channel differential mode */
+    ADC_ChanConf->OffsetNumber = ADC_OFFSET_NONE;  /* ADC channel affected to offset number */
+    ADC_ChanConf->SingleDiff   = ADC_SINGLE_ENDED; /* ADC channel differential mode */
+#endif
+
+    return RT_EOK;
+}
+
+static rt_err_t stm32_get_adc_value(struct rt_adc_device *device, rt_uint32_t channel, rt_uint32_t *value)
+{
+    ADC_ChannelConfTypeDef ADC_ChanConf;
+    ADC_HandleTypeDef *stm32_adc_handler;
+
+    RT_ASSERT(device != RT_NULL);
+    RT_ASSERT(value != RT_NULL);
+
+    stm32_adc_handler = device->parent.user_data;
+
+#ifdef BSP_ADC_USING_DMA
+    if (rt_container_of(device, struct stm32_adc, stm32_adc_device)->scanning)
+    {
+        /* the sequencer belongs to the running scan group */
+        return -RT_EBUSY;
+    }
 #endif
 
 #if defined(SOC_SERIES_STM32H7)
-      /* Run the ADC linear calibration in single-ended mode */
-    if (HAL_ADCEx_Calibration_Start(stm32_adc_handler, ADC_CALIB_OFFSET_LINEARITY, ADC_SINGLE_ENDED) != HAL_OK)
+    if (stm32_adc_channel_conf(&ADC_ChanConf, channel, ADC_REGULAR_RANK_1) != RT_EOK)
+#else
+    if (stm32_adc_channel_conf(&ADC_ChanConf, channel, 1) != RT_EOK)
+#endif
+    {
+        return -RT_ERROR;
+    }
+
+#if defined(SOC_SERIES_STM32H7)
+    if (stm32_adc_calibrate(rt_container_of(device, struct stm32_adc, stm32_adc_device)) != RT_EOK)
     {
-        LOG_E("ADC open linear calibration error!\n");
-        /* Calibration Error */
         return -RT_ERROR;
     }
 #endif
@@ -244,10 +389,248 @@ static rt_err_t stm32_get_adc_value(struct rt_adc_device *device, rt_uint32_t ch
     return RT_EOK;
 }
 
+#ifdef BSP_ADC_USING_DMA
+static const rt_uint32_t stm32_adc_regular_rank[] =
+{
+    ADC_REGULAR_RANK_1,  ADC_REGULAR_RANK_2,  ADC_REGULAR_RANK_3,  ADC_REGULAR_RANK_4,
+    ADC_REGULAR_RANK_5,  ADC_REGULAR_RANK_6,  ADC_REGULAR_RANK_7,  ADC_REGULAR_RANK_8,
+    ADC_REGULAR_RANK_9,  ADC_REGULAR_RANK_10, ADC_REGULAR_RANK_11, ADC_REGULAR_RANK_12,
+    ADC_REGULAR_RANK_13, ADC_REGULAR_RANK_14, ADC_REGULAR_RANK_15, ADC_REGULAR_RANK_16,
+};
+
+static void stm32_adc_dma_init(struct stm32_adc *adc)
+{
+    DMA_HandleTypeDef *DMA_Handle = &adc->dma_handle;
+    struct dma_config *dma_config = adc->dma_config;
+
+    {
+        rt_uint32_t tmpreg = 0x00U;
+
+        /* enable DMA clock && Delay after an RCC peripheral clock enabling*/
+        SET_BIT(RCC->AHB1ENR, dma_config->dma_rcc);
+        tmpreg = READ_BIT(RCC->AHB1ENR, dma_config->dma_rcc);
+        UNUSED(tmpreg);   /* To avoid compiler warnings */
+    }
+
+    DMA_Handle->Instance                 = dma_config->Instance;
+    DMA_Handle->Init.Request             = dma_config->request;
+    DMA_Handle->Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    DMA_Handle->Init.PeriphInc           = DMA_PINC_DISABLE;
+    DMA_Handle->Init.MemInc              = DMA_MINC_ENABLE;
+    DMA_Handle->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    DMA_Handle->Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    DMA_Handle->Init.Mode                = DMA_CIRCULAR;
+    DMA_Handle->Init.Priority            = DMA_PRIORITY_HIGH;
+    DMA_Handle->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+
+    if (HAL_DMA_DeInit(DMA_Handle) != HAL_OK)
+    {
+        RT_ASSERT(0);
+    }
+
+    if (HAL_DMA_Init(DMA_Handle) != HAL_OK)
+    {
+        RT_ASSERT(0);
+    }
+
+    __HAL_LINKDMA(&adc->ADC_Handler, DMA_Handle, adc->dma_handle);
+
+    HAL_NVIC_SetPriority(dma_config->dma_irq, 1, 0);
+    HAL_NVIC_EnableIRQ(dma_config->dma_irq);
+}
+
+static rt_err_t stm32_adc_scan_config(struct rt_adc_device *device, const struct rt_adc_scan_config *config)
+{
+    ADC_ChannelConfTypeDef ADC_ChanConf;
+    struct stm32_adc *adc;
+    ADC_HandleTypeDef *hadc;
+    int i;
+
+    RT_ASSERT(device != RT_NULL);
+    adc = rt_container_of(device, struct stm32_adc, stm32_adc_device);
+    hadc = &adc->ADC_Handler;
+
+    if (adc->dma_config == RT_NULL || adc->dma_config->Instance == RT_NULL)
+    {
+        return -RT_ENOSYS;
+    }
+    if (adc->scanning)
+    {
+        return -RT_EBUSY;
+    }
+    if (config->channel_count > sizeof(stm32_adc_regular_rank) / sizeof(stm32_adc_regular_rank[0]))
+    {
+        LOG_E("scan group supports at most %d channels", sizeof(stm32_adc_regular_rank) / sizeof(stm32_adc_regular_rank[0]));
+        return -RT_EINVAL;
+    }
+
+    /* the sequencer can only be reprogrammed with the ADC disabled */
+    ADC_Disable(hadc);
+
+    hadc->Init.ScanConvMode             = ADC_SCAN_ENABLE;
+    hadc->Init.NbrOfConversion          = config->channel_count;
+    hadc->Init.EOCSelection             = ADC_EOC_SEQ_CONV;
+    hadc->Init.DiscontinuousConvMode    = DISABLE;
+    hadc->Init.ConversionDataManagement = ADC_CONVERSIONDATA_DMA_CIRCULAR;
+    hadc->Init.Overrun                  = ADC_OVR_DATA_OVERWRITTEN;
+    if (config->trigger == RT_ADC_SCAN_TRIGGER_CONTINUOUS)
+    {
+        hadc->Init.ContinuousConvMode   = ENABLE;
+        hadc->Init.ExternalTrigConv     = ADC_SOFTWARE_START;
+        hadc->Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
+    }
+    else
+    {
+        /* one sequence per trigger event, e.g. ADC_EXTERNALTRIG_T3_TRGO */
+        hadc->Init.ContinuousConvMode   = DISABLE;
+        hadc->Init.ExternalTrigConv     = config->trigger;
+        hadc->Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    }
+    stm32_adc_oversampling_init(adc);
+
+    if (HAL_ADC_Init(hadc) != HAL_OK)
+    {
+        LOG_E("%s scan init failed", device->parent.parent.name);
+        return -RT_ERROR;
+    }
+
+    for (i = 0; i < config->channel_count; i++)
+    {
+        if (stm32_adc_channel_conf(&ADC_ChanConf, config->channels[i], stm32_adc_regular_rank[i]) != RT_EOK)
+        {
+            return -RT_ERROR;
+        }
+        if (HAL_ADC_ConfigChannel(hadc, &ADC_ChanConf) != HAL_OK)
+        {
+            LOG_E("%s scan channel %d config failed", device->parent.parent.name, config->channels[i]);
+            return -RT_ERROR;
+        }
+    }
+
+    if (stm32_adc_calibrate(adc) != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    stm32_adc_dma_init(adc);
+    adc->scan = *config;
+
+    LOG_D("%s scan group: %d channels, %d frames per half", device->parent.parent.name,
+          config->channel_count, config->frames_per_half);
+
+    return RT_EOK;
+}
+
+static rt_err_t stm32_adc_scan_start(struct rt_adc_device *device)
+{
+    struct stm32_adc *adc;
+    rt_uint32_t length;
+
+    RT_ASSERT(device != RT_NULL);
+    adc = rt_container_of(device, struct stm32_adc, stm32_adc_device);
+
+    if (adc->scan.buffer == RT_NULL)
+    {
+        LOG_E("%s scan group not configured", device->parent.parent.name);
+        return -RT_ERROR;
+    }
+    if (adc->scanning)
+    {
+        return RT_EOK;
+    }
+
+    length = 2 * adc->scan.frames_per_half * adc->scan.channel_count;
+    adc->scanning = RT_TRUE;
+    if (HAL_ADC_Start_DMA(&adc->ADC_Handler, (uint32_t *)adc->scan.buffer, length) != HAL_OK)
+    {
+        adc->scanning = RT_FALSE;
+        LOG_E("%s scan start failed", device->parent.parent.name);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t stm32_adc_scan_stop(struct rt_adc_device *device)
+{
+    struct stm32_adc *adc;
+    ADC_HandleTypeDef *hadc;
+
+    RT_ASSERT(device != RT_NULL);
+    adc = rt_container_of(device, struct stm32_adc, stm32_adc_device);
+    hadc = &adc->ADC_Handler;
+
+    if (!adc->scanning)
+    {
+        return RT_EOK;
+    }
+
+    HAL_ADC_Stop_DMA(hadc);
+    adc->scanning = RT_FALSE;
+
+    /* restore the single conversion setup used by rt_adc_read() */
+    hadc->Init = adc_config[adc - stm32_adc_obj].Init;
+    stm32_adc_oversampling_init(adc);
+    if (HAL_ADC_Init(hadc) != HAL_OK)
+    {
+        LOG_E("%s restore init failed", device->parent.parent.name);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+static void stm32_adc_scan_done(ADC_HandleTypeDef *hadc, rt_bool_t second_half)
+{
+    struct stm32_adc *adc = rt_container_of(hadc, struct stm32_adc, ADC_Handler);
+    rt_size_t half_samples = adc->scan.frames_per_half * adc->scan.channel_count;
+    rt_uint16_t *frames = adc->scan.buffer + (second_half ? half_samples : 0);
+
+    /* DMA wrote behind the D-cache, drop any stale lines of this half */
+    SCB_InvalidateDCache_by_Addr((uint32_t *)frames, half_samples * sizeof(rt_uint16_t));
+
+    if (adc->scan.frame_done != RT_NULL)
+    {
+        adc->scan.frame_done(&adc->stm32_adc_device, frames, adc->scan.frames_per_half, adc->scan.user_data);
+    }
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    stm32_adc_scan_done(hadc, RT_FALSE);
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    stm32_adc_scan_done(hadc, RT_TRUE);
+}
+
+#if defined(BSP_ADC1_USING_DMA)
+void ADC1_DMA_IRQHandler(void)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    HAL_DMA_IRQHandler(&stm32_adc_obj[0].dma_handle);
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+#endif /* BSP_ADC1_USING_DMA */
+#endif /* BSP_ADC_USING_DMA */
+
 static const struct rt_adc_ops stm_adc_ops =
 {
     .enabled = stm32_adc_enabled,
     .convert = stm32_get_adc_value,
+#ifdef BSP_ADC_USING_DMA
+    .scan_config = stm32_adc_scan_config,
+    .scan_start = stm32_adc_scan_start,
+    .scan_stop = stm32_adc_scan_stop,
+#endif
+#if defined(SOC_SERIES_STM32H7)
+    .oversampling = stm32_adc_oversampling,
+#endif
 };
 
 static int stm32_adc_init(void)
@@ -262,6 +645,9 @@ static int stm32_adc_init(void)
         /* ADC init */
         name_buf[3] = '0';
         stm32_adc_obj[i].ADC_Handler = adc_config[i];
+#ifdef BSP_ADC_USING_DMA
+        stm32_adc_obj[i].dma_config = &adc_dma_config[i];
+#endif
 #if defined(ADC1)
         if (stm32_adc_obj[i].ADC_Handler.Instance == ADC1)
         {
@@ -43,6 +43,10 @@ void SysTick_Handler(void)
 
     HAL_IncTick();
     rt_tick_increase();
+#ifdef RT_USING_TICKLESS
+    extern void stm32_tickless_systick(void);
+    stm32_tickless_systick();
+#endif
 
     /* leave interrupt */
     rt_interrupt_leave();
@@ -15,8 +15,8 @@
 #include <rtdevice.h>
 #include <string.h>
 
-#if !defined(RT_USING_MEMHEAP_AS_HEAP)
-    #error "Please define RT_USING_MEMHEAP_AS_HEAP"
+#if !defined(RT_USING_MEMHEAP_AS_HEAP) && !defined(RT_USING_TLSF_AS_HEAP)
+    #error "Please define RT_USING_MEMHEAP_AS_HEAP or RT_USING_TLSF_AS_HEAP"
 #endif
 
 #define DRV_DEBUG
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-12-04     zylx         first version
+ * 2026-10-16     RT-Thread    add SDRAM to the TLSF system heap
  */
 
 #include <board.h>
@@ -182,6 +183,9 @@ static int SDRAM_Init(void)
 #ifdef RT_USING_MEMHEAP_AS_HEAP
         /* If RT_USING_MEMHEAP_AS_HEAP is enabled, SDRAM is initialized to the heap */
         rt_memheap_init(&system_heap, "sdram", (void *)SDRAM_BANK_ADDR, SDRAM_SIZE);
+#elif defined(RT_USING_TLSF_AS_HEAP)
+        /* If RT_USING_TLSF_AS_HEAP is enabled, SDRAM is a region of the system heap */
+        rt_system_heap_add((void *)SDRAM_BANK_ADDR, (void *)(SDRAM_BANK_ADDR + SDRAM_SIZE));
 #endif
     }
 
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The clock of the tickless idle. LPTIM1 counts the 32.768 kHz LSE crystal of the board,
+ * without prescaler, from 0 to 0xFFFF and around again in 2 s, and its compare match is the
+ * alarm. The periodic tick is SysTick. After a sleep, SysTick first counts what is left of
+ * the current tick, and SysTick_Handler gives it back the whole tick.
+ */
+
+#include <board.h>
+#include <rthw.h>
+
+#ifdef RT_USING_TICKLESS
+
+#include <drivers/tickless.h>
+
+#define LPTIM_FREQ      32768
+#define LPTIM_MASK      0xFFFF
+
+static LPTIM_HandleTypeDef LptimHandle;
+/* the SysTick cycles of a tick */
+static rt_uint32_t systick_period;
+/* the cycles of the current tick gone before SysTick started again, 0 for a whole tick */
+static rt_uint32_t systick_phase;
+
+void LPTIM1_IRQHandler(void)
+{
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    __HAL_LPTIM_CLEAR_FLAG(&LptimHandle, LPTIM_FLAG_CMPM);
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+/**
+ * This function is called by SysTick_Handler, it gives back the whole tick after a sleep
+ */
+void stm32_tickless_systick(void)
+{
+    if (systick_phase)
+    {
+        SysTick->LOAD = systick_period - 1;
+        SysTick->VAL = 0;
+        systick_phase = 0;
+    }
+}
+
+static rt_uint32_t stm32_tickless_counter(void)
+{
+    rt_uint32_t count;
+
+    /* the counter runs on the LSE, read it until two reads agree */
+    do
+    {
+        count = LptimHandle.Instance->CNT;
+    }
+    while (count != LptimHandle.Instance->CNT);
+
+    return count;
+}
+
+static rt_err_t stm32_tickless_alarm(rt_uint32_t value)
+{
+    __HAL_LPTIM_CLEAR_FLAG(&LptimHandle, LPTIM_FLAG_CMPOK | LPTIM_FLAG_CMPM);
+    __HAL_LPTIM_COMPARE_SET(&LptimHandle, value);
+    /* the write takes a few LSE cycles */
+    while (!__HAL_LPTIM_GET_FLAG(&LptimHandle, LPTIM_FLAG_CMPOK));
+
+    /* the tickless idle sleeps at most 7/8 of the counter, a value just behind it is past */
+    if (!__HAL_LPTIM_GET_FLAG(&LptimHandle, LPTIM_FLAG_CMPM) &&
+        ((stm32_tickless_counter() - value) & LPTIM_MASK) < (LPTIM_MASK >> 3))
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    return RT_EOK;
+}
+
+static rt_uint32_t stm32_tickless_tick_stop(void)
+{
+    rt_uint32_t cycles;
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    cycles = SysTick->LOAD - SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* the tick is due, it goes into the sleep */
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+        cycles += systick_period;
+    }
+    else
+    {
+        cycles += systick_phase;
+    }
+    systick_phase = 0;
+
+    /* LPTIM_FREQ in a tick */
+    return (rt_uint32_t)(((rt_uint64_t)cycles * LPTIM_FREQ + systick_period / 2) / systick_period);
+}
+
+static void stm32_tickless_tick_start(rt_uint32_t phase)
+{
+    rt_uint32_t cycles;
+
+    cycles = (rt_uint32_t)(((rt_uint64_t)phase * systick_period + LPTIM_FREQ / 2) / LPTIM_FREQ);
+    if (cycles >= systick_period)
+    {
+        cycles = systick_period - 1;
+    }
+
+    systick_phase = cycles;
+    SysTick->LOAD = systick_period - cycles - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+}
+
+static void stm32_tickless_sleep(void)
+{
+    __DSB();
+    __WFI();
+    __ISB();
+}
+
+static const struct rt_tickless_ops stm32_tickless_ops =
+{
+    stm32_tickless_counter,
+    stm32_tickless_alarm,
+    stm32_tickless_tick_stop,
+    stm32_tickless_tick_start,
+    stm32_tickless_sleep,
+};
+
+/**
+ * This function starts LPTIM1 on the LSE and the tickless idle
+ */
+static int stm32_tickless_init(void)
+{
+    RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+    RCC_PeriphCLKInitTypeDef RCC_PeriphCLKInitStruct = {0};
+
+    /* Enable LSE clock, also the clock of the RTC */
+    HAL_PWR_EnableBkUpAccess();
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_LSE;
+    RCC_OscInitStruct.LSEState = RCC_LSE_ON;
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+    if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+    {
+        return -RT_ERROR;
+    }
+
+    /* Select the LSE clock as LPTIM peripheral clock */
+    RCC_PeriphCLKInitStruct.PeriphClockSelection = RCC_PERIPHCLK_LPTIM1;
+    RCC_PeriphCLKInitStruct.Lptim1ClockSelection = RCC_LPTIM1CLKSOURCE_LSE;
+    HAL_RCCEx_PeriphCLKConfig(&RCC_PeriphCLKInitStruct);
+
+    LptimHandle.Instance = LPTIM1;
+    LptimHandle.Init.Clock.Source = LPTIM_CLOCKSOURCE_APBCLOCK_LPOSC;
+    LptimHandle.Init.Clock.Prescaler = LPTIM_PRESCALER_DIV1;
+    LptimHandle.Init.Trigger.Source = LPTIM_TRIGSOURCE_SOFTWARE;
+    LptimHandle.Init.OutputPolarity = LPTIM_OUTPUTPOLARITY_HIGH;
+    LptimHandle.Init.UpdateMode = LPTIM_UPDATE_IMMEDIATE;
+    LptimHandle.Init.CounterSource = LPTIM_COUNTERSOURCE_INTERNAL;
+    if (HAL_LPTIM_Init(&LptimHandle) != HAL_OK)
+    {
+        return -RT_ERROR;
+    }
+
+    /* IER is written with the timer disabled */
+    __HAL_LPTIM_ENABLE_IT(&LptimHandle, LPTIM_IT_CMPM);
+    if (HAL_LPTIM_Counter_Start(&LptimHandle, LPTIM_MASK) != HAL_OK)
+    {
+        return -RT_ERROR;
+    }
+
+    NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+    NVIC_SetPriority(LPTIM1_IRQn, 0);
+    NVIC_EnableIRQ(LPTIM1_IRQn);
+
+    systick_period = SysTick->LOAD + 1;
+    rt_tickless_init(&stm32_tickless_ops, LPTIM_FREQ, LPTIM_MASK);
+
+    return RT_EOK;
+}
+INIT_DEVICE_EXPORT(stm32_tickless_init);
+
+#endif /* RT_USING_TICKLESS */
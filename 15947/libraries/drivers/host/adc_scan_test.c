@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The DMA scan group of drv_adc.c on the HAL mock, see README.md. The driver is built into
+ * this file to reach its init function and its devices.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hal_mock.h"
+#include "../drv_adc.c"
+
+#define TEST_CHANNELS       3
+#define TEST_FRAMES         4
+#define TEST_SAMPLES        (2 * TEST_FRAMES * TEST_CHANNELS)
+
+struct test_frames
+{
+    int calls;
+    const rt_uint16_t *frames[8];
+    rt_size_t frame_count;
+    rt_uint16_t data[8][TEST_FRAMES * TEST_CHANNELS];
+    /* the invalidations of the D-cache before each call */
+    int invalidations[8];
+    void *user_data;
+};
+
+static const rt_uint8_t test_channels[TEST_CHANNELS] = {3, 5, 16};
+static rt_uint16_t test_buffer[TEST_SAMPLES] __attribute__((aligned(32)));
+static struct test_frames test_seen;
+static int test_errors;
+
+#define TEST_CHECK(expr)                                                        \
+    do                                                                          \
+    {                                                                           \
+        if (!(expr))                                                            \
+        {                                                                       \
+            printf("  line %d: %s\n", __LINE__, #expr);                         \
+            test_errors++;                                                      \
+        }                                                                       \
+    } while (0)
+
+static void test_frame_done(struct rt_adc_device *device, const rt_uint16_t *frames,
+                            rt_size_t frame_count, void *user_data)
+{
+    struct test_frames *seen = user_data;
+
+    (void) device;
+    if (seen->calls < 8)
+    {
+        seen->frames[seen->calls] = frames;
+        memcpy(seen->data[seen->calls], frames, frame_count * TEST_CHANNELS * sizeof(rt_uint16_t));
+        seen->invalidations[seen->calls] = hal_mock.invalidations;
+    }
+    seen->frame_count = frame_count;
+    seen->user_data = user_data;
+    seen->calls++;
+}
+
+static void test_config(struct rt_adc_scan_config *config, rt_uint32_t trigger)
+{
+    memset(config, 0, sizeof(*config));
+    config->channels = test_channels;
+    config->channel_count = TEST_CHANNELS;
+    config->frames_per_half = TEST_FRAMES;
+    config->buffer = test_buffer;
+    config->trigger = trigger;
+    config->frame_done = test_frame_done;
+    config->user_data = &test_seen;
+}
+
+/* the sequencer converts count samples, numbered from first, and the DMA interrupt runs */
+static void test_convert(rt_uint16_t first, int count)
+{
+    rt_uint16_t samples[TEST_SAMPLES * 2];
+    int i;
+
+    for (i = 0; i < count; i++)
+        samples[i] = (rt_uint16_t)(first + i);
+    hal_mock_dma_write(samples, count);
+    ADC1_DMA_IRQHandler();
+}
+
+static void test_setup(struct rt_adc_device **adc)
+{
+    hal_mock_reset();
+    memset(test_buffer, 0, sizeof(test_buffer));
+    memset(&test_seen, 0, sizeof(test_seen));
+    memset(stm32_adc_obj, 0, sizeof(stm32_adc_obj));
+    stm32_adc_init();
+    *adc = &stm32_adc_obj[0].stm32_adc_device;
+}
+
+static void test_register(void)
+{
+    struct rt_adc_device *adc;
+
+    test_setup(&adc);
+    TEST_CHECK(strcmp(adc->parent.parent.name, "adc1") == 0);
+    TEST_CHECK(adc->ops->scan_config != RT_NULL);
+    TEST_CHECK(hal_mock.init.ScanConvMode == ADC_SCAN_DISABLE);
+    TEST_CHECK(hal_mock.init.ConversionDataManagement == ADC_CONVERSIONDATA_DR);
+
+    hal_mock.value = 1234;
+    TEST_CHECK(rt_adc_read(adc, 5) == 1234);
+    TEST_CHECK(hal_mock.channel_num == 1 && hal_mock.channels[0].Channel == ADC_CHANNEL_5);
+    TEST_CHECK(hal_mock.calibrations == 1);
+    rt_adc_read(adc, 5);
+    TEST_CHECK(hal_mock.calibrations == 1);
+}
+
+static void test_scan_config(void)
+{
+    struct rt_adc_device *adc;
+    struct rt_adc_scan_config config;
+    rt_uint8_t many[17];
+    int i;
+
+    test_setup(&adc);
+
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    config.channel_count = 0;
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == -RT_EINVAL);
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    config.buffer = RT_NULL;
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == -RT_EINVAL);
+    memset(many, 0, sizeof(many));
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    config.channels = many;
+    config.channel_count = sizeof(many);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == -RT_EINVAL);
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    config.channels = many;
+    many[0] = 20;
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == -RT_ERROR);
+
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == RT_EOK);
+    TEST_CHECK(hal_mock.init.ScanConvMode == ADC_SCAN_ENABLE);
+    TEST_CHECK(hal_mock.init.NbrOfConversion == TEST_CHANNELS);
+    TEST_CHECK(hal_mock.init.EOCSelection == ADC_EOC_SEQ_CONV);
+    TEST_CHECK(hal_mock.init.ConversionDataManagement == ADC_CONVERSIONDATA_DMA_CIRCULAR);
+    TEST_CHECK(hal_mock.init.ContinuousConvMode == ENABLE);
+    TEST_CHECK(hal_mock.init.ExternalTrigConv == ADC_SOFTWARE_START);
+
+    /* the channels in list order, on the ranks from 1 */
+    TEST_CHECK(hal_mock.channel_num == TEST_CHANNELS);
+    for (i = 0; i < hal_mock.channel_num; i++)
+    {
+        TEST_CHECK(hal_mock.channels[i].Channel == (0x100U | test_channels[i]));
+        TEST_CHECK(hal_mock.channels[i].Rank == stm32_adc_regular_rank[i]);
+    }
+
+    TEST_CHECK(hal_mock.dma_inits == 1);
+    TEST_CHECK(hal_mock.dma_init.Mode == DMA_CIRCULAR);
+    TEST_CHECK(hal_mock.dma_init.Direction == DMA_PERIPH_TO_MEMORY);
+    TEST_CHECK(hal_mock.dma_init.MemInc == DMA_MINC_ENABLE);
+    TEST_CHECK(hal_mock.dma_init.PeriphDataAlignment == DMA_PDATAALIGN_HALFWORD);
+    TEST_CHECK(hal_mock.dma_init.MemDataAlignment == DMA_MDATAALIGN_HALFWORD);
+    TEST_CHECK(hal_mock.dma_init.Request == DMA_REQUEST_ADC1);
+    TEST_CHECK(hal_mock.irq_enabled);
+    TEST_CHECK(stm32_adc_obj[0].ADC_Handler.DMA_Handle == &stm32_adc_obj[0].dma_handle);
+
+    /* one sequence per trigger event */
+    test_config(&config, ADC_EXTERNALTRIG_T3_TRGO);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == RT_EOK);
+    TEST_CHECK(hal_mock.init.ContinuousConvMode == DISABLE);
+    TEST_CHECK(hal_mock.init.ExternalTrigConv == ADC_EXTERNALTRIG_T3_TRGO);
+    TEST_CHECK(hal_mock.init.ExternalTrigConvEdge == ADC_EXTERNALTRIGCONVEDGE_RISING);
+}
+
+static void test_scan_halves(void)
+{
+    struct rt_adc_device *adc;
+    struct rt_adc_scan_config config;
+    const int half = TEST_FRAMES * TEST_CHANNELS;
+    int i, round;
+
+    test_setup(&adc);
+    TEST_CHECK(rt_adc_scan_start(adc) == -RT_ERROR);
+
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == RT_EOK);
+    TEST_CHECK(rt_adc_scan_start(adc) == RT_EOK);
+    TEST_CHECK(hal_mock.dma_running);
+    TEST_CHECK(hal_mock.dma_buffer == test_buffer);
+    TEST_CHECK(hal_mock.dma_length == TEST_SAMPLES);
+    /* started already */
+    TEST_CHECK(rt_adc_scan_start(adc) == RT_EOK);
+
+    /* nothing before the first half is full */
+    test_convert(0, half - 1);
+    TEST_CHECK(test_seen.calls == 0);
+    test_convert(half - 1, 1);
+    TEST_CHECK(test_seen.calls == 1);
+    TEST_CHECK(test_seen.frames[0] == test_buffer);
+    TEST_CHECK(test_seen.frame_count == TEST_FRAMES);
+    TEST_CHECK(test_seen.user_data == &test_seen);
+    TEST_CHECK(test_seen.data[0][0] == 0 && test_seen.data[0][half - 1] == half - 1);
+    /* the half was invalidated before the call, and only that half */
+    TEST_CHECK(test_seen.invalidations[0] == 1);
+    TEST_CHECK(hal_mock.inval_addr == test_buffer);
+    TEST_CHECK(hal_mock.inval_size == half * (int32_t)sizeof(rt_uint16_t));
+
+    test_convert(half, half);
+    TEST_CHECK(test_seen.calls == 2);
+    TEST_CHECK(test_seen.frames[1] == test_buffer + half);
+    TEST_CHECK(test_seen.data[1][0] == half && test_seen.data[1][half - 1] == 2 * half - 1);
+    TEST_CHECK(test_seen.invalidations[1] == 2);
+    TEST_CHECK(hal_mock.inval_addr == test_buffer + half);
+
+    /* the transfer wraps, first half, second half, and so on */
+    for (round = 1; round < 3; round++)
+    {
+        test_convert(round * 2 * half, 2 * half);
+        TEST_CHECK(test_seen.calls == 2 + 2 * round);
+        for (i = 0; i < 2; i++)
+        {
+            TEST_CHECK(test_seen.frames[2 * round + i] == test_buffer + i * half);
+            TEST_CHECK(test_seen.data[2 * round + i][0] == (round * 2 + i) * half);
+            TEST_CHECK(test_seen.data[2 * round + i][half - 1] == (round * 2 + i + 1) * half - 1);
+        }
+    }
+
+    /* both flags on one interrupt, the half first */
+    test_convert(6 * half, half + 1);
+    test_convert(7 * half + 1, half - 1);
+    TEST_CHECK(test_seen.calls == 8);
+    TEST_CHECK(test_seen.frames[6] == test_buffer && test_seen.frames[7] == test_buffer + half);
+
+    TEST_CHECK(rt_adc_scan_stop(adc) == RT_EOK);
+}
+
+static void test_scan_busy(void)
+{
+    struct rt_adc_device *adc;
+    struct rt_adc_scan_config config;
+    struct rt_adc_oversampling oversampling = {16, 4};
+    rt_uint32_t value;
+    int conversions, enabled;
+
+    test_setup(&adc);
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == RT_EOK);
+    TEST_CHECK(rt_adc_scan_start(adc) == RT_EOK);
+
+    /* the sequencer belongs to the scan, a read gets nothing instead of a stale value */
+    conversions = hal_mock.conversions;
+    hal_mock.value = 555;
+    value = 0xDEADBEEF;
+    TEST_CHECK(rt_adc_convert(adc, 5, &value) == -RT_EBUSY);
+    TEST_CHECK(value == 0);
+    TEST_CHECK(rt_adc_read(adc, 5) == 0);
+    TEST_CHECK(hal_mock.conversions == conversions);
+
+    /* and the enable of a single read, whose disable would stop the scan */
+    enabled = hal_mock.enabled;
+    TEST_CHECK(rt_adc_enable(adc, 5) == -RT_EBUSY);
+    TEST_CHECK(rt_adc_disable(adc, 5) == -RT_EBUSY);
+    TEST_CHECK(hal_mock.enabled == enabled && hal_mock.dma_running);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == -RT_EBUSY);
+    TEST_CHECK(rt_adc_set_oversampling(adc, &oversampling) == -RT_EBUSY);
+
+    /* the stop gives the single conversions back */
+    TEST_CHECK(rt_adc_scan_stop(adc) == RT_EOK);
+    TEST_CHECK(!hal_mock.dma_running);
+    TEST_CHECK(hal_mock.init.ScanConvMode == ADC_SCAN_DISABLE);
+    TEST_CHECK(hal_mock.init.NbrOfConversion == 1);
+    TEST_CHECK(hal_mock.init.ContinuousConvMode == DISABLE);
+    TEST_CHECK(hal_mock.init.ConversionDataManagement == ADC_CONVERSIONDATA_DR);
+    TEST_CHECK(rt_adc_scan_stop(adc) == RT_EOK);
+    hal_mock.value = 777;
+    TEST_CHECK(rt_adc_read(adc, 3) == 777);
+    TEST_CHECK(rt_adc_convert(adc, 3, &value) == RT_EOK && value == 777);
+    TEST_CHECK(rt_adc_disable(adc, 3) == RT_EOK && !hal_mock.enabled);
+    TEST_CHECK(rt_adc_enable(adc, 3) == RT_EOK && hal_mock.enabled);
+
+    /* the oversampling set in between is kept by the next scan */
+    TEST_CHECK(rt_adc_set_oversampling(adc, &oversampling) == RT_EOK);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == RT_EOK);
+    TEST_CHECK(hal_mock.init.OversamplingMode == ENABLE);
+    TEST_CHECK(hal_mock.init.Oversampling.Ratio == 16);
+    TEST_CHECK(rt_adc_scan_start(adc) == RT_EOK);
+    TEST_CHECK(rt_adc_scan_stop(adc) == RT_EOK);
+    TEST_CHECK(hal_mock.init.OversamplingMode == ENABLE);
+}
+
+static void test_scan_start_fail(void)
+{
+    struct rt_adc_device *adc;
+    struct rt_adc_scan_config config;
+
+    test_setup(&adc);
+    test_config(&config, RT_ADC_SCAN_TRIGGER_CONTINUOUS);
+    TEST_CHECK(rt_adc_scan_config(adc, &config) == RT_EOK);
+
+    hal_mock.start_dma_result = HAL_ERROR;
+    TEST_CHECK(rt_adc_scan_start(adc) == -RT_ERROR);
+    TEST_CHECK(!stm32_adc_obj[0].scanning);
+    hal_mock.value = 42;
+    TEST_CHECK(rt_adc_read(adc, 3) == 42);
+
+    hal_mock.start_dma_result = HAL_OK;
+    TEST_CHECK(rt_adc_scan_start(adc) == RT_EOK);
+    test_convert(0, TEST_SAMPLES / 2);
+    TEST_CHECK(test_seen.calls == 1);
+    TEST_CHECK(rt_adc_scan_stop(adc) == RT_EOK);
+
+    /* no callback after the stop */
+    test_convert(0, TEST_SAMPLES);
+    TEST_CHECK(test_seen.calls == 1);
+}
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+} test_cases[] =
+{
+    {"register and single read", test_register},
+    {"scan group config", test_scan_config},
+    {"half and complete callbacks", test_scan_halves},
+    {"single read during a scan", test_scan_busy},
+    {"failed scan start", test_scan_start_fail},
+};
+
+int main(void)
+{
+    int i, errors, failed = 0;
+
+    for (i = 0; i < (int)(sizeof(test_cases) / sizeof(test_cases[0])); i++)
+    {
+        errors = test_errors;
+        test_cases[i].run();
+        printf("%-32s %s\n", test_cases[i].name, test_errors == errors ? "ok" : "FAILED");
+        if (test_errors != errors)
+            failed++;
+    }
+    printf("%d of %d passed\n", i - failed, i);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The part of the STM32H7 HAL that drv_adc.c uses, in place of the BSP board.h. The types
+ * keep the fields the driver writes, the functions are the mock of hal_mock.c.
+ */
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+#include <stdint.h>
+#include <rtthread.h>
+
+#define SOC_SERIES_STM32H7
+
+#define ENABLE                  1U
+#define DISABLE                 0U
+#define UNUSED(x)               ((void)(x))
+#define SET_BIT(REG, BIT)       ((REG) |= (BIT))
+#define READ_BIT(REG, BIT)      ((REG) & (BIT))
+
+typedef enum
+{
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef int IRQn_Type;
+
+typedef struct
+{
+    volatile uint32_t AHB1ENR;
+} RCC_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CR;
+} ADC_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CR;
+} DMA_Stream_TypeDef;
+
+extern RCC_TypeDef hal_mock_rcc;
+extern ADC_TypeDef hal_mock_adc1;
+extern DMA_Stream_TypeDef hal_mock_dma1_stream6;
+
+#define RCC                     (&hal_mock_rcc)
+#define ADC1                    (&hal_mock_adc1)
+#define DMA1_Stream6            (&hal_mock_dma1_stream6)
+#define DMA1_Stream6_IRQn       ((IRQn_Type)17)
+#define RCC_AHB1ENR_DMA1EN      (1U << 0)
+#define DMA_REQUEST_ADC1        9U
+
+/* DMA */
+typedef struct
+{
+    uint32_t Request;
+    uint32_t Direction;
+    uint32_t PeriphInc;
+    uint32_t MemInc;
+    uint32_t PeriphDataAlignment;
+    uint32_t MemDataAlignment;
+    uint32_t Mode;
+    uint32_t Priority;
+    uint32_t FIFOMode;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+    DMA_Stream_TypeDef *Instance;
+    DMA_InitTypeDef Init;
+    void *Parent;
+} DMA_HandleTypeDef;
+
+#define DMA_PERIPH_TO_MEMORY            0x00000040U
+#define DMA_PINC_DISABLE                0x00000000U
+#define DMA_MINC_ENABLE                 0x00000400U
+#define DMA_PDATAALIGN_HALFWORD         0x00000800U
+#define DMA_MDATAALIGN_HALFWORD         0x00002000U
+#define DMA_NORMAL                      0x00000000U
+#define DMA_CIRCULAR                    0x00000100U
+#define DMA_PRIORITY_HIGH               0x00020000U
+#define DMA_FIFOMODE_DISABLE            0x00000000U
+
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__) \
+    do                                                              \
+    {                                                               \
+        (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__);        \
+        (__DMA_HANDLE__).Parent = (__HANDLE__);                     \
+    } while (0)
+
+/* ADC */
+typedef struct
+{
+    uint32_t Ratio;
+    uint32_t RightBitShift;
+    uint32_t TriggeredMode;
+    uint32_t OversamplingStopReset;
+} ADC_OversamplingTypeDef;
+
+typedef struct
+{
+    uint32_t ClockPrescaler;
+    uint32_t Resolution;
+    uint32_t ScanConvMode;
+    uint32_t EOCSelection;
+    uint32_t LowPowerAutoWait;
+    uint32_t ContinuousConvMode;
+    uint32_t NbrOfConversion;
+    uint32_t DiscontinuousConvMode;
+    uint32_t NbrOfDiscConversion;
+    uint32_t ExternalTrigConv;
+    uint32_t ExternalTrigConvEdge;
+    uint32_t ConversionDataManagement;
+    uint32_t Overrun;
+    uint32_t OversamplingMode;
+    ADC_OversamplingTypeDef Oversampling;
+} ADC_InitTypeDef;
+
+typedef struct __ADC_HandleTypeDef
+{
+    ADC_TypeDef *Instance;
+    ADC_InitTypeDef Init;
+    DMA_HandleTypeDef *DMA_Handle;
+} ADC_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t Channel;
+    uint32_t Rank;
+    uint32_t SamplingTime;
+    uint32_t SingleDiff;
+    uint32_t OffsetNumber;
+    uint32_t Offset;
+} ADC_ChannelConfTypeDef;
+
+/* the channel number in the low bits, as the HAL decodes it */
+#define ADC_CHANNEL_0                   (0x100U | 0U)
+#define ADC_CHANNEL_1                   (0x100U | 1U)
+#define ADC_CHANNEL_2                   (0x100U | 2U)
+#define ADC_CHANNEL_3                   (0x100U | 3U)
+#define ADC_CHANNEL_4                   (0x100U | 4U)
+#define ADC_CHANNEL_5                   (0x100U | 5U)
+#define ADC_CHANNEL_6                   (0x100U | 6U)
+#define ADC_CHANNEL_7                   (0x100U | 7U)
+#define ADC_CHANNEL_8                   (0x100U | 8U)
+#define ADC_CHANNEL_9                   (0x100U | 9U)
+#define ADC_CHANNEL_10                  (0x100U | 10U)
+#define ADC_CHANNEL_11                  (0x100U | 11U)
+#define ADC_CHANNEL_12                  (0x100U | 12U)
+#define ADC_CHANNEL_13                  (0x100U | 13U)
+#define ADC_CHANNEL_14                  (0x100U | 14U)
+#define ADC_CHANNEL_15                  (0x100U | 15U)
+#define ADC_CHANNEL_16                  (0x100U | 16U)
+#define ADC_CHANNEL_17                  (0x100U | 17U)
+#define ADC_CHANNEL_18                  (0x100U | 18U)
+#define ADC_CHANNEL_19                  (0x100U | 19U)
+
+#define ADC_REGULAR_RANK_1              6U
+#define ADC_REGULAR_RANK_2              12U
+#define ADC_REGULAR_RANK_3              18U
+#define ADC_REGULAR_RANK_4              24U
+#define ADC_REGULAR_RANK_5              0x100U
+#define ADC_REGULAR_RANK_6              0x106U
+#define ADC_REGULAR_RANK_7              0x10CU
+#define ADC_REGULAR_RANK_8              0x112U
+#define ADC_REGULAR_RANK_9              0x118U
+#define ADC_REGULAR_RANK_10             0x200U
+#define ADC_REGULAR_RANK_11             0x206U
+#define ADC_REGULAR_RANK_12             0x20CU
+#define ADC_REGULAR_RANK_13             0x212U
+#define ADC_REGULAR_RANK_14             0x218U
+#define ADC_REGULAR_RANK_15             0x300U
+#define ADC_REGULAR_RANK_16             0x306U
+
+#define ADC_CLOCK_SYNC_PCLK_DIV2        0x00020000U
+#define ADC_CLOCK_SYNC_PCLK_DIV4        0x00030000U
+#define ADC_RESOLUTION_16B              0x00000000U
+#define ADC_RESOLUTION_12B              0x0000000CU
+#define ADC_SCAN_DISABLE                0x00000000U
+#define ADC_SCAN_ENABLE                 0x00100000U
+#define ADC_EOC_SINGLE_CONV             0x00000004U
+#define ADC_EOC_SEQ_CONV                0x00000008U
+#define ADC_SOFTWARE_START              0x00000001U
+#define ADC_EXTERNALTRIG_T3_TRGO        0x00001000U
+#define ADC_EXTERNALTRIGCONVEDGE_NONE   0x00000000U
+#define ADC_EXTERNALTRIGCONVEDGE_RISING 0x00000400U
+#define ADC_CONVERSIONDATA_DR           0x00000000U
+#define ADC_CONVERSIONDATA_DMA_CIRCULAR 0x00000003U
+#define ADC_OVR_DATA_OVERWRITTEN        0x00001000U
+#define ADC_SAMPLETIME_1CYCLE_5         0x00000000U
+#define ADC_OFFSET_NONE                 0x00000004U
+#define ADC_SINGLE_ENDED                0x00000000U
+#define ADC_CALIB_OFFSET_LINEARITY      0x00010000U
+#define ADC_CFGR2_OVSS_Pos              5U
+#define ADC_TRIGGEREDMODE_SINGLE_TRIGGER    0x00000000U
+#define ADC_REGOVERSAMPLING_CONTINUED_MODE  0x00000000U
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc, uint32_t CalibrationMode, uint32_t SingleDiff);
+HAL_StatusTypeDef ADC_Enable(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef ADC_Disable(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc);
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void SCB_InvalidateDCache_by_Addr(void *addr, int32_t dsize);
+
+#endif /* __BOARD_H__ */
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * A mock of the STM32H7 HAL for drv_adc.c. It keeps what the driver programs, and moves
+ * the samples of a circular DMA transfer into the buffer the way the stream does: the
+ * half transfer and transfer complete flags are raised as the position passes the middle
+ * and the end, and HAL_DMA_IRQHandler() turns them into the ADC callbacks.
+ */
+
+#include <string.h>
+
+#include "hal_mock.h"
+
+RCC_TypeDef hal_mock_rcc;
+ADC_TypeDef hal_mock_adc1;
+DMA_Stream_TypeDef hal_mock_dma1_stream6;
+
+struct hal_mock hal_mock;
+
+void hal_mock_reset(void)
+{
+    memset(&hal_mock, 0, sizeof(hal_mock));
+    hal_mock.init_result = HAL_OK;
+    hal_mock.start_dma_result = HAL_OK;
+}
+
+void hal_mock_dma_write(const uint16_t *samples, uint32_t count)
+{
+    uint32_t i;
+
+    if (!hal_mock.dma_running)
+        return;
+
+    for (i = 0; i < count; i++)
+    {
+        hal_mock.dma_buffer[hal_mock.dma_pos++] = samples[i];
+        if (hal_mock.dma_pos == hal_mock.dma_length / 2)
+        {
+            hal_mock.half_pending = 1;
+        }
+        else if (hal_mock.dma_pos == hal_mock.dma_length)
+        {
+            hal_mock.full_pending = 1;
+            hal_mock.dma_pos = 0;
+        }
+    }
+}
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc)
+{
+    hal_mock.init = hadc->Init;
+    hal_mock.init_calls++;
+    hal_mock.channel_num = 0;
+
+    return hal_mock.init_result;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig)
+{
+    (void) hadc;
+
+    if (hal_mock.channel_num >= HAL_MOCK_MAX_RANKS)
+        return HAL_ERROR;
+    hal_mock.channels[hal_mock.channel_num++] = *sConfig;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
+{
+    (void) hadc;
+
+    hal_mock.conversions++;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout)
+{
+    (void) hadc;
+    (void) Timeout;
+
+    return HAL_OK;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc)
+{
+    (void) hadc;
+
+    return hal_mock.value;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length)
+{
+    (void) hadc;
+
+    if (hal_mock.start_dma_result != HAL_OK)
+        return hal_mock.start_dma_result;
+
+    hal_mock.dma_buffer = (uint16_t *)pData;
+    hal_mock.dma_length = Length;
+    hal_mock.dma_pos = 0;
+    hal_mock.dma_running = 1;
+    hal_mock.half_pending = 0;
+    hal_mock.full_pending = 0;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc)
+{
+    (void) hadc;
+
+    hal_mock.dma_running = 0;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc, uint32_t CalibrationMode, uint32_t SingleDiff)
+{
+    (void) hadc;
+    (void) CalibrationMode;
+    (void) SingleDiff;
+
+    hal_mock.calibrations++;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef ADC_Enable(ADC_HandleTypeDef *hadc)
+{
+    (void) hadc;
+
+    hal_mock.enabled = 1;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef ADC_Disable(ADC_HandleTypeDef *hadc)
+{
+    (void) hadc;
+
+    hal_mock.enabled = 0;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+    hal_mock.dma_init = hdma->Init;
+    hal_mock.dma_inits++;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *hdma)
+{
+    (void) hdma;
+
+    return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+    /* the stream handles the half transfer before the transfer complete */
+    if (hal_mock.half_pending)
+    {
+        hal_mock.half_pending = 0;
+        HAL_ADC_ConvHalfCpltCallback(hdma->Parent);
+    }
+    if (hal_mock.full_pending)
+    {
+        hal_mock.full_pending = 0;
+        HAL_ADC_ConvCpltCallback(hdma->Parent);
+    }
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void) IRQn;
+    (void) PreemptPriority;
+    (void) SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    (void) IRQn;
+
+    hal_mock.irq_enabled = 1;
+}
+
+void SCB_InvalidateDCache_by_Addr(void *addr, int32_t dsize)
+{
+    hal_mock.inval_addr = addr;
+    hal_mock.inval_size = dsize;
+    hal_mock.invalidations++;
+}
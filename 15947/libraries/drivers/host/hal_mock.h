@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#ifndef __HAL_MOCK_H__
+#define __HAL_MOCK_H__
+
+#include <board.h>
+
+#define HAL_MOCK_MAX_RANKS      16
+
+/* what the driver asked of the HAL, and what the HAL answers */
+struct hal_mock
+{
+    /* the Init of the last HAL_ADC_Init() */
+    ADC_InitTypeDef init;
+    int init_calls;
+    HAL_StatusTypeDef init_result;
+    int enabled;
+    int calibrations;
+
+    /* the channels configured since the last HAL_ADC_Init(), in call order */
+    ADC_ChannelConfTypeDef channels[HAL_MOCK_MAX_RANKS];
+    int channel_num;
+
+    /* the single conversion */
+    uint32_t value;
+    int conversions;
+
+    DMA_InitTypeDef dma_init;
+    int dma_inits;
+    int irq_enabled;
+
+    /* the circular transfer of HAL_ADC_Start_DMA() */
+    uint16_t *dma_buffer;
+    uint32_t dma_length;
+    uint32_t dma_pos;
+    int dma_running;
+    HAL_StatusTypeDef start_dma_result;
+    int half_pending;
+    int full_pending;
+
+    /* the last D-cache invalidation */
+    void *inval_addr;
+    int32_t inval_size;
+    int invalidations;
+};
+
+extern struct hal_mock hal_mock;
+
+void hal_mock_reset(void);
+/* the DMA moves count conversions of the sequencer to memory */
+void hal_mock_dma_write(const uint16_t *samples, uint32_t count);
+
+#endif /* __HAL_MOCK_H__ */
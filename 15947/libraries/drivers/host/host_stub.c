@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The kernel services used by drv_adc.c and the ADC framework. The test runs in one
+ * thread and calls the DMA interrupt handler itself, so the interrupt nesting has nothing
+ * to count, and a registered device only needs its name.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#include <rtthread.h>
+#include <rthw.h>
+
+void rt_interrupt_enter(void)
+{
+}
+
+void rt_interrupt_leave(void)
+{
+}
+
+rt_err_t rt_device_register(rt_device_t dev, const char *name, rt_uint16_t flags)
+{
+    (void) flags;
+
+    snprintf(dev->parent.name, RT_NAME_MAX, "%s", name);
+
+    return RT_EOK;
+}
+
+int rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, fmt);
+    length = vprintf(fmt, args);
+    va_end(args);
+
+    return length;
+}
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    printf("(%s) assertion failed at function:%s, line number:%lu\n", ex, func, (unsigned long) line);
+    abort();
+}
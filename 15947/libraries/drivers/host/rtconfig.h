@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Configuration of the host build in place of the BSP rtconfig.h: the kernel options the
+ * ADC framework needs, and ADC1 with its DMA scan group as on the board.
+ */
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_DEVICE
+#define RT_USING_CONSOLE
+#define RT_USING_ADC
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMSET
+#define RT_KSERVICE_USING_STDLIB_MEMCPY
+
+#define BSP_USING_ADC
+#define BSP_USING_ADC1
+#define BSP_ADC1_USING_DMA
+#define BSP_ADC_USING_DMA
+
+#endif /* RT_CONFIG_H__ */
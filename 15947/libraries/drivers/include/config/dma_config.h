@@ -74,6 +74,13 @@ extern "C" {
 #endif
 
 /* DMA1 stream6 */
+#if defined(BSP_ADC1_USING_DMA) && !defined(ADC1_DMA_INSTANCE)
+#define ADC1_DMA_IRQHandler              DMA1_Stream6_IRQHandler
+#define ADC1_DMA_RCC                     RCC_AHB1ENR_DMA1EN
+#define ADC1_DMA_INSTANCE                DMA1_Stream6
+#define ADC1_DMA_REQUEST                 DMA_REQUEST_ADC1
+#define ADC1_DMA_IRQ                     DMA1_Stream6_IRQn
+#endif
 
 /* DMA1 stream7 */
 #if defined(BSP_SPI3_TX_USING_DMA) && !defined(SPI3_TX_DMA_INSTANCE)
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+光伏二进制遥测通道解码器 (配合 applications/pv_stream.c)
+
+线上格式: COBS(32字节记录 + CRC16-CCITT) + 0x00
+与控制台共用串口时, 夹杂的文本行会因CRC校验失败被丢弃。
+
+用法:
+    python pv_stream_decode.py COM5                    # 串口, 打印
+    python pv_stream_decode.py /dev/ttyUSB0 -b 115200 --csv out.csv   # 采样帧写 out.csv, 诊断写 out_diag.csv
+    python pv_stream_decode.py capture.bin             # 解码抓包文件
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+REC_HELLO = 0
+REC_FRAME = 1
+REC_DIAG = 2
+
+RECORD_FMT = '<BBHI24s'
+RECORD_SIZE = struct.calcsize(RECORD_FMT)   # 32
+HELLO_FMT = '<IHHHHII'
+FRAME_FMT = '<IHH6H'
+DIAG_FMT = '<BBBBBBBB8h'
+STREAM_MAGIC = 0x53545650
+STREAM_VERSION = 2                          # 2: DIAG 每条记录一组 (8块) 板
+
+# 帧内通道顺序与 pv_sampler.h 一致
+CHANNELS = ['PA0', 'PA1', 'PB0', 'PB1', 'PA6', 'PA7']
+
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    """按0x00切分帧, 校验后解析为字典"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.vref_mv = 3300
+        self.adc_max = 65535
+        self.tick_hz = 1000
+        self.last_seq = None
+        self.lost = 0
+        self.bad = 0
+        self.version = None
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            end = self.buf.find(b'\x00')
+            if end < 0:
+                return
+            frame = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if not frame:
+                continue
+            record = self.parse(frame)
+            if record is not None:
+                yield record
+
+    def parse(self, frame):
+        raw = cobs_decode(frame)
+        if raw is None or len(raw) != RECORD_SIZE + 2:
+            self.bad += 1
+            return None
+        body, crc = raw[:RECORD_SIZE], struct.unpack('<H', raw[RECORD_SIZE:])[0]
+        if crc16_ccitt(body) != crc:
+            self.bad += 1
+            return None
+
+        rtype, length, seq, tick, payload = struct.unpack(RECORD_FMT, body)
+        if self.last_seq is not None:
+            gap = (seq - self.last_seq - 1) & 0xFFFF
+            if gap < 0x8000:            # 序号回退视为设备重启, 重新同步
+                self.lost += gap
+        self.last_seq = seq
+
+        rec = {'seq': seq, 'time_s': tick / float(self.tick_hz)}
+        if rtype == REC_HELLO:
+            magic, version, tick_hz, vref, _, adc_max, dropped = struct.unpack(HELLO_FMT, payload[:20])
+            if magic != STREAM_MAGIC:
+                self.bad += 1
+                return None
+            if version != STREAM_VERSION and version != self.version:
+                print('warning: stream version %d, decoder expects %d' % (version, STREAM_VERSION),
+                      file=sys.stderr)
+            self.version = version
+            self.tick_hz, self.vref_mv, self.adc_max = tick_hz, vref, adc_max
+            rec.update(type='hello', version=version, dropped=dropped, time_s=tick / float(tick_hz))
+        elif rtype == REC_FRAME:
+            fields = struct.unpack(FRAME_FMT, payload[:20])
+            rec.update(type='frame', frame_seq=fields[0], samples=fields[1])
+            for name, raw_value in zip(CHANNELS, fields[3:]):
+                rec[name] = raw_value * self.vref_mv // self.adc_max
+        elif rtype == REC_DIAG:
+            if self.version is not None and self.version < 2:
+                self.bad += 1               # v1 的 DIAG 只有6块板, 本解码器不再支持
+                return None
+            fields = struct.unpack(DIAG_FMT, payload[:24])
+            first, count = fields[0], min(fields[1], 8)
+            # 一组一条记录, PV 序号为全阵列序号
+            rec.update(type='diag', first_panel=first, panel_count=count, panels=fields[2],
+                       baseline=bool(fields[3] & 1), fault_code=fields[4], fault_count=fields[5],
+                       fault_mask=fields[6])
+            for i in range(8):
+                rec['mv%d' % i] = fields[8 + i] if i < count else ''
+        else:
+            rec.update(type='unknown(%d)' % rtype, len=length)
+        return rec
+
+
+def format_record(rec):
+    t = '%10.3f #%05d' % (rec['time_s'], rec['seq'])
+    if rec['type'] == 'frame':
+        volts = ' '.join('%s=%4dmV' % (ch, rec[ch]) for ch in CHANNELS)
+        return '%s FRAME %6d x%-3d %s' % (t, rec['frame_seq'], rec['samples'], volts)
+    if rec['type'] == 'diag':
+        first, count = rec['first_panel'], rec['panel_count']
+        pvs = ' '.join('PV%d=%5d' % (first + i + 1, rec['mv%d' % i]) for i in range(count))
+        faulty = [str(first + i + 1) for i in range(count) if rec['fault_mask'] & (1 << i)]
+        return '%s DIAG  PV%d..%d/%d faulty=[%s] code=%d count=%d %s %s' % (
+            t, first + 1, first + count, rec['panels'], ','.join(faulty), rec['fault_code'],
+            rec['fault_count'], 'ready' if rec['baseline'] else 'baseline', pvs)
+    if rec['type'] == 'hello':
+        return '%s HELLO v%d dropped=%d' % (t, rec['version'], rec['dropped'])
+    return '%s %s' % (t, rec['type'])
+
+
+def open_source(path, baud):
+    if os.path.isfile(path):
+        return open(path, 'rb'), False
+    try:
+        import serial
+    except ImportError:
+        sys.exit('pyserial is required for serial ports: pip install pyserial')
+    return serial.Serial(path, baud, timeout=0.2), True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode PV binary telemetry stream')
+    parser.add_argument('source', help='serial port or capture file')
+    parser.add_argument('-b', '--baud', type=int, default=115200)
+    parser.add_argument('--csv', help='write FRAME records to CSV (DIAG to <name>_diag.csv) instead of printing')
+    parser.add_argument('--frames', action='store_true', help='print only FRAME records')
+    args = parser.parse_args()
+
+    src, is_serial = open_source(args.source, args.baud)
+    decoder = Decoder()
+    writers = {}
+    csv_files = []
+    if args.csv:
+        root, ext = os.path.splitext(args.csv)
+        paths = {'frame': args.csv, 'diag': root + '_diag' + (ext or '.csv')}
+
+    try:
+        while True:
+            data = src.read(4096)
+            if not data:
+                if is_serial:
+                    continue
+                break
+            for rec in decoder.feed(data):
+                if args.csv:
+                    if rec['type'] not in paths:
+                        continue
+                    if rec['type'] not in writers:
+                        f = open(paths[rec['type']], 'w', newline='')
+                        csv_files.append(f)
+                        writers[rec['type']] = csv.DictWriter(f, fieldnames=list(rec.keys()))
+                        writers[rec['type']].writeheader()
+                    writers[rec['type']].writerow(rec)
+                elif not args.frames or rec['type'] == 'frame':
+                    print(format_record(rec))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        src.close()
+        for f in csv_files:
+            f.close()
+
+    print('records lost on the line: %d, bad frames: %d' % (decoder.lost, decoder.bad), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -14,10 +14,49 @@
 #include <rtthread.h>
 
 struct rt_adc_device;
+
+#define RT_ADC_SCAN_TRIGGER_CONTINUOUS  0   /* free running, back-to-back conversions */
+
+/*
+ * Scan group: a fixed list of channels converted as one hardware sequence.
+ * Samples are written frame by frame (one sample per channel, in list order)
+ * into a caller supplied double buffer of 2 * frames_per_half frames. Each
+ * time one half is filled, frame_done is called from interrupt context with
+ * that half; the data stays valid until the hardware wraps back onto it.
+ */
+struct rt_adc_scan_config
+{
+    const rt_uint8_t *channels;         /* channel list, converted in this order */
+    rt_uint8_t channel_count;
+    rt_uint16_t frames_per_half;        /* frames handed to frame_done per call */
+    rt_uint16_t *buffer;                /* 2 * frames_per_half * channel_count samples */
+    rt_uint32_t trigger;                /* RT_ADC_SCAN_TRIGGER_CONTINUOUS or driver specific source */
+
+    void (*frame_done)(struct rt_adc_device *device, const rt_uint16_t *frames, rt_size_t frame_count, void *user_data);
+    void *user_data;
+};
+
+/*
+ * Hardware oversampling: each result is the sum of ratio conversions shifted
+ * right by right_shift bits. ratio 1 turns oversampling off. The result must
+ * still fit the converter resolution, so ratio may not exceed 1 << right_shift.
+ */
+struct rt_adc_oversampling
+{
+    rt_uint16_t ratio;
+    rt_uint8_t right_shift;
+};
+
 struct rt_adc_ops
 {
     rt_err_t (*enabled)(struct rt_adc_device *device, rt_uint32_t channel, rt_bool_t enabled);
     rt_err_t (*convert)(struct rt_adc_device *device, rt_uint32_t channel, rt_uint32_t *value);
+    /* optional scan group support */
+    rt_err_t (*scan_config)(struct rt_adc_device *device, const struct rt_adc_scan_config *config);
+    rt_err_t (*scan_start)(struct rt_adc_device *device);
+    rt_err_t (*scan_stop)(struct rt_adc_device *device);
+    /* optional hardware oversampling, applies to single reads and scan groups */
+    rt_err_t (*oversampling)(struct rt_adc_device *device, const struct rt_adc_oversampling *config);
 };
 
 struct rt_adc_device
@@ -35,8 +74,19 @@ typedef enum
 
 rt_err_t rt_hw_adc_register(rt_adc_device_t adc,const char *name, const struct rt_adc_ops *ops, const void *user_data);
 
+/*
+ * rt_adc_read returns 0 when the conversion fails. rt_adc_convert returns the error
+ * instead, -RT_EBUSY while a scan group runs on the device, and sets *value to 0.
+ */
 rt_uint32_t rt_adc_read(rt_adc_device_t dev, rt_uint32_t channel);
+rt_err_t rt_adc_convert(rt_adc_device_t dev, rt_uint32_t channel, rt_uint32_t *value);
 rt_err_t rt_adc_enable(rt_adc_device_t dev, rt_uint32_t channel);
 rt_err_t rt_adc_disable(rt_adc_device_t dev, rt_uint32_t channel);
 
+rt_err_t rt_adc_scan_config(rt_adc_device_t dev, const struct rt_adc_scan_config *config);
+rt_err_t rt_adc_scan_start(rt_adc_device_t dev);
+rt_err_t rt_adc_scan_stop(rt_adc_device_t dev);
+
+rt_err_t rt_adc_set_oversampling(rt_adc_device_t dev, const struct rt_adc_oversampling *config);
+
 #endif /* __ADC_H__ */
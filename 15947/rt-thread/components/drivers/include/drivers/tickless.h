@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#ifndef __TICKLESS_H__
+#define __TICKLESS_H__
+
+#include <rtthread.h>
+
+/*
+ * The clock of the tickless idle: a low power counter running through the sleep, and the
+ * periodic tick. Times are counts of the counter, and the phases of the tick are in
+ * 1 / RT_TICK_PER_SECOND counts, freq of them in a tick. All of them are called with the
+ * interrupts disabled.
+ */
+struct rt_tickless_ops
+{
+    /* the counter, from 0 to the mask and around again */
+    rt_uint32_t (*counter)(void);
+    /* interrupt when the counter gets to the value, -RT_ETIMEOUT if it is already past it */
+    rt_err_t (*alarm)(rt_uint32_t value);
+    /* stop the periodic tick and clear a pending tick, return the phase: the time since the
+     * last tick, and a whole tick more for a pending tick */
+    rt_uint32_t (*tick_stop)(void);
+    /* start the periodic tick, the phase of the current tick already gone */
+    void (*tick_start)(rt_uint32_t phase);
+    /* wait for an interrupt, the interrupts disabled */
+    void (*sleep)(void);
+};
+
+struct rt_tickless_stat
+{
+    rt_uint32_t sleeps;             /* sleeps without the periodic tick */
+    rt_uint32_t wakeups;            /* sleeps ended by another interrupt before the alarm */
+    rt_uint32_t idles;              /* waits with the periodic tick, the next timer too close */
+    rt_uint64_t ticks;              /* ticks passed in the sleeps */
+};
+
+void rt_tickless_init(const struct rt_tickless_ops *ops, rt_uint32_t freq, rt_uint32_t mask);
+void rt_tickless_idle(void);
+void rt_tickless_get_stat(struct rt_tickless_stat *stat);
+
+#endif /* __TICKLESS_H__ */
@@ -129,6 +129,10 @@ extern "C" {
 #include "drivers/pm.h"
 #endif /* RT_USING_PM */
 
+#ifdef RT_USING_TICKLESS
+#include "drivers/tickless.h"
+#endif /* RT_USING_TICKLESS */
+
 #ifdef RT_USING_WIFI
 #include "drivers/wlan.h"
 #endif /* RT_USING_WIFI */
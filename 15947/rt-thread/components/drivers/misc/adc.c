@@ -101,13 +101,33 @@ rt_err_t rt_hw_adc_register(rt_adc_device_t device, const char *name, const stru
 
 rt_uint32_t rt_adc_read(rt_adc_device_t dev, rt_uint32_t channel)
 {
-    rt_uint32_t value;
+    rt_uint32_t value = 0;
+    rt_err_t result;
+
+    result = rt_adc_convert(dev, channel, &value);
+    if (result != RT_EOK)
+    {
+        LOG_W("%s channel %d read failed: %d", dev->parent.parent.name, channel, result);
+        return 0;
+    }
+
+    return value;
+}
+
+rt_err_t rt_adc_convert(rt_adc_device_t dev, rt_uint32_t channel, rt_uint32_t *value)
+{
+    rt_err_t result;
 
     RT_ASSERT(dev);
+    RT_ASSERT(value);
 
-    dev->ops->convert(dev, channel, &value);
+    result = dev->ops->convert(dev, channel, value);
+    if (result != RT_EOK)
+    {
+        *value = 0;
+    }
 
-    return value;
+    return result;
 }
 
 rt_err_t rt_adc_enable(rt_adc_device_t dev, rt_uint32_t channel)
@@ -144,6 +164,67 @@ rt_err_t rt_adc_disable(rt_adc_device_t dev, rt_uint32_t channel)
     return result;
 }
 
+rt_err_t rt_adc_scan_config(rt_adc_device_t dev, const struct rt_adc_scan_config *config)
+{
+    RT_ASSERT(dev);
+    RT_ASSERT(config);
+
+    if (config->channels == RT_NULL || config->channel_count == 0 ||
+        config->buffer == RT_NULL || config->frames_per_half == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    if (dev->ops->scan_config == RT_NULL)
+    {
+        return -RT_ENOSYS;
+    }
+
+    return dev->ops->scan_config(dev, config);
+}
+
+rt_err_t rt_adc_scan_start(rt_adc_device_t dev)
+{
+    RT_ASSERT(dev);
+
+    if (dev->ops->scan_start == RT_NULL)
+    {
+        return -RT_ENOSYS;
+    }
+
+    return dev->ops->scan_start(dev);
+}
+
+rt_err_t rt_adc_scan_stop(rt_adc_device_t dev)
+{
+    RT_ASSERT(dev);
+
+    if (dev->ops->scan_stop == RT_NULL)
+    {
+        return -RT_ENOSYS;
+    }
+
+    return dev->ops->scan_stop(dev);
+}
+
+rt_err_t rt_adc_set_oversampling(rt_adc_device_t dev, const struct rt_adc_oversampling *config)
+{
+    RT_ASSERT(dev);
+    RT_ASSERT(config);
+
+    if (config->ratio == 0 || config->ratio > (1UL << config->right_shift))
+    {
+        return -RT_EINVAL;
+    }
+
+    if (dev->ops->oversampling == RT_NULL)
+    {
+        return -RT_ENOSYS;
+    }
+
+    return dev->ops->oversampling(dev, config);
+}
+
 #ifdef RT_USING_FINSH
 
 static int adc(int argc, char **argv)
@@ -192,8 +273,16 @@ static int adc(int argc, char **argv)
             {
                 if (argc == 3)
                 {
-                    value = rt_adc_read(adc_device, atoi(argv[2]));
-                    rt_kprintf("%s channel %d  read value is 0x%08X \n", adc_device->parent.parent.name, atoi(argv[2]), value);
+                    result = rt_adc_convert(adc_device, atoi(argv[2]), (rt_uint32_t *)&value);
+                    if (result == RT_EOK)
+                    {
+                        rt_kprintf("%s channel %d  read value is 0x%08X \n", adc_device->parent.parent.name, atoi(argv[2]), value);
+                    }
+                    else
+                    {
+                        rt_kprintf("%s channel %d  read failure %d%s\n", adc_device->parent.parent.name, atoi(argv[2]), result,
+                                   result == -RT_EBUSY ? ", a scan group is running" : "");
+                    }
                 }
                 else
                 {
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ * 2026-10-16     RT-Thread    do not wait for an edge of the counter
+ */
+
+/*
+ * Tickless idle.
+ *
+ * When the next timer is RT_TICKLESS_THRESHOLD ticks away or more, the idle thread stops the
+ * periodic tick and sleeps until the tick of that timer on a low power counter. On wake up,
+ * by the alarm or by another interrupt, the sleep is read on the counter and added to rt_tick
+ * in one step, and what is left of a tick starts the periodic tick again with the right
+ * phase. The phases are kept in 1 / RT_TICK_PER_SECOND counts, so rt_tick keeps to the
+ * counter.
+ *
+ * The counter is not waited on with interrupts off. The time gone in the count read at the
+ * start is worked out from the edge the last sleep ended on: its phase is kept, and the
+ * periodic tick has run since. The alarm ends the sleep on an edge; another interrupt is
+ * taken as half way through its count, and the edge before it is kept with that guess, so
+ * the error of a guess is undone by the next sleep instead of adding up. Without a kept
+ * edge, on the first sleep or after the counter came around, the start is half a count.
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <drivers/tickless.h>
+
+#ifndef RT_TICKLESS_THRESHOLD
+#define RT_TICKLESS_THRESHOLD   2
+#endif
+
+static const struct rt_tickless_ops *_ops = RT_NULL;
+static rt_uint32_t _freq;
+static rt_uint32_t _mask;
+/* the longest sleep, in counts, well short of the counter coming around */
+static rt_uint32_t _max_counts;
+static struct rt_tickless_stat _stat;
+/* the edge the last sleep ended on: the count, and rt_tick and the phase it was at */
+static rt_bool_t _edge_valid;
+static rt_uint32_t _edge_count;
+static rt_tick_t _edge_tick;
+static rt_int32_t _edge_phase;
+
+/*
+ * The time gone in the count read, by the periodic tick since the kept edge. It is off by
+ * as much as the kept edge, so it is taken within a count of its range either way.
+ */
+static rt_int32_t _tickless_gone(rt_tick_t tick, rt_uint32_t phase, rt_uint32_t count)
+{
+    rt_int64_t gone;
+
+    if (!_edge_valid)
+        return RT_TICK_PER_SECOND / 2;
+
+    gone = (rt_int64_t)(rt_tick_t)(tick - _edge_tick) * _freq + phase - _edge_phase
+           - (rt_int64_t)((count - _edge_count) & _mask) * RT_TICK_PER_SECOND;
+    /* the counter came around */
+    if (gone <= -RT_TICK_PER_SECOND || gone >= 2 * RT_TICK_PER_SECOND)
+        return RT_TICK_PER_SECOND / 2;
+
+    return (rt_int32_t)gone;
+}
+
+/**
+ * @brief This function will sleep until the next timer, without the periodic tick.
+ *
+ * @note It is the idle hook of the tickless idle, it returns after each wake up.
+ */
+void rt_tickless_idle(void)
+{
+    rt_base_t level;
+    rt_tick_t tick, next, delta;
+    rt_uint32_t start, wait, elapsed, phase;
+    rt_int32_t gone, late;
+    rt_int64_t target, total, ticks;
+    rt_bool_t alarm = RT_FALSE;
+
+    if (_ops == RT_NULL)
+        return;
+
+    level = rt_hw_interrupt_disable();
+
+    tick = rt_tick_get();
+    next = rt_timer_next_timeout_tick();
+    if (next == RT_TICK_MAX)
+    {
+        /* no timer, sleep as long as the counter allows */
+        delta = RT_TICK_MAX;
+    }
+    else
+    {
+        delta = next - tick;
+        /* the timer is due already */
+        if (delta >= RT_TICK_MAX / 2)
+            delta = 0;
+    }
+
+    if (delta < RT_TICKLESS_THRESHOLD)
+    {
+        /* the next tick wakes the CPU */
+        _ops->sleep();
+        _stat.idles++;
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    start = _ops->counter();
+    phase = _ops->tick_stop();
+    gone = _tickless_gone(tick, phase, start);
+
+    /* the time to the tick of the next timer, in 1 / RT_TICK_PER_SECOND counts */
+    target = (rt_int64_t)delta * _freq;
+    wait = 0;
+    if (target > phase)
+    {
+        /* from the edge of the start count */
+        target = (target - phase + gone + RT_TICK_PER_SECOND - 1) / RT_TICK_PER_SECOND;
+        wait = target > _max_counts ? _max_counts : (rt_uint32_t)target;
+        if (_ops->alarm((start + wait) & _mask) == RT_EOK)
+        {
+            alarm = RT_TRUE;
+            _ops->sleep();
+        }
+    }
+    elapsed = (_ops->counter() - start) & _mask;
+    if (alarm && elapsed == wait)
+    {
+        /* on the edge of the alarm */
+        late = 0;
+    }
+    else
+    {
+        /* half way through the rest of the count, it is after the start */
+        target = gone - (rt_int64_t)elapsed * RT_TICK_PER_SECOND;
+        late = target > 0 ? (rt_int32_t)target : 0;
+        if (late < RT_TICK_PER_SECOND)
+            late = (late + RT_TICK_PER_SECOND) / 2;
+        if (elapsed < wait)
+            _stat.wakeups++;
+    }
+
+    /* the whole ticks go to rt_tick, the rest of a tick to the phase */
+    total = phase + (rt_int64_t)elapsed * RT_TICK_PER_SECOND + late - gone;
+    ticks = total / _freq;
+
+    _edge_valid = RT_TRUE;
+    _edge_count = (start + elapsed) & _mask;
+    _edge_tick = tick + (rt_tick_t)ticks;
+    _edge_phase = (rt_int32_t)(total - ticks * _freq) - (rt_int32_t)late;
+
+    rt_tick_set(tick + (rt_tick_t)ticks);
+    _ops->tick_start((rt_uint32_t)(total - ticks * _freq));
+
+    _stat.sleeps++;
+    _stat.ticks += ticks;
+
+    rt_hw_interrupt_enable(level);
+
+    if (ticks)
+    {
+        rt_timer_check();
+    }
+}
+
+/**
+ * @brief This function will get the statistics of the tickless idle.
+ *
+ * @param stat is the statistics to fill.
+ */
+void rt_tickless_get_stat(struct rt_tickless_stat *stat)
+{
+    rt_base_t level;
+
+    RT_ASSERT(stat != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    *stat = _stat;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * @brief This function will start the tickless idle on a low power counter.
+ *
+ * @param ops is the counter and the periodic tick of the board.
+ *
+ * @param freq is the frequency of the counter, in Hz.
+ *
+ * @param mask is the last value of the counter, 0xFFFF for a 16-bit counter.
+ */
+void rt_tickless_init(const struct rt_tickless_ops *ops, rt_uint32_t freq, rt_uint32_t mask)
+{
+    RT_ASSERT(ops != RT_NULL);
+    RT_ASSERT(freq >= RT_TICK_PER_SECOND);
+
+    _freq = freq;
+    _mask = mask;
+    /* the counter is read after the wake up, leave it time before it comes around */
+    _max_counts = mask - (mask >> 3);
+    rt_memset(&_stat, 0, sizeof(_stat));
+    _edge_valid = RT_FALSE;
+    _ops = ops;
+
+    rt_thread_idle_sethook(rt_tickless_idle);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void tickless(void)
+{
+    struct rt_tickless_stat stat;
+    rt_tick_t uptime;
+
+    rt_tickless_get_stat(&stat);
+    uptime = rt_tick_get();
+
+    rt_kprintf("uptime      : %u ticks\n", uptime);
+    rt_kprintf("sleeps      : %u, %u ended before the alarm\n", stat.sleeps, stat.wakeups);
+    rt_kprintf("ticks slept : %u, %u per sleep\n", (rt_uint32_t)stat.ticks,
+               stat.sleeps ? (rt_uint32_t)(stat.ticks / stat.sleeps) : 0);
+    rt_kprintf("short idles : %u\n", stat.idles);
+}
+MSH_CMD_EXPORT(tickless, show the statistics of the tickless idle);
+#endif /* RT_USING_FINSH */
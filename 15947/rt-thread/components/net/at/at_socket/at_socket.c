@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-06-06     chenyong     first version
+ * 2026-10-16     RT-Thread    receive into a ring block buffer per socket
+ * 2026-10-16     RT-Thread    add at_sendmsg
  */
 
 #include <at.h>
@@ -49,151 +51,150 @@ typedef enum {
 } at_event_t;
 
 
-/* the global of sockets list */
-static rt_slist_t _socket_list = RT_SLIST_OBJECT_INIT(_socket_list);
+/* the smallest block a received chunk is split into when the free space wraps */
+#define AT_SOCKET_RECV_BLK_MIN         32
+
+/* the global sockets, indexed by the socket descriptor */
+static struct at_socket *_socket_table[AT_SOCKETS_NUM] = { 0 };
 
 struct at_socket *at_get_socket(int socket)
 {
-    rt_base_t level;
-    rt_slist_t *node = RT_NULL;
-    struct at_socket *at_sock = RT_NULL;
+    struct at_socket *at_sock;
 
-    level = rt_hw_interrupt_disable();
-
-    rt_slist_for_each(node, &_socket_list)
+    if (socket < 0 || socket >= AT_SOCKETS_NUM)
     {
-        at_sock = rt_slist_entry(node, struct at_socket, list);
-        if (socket == at_sock->socket)
-        {
-            if (at_sock && at_sock->magic == AT_SOCKET_MAGIC)
-            {
-                rt_hw_interrupt_enable(level);
-                return at_sock;
-            }
-        }
+        return RT_NULL;
     }
 
-    rt_hw_interrupt_enable(level);
+    at_sock = _socket_table[socket];
+    if (at_sock && at_sock->magic == AT_SOCKET_MAGIC)
+    {
+        return at_sock;
+    }
 
     return RT_NULL;
 }
 
-/* get a block to the AT socket receive list*/
-static rt_err_t at_recvpkt_put(rt_slist_t *rlist, const char *ptr, size_t length)
+/**
+ * Allocate a block in the socket receive buffer for the AT device to receive data into.
+ *
+ * @param sock AT socket object
+ * @param size data size
+ *
+ * @note The block can be smaller than size when the free space wraps at the end of the
+ *       buffer, the rest of the data goes to the next block.
+ *
+ * @return != RT_NULL: block, commit it by at_socket_recv_commit()
+ *          = RT_NULL: the receive buffer is full
+ */
+rt_rbb_blk_t at_socket_recv_alloc(struct at_socket *sock, size_t size)
 {
-    at_recv_pkt_t pkt = RT_NULL;
+    rt_rbb_blk_t block = RT_NULL;
 
-    pkt = (at_recv_pkt_t) rt_calloc(1, sizeof(struct at_recv_pkt));
-    if (pkt == RT_NULL)
+    if (sock->recv_rbb == RT_NULL)
     {
-        LOG_E("No memory for receive packet table!");
-        return -RT_ENOMEM;
+        return RT_NULL;
     }
 
-    pkt->bfsz_totle = length;
-    pkt->bfsz_index = 0;
-    pkt->buff = (char *) ptr;
-
-    rt_slist_append(rlist, &pkt->list);
+    while (size > 0 && (block = rt_rbb_blk_alloc(sock->recv_rbb, size)) == RT_NULL)
+    {
+        size = (size > AT_SOCKET_RECV_BLK_MIN) ? size / 2 : 0;
+    }
 
-    return RT_EOK;
+    return block;
 }
 
-/* delete and free all receive buffer list */
-static int at_recvpkt_all_delete(rt_slist_t *rlist)
+static void at_do_event_changes(struct at_socket *sock, at_event_t event, rt_bool_t is_plus);
+
+/**
+ * Commit a block allocated by at_socket_recv_alloc() and notify the receiver.
+ *
+ * @param sock AT socket object
+ * @param block received data block
+ * @param size received data size, not larger than the block, 0 drops the block
+ */
+void at_socket_recv_commit(struct at_socket *sock, rt_rbb_blk_t block, size_t size)
 {
-    at_recv_pkt_t pkt = RT_NULL;
-    rt_slist_t *node = RT_NULL;
+    RT_ASSERT(size <= rt_rbb_blk_size(block));
 
-    if (rt_slist_isempty(rlist))
+    if (size == 0)
     {
-        return 0;
+        rt_rbb_blk_free(sock->recv_rbb, block);
+        return;
     }
 
-    for(node = rt_slist_first(rlist); node; node = rt_slist_next(node))
-    {
-        pkt = rt_slist_entry(node, struct at_recv_pkt, list);
-        if (pkt->buff)
-        {
-            rt_free(pkt->buff);
-        }
-        if (pkt)
-        {
-            rt_free(pkt);
-            pkt = RT_NULL;
-        }
-    }
+    /* the block is the last allocated one, shrinking it gives the rest back */
+    block->size = size;
+    rt_rbb_blk_put(block);
 
-    return 0;
+    rt_sem_release(sock->recv_notice);
+
+    at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
 }
 
-/* delete and free specified list block */
-static int at_recvpkt_node_delete(rt_slist_t *rlist, rt_slist_t *node)
+/* the block at the read position, call with recv_lock held */
+static rt_rbb_blk_t at_recvbuf_current(struct at_socket *sock)
 {
-    at_recv_pkt_t pkt = RT_NULL;
-
-    if (rt_slist_isempty(rlist))
+    if (sock->recv_blk == RT_NULL)
     {
-        return 0;
+        sock->recv_blk = rt_rbb_blk_get(sock->recv_rbb);
+        sock->recv_blk_offset = 0;
     }
 
-    rt_slist_remove(rlist, node);
+    return sock->recv_blk;
+}
 
-    pkt = rt_slist_entry(node, struct at_recv_pkt, list);
-    if (pkt->buff)
+/* advance the read position in the current block, call with recv_lock held */
+static void at_recvbuf_consume(struct at_socket *sock, size_t len)
+{
+    sock->recv_blk_offset += len;
+    if (sock->recv_blk_offset == rt_rbb_blk_size(sock->recv_blk))
     {
-        rt_free(pkt->buff);
+        rt_rbb_blk_free(sock->recv_rbb, sock->recv_blk);
+        sock->recv_blk = RT_NULL;
     }
-    if (pkt)
+}
+
+/* a TCP stream with a gap can't be read or written any more, fail the socket */
+static rt_bool_t at_recv_is_failed(struct at_socket *sock)
+{
+    if (sock->recv_failed)
     {
-        rt_free(pkt);
-        pkt = RT_NULL;
+        errno = ECONNABORTED;
+        return RT_TRUE;
     }
 
-    return 0;
+    return RT_FALSE;
 }
 
-/* get a block from AT socket receive buffer list */
-static size_t at_recvpkt_get(rt_slist_t *rlist, char *mem, size_t len)
+/* get data from AT socket receive buffer */
+static size_t at_recvbuf_get(struct at_socket *sock, char *mem, size_t len)
 {
-    rt_slist_t *node = RT_NULL;
-    at_recv_pkt_t pkt = RT_NULL;
+    rt_rbb_blk_t block;
     size_t content_pos = 0, page_pos = 0;
 
-    if (rt_slist_isempty(rlist))
+    while (content_pos < len && (block = at_recvbuf_current(sock)) != RT_NULL)
     {
-        return 0;
-    }
-
-    for (node = rt_slist_first(rlist); node; node = rt_slist_next(node))
-    {
-        pkt = rt_slist_entry(node, struct at_recv_pkt, list);
-
-        page_pos = pkt->bfsz_totle - pkt->bfsz_index;
-
-        if (page_pos >= len - content_pos)
-        {
-            rt_memcpy((char *) mem + content_pos, pkt->buff + pkt->bfsz_index, len - content_pos);
-            pkt->bfsz_index += len - content_pos;
-            if (pkt->bfsz_index == pkt->bfsz_totle)
-            {
-                at_recvpkt_node_delete(rlist, node);
-            }
-            content_pos = len;
-            break;
-        }
-        else
+        page_pos = rt_rbb_blk_size(block) - sock->recv_blk_offset;
+        if (page_pos > len - content_pos)
         {
-            rt_memcpy((char *) mem + content_pos, pkt->buff + pkt->bfsz_index, page_pos);
-            content_pos += page_pos;
-            pkt->bfsz_index += page_pos;
-            at_recvpkt_node_delete(rlist, node);
+            page_pos = len - content_pos;
         }
+
+        rt_memcpy(mem + content_pos, rt_rbb_blk_buf(block) + sock->recv_blk_offset, page_pos);
+        content_pos += page_pos;
+        at_recvbuf_consume(sock, page_pos);
     }
 
     return content_pos;
 }
 
+/* there is received data not read yet */
+static rt_bool_t at_recvbuf_pending(struct at_socket *sock)
+{
+    return sock->recv_blk != RT_NULL || rt_rbb_next_blk_queue_len(sock->recv_rbb) > 0;
+}
+
 static void at_do_event_changes(struct at_socket *sock, at_event_t event, rt_bool_t is_plus)
 {
     switch (event)
@@ -275,34 +276,58 @@ static void at_do_event_clean(struct at_socket *sock, at_event_t event)
     }
 }
 
-static int alloc_empty_socket(rt_slist_t *l)
+/* data was read, the receive event stays set while more data is buffered */
+static void at_recv_event_update(struct at_socket *sock)
+{
+    at_do_event_changes(sock, AT_EVENT_RECV, RT_FALSE);
+    if (at_recvbuf_pending(sock))
+    {
+        at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+    }
+    else
+    {
+        at_do_event_clean(sock, AT_EVENT_RECV);
+    }
+}
+
+/* take the smallest free socket descriptor, returns -1 when there is none */
+static int alloc_empty_socket(struct at_socket *sock)
 {
     rt_base_t level;
-    rt_slist_t *node = RT_NULL;
-    rt_slist_t *pre_node = &_socket_list;
-    struct at_socket *at_sock = RT_NULL;
-    int idx = 0;
+    int idx;
 
     level = rt_hw_interrupt_disable();
 
-    rt_slist_init(l);
+    for (idx = 0; idx < AT_SOCKETS_NUM && _socket_table[idx]; idx++);
 
-    rt_slist_for_each(node, &_socket_list)
+    if (idx < AT_SOCKETS_NUM)
     {
-        at_sock = rt_slist_entry(node, struct at_socket, list);
-        if(at_sock->socket != idx)
-            break;
-        idx++;
-        pre_node = node;
+        _socket_table[idx] = sock;
+    }
+    else
+    {
+        idx = -1;
     }
-
-    rt_slist_insert(pre_node, l);
 
     rt_hw_interrupt_enable(level);
 
     return idx;
 }
 
+static void free_empty_socket(struct at_socket *sock)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+
+    if (sock->socket >= 0 && sock->socket < AT_SOCKETS_NUM && _socket_table[sock->socket] == sock)
+    {
+        _socket_table[sock->socket] = RT_NULL;
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+
 static struct at_socket *alloc_socket_by_device(struct at_device *device, enum at_socket_type type)
 {
     static rt_mutex_t at_slock = RT_NULL;
@@ -340,8 +365,13 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
     }
 
     sock = &(device->sockets[idx]);
-    /* the socket descriptor is the number of sockte lists */
-    sock->socket = alloc_empty_socket(&(sock->list));
+    /* the socket descriptor is the index in the socket table */
+    sock->socket = alloc_empty_socket(sock);
+    if (sock->socket < 0)
+    {
+        LOG_E("AT socket table is full(%d)!", AT_SOCKETS_NUM);
+        goto __err;
+    }
     /* the socket operations is the specify operations of the device */
     sock->ops = device->class->socket_ops;
     /* the user-data is the at device socket descriptor */
@@ -352,7 +382,9 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
     sock->rcvevent = RT_NULL;
     sock->sendevent = RT_NULL;
     sock->errevent = RT_NULL;
-    rt_slist_init(&sock->recvpkt_list);
+    sock->recv_blk = RT_NULL;
+    sock->recv_blk_offset = 0;
+    sock->recv_failed = RT_FALSE;
 #ifdef SAL_USING_POSIX
     rt_wqueue_init(&sock->wait_head);
 #endif
@@ -362,6 +394,9 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
     if ((sock->recv_notice = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO)) == RT_NULL)
     {
         LOG_E("No memory socket receive notic semaphore create.");
+        free_empty_socket(sock);
+        rt_memset(sock, 0x00, sizeof(struct at_socket));
+        sock = RT_NULL;
         goto __err;
     }
 
@@ -371,6 +406,21 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
     {
         LOG_E("No memory for socket receive mutex create.");
         rt_sem_delete(sock->recv_notice);
+        free_empty_socket(sock);
+        rt_memset(sock, 0x00, sizeof(struct at_socket));
+        sock = RT_NULL;
+        goto __err;
+    }
+
+    /* the receive buffer is allocated once here, receiving data doesn't use the heap */
+    if ((sock->recv_rbb = rt_rbb_create(AT_SOCKET_RECV_BFSZ, AT_SOCKET_RECV_BLK_NUM)) == RT_NULL)
+    {
+        LOG_E("No memory for socket receive buffer create.");
+        rt_sem_delete(sock->recv_notice);
+        rt_mutex_delete(sock->recv_lock);
+        free_empty_socket(sock);
+        rt_memset(sock, 0x00, sizeof(struct at_socket));
+        sock = RT_NULL;
         goto __err;
     }
 
@@ -378,6 +428,10 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
     return sock;
 
 __err:
+    if (sock != RT_NULL && sock->socket < 0)
+    {
+        rt_memset(sock, 0x00, sizeof(struct at_socket));
+    }
     rt_mutex_release(at_slock);
     return RT_NULL;
 }
@@ -468,34 +522,13 @@ static int free_socket(struct at_socket *sock)
         rt_mutex_delete(sock->recv_lock);
     }
 
-    if (!rt_slist_isempty(&sock->recvpkt_list))
+    if (sock->recv_rbb)
     {
-        at_recvpkt_all_delete(&sock->recvpkt_list);
+        rt_rbb_destroy(sock->recv_rbb);
     }
 
-    /* delect socket from socket list */
-    {
-        rt_base_t level;
-        rt_slist_t *node = RT_NULL;
-        struct at_socket *at_sock = RT_NULL;
-
-        level = rt_hw_interrupt_disable();
-
-        rt_slist_for_each(node, &_socket_list)
-        {
-            at_sock = rt_slist_entry(node, struct at_socket, list);
-            if (sock->socket == at_sock->socket)
-            {
-                if (at_sock && at_sock->magic == AT_SOCKET_MAGIC)
-                {
-                    rt_slist_remove(&_socket_list, &at_sock->list);
-                    break;
-                }
-            }
-        }
-
-        rt_hw_interrupt_enable(level);
-    }
+    /* delect socket from socket table */
+    free_empty_socket(sock);
 
     rt_memset(sock, 0x00, sizeof(struct at_socket));
 
@@ -648,29 +681,49 @@ static int ipaddr_to_ipstr(const struct sockaddr *sockaddr, char *ipstr)
 
 static void at_recv_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
 {
+    rt_rbb_blk_t block;
+    size_t pos = 0, size;
+
     RT_ASSERT(buff);
     RT_ASSERT(event == AT_SOCKET_EVT_RECV);
 
-    /* check the socket object status */
-    if (sock->magic != AT_SOCKET_MAGIC || sock->state == AT_SOCKET_CLOSED)
+    /* check the socket object status, nothing is added to a stream after a gap */
+    if (sock->magic != AT_SOCKET_MAGIC || sock->state == AT_SOCKET_CLOSED || sock->recv_failed)
     {
         rt_free((void *)buff);
         return;
     }
 
-    /* put receive buffer to receiver packet list */
-    rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-    if (at_recvpkt_put(&(sock->recvpkt_list), buff, bfsz) != RT_EOK)
+    /* copy the buffer of the AT device into the socket receive buffer */
+    while (pos < bfsz)
     {
-        rt_free((void *)buff);
-        rt_mutex_release(sock->recv_lock);
-        return;
-    }
-    rt_mutex_release(sock->recv_lock);
+        block = at_socket_recv_alloc(sock, bfsz - pos);
+        if (block == RT_NULL)
+        {
+            if (sock->type == AT_SOCKET_TCP)
+            {
+                /* the modem has ACKed the data, the stream can't be resumed after dropping it */
+                LOG_E("AT socket (%d) receive buffer is full, %d bytes lost, connection aborted!",
+                      sock->socket, (int) (bfsz - pos));
+                sock->recv_failed = RT_TRUE;
+                at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+                rt_sem_release(sock->recv_notice);
+            }
+            else
+            {
+                LOG_E("AT socket (%d) receive buffer is full, %d bytes dropped!", sock->socket, (int) (bfsz - pos));
+            }
+            at_do_event_changes(sock, AT_EVENT_ERROR, RT_TRUE);
+            break;
+        }
 
-    rt_sem_release(sock->recv_notice);
+        size = rt_rbb_blk_size(block);
+        rt_memcpy(rt_rbb_blk_buf(block), buff + pos, size);
+        at_socket_recv_commit(sock, block, size);
+        pos += size;
+    }
 
-    at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+    rt_free((void *)buff);
 }
 
 static void at_closed_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
@@ -779,9 +832,15 @@ int at_recvfrom(int socket, void *mem, size_t len, int flags, struct sockaddr *f
         sock->state = AT_SOCKET_CONNECT;
     }
 
+    if (at_recv_is_failed(sock))
+    {
+        result = -1;
+        goto __exit;
+    }
+
     /* receive packet list last transmission of remaining data */
     rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-    if((recv_len = at_recvpkt_get(&(sock->recvpkt_list), (char *)mem, len)) > 0)
+    if((recv_len = at_recvbuf_get(sock, (char *)mem, len)) > 0)
     {
         rt_mutex_release(sock->recv_lock);
         goto __exit;
@@ -827,12 +886,17 @@ int at_recvfrom(int socket, void *mem, size_t len, int flags, struct sockaddr *f
             result = -1;
             goto __exit;
         }
+        else if (at_recv_is_failed(sock))
+        {
+            result = -1;
+            goto __exit;
+        }
         else
         {
 
             /* get receive buffer to receiver ring buffer */
             rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-            recv_len = at_recvpkt_get(&(sock->recvpkt_list), (char *) mem, len);
+            recv_len = at_recvbuf_get(sock, (char *) mem, len);
             rt_mutex_release(sock->recv_lock);
             if (recv_len > 0)
             {
@@ -849,16 +913,8 @@ __exit:
         if (recv_len > 0)
         {
             result = recv_len;
-            at_do_event_changes(sock, AT_EVENT_RECV, RT_FALSE);
             errno = 0;
-            if (!rt_slist_isempty(&sock->recvpkt_list))
-            {
-                at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
-            }
-            else
-            {
-                at_do_event_clean(sock, AT_EVENT_RECV);
-            }
+            at_recv_event_update(sock);
         }
         else
         {
@@ -874,6 +930,116 @@ int at_recv(int s, void *mem, size_t len, int flags)
     return at_recvfrom(s, mem, len, flags, RT_NULL, RT_NULL);
 }
 
+/**
+ * Zero-copy receive: get the received data at the read position in place.
+ *
+ * @param socket AT socket descriptor
+ * @param data the data at the read position
+ * @param flags MSG_DONTWAIT: don't wait when there is no data
+ *
+ * @note The data is one block as it was received from the device, it stays valid and
+ *       isn't read by at_recv() until at_recv_consume() is called on this socket.
+ *
+ * @return >0: length of the data
+ *          0: the socket is closed by the peer
+ *         -1: error or timeout
+ */
+int at_recv_peek(int socket, const void **data, int flags)
+{
+    struct at_socket *sock = RT_NULL;
+    rt_rbb_blk_t block;
+    int timeout, result;
+
+    RT_ASSERT(data);
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        return -1;
+    }
+
+    /* set AT socket receive timeout */
+    if ((timeout = sock->recv_timeout) == 0)
+    {
+        timeout = RT_WAITING_FOREVER;
+    }
+    else
+    {
+        timeout = rt_tick_from_millisecond(timeout);
+    }
+
+    while (1)
+    {
+        if (at_recv_is_failed(sock))
+        {
+            return -1;
+        }
+
+        rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
+        block = at_recvbuf_current(sock);
+        if (block != RT_NULL)
+        {
+            *data = rt_rbb_blk_buf(block) + sock->recv_blk_offset;
+            result = rt_rbb_blk_size(block) - sock->recv_blk_offset;
+            rt_mutex_release(sock->recv_lock);
+            return result;
+        }
+        rt_mutex_release(sock->recv_lock);
+
+        /* socket passively closed, receive function return 0 */
+        if (sock->state == AT_SOCKET_CLOSED)
+        {
+            return 0;
+        }
+        else if (sock->state != AT_SOCKET_CONNECT && sock->state != AT_SOCKET_OPEN)
+        {
+            LOG_E("received data error, current socket (%d) state (%d) is error.", socket, sock->state);
+            return -1;
+        }
+
+        if ((flags & MSG_DONTWAIT) || rt_sem_take(sock->recv_notice, timeout) < 0)
+        {
+            errno = EAGAIN;
+            return -1;
+        }
+    }
+}
+
+/**
+ * Release data got by at_recv_peek().
+ *
+ * @param socket AT socket descriptor
+ * @param len the length of data to release, not larger than at_recv_peek() returned
+ *
+ * @return 0: success, -1: error
+ */
+int at_recv_consume(int socket, size_t len)
+{
+    struct at_socket *sock = RT_NULL;
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        return -1;
+    }
+
+    rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
+    if (sock->recv_blk == RT_NULL || len > rt_rbb_blk_size(sock->recv_blk) - sock->recv_blk_offset)
+    {
+        rt_mutex_release(sock->recv_lock);
+        return -1;
+    }
+    if (len > 0)
+    {
+        at_recvbuf_consume(sock, len);
+    }
+    rt_mutex_release(sock->recv_lock);
+
+    at_recv_event_update(sock);
+
+    return 0;
+}
+
 int at_sendto(int socket, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen)
 {
     struct at_socket *sock = RT_NULL;
@@ -901,6 +1067,11 @@ int at_sendto(int socket, const void *data, size_t size, int flags, const struct
             result = 0;
             goto __exit;
         }
+        else if (at_recv_is_failed(sock))
+        {
+            result = -1;
+            goto __exit;
+        }
         else if (sock->state != AT_SOCKET_CONNECT && sock->state != AT_SOCKET_OPEN)
         {
             LOG_E("send data error, current socket (%d) state (%d) is error.", socket, sock->state);
@@ -968,6 +1139,88 @@ int at_send(int socket, const void *data, size_t size, int flags)
     return at_sendto(socket, data, size, flags, RT_NULL, 0);
 }
 
+#ifdef RT_USING_SAL
+/**
+ * This function will send the buffers of a message, e.g. a network buffer chain.
+ * A TCP socket sends each buffer by its own send command straight from the buffer, so the
+ * blocks of a chain are not gathered. A UDP datagram must be one send command: it is sent
+ * as it is if it has one buffer, otherwise it is gathered into a heap buffer.
+ *
+ * @param socket the socket descriptor
+ * @param message the buffers and the destination address
+ * @param flags the send flags
+ *
+ * @return the number of bytes sent, -1 on failure
+ */
+int at_sendmsg(int socket, const struct msghdr *message, int flags)
+{
+    struct at_socket *sock;
+    const struct sockaddr *to = (const struct sockaddr *) message->msg_name;
+    char *data, *pos;
+    size_t size = 0;
+    int i, ret, sent = 0;
+
+    sock = at_get_socket(socket);
+    if (sock == RT_NULL)
+    {
+        return -1;
+    }
+
+    if (sock->type == AT_SOCKET_TCP)
+    {
+        for (i = 0; i < message->msg_iovlen; i++)
+        {
+            if (message->msg_iov[i].iov_len == 0)
+            {
+                continue;
+            }
+
+            ret = at_sendto(socket, message->msg_iov[i].iov_base, message->msg_iov[i].iov_len, flags, RT_NULL, 0);
+            if (ret > 0)
+            {
+                sent += ret;
+            }
+            /* a failed send ends the message, report the bytes sent before it */
+            if (ret != (int) message->msg_iov[i].iov_len)
+            {
+                return (sent > 0) ? sent : ret;
+            }
+        }
+
+        return sent;
+    }
+
+    if (message->msg_iovlen == 1)
+    {
+        return at_sendto(socket, message->msg_iov[0].iov_base, message->msg_iov[0].iov_len, flags,
+                         to, message->msg_namelen);
+    }
+
+    for (i = 0; i < message->msg_iovlen; i++)
+    {
+        size += message->msg_iov[i].iov_len;
+    }
+
+    data = (char *) rt_malloc(size ? size : 1);
+    if (data == RT_NULL)
+    {
+        LOG_E("No memory to gather the datagram of socket (%d).", socket);
+        return -1;
+    }
+
+    for (i = 0, pos = data; i < message->msg_iovlen; i++)
+    {
+        rt_memcpy(pos, message->msg_iov[i].iov_base, message->msg_iov[i].iov_len);
+        pos += message->msg_iov[i].iov_len;
+    }
+
+    ret = at_sendto(socket, data, size, flags, to, message->msg_namelen);
+    rt_free(data);
+
+    return ret;
+}
+#endif /* RT_USING_SAL */
+
 int at_getsockopt(int socket, int level, int optname, void *optval, socklen_t *optlen)
 {
     struct at_socket *sock;
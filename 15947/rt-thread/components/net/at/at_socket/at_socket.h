@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-06-06     chenYong     first version
+ * 2026-10-16     RT-Thread    receive into a ring block buffer per socket
+ * 2026-10-16     RT-Thread    add at_sendmsg
  */
 
 #ifndef __AT_SOCKET_H__
@@ -22,8 +24,14 @@
 extern "C" {
 #endif
 
+/* the receive buffer size of each socket */
 #ifndef AT_SOCKET_RECV_BFSZ
-#define AT_SOCKET_RECV_BFSZ            512
+#define AT_SOCKET_RECV_BFSZ            2048
+#endif
+
+/* the maximum number of received data blocks buffered by each socket */
+#ifndef AT_SOCKET_RECV_BLK_NUM
+#define AT_SOCKET_RECV_BLK_NUM         16
 #endif
 
 #define AT_DEFAULT_RECVMBOX_SIZE       10
@@ -74,16 +82,6 @@ struct at_socket_ops
     int (*at_socket)(struct at_device *device, enum at_socket_type type);
 };
 
-/* AT receive package list structure */
-struct at_recv_pkt
-{
-    rt_slist_t list;
-    size_t bfsz_totle;
-    size_t bfsz_index;
-    char *buff;
-};
-typedef struct at_recv_pkt *at_recv_pkt_t;
-
 struct at_socket
 {
     /* AT socket magic word */
@@ -101,7 +99,13 @@ struct at_socket
     /* receive semaphore, received data release semaphore */
     rt_sem_t recv_notice;
     rt_mutex_t recv_lock;
-    rt_slist_t recvpkt_list;
+    /* received data, each block is one chunk from the device */
+    rt_rbb_t recv_rbb;
+    /* the block at the read position and the bytes already read from it */
+    rt_rbb_blk_t recv_blk;
+    size_t recv_blk_offset;
+    /* TCP data was dropped because the receive buffer was full, the stream is broken */
+    rt_bool_t recv_failed;
 
     /* timeout to wait for send or received data in milliseconds */
     int32_t recv_timeout;
@@ -119,7 +123,6 @@ struct at_socket
 #ifdef SAL_USING_POSIX
     rt_wqueue_t wait_head;
 #endif
-    rt_slist_t list;
 
     /* user-specific data */
     void *user_data;
@@ -132,8 +135,13 @@ int at_bind(int socket, const struct sockaddr *name, socklen_t namelen);
 int at_connect(int socket, const struct sockaddr *name, socklen_t namelen);
 int at_sendto(int socket, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen);
 int at_send(int socket, const void *data, size_t size, int flags);
+#ifdef RT_USING_SAL
+int at_sendmsg(int socket, const struct msghdr *message, int flags);
+#endif
 int at_recvfrom(int socket, void *mem, size_t len, int flags, struct sockaddr *from, socklen_t *fromlen);
 int at_recv(int socket, void *mem, size_t len, int flags);
+int at_recv_peek(int socket, const void **data, int flags);
+int at_recv_consume(int socket, size_t len);
 int at_getsockopt(int socket, int level, int optname, void *optval, socklen_t *optlen);
 int at_setsockopt(int socket, int level, int optname, const void *optval, socklen_t optlen);
 struct hostent *at_gethostbyname(const char *name);
@@ -142,6 +150,10 @@ void at_freeaddrinfo(struct addrinfo *ai);
 
 struct at_socket *at_get_socket(int socket);
 
+/* AT device receive data straight into the socket receive buffer */
+rt_rbb_blk_t at_socket_recv_alloc(struct at_socket *sock, size_t size);
+void at_socket_recv_commit(struct at_socket *sock, rt_rbb_blk_t block, size_t size);
+
 #ifndef RT_USING_SAL
 
 #define socket(domain, type, protocol)                      at_socket(domain, type, protocol)
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Asynchronous commands of at_client.c against a scripted modem on "uart". The client
+ * runs its parser thread on POSIX threads, see client_stub.c. A test waits at most
+ * TEST_WAIT_MS for a command, so a client that never completes it fails the test instead
+ * of hanging it.
+ */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <at.h>
+
+extern void host_modem_reply(const char *data, rt_size_t size);
+
+#define TEST_RECV_BUFSZ     128
+#define TEST_TIMEOUT_MS     200
+#define TEST_WAIT_MS        2000
+#define TEST_IDLE_MS        50
+
+struct test_sync
+{
+    at_response_t resp;
+    const char *cmd;
+    int result;
+    sem_t done;
+};
+
+static at_client_t test_client;
+static sem_t test_done;
+static int test_errors;
+
+#define TEST_CHECK(expr)                                            \
+    do                                                              \
+    {                                                               \
+        if (!(expr))                                                \
+        {                                                           \
+            printf("  line %d: %s\n", __LINE__, #expr);             \
+            test_errors++;                                          \
+        }                                                           \
+    } while (0)
+
+/*
+ * The modem: "AT" and "AT+ECHO=<n>" are answered, "AT+SILENT" never is and "AT+LONG"
+ * gets a line longer than the receive buffer, without its line end.
+ */
+void host_modem_write(const char *buf, rt_size_t size)
+{
+    char reply[TEST_RECV_BUFSZ * 3];
+    int n;
+
+    if (size == 4 && strncmp(buf, "AT\r\n", 4) == 0)
+    {
+        host_modem_reply("OK\r\n", 4);
+    }
+    else if (sscanf(buf, "AT+ECHO=%d", &n) == 1)
+    {
+        n = snprintf(reply, sizeof(reply), "+ECHO: %d\r\nOK\r\n", n);
+        host_modem_reply(reply, n);
+    }
+    else if (strncmp(buf, "AT+LONG", 7) == 0)
+    {
+        memset(reply, 'x', sizeof(reply));
+        host_modem_reply(reply, sizeof(reply));
+    }
+}
+
+static rt_tick_t test_now(void)
+{
+    return rt_tick_get();
+}
+
+static int test_wait(sem_t *sem)
+{
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += TEST_WAIT_MS / 1000;
+
+    return sem_timedwait(sem, &deadline);
+}
+
+/* let the parser go back to waiting for data, with nothing in flight */
+static void test_idle(void)
+{
+    usleep(TEST_IDLE_MS * 1000);
+}
+
+static void test_req_done(at_client_t client, at_cmd_req_t req, int result)
+{
+    *(rt_tick_t *) req->user_data = test_now();
+    sem_post(&test_done);
+}
+
+static void *test_sync_entry(void *parameter)
+{
+    struct test_sync *sync = parameter;
+
+    sync->result = at_obj_exec_cmd(test_client, sync->resp, sync->cmd);
+    sem_post(&sync->done);
+
+    return RT_NULL;
+}
+
+/* run a synchronous command in another thread, returns -1 if it didn't end in time */
+static int test_exec_sync(at_response_t resp, const char *cmd, int *result)
+{
+    static struct test_sync sync;
+    pthread_t tid;
+
+    sync.resp = resp;
+    sync.cmd = cmd;
+    sync.result = -RT_ERROR;
+    sem_init(&sync.done, 0, 0);
+    pthread_create(&tid, RT_NULL, test_sync_entry, &sync);
+    if (test_wait(&sync.done) != 0)
+    {
+        /* the thread is stuck in the client, leave it */
+        pthread_detach(tid);
+        return -1;
+    }
+    pthread_join(tid, RT_NULL);
+    sem_destroy(&sync.done);
+    *result = sync.result;
+
+    return 0;
+}
+
+static void test_async_reply(void)
+{
+    at_response_t resp = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    struct at_cmd_req req;
+    rt_tick_t done = 0;
+    int value = 0;
+
+    at_cmd_req_init(&req, resp, test_req_done, &done);
+    TEST_CHECK(at_obj_exec_cmd_async(test_client, &req, "AT+ECHO=%d", 7) == RT_EOK);
+    TEST_CHECK(test_wait(&test_done) == 0);
+    TEST_CHECK(req.result == RT_EOK);
+    TEST_CHECK(at_resp_parse_line_args_by_kw(resp, "+ECHO:", "+ECHO: %d", &value) == 1 && value == 7);
+
+    at_delete_resp(resp);
+}
+
+static int test_order[2];
+static int test_order_count;
+
+static void test_req_order(at_client_t client, at_cmd_req_t req, int result)
+{
+    if (test_order_count < 2)
+    {
+        test_order[test_order_count] = *(int *) req->user_data;
+    }
+    test_order_count++;
+    sem_post(&test_done);
+}
+
+/* two commands queued back to back complete in order, each with its own response */
+static void test_async_in_order(void)
+{
+    at_response_t resp1 = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    at_response_t resp2 = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    struct at_cmd_req req1, req2;
+    int id1 = 1, id2 = 2, value1 = 0, value2 = 0;
+
+    at_cmd_req_init(&req1, resp1, test_req_order, &id1);
+    at_cmd_req_init(&req2, resp2, test_req_order, &id2);
+    TEST_CHECK(at_obj_exec_cmd_async(test_client, &req1, "AT+ECHO=%d", 11) == RT_EOK);
+    TEST_CHECK(at_obj_exec_cmd_async(test_client, &req2, "AT+ECHO=%d", 22) == RT_EOK);
+    TEST_CHECK(test_wait(&test_done) == 0);
+    TEST_CHECK(test_wait(&test_done) == 0);
+
+    TEST_CHECK(test_order_count == 2 && test_order[0] == 1 && test_order[1] == 2);
+    TEST_CHECK(req1.result == RT_EOK && req2.result == RT_EOK);
+    TEST_CHECK(at_resp_parse_line_args_by_kw(resp1, "+ECHO:", "+ECHO: %d", &value1) == 1 && value1 == 11);
+    TEST_CHECK(at_resp_parse_line_args_by_kw(resp2, "+ECHO:", "+ECHO: %d", &value2) == 1 && value2 == 22);
+
+    at_delete_resp(resp1);
+    at_delete_resp(resp2);
+}
+
+/* the parser must wake to time out a command the modem never answers */
+static void test_async_no_reply(void)
+{
+    at_response_t resp = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    struct at_cmd_req req;
+    rt_tick_t start, done = 0;
+
+    test_idle();
+    at_cmd_req_init(&req, resp, test_req_done, &done);
+    start = test_now();
+    TEST_CHECK(at_obj_exec_cmd_async(test_client, &req, "AT+SILENT") == RT_EOK);
+    TEST_CHECK(test_wait(&test_done) == 0);
+    TEST_CHECK(req.result == -RT_ETIMEOUT);
+    TEST_CHECK(done - start >= TEST_TIMEOUT_MS && done - start < TEST_TIMEOUT_MS * 2);
+
+    at_delete_resp(resp);
+}
+
+/* a synchronous command waits for the unanswered one to time out, then runs */
+static void test_sync_after_async(void)
+{
+    at_response_t async_resp = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    at_response_t resp = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    struct at_cmd_req req;
+    rt_tick_t start, done = 0;
+    int result = -RT_ERROR;
+
+    test_idle();
+    at_cmd_req_init(&req, async_resp, test_req_done, &done);
+    start = test_now();
+    TEST_CHECK(at_obj_exec_cmd_async(test_client, &req, "AT+SILENT") == RT_EOK);
+    TEST_CHECK(test_exec_sync(resp, "AT", &result) == 0);
+    TEST_CHECK(result == RT_EOK);
+    TEST_CHECK(test_wait(&test_done) == 0);
+    TEST_CHECK(req.result == -RT_ETIMEOUT);
+    TEST_CHECK(done - start >= TEST_TIMEOUT_MS && done - start < TEST_TIMEOUT_MS * 2);
+
+    at_delete_resp(resp);
+    at_delete_resp(async_resp);
+}
+
+/* a command times out while an overlong line is being dropped */
+static void test_overlong_line(void)
+{
+    at_response_t async_resp = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    at_response_t resp = at_create_resp(64, 0, TEST_TIMEOUT_MS);
+    struct at_cmd_req req;
+    rt_tick_t start, done = 0;
+    int result = -RT_ERROR;
+
+    test_idle();
+    at_cmd_req_init(&req, async_resp, test_req_done, &done);
+    start = test_now();
+    TEST_CHECK(at_obj_exec_cmd_async(test_client, &req, "AT+LONG") == RT_EOK);
+    TEST_CHECK(test_wait(&test_done) == 0);
+    TEST_CHECK(req.result == -RT_ETIMEOUT);
+    TEST_CHECK(done - start >= TEST_TIMEOUT_MS && done - start < TEST_TIMEOUT_MS * 2);
+
+    /* the end of the overlong line, the client answers again after it */
+    host_modem_reply("\r\n", 2);
+    TEST_CHECK(test_exec_sync(resp, "AT", &result) == 0);
+    TEST_CHECK(result == RT_EOK);
+
+    at_delete_resp(resp);
+    at_delete_resp(async_resp);
+}
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+} test_cases[] =
+{
+    {"async command answered", test_async_reply},
+    {"async commands in order", test_async_in_order},
+    {"async command not answered", test_async_no_reply},
+    {"sync command after unanswered", test_sync_after_async},
+    {"timeout in an overlong line", test_overlong_line},
+};
+
+int main(void)
+{
+    int i, errors, failed = 0;
+
+    sem_init(&test_done, 0, 0);
+    if (at_client_init("uart", TEST_RECV_BUFSZ) != RT_EOK)
+    {
+        printf("at_client_init failed\n");
+        return 1;
+    }
+    test_client = at_client_get_first();
+
+    for (i = 0; i < (int) (sizeof(test_cases) / sizeof(test_cases[0])); i++)
+    {
+        errors = test_errors;
+        test_cases[i].run();
+        printf("%-32s %s\n", test_cases[i].name, test_errors == errors ? "ok" : "FAILED");
+        if (test_errors != errors)
+        {
+            failed++;
+        }
+    }
+    printf("%d of %d passed\n", i - failed, i);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The kernel services used by at_client.c on POSIX threads, and the serial device of the
+ * modem: "uart". What the client writes goes to host_modem_write() of the test, what the
+ * test passes to host_modem_reply() is read by the client.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#define HOST_UART_BUF_SIZE  4096
+
+struct host_thread
+{
+    pthread_t tid;
+    void (*entry)(void *parameter);
+    void *parameter;
+};
+
+struct host_sem
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    rt_uint32_t value;
+};
+
+extern void host_modem_write(const char *buf, rt_size_t size);
+
+static __thread rt_thread_t host_self;
+static pthread_mutex_t host_irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static struct rt_device host_uart;
+static pthread_mutex_t host_uart_lock = PTHREAD_MUTEX_INITIALIZER;
+static char host_uart_buf[HOST_UART_BUF_SIZE];
+static rt_size_t host_uart_len;
+
+static rt_uint64_t host_now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (rt_uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    static rt_uint64_t start;
+
+    if (start == 0)
+    {
+        start = host_now_ms() - 1;
+    }
+
+    return (rt_tick_t) (host_now_ms() - start);
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    return ms * RT_TICK_PER_SECOND / 1000;
+}
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    pthread_mutex_lock(&host_irq_lock);
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    pthread_mutex_unlock(&host_irq_lock);
+}
+
+static void *host_thread_entry(void *parameter)
+{
+    struct host_thread *thread = parameter;
+
+    host_self = (rt_thread_t) thread;
+    thread->entry(thread->parameter);
+
+    return RT_NULL;
+}
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick)
+{
+    struct host_thread *thread = calloc(1, sizeof(struct host_thread));
+
+    thread->entry = entry;
+    thread->parameter = parameter;
+
+    return (rt_thread_t) thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    struct host_thread *host = (struct host_thread *) thread;
+
+    if (pthread_create(&host->tid, RT_NULL, host_thread_entry, host) != 0)
+    {
+        return -RT_ERROR;
+    }
+    pthread_detach(host->tid);
+
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    return host_self;
+}
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    struct host_sem *sem = calloc(1, sizeof(struct host_sem));
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&sem->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&sem->lock, RT_NULL);
+    sem->value = value;
+
+    return (rt_sem_t) sem;
+}
+
+rt_err_t rt_sem_delete(rt_sem_t sem)
+{
+    struct host_sem *host = (struct host_sem *) sem;
+
+    pthread_cond_destroy(&host->cond);
+    pthread_mutex_destroy(&host->lock);
+    free(host);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    struct host_sem *host = (struct host_sem *) sem;
+    struct timespec deadline;
+    rt_err_t result = RT_EOK;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    if (time > 0)
+    {
+        rt_uint64_t ns = deadline.tv_nsec + (rt_uint64_t) time * (1000000000 / RT_TICK_PER_SECOND);
+
+        deadline.tv_sec += ns / 1000000000;
+        deadline.tv_nsec = ns % 1000000000;
+    }
+
+    pthread_mutex_lock(&host->lock);
+    while (host->value == 0)
+    {
+        if (time == 0)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+        if (time < 0)
+        {
+            pthread_cond_wait(&host->cond, &host->lock);
+        }
+        else if (pthread_cond_timedwait(&host->cond, &host->lock, &deadline) == ETIMEDOUT
+                 && host->value == 0)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+    }
+    if (result == RT_EOK)
+    {
+        host->value--;
+    }
+    pthread_mutex_unlock(&host->lock);
+
+    return result;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    struct host_sem *host = (struct host_sem *) sem;
+
+    pthread_mutex_lock(&host->lock);
+    host->value++;
+    pthread_cond_signal(&host->cond);
+    pthread_mutex_unlock(&host->lock);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
+{
+    struct host_sem *host = (struct host_sem *) sem;
+
+    if (cmd == RT_IPC_CMD_RESET)
+    {
+        pthread_mutex_lock(&host->lock);
+        host->value = arg ? (rt_uint32_t) (rt_ubase_t) arg : 0;
+        pthread_mutex_unlock(&host->lock);
+    }
+
+    return RT_EOK;
+}
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
+{
+    pthread_mutex_t *mutex = calloc(1, sizeof(pthread_mutex_t));
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    return (rt_mutex_t) mutex;
+}
+
+rt_err_t rt_mutex_delete(rt_mutex_t mutex)
+{
+    pthread_mutex_destroy((pthread_mutex_t *) mutex);
+    free(mutex);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    if (time == RT_WAITING_NO)
+    {
+        return (pthread_mutex_trylock((pthread_mutex_t *) mutex) == 0) ? RT_EOK : -RT_ETIMEOUT;
+    }
+    pthread_mutex_lock((pthread_mutex_t *) mutex);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    pthread_mutex_unlock((pthread_mutex_t *) mutex);
+
+    return RT_EOK;
+}
+
+/* the test completes its requests by callback */
+void rt_completion_done(struct rt_completion *completion)
+{
+    RT_ASSERT(0);
+}
+
+void *rt_realloc(void *ptr, rt_size_t size)
+{
+    return realloc(ptr, size);
+}
+
+int rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, fmt);
+    length = vsnprintf(buf, size, fmt, args);
+    va_end(args);
+
+    return length;
+}
+
+rt_device_t rt_device_find(const char *name)
+{
+    if (strcmp(name, "uart") != 0)
+    {
+        return RT_NULL;
+    }
+    snprintf(host_uart.parent.name, RT_NAME_MAX, "%s", name);
+    host_uart.type = RT_Device_Class_Char;
+
+    return &host_uart;
+}
+
+rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_device_close(rt_device_t dev)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_device_set_rx_indicate(rt_device_t dev, rt_err_t (*rx_ind)(rt_device_t dev, rt_size_t size))
+{
+    dev->rx_indicate = rx_ind;
+
+    return RT_EOK;
+}
+
+rt_size_t rt_device_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    pthread_mutex_lock(&host_uart_lock);
+    if (size > host_uart_len)
+    {
+        size = host_uart_len;
+    }
+    memcpy(buffer, host_uart_buf, size);
+    memmove(host_uart_buf, host_uart_buf + size, host_uart_len - size);
+    host_uart_len -= size;
+    pthread_mutex_unlock(&host_uart_lock);
+
+    return size;
+}
+
+rt_size_t rt_device_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    host_modem_write(buffer, size);
+
+    return size;
+}
+
+/* modem output, as the receive interrupt of the serial device */
+void host_modem_reply(const char *data, rt_size_t size)
+{
+    pthread_mutex_lock(&host_uart_lock);
+    RT_ASSERT(host_uart_len + size <= HOST_UART_BUF_SIZE);
+    memcpy(host_uart_buf + host_uart_len, data, size);
+    host_uart_len += size;
+    pthread_mutex_unlock(&host_uart_lock);
+
+    if (host_uart.rx_indicate)
+    {
+        host_uart.rx_indicate(&host_uart, size);
+    }
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * URC matching cost per received byte: the compiled matcher of at_urc.c against the table
+ * scan of get_urc_obj() in at_client.c, which at_recv_readline() ran after every byte
+ * before. Both see the same stream of modem output, synthetic or read from a captured log,
+ * framed into lines as at_recv_readline() does: a line ends on "\r\n" or as soon as a URC
+ * matches it. First the two are compared on every byte, then the sequences of URCs each one
+ * dispatches on its own are compared; the benchmark exits with 1 on a difference.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <at.h>
+
+extern struct at_urc_matcher *at_urc_matcher_create(const struct at_urc_table *tables, rt_size_t table_num);
+extern void at_urc_matcher_delete(struct at_urc_matcher *matcher);
+extern void at_urc_matcher_reset(struct at_urc_matcher *matcher);
+extern const struct at_urc *at_urc_matcher_feed(struct at_urc_matcher *matcher, char ch);
+
+#define BENCH_LINE_SIZE     512
+
+/* the device and socket URCs of the Air720 in the at_device package */
+static const struct at_urc air720_urc_table[] =
+{
+    {"RDY",           "\r\n",                 RT_NULL},
+    {"+PDP: DEACT",   "\r\n",                 RT_NULL},
+    {"+CPIN:",        "\r\n",                 RT_NULL},
+    {"+CREG:",        "\r\n",                 RT_NULL},
+    {"+CGREG:",       "\r\n",                 RT_NULL},
+};
+
+static const struct at_urc air720_socket_urc_table[] =
+{
+    {"",              ", CONNECT OK\r\n",     RT_NULL},
+    {"",              ", CONNECT FAIL\r\n",   RT_NULL},
+    {"",              ", ALREADY CONNECT\r\n", RT_NULL},
+    {"",              ", SEND OK\r\n",        RT_NULL},
+    {"",              ", SEND FAIL\r\n",      RT_NULL},
+    {"",              ", CLOSE OK\r\n",       RT_NULL},
+    {"",              ", CLOSED\r\n",         RT_NULL},
+    {"+RECEIVE,",     "\r\n",                 RT_NULL},
+    {"+CDNSGIP:",     "\r\n",                 RT_NULL},
+    {"+PDP:",         "\r\n",                 RT_NULL},
+    /* a URC without line end, and two that overlap it */
+    {"> ",            "",                     RT_NULL},
+    {"+X",            "Y",                    RT_NULL},
+    {"+XA",           "",                     RT_NULL},
+};
+
+static struct at_urc_table bench_tables[] =
+{
+    {sizeof(air720_urc_table) / sizeof(air720_urc_table[0]), air720_urc_table},
+    {sizeof(air720_socket_urc_table) / sizeof(air720_socket_urc_table[0]), air720_socket_urc_table},
+};
+
+/* pieces of modem output, a line end follows a third of them */
+static const char *const bench_fragments[] =
+{
+    "RDY", "\r\n", "+PDP: DEACT", "0, CONNECT OK", "1, CLOSED", "+RECEIVE,0,12:", "hello world!",
+    "OK", "ERROR", "+CDNSGIP: 1,\"a.com\",\"1.2.3.4\"", "> ", "SEND OK", "2, SEND OK", "+X", "Y",
+    "+XA", "AT+CIPSEND=0,5", "+CGREG: 0,1", "x", ",",
+};
+
+static char *bench_stream;
+static rt_size_t bench_stream_len;
+static rt_uint32_t bench_seed = 1;
+
+static rt_uint32_t bench_rand(void)
+{
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return bench_seed >> 8;
+}
+
+static rt_uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (rt_uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* the stream is the content of a log captured from the modem UART */
+static int bench_load_stream(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    long size;
+
+    if (fp == RT_NULL)
+    {
+        printf("cannot open %s\n", path);
+        return -1;
+    }
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0)
+    {
+        printf("%s is empty\n", path);
+        fclose(fp);
+        return -1;
+    }
+
+    bench_stream = malloc(size);
+    bench_stream_len = fread(bench_stream, 1, size, fp);
+    fclose(fp);
+
+    return bench_stream_len == (rt_size_t) size ? 0 : -1;
+}
+
+static void bench_make_stream(rt_size_t size)
+{
+    const int fragments = sizeof(bench_fragments) / sizeof(bench_fragments[0]);
+
+    bench_stream = malloc(size);
+    bench_stream_len = 0;
+    while (bench_stream_len + 64 < size)
+    {
+        const char *fragment = bench_fragments[bench_rand() % fragments];
+        rt_size_t len = strlen(fragment);
+
+        memcpy(bench_stream + bench_stream_len, fragment, len);
+        bench_stream_len += len;
+        if (bench_rand() % 3 == 0)
+        {
+            bench_stream[bench_stream_len++] = '\r';
+            bench_stream[bench_stream_len++] = '\n';
+        }
+    }
+}
+
+/* the table scan of get_urc_obj() */
+static const struct at_urc *bench_scan(const char *line, rt_size_t len)
+{
+    rt_size_t i, j;
+
+    for (i = 0; i < sizeof(bench_tables) / sizeof(bench_tables[0]); i++)
+    {
+        for (j = 0; j < bench_tables[i].urc_size; j++)
+        {
+            const struct at_urc *urc = &bench_tables[i].urc[j];
+            rt_size_t prefix_len = strlen(urc->cmd_prefix);
+            rt_size_t suffix_len = strlen(urc->cmd_suffix);
+
+            if (len < prefix_len + suffix_len)
+            {
+                continue;
+            }
+            if ((prefix_len ? !strncmp(line, urc->cmd_prefix, prefix_len) : 1)
+                    && (suffix_len ? !strncmp(line + len - suffix_len, urc->cmd_suffix, suffix_len) : 1))
+            {
+                return urc;
+            }
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* feed the stream byte by byte to both, returns the number of bytes where they differ */
+static rt_size_t bench_check(struct at_urc_matcher *matcher, rt_size_t *lines, rt_size_t *urcs)
+{
+    char line[BENCH_LINE_SIZE];
+    rt_size_t i, len = 0, mismatches = 0;
+
+    *lines = *urcs = 0;
+    at_urc_matcher_reset(matcher);
+    for (i = 0; i < bench_stream_len; i++)
+    {
+        const struct at_urc *compiled, *scanned;
+        char ch = bench_stream[i];
+
+        line[len++] = ch;
+        compiled = at_urc_matcher_feed(matcher, ch);
+        scanned = bench_scan(line, len);
+        if (compiled != scanned)
+        {
+            if (mismatches++ < 5)
+            {
+                printf("byte %d: compiled %s, scan %s, line \"%.*s\"\n", (int) i,
+                       compiled ? compiled->cmd_prefix : "none", scanned ? scanned->cmd_prefix : "none",
+                       (int) len, line);
+            }
+        }
+        if ((ch == '\n' && len > 1 && line[len - 2] == '\r') || scanned || len == BENCH_LINE_SIZE)
+        {
+            (*lines)++;
+            *urcs += (scanned != RT_NULL);
+            len = 0;
+            at_urc_matcher_reset(matcher);
+        }
+    }
+
+    return mismatches;
+}
+
+/* the parser loop of one of them, returns the URCs matched, the first max of them go to dispatched */
+static rt_size_t bench_run(struct at_urc_matcher *matcher, const struct at_urc **dispatched, rt_size_t max)
+{
+    char line[BENCH_LINE_SIZE];
+    rt_size_t i, len = 0, urcs = 0;
+
+    if (matcher)
+    {
+        at_urc_matcher_reset(matcher);
+    }
+    for (i = 0; i < bench_stream_len; i++)
+    {
+        const struct at_urc *urc;
+        char ch = bench_stream[i];
+
+        line[len++] = ch;
+        urc = matcher ? at_urc_matcher_feed(matcher, ch) : bench_scan(line, len);
+        if ((ch == '\n' && len > 1 && line[len - 2] == '\r') || urc || len == BENCH_LINE_SIZE)
+        {
+            if (urc && urcs < max)
+            {
+                dispatched[urcs] = urc;
+            }
+            urcs += (urc != RT_NULL);
+            len = 0;
+            if (matcher)
+            {
+                at_urc_matcher_reset(matcher);
+            }
+        }
+    }
+
+    return urcs;
+}
+
+/* each of them parses the stream on its own, returns the number of URCs dispatched differently */
+static rt_size_t bench_compare_dispatch(struct at_urc_matcher *matcher, rt_size_t urcs)
+{
+    const struct at_urc **scanned = malloc((urcs + 1) * sizeof(struct at_urc *));
+    const struct at_urc **compiled = malloc((urcs + 1) * sizeof(struct at_urc *));
+    rt_size_t i, scan_urcs, compiled_urcs, differences = 0;
+
+    scan_urcs = bench_run(RT_NULL, scanned, urcs + 1);
+    compiled_urcs = bench_run(matcher, compiled, urcs + 1);
+    if (scan_urcs != compiled_urcs)
+    {
+        printf("URCs dispatched: table scan %d, compiled %d\n", (int) scan_urcs, (int) compiled_urcs);
+        differences++;
+    }
+    for (i = 0; i < scan_urcs && i < compiled_urcs && i <= urcs; i++)
+    {
+        if (scanned[i] != compiled[i] && differences++ < 5)
+        {
+            printf("URC %d: table scan \"%s\"...\"%s\", compiled \"%s\"...\"%s\"\n", (int) i,
+                   scanned[i]->cmd_prefix, scanned[i]->cmd_suffix, compiled[i]->cmd_prefix, compiled[i]->cmd_suffix);
+        }
+    }
+
+    free(scanned);
+    free(compiled);
+
+    return differences;
+}
+
+int main(int argc, char **argv)
+{
+    struct at_urc_matcher *matcher;
+    rt_size_t size = 4 << 20;
+    rt_size_t lines, urcs, mismatches, differences, scan_urcs, compiled_urcs;
+    rt_uint64_t start, scan_ns, compiled_ns;
+    const char *log = RT_NULL;
+    int urc_num = 0, c;
+
+    while ((c = getopt(argc, argv, "f:n:s:h")) != -1)
+    {
+        switch (c)
+        {
+        case 'f':
+            log = optarg;
+            break;
+        case 'n':
+            size = strtoul(optarg, RT_NULL, 0);
+            break;
+        case 's':
+            bench_seed = strtoul(optarg, RT_NULL, 0);
+            break;
+        default:
+            printf("usage: %s [-n bytes] [-s seed] [-f modem log]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (size < 1024)
+    {
+        size = 1024;
+    }
+
+    matcher = at_urc_matcher_create(bench_tables, sizeof(bench_tables) / sizeof(bench_tables[0]));
+    if (matcher == RT_NULL)
+    {
+        printf("at_urc_matcher_create failed\n");
+        return 1;
+    }
+    for (c = 0; c < (int) (sizeof(bench_tables) / sizeof(bench_tables[0])); c++)
+    {
+        urc_num += bench_tables[c].urc_size;
+    }
+
+    if (log)
+    {
+        if (bench_load_stream(log) != 0)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        bench_make_stream(size);
+    }
+    mismatches = bench_check(matcher, &lines, &urcs);
+    printf("%d bytes, %d lines, %d URCs of %d in %d tables, %d mismatches\n", (int) bench_stream_len,
+           (int) lines, (int) urcs, urc_num, (int) (sizeof(bench_tables) / sizeof(bench_tables[0])),
+           (int) mismatches);
+    differences = bench_compare_dispatch(matcher, urcs);
+    printf("%d URCs dispatched, %d differences\n", (int) urcs, (int) differences);
+    if (mismatches || differences)
+    {
+        return 1;
+    }
+
+    start = bench_now_ns();
+    scan_urcs = bench_run(RT_NULL, RT_NULL, 0);
+    scan_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    compiled_urcs = bench_run(matcher, RT_NULL, 0);
+    compiled_ns = bench_now_ns() - start;
+
+    printf("ns per byte: table scan %.1f, compiled %.1f\n",
+           (double) scan_ns / bench_stream_len, (double) compiled_ns / bench_stream_len);
+
+    at_urc_matcher_delete(matcher);
+    free(bench_stream);
+
+    return (scan_urcs == urcs && compiled_urcs == urcs) ? 0 : 1;
+}
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2018-03-30     chenyong     first version
  * 2018-08-17     chenyong     multiple client support
+ * 2026-10-16     RT-Thread    add asynchronous command queue
  */
 
 #ifndef __AT_H__
@@ -50,6 +51,11 @@ extern "C" {
 #define AT_CLIENT_NUM_MAX              1
 #endif
 
+/* the maximum number of queued AT commands sent before their responses arrive */
+#ifndef AT_CLIENT_CMD_PIPELINE
+#define AT_CLIENT_CMD_PIPELINE         1
+#endif
+
 #define AT_CMD_EXPORT(_name_, _args_expr_, _test_, _query_, _setup_, _exec_)   \
     RT_USED static const struct at_cmd __at_cmd_##_test_##_query_##_setup_##_exec_ RT_SECTION("RtAtCmdTab") = \
     {                                                                          \
@@ -159,6 +165,41 @@ struct at_urc_table
 };
 typedef struct at_urc *at_urc_table_t;
 
+/* compiled URC matcher, see at_urc.c */
+struct at_urc_matcher;
+
+struct at_cmd_req;
+typedef void (*at_cmd_cb_t)(struct at_client *client, struct at_cmd_req *req, int result);
+
+/* asynchronous AT command request, it's owned by the caller until it's completed */
+struct at_cmd_req
+{
+    rt_list_t list;
+
+    /* response object, RT_NULL: the request is completed once the command is sent */
+    at_response_t resp;
+    /* data sent when a response line ends with the client end sign (eg: '>'),
+     * the response then continues until its final result */
+    const char *data;
+    rt_size_t data_len;
+
+    /* called in the AT client parser thread, the request can be reused in it */
+    at_cmd_cb_t callback;
+    void *user_data;
+    /* optional, done after the callback returns */
+    struct rt_completion *completion;
+
+    /* 0: success, -1: response status error, -2: timeout */
+    int result;
+    at_resp_status_t resp_status;
+    rt_bool_t data_sent;
+    rt_tick_t deadline;
+
+    rt_size_t cmd_len;
+    char cmd[AT_CMD_MAX_LEN];
+};
+typedef struct at_cmd_req *at_cmd_req_t;
+
 struct at_client
 {
     rt_device_t device;
@@ -166,12 +207,20 @@ struct at_client
     at_status_t status;
     char end_sign;
 
-    /* the current received one line data buffer */
+    /* the current received one line data, a NUL-terminated slice of the receive block */
     char *recv_line_buf;
     /* The length of the currently received one line data */
     rt_size_t recv_line_len;
     /* The maximum supported receive data length */
     rt_size_t recv_bufsz;
+    /* receive block filled by bulk device reads, bytes before recv_blk_pos are consumed */
+    char *recv_blk;
+    rt_size_t recv_blk_size;
+    rt_size_t recv_blk_pos;
+    rt_size_t recv_blk_len;
+    /* the byte under the NUL that terminates the current line */
+    char recv_line_saved;
+    rt_bool_t recv_line_patched;
     rt_sem_t rx_notice;
     rt_mutex_t lock;
 
@@ -181,6 +230,20 @@ struct at_client
 
     struct at_urc_table *urc_table;
     rt_size_t urc_table_size;
+    /* matcher used by the parser thread, and a newly compiled one waiting to replace it */
+    struct at_urc_matcher *urc_matcher;
+    struct at_urc_matcher *urc_matcher_new;
+    rt_bool_t urc_matcher_pending;
+
+    /* asynchronous commands waiting to be sent, and sent ones waiting for responses in order */
+    rt_list_t cmd_queue;
+    rt_list_t cmd_inflight;
+    rt_size_t cmd_inflight_num;
+    /* a synchronous caller waits on cmd_idle until the sent commands are completed */
+    rt_sem_t cmd_idle;
+    rt_bool_t cmd_sync_wait;
+    /* a synchronous command got the end sign prompt, queued commands wait for its data */
+    rt_bool_t cmd_prompt_hold;
 
     rt_thread_t parser;
 };
@@ -229,6 +292,10 @@ int at_obj_set_urc_table(at_client_t client, const struct at_urc * table, rt_siz
 /* AT client send commands to AT server and waiter response */
 int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr, ...);
 
+/* AT client queue commands, the response is reported by the request callback or completion */
+void at_cmd_req_init(at_cmd_req_t req, at_response_t resp, at_cmd_cb_t callback, void *user_data);
+int at_obj_exec_cmd_async(at_client_t client, at_cmd_req_t req, const char *cmd_expr, ...);
+
 /* AT response object create and delete */
 at_response_t at_create_resp(rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout);
 void at_delete_resp(at_response_t resp);
@@ -248,6 +315,7 @@ int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const
  */
 
 #define at_exec_cmd(resp, ...)                   at_obj_exec_cmd(at_client_get_first(), resp, __VA_ARGS__)
+#define at_exec_cmd_async(req, ...)              at_obj_exec_cmd_async(at_client_get_first(), req, __VA_ARGS__)
 #define at_client_wait_connect(timeout)          at_client_obj_wait_connect(at_client_get_first(), timeout)
 #define at_client_send(buf, size)                at_client_obj_send(at_client_get_first(), buf, size)
 #define at_client_recv(buf, size, timeout)       at_client_obj_recv(at_client_get_first(), buf, size, timeout)
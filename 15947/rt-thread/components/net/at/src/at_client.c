@@ -10,9 +10,13 @@
  * 2018-08-17     chenyong     multiple client support
  * 2021-03-17     Meco Man     fix a buf of leaking memory
  * 2021-07-14     Sszl         fix a buf of leaking memory
+ * 2026-10-16     RT-Thread    add asynchronous command queue
+ * 2026-10-16     RT-Thread    wake the parser when a command is sent
  */
 
 #include <at.h>
+#include <rthw.h>
+#include <rtdevice.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -37,6 +41,12 @@ extern rt_size_t at_vprintfln(rt_device_t device, const char *format, va_list ar
 extern void at_print_raw_cmd(const char *type, const char *cmd, rt_size_t size);
 extern const char *at_get_last_cmd(rt_size_t *cmd_size);
 
+extern struct at_urc_matcher *at_urc_matcher_create(const struct at_urc_table *tables, rt_size_t table_num);
+extern void at_urc_matcher_delete(struct at_urc_matcher *matcher);
+extern void at_urc_matcher_reset(struct at_urc_matcher *matcher);
+extern const struct at_urc *at_urc_matcher_feed(struct at_urc_matcher *matcher, char ch);
+extern const struct at_urc *at_urc_matcher_result(struct at_urc_matcher *matcher);
+
 /**
  * Create response object.
  *
@@ -274,6 +284,216 @@ int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const
     return resp_args_num;
 }
 
+/* the oldest sent asynchronous command, it owns the next response line */
+static struct at_cmd_req *at_cmd_inflight_head(at_client_t client)
+{
+    struct at_cmd_req *req = RT_NULL;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&client->cmd_inflight))
+    {
+        req = rt_list_entry(client->cmd_inflight.next, struct at_cmd_req, list);
+    }
+    rt_hw_interrupt_enable(level);
+
+    return req;
+}
+
+/* take the oldest sent command off the in-flight list, wake a synchronous caller when it drains */
+static void at_cmd_inflight_remove(at_client_t client, struct at_cmd_req *req)
+{
+    rt_bool_t notify = RT_FALSE;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&req->list);
+    client->cmd_inflight_num--;
+    if (client->cmd_inflight_num == 0 && client->cmd_sync_wait)
+    {
+        client->cmd_sync_wait = RT_FALSE;
+        notify = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (notify)
+    {
+        rt_sem_release(client->cmd_idle);
+    }
+}
+
+static void at_cmd_finish(at_client_t client, struct at_cmd_req *req, int result)
+{
+    /* the callback may reuse the request */
+    struct rt_completion *completion = req->completion;
+
+    req->result = result;
+    if (req->callback)
+    {
+        req->callback(client, req, result);
+    }
+    if (completion)
+    {
+        rt_completion_done(completion);
+    }
+}
+
+/* the queued command that can be sent now, call with interrupts disabled */
+static struct at_cmd_req *at_cmd_next(at_client_t client)
+{
+    struct at_cmd_req *req;
+
+    if (rt_list_isempty(&client->cmd_queue) || client->cmd_prompt_hold
+            || client->cmd_inflight_num >= AT_CLIENT_CMD_PIPELINE)
+    {
+        return RT_NULL;
+    }
+
+    req = rt_list_entry(client->cmd_queue.next, struct at_cmd_req, list);
+
+    /* a command with data is alone on the line until its prompt is answered */
+    if (client->cmd_inflight_num > 0
+            && (req->data || rt_list_entry(client->cmd_inflight.prev, struct at_cmd_req, list)->data))
+    {
+        return RT_NULL;
+    }
+
+    return req;
+}
+
+/*
+ * Send queued commands back to back while the pipeline has room. Nothing is sent
+ * while another thread holds the client lock, the holder dispatches again when it
+ * releases the lock (at_client_unlock).
+ */
+static void at_cmd_dispatch(at_client_t client)
+{
+    struct at_cmd_req *req;
+    rt_bool_t sent = RT_FALSE;
+    rt_base_t level;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        req = at_cmd_next(client);
+        rt_hw_interrupt_enable(level);
+
+        if (req == RT_NULL || rt_mutex_take(client->lock, RT_WAITING_NO) != RT_EOK)
+        {
+            break;
+        }
+
+        while (1)
+        {
+            level = rt_hw_interrupt_disable();
+            req = at_cmd_next(client);
+            if (req == RT_NULL)
+            {
+                rt_hw_interrupt_enable(level);
+                break;
+            }
+            rt_list_remove(&req->list);
+            if (req->resp)
+            {
+                /* in flight before it's sent, the response can't overtake it */
+                req->deadline = rt_tick_get() + req->resp->timeout;
+                rt_list_insert_before(&client->cmd_inflight, &req->list);
+                client->cmd_inflight_num++;
+                sent = RT_TRUE;
+            }
+            rt_hw_interrupt_enable(level);
+
+#ifdef AT_PRINT_RAW_CMD
+            at_print_raw_cmd("sendline", req->cmd, req->cmd_len);
+#endif
+            at_utils_send(client->device, 0, req->cmd, req->cmd_len);
+
+            if (req->resp == RT_NULL)
+            {
+                at_cmd_finish(client, req, RT_EOK);
+            }
+        }
+
+        /* check again, a command queued while the lock was held missed its dispatch */
+        rt_mutex_release(client->lock);
+    }
+
+    /* the parser may be waiting for data with no deadline, wake it to wait until the
+     * deadline of the commands sent now, even if the modem never answers */
+    if (sent && rt_thread_self() != client->parser)
+    {
+        rt_sem_release(client->rx_notice);
+    }
+}
+
+/* complete the sent commands whose response timed out, oldest first */
+static void at_cmd_expire(at_client_t client)
+{
+    struct at_cmd_req *req;
+    rt_bool_t expired = RT_FALSE;
+
+    while ((req = at_cmd_inflight_head(client)) != RT_NULL
+            && (rt_int32_t) (rt_tick_get() - req->deadline) >= 0)
+    {
+        at_cmd_inflight_remove(client, req);
+        LOG_W("execute command (%.*s) timeout (%d ticks)!", (int) req->cmd_len - 2, req->cmd, req->resp->timeout);
+        at_cmd_finish(client, req, -RT_ETIMEOUT);
+        expired = RT_TRUE;
+    }
+
+    if (expired)
+    {
+        at_cmd_dispatch(client);
+    }
+}
+
+/* ticks the parser can wait for data before the oldest sent command times out */
+static rt_int32_t at_cmd_wait_ticks(at_client_t client)
+{
+    struct at_cmd_req *req = at_cmd_inflight_head(client);
+    rt_int32_t ticks;
+
+    /* the CLI owns the device */
+    if (req == RT_NULL || client->status == AT_STATUS_CLI)
+    {
+        return RT_WAITING_FOREVER;
+    }
+
+    ticks = (rt_int32_t) (req->deadline - rt_tick_get());
+
+    return (ticks > 0) ? ticks : 0;
+}
+
+/* own the client for a synchronous exchange, after the sent asynchronous commands are completed */
+static void at_client_lock(at_client_t client)
+{
+    rt_base_t level;
+
+    rt_mutex_take(client->lock, RT_WAITING_FOREVER);
+
+    /* URC handlers run in the parser thread, which can't wait for itself */
+    if (rt_thread_self() == client->parser)
+    {
+        return;
+    }
+
+    level = rt_hw_interrupt_disable();
+    while (client->cmd_inflight_num > 0)
+    {
+        client->cmd_sync_wait = RT_TRUE;
+        rt_hw_interrupt_enable(level);
+        rt_sem_take(client->cmd_idle, RT_WAITING_FOREVER);
+        level = rt_hw_interrupt_disable();
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static void at_client_unlock(at_client_t client)
+{
+    rt_mutex_release(client->lock);
+    at_cmd_dispatch(client);
+}
+
 /**
  * Send commands to AT server and wait response.
  *
@@ -307,9 +527,10 @@ int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr
         return -RT_EBUSY;
     }
 
-    rt_mutex_take(client->lock, RT_WAITING_FOREVER);
+    at_client_lock(client);
 
     client->resp_status = AT_RESP_OK;
+    client->cmd_prompt_hold = RT_FALSE;
 
     if (resp != RT_NULL)
     {
@@ -346,11 +567,100 @@ int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr
 __exit:
     client->resp = RT_NULL;
 
-    rt_mutex_release(client->lock);
+    at_client_unlock(client);
 
     return result;
 }
 
+/**
+ * Initialize an asynchronous command request.
+ *
+ * @param req request object
+ * @param resp AT response object, using RT_NULL when you don't care response
+ * @param callback completion callback, can be RT_NULL
+ * @param user_data user data for the callback
+ */
+void at_cmd_req_init(at_cmd_req_t req, at_response_t resp, at_cmd_cb_t callback, void *user_data)
+{
+    RT_ASSERT(req);
+
+    rt_memset(req, 0x00, sizeof(struct at_cmd_req));
+    rt_list_init(&req->list);
+    req->resp = resp;
+    req->callback = callback;
+    req->user_data = user_data;
+}
+
+/**
+ * Queue commands to AT server without waiting for the response.
+ *
+ * The commands are sent in order by the AT client, up to AT_CLIENT_CMD_PIPELINE of them
+ * before their responses arrive, and responses are matched to them in the same order.
+ * When the response ends or times out the request callback is called in the parser
+ * thread and then the request completion is done. The request and its response object
+ * must stay valid until then.
+ *
+ * The publish thread of applications/pv_onenet_client.c queries the module status this way
+ * after a failed send. The socket operations of the AT device drivers, which live in the
+ * at_device package, still send with at_obj_exec_cmd().
+ *
+ * @param client current AT client object
+ * @param req request object, see at_cmd_req_init()
+ * @param cmd_expr AT commands expression
+ *
+ * @return 0 : queued
+ *        -1 : client object is NULL
+ *        -7 : enter AT CLI mode
+ */
+int at_obj_exec_cmd_async(at_client_t client, at_cmd_req_t req, const char *cmd_expr, ...)
+{
+    va_list args;
+    rt_size_t len;
+    rt_base_t level;
+
+    RT_ASSERT(req);
+    RT_ASSERT(cmd_expr);
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    /* check AT CLI mode */
+    if (client->status == AT_STATUS_CLI)
+    {
+        return -RT_EBUSY;
+    }
+
+    va_start(args, cmd_expr);
+    len = vsnprintf(req->cmd, sizeof(req->cmd) - 2, cmd_expr, args);
+    va_end(args);
+    if (len > sizeof(req->cmd) - 2)
+    {
+        len = sizeof(req->cmd) - 2;
+    }
+    rt_memcpy(req->cmd + len, "\r\n", 2);
+    req->cmd_len = len + 2;
+
+    req->result = RT_EOK;
+    req->resp_status = AT_RESP_OK;
+    req->data_sent = RT_FALSE;
+    if (req->resp != RT_NULL)
+    {
+        req->resp->buf_len = 0;
+        req->resp->line_counts = 0;
+    }
+
+    level = rt_hw_interrupt_disable();
+    rt_list_insert_before(&client->cmd_queue, &req->list);
+    rt_hw_interrupt_enable(level);
+
+    at_cmd_dispatch(client);
+
+    return RT_EOK;
+}
+
 /**
  * Waiting for connection to external devices.
  *
@@ -381,7 +691,7 @@ int at_client_obj_wait_connect(at_client_t client, rt_uint32_t timeout)
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(client->lock, RT_WAITING_FOREVER);
+    at_client_lock(client);
     client->resp = resp;
     rt_sem_control(client->resp_notice, RT_IPC_CMD_RESET, RT_NULL);
 
@@ -412,7 +722,7 @@ int at_client_obj_wait_connect(at_client_t client, rt_uint32_t timeout)
 
     client->resp = RT_NULL;
 
-    rt_mutex_release(client->lock);
+    at_client_unlock(client);
 
     return result;
 }
@@ -443,31 +753,25 @@ rt_size_t at_client_obj_send(at_client_t client, const char *buf, rt_size_t size
     at_print_raw_cmd("sendline", buf, size);
 #endif
 
-    rt_mutex_take(client->lock, RT_WAITING_FOREVER);
+    at_client_lock(client);
 
     len = at_utils_send(client->device, 0, buf, size);
+    /* the data answers an end sign prompt, if there was one */
+    client->cmd_prompt_hold = RT_FALSE;
 
-    rt_mutex_release(client->lock);
+    at_client_unlock(client);
 
     return len;
 }
 
-static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeout)
+/* restore the byte under the NUL that terminates the current line */
+static void at_client_line_release(at_client_t client)
 {
-    rt_err_t result = RT_EOK;
-
-    while (rt_device_read(client->device, 0, ch, 1) == 0)
+    if (client->recv_line_patched)
     {
-        result = rt_sem_take(client->rx_notice, rt_tick_from_millisecond(timeout));
-        if (result != RT_EOK)
-        {
-            return result;
-        }
-
-        rt_sem_control(client->rx_notice, RT_IPC_CMD_RESET, RT_NULL);
+        client->recv_blk[client->recv_blk_pos] = client->recv_line_saved;
+        client->recv_line_patched = RT_FALSE;
     }
-
-    return RT_EOK;
 }
 
 /**
@@ -478,7 +782,9 @@ static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeo
  * @param size  receive fixed data size
  * @param timeout  receive data timeout (ms)
  *
- * @note this function can only be used in execution function of URC data
+ * @note this function can only be used in execution function of URC data.
+ *       Bytes the parser already read past the URC line are returned first, after
+ *       that the URC line passed to the handler is no longer NUL-terminated.
  *
  * @return >0: receive data size
  *         =0: receive failed
@@ -495,7 +801,22 @@ rt_size_t at_client_obj_recv(at_client_t client, char *buf, rt_size_t size, rt_i
         return 0;
     }
 
-    while (1)
+    /* data behind the current line that is already in the receive block */
+    if (client->recv_blk_pos < client->recv_blk_len)
+    {
+        at_client_line_release(client);
+
+        len = client->recv_blk_len - client->recv_blk_pos;
+        if (len > size)
+        {
+            len = size;
+        }
+        rt_memcpy(buf, client->recv_blk + client->recv_blk_pos, len);
+        client->recv_blk_pos += len;
+        size -= len;
+    }
+
+    while (size > 0)
     {
         rt_size_t read_len;
 
@@ -543,6 +864,10 @@ void at_obj_set_end_sign(at_client_t client, char ch)
 /**
  * set URC(Unsolicited Result Code) table
  *
+ * The registered tables are compiled into one matcher that the parser thread
+ * advances once per received byte. The parser picks up the new matcher on
+ * its next byte, so this can be called while the client is running.
+ *
  * @param client current AT client object
  * @param table URC table
  * @param size table size
@@ -550,6 +875,8 @@ void at_obj_set_end_sign(at_client_t client, char ch)
 int at_obj_set_urc_table(at_client_t client, const struct at_urc *urc_table, rt_size_t table_sz)
 {
     rt_size_t idx;
+    struct at_urc_matcher *matcher, *stale;
+    rt_base_t level;
 
     if (client == RT_NULL)
     {
@@ -592,6 +919,22 @@ int at_obj_set_urc_table(at_client_t client, const struct at_urc *urc_table, rt_
 
     }
 
+    /* without a compiled matcher the parser falls back to scanning the tables */
+    matcher = at_urc_matcher_create(client->urc_table, client->urc_table_size);
+    if (matcher == RT_NULL)
+    {
+        LOG_W("AT client compile URC table failed, using table scan.");
+    }
+
+    level = rt_hw_interrupt_disable();
+    stale = client->urc_matcher_new;
+    client->urc_matcher_new = matcher;
+    client->urc_matcher_pending = RT_TRUE;
+    rt_hw_interrupt_enable(level);
+
+    /* a matcher the parser has not picked up yet */
+    at_urc_matcher_delete(stale);
+
     return RT_EOK;
 }
 
@@ -610,7 +953,8 @@ at_client_t at_client_get(const char *dev_name)
 
     for (idx = 0; idx < AT_CLIENT_NUM_MAX; idx++)
     {
-        if (rt_strcmp(at_client_table[idx].device->parent.name, dev_name) == 0)
+        if (at_client_table[idx].device
+                && rt_strcmp(at_client_table[idx].device->parent.name, dev_name) == 0)
         {
             return &at_client_table[idx];
         }
@@ -634,6 +978,32 @@ at_client_t at_client_get_first(void)
     return &at_client_table[0];
 }
 
+/* adopt a newly compiled matcher and replay the part of the line received so far */
+static void urc_matcher_update(at_client_t client)
+{
+    struct at_urc_matcher *matcher;
+    rt_base_t level;
+    rt_size_t idx;
+
+    level = rt_hw_interrupt_disable();
+    matcher = client->urc_matcher_new;
+    client->urc_matcher_new = RT_NULL;
+    client->urc_matcher_pending = RT_FALSE;
+    rt_hw_interrupt_enable(level);
+
+    at_urc_matcher_delete(client->urc_matcher);
+    client->urc_matcher = matcher;
+
+    if (matcher)
+    {
+        at_urc_matcher_reset(matcher);
+        for (idx = 0; idx < client->recv_line_len; idx++)
+        {
+            at_urc_matcher_feed(matcher, client->recv_line_buf[idx]);
+        }
+    }
+}
+
 static const struct at_urc *get_urc_obj(at_client_t client)
 {
     rt_size_t i, j, prefix_len, suffix_len;
@@ -642,6 +1012,11 @@ static const struct at_urc *get_urc_obj(at_client_t client)
     const struct at_urc *urc = RT_NULL;
     struct at_urc_table *urc_table = RT_NULL;
 
+    if (client->urc_matcher)
+    {
+        return at_urc_matcher_result(client->urc_matcher);
+    }
+
     if (client->urc_table == RT_NULL)
     {
         return RT_NULL;
@@ -674,59 +1049,334 @@ static const struct at_urc *get_urc_obj(at_client_t client)
     return RT_NULL;
 }
 
+/*
+ * Bulk read from the device into the receive block, wait for data up to the timeout.
+ * Returns -RT_EEMPTY when woken without data, a command was sent and the caller
+ * computes the wait again.
+ */
+static rt_err_t at_client_fill(at_client_t client, rt_int32_t timeout)
+{
+    /* one byte is kept for the NUL that terminates the line slice */
+    rt_size_t space = client->recv_blk_size - 1 - client->recv_blk_len;
+    rt_size_t len;
+
+    len = rt_device_read(client->device, 0, client->recv_blk + client->recv_blk_len, space);
+    if (len == 0)
+    {
+        if (rt_sem_take(client->rx_notice, timeout) != RT_EOK)
+        {
+            return -RT_ETIMEOUT;
+        }
+        rt_sem_control(client->rx_notice, RT_IPC_CMD_RESET, RT_NULL);
+
+        len = rt_device_read(client->device, 0, client->recv_blk + client->recv_blk_len, space);
+        if (len == 0)
+        {
+            return -RT_EEMPTY;
+        }
+    }
+
+    client->recv_blk_len += len;
+
+    return RT_EOK;
+}
+
+/* find the first '\n' or end sign, a machine word at a time; returns size when there is none */
+static rt_size_t at_scan_line_end(const char *buf, rt_size_t size, char end_sign)
+{
+#define AT_WORD_ONES       ((rt_ubase_t) -1 / 0xFF)
+#define AT_WORD_HIGHS      (AT_WORD_ONES * 0x80)
+#define AT_WORD_HAS_ZERO(v) (((v) - AT_WORD_ONES) & ~(v) & AT_WORD_HIGHS)
+
+    const rt_ubase_t lf = AT_WORD_ONES * '\n';
+    const rt_ubase_t es = AT_WORD_ONES * (rt_uint8_t) (end_sign ? end_sign : '\n');
+    rt_size_t idx = 0;
+
+    /* head bytes up to word alignment */
+    for (; idx < size && ((rt_ubase_t) (buf + idx) & (sizeof(rt_ubase_t) - 1)); idx++)
+    {
+        if (buf[idx] == '\n' || (end_sign && buf[idx] == end_sign))
+        {
+            return idx;
+        }
+    }
+
+    for (; idx + sizeof(rt_ubase_t) <= size; idx += sizeof(rt_ubase_t))
+    {
+        rt_ubase_t word = *(const rt_ubase_t *) (buf + idx);
+
+        if (AT_WORD_HAS_ZERO(word ^ lf) || AT_WORD_HAS_ZERO(word ^ es))
+        {
+            break;
+        }
+    }
+
+    for (; idx < size; idx++)
+    {
+        if (buf[idx] == '\n' || (end_sign && buf[idx] == end_sign))
+        {
+            return idx;
+        }
+    }
+
+    return size;
+}
+
+/* "\r\n" or the end sign at line[pos] */
+#define AT_IS_LINE_END(client, line, pos)                                           \
+    (((line)[pos] == '\n' && (pos) > 0 && (line)[(pos) - 1] == '\r')                 \
+     || ((client)->end_sign != 0 && (line)[pos] == (client)->end_sign))
+
+/* per-byte URC check over [from, to) of the line, returns the offset just past the first match or 0 */
+static rt_size_t at_recv_urc_scan(at_client_t client, rt_size_t from, rt_size_t to)
+{
+    const char *line = client->recv_line_buf;
+
+    if (client->urc_matcher)
+    {
+        for (; from < to; from++)
+        {
+            if (at_urc_matcher_feed(client->urc_matcher, line[from]))
+            {
+                return from + 1;
+            }
+        }
+    }
+    else if (client->urc_table)
+    {
+        for (; from < to; from++)
+        {
+            client->recv_line_len = from + 1;
+            if (get_urc_obj(client))
+            {
+                return from + 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Frame the next line in the receive block. The device is drained in bulk into
+ * the block, and the line is handed out as a slice of it (recv_line_buf,
+ * recv_line_len) terminated by a NUL patched over the following byte, so the
+ * data is never copied. Bytes after the line stay in the block for the next call.
+ */
 static int at_recv_readline(at_client_t client)
 {
-    rt_size_t read_len = 0;
-    char ch = 0, last_ch = 0;
+    rt_size_t line_start, scanned, end = 0;
     rt_bool_t is_full = RT_FALSE;
+    rt_err_t result;
+
+    /* drop the previous line, move a partial line to the front only when the block is full */
+    at_client_line_release(client);
+    if (client->recv_blk_pos == client->recv_blk_len)
+    {
+        client->recv_blk_pos = client->recv_blk_len = 0;
+    }
 
-    rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
+    line_start = client->recv_blk_pos;
+    scanned = 0;
+    client->recv_line_buf = client->recv_blk + line_start;
     client->recv_line_len = 0;
 
-    while (1)
+    if (client->urc_matcher)
+    {
+        at_urc_matcher_reset(client->urc_matcher);
+    }
+
+    while (end == 0)
     {
-        at_client_getchar(client, &ch, RT_WAITING_FOREVER);
+        rt_size_t avail, limit, stop;
+
+        if (line_start + scanned == client->recv_blk_len)
+        {
+            if (client->recv_blk_len == client->recv_blk_size - 1)
+            {
+                rt_memmove(client->recv_blk, client->recv_blk + line_start, scanned);
+                client->recv_blk_len = scanned;
+                client->recv_blk_pos = line_start = 0;
+                client->recv_line_buf = client->recv_blk;
+            }
+            /* wait no longer than the deadline of the oldest sent command */
+            result = at_client_fill(client, at_cmd_wait_ticks(client));
+            if (result == -RT_EEMPTY)
+            {
+                continue;
+            }
+            if (result != RT_EOK)
+            {
+                if (!is_full)
+                {
+                    /* give up the line, it's framed again from its start next time */
+                    return -RT_ETIMEOUT;
+                }
+                /* an overlong line being dropped can't be restarted, expire the commands here */
+                at_cmd_expire(client);
+                continue;
+            }
+        }
 
-        if (read_len < client->recv_bufsz)
+        if (client->urc_matcher_pending)
         {
-            client->recv_line_buf[read_len++] = ch;
-            client->recv_line_len = read_len;
+            client->recv_line_len = scanned;
+            urc_matcher_update(client);
         }
-        else
+
+        avail = client->recv_blk_len - line_start;
+        if (is_full)
         {
-            is_full = RT_TRUE;
+            /* overlong line: keep looking for its end but drop the data */
+            for (stop = scanned; stop < avail; stop++)
+            {
+                stop += at_scan_line_end(client->recv_line_buf + stop, avail - stop, client->end_sign);
+                if (stop < avail && AT_IS_LINE_END(client, client->recv_line_buf, stop))
+                {
+                    client->recv_blk_pos = line_start + stop + 1;
+                    LOG_E("read line failed. The line data length is out of buffer size(%d)!", client->recv_bufsz);
+                    client->recv_line_len = 0;
+                    return -RT_EFULL;
+                }
+            }
+            /* keep the last byte for the '\r' check */
+            client->recv_blk[line_start] = client->recv_line_buf[avail - 1];
+            client->recv_blk_len = line_start + 1;
+            scanned = 1;
+            continue;
         }
 
-        /* is newline or URC data */
-        if ((ch == '\n' && last_ch == '\r') || (client->end_sign != 0 && ch == client->end_sign)
-                || get_urc_obj(client))
+        limit = (avail < client->recv_bufsz) ? avail : client->recv_bufsz;
+        while (scanned < limit)
         {
-            if (is_full)
+            stop = at_scan_line_end(client->recv_line_buf + scanned, limit - scanned, client->end_sign) + scanned;
+
+            /* a URC can complete before the line end */
+            end = at_recv_urc_scan(client, scanned, (stop < limit) ? stop + 1 : limit);
+            if (end)
             {
-                LOG_E("read line failed. The line data length is out of buffer size(%d)!", client->recv_bufsz);
-                rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
-                client->recv_line_len = 0;
-                return -RT_EFULL;
+                break;
             }
-            break;
+            if (stop == limit)
+            {
+                scanned = limit;
+                break;
+            }
+
+            if (AT_IS_LINE_END(client, client->recv_line_buf, stop))
+            {
+                end = stop + 1;
+                break;
+            }
+            scanned = stop + 1;
+        }
+
+        if (end == 0 && scanned == client->recv_bufsz)
+        {
+            is_full = RT_TRUE;
         }
-        last_ch = ch;
     }
 
+    client->recv_line_len = end;
+    client->recv_blk_pos = line_start + end;
+    client->recv_line_saved = client->recv_blk[client->recv_blk_pos];
+    client->recv_blk[client->recv_blk_pos] = '\0';
+    client->recv_line_patched = RT_TRUE;
+
 #ifdef AT_PRINT_RAW_CMD
-    at_print_raw_cmd("recvline", client->recv_line_buf, read_len);
+    at_print_raw_cmd("recvline", client->recv_line_buf, end);
 #endif
 
-    return read_len;
+    return end;
+}
+
+/* add the current line to a response, returns RT_TRUE with the status set when the line ends it */
+static rt_bool_t at_resp_add_line(at_client_t client, at_response_t resp, at_resp_status_t *status)
+{
+    char end_ch = client->recv_line_buf[client->recv_line_len - 1];
+
+    /* current receive is response */
+    client->recv_line_buf[client->recv_line_len - 1] = '\0';
+    if (resp->buf_len + client->recv_line_len < resp->buf_size)
+    {
+        /* copy response lines, separated by '\0' */
+        rt_memcpy(resp->buf + resp->buf_len, client->recv_line_buf, client->recv_line_len);
+
+        /* update the current response information */
+        resp->buf_len += client->recv_line_len;
+        resp->line_counts++;
+    }
+    else
+    {
+        *status = AT_RESP_BUFF_FULL;
+        LOG_E("Read response buffer failed. The Response buffer size is out of buffer size(%d)!", resp->buf_size);
+    }
+    /* check response result */
+    if ((client->end_sign != 0) && (end_ch == client->end_sign) && (resp->line_num == 0))
+    {
+        /* get the end sign, return response state END_OK.*/
+        *status = AT_RESP_OK;
+    }
+    else if (rt_memcmp(client->recv_line_buf, AT_RESP_END_OK, rt_strlen(AT_RESP_END_OK)) == 0
+            && resp->line_num == 0)
+    {
+        /* get the end data by response result, return response state END_OK. */
+        *status = AT_RESP_OK;
+    }
+    else if (rt_strstr(client->recv_line_buf, AT_RESP_END_ERROR)
+            || (rt_memcmp(client->recv_line_buf, AT_RESP_END_FAIL, rt_strlen(AT_RESP_END_FAIL)) == 0))
+    {
+        *status = AT_RESP_ERROR;
+    }
+    else if (resp->line_counts == resp->line_num && resp->line_num)
+    {
+        /* get the end data by response line, return response state END_OK.*/
+        *status = AT_RESP_OK;
+    }
+    else
+    {
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+/* response line of the oldest sent asynchronous command */
+static void at_cmd_response(at_client_t client, struct at_cmd_req *req)
+{
+    if (req->data && !req->data_sent && client->end_sign != 0
+            && client->recv_line_buf[client->recv_line_len - 1] == client->end_sign)
+    {
+        /* nothing else is sent while the data command is in flight */
+        req->data_sent = RT_TRUE;
+        at_utils_send(client->device, 0, req->data, req->data_len);
+        return;
+    }
+
+    if (at_resp_add_line(client, req->resp, &req->resp_status))
+    {
+        at_cmd_inflight_remove(client, req);
+        if (req->resp_status != AT_RESP_OK)
+        {
+            LOG_E("execute command (%.*s) failed!", (int) req->cmd_len - 2, req->cmd);
+        }
+        at_cmd_finish(client, req, (req->resp_status == AT_RESP_OK) ? RT_EOK : -RT_ERROR);
+        at_cmd_dispatch(client);
+    }
 }
 
 static void client_parser(at_client_t client)
 {
     const struct at_urc *urc;
+    struct at_cmd_req *req;
+    int len;
 
     while(1)
     {
-        if (at_recv_readline(client) > 0)
+        len = at_recv_readline(client);
+        at_cmd_expire(client);
+
+        if (len > 0)
         {
             if ((urc = get_urc_obj(client)) != RT_NULL)
             {
@@ -736,55 +1386,22 @@ static void client_parser(at_client_t client)
                     urc->func(client, client->recv_line_buf, client->recv_line_len);
                 }
             }
+            else if ((req = at_cmd_inflight_head(client)) != RT_NULL)
+            {
+                at_cmd_response(client, req);
+            }
             else if (client->resp != RT_NULL)
             {
-                at_response_t resp = client->resp;
-
-                char end_ch = client->recv_line_buf[client->recv_line_len - 1];
+                rt_bool_t prompt = (client->end_sign != 0)
+                                   && (client->recv_line_buf[client->recv_line_len - 1] == client->end_sign);
 
-                /* current receive is response */
-                client->recv_line_buf[client->recv_line_len - 1] = '\0';
-                if (resp->buf_len + client->recv_line_len < resp->buf_size)
-                {
-                    /* copy response lines, separated by '\0' */
-                    rt_memcpy(resp->buf + resp->buf_len, client->recv_line_buf, client->recv_line_len);
-
-                    /* update the current response information */
-                    resp->buf_len += client->recv_line_len;
-                    resp->line_counts++;
-                }
-                else
-                {
-                    client->resp_status = AT_RESP_BUFF_FULL;
-                    LOG_E("Read response buffer failed. The Response buffer size is out of buffer size(%d)!", resp->buf_size);
-                }
-                /* check response result */
-                if ((client->end_sign != 0) && (end_ch == client->end_sign) && (resp->line_num == 0))
-                {
-                    /* get the end sign, return response state END_OK.*/
-                    client->resp_status = AT_RESP_OK;
-                }
-                else if (rt_memcmp(client->recv_line_buf, AT_RESP_END_OK, rt_strlen(AT_RESP_END_OK)) == 0
-                        && resp->line_num == 0)
-                {
-                    /* get the end data by response result, return response state END_OK. */
-                    client->resp_status = AT_RESP_OK;
-                }
-                else if (rt_strstr(client->recv_line_buf, AT_RESP_END_ERROR)
-                        || (rt_memcmp(client->recv_line_buf, AT_RESP_END_FAIL, rt_strlen(AT_RESP_END_FAIL)) == 0))
-                {
-                    client->resp_status = AT_RESP_ERROR;
-                }
-                else if (resp->line_counts == resp->line_num && resp->line_num)
-                {
-                    /* get the end data by response line, return response state END_OK.*/
-                    client->resp_status = AT_RESP_OK;
-                }
-                else
+                if (!at_resp_add_line(client, client->resp, &client->resp_status))
                 {
                     continue;
                 }
 
+                /* queued commands must not get between the prompt and its data */
+                client->cmd_prompt_hold = prompt;
                 client->resp = RT_NULL;
                 rt_sem_release(client->resp_notice);
             }
@@ -817,6 +1434,7 @@ static int at_client_para_init(at_client_t client)
 #define AT_CLIENT_LOCK_NAME            "at_c"
 #define AT_CLIENT_SEM_NAME             "at_cs"
 #define AT_CLIENT_RESP_NAME            "at_cr"
+#define AT_CLIENT_IDLE_NAME            "at_ci"
 #define AT_CLIENT_THREAD_NAME          "at_clnt"
 
     int result = RT_EOK;
@@ -825,9 +1443,12 @@ static int at_client_para_init(at_client_t client)
 
     client->status = AT_STATUS_UNINITIALIZED;
 
+    /* room for one full line plus a bulk read behind it, and the line's NUL */
     client->recv_line_len = 0;
-    client->recv_line_buf = (char *) rt_calloc(1, client->recv_bufsz);
-    if (client->recv_line_buf == RT_NULL)
+    client->recv_blk_size = client->recv_bufsz * 2 + 1;
+    client->recv_blk = (char *) rt_calloc(1, client->recv_blk_size);
+    client->recv_line_buf = client->recv_blk;
+    if (client->recv_blk == RT_NULL)
     {
         LOG_E("AT client initialize failed! No memory for receive buffer.");
         result = -RT_ENOMEM;
@@ -861,8 +1482,26 @@ static int at_client_para_init(at_client_t client)
         goto __exit;
     }
 
+    rt_snprintf(name, RT_NAME_MAX, "%s%d", AT_CLIENT_IDLE_NAME, at_client_num);
+    client->cmd_idle = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO);
+    if (client->cmd_idle == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! at_client_idle semaphore create failed!");
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+
+    rt_list_init(&client->cmd_queue);
+    rt_list_init(&client->cmd_inflight);
+    client->cmd_inflight_num = 0;
+    client->cmd_sync_wait = RT_FALSE;
+    client->cmd_prompt_hold = RT_FALSE;
+
     client->urc_table = RT_NULL;
     client->urc_table_size = 0;
+    client->urc_matcher = RT_NULL;
+    client->urc_matcher_new = RT_NULL;
+    client->urc_matcher_pending = RT_FALSE;
 
     rt_snprintf(name, RT_NAME_MAX, "%s%d", AT_CLIENT_THREAD_NAME, at_client_num);
     client->parser = rt_thread_create(name,
@@ -895,14 +1534,19 @@ __exit:
             rt_sem_delete(client->resp_notice);
         }
 
+        if (client->cmd_idle)
+        {
+            rt_sem_delete(client->cmd_idle);
+        }
+
         if (client->device)
         {
             rt_device_close(client->device);
         }
 
-        if (client->recv_line_buf)
+        if (client->recv_blk)
         {
-            rt_free(client->recv_line_buf);
+            rt_free(client->recv_blk);
         }
 
         rt_memset(client, 0x00, sizeof(struct at_client));
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <at.h>
+#include <string.h>
+
+#define LOG_TAG              "at.urc"
+#include <at_log.h>
+
+#ifdef AT_USING_CLIENT
+
+#define AT_URC_NONE                    0xFFFF
+
+/*
+ * The URC tables are compiled into two byte-driven automata that share one
+ * byte class map (class 0 is every byte that appears in no prefix/suffix):
+ *
+ *  - a prefix trie, walked from the start of the line until the first byte
+ *    that leaves it. Every node where a prefix ends is remembered, so the
+ *    URCs whose prefix matches the line so far are a short chain of nodes.
+ *  - an Aho-Corasick automaton over all suffixes with the failure links
+ *    folded into a full transition table, so it advances exactly one state
+ *    per byte and its state tells which suffixes end at the current byte.
+ *
+ * A byte that neither completes a prefix nor ends a suffix cannot produce
+ * a match, which is the common case and costs two table lookups. Only on
+ * those bytes the candidate URCs are checked, first registered wins, same
+ * as the linear scan in get_urc_obj().
+ */
+struct at_urc_matcher
+{
+    rt_uint16_t classes;
+    rt_uint8_t class_map[256];
+
+    /* prefix trie, [node * classes + class] */
+    rt_uint16_t *prefix_next;
+    /* first URC whose prefix ends at this node */
+    rt_uint16_t *prefix_urc;
+    /* nearest ancestor where a shorter prefix ends */
+    rt_uint16_t *prefix_up;
+
+    /* suffix automaton, [node * classes + class] */
+    rt_uint16_t *suffix_next;
+    /* longest suffix ending in this state, and the next shorter one */
+    rt_uint16_t *suffix_out;
+    rt_uint16_t *suffix_out_up;
+    /* stream position at which the suffix ended last */
+    rt_uint32_t *suffix_seen;
+
+    /* URCs in registration order */
+    rt_uint16_t urc_num;
+    const struct at_urc **urc;
+    /* next URC with the same prefix, in registration order */
+    rt_uint16_t *urc_next;
+    /* suffix end node, 0 for an empty suffix */
+    rt_uint16_t *urc_suffix;
+    rt_uint16_t *urc_min_len;
+
+    /* some URC has neither prefix nor suffix and matches any byte */
+    rt_bool_t always;
+
+    /* cursor */
+    rt_uint16_t prefix_state;
+    rt_uint16_t prefix_match;
+    rt_uint16_t suffix_state;
+    rt_uint32_t pos;
+    rt_uint32_t line_start;
+    const struct at_urc *hit;
+};
+
+static void urc_class_add(struct at_urc_matcher *matcher, const char *str)
+{
+    for (; *str; str++)
+    {
+        if (matcher->class_map[(rt_uint8_t) *str] == 0)
+        {
+            matcher->class_map[(rt_uint8_t) *str] = (rt_uint8_t) matcher->classes++;
+        }
+    }
+}
+
+/* insert a string into a trie whose absent edges are `none`, return its end node */
+static rt_uint16_t urc_trie_insert(struct at_urc_matcher *matcher, rt_uint16_t *next,
+                                   rt_uint16_t none, rt_uint16_t *nodes, const char *str)
+{
+    rt_uint16_t node = 0;
+
+    for (; *str; str++)
+    {
+        rt_uint16_t *edge = &next[node * matcher->classes + matcher->class_map[(rt_uint8_t) *str]];
+
+        if (*edge == none)
+        {
+            *edge = (*nodes)++;
+        }
+        node = *edge;
+    }
+
+    return node;
+}
+
+/* turn the suffix trie into a full DFA and fill the output links */
+static int urc_suffix_build(struct at_urc_matcher *matcher, rt_uint16_t nodes)
+{
+    rt_uint16_t *fail, *queue;
+    rt_uint16_t head = 0, tail = 0;
+    rt_uint16_t classes = matcher->classes;
+    rt_uint16_t node, c;
+
+    fail = (rt_uint16_t *) rt_calloc(2 * nodes, sizeof(rt_uint16_t));
+    if (fail == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    queue = fail + nodes;
+
+    /* root edges that leave the trie stay at the root (0) */
+    for (c = 0; c < classes; c++)
+    {
+        node = matcher->suffix_next[c];
+        if (node != 0)
+        {
+            fail[node] = 0;
+            queue[tail++] = node;
+        }
+    }
+
+    while (head < tail)
+    {
+        rt_uint16_t u = queue[head++];
+        rt_uint16_t *row = &matcher->suffix_next[u * classes];
+        const rt_uint16_t *fail_row = &matcher->suffix_next[fail[u] * classes];
+
+        if (matcher->suffix_out[u] == AT_URC_NONE)
+        {
+            matcher->suffix_out[u] = matcher->suffix_out[fail[u]];
+        }
+        matcher->suffix_out_up[u] = matcher->suffix_out[fail[u]];
+
+        for (c = 0; c < classes; c++)
+        {
+            if (row[c] != 0)
+            {
+                fail[row[c]] = fail_row[c];
+                queue[tail++] = row[c];
+            }
+            else
+            {
+                row[c] = fail_row[c];
+            }
+        }
+    }
+
+    rt_free(fail);
+
+    return RT_EOK;
+}
+
+/**
+ * Start matching a new line.
+ */
+void at_urc_matcher_reset(struct at_urc_matcher *matcher)
+{
+    matcher->prefix_state = 0;
+    matcher->prefix_match = (matcher->prefix_urc[0] != AT_URC_NONE) ? 0 : AT_URC_NONE;
+    matcher->suffix_state = 0;
+    matcher->line_start = matcher->pos;
+    matcher->hit = RT_NULL;
+}
+
+/**
+ * Compile URC tables into a matcher.
+ *
+ * @param tables URC tables, in registration order
+ * @param table_num number of tables
+ *
+ * @return != RT_NULL: matcher object
+ *          = RT_NULL: no memory or the tables are too large
+ */
+struct at_urc_matcher *at_urc_matcher_create(const struct at_urc_table *tables, rt_size_t table_num)
+{
+    struct at_urc_matcher *matcher;
+    rt_size_t urc_num = 0, prefix_nodes = 1, suffix_nodes = 1;
+    rt_size_t i, j, size;
+    rt_uint16_t pn = 1, sn = 1, u;
+    rt_uint8_t *p;
+
+    matcher = (struct at_urc_matcher *) rt_calloc(1, sizeof(struct at_urc_matcher));
+    if (matcher == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    matcher->classes = 1;
+    for (i = 0; i < table_num; i++)
+    {
+        for (j = 0; j < tables[i].urc_size; j++)
+        {
+            const struct at_urc *urc = &tables[i].urc[j];
+
+            urc_class_add(matcher, urc->cmd_prefix);
+            urc_class_add(matcher, urc->cmd_suffix);
+            prefix_nodes += rt_strlen(urc->cmd_prefix);
+            suffix_nodes += rt_strlen(urc->cmd_suffix);
+            urc_num++;
+        }
+    }
+
+    if (urc_num >= AT_URC_NONE || prefix_nodes >= AT_URC_NONE || suffix_nodes >= AT_URC_NONE)
+    {
+        LOG_E("URC table is too large to compile (%d URCs).", (int) urc_num);
+        rt_free(matcher);
+        return RT_NULL;
+    }
+
+    /* all arrays in one block: pointers, then 32-bit, then 16-bit */
+    size = urc_num * sizeof(const struct at_urc *)
+           + suffix_nodes * sizeof(rt_uint32_t)
+           + (prefix_nodes * matcher->classes + 2 * prefix_nodes) * sizeof(rt_uint16_t)
+           + (suffix_nodes * matcher->classes + 2 * suffix_nodes) * sizeof(rt_uint16_t)
+           + 3 * urc_num * sizeof(rt_uint16_t);
+    p = (rt_uint8_t *) rt_malloc(size);
+    if (p == RT_NULL)
+    {
+        rt_free(matcher);
+        return RT_NULL;
+    }
+
+    matcher->urc = (const struct at_urc **) p;               p += urc_num * sizeof(const struct at_urc *);
+    matcher->suffix_seen = (rt_uint32_t *) p;                p += suffix_nodes * sizeof(rt_uint32_t);
+    matcher->prefix_next = (rt_uint16_t *) p;                p += prefix_nodes * matcher->classes * sizeof(rt_uint16_t);
+    matcher->prefix_urc = (rt_uint16_t *) p;                 p += prefix_nodes * sizeof(rt_uint16_t);
+    matcher->prefix_up = (rt_uint16_t *) p;                  p += prefix_nodes * sizeof(rt_uint16_t);
+    matcher->suffix_next = (rt_uint16_t *) p;                p += suffix_nodes * matcher->classes * sizeof(rt_uint16_t);
+    matcher->suffix_out = (rt_uint16_t *) p;                 p += suffix_nodes * sizeof(rt_uint16_t);
+    matcher->suffix_out_up = (rt_uint16_t *) p;              p += suffix_nodes * sizeof(rt_uint16_t);
+    matcher->urc_next = (rt_uint16_t *) p;                   p += urc_num * sizeof(rt_uint16_t);
+    matcher->urc_suffix = (rt_uint16_t *) p;                 p += urc_num * sizeof(rt_uint16_t);
+    matcher->urc_min_len = (rt_uint16_t *) p;
+
+    rt_memset(matcher->suffix_seen, 0x00, suffix_nodes * sizeof(rt_uint32_t));
+    rt_memset(matcher->prefix_next, 0xFF, (prefix_nodes * matcher->classes + 2 * prefix_nodes) * sizeof(rt_uint16_t));
+    rt_memset(matcher->suffix_next, 0x00, suffix_nodes * matcher->classes * sizeof(rt_uint16_t));
+    rt_memset(matcher->suffix_out, 0xFF, 2 * suffix_nodes * sizeof(rt_uint16_t));
+    matcher->urc_num = (rt_uint16_t) urc_num;
+
+    u = 0;
+    for (i = 0; i < table_num; i++)
+    {
+        for (j = 0; j < tables[i].urc_size; j++, u++)
+        {
+            const struct at_urc *urc = &tables[i].urc[j];
+            rt_size_t min_len = rt_strlen(urc->cmd_prefix) + rt_strlen(urc->cmd_suffix);
+
+            matcher->urc[u] = urc;
+            matcher->urc_min_len[u] = (rt_uint16_t) min_len;
+            matcher->urc_suffix[u] = urc_trie_insert(matcher, matcher->suffix_next, 0, &sn, urc->cmd_suffix);
+            if (matcher->urc_suffix[u] != 0)
+            {
+                matcher->suffix_out[matcher->urc_suffix[u]] = matcher->urc_suffix[u];
+            }
+            else if (min_len == 0)
+            {
+                matcher->always = RT_TRUE;
+            }
+            /* prefix nodes are assigned in the second pass */
+            matcher->urc_next[u] = AT_URC_NONE;
+        }
+    }
+
+    /* link URCs per prefix node; walk backwards so each list is in registration order */
+    for (i = table_num; i-- > 0;)
+    {
+        for (j = tables[i].urc_size; j-- > 0;)
+        {
+            rt_uint16_t node;
+
+            u--;
+            node = urc_trie_insert(matcher, matcher->prefix_next, AT_URC_NONE, &pn, tables[i].urc[j].cmd_prefix);
+            matcher->urc_next[u] = matcher->prefix_urc[node];
+            matcher->prefix_urc[node] = u;
+        }
+    }
+
+    /* link each prefix end to the nearest shorter one, top-down (children always have larger ids) */
+    for (i = 0; i < pn; i++)
+    {
+        rt_uint16_t up = (matcher->prefix_urc[i] != AT_URC_NONE) ? (rt_uint16_t) i : matcher->prefix_up[i];
+        rt_uint16_t c;
+
+        for (c = 0; c < matcher->classes; c++)
+        {
+            rt_uint16_t child = matcher->prefix_next[i * matcher->classes + c];
+
+            if (child != AT_URC_NONE)
+            {
+                matcher->prefix_up[child] = up;
+            }
+        }
+    }
+
+    if (urc_suffix_build(matcher, sn) != RT_EOK)
+    {
+        rt_free(matcher->urc);
+        rt_free(matcher);
+        return RT_NULL;
+    }
+
+    LOG_D("URC matcher: %d URCs, %d classes, %d prefix states, %d suffix states, %d bytes.",
+          (int) urc_num, matcher->classes, pn, sn, (int) (sizeof(struct at_urc_matcher) + size));
+
+    at_urc_matcher_reset(matcher);
+
+    return matcher;
+}
+
+/**
+ * Delete a matcher object.
+ */
+void at_urc_matcher_delete(struct at_urc_matcher *matcher)
+{
+    if (matcher)
+    {
+        rt_free(matcher->urc);
+        rt_free(matcher);
+    }
+}
+
+/* check the candidates on a byte where a prefix completed or a suffix ended */
+static const struct at_urc *urc_resolve(struct at_urc_matcher *matcher)
+{
+    rt_uint32_t pos = matcher->pos;
+    rt_uint32_t len = pos - matcher->line_start;
+    rt_uint16_t best = AT_URC_NONE;
+    rt_uint16_t node, u;
+
+    for (node = matcher->suffix_out[matcher->suffix_state]; node != AT_URC_NONE; node = matcher->suffix_out_up[node])
+    {
+        matcher->suffix_seen[node] = pos;
+    }
+
+    for (node = matcher->prefix_match; node != AT_URC_NONE; node = matcher->prefix_up[node])
+    {
+        for (u = matcher->prefix_urc[node]; u != AT_URC_NONE && u < best; u = matcher->urc_next[u])
+        {
+            if (len >= matcher->urc_min_len[u]
+                    && (matcher->urc_suffix[u] == 0 || matcher->suffix_seen[matcher->urc_suffix[u]] == pos))
+            {
+                best = u;
+                break;
+            }
+        }
+    }
+
+    return (best != AT_URC_NONE) ? matcher->urc[best] : RT_NULL;
+}
+
+/**
+ * Feed one received byte of the current line.
+ *
+ * @return != RT_NULL: the line received so far matches this URC
+ */
+const struct at_urc *at_urc_matcher_feed(struct at_urc_matcher *matcher, char ch)
+{
+    rt_uint16_t c = matcher->class_map[(rt_uint8_t) ch];
+    rt_bool_t event = matcher->always;
+
+    matcher->pos++;
+
+    if (matcher->prefix_state != AT_URC_NONE)
+    {
+        matcher->prefix_state = matcher->prefix_next[matcher->prefix_state * matcher->classes + c];
+        if (matcher->prefix_state != AT_URC_NONE && matcher->prefix_urc[matcher->prefix_state] != AT_URC_NONE)
+        {
+            matcher->prefix_match = matcher->prefix_state;
+            event = RT_TRUE;
+        }
+    }
+
+    matcher->suffix_state = matcher->suffix_next[matcher->suffix_state * matcher->classes + c];
+    if (matcher->suffix_out[matcher->suffix_state] != AT_URC_NONE)
+    {
+        event = RT_TRUE;
+    }
+
+    matcher->hit = event ? urc_resolve(matcher) : RT_NULL;
+
+    return matcher->hit;
+}
+
+/**
+ * Get the match result for the bytes fed since the last reset.
+ */
+const struct at_urc *at_urc_matcher_result(struct at_urc_matcher *matcher)
+{
+    return matcher->hit;
+}
+
+#endif /* AT_USING_CLIENT */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    host port on pthreads
+ */
+#ifndef __ARCH_CC_H__
+#define __ARCH_CC_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <endian.h>
+#include <sys/uio.h>
+
+#ifndef BYTE_ORDER
+#define BYTE_ORDER __BYTE_ORDER
+#endif /* BYTE_ORDER */
+
+/* lwip/sockets.h takes struct iovec of the C library */
+#define iovec iovec
+
+#define PACK_STRUCT_FIELD(x) x
+#define PACK_STRUCT_STRUCT __attribute__((packed))
+#define PACK_STRUCT_BEGIN
+#define PACK_STRUCT_END
+
+/* the board lwipopts.h copies with rt_memcpy() */
+#define rt_memcpy(dst, src, len)    memcpy(dst, src, len)
+
+#define LWIP_PLATFORM_DIAG(x)   do {printf x;} while(0)
+#define LWIP_PLATFORM_ASSERT(x) do {fprintf(stderr, "Assertion \"%s\" failed at line %d in %s\n", \
+                                    x, __LINE__, __FILE__); fflush(NULL); abort();} while(0)
+
+#endif /* __ARCH_CC_H__ */
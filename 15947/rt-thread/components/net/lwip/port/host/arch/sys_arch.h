@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    host port on pthreads
+ */
+#ifndef __ARCH_SYS_ARCH_H__
+#define __ARCH_SYS_ARCH_H__
+
+#include "arch/cc.h"
+
+#define SYS_MBOX_NULL NULL
+#define SYS_SEM_NULL  NULL
+
+typedef int sys_prot_t;
+
+struct sys_sem;
+struct sys_mutex;
+struct sys_mbox;
+struct sys_thread;
+
+typedef struct sys_sem *sys_sem_t;
+typedef struct sys_mutex *sys_mutex_t;
+typedef struct sys_mbox *sys_mbox_t;
+typedef struct sys_thread *sys_thread_t;
+
+#define sys_sem_valid(sem)              (((sem) != NULL) && (*(sem) != NULL))
+#define sys_sem_set_invalid(sem)        do { if ((sem) != NULL) { *(sem) = NULL; } } while (0)
+#define sys_mutex_valid(mutex)          (((mutex) != NULL) && (*(mutex) != NULL))
+#define sys_mutex_set_invalid(mutex)    do { if ((mutex) != NULL) { *(mutex) = NULL; } } while (0)
+#define sys_mbox_valid(mbox)            (((mbox) != NULL) && (*(mbox) != NULL))
+#define sys_mbox_set_invalid(mbox)      do { if ((mbox) != NULL) { *(mbox) = NULL; } } while (0)
+
+#endif /* __ARCH_SYS_ARCH_H__ */
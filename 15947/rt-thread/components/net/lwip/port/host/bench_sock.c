@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/* built with BENCH_SOCK_LWIP for the lwIP socket API, without it for the host stack */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef BENCH_SOCK_LWIP
+#include <lwip/sockets.h>
+
+#define BENCH(name)         bench_lwip_##name
+#define b_socket            lwip_socket
+#define b_bind              lwip_bind
+#define b_listen            lwip_listen
+#define b_accept            lwip_accept
+#define b_connect           lwip_connect
+#define b_send              lwip_send
+#define b_recv              lwip_recv
+#define b_recvfrom          lwip_recvfrom
+#define b_shutdown          lwip_shutdown
+#define b_setsockopt        lwip_setsockopt
+#define b_close             lwip_close
+#define b_inet_pton         lwip_inet_pton
+#else
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#define BENCH(name)         bench_host_##name
+#define b_socket            socket
+#define b_bind              bind
+#define b_listen            listen
+#define b_accept            accept
+#define b_connect           connect
+#define b_send              send
+#define b_recv              recv
+#define b_recvfrom          recvfrom
+#define b_shutdown          shutdown
+#define b_setsockopt        setsockopt
+#define b_close             close
+#define b_inet_pton         inet_pton
+#endif
+
+#include "bench_sock.h"
+
+#define BENCH_BUF_SIZE      8192
+#define BENCH_TIMEOUT       5
+
+struct bench_server
+{
+    int sock;
+    int echo;
+    struct bench_counter *counter;
+};
+
+#ifndef BENCH_SOCK_LWIP
+double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+#endif
+
+static int BENCH(open)(int type, const char *ip, unsigned short port)
+{
+    struct sockaddr_in addr;
+    int sock, on = 1;
+
+    sock = b_socket(AF_INET, type, 0);
+    if (sock < 0)
+    {
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+
+    if (ip == NULL)
+    {
+        b_setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (b_bind(sock, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+            (type == SOCK_STREAM && b_listen(sock, 2) < 0))
+        {
+            b_close(sock);
+            return -1;
+        }
+    }
+    else
+    {
+        /* a stack that ran out of memory stalls the client, fail the test instead of hanging */
+        struct timeval timeout = {BENCH_TIMEOUT, 0};
+
+        b_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        b_setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        b_inet_pton(AF_INET, ip, &addr.sin_addr);
+        if (b_connect(sock, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+        {
+            b_close(sock);
+            return -1;
+        }
+    }
+
+    return sock;
+}
+
+static int BENCH(send_all)(int sock, const char *buf, size_t len)
+{
+    size_t sent = 0;
+    int n;
+
+    while (sent < len)
+    {
+        n = b_send(sock, buf + sent, len - sent, 0);
+        if (n <= 0)
+        {
+            return -1;
+        }
+        sent += n;
+    }
+
+    return 0;
+}
+
+static void *BENCH(tcp_server_entry)(void *parameter)
+{
+    struct bench_server *server = (struct bench_server *) parameter;
+    char *buf = malloc(BENCH_BUF_SIZE);
+    int client, n;
+
+    while ((client = b_accept(server->sock, NULL, NULL)) >= 0)
+    {
+        while ((n = b_recv(client, buf, BENCH_BUF_SIZE, 0)) > 0)
+        {
+            if (server->counter)
+            {
+                server->counter->bytes += n;
+            }
+            if (server->echo && BENCH(send_all)(client, buf, n) < 0)
+            {
+                break;
+            }
+        }
+
+        /* the sink answers the end of the stream, the sender stops its clock on it */
+        if (!server->echo && n == 0)
+        {
+            b_send(client, "k", 1, 0);
+        }
+        b_close(client);
+    }
+
+    free(buf);
+    return NULL;
+}
+
+static void *BENCH(udp_server_entry)(void *parameter)
+{
+    struct bench_server *server = (struct bench_server *) parameter;
+    char *buf = malloc(BENCH_BUF_SIZE);
+    int n;
+
+    while ((n = b_recvfrom(server->sock, buf, BENCH_BUF_SIZE, 0, NULL, NULL)) >= 0)
+    {
+        server->counter->packets++;
+        server->counter->bytes += n;
+    }
+
+    free(buf);
+    return NULL;
+}
+
+static int BENCH(server)(int type, unsigned short port, int echo, struct bench_counter *counter)
+{
+    struct bench_server *server;
+    pthread_t thread;
+
+    server = calloc(1, sizeof(struct bench_server));
+    server->sock = BENCH(open)(type, NULL, port);
+    if (server->sock < 0)
+    {
+        free(server);
+        return -1;
+    }
+    server->echo = echo;
+    server->counter = counter;
+
+    if (pthread_create(&thread, NULL, type == SOCK_STREAM ? BENCH(tcp_server_entry) : BENCH(udp_server_entry), server) != 0)
+    {
+        b_close(server->sock);
+        free(server);
+        return -1;
+    }
+    pthread_detach(thread);
+
+    return 0;
+}
+
+int BENCH(tcp_server)(unsigned short port, int echo, struct bench_counter *counter)
+{
+    return BENCH(server)(SOCK_STREAM, port, echo, counter);
+}
+
+int BENCH(udp_server)(unsigned short port, struct bench_counter *counter)
+{
+    return BENCH(server)(SOCK_DGRAM, port, 0, counter);
+}
+
+int BENCH(tcp_stream)(const char *ip, unsigned short port, size_t total, size_t chunk, double *seconds)
+{
+    char *buf, ack;
+    size_t sent, len;
+    double start;
+    int sock, result = 0;
+
+    sock = BENCH(open)(SOCK_STREAM, ip, port);
+    if (sock < 0)
+    {
+        return -1;
+    }
+
+    buf = malloc(chunk);
+    memset(buf, 0x5A, chunk);
+
+    start = bench_now();
+    for (sent = 0; sent < total; sent += len)
+    {
+        len = (total - sent < chunk) ? total - sent : chunk;
+        if (BENCH(send_all)(sock, buf, len) < 0)
+        {
+            result = -1;
+            break;
+        }
+    }
+
+    b_shutdown(sock, SHUT_WR);
+    if (result == 0 && b_recv(sock, &ack, 1, 0) != 1)
+    {
+        result = -1;
+    }
+    *seconds = bench_now() - start;
+
+    b_close(sock);
+    free(buf);
+
+    return result;
+}
+
+long BENCH(udp_stream)(const char *ip, unsigned short port, unsigned long count, size_t size, double *seconds)
+{
+    unsigned long i;
+    long sent = 0;
+    double start;
+    char *buf;
+    int sock;
+
+    sock = BENCH(open)(SOCK_DGRAM, ip, port);
+    if (sock < 0)
+    {
+        return -1;
+    }
+
+    buf = malloc(size);
+    memset(buf, 0xA5, size);
+
+    start = bench_now();
+    for (i = 0; i < count; i++)
+    {
+        /* a full pbuf pool or mailbox fails the send, counted as lost */
+        if (b_send(sock, buf, size, 0) == (int) size)
+        {
+            sent++;
+        }
+    }
+    *seconds = bench_now() - start;
+
+    b_close(sock);
+    free(buf);
+
+    return sent;
+}
+
+int BENCH(tcp_rr)(const char *ip, unsigned short port, unsigned long count, size_t size, double *samples_us)
+{
+    unsigned long i;
+    size_t got;
+    double start;
+    char *buf;
+    int sock, n, on = 1, result = 0;
+
+    sock = BENCH(open)(SOCK_STREAM, ip, port);
+    if (sock < 0)
+    {
+        return -1;
+    }
+    b_setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    buf = malloc(size);
+    memset(buf, 0x3C, size);
+
+    for (i = 0; i < count && result == 0; i++)
+    {
+        start = bench_now();
+        if (BENCH(send_all)(sock, buf, size) < 0)
+        {
+            result = -1;
+            break;
+        }
+        for (got = 0; got < size; got += n)
+        {
+            n = b_recv(sock, buf + got, size - got, 0);
+            if (n <= 0)
+            {
+                result = -1;
+                break;
+            }
+        }
+        samples_us[i] = (bench_now() - start) * 1e6;
+    }
+
+    b_close(sock);
+    free(buf);
+
+    return result;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+#ifndef __BENCH_SOCK_H__
+#define __BENCH_SOCK_H__
+
+#include <stddef.h>
+
+/*
+ * Benchmark servers and clients. bench_sock.c is built twice: bench_lwip_xxx() run on the
+ * lwIP socket API, bench_host_xxx() on the host stack, the peer at the other end of the TAP.
+ */
+
+struct bench_counter
+{
+    volatile unsigned long packets;
+    volatile unsigned long long bytes;
+};
+
+/* start a TCP server thread, echo mode sends every byte back, otherwise the received data
+ * is counted and a single byte is answered when the peer shuts down its sending side */
+int bench_lwip_tcp_server(unsigned short port, int echo, struct bench_counter *counter);
+int bench_host_tcp_server(unsigned short port, int echo, struct bench_counter *counter);
+
+/* start a UDP server thread counting the received datagrams */
+int bench_lwip_udp_server(unsigned short port, struct bench_counter *counter);
+int bench_host_udp_server(unsigned short port, struct bench_counter *counter);
+
+/* send total bytes in chunks to a TCP sink server, seconds until the sink answered */
+int bench_lwip_tcp_stream(const char *ip, unsigned short port, size_t total, size_t chunk, double *seconds);
+int bench_host_tcp_stream(const char *ip, unsigned short port, size_t total, size_t chunk, double *seconds);
+
+/* send count datagrams, return the number sent */
+long bench_lwip_udp_stream(const char *ip, unsigned short port, unsigned long count, size_t size, double *seconds);
+long bench_host_udp_stream(const char *ip, unsigned short port, unsigned long count, size_t size, double *seconds);
+
+/* request/response round trips to a TCP echo server, samples_us[count] */
+int bench_lwip_tcp_rr(const char *ip, unsigned short port, unsigned long count, size_t size, double *samples_us);
+int bench_host_tcp_rr(const char *ip, unsigned short port, unsigned long count, size_t size, double *samples_us);
+
+double bench_now(void);
+
+#endif /* __BENCH_SOCK_H__ */
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * TCP/UDP throughput, TCP round trip latency and pool usage of the lwIP stack built with
+ * the board lwipopts.h, see README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <lwip/opt.h>
+#include <lwip/init.h>
+#include <lwip/sys.h>
+#include <lwip/tcpip.h>
+#include <lwip/stats.h>
+#include <lwip/memp.h>
+#include <lwip/netif.h>
+
+#include "tapif.h"
+#include "bench_sock.h"
+
+#define BENCH_TCP_PORT      5001
+#define BENCH_ECHO_PORT     5002
+#define BENCH_UDP_PORT      5003
+
+struct bench_options
+{
+    int tap;
+    const char *ifname;
+    const char *local_ip;
+    const char *peer_ip;
+    const char *tests;
+    const char *pcap;
+    size_t total;
+    size_t chunk;
+    unsigned long count;
+};
+
+static struct netif bench_netif;
+static struct bench_counter lwip_tcp_counter, lwip_udp_counter;
+static struct bench_counter host_tcp_counter, host_udp_counter;
+
+static void bench_stats_reset(void)
+{
+    int i;
+
+    for (i = 0; i < MEMP_MAX; i++)
+    {
+        lwip_stats.memp[i]->max = lwip_stats.memp[i]->used;
+        lwip_stats.memp[i]->err = 0;
+    }
+    lwip_stats.mem.max = lwip_stats.mem.used;
+    lwip_stats.mem.err = 0;
+    memset(&lwip_stats.link, 0, sizeof(lwip_stats.link));
+    memset(&lwip_stats.tcp, 0, sizeof(lwip_stats.tcp));
+    memset(&lwip_stats.udp, 0, sizeof(lwip_stats.udp));
+}
+
+static void bench_stats_pool(const char *name, const struct stats_mem *mem)
+{
+    printf("    %-16s max %5u / %-5u err %u\n", name, (unsigned) mem->max, (unsigned) mem->avail, (unsigned) mem->err);
+}
+
+static void bench_stats_print(void)
+{
+    bench_stats_pool("PBUF_POOL", lwip_stats.memp[MEMP_PBUF_POOL]);
+    bench_stats_pool("PBUF", lwip_stats.memp[MEMP_PBUF]);
+    bench_stats_pool("TCP_SEG", lwip_stats.memp[MEMP_TCP_SEG]);
+    bench_stats_pool("TCPIP_MSG_INPKT", lwip_stats.memp[MEMP_TCPIP_MSG_INPKT]);
+    bench_stats_pool("NETBUF", lwip_stats.memp[MEMP_NETBUF]);
+    bench_stats_pool("heap", &lwip_stats.mem);
+    printf("    tcp xmit %u recv %u drop %u memerr %u, udp drop %u memerr %u, link drop %u\n",
+           lwip_stats.tcp.xmit, lwip_stats.tcp.recv, lwip_stats.tcp.drop, lwip_stats.tcp.memerr,
+           lwip_stats.udp.drop, lwip_stats.udp.memerr, lwip_stats.link.drop);
+}
+
+static void bench_tcp(const struct bench_options *opt, int rx)
+{
+    double seconds = 0;
+    int result;
+
+    bench_stats_reset();
+    if (rx)
+    {
+        result = bench_host_tcp_stream(opt->local_ip, BENCH_TCP_PORT, opt->total, opt->chunk, &seconds);
+    }
+    else
+    {
+        result = bench_lwip_tcp_stream(opt->tap ? opt->peer_ip : opt->local_ip, BENCH_TCP_PORT,
+                                       opt->total, opt->chunk, &seconds);
+    }
+
+    if (result < 0)
+    {
+        printf("tcp %s: failed\n", rx ? "rx" : "tx");
+        bench_stats_print();
+        return;
+    }
+
+    printf("tcp %s: %lu bytes in %.3f s, %.2f Mbit/s\n", rx ? "rx" : "tx",
+           (unsigned long) opt->total, seconds, opt->total * 8 / seconds / 1e6);
+    bench_stats_print();
+}
+
+static void bench_udp(const struct bench_options *opt, int rx)
+{
+    struct bench_counter *counter;
+    unsigned long before;
+    double seconds = 0;
+    long sent;
+
+    counter = (rx || !opt->tap) ? &lwip_udp_counter : &host_udp_counter;
+    before = counter->packets;
+
+    bench_stats_reset();
+    if (rx)
+    {
+        sent = bench_host_udp_stream(opt->local_ip, BENCH_UDP_PORT, opt->count, opt->chunk, &seconds);
+    }
+    else
+    {
+        sent = bench_lwip_udp_stream(opt->tap ? opt->peer_ip : opt->local_ip, BENCH_UDP_PORT,
+                                     opt->count, opt->chunk, &seconds);
+    }
+
+    if (sent < 0)
+    {
+        printf("udp %s: failed\n", rx ? "rx" : "tx");
+        return;
+    }
+
+    /* let the receiver drain what is still queued */
+    usleep(200 * 1000);
+
+    printf("udp %s: %ld of %lu datagrams sent in %.3f s, %.0f pps, %.2f Mbit/s, %lu received\n",
+           rx ? "rx" : "tx", sent, opt->count, seconds, sent / seconds,
+           sent * opt->chunk * 8 / seconds / 1e6, counter->packets - before);
+    bench_stats_print();
+}
+
+static int bench_compare(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+static void bench_rr(const struct bench_options *opt)
+{
+    double *samples, sum = 0;
+    unsigned long i;
+
+    samples = calloc(opt->count, sizeof(double));
+
+    bench_stats_reset();
+    if (bench_lwip_tcp_rr(opt->tap ? opt->peer_ip : opt->local_ip, BENCH_ECHO_PORT,
+                          opt->count, opt->chunk, samples) < 0)
+    {
+        printf("tcp rr: failed\n");
+        bench_stats_print();
+        free(samples);
+        return;
+    }
+
+    qsort(samples, opt->count, sizeof(double), bench_compare);
+    for (i = 0; i < opt->count; i++)
+    {
+        sum += samples[i];
+    }
+
+    printf("tcp rr: %lu x %lu bytes, us min %.1f avg %.1f p50 %.1f p99 %.1f max %.1f\n",
+           opt->count, (unsigned long) opt->chunk, samples[0], sum / opt->count,
+           samples[opt->count / 2], samples[opt->count * 99 / 100], samples[opt->count - 1]);
+    bench_stats_print();
+
+    free(samples);
+}
+
+static void bench_tcpip_init_done(void *arg)
+{
+    sys_sem_signal((sys_sem_t *) arg);
+}
+
+static int bench_netif_init(const struct bench_options *opt)
+{
+    static struct tapif_config tap_config;
+    ip4_addr_t ipaddr, netmask, gw;
+    sys_sem_t init_done;
+    FILE *pcap = NULL;
+
+    sys_sem_new(&init_done, 0);
+    tcpip_init(bench_tcpip_init_done, &init_done);
+    sys_sem_wait(&init_done);
+    sys_sem_free(&init_done);
+
+    if (opt->pcap)
+    {
+        pcap = fopen(opt->pcap, "wb");
+        if (pcap == NULL)
+        {
+            perror(opt->pcap);
+            return -1;
+        }
+    }
+
+    ip4addr_aton(opt->local_ip, &ipaddr);
+    ip4addr_aton("255.255.255.0", &netmask);
+    ip4addr_aton(opt->tap ? opt->peer_ip : opt->local_ip, &gw);
+
+    tap_config.name = opt->ifname;
+    tap_config.pcap = pcap;
+
+    LOCK_TCPIP_CORE();
+    if (netif_add(&bench_netif, &ipaddr, &netmask, &gw, opt->tap ? &tap_config : NULL,
+                  opt->tap ? tapif_init : nullif_init, tcpip_input) == NULL)
+    {
+        UNLOCK_TCPIP_CORE();
+        printf("add netif failed\n");
+        return -1;
+    }
+    netif_set_default(&bench_netif);
+    netif_set_up(&bench_netif);
+    UNLOCK_TCPIP_CORE();
+
+    return 0;
+}
+
+static void bench_usage(const char *name)
+{
+    printf("usage: %s [-m loop|tap] [-i tap0] [-a local_ip] [-p peer_ip] [-t tcp,udp,rr]\n"
+           "          [-n total_bytes] [-l chunk_bytes] [-c count] [-w capture.pcap]\n"
+           "  loop: traffic to the lwIP address is looped back inside the stack (default)\n"
+           "  tap:  lwIP on the TAP device, the host stack at peer_ip is the other end\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    struct bench_options opt;
+    int c;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.ifname = "tap0";
+    opt.peer_ip = "192.168.7.1";
+    opt.tests = "tcp,udp,rr";
+    opt.total = 16 * 1024 * 1024;
+    opt.chunk = 1460;
+    opt.count = 2000;
+
+    while ((c = getopt(argc, argv, "m:i:a:p:t:n:l:c:w:h")) != -1)
+    {
+        switch (c)
+        {
+        case 'm': opt.tap = (strcmp(optarg, "tap") == 0); break;
+        case 'i': opt.ifname = optarg; break;
+        case 'a': opt.local_ip = optarg; break;
+        case 'p': opt.peer_ip = optarg; break;
+        case 't': opt.tests = optarg; break;
+        case 'n': opt.total = strtoul(optarg, NULL, 0); break;
+        case 'l': opt.chunk = strtoul(optarg, NULL, 0); break;
+        case 'c': opt.count = strtoul(optarg, NULL, 0); break;
+        case 'w': opt.pcap = optarg; break;
+        default:
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (opt.local_ip == NULL)
+    {
+        opt.local_ip = opt.tap ? "192.168.7.2" : "10.0.0.2";
+    }
+    if (opt.chunk == 0 || opt.count == 0)
+    {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    if (bench_netif_init(&opt) < 0)
+    {
+        return 1;
+    }
+
+    if (bench_lwip_tcp_server(BENCH_TCP_PORT, 0, &lwip_tcp_counter) < 0 ||
+        bench_lwip_tcp_server(BENCH_ECHO_PORT, 1, NULL) < 0 ||
+        bench_lwip_udp_server(BENCH_UDP_PORT, &lwip_udp_counter) < 0)
+    {
+        printf("start lwIP servers failed\n");
+        return 1;
+    }
+
+    if (opt.tap &&
+        (bench_host_tcp_server(BENCH_TCP_PORT, 0, &host_tcp_counter) < 0 ||
+         bench_host_tcp_server(BENCH_ECHO_PORT, 1, NULL) < 0 ||
+         bench_host_udp_server(BENCH_UDP_PORT, &host_udp_counter) < 0))
+    {
+        printf("start host servers failed, is another instance running?\n");
+        return 1;
+    }
+
+    printf("lwIP %u.%u.%u, %s mode %s, PBUF_POOL_SIZE %d, TCP_WND %d, TCP_SND_BUF %d, MEM_SIZE %d\n",
+           LWIP_VERSION_MAJOR, LWIP_VERSION_MINOR, LWIP_VERSION_REVISION, opt.tap ? "tap" : "loop", opt.local_ip,
+           PBUF_POOL_SIZE, TCP_WND, TCP_SND_BUF, MEM_SIZE);
+
+    if (strstr(opt.tests, "tcp"))
+    {
+        bench_tcp(&opt, 0);
+        if (opt.tap)
+        {
+            bench_tcp(&opt, 1);
+        }
+    }
+    if (strstr(opt.tests, "udp"))
+    {
+        bench_udp(&opt, 0);
+        if (opt.tap)
+        {
+            bench_udp(&opt, 1);
+        }
+    }
+    if (strstr(opt.tests, "rr"))
+    {
+        bench_rr(&opt);
+    }
+
+    if (opt.pcap)
+    {
+        fflush(NULL);
+    }
+
+    return 0;
+}
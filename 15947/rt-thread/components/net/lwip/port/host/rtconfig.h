@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    host port on pthreads
+ */
+
+/*
+ * Configuration of the host build, read by the board lwipopts.h in place of the BSP
+ * rtconfig.h. The values are the Kconfig defaults of RT_USING_LWIP, each of them can
+ * be overridden from the make command line, e.g. make D="-DRT_LWIP_TCP_WND=16384".
+ */
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+#define RT_USING_LWIP
+#define RT_USING_LWIP212
+#define RT_USING_LWIP_VER_NUM 0x20102
+
+#ifndef RT_LWIP_MEM_ALIGNMENT
+#define RT_LWIP_MEM_ALIGNMENT 8
+#endif
+#define RT_LWIP_ICMP
+#define RT_LWIP_DNS
+#define RT_LWIP_UDP
+#define RT_LWIP_TCP
+
+#ifndef RT_MEMP_NUM_NETCONN
+#define RT_MEMP_NUM_NETCONN 8
+#endif
+#ifndef RT_LWIP_PBUF_NUM
+#define RT_LWIP_PBUF_NUM 16
+#endif
+#ifndef RT_LWIP_RAW_PCB_NUM
+#define RT_LWIP_RAW_PCB_NUM 4
+#endif
+#ifndef RT_LWIP_UDP_PCB_NUM
+#define RT_LWIP_UDP_PCB_NUM 4
+#endif
+#ifndef RT_LWIP_TCP_PCB_NUM
+#define RT_LWIP_TCP_PCB_NUM 4
+#endif
+#ifndef RT_LWIP_TCP_SEG_NUM
+#define RT_LWIP_TCP_SEG_NUM 40
+#endif
+#ifndef RT_LWIP_TCP_SND_BUF
+#define RT_LWIP_TCP_SND_BUF 8196
+#endif
+#ifndef RT_LWIP_TCP_WND
+#define RT_LWIP_TCP_WND 8196
+#endif
+#define RT_LWIP_TCPTHREAD_PRIORITY 10
+#ifndef RT_LWIP_TCPTHREAD_MBOX_SIZE
+#define RT_LWIP_TCPTHREAD_MBOX_SIZE 8
+#endif
+#define RT_LWIP_TCPTHREAD_STACKSIZE 4096
+
+/* the benchmark reads the pool and heap usage from the lwIP statistics */
+#define RT_LWIP_STATS
+
+/* the BSD names belong to the host C library, the benchmark calls lwip_xxx() */
+#define LWIP_COMPAT_SOCKETS 0
+/* traffic to the address of a netif itself is looped back, used by the loop mode */
+#define LWIP_NETIF_LOOPBACK 1
+
+#endif /* RT_CONFIG_H__ */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+#ifndef __RT_THREAD_H__
+#define __RT_THREAD_H__
+
+/*
+ * The lwIP sources include rtthread.h for the netdev and SAL hooks. The host build has
+ * neither, only the configuration is needed.
+ */
+#include <rtconfig.h>
+
+#endif /* __RT_THREAD_H__ */
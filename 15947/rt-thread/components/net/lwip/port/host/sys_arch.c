@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    host port on pthreads
+ */
+
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+
+#include <lwip/opt.h>
+#include <lwip/sys.h>
+#include <lwip/stats.h>
+#include <lwip/netif.h>
+
+struct sys_sem
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    unsigned int count;
+};
+
+struct sys_mutex
+{
+    pthread_mutex_t lock;
+};
+
+struct sys_mbox
+{
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    int size;
+    int head;
+    int count;
+    void *msgs[];
+};
+
+struct sys_thread
+{
+    pthread_t thread;
+    lwip_thread_fn function;
+    void *arg;
+};
+
+static pthread_mutex_t sys_prot_lock;
+
+static struct timespec sys_start;
+
+/* absolute CLOCK_MONOTONIC time timeout milliseconds from now */
+static void sys_deadline(struct timespec *ts, u32_t timeout)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += timeout / 1000;
+    ts->tv_nsec += (long)(timeout % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L)
+    {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static void sys_cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+void sys_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&sys_prot_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    clock_gettime(CLOCK_MONOTONIC, &sys_start);
+}
+
+u32_t sys_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u32_t)((ts.tv_sec - sys_start.tv_sec) * 1000 + (ts.tv_nsec - sys_start.tv_nsec) / 1000000L);
+}
+
+u32_t sys_jiffies(void)
+{
+    return sys_now();
+}
+
+sys_prot_t sys_arch_protect(void)
+{
+    pthread_mutex_lock(&sys_prot_lock);
+    return 0;
+}
+
+void sys_arch_unprotect(sys_prot_t pval)
+{
+    LWIP_UNUSED_ARG(pval);
+    pthread_mutex_unlock(&sys_prot_lock);
+}
+
+err_t sys_sem_new(sys_sem_t *sem, u8_t count)
+{
+    struct sys_sem *s = (struct sys_sem *) calloc(1, sizeof(struct sys_sem));
+
+    if (s == NULL)
+    {
+        SYS_STATS_INC(sem.err);
+        return ERR_MEM;
+    }
+
+    pthread_mutex_init(&s->lock, NULL);
+    sys_cond_init(&s->cond);
+    s->count = count;
+    *sem = s;
+    SYS_STATS_INC_USED(sem);
+
+    return ERR_OK;
+}
+
+void sys_sem_free(sys_sem_t *sem)
+{
+    struct sys_sem *s = *sem;
+
+    pthread_cond_destroy(&s->cond);
+    pthread_mutex_destroy(&s->lock);
+    free(s);
+    SYS_STATS_DEC(sem.used);
+}
+
+void sys_sem_signal(sys_sem_t *sem)
+{
+    struct sys_sem *s = *sem;
+
+    pthread_mutex_lock(&s->lock);
+    s->count++;
+    pthread_cond_signal(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+}
+
+u32_t sys_arch_sem_wait(sys_sem_t *sem, u32_t timeout)
+{
+    struct sys_sem *s = *sem;
+    struct timespec deadline;
+    u32_t start = sys_now();
+
+    if (timeout)
+    {
+        sys_deadline(&deadline, timeout);
+    }
+
+    pthread_mutex_lock(&s->lock);
+    while (s->count == 0)
+    {
+        if (timeout == 0)
+        {
+            pthread_cond_wait(&s->cond, &s->lock);
+        }
+        else if (pthread_cond_timedwait(&s->cond, &s->lock, &deadline) == ETIMEDOUT && s->count == 0)
+        {
+            pthread_mutex_unlock(&s->lock);
+            return SYS_ARCH_TIMEOUT;
+        }
+    }
+    s->count--;
+    pthread_mutex_unlock(&s->lock);
+
+    return sys_now() - start;
+}
+
+err_t sys_mutex_new(sys_mutex_t *mutex)
+{
+    struct sys_mutex *m = (struct sys_mutex *) calloc(1, sizeof(struct sys_mutex));
+
+    if (m == NULL)
+    {
+        SYS_STATS_INC(mutex.err);
+        return ERR_MEM;
+    }
+
+    pthread_mutex_init(&m->lock, NULL);
+    *mutex = m;
+    SYS_STATS_INC_USED(mutex);
+
+    return ERR_OK;
+}
+
+void sys_mutex_free(sys_mutex_t *mutex)
+{
+    pthread_mutex_destroy(&(*mutex)->lock);
+    free(*mutex);
+    SYS_STATS_DEC(mutex.used);
+}
+
+void sys_mutex_lock(sys_mutex_t *mutex)
+{
+    pthread_mutex_lock(&(*mutex)->lock);
+}
+
+void sys_mutex_unlock(sys_mutex_t *mutex)
+{
+    pthread_mutex_unlock(&(*mutex)->lock);
+}
+
+err_t sys_mbox_new(sys_mbox_t *mbox, int size)
+{
+    struct sys_mbox *mb;
+
+    if (size <= 0)
+    {
+        size = 16;
+    }
+
+    mb = (struct sys_mbox *) calloc(1, sizeof(struct sys_mbox) + size * sizeof(void *));
+    if (mb == NULL)
+    {
+        SYS_STATS_INC(mbox.err);
+        return ERR_MEM;
+    }
+
+    pthread_mutex_init(&mb->lock, NULL);
+    sys_cond_init(&mb->not_empty);
+    sys_cond_init(&mb->not_full);
+    mb->size = size;
+    *mbox = mb;
+    SYS_STATS_INC_USED(mbox);
+
+    return ERR_OK;
+}
+
+void sys_mbox_free(sys_mbox_t *mbox)
+{
+    struct sys_mbox *mb = *mbox;
+
+    pthread_cond_destroy(&mb->not_full);
+    pthread_cond_destroy(&mb->not_empty);
+    pthread_mutex_destroy(&mb->lock);
+    free(mb);
+    SYS_STATS_DEC(mbox.used);
+}
+
+/* must hold the mbox lock and have room */
+static void sys_mbox_put(struct sys_mbox *mb, void *msg)
+{
+    mb->msgs[(mb->head + mb->count) % mb->size] = msg;
+    mb->count++;
+    pthread_cond_signal(&mb->not_empty);
+}
+
+void sys_mbox_post(sys_mbox_t *mbox, void *msg)
+{
+    struct sys_mbox *mb = *mbox;
+
+    pthread_mutex_lock(&mb->lock);
+    while (mb->count == mb->size)
+    {
+        pthread_cond_wait(&mb->not_full, &mb->lock);
+    }
+    sys_mbox_put(mb, msg);
+    pthread_mutex_unlock(&mb->lock);
+}
+
+err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
+{
+    struct sys_mbox *mb = *mbox;
+    err_t result = ERR_OK;
+
+    pthread_mutex_lock(&mb->lock);
+    if (mb->count == mb->size)
+    {
+        SYS_STATS_INC(mbox.err);
+        result = ERR_MEM;
+    }
+    else
+    {
+        sys_mbox_put(mb, msg);
+    }
+    pthread_mutex_unlock(&mb->lock);
+
+    return result;
+}
+
+err_t sys_mbox_trypost_fromisr(sys_mbox_t *mbox, void *msg)
+{
+    return sys_mbox_trypost(mbox, msg);
+}
+
+u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
+{
+    struct sys_mbox *mb = *mbox;
+    struct timespec deadline;
+    u32_t start = sys_now();
+
+    if (timeout)
+    {
+        sys_deadline(&deadline, timeout);
+    }
+
+    pthread_mutex_lock(&mb->lock);
+    while (mb->count == 0)
+    {
+        if (timeout == 0)
+        {
+            pthread_cond_wait(&mb->not_empty, &mb->lock);
+        }
+        else if (pthread_cond_timedwait(&mb->not_empty, &mb->lock, &deadline) == ETIMEDOUT && mb->count == 0)
+        {
+            pthread_mutex_unlock(&mb->lock);
+            return SYS_ARCH_TIMEOUT;
+        }
+    }
+
+    if (msg)
+    {
+        *msg = mb->msgs[mb->head];
+    }
+    mb->head = (mb->head + 1) % mb->size;
+    mb->count--;
+    pthread_cond_signal(&mb->not_full);
+    pthread_mutex_unlock(&mb->lock);
+
+    return sys_now() - start;
+}
+
+u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg)
+{
+    struct sys_mbox *mb = *mbox;
+
+    pthread_mutex_lock(&mb->lock);
+    if (mb->count == 0)
+    {
+        pthread_mutex_unlock(&mb->lock);
+        return SYS_MBOX_EMPTY;
+    }
+
+    if (msg)
+    {
+        *msg = mb->msgs[mb->head];
+    }
+    mb->head = (mb->head + 1) % mb->size;
+    mb->count--;
+    pthread_cond_signal(&mb->not_full);
+    pthread_mutex_unlock(&mb->lock);
+
+    return 0;
+}
+
+static void *sys_thread_entry(void *parameter)
+{
+    struct sys_thread *t = (struct sys_thread *) parameter;
+
+    t->function(t->arg);
+
+    return NULL;
+}
+
+/* the RT-Thread priority and stack size don't apply, host threads use the defaults */
+sys_thread_t sys_thread_new(const char *name, lwip_thread_fn function, void *arg, int stacksize, int prio)
+{
+    struct sys_thread *t;
+
+    LWIP_UNUSED_ARG(stacksize);
+    LWIP_UNUSED_ARG(prio);
+
+    t = (struct sys_thread *) calloc(1, sizeof(struct sys_thread));
+    if (t == NULL)
+    {
+        return NULL;
+    }
+
+    t->function = function;
+    t->arg = arg;
+    if (pthread_create(&t->thread, NULL, sys_thread_entry, t) != 0)
+    {
+        LWIP_PLATFORM_DIAG(("sys_thread_new: create %s failed\n", name));
+        free(t);
+        return NULL;
+    }
+    pthread_detach(t->thread);
+
+    return t;
+}
+
+/* the same source address routing as the board port, see port/sys_arch.c */
+struct netif *lwip_ip4_route_src(const ip4_addr_t *dest, const ip4_addr_t *src)
+{
+    struct netif *netif;
+
+    LWIP_UNUSED_ARG(dest);
+
+    for (netif = netif_list; netif != NULL; netif = netif->next)
+    {
+        if (netif_is_up(netif) && netif_is_link_up(netif) && !ip4_addr_isany_val(*netif_ip4_addr(netif)))
+        {
+            if (src != NULL && ip4_addr_cmp(src, netif_ip4_addr(netif)))
+            {
+                return netif;
+            }
+        }
+    }
+
+    return netif_default;
+}
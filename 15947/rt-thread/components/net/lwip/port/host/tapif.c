@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/time.h>
+#include <linux/if.h>
+#include <linux/if_tun.h>
+
+#include <lwip/opt.h>
+#include <lwip/sys.h>
+#include <lwip/pbuf.h>
+#include <lwip/stats.h>
+#include <lwip/snmp.h>
+#include <lwip/etharp.h>
+#include <netif/ethernet.h>
+
+#include "tapif.h"
+
+#define TAPIF_FRAME_MAX     (1514 + ETH_PAD_SIZE)
+
+struct tapif
+{
+    int fd;
+    FILE *pcap;
+};
+
+static struct tapif tapif;
+static pthread_mutex_t pcap_lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long rx_drops;
+
+/* pcap file header, LINKTYPE_ETHERNET */
+static void pcap_open(FILE *pcap)
+{
+    const u32_t header[6] = {0xa1b2c3d4, 0x00040002, 0, 0, 65535, 1};
+
+    fwrite(header, sizeof(header), 1, pcap);
+}
+
+static void pcap_write(FILE *pcap, const u8_t *frame, u32_t len)
+{
+    struct timeval tv;
+    u32_t record[4];
+
+    if (pcap == NULL)
+    {
+        return;
+    }
+
+    gettimeofday(&tv, NULL);
+    record[0] = (u32_t) tv.tv_sec;
+    record[1] = (u32_t) tv.tv_usec;
+    record[2] = len;
+    record[3] = len;
+
+    pthread_mutex_lock(&pcap_lock);
+    fwrite(record, sizeof(record), 1, pcap);
+    fwrite(frame, len, 1, pcap);
+    pthread_mutex_unlock(&pcap_lock);
+}
+
+static err_t tapif_linkoutput(struct netif *netif, struct pbuf *p)
+{
+    u8_t frame[TAPIF_FRAME_MAX];
+    u16_t len;
+
+    LWIP_UNUSED_ARG(netif);
+
+    if (p->tot_len > sizeof(frame))
+    {
+        MIB2_STATS_NETIF_INC(netif, ifoutdiscards);
+        return ERR_IF;
+    }
+
+    len = pbuf_copy_partial(p, frame, p->tot_len, 0);
+    pcap_write(tapif.pcap, frame + ETH_PAD_SIZE, len - ETH_PAD_SIZE);
+
+    if (write(tapif.fd, frame + ETH_PAD_SIZE, len - ETH_PAD_SIZE) < 0)
+    {
+        LINK_STATS_INC(link.err);
+        return ERR_IF;
+    }
+
+    LINK_STATS_INC(link.xmit);
+    MIB2_STATS_NETIF_ADD(netif, ifoutoctets, len);
+
+    return ERR_OK;
+}
+
+static void tapif_rx_thread(void *parameter)
+{
+    struct netif *netif = (struct netif *) parameter;
+    u8_t frame[TAPIF_FRAME_MAX];
+    struct pbuf *p;
+    ssize_t len;
+
+    while (1)
+    {
+        len = read(tapif.fd, frame + ETH_PAD_SIZE, sizeof(frame) - ETH_PAD_SIZE);
+        if (len <= 0)
+        {
+            continue;
+        }
+        pcap_write(tapif.pcap, frame + ETH_PAD_SIZE, (u32_t) len);
+
+        /* the frame goes to the pbuf pool as the Ethernet driver does */
+        p = pbuf_alloc(PBUF_RAW, (u16_t)(len + ETH_PAD_SIZE), PBUF_POOL);
+        if (p == NULL)
+        {
+            rx_drops++;
+            LINK_STATS_INC(link.memerr);
+            LINK_STATS_INC(link.drop);
+            continue;
+        }
+
+        pbuf_take(p, frame, (u16_t)(len + ETH_PAD_SIZE));
+        LINK_STATS_INC(link.recv);
+
+        if (netif->input(p, netif) != ERR_OK)
+        {
+            pbuf_free(p);
+        }
+    }
+}
+
+err_t tapif_init(struct netif *netif)
+{
+    const struct tapif_config *config = (const struct tapif_config *) netif->state;
+    struct ifreq ifr;
+
+    tapif.fd = open("/dev/net/tun", O_RDWR);
+    if (tapif.fd < 0)
+    {
+        perror("tapif_init: open /dev/net/tun");
+        return ERR_IF;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+    strncpy(ifr.ifr_name, config->name, IFNAMSIZ - 1);
+    if (ioctl(tapif.fd, TUNSETIFF, (void *) &ifr) < 0)
+    {
+        perror("tapif_init: TUNSETIFF");
+        close(tapif.fd);
+        return ERR_IF;
+    }
+
+    tapif.pcap = config->pcap;
+    if (tapif.pcap)
+    {
+        pcap_open(tapif.pcap);
+    }
+
+    netif->name[0] = 't';
+    netif->name[1] = 'p';
+    netif->output = etharp_output;
+    netif->linkoutput = tapif_linkoutput;
+    netif->mtu = 1500;
+    netif->hwaddr_len = 6;
+    netif->hwaddr[0] = 0x02;
+    netif->hwaddr[1] = 0x12;
+    netif->hwaddr[2] = 0x34;
+    netif->hwaddr[3] = 0x56;
+    netif->hwaddr[4] = 0x78;
+    netif->hwaddr[5] = 0xab;
+    netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET | NETIF_FLAG_LINK_UP;
+    MIB2_INIT_NETIF(netif, snmp_ifType_ethernet_csmacd, 100000000);
+
+    sys_thread_new("tapif", tapif_rx_thread, netif, 0, 0);
+
+    return ERR_OK;
+}
+
+static err_t nullif_linkoutput(struct netif *netif, struct pbuf *p)
+{
+    LWIP_UNUSED_ARG(netif);
+    LWIP_UNUSED_ARG(p);
+
+    LINK_STATS_INC(link.drop);
+
+    return ERR_OK;
+}
+
+err_t nullif_init(struct netif *netif)
+{
+    netif->name[0] = 'n';
+    netif->name[1] = 'l';
+    netif->output = etharp_output;
+    netif->linkoutput = nullif_linkoutput;
+    netif->mtu = 1500;
+    netif->hwaddr_len = 6;
+    memset(netif->hwaddr, 0, sizeof(netif->hwaddr));
+    netif->hwaddr[0] = 0x02;
+    netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET | NETIF_FLAG_LINK_UP;
+
+    return ERR_OK;
+}
+
+unsigned long tapif_rx_drops(void)
+{
+    return rx_drops;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+#ifndef __TAPIF_H__
+#define __TAPIF_H__
+
+#include <stdio.h>
+#include <lwip/netif.h>
+
+/* netif->state of a TAP netif */
+struct tapif_config
+{
+    const char *name;                  /* TAP device name, e.g. "tap0" */
+    FILE *pcap;                        /* capture the frames in and out in pcap format, or NULL */
+};
+
+/* netif init function of a Linux TAP device, for netif_add() with tcpip_input */
+err_t tapif_init(struct netif *netif);
+
+/* netif init function of a netif without a link, only traffic to its own address is looped back */
+err_t nullif_init(struct netif *netif);
+
+/* frames dropped because the pbuf pool was empty */
+unsigned long tapif_rx_drops(void);
+
+#endif /* __TAPIF_H__ */
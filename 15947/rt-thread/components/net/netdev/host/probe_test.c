@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * netdev_probe_update() and netdev_probe_select() of netdev_probe.c against fake netdevs:
+ * the smoothed round trip time, the loss window, the health rules, the hysteresis and
+ * switch rounds before a healthy default is replaced, and the loss penalty. The probe
+ * results are fed directly, the ping thread isn't built.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <netdev_ipaddr.h>
+#include <netdev.h>
+
+#define TEST_NETDEV_NUM     3
+
+extern struct netdev *netdev_list;
+extern struct netdev *netdev_default;
+
+static struct netdev test_netdevs[TEST_NETDEV_NUM];
+static struct netdev *const eth = &test_netdevs[0];
+static struct netdev *const wlan = &test_netdevs[1];
+static struct netdev *const lte = &test_netdevs[2];
+
+static rt_uint32_t test_seed = 1;
+static int test_errors;
+
+#define TEST_CHECK(expr)                                            \
+    do                                                              \
+    {                                                               \
+        if (!(expr))                                                \
+        {                                                           \
+            printf("  line %d: %s\n", __LINE__, #expr);             \
+            test_errors++;                                          \
+        }                                                           \
+    } while (0)
+
+static rt_uint32_t test_rand(void)
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return test_seed >> 8;
+}
+
+/* three netdevs up with a link and an address, no statistics, no default */
+static void test_setup(void)
+{
+    static const char *const names[TEST_NETDEV_NUM] = {"e0", "w0", "l0"};
+    int i;
+
+    memset(test_netdevs, 0x00, sizeof(test_netdevs));
+    for (i = 0; i < TEST_NETDEV_NUM; i++)
+    {
+        struct netdev *netdev = &test_netdevs[i];
+
+        strncpy(netdev->name, names[i], RT_NAME_MAX);
+        netdev->flags = NETDEV_FLAG_UP | NETDEV_FLAG_LINK_UP;
+        netdev->ip_addr.addr = htonl(0x0A000001 + i);
+        rt_slist_init(&(netdev->list));
+        if (i > 0)
+        {
+            rt_slist_append(&(test_netdevs[0].list), &(netdev->list));
+        }
+    }
+    netdev_list = &test_netdevs[0];
+    netdev_default = RT_NULL;
+
+    /* nothing is healthy, this forgets the candidate of the previous test */
+    TEST_CHECK(netdev_probe_select() == RT_NULL);
+}
+
+/* n replies of rtt ms, so the variation settles and the score is the rtt */
+static void test_feed(struct netdev *netdev, int n, uint32_t rtt)
+{
+    while (n--)
+    {
+        netdev_probe_update(netdev, RT_TRUE, rtt);
+    }
+}
+
+/* a window of replies of rtt ms with lost probes among them, the newest is a reply */
+static void test_feed_lossy(struct netdev *netdev, int lost, uint32_t rtt)
+{
+    int i;
+
+    for (i = 0; i < 16; i++)
+    {
+        netdev_probe_update(netdev, !(i % 2 == 0 && i / 2 < lost), rtt);
+    }
+}
+
+static rt_bool_t test_healthy(struct netdev *netdev)
+{
+    struct netdev_probe_info info;
+
+    netdev_get_probe_info(netdev, &info);
+
+    return info.healthy;
+}
+
+/* select and apply, as the probe thread does */
+static struct netdev *test_round(void)
+{
+    struct netdev *netdev = netdev_probe_select();
+
+    netdev_default = netdev;
+
+    return netdev;
+}
+
+/* the integer estimator follows RFC 6298 with alpha 1/8 and beta 1/4 */
+static void test_smoothing(void)
+{
+    struct netdev_probe_info info;
+    double srtt = 0, rttvar = 0;
+    int i, srtt_err = 0, rttvar_err = 0;
+
+    test_setup();
+    for (i = 0; i < 1000; i++)
+    {
+        uint32_t rtt = 20 + test_rand() % 300;
+
+        netdev_probe_update(eth, RT_TRUE, rtt);
+        if (i == 0)
+        {
+            srtt = rtt;
+            rttvar = rtt / 2.0;
+        }
+        else
+        {
+            rttvar = 0.75 * rttvar + 0.25 * fabs(srtt - rtt);
+            srtt = 0.875 * srtt + 0.125 * rtt;
+        }
+
+        netdev_get_probe_info(eth, &info);
+        TEST_CHECK(info.last_rtt == rtt);
+        if (fabs(info.rtt - srtt) > srtt_err)
+        {
+            srtt_err = (int) ceil(fabs(info.rtt - srtt));
+        }
+        if (fabs(info.rtt_var - rttvar) > rttvar_err)
+        {
+            rttvar_err = (int) ceil(fabs(info.rtt_var - rttvar));
+        }
+    }
+    TEST_CHECK(srtt_err <= 1);
+    TEST_CHECK(rttvar_err <= 1);
+    TEST_CHECK(info.sent == 1000 && info.received == 1000 && info.loss == 0);
+
+    /* a constant round trip time leaves no variation */
+    test_feed(eth, 50, 100);
+    TEST_CHECK(netdev_get_rtt(eth) == 100);
+    netdev_get_probe_info(eth, &info);
+    TEST_CHECK(info.rtt_var == 0);
+}
+
+/* the loss is counted over the last 16 probes */
+static void test_loss_window(void)
+{
+    struct netdev_probe_info info;
+
+    test_setup();
+    netdev_probe_update(eth, RT_FALSE, 0);
+    TEST_CHECK(netdev_get_loss(eth) == 100);
+    netdev_probe_update(eth, RT_TRUE, 40);
+    TEST_CHECK(netdev_get_loss(eth) == 50);
+
+    test_feed_lossy(eth, 4, 40);
+    TEST_CHECK(netdev_get_loss(eth) == 25);
+    netdev_get_probe_info(eth, &info);
+    TEST_CHECK(info.samples == 16 && info.sent == 18 && info.received == 13);
+
+    /* the lost probes leave the window */
+    test_feed(eth, 15, 40);
+    TEST_CHECK(netdev_get_loss(eth) == 0);
+}
+
+static void test_health(void)
+{
+    test_setup();
+
+    /* too few samples */
+    test_feed(eth, 2, 40);
+    TEST_CHECK(!test_healthy(eth));
+    test_feed(eth, 1, 40);
+    TEST_CHECK(test_healthy(eth));
+    test_feed(eth, 10, 40);
+
+    /* three lost in a row, though the loss is below NETDEV_PROBE_LOSS_MAX */
+    netdev_probe_update(eth, RT_FALSE, 0);
+    netdev_probe_update(eth, RT_FALSE, 0);
+    TEST_CHECK(test_healthy(eth));
+    netdev_probe_update(eth, RT_FALSE, 0);
+    TEST_CHECK(netdev_get_loss(eth) < NETDEV_PROBE_LOSS_MAX);
+    TEST_CHECK(!test_healthy(eth));
+    netdev_probe_update(eth, RT_TRUE, 40);
+    TEST_CHECK(test_healthy(eth));
+
+    /* NETDEV_PROBE_LOSS_MAX */
+    test_setup();
+    test_feed_lossy(wlan, 7, 40);
+    TEST_CHECK(test_healthy(wlan));
+    test_feed_lossy(wlan, 8, 40);
+    TEST_CHECK(netdev_get_loss(wlan) == 50 && !test_healthy(wlan));
+
+    /* down, no link, no address */
+    test_setup();
+    test_feed(lte, 10, 40);
+    TEST_CHECK(test_healthy(lte));
+    lte->flags &= ~NETDEV_FLAG_LINK_UP;
+    TEST_CHECK(!test_healthy(lte));
+    lte->flags = NETDEV_FLAG_LINK_UP;
+    TEST_CHECK(!test_healthy(lte));
+    lte->flags = NETDEV_FLAG_UP | NETDEV_FLAG_LINK_UP;
+    lte->ip_addr.addr = 0;
+    TEST_CHECK(!test_healthy(lte));
+}
+
+/* with no healthy default the best netdev is selected at once */
+static void test_select_at_once(void)
+{
+    test_setup();
+    test_feed(eth, 10, 120);
+    test_feed(wlan, 10, 60);
+    test_feed(lte, 10, 300);
+    TEST_CHECK(test_round() == wlan);
+    TEST_CHECK(test_round() == wlan);
+
+    /* the default loses three probes in a row */
+    netdev_probe_update(wlan, RT_FALSE, 0);
+    netdev_probe_update(wlan, RT_FALSE, 0);
+    TEST_CHECK(test_round() == wlan);
+    netdev_probe_update(wlan, RT_FALSE, 0);
+    TEST_CHECK(test_round() == eth);
+
+    /* the default loses its link */
+    eth->flags &= ~NETDEV_FLAG_LINK_UP;
+    TEST_CHECK(test_round() == lte);
+
+    /* nothing healthy, the default stays */
+    lte->flags &= ~NETDEV_FLAG_UP;
+    TEST_CHECK(test_round() == lte);
+}
+
+/* a healthy default is replaced only by a netdev NETDEV_PROBE_HYSTERESIS ms better */
+static void test_hysteresis(void)
+{
+    int i;
+
+    test_setup();
+    test_feed(eth, 20, 100);
+    TEST_CHECK(test_round() == eth);
+
+    /* better, by the hysteresis or less */
+    test_feed(wlan, 20, 100 - NETDEV_PROBE_HYSTERESIS);
+    for (i = 0; i < 10; i++)
+    {
+        TEST_CHECK(test_round() == eth);
+    }
+
+    /* better by more */
+    test_feed(wlan, 20, 100 - NETDEV_PROBE_HYSTERESIS - 1);
+    for (i = 1; i < NETDEV_PROBE_SWITCH_ROUNDS; i++)
+    {
+        TEST_CHECK(test_round() == eth);
+    }
+    TEST_CHECK(test_round() == wlan);
+    TEST_CHECK(test_round() == wlan);
+
+    /* and not back, the old default is as much better now */
+    test_feed(eth, 40, 100 - 2 * NETDEV_PROBE_HYSTERESIS);
+    test_feed(wlan, 40, 100 - NETDEV_PROBE_HYSTERESIS);
+    for (i = 0; i < 10; i++)
+    {
+        TEST_CHECK(test_round() == wlan);
+    }
+}
+
+/* the rounds are consecutive, and counted for the same netdev */
+static void test_switch_rounds(void)
+{
+    int i;
+
+    test_setup();
+    test_feed(eth, 20, 200);
+    TEST_CHECK(test_round() == eth);
+
+    /* one round short, then a round not better enough */
+    test_feed(wlan, 20, 100);
+    for (i = 1; i < NETDEV_PROBE_SWITCH_ROUNDS; i++)
+    {
+        TEST_CHECK(test_round() == eth);
+    }
+    test_feed(wlan, 40, 200);
+    TEST_CHECK(test_round() == eth);
+
+    /* the count starts again */
+    test_feed(wlan, 40, 100);
+    for (i = 1; i < NETDEV_PROBE_SWITCH_ROUNDS; i++)
+    {
+        TEST_CHECK(test_round() == eth);
+    }
+
+    /* another netdev becomes the best, the count starts again for it */
+    test_feed(lte, 20, 50);
+    for (i = 1; i < NETDEV_PROBE_SWITCH_ROUNDS; i++)
+    {
+        TEST_CHECK(test_round() == eth);
+    }
+    TEST_CHECK(test_round() == lte);
+}
+
+/* each percent of loss costs NETDEV_PROBE_LOSS_PENALTY ms */
+static void test_loss_penalty(void)
+{
+    test_setup();
+
+    /* 25% loss at 50 ms scores 300, worse than 200 ms without loss */
+    test_feed(eth, 20, 50);
+    test_feed_lossy(eth, 4, 50);
+    test_feed(wlan, 20, 200);
+    TEST_CHECK(netdev_get_loss(eth) == 25);
+    TEST_CHECK(test_round() == wlan);
+
+    /* 6% loss scores 110, better than 200 ms */
+    test_setup();
+    test_feed(eth, 20, 50);
+    netdev_probe_update(eth, RT_FALSE, 0);
+    test_feed(eth, 15, 50);
+    test_feed(wlan, 20, 200);
+    TEST_CHECK(netdev_get_loss(eth) == 6);
+    TEST_CHECK(test_round() == eth);
+
+    /* the loss of the default counts for the hysteresis: 12% at 50 ms scores 170 */
+    test_feed(lte, 20, 100);
+    test_feed_lossy(eth, 2, 50);
+    TEST_CHECK(netdev_get_loss(eth) == 12);
+    TEST_CHECK(test_round() == eth);
+    TEST_CHECK(test_round() == eth);
+    TEST_CHECK(test_round() == lte);
+}
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+} test_cases[] =
+{
+    {"rtt smoothing", test_smoothing},
+    {"loss window", test_loss_window},
+    {"health", test_health},
+    {"unhealthy default replaced", test_select_at_once},
+    {"hysteresis", test_hysteresis},
+    {"switch rounds", test_switch_rounds},
+    {"loss penalty", test_loss_penalty},
+};
+
+int main(void)
+{
+    int i, errors, failed = 0;
+
+    for (i = 0; i < (int) (sizeof(test_cases) / sizeof(test_cases[0])); i++)
+    {
+        errors = test_errors;
+        test_cases[i].run();
+        printf("%-32s %s\n", test_cases[i].name, test_errors == errors ? "ok" : "FAILED");
+        if (test_errors != errors)
+        {
+            failed++;
+        }
+    }
+    printf("%d of %d passed\n", i - failed, i);
+
+    return failed ? 1 : 0;
+}
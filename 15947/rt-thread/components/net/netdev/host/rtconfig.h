@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Configuration of the host build in place of the BSP rtconfig.h: the kernel options of the
+ * board and the Kconfig defaults of the netdev probe, which the board leaves off as it has
+ * only one netdev. RT_USING_FINSH is left out, so the probe thread isn't built.
+ */
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMSET
+#define RT_KSERVICE_USING_STDLIB_MEMCPY
+
+#define RT_USING_NETDEV
+#define NETDEV_USING_AUTO_DEFAULT
+#define NETDEV_USING_PROBE
+#define NETDEV_PROBE_HOST "114.114.114.114"
+#define NETDEV_PROBE_INTERVAL 10
+#define NETDEV_PROBE_TIMEOUT 2000
+#define NETDEV_PROBE_LOSS_MAX 50
+#define NETDEV_PROBE_HYSTERESIS 30
+#define NETDEV_PROBE_SWITCH_ROUNDS 3
+#define NETDEV_IPV4 1
+#define NETDEV_IPV6 0
+
+#endif /* RT_CONFIG_H__ */
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-03-18     ChenYong     First version
+ * 2026-10-16     RT-Thread    add round trip time and loss statistics
  */
 
 #ifndef __NETDEV_H__
@@ -76,6 +77,33 @@ typedef void (*netdev_callback_fn )(struct netdev *netdev, enum netdev_cb_type t
 
 struct netdev_ops;
 
+#ifdef NETDEV_USING_PROBE
+/* round trip time and loss statistics of the periodic probes */
+struct netdev_probe_stats
+{
+    uint32_t srtt;                                     /* smoothed round trip time, unit ms, scaled by 8 */
+    uint32_t rttvar;                                   /* round trip time variation, unit ms, scaled by 4 */
+    uint32_t last_rtt;                                 /* round trip time of the last reply, unit ms */
+    uint32_t history;                                  /* result of the last probes, bit 0 is the newest, set if lost */
+    uint32_t sent;                                     /* number of probes sent */
+    uint32_t received;                                 /* number of replies received */
+    uint8_t samples;                                   /* valid bits in history */
+};
+
+/* snapshot of the probe statistics, see netdev_get_probe_info() */
+struct netdev_probe_info
+{
+    uint32_t rtt;                                      /* smoothed round trip time, unit ms */
+    uint32_t rtt_var;                                  /* round trip time variation, unit ms */
+    uint32_t last_rtt;                                 /* round trip time of the last reply, unit ms */
+    uint32_t sent;                                     /* number of probes sent */
+    uint32_t received;                                 /* number of replies received */
+    uint8_t loss;                                      /* loss of the recent probes, unit percent */
+    uint8_t samples;                                   /* number of recent probes */
+    rt_bool_t healthy;                                 /* the netdev can be selected as default */
+};
+#endif /* NETDEV_USING_PROBE */
+
 /* network interface device object */
 struct netdev
 {
@@ -99,6 +127,10 @@ struct netdev
     netdev_callback_fn status_callback;                /* network interface device flags change callback */
     netdev_callback_fn addr_callback;                  /* network interface device address information change callback */
 
+#ifdef NETDEV_USING_PROBE
+    struct netdev_probe_stats probe;                   /* round trip time and loss statistics */
+#endif /* NETDEV_USING_PROBE */
+
 #ifdef RT_USING_SAL
     void *sal_user_data;                               /* user-specific data for SAL */
 #endif /* RT_USING_SAL */
@@ -169,6 +201,18 @@ int netdev_dhcp_enabled(struct netdev *netdev, rt_bool_t is_enabled);
 #define netdev_is_internet_up(netdev) (((netdev)->flags & NETDEV_FLAG_INTERNET_UP) ? (uint8_t)1 : (uint8_t)0)
 #define netdev_is_dhcp_enabled(netdev) (((netdev)->flags & NETDEV_FLAG_DHCP) ? (uint8_t)1 : (uint8_t)0)
 
+#ifdef NETDEV_USING_PROBE
+/* Get network interface device round trip time and loss statistics */
+uint32_t netdev_get_rtt(struct netdev *netdev);
+uint8_t netdev_get_loss(struct netdev *netdev);
+int netdev_get_probe_info(struct netdev *netdev, struct netdev_probe_info *info);
+
+/* Add a probe result, the probe thread calls it for the netdevs supporting ping */
+void netdev_probe_update(struct netdev *netdev, rt_bool_t replied, uint32_t rtt);
+/* Select the default network interface device by the probe statistics */
+struct netdev *netdev_probe_select(void);
+#endif /* NETDEV_USING_PROBE */
+
 /* Set network interface device address */
 int netdev_set_ipaddr(struct netdev *netdev, const ip_addr_t *ipaddr);
 int netdev_set_netmask(struct netdev *netdev, const ip_addr_t *netmask);
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-03-18     ChenYong     First version
+ * 2026-10-16     RT-Thread    add round trip time and loss statistics
  */
 
 #include <stdio.h>
@@ -86,6 +87,10 @@ int netdev_register(struct netdev *netdev, const char *name, void *user_data)
         LOG_E("netdev name[%s] length is so long that have been cut into [%s].", name, netdev_name);
     }
 
+#ifdef NETDEV_USING_PROBE
+    rt_memset(&(netdev->probe), 0x00, sizeof(netdev->probe));
+#endif /* NETDEV_USING_PROBE */
+
     /* fill network interface device */
     rt_strncpy(netdev->name, name, RT_NAME_MAX);
     netdev->user_data = user_data;
@@ -815,6 +820,11 @@ void netdev_low_level_set_link_status(struct netdev *netdev, rt_bool_t is_up)
             /* set network interface device flags to internet down */
             netdev->flags &= ~NETDEV_FLAG_INTERNET_UP;
 
+#ifdef NETDEV_USING_PROBE
+            /* the statistics of the old link do not apply any more */
+            rt_memset(&(netdev->probe), 0x00, sizeof(netdev->probe));
+#endif /* NETDEV_USING_PROBE */
+
 #ifdef NETDEV_USING_AUTO_DEFAULT
             /* change to the first link_up network interface device automatically */
             netdev_auto_change_default(netdev);
@@ -962,6 +972,20 @@ static void netdev_list_if(void)
         rt_kprintf("gw address: %s\n", inet_ntoa(netdev->gw));
         rt_kprintf("net mask  : %s\n", inet_ntoa(netdev->netmask));
 
+#ifdef NETDEV_USING_PROBE
+        {
+            struct netdev_probe_info info;
+
+            netdev_get_probe_info(netdev, &info);
+            if (info.sent > 0)
+            {
+                rt_kprintf("rtt       : %d ms (var %d ms, last %d ms), loss %d%% of %d, %s\n",
+                           info.rtt, info.rtt_var, info.last_rtt, info.loss, info.samples,
+                           info.healthy ? "HEALTHY" : "UNHEALTHY");
+            }
+        }
+#endif /* NETDEV_USING_PROBE */
+
 #if NETDEV_IPV6
         {
             ip_addr_t *addr;
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+
+#include <netdev_ipaddr.h>
+#include <netdev.h>
+
+#define DBG_TAG              "netdev.probe"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef NETDEV_USING_PROBE
+
+/* the number of recent probes the loss is counted over, at most 32 */
+#ifndef NETDEV_PROBE_WINDOW
+#define NETDEV_PROBE_WINDOW            16
+#endif
+/* the number of probes a netdev needs before it can be selected */
+#ifndef NETDEV_PROBE_MIN_SAMPLES
+#define NETDEV_PROBE_MIN_SAMPLES       3
+#endif
+/* the number of consecutive lost probes that makes a netdev unhealthy at once */
+#ifndef NETDEV_PROBE_LOST_MAX
+#define NETDEV_PROBE_LOST_MAX          3
+#endif
+/* the score added for each percent of loss, unit ms */
+#ifndef NETDEV_PROBE_LOSS_PENALTY
+#define NETDEV_PROBE_LOSS_PENALTY      10
+#endif
+
+#ifndef NETDEV_PROBE_THREAD_STACK_SIZE
+#define NETDEV_PROBE_THREAD_STACK_SIZE 2048
+#endif
+#ifndef NETDEV_PROBE_THREAD_PRIORITY
+#define NETDEV_PROBE_THREAD_PRIORITY   (RT_THREAD_PRIORITY_MAX - 2)
+#endif
+
+#define NETDEV_PROBE_DATA_SIZE         8
+#define NETDEV_PROBE_WINDOW_MASK       ((NETDEV_PROBE_WINDOW >= 32) ? 0xFFFFFFFFUL : ((1UL << NETDEV_PROBE_WINDOW) - 1))
+#define NETDEV_PROBE_LOST_MASK         ((1UL << NETDEV_PROBE_LOST_MAX) - 1)
+
+static uint8_t netdev_probe_loss(const struct netdev_probe_stats *stats)
+{
+    uint32_t history = stats->history;
+    uint32_t lost = 0;
+
+    if (stats->samples == 0)
+    {
+        return 0;
+    }
+
+    for (; history; history >>= 1)
+    {
+        lost += history & 0x01;
+    }
+
+    return (uint8_t)(lost * 100 / stats->samples);
+}
+
+static rt_bool_t netdev_probe_is_healthy(struct netdev *netdev)
+{
+    const struct netdev_probe_stats *stats = &(netdev->probe);
+
+    if (!netdev_is_up(netdev) || !netdev_is_link_up(netdev) || ip_addr_isany(&(netdev->ip_addr)))
+    {
+        return RT_FALSE;
+    }
+
+    if (stats->samples < NETDEV_PROBE_MIN_SAMPLES || stats->received == 0)
+    {
+        return RT_FALSE;
+    }
+
+    /* the path is gone, do not wait for the loss rate to catch up */
+    if ((stats->history & NETDEV_PROBE_LOST_MASK) == NETDEV_PROBE_LOST_MASK)
+    {
+        return RT_FALSE;
+    }
+
+    return netdev_probe_loss(stats) < NETDEV_PROBE_LOSS_MAX;
+}
+
+/* lower is better: the expected round trip time plus a penalty for the loss */
+static uint32_t netdev_probe_score(struct netdev *netdev)
+{
+    const struct netdev_probe_stats *stats = &(netdev->probe);
+
+    return (stats->srtt >> 3) + (stats->rttvar >> 2) + netdev_probe_loss(stats) * NETDEV_PROBE_LOSS_PENALTY;
+}
+
+/**
+ * This function will add a probe result to the network interface device statistics.
+ * The round trip time is smoothed as the TCP retransmission timer does (RFC 6298).
+ *
+ * @param netdev the network interface device
+ * @param replied RT_TRUE if the probe was answered
+ * @param rtt the round trip time, unit ms
+ */
+void netdev_probe_update(struct netdev *netdev, rt_bool_t replied, uint32_t rtt)
+{
+    struct netdev_probe_stats *stats;
+    rt_base_t level;
+    int32_t delta;
+
+    RT_ASSERT(netdev);
+
+    stats = &(netdev->probe);
+
+    level = rt_hw_interrupt_disable();
+
+    stats->sent++;
+    stats->history = (stats->history << 1) & NETDEV_PROBE_WINDOW_MASK;
+    if (stats->samples < NETDEV_PROBE_WINDOW)
+    {
+        stats->samples++;
+    }
+
+    if (replied)
+    {
+        if (stats->received++ == 0)
+        {
+            stats->srtt = rtt << 3;
+            stats->rttvar = rtt << 1;
+        }
+        else
+        {
+            delta = (int32_t) rtt - (int32_t)(stats->srtt >> 3);
+            stats->srtt += delta;
+            if (delta < 0)
+            {
+                delta = -delta;
+            }
+            stats->rttvar += delta - (int32_t)(stats->rttvar >> 2);
+        }
+        stats->last_rtt = rtt;
+    }
+    else
+    {
+        stats->history |= 0x01;
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will select the default network interface device by the probe statistics.
+ * An unhealthy default is replaced at once, a healthy one only after another netdev scored
+ * NETDEV_PROBE_HYSTERESIS ms better for NETDEV_PROBE_SWITCH_ROUNDS consecutive calls.
+ *
+ * @return the network interface device to be default, the current default if nothing changes
+ */
+struct netdev *netdev_probe_select(void)
+{
+    static struct netdev *candidate = RT_NULL;
+    static int rounds = 0;
+
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    struct netdev *netdev = RT_NULL, *best = RT_NULL, *selected = RT_NULL;
+    uint32_t score, best_score = 0;
+
+    if (netdev_list == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    for (node = &(netdev_list->list); node; node = rt_slist_next(node))
+    {
+        netdev = rt_slist_entry(node, struct netdev, list);
+        if (!netdev_probe_is_healthy(netdev))
+        {
+            continue;
+        }
+
+        score = netdev_probe_score(netdev);
+        if (best == RT_NULL || score < best_score)
+        {
+            best = netdev;
+            best_score = score;
+        }
+    }
+
+    selected = netdev_default;
+
+    if (best == RT_NULL || best == netdev_default)
+    {
+        candidate = RT_NULL;
+    }
+    else if (netdev_default == RT_NULL || !netdev_probe_is_healthy(netdev_default))
+    {
+        candidate = RT_NULL;
+        selected = best;
+    }
+    else if (best_score + NETDEV_PROBE_HYSTERESIS < netdev_probe_score(netdev_default))
+    {
+        if (candidate != best)
+        {
+            candidate = best;
+            rounds = 0;
+        }
+
+        if (++rounds >= NETDEV_PROBE_SWITCH_ROUNDS)
+        {
+            candidate = RT_NULL;
+            selected = best;
+        }
+    }
+    else
+    {
+        candidate = RT_NULL;
+    }
+
+    if (candidate == RT_NULL)
+    {
+        rounds = 0;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return selected;
+}
+
+/**
+ * This function will get the smoothed round trip time of the network interface device.
+ *
+ * @param netdev the network interface device
+ *
+ * @return the round trip time in ms, 0 if no probe was answered
+ */
+uint32_t netdev_get_rtt(struct netdev *netdev)
+{
+    RT_ASSERT(netdev);
+
+    return netdev->probe.srtt >> 3;
+}
+
+/**
+ * This function will get the loss of the recent probes of the network interface device.
+ *
+ * @param netdev the network interface device
+ *
+ * @return the loss in percent
+ */
+uint8_t netdev_get_loss(struct netdev *netdev)
+{
+    uint8_t loss;
+    rt_base_t level;
+
+    RT_ASSERT(netdev);
+
+    level = rt_hw_interrupt_disable();
+    loss = netdev_probe_loss(&(netdev->probe));
+    rt_hw_interrupt_enable(level);
+
+    return loss;
+}
+
+/**
+ * This function will get the probe statistics of the network interface device.
+ *
+ * @param netdev the network interface device
+ * @param info the statistics snapshot
+ *
+ * @return  0: get successfully
+ */
+int netdev_get_probe_info(struct netdev *netdev, struct netdev_probe_info *info)
+{
+    const struct netdev_probe_stats *stats;
+    rt_base_t level;
+
+    RT_ASSERT(netdev);
+    RT_ASSERT(info);
+
+    stats = &(netdev->probe);
+
+    level = rt_hw_interrupt_disable();
+    info->rtt = stats->srtt >> 3;
+    info->rtt_var = stats->rttvar >> 2;
+    info->last_rtt = stats->last_rtt;
+    info->sent = stats->sent;
+    info->received = stats->received;
+    info->loss = netdev_probe_loss(stats);
+    info->samples = stats->samples;
+    info->healthy = netdev_probe_is_healthy(netdev);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_FINSH
+/* the number of registered network interface devices */
+static int netdev_probe_count(void)
+{
+    rt_slist_t *node = RT_NULL;
+    rt_base_t level;
+    int count = 0;
+
+    level = rt_hw_interrupt_disable();
+    for (node = netdev_list ? &(netdev_list->list) : RT_NULL; node; node = rt_slist_next(node))
+    {
+        count++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return count;
+}
+
+static void netdev_probe_entry(void *parameter)
+{
+    rt_slist_t *node = RT_NULL;
+    struct netdev *netdev = RT_NULL;
+    struct netdev_ping_resp ping_resp;
+    int result;
+
+    while (1)
+    {
+        rt_thread_mdelay(NETDEV_PROBE_INTERVAL * 1000);
+
+        /* nothing to choose from: do not keep a lone modem busy and spend its data on pings */
+        if (netdev_probe_count() < 2)
+        {
+            continue;
+        }
+
+        for (node = netdev_list ? &(netdev_list->list) : RT_NULL; node; node = rt_slist_next(node))
+        {
+            netdev = rt_slist_entry(node, struct netdev, list);
+            if (netdev->ops == RT_NULL || netdev->ops->ping == RT_NULL ||
+                    !netdev_is_up(netdev) || !netdev_is_link_up(netdev) || ip_addr_isany(&(netdev->ip_addr)))
+            {
+                continue;
+            }
+
+            /* the ping operations bind the probe to the address of this netdev */
+            rt_memset(&ping_resp, 0x00, sizeof(struct netdev_ping_resp));
+            result = netdev->ops->ping(netdev, NETDEV_PROBE_HOST, NETDEV_PROBE_DATA_SIZE,
+                                       rt_tick_from_millisecond(NETDEV_PROBE_TIMEOUT), &ping_resp);
+            netdev_probe_update(netdev, result == RT_EOK, ping_resp.ticks * 1000 / RT_TICK_PER_SECOND);
+        }
+
+#ifdef NETDEV_USING_AUTO_DEFAULT
+        netdev = netdev_probe_select();
+        if (netdev && netdev != netdev_default)
+        {
+            LOG_I("default network interface device changed to %.*s, rtt %d ms, loss %d%%.",
+                  RT_NAME_MAX, netdev->name, netdev_get_rtt(netdev), netdev_get_loss(netdev));
+            netdev_set_default(netdev);
+        }
+#endif /* NETDEV_USING_AUTO_DEFAULT */
+    }
+}
+
+static int netdev_probe_init(void)
+{
+    rt_thread_t tid;
+
+    tid = rt_thread_create("netdev_p", netdev_probe_entry, RT_NULL,
+                           NETDEV_PROBE_THREAD_STACK_SIZE, NETDEV_PROBE_THREAD_PRIORITY, 10);
+    if (tid == RT_NULL)
+    {
+        LOG_E("create netdev probe thread failed.");
+        return -RT_ENOMEM;
+    }
+
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+INIT_APP_EXPORT(netdev_probe_init);
+#endif /* RT_USING_FINSH */
+
+#endif /* NETDEV_USING_PROBE */
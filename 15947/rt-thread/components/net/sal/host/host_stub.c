@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The kernel services used by sal_netbuf.c and memheap.c. The benchmark runs in one
+ * thread, so the interrupt lock and the heap semaphore have nothing to do.
+ */
+
+#include <stdio.h>
+
+#include <rtthread.h>
+#include <rthw.h>
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    (void) level;
+}
+
+void rt_object_init(struct rt_object *object, enum rt_object_class_type type, const char *name)
+{
+    snprintf(object->name, RT_NAME_MAX, "%s", name);
+    object->type = type | RT_Object_Class_Static;
+}
+
+void rt_object_detach(rt_object_t object)
+{
+    object->type = 0;
+}
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    (void) flag;
+
+    rt_object_init(&(sem->parent.parent), RT_Object_Class_Semaphore, name);
+    sem->value = (rt_uint16_t) value;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    rt_object_detach(&(sem->parent.parent));
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    (void) sem;
+    (void) time;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    (void) sem;
+
+    return RT_EOK;
+}
+
+void rt_set_errno(rt_err_t error)
+{
+    (void) error;
+}
@@ -0,0 +1,736 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Copies per uploaded byte, peak RAM and heap fragmentation of the publish path with flat
+ * buffers and with the SAL network buffer pool, see README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <rtthread.h>
+#include <sal_socket.h>
+#include <sal_netbuf.h>
+
+int sal_netbuf_init(void);
+
+/* the sizes of the publish queue of applications/pv_onenet_client.c before it used the pool */
+#define BENCH_QUEUE_POOL        8
+#define BENCH_QUEUE_PAYLOAD     512
+/* the size of a queued message of applications/pv_onenet_client.c, the payload is in the pool */
+#define BENCH_QUEUE_MSG_SIZE    32
+/* the MQTT client send buffer */
+#define BENCH_MQTT_BUF_SIZE     1024
+/* allocations of the other heap users kept at the same time */
+#define BENCH_CHURN_SLOTS       16
+
+#define BENCH_TOPIC_RAW         "$sys/81kgVdJcL2/voltage/dp/post/json"
+#define BENCH_TOPIC_STRING      "$dp"
+#define BENCH_DS_NAME           "pv_data"
+
+enum bench_sink
+{
+    BENCH_SINK_SENDMSG,                /* the stack takes the buffers as they are, lwIP */
+    BENCH_SINK_AT,                     /* at_sendmsg(), one send command per buffer */
+    BENCH_SINK_SENDTO,                 /* the stack only has sendto, the fallback of sal_sendmsg() */
+};
+
+struct bench_options
+{
+    unsigned long count;
+    int window;
+    int min_len;
+    int max_len;
+    int string_percent;
+    size_t heap_size;
+    unsigned int seed;
+};
+
+struct bench_result
+{
+    unsigned long payload;             /* bytes of JSON uploaded */
+    unsigned long copied;              /* bytes copied between the JSON and the stack */
+    unsigned long sent;                /* bytes handed to the stack */
+    unsigned long sends;               /* calls of sendto or sendmsg */
+    unsigned long heap_allocs;
+    unsigned long heap_fails;
+    unsigned long pool_fails;
+    size_t heap_peak;
+    size_t static_ram;
+    size_t pool_peak;
+    size_t free_total;
+    size_t free_largest;
+    int free_blocks;
+    double seconds;
+};
+
+static struct rt_memheap bench_heap;
+static rt_uint8_t *bench_heap_mem;
+static struct bench_result *result;
+static enum bench_sink bench_sink;
+volatile rt_uint32_t bench_sink_sum;
+
+/* the JSON is written once, these copies move it on the way to the stack */
+static void *bench_copy(void *dst, const void *src, size_t len)
+{
+    result->copied += len;
+    return memcpy(dst, src, len);
+}
+
+static void *bench_malloc(size_t size)
+{
+    void *ptr = rt_memheap_alloc(&bench_heap, size);
+
+    result->heap_allocs++;
+    if (ptr == RT_NULL)
+    {
+        result->heap_fails++;
+    }
+
+    return ptr;
+}
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_heap_init(const struct bench_options *opt)
+{
+    if (bench_heap_mem)
+    {
+        rt_memheap_detach(&bench_heap);
+        free(bench_heap_mem);
+    }
+
+    bench_heap_mem = malloc(opt->heap_size);
+    rt_memheap_init(&bench_heap, "heap", bench_heap_mem, opt->heap_size);
+}
+
+/* walk the free list of the heap after the run */
+static void bench_heap_scan(struct bench_result *res)
+{
+    struct rt_memheap_item *item;
+    size_t size;
+
+    res->free_total = 0;
+    res->free_largest = 0;
+    res->free_blocks = 0;
+
+    for (item = bench_heap.free_list->next_free; item != bench_heap.free_list; item = item->next_free)
+    {
+        size = (rt_ubase_t) item->next - (rt_ubase_t) item - RT_ALIGN(sizeof(struct rt_memheap_item), RT_ALIGN_SIZE);
+        res->free_total += size;
+        res->free_blocks++;
+        if (size > res->free_largest)
+        {
+            res->free_largest = size;
+        }
+    }
+
+    res->heap_peak = bench_heap.max_used_size;
+}
+
+/*
+ * The other heap users: each message frees one of their allocations and makes a new one,
+ * so the publish path allocates from a heap that is already in use.
+ */
+static void bench_churn(unsigned int *seed, void **slots)
+{
+    int index = rand_r(seed) % BENCH_CHURN_SLOTS;
+
+    if (slots[index])
+    {
+        rt_memheap_free(slots[index]);
+    }
+    slots[index] = rt_memheap_alloc(&bench_heap, 16 + rand_r(seed) % 240);
+}
+
+/* one data point of the JSON, the same bytes for every pipeline */
+#define BENCH_DP_FORMAT         "%s\"pv%d\":{\"v\":%lu.%02d}"
+#define BENCH_DP_ARGS(seq, index) \
+    (index) ? "," : "{\"id\":0,\"dp\":{", (index), ((seq) * 7 + (index) * 13) % 1000, (index) % 100
+
+/* generate_dp_json(): the JSON of len bytes at least, written into a flat buffer */
+static int bench_json_flat(char *buf, size_t size, unsigned long seq, int len)
+{
+    int pos = 0, index = 0;
+
+    while (pos < len && pos < (int) size - 64)
+    {
+        pos += snprintf(buf + pos, size - pos, BENCH_DP_FORMAT, BENCH_DP_ARGS(seq, index));
+        index++;
+    }
+    pos += snprintf(buf + pos, size - pos, "}}");
+
+    return pos;
+}
+
+/* write formatted text into the free room of the last buffer, a new buffer is chained if it is full */
+static int bench_netbuf_printf(struct sal_netbuf **chain, struct sal_netbuf **tail, const char *fmt, ...)
+{
+    struct sal_netbuf *nb = *tail;
+    va_list args;
+    size_t room;
+    int len;
+
+    while (1)
+    {
+        room = nb ? sal_netbuf_space(nb) : 0;
+        if (nb && room > 0)
+        {
+            va_start(args, fmt);
+            len = vsnprintf((char *) nb->payload + nb->len, room, fmt, args);
+            va_end(args);
+            if (len >= 0 && (size_t) len < room)
+            {
+                nb->len += len;
+                return len;
+            }
+        }
+
+        nb = sal_netbuf_alloc();
+        if (nb == RT_NULL)
+        {
+            result->pool_fails++;
+            return -1;
+        }
+        if (*tail)
+        {
+            (*tail)->next = nb;
+        }
+        else
+        {
+            *chain = nb;
+        }
+        *tail = nb;
+    }
+}
+
+/* the same JSON as bench_json_flat(), written straight into network buffers */
+static int bench_json_netbuf(struct sal_netbuf **chain, struct sal_netbuf **tail, unsigned long seq, int len)
+{
+    int pos = 0, index = 0, n;
+
+    while (pos < len && pos < BENCH_QUEUE_PAYLOAD - 64)
+    {
+        n = bench_netbuf_printf(chain, tail, BENCH_DP_FORMAT, BENCH_DP_ARGS(seq, index));
+        if (n < 0)
+        {
+            return -1;
+        }
+        pos += n;
+        index++;
+    }
+    if (bench_netbuf_printf(chain, tail, "}}") < 0)
+    {
+        return -1;
+    }
+
+    return pos + 2;
+}
+
+/* the MQTT PUBLISH fixed header, topic and packet id */
+static int bench_mqtt_header(rt_uint8_t *buf, const char *topic, rt_uint16_t id, size_t payload_len)
+{
+    size_t topic_len = strlen(topic), remain = 2 + topic_len + 2 + payload_len;
+    int pos = 0;
+
+    buf[pos++] = 0x32;
+    do
+    {
+        buf[pos] = remain & 0x7F;
+        remain >>= 7;
+        buf[pos++] |= remain ? 0x80 : 0;
+    } while (remain);
+    buf[pos++] = topic_len >> 8;
+    buf[pos++] = topic_len & 0xFF;
+    memcpy(buf + pos, topic, topic_len);
+    pos += topic_len;
+    buf[pos++] = id >> 8;
+    buf[pos++] = id & 0xFF;
+
+    return pos;
+}
+
+/* the serial port or the stack reads the data once, that is not counted as a copy */
+static void bench_sink_read(const void *data, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i += 64)
+    {
+        bench_sink_sum += ((const rt_uint8_t *) data)[i];
+    }
+    result->sent += size;
+}
+
+static int bench_sendto(const void *data, size_t size)
+{
+    bench_sink_read(data, size);
+    result->sends++;
+
+    return (int) size;
+}
+
+/*
+ * lwIP takes the buffers as they are, at_sendmsg() sends each buffer of a TCP socket by its
+ * own send command, and the fallback of sal_sendmsg() for a stream gathers the buffers into
+ * sends of full blocks, the rest of a large buffer is sent as it is.
+ */
+int sal_sendmsg(int socket, const struct msghdr *message, int flags)
+{
+    struct sal_netbuf *nb;
+    const rt_uint8_t *data;
+    size_t pending = 0, total = 0, left, size;
+    int i;
+
+    (void) socket;
+    (void) flags;
+
+    if (bench_sink == BENCH_SINK_SENDMSG)
+    {
+        for (i = 0; i < (int) message->msg_iovlen; i++)
+        {
+            total += message->msg_iov[i].iov_len;
+            bench_sink_read(message->msg_iov[i].iov_base, message->msg_iov[i].iov_len);
+        }
+        result->sends++;
+        return (int) total;
+    }
+
+    if (bench_sink == BENCH_SINK_AT)
+    {
+        for (i = 0; i < (int) message->msg_iovlen; i++)
+        {
+            total += bench_sendto(message->msg_iov[i].iov_base, message->msg_iov[i].iov_len);
+        }
+        return (int) total;
+    }
+
+    nb = sal_netbuf_alloc();
+    for (i = 0; i < (int) message->msg_iovlen; i++)
+    {
+        data = (const rt_uint8_t *) message->msg_iov[i].iov_base;
+        left = message->msg_iov[i].iov_len;
+        total += left;
+
+        while (left > 0)
+        {
+            if (nb && (pending > 0 || left < SAL_NETBUF_BLOCK_SIZE))
+            {
+                size = SAL_NETBUF_BLOCK_SIZE - pending;
+                if (size > left)
+                {
+                    size = left;
+                }
+                bench_copy(nb->payload + pending, data, size);
+                pending += size;
+                data += size;
+                left -= size;
+                if (pending == SAL_NETBUF_BLOCK_SIZE)
+                {
+                    bench_sendto(nb->payload, pending);
+                    pending = 0;
+                }
+                continue;
+            }
+            bench_sendto(data, left);
+            left = 0;
+        }
+    }
+    if (pending > 0)
+    {
+        bench_sendto(nb->payload, pending);
+    }
+    if (nb)
+    {
+        sal_netbuf_free(nb);
+    }
+
+    return (int) total;
+}
+
+/*
+ * The publish path through the OneNET package: the MQTT client serializes the payload into
+ * its send buffer, which is sent by sendto. A string data point of the package is made of a
+ * cJSON object, the printed string and a type 3 send buffer on the heap before it reaches
+ * the MQTT client.
+ *
+ * With flat buffers generate_dp_json() writes into a stack buffer and the publish queue
+ * copies it. With in_netbuf, the path of the tree, the JSON is written into a network
+ * buffer that the queue holds until the package has copied it.
+ */
+static void bench_run_flat(const struct bench_options *opt, struct bench_result *res, int in_netbuf)
+{
+    static rt_uint8_t queue[BENCH_QUEUE_POOL][BENCH_QUEUE_PAYLOAD + 1];
+    static rt_uint8_t mqtt_buf[BENCH_MQTT_BUF_SIZE];
+    void *churn[BENCH_CHURN_SLOTS] = { 0 };
+    unsigned int seed = opt->seed, churn_seed = opt->seed;
+    char json[BENCH_QUEUE_PAYLOAD];
+    struct sal_netbuf_stats stats;
+    unsigned long seq;
+    double start;
+    int peak = 0;
+
+    result = res;
+    bench_heap_init(opt);
+    if (in_netbuf)
+    {
+        res->static_ram = BENCH_QUEUE_POOL * BENCH_QUEUE_MSG_SIZE + sizeof(mqtt_buf) +
+                          SAL_NETBUF_BLOCK_NUM * (RT_ALIGN(sizeof(struct sal_netbuf), RT_ALIGN_SIZE) +
+                                                  RT_ALIGN(SAL_NETBUF_BLOCK_SIZE, RT_ALIGN_SIZE));
+    }
+    else
+    {
+        res->static_ram = sizeof(queue) + sizeof(mqtt_buf);
+    }
+
+    start = bench_now();
+    for (seq = 0; seq < opt->count; seq++)
+    {
+        int target = opt->min_len + rand_r(&seed) % (opt->max_len - opt->min_len + 1);
+        int is_string = (int)(rand_r(&seed) % 100) < opt->string_percent;
+        const rt_uint8_t *slot;
+        const rt_uint8_t *payload;
+        rt_uint8_t *object = RT_NULL, *item = RT_NULL, *value = RT_NULL, *printed = RT_NULL, *out = RT_NULL;
+        struct sal_netbuf *chain = RT_NULL, *tail = RT_NULL;
+        int len, pos;
+
+        bench_churn(&churn_seed, churn);
+
+        if (in_netbuf)
+        {
+            /* pv_onenet_publish_netbuf() only takes a single buffer */
+            len = bench_json_netbuf(&chain, &tail, seq, target);
+            if (len < 0 || chain->next)
+            {
+                res->pool_fails += (len >= 0);
+                sal_netbuf_free(chain);
+                continue;
+            }
+            slot = chain->payload;
+            sal_netbuf_get_stats(&stats);
+            if (stats.used > peak)
+            {
+                peak = stats.used;
+            }
+        }
+        else
+        {
+            len = bench_json_flat(json, sizeof(json), seq, target);
+            bench_copy(queue[seq % BENCH_QUEUE_POOL], json, len);
+            slot = queue[seq % BENCH_QUEUE_POOL];
+        }
+        res->payload += len;
+        payload = slot;
+
+        if (is_string)
+        {
+            object = bench_malloc(64);
+            item = bench_malloc(64);
+            value = bench_malloc(len + 1);
+            printed = bench_malloc(len + sizeof(BENCH_DS_NAME) + 8);
+            if (value && printed)
+            {
+                bench_copy(value, slot, len);
+                pos = sprintf((char *) printed, "{\"%s\":\"", BENCH_DS_NAME);
+                bench_copy(printed + pos, value, len);
+                pos += len;
+                out = bench_malloc(pos + 3);
+                if (out)
+                {
+                    out[0] = 0x03;
+                    out[1] = pos >> 8;
+                    out[2] = pos & 0xFF;
+                    bench_copy(out + 3, printed, pos);
+                }
+            }
+            rt_memheap_free(printed);
+            rt_memheap_free(value);
+            rt_memheap_free(item);
+            rt_memheap_free(object);
+            if (out == RT_NULL)
+            {
+                sal_netbuf_free(chain);
+                continue;
+            }
+            payload = out;
+            len = pos + 3;
+        }
+
+        pos = bench_mqtt_header(mqtt_buf, is_string ? BENCH_TOPIC_STRING : BENCH_TOPIC_RAW, seq & 0xFFFF, len);
+        bench_copy(mqtt_buf + pos, payload, len);
+        bench_sendto(mqtt_buf, pos + len);
+
+        if (out)
+        {
+            rt_memheap_free(out);
+        }
+        /* the queue drops its reference once the package returns */
+        sal_netbuf_free(chain);
+    }
+    res->seconds = bench_now() - start;
+
+    res->pool_peak = peak * (RT_ALIGN(sizeof(struct sal_netbuf), RT_ALIGN_SIZE) + RT_ALIGN(SAL_NETBUF_BLOCK_SIZE, RT_ALIGN_SIZE));
+    bench_heap_scan(res);
+}
+
+/*
+ * The same uploads with network buffers: the JSON is written into a chain, the publish
+ * queue holds a reference to it until the PUBACK, the MQTT header goes into a buffer of
+ * its own in front of the chain and the chain is sent by sal_netbuf_send().
+ */
+static void bench_run_netbuf(const struct bench_options *opt, struct bench_result *res)
+{
+    struct sal_netbuf *inflight[BENCH_QUEUE_POOL] = { 0 };
+    void *churn[BENCH_CHURN_SLOTS] = { 0 };
+    unsigned int seed = opt->seed, churn_seed = opt->seed;
+    struct sal_netbuf_stats stats;
+    unsigned long seq;
+    double start;
+    int i, peak = 0;
+
+    result = res;
+    bench_heap_init(opt);
+    res->static_ram = SAL_NETBUF_BLOCK_NUM * (RT_ALIGN(sizeof(struct sal_netbuf), RT_ALIGN_SIZE) +
+                                              RT_ALIGN(SAL_NETBUF_BLOCK_SIZE, RT_ALIGN_SIZE));
+
+    start = bench_now();
+    for (seq = 0; seq < opt->count; seq++)
+    {
+        int target = opt->min_len + rand_r(&seed) % (opt->max_len - opt->min_len + 1);
+        int is_string = (int)(rand_r(&seed) % 100) < opt->string_percent;
+        struct sal_netbuf *chain = RT_NULL, *tail = RT_NULL, *header;
+        int slot = seq % opt->window, len;
+
+        bench_churn(&churn_seed, churn);
+
+        /* the oldest message of the window is acknowledged */
+        if (inflight[slot])
+        {
+            sal_netbuf_free(inflight[slot]);
+            inflight[slot] = RT_NULL;
+        }
+
+        if (is_string)
+        {
+            /* type 3 header and the data stream object, the length is set at the end */
+            bench_netbuf_printf(&chain, &tail, "%c%c%c{\"%s\":\"", 0x03, 0x01, 0x01, BENCH_DS_NAME);
+        }
+        len = bench_json_netbuf(&chain, &tail, seq, target);
+        if (len < 0)
+        {
+            sal_netbuf_free(chain);
+            continue;
+        }
+        res->payload += len;
+        if (is_string)
+        {
+            len = sal_netbuf_len(chain);
+            chain->payload[1] = (len - 3) >> 8;
+            chain->payload[2] = (len - 3) & 0xFF;
+        }
+
+        /* the queue takes over the reference of the writer */
+        inflight[slot] = chain;
+
+        header = sal_netbuf_alloc();
+        if (header == RT_NULL)
+        {
+            res->pool_fails++;
+            continue;
+        }
+        header->len = bench_mqtt_header(header->payload, is_string ? BENCH_TOPIC_STRING : BENCH_TOPIC_RAW,
+                                        seq & 0xFFFF, sal_netbuf_len(chain));
+        sal_netbuf_ref(chain);
+        sal_netbuf_cat(header, chain);
+        sal_netbuf_send(0, header, 0);
+
+        sal_netbuf_get_stats(&stats);
+        if (stats.used > peak)
+        {
+            peak = stats.used;
+        }
+        sal_netbuf_free(header);
+    }
+    res->seconds = bench_now() - start;
+
+    for (i = 0; i < BENCH_QUEUE_POOL; i++)
+    {
+        sal_netbuf_free(inflight[i]);
+    }
+
+    sal_netbuf_get_stats(&stats);
+    if (stats.used != 0)
+    {
+        printf("%d network buffers leaked\n", stats.used);
+    }
+    res->pool_peak = peak * (res->static_ram / SAL_NETBUF_BLOCK_NUM);
+    bench_heap_scan(res);
+}
+
+static void bench_print(const char *name, const struct bench_result *res)
+{
+    printf("%-16s %6.2f %7.2f %8lu %9lu %7lu %7lu %6d %9lu %9.0f\n", name,
+           res->payload ? (double) res->copied / res->payload : 0,
+           res->sends ? (double) res->sent / res->sends : 0,
+           (unsigned long)(res->static_ram + res->heap_peak),
+           (unsigned long) res->heap_peak, res->heap_allocs, (unsigned long) res->free_largest,
+           res->free_blocks, res->heap_fails + res->pool_fails,
+           res->payload ? res->seconds * 1e9 / (res->payload / 1024.0) : 0);
+}
+
+/* the cost of one allocation and free: the network buffer pool, the board heap and the C library */
+static void bench_alloc(const struct bench_options *opt)
+{
+    const unsigned long rounds = 1000000;
+    struct bench_result res;
+    void *ptr[8];
+    unsigned long i;
+    double start, netbuf, memheap, libc;
+    int j;
+
+    memset(&res, 0, sizeof(res));
+    result = &res;
+    bench_heap_init(opt);
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            ptr[j] = sal_netbuf_alloc();
+        }
+        for (j = 0; j < 8; j++)
+        {
+            sal_netbuf_free(ptr[j]);
+        }
+    }
+    netbuf = (bench_now() - start) * 1e9 / (rounds * 8);
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            ptr[j] = rt_memheap_alloc(&bench_heap, SAL_NETBUF_BLOCK_SIZE);
+        }
+        for (j = 0; j < 8; j++)
+        {
+            rt_memheap_free(ptr[j]);
+        }
+    }
+    memheap = (bench_now() - start) * 1e9 / (rounds * 8);
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            ptr[j] = malloc(SAL_NETBUF_BLOCK_SIZE);
+            *(volatile char *) ptr[j] = 0;
+        }
+        for (j = 0; j < 8; j++)
+        {
+            free(ptr[j]);
+        }
+    }
+    libc = (bench_now() - start) * 1e9 / (rounds * 8);
+
+    printf("alloc + free of %d bytes, ns: netbuf %.1f, rt_memheap %.1f, libc malloc %.1f\n",
+           SAL_NETBUF_BLOCK_SIZE, netbuf, memheap, libc);
+}
+
+static void bench_usage(const char *name)
+{
+    printf("usage: %s [-n messages] [-w window] [-l min,max] [-p string_percent] [-H heap_bytes] [-s seed]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    struct bench_options opt;
+    struct bench_result flat, queue, sendmsg, at, sendto;
+    int c;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.count = 100000;
+    opt.window = 4;
+    opt.min_len = 200;
+    opt.max_len = 440;
+    opt.string_percent = 50;
+    opt.heap_size = 16 * 1024;
+    opt.seed = 1;
+
+    while ((c = getopt(argc, argv, "n:w:l:p:H:s:h")) != -1)
+    {
+        switch (c)
+        {
+        case 'n': opt.count = strtoul(optarg, NULL, 0); break;
+        case 'w': opt.window = atoi(optarg); break;
+        case 'l': sscanf(optarg, "%d,%d", &opt.min_len, &opt.max_len); break;
+        case 'p': opt.string_percent = atoi(optarg); break;
+        case 'H': opt.heap_size = strtoul(optarg, NULL, 0); break;
+        case 's': opt.seed = strtoul(optarg, NULL, 0); break;
+        default:
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (opt.window < 1 || opt.window > BENCH_QUEUE_POOL || opt.min_len < 1 ||
+        opt.max_len < opt.min_len || opt.max_len > BENCH_QUEUE_PAYLOAD - 64)
+    {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    sal_netbuf_init();
+
+    printf("%lu messages of %d..%d bytes, %d%% string data points, window %d, heap %lu bytes, "
+           "netbuf %d x %d bytes\n", opt.count, opt.min_len, opt.max_len, opt.string_percent, opt.window,
+           (unsigned long) opt.heap_size, SAL_NETBUF_BLOCK_NUM, SAL_NETBUF_BLOCK_SIZE);
+
+    bench_alloc(&opt);
+
+    memset(&flat, 0, sizeof(flat));
+    memset(&queue, 0, sizeof(queue));
+    memset(&sendmsg, 0, sizeof(sendmsg));
+    memset(&at, 0, sizeof(at));
+    memset(&sendto, 0, sizeof(sendto));
+    bench_run_flat(&opt, &flat, 0);
+    bench_run_flat(&opt, &queue, 1);
+    bench_sink = BENCH_SINK_SENDMSG;
+    bench_run_netbuf(&opt, &sendmsg);
+    bench_sink = BENCH_SINK_AT;
+    bench_run_netbuf(&opt, &at);
+    bench_sink = BENCH_SINK_SENDTO;
+    bench_run_netbuf(&opt, &sendto);
+
+    printf("\npipeline         copy/B  B/send  RAM peak heap peak  allocs largest  frags  failures   ns/KB\n");
+    bench_print("flat buffers", &flat);
+    bench_print("netbuf queue", &queue);
+    bench_print("netbuf, lwIP", &sendmsg);
+    bench_print("netbuf, AT", &at);
+    bench_print("netbuf, sendto", &sendto);
+    printf("\nnetbuf pool peak: %lu bytes (queue), %lu bytes (lwIP), %lu bytes (AT), %lu bytes (sendto)\n",
+           (unsigned long) queue.pool_peak, (unsigned long) sendmsg.pool_peak, (unsigned long) at.pool_peak,
+           (unsigned long) sendto.pool_peak);
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Configuration of the host build in place of the BSP rtconfig.h. Only the kernel options
+ * the network buffer pool and the memory heap depend on are set. The pool size is the one
+ * of the board, it can be overridden from the make command line, e.g.
+ * make D="-DSAL_NETBUF_BLOCK_SIZE=256 -DSAL_NETBUF_BLOCK_NUM=16".
+ */
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_MEMHEAP
+#define RT_USING_HEAP
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMSET
+#define RT_KSERVICE_USING_STDLIB_MEMCPY
+
+#define RT_USING_SAL
+#define SAL_USING_NETBUF
+#ifndef SAL_NETBUF_BLOCK_SIZE
+#define SAL_NETBUF_BLOCK_SIZE 512
+#endif
+#ifndef SAL_NETBUF_BLOCK_NUM
+#define SAL_NETBUF_BLOCK_NUM 8
+#endif
+
+#endif /* RT_CONFIG_H__ */
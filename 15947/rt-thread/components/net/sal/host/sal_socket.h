@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+#ifndef SAL_SOCKET_H__
+#define SAL_SOCKET_H__
+
+/*
+ * The SAL socket types clash with the host C library. The network buffer pool only needs
+ * the iovec and msghdr of the host and sal_sendmsg(), which the benchmark provides.
+ */
+#include <sys/uio.h>
+#include <sys/socket.h>
+
+int sal_sendmsg(int socket, const struct msghdr *message, int flags);
+
+#endif /* SAL_SOCKET_H__ */
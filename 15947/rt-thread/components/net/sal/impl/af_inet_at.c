@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-06-06     ChenYong     First version
+ * 2026-10-16     RT-Thread    add sendmsg operation
  */
 
 #include <rtthread.h>
@@ -83,6 +84,7 @@ static const struct sal_socket_ops at_socket_ops =
 #ifdef SAL_USING_POSIX
     at_poll,
 #endif /* SAL_USING_POSIX */
+    at_sendmsg,
 };
 
 static const struct sal_netdb_ops at_netdb_ops =
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-05-17     ChenYong     First version
+ * 2026-10-16     RT-Thread    add sendmsg operation
  */
 
 #include <rtthread.h>
@@ -303,6 +304,7 @@ static const struct sal_socket_ops lwip_socket_ops =
 #ifdef SAL_USING_POSIX
     inet_poll,
 #endif
+    lwip_sendmsg,
 };
 
 static const struct sal_netdb_ops lwip_netdb_ops =
@@ -6,6 +6,9 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-05-17     ChenYong     First version
+ * 2026-10-16     RT-Thread    add name resolving cache
+ * 2026-10-16     RT-Thread    add epoll readiness interface
+ * 2026-10-16     RT-Thread    add sendmsg operation and network buffer pool
  */
 
 #ifndef SAL_H__
@@ -25,6 +28,8 @@ extern "C" {
 typedef uint32_t socklen_t;
 #endif
 
+struct msghdr;
+
 /* SAL socket magic word */
 #define SAL_SOCKET_MAGIC               0x5A10
 
@@ -80,6 +85,8 @@ struct sal_socket_ops
 #ifdef SAL_USING_POSIX
     int (*poll)       (struct dfs_fd *file, struct rt_pollreq *req);
 #endif
+    /* optional, sal_sendmsg() gathers the buffers and calls sendto if it is not supported */
+    int (*sendmsg)    (int s, const struct msghdr *message, int flags);
 };
 
 /* sal network database name resolving */
@@ -107,6 +114,35 @@ struct sal_socket *sal_get_socket(int sock);
 /* check SAL socket netweork interface device internet status */
 int sal_check_netdev_internet_up(struct netdev *netdev);
 
+#ifdef SAL_USING_NETDB_CACHE
+/* the longest host name and address kept by the name resolving cache */
+#define SAL_NETDB_CACHE_NAME_LEN       64
+#define SAL_NETDB_CACHE_ADDR_LEN       24
+/* buffer size to hold a cached host entry, see sal_netdb_cache_gethostbyname() */
+#define SAL_NETDB_CACHE_HOSTBUF_SIZE   (4 * sizeof(char *) + SAL_NETDB_CACHE_ADDR_LEN + SAL_NETDB_CACHE_NAME_LEN)
+
+/* SAL name resolving cache, lookups return 1 on a hit, -1 on a cached failure and 0 on a miss */
+int sal_netdb_cache_init(void);
+int sal_netdb_cache_gethostbyname(const char *name, struct hostent *ret, char *buf, size_t buflen);
+void sal_netdb_cache_put_host(struct netdev *netdev, const char *name, const struct hostent *host);
+int sal_netdb_cache_getaddrinfo(const char *nodename, const char *servname,
+                                const struct addrinfo *hints, struct addrinfo **res);
+void sal_netdb_cache_put_addrinfo(struct netdev *netdev, const char *nodename, const char *servname,
+                                  const struct addrinfo *hints, int result, const struct addrinfo *res);
+rt_bool_t sal_netdb_cache_freeaddrinfo(struct addrinfo *ai);
+#endif /* SAL_USING_NETDB_CACHE */
+
+#ifdef SAL_USING_NETBUF
+/* SAL network buffer pool, see sal_netbuf.h */
+int sal_netbuf_init(void);
+#endif
+
+#ifdef SAL_USING_EPOLL
+/* SAL epoll readiness interface, see sal_epoll.h */
+int sal_epoll_init(void);
+void sal_epoll_socket_close(int socket);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
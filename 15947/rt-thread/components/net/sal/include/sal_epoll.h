@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    First version
+ */
+#ifndef __SAL_EPOLL_H__
+#define __SAL_EPOLL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <rtthread.h>
+#include <poll.h>
+
+/* readiness events, the same values as poll() */
+#define SAL_EPOLLIN         POLLIN
+#define SAL_EPOLLOUT        POLLOUT
+#define SAL_EPOLLERR        POLLERR
+#define SAL_EPOLLHUP        POLLHUP
+/* report the socket once when it becomes ready, not while it stays ready */
+#define SAL_EPOLLET         0x40000000
+/* disable the socket after it is reported, until SAL_EPOLL_CTL_MOD */
+#define SAL_EPOLLONESHOT    0x20000000
+
+/* sal_epoll_ctl() operations */
+#define SAL_EPOLL_CTL_ADD   1
+#define SAL_EPOLL_CTL_DEL   2
+#define SAL_EPOLL_CTL_MOD   3
+
+typedef union sal_epoll_data
+{
+    void *ptr;
+    int fd;
+    rt_uint32_t u32;
+} sal_epoll_data_t;
+
+struct sal_epoll_event
+{
+    rt_uint32_t events;
+    sal_epoll_data_t data;
+};
+
+typedef struct sal_epoll *sal_epoll_t;
+
+sal_epoll_t sal_epoll_create(void);
+int sal_epoll_delete(sal_epoll_t ep);
+int sal_epoll_ctl(sal_epoll_t ep, int op, int fd, const struct sal_epoll_event *event);
+int sal_epoll_wait(sal_epoll_t ep, struct sal_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SAL_EPOLL_H__ */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    First version
+ */
+#ifndef __SAL_NETBUF_H__
+#define __SAL_NETBUF_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <rtthread.h>
+
+/* the data size of a network buffer block */
+#ifndef SAL_NETBUF_BLOCK_SIZE
+#define SAL_NETBUF_BLOCK_SIZE       256
+#endif
+/* the number of network buffer blocks in the pool */
+#ifndef SAL_NETBUF_BLOCK_NUM
+#define SAL_NETBUF_BLOCK_NUM        16
+#endif
+/* the most blocks of a chain sal_netbuf_send() can send */
+#ifndef SAL_NETBUF_IOV_MAX
+#define SAL_NETBUF_IOV_MAX          8
+#endif
+
+/*
+ * A network buffer is a fixed size block of the pool, a message larger than a block is
+ * held by a chain of buffers. The reference count lets several owners, e.g. a retransmit
+ * queue and the sender, hold the same chain: sal_netbuf_ref() adds a reference to the
+ * first buffer, sal_netbuf_free() drops one and returns the buffers no longer referenced.
+ */
+struct sal_netbuf
+{
+    struct sal_netbuf *next;        /* next buffer of the chain */
+    rt_uint8_t *payload;            /* the data of this buffer */
+    rt_uint16_t len;                /* the data length of this buffer */
+    rt_uint16_t ref;                /* reference count */
+};
+
+struct sal_netbuf_stats
+{
+    rt_uint16_t total;              /* blocks in the pool */
+    rt_uint16_t used;               /* blocks in use */
+    rt_uint16_t peak;               /* the most blocks ever in use */
+    rt_uint32_t alloc;              /* blocks allocated */
+    rt_uint32_t fail;               /* allocations failed with the pool empty */
+};
+
+struct sal_netbuf *sal_netbuf_alloc(void);
+void sal_netbuf_ref(struct sal_netbuf *nb);
+int sal_netbuf_free(struct sal_netbuf *nb);
+void sal_netbuf_cat(struct sal_netbuf *head, struct sal_netbuf *tail);
+
+rt_size_t sal_netbuf_append(struct sal_netbuf **chain, const void *data, rt_size_t len);
+rt_size_t sal_netbuf_len(const struct sal_netbuf *nb);
+rt_size_t sal_netbuf_space(const struct sal_netbuf *nb);
+rt_size_t sal_netbuf_copy(const struct sal_netbuf *nb, rt_size_t offset, void *buf, rt_size_t len);
+int sal_netbuf_send(int socket, const struct sal_netbuf *nb, int flags);
+
+void sal_netbuf_get_stats(struct sal_netbuf_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SAL_NETBUF_H__ */
@@ -79,6 +79,11 @@ int sal_getaddrinfo(const char *nodename,
        const struct addrinfo *hints,
        struct addrinfo **res);
 
+#ifdef SAL_USING_NETDB_CACHE
+/* drop the cached result of a host name, or of all names if name is RT_NULL */
+void sal_netdb_cache_flush(const char *name);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
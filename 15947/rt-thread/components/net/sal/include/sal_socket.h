@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-05-24     ChenYong     First version
+ * 2026-10-16     RT-Thread    add sal_sendmsg
  */
 
 #ifndef SAL_SOCKET_H__
@@ -194,6 +195,30 @@ struct sockaddr_storage
 #endif /* NETDEV_IPV6 */
 };
 
+/* the maximum number of buffers passed to sal_sendmsg() */
+#ifndef IOV_MAX
+#define IOV_MAX         0xFFFF
+#endif
+
+#if !defined(iovec)
+struct iovec
+{
+    void  *iov_base;
+    size_t iov_len;
+};
+#endif
+
+struct msghdr
+{
+    void         *msg_name;
+    socklen_t     msg_namelen;
+    struct iovec *msg_iov;
+    int           msg_iovlen;
+    void         *msg_control;
+    socklen_t     msg_controllen;
+    int           msg_flags;
+};
+
 int sal_accept(int socket, struct sockaddr *addr, socklen_t *addrlen);
 int sal_bind(int socket, const struct sockaddr *name, socklen_t namelen);
 int sal_shutdown(int socket, int how);
@@ -207,6 +232,7 @@ int sal_recvfrom(int socket, void *mem, size_t len, int flags,
       struct sockaddr *from, socklen_t *fromlen);
 int sal_sendto(int socket, const void *dataptr, size_t size, int flags,
     const struct sockaddr *to, socklen_t tolen);
+int sal_sendmsg(int socket, const struct msghdr *message, int flags);
 int sal_socket(int domain, int type, int protocol);
 int sal_closesocket(int socket);
 int sal_ioctlsocket(int socket, long cmd, void *arg);
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2015-02-17     Bernard      First version
  * 2018-05-17     ChenYong     Add socket abstraction layer
+ * 2026-10-16     RT-Thread    Add sendmsg
  */
 
 #include <dfs.h>
@@ -194,6 +195,14 @@ int sendto(int s, const void *dataptr, size_t size, int flags,
 }
 RTM_EXPORT(sendto);
 
+int sendmsg(int s, const struct msghdr *message, int flags)
+{
+    int socket = dfs_net_getsocket(s);
+
+    return sal_sendmsg(socket, message, flags);
+}
+RTM_EXPORT(sendmsg);
+
 int socket(int domain, int type, int protocol)
 {
     /* create a BSD socket */
@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    First version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+
+#include <sal_socket.h>
+#include <sal_netdb.h>
+#include <sal.h>
+
+#ifdef SAL_USING_EPOLL
+
+#include <dfs_file.h>
+#include <sal_epoll.h>
+
+#define DBG_TAG                        "sal.epoll"
+#define DBG_LVL                        DBG_INFO
+#include <rtdbg.h>
+
+#define SAL_EPOLL_EVENT_READY          0x01
+
+/*
+ * A registered socket. Its wait queue node stays hooked on the socket wait queue while
+ * registered, so the protocol family event wakes it up without the socket being polled.
+ */
+struct sal_epoll_item
+{
+    struct rt_wqueue_node wqn;         /* hooked on the socket wait queue, key is the interest mask */
+    rt_wqueue_t *wq;
+    rt_list_t list;                    /* node of the interest list */
+    rt_list_t ready;                   /* node of the ready list, empty if not ready */
+    struct sal_epoll *ep;
+    int fd;                            /* file descriptor */
+    int socket;                        /* SAL socket descriptor */
+    struct sal_epoll_event event;
+};
+
+struct sal_epoll
+{
+    rt_list_t list;                    /* node of the instance list */
+    rt_list_t items;                   /* the interest list */
+    rt_list_t ready_list;              /* the sockets woken up and not checked yet */
+    struct rt_event notice;
+};
+
+/* poll request to hook the item on the socket wait queue */
+struct sal_epoll_pollreq
+{
+    rt_pollreq_t req;
+    struct sal_epoll_item *item;
+};
+
+static rt_list_t sal_epoll_list = RT_LIST_OBJECT_INIT(sal_epoll_list);
+static struct rt_mutex sal_epoll_lock;
+static rt_bool_t init_ok = RT_FALSE;
+
+/* called from rt_wqueue_wakeup() with interrupt disabled */
+static int sal_epoll_wakeup(struct rt_wqueue_node *wait, void *key)
+{
+    struct sal_epoll_item *item = rt_container_of(wait, struct sal_epoll_item, wqn);
+
+    if (wait->key == 0 || (key && !((rt_ubase_t) key & wait->key)))
+    {
+        return -1;
+    }
+
+    if (rt_list_isempty(&item->ready))
+    {
+        rt_list_insert_before(&item->ep->ready_list, &item->ready);
+    }
+    rt_event_send(&item->ep->notice, SAL_EPOLL_EVENT_READY);
+
+    /* the node stays on the wait queue, and the next waiter is woken up as well */
+    return -1;
+}
+
+static void sal_epoll_hook(rt_wqueue_t *wq, rt_pollreq_t *req)
+{
+    struct sal_epoll_item *item = rt_container_of(req, struct sal_epoll_pollreq, req)->item;
+
+    if (item->wq == RT_NULL)
+    {
+        item->wq = wq;
+        rt_wqueue_add(wq, &item->wqn);
+    }
+}
+
+static rt_uint32_t sal_epoll_key(const struct sal_epoll_event *event)
+{
+    return (event->events & (SAL_EPOLLIN | SAL_EPOLLOUT)) | SAL_EPOLLERR | SAL_EPOLLHUP;
+}
+
+/* get the events ready on the socket, hook the item on its wait queue if hook is set */
+static rt_uint32_t sal_epoll_check(struct sal_epoll_item *item, rt_bool_t hook)
+{
+    struct sal_epoll_pollreq pr;
+    struct dfs_fd *file;
+    int mask;
+
+    pr.req._proc = hook ? sal_epoll_hook : RT_NULL;
+    pr.req._key = (short) item->wqn.key;
+    pr.item = item;
+
+    file = fd_get(item->fd);
+    if (file == RT_NULL)
+    {
+        return SAL_EPOLLERR | SAL_EPOLLHUP;
+    }
+
+    mask = file->fops->poll(file, &pr.req);
+    fd_put(file);
+
+    /* the network interface is down or the socket is invalid */
+    if (mask < 0)
+    {
+        mask = SAL_EPOLLERR;
+    }
+
+    return (rt_uint32_t) mask & item->wqn.key;
+}
+
+static void sal_epoll_ready(struct sal_epoll_item *item)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (rt_list_isempty(&item->ready))
+    {
+        rt_list_insert_before(&item->ep->ready_list, &item->ready);
+    }
+    rt_hw_interrupt_enable(level);
+
+    rt_event_send(&item->ep->notice, SAL_EPOLL_EVENT_READY);
+}
+
+/* unhook and free an item, must hold the epoll lock */
+static void sal_epoll_item_free(struct sal_epoll_item *item)
+{
+    rt_base_t level;
+
+    if (item->wq)
+    {
+        rt_wqueue_remove(&item->wqn);
+    }
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&item->ready);
+    rt_hw_interrupt_enable(level);
+
+    rt_list_remove(&item->list);
+    rt_free(item);
+}
+
+static struct sal_epoll_item *sal_epoll_item_find(struct sal_epoll *ep, int fd)
+{
+    struct sal_epoll_item *item;
+
+    rt_list_for_each_entry(item, &ep->items, list)
+    {
+        if (item->fd == fd)
+        {
+            return item;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* check the woken up sockets and fill in the events, must hold the epoll lock */
+static int sal_epoll_harvest(struct sal_epoll *ep, struct sal_epoll_event *events, int maxevents)
+{
+    struct sal_epoll_item *item;
+    rt_list_t pending, *node;
+    rt_uint32_t mask;
+    rt_base_t level;
+    int num = 0;
+
+    /* take the ready list, a socket woken up again while checked goes back to the ready list */
+    rt_list_init(&pending);
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&ep->ready_list))
+    {
+        pending.next = ep->ready_list.next;
+        pending.prev = ep->ready_list.prev;
+        pending.next->prev = &pending;
+        pending.prev->next = &pending;
+        rt_list_init(&ep->ready_list);
+    }
+    rt_hw_interrupt_enable(level);
+
+    while (num < maxevents)
+    {
+        level = rt_hw_interrupt_disable();
+        if (rt_list_isempty(&pending))
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+        item = rt_list_first_entry(&pending, struct sal_epoll_item, ready);
+        rt_list_remove(&item->ready);
+        rt_hw_interrupt_enable(level);
+
+        mask = sal_epoll_check(item, RT_FALSE);
+        if (mask == 0)
+        {
+            continue;
+        }
+
+        events[num].events = mask;
+        events[num].data = item->event.data;
+        num++;
+
+        if (item->event.events & SAL_EPOLLONESHOT)
+        {
+            level = rt_hw_interrupt_disable();
+            item->wqn.key = 0;
+            rt_hw_interrupt_enable(level);
+        }
+        else if (!(item->event.events & SAL_EPOLLET))
+        {
+            /* level triggered, checked again by the next wait */
+            sal_epoll_ready(item);
+        }
+    }
+
+    /* put the sockets not checked back to the front of the ready list */
+    level = rt_hw_interrupt_disable();
+    while (!rt_list_isempty(&pending))
+    {
+        node = pending.prev;
+        rt_list_remove(node);
+        rt_list_insert_after(&ep->ready_list, node);
+    }
+    rt_hw_interrupt_enable(level);
+
+    return num;
+}
+
+/**
+ * This function will create an epoll instance.
+ *
+ * @return the epoll instance, RT_NULL if out of memory
+ */
+sal_epoll_t sal_epoll_create(void)
+{
+    struct sal_epoll *ep;
+
+    if (init_ok == RT_FALSE)
+    {
+        LOG_E("Socket Abstraction Layer is not initialized.");
+        return RT_NULL;
+    }
+
+    ep = (struct sal_epoll *) rt_calloc(1, sizeof(struct sal_epoll));
+    if (ep == RT_NULL)
+    {
+        LOG_E("No memory for epoll instance.");
+        return RT_NULL;
+    }
+
+    rt_list_init(&ep->items);
+    rt_list_init(&ep->ready_list);
+    rt_event_init(&ep->notice, "sal_ep", RT_IPC_FLAG_PRIO);
+
+    rt_mutex_take(&sal_epoll_lock, RT_WAITING_FOREVER);
+    rt_list_insert_after(&sal_epoll_list, &ep->list);
+    rt_mutex_release(&sal_epoll_lock);
+
+    return ep;
+}
+
+/**
+ * This function will delete an epoll instance and remove all sockets registered on it.
+ * No thread may be waiting on the instance.
+ *
+ * @param ep the epoll instance
+ *
+ * @return 0: delete success
+ */
+int sal_epoll_delete(sal_epoll_t ep)
+{
+    struct sal_epoll_item *item, *next;
+
+    RT_ASSERT(ep);
+
+    rt_mutex_take(&sal_epoll_lock, RT_WAITING_FOREVER);
+    rt_list_for_each_entry_safe(item, next, &ep->items, list)
+    {
+        sal_epoll_item_free(item);
+    }
+    rt_list_remove(&ep->list);
+    rt_mutex_release(&sal_epoll_lock);
+
+    rt_event_detach(&ep->notice);
+    rt_free(ep);
+
+    return 0;
+}
+
+/**
+ * This function will add, modify or remove a socket on an epoll instance.
+ *
+ * @param ep the epoll instance
+ * @param op SAL_EPOLL_CTL_ADD, SAL_EPOLL_CTL_MOD or SAL_EPOLL_CTL_DEL
+ * @param fd the socket file descriptor
+ * @param event the interest events and the user data reported with them, not used by SAL_EPOLL_CTL_DEL
+ *
+ * @return 0: success
+ *        -1: not a socket, already added, not added or out of memory
+ */
+int sal_epoll_ctl(sal_epoll_t ep, int op, int fd, const struct sal_epoll_event *event)
+{
+    struct sal_epoll_item *item;
+    struct dfs_fd *file;
+    rt_uint32_t mask;
+    rt_base_t level;
+    int socket, result = 0;
+
+    RT_ASSERT(ep);
+
+    if (op != SAL_EPOLL_CTL_DEL && event == RT_NULL)
+    {
+        return -1;
+    }
+
+    file = fd_get(fd);
+    if (file == RT_NULL)
+    {
+        return -1;
+    }
+    socket = (int) file->data;
+    result = (file->type == FT_SOCKET && file->fops->poll) ? 0 : -1;
+    fd_put(file);
+    if (result < 0)
+    {
+        return -1;
+    }
+
+    rt_mutex_take(&sal_epoll_lock, RT_WAITING_FOREVER);
+
+    item = sal_epoll_item_find(ep, fd);
+    switch (op)
+    {
+    case SAL_EPOLL_CTL_ADD:
+        if (item)
+        {
+            result = -1;
+            break;
+        }
+
+        item = (struct sal_epoll_item *) rt_calloc(1, sizeof(struct sal_epoll_item));
+        if (item == RT_NULL)
+        {
+            LOG_E("No memory for epoll item.");
+            result = -1;
+            break;
+        }
+
+        rt_list_init(&item->wqn.list);
+        item->wqn.polling_thread = rt_thread_self();
+        item->wqn.wakeup = sal_epoll_wakeup;
+        item->wqn.key = sal_epoll_key(event);
+        rt_list_init(&item->ready);
+        item->ep = ep;
+        item->fd = fd;
+        item->socket = socket;
+        item->event = *event;
+        rt_list_insert_before(&ep->items, &item->list);
+
+        mask = sal_epoll_check(item, RT_TRUE);
+        if (mask)
+        {
+            sal_epoll_ready(item);
+        }
+        break;
+
+    case SAL_EPOLL_CTL_MOD:
+        if (item == RT_NULL)
+        {
+            result = -1;
+            break;
+        }
+
+        level = rt_hw_interrupt_disable();
+        item->wqn.key = sal_epoll_key(event);
+        item->event = *event;
+        rt_hw_interrupt_enable(level);
+
+        mask = sal_epoll_check(item, RT_TRUE);
+        if (mask)
+        {
+            sal_epoll_ready(item);
+        }
+        break;
+
+    case SAL_EPOLL_CTL_DEL:
+        if (item == RT_NULL)
+        {
+            result = -1;
+            break;
+        }
+
+        sal_epoll_item_free(item);
+        break;
+
+    default:
+        result = -1;
+        break;
+    }
+
+    rt_mutex_release(&sal_epoll_lock);
+
+    return result;
+}
+
+/**
+ * This function will wait for the registered sockets to become ready. Only the sockets
+ * woken up by their protocol family are checked, not the whole interest list.
+ *
+ * @param ep the epoll instance
+ * @param events the buffer of the ready events
+ * @param maxevents the maximum number of events to return
+ * @param timeout the timeout in milliseconds, -1 waits forever
+ *
+ * @return the number of ready events, 0 on timeout
+ *         -1: bad parameters
+ */
+int sal_epoll_wait(sal_epoll_t ep, struct sal_epoll_event *events, int maxevents, int timeout)
+{
+    rt_tick_t deadline = 0;
+    rt_int32_t wait_tick;
+    int num;
+
+    RT_ASSERT(ep);
+
+    if (events == RT_NULL || maxevents <= 0)
+    {
+        return -1;
+    }
+
+    if (timeout > 0)
+    {
+        deadline = rt_tick_get() + rt_tick_from_millisecond(timeout);
+    }
+
+    while (1)
+    {
+        rt_mutex_take(&sal_epoll_lock, RT_WAITING_FOREVER);
+        num = sal_epoll_harvest(ep, events, maxevents);
+        rt_mutex_release(&sal_epoll_lock);
+
+        if (num > 0 || timeout == 0)
+        {
+            break;
+        }
+
+        if (timeout < 0)
+        {
+            wait_tick = RT_WAITING_FOREVER;
+        }
+        else
+        {
+            wait_tick = (rt_int32_t)(deadline - rt_tick_get());
+            if (wait_tick <= 0)
+            {
+                break;
+            }
+        }
+
+        /* a wakeup after the harvest leaves the event set, so it is not missed here */
+        if (rt_event_recv(&ep->notice, SAL_EPOLL_EVENT_READY, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                          wait_tick, RT_NULL) != RT_EOK)
+        {
+            break;
+        }
+    }
+
+    return num;
+}
+
+/* remove a SAL socket from all epoll instances before the protocol family frees its wait queue */
+void sal_epoll_socket_close(int socket)
+{
+    struct sal_epoll *ep;
+    struct sal_epoll_item *item, *next;
+
+    if (init_ok == RT_FALSE)
+    {
+        return;
+    }
+
+    rt_mutex_take(&sal_epoll_lock, RT_WAITING_FOREVER);
+    rt_list_for_each_entry(ep, &sal_epoll_list, list)
+    {
+        rt_list_for_each_entry_safe(item, next, &ep->items, list)
+        {
+            if (item->socket == socket)
+            {
+                sal_epoll_item_free(item);
+            }
+        }
+    }
+    rt_mutex_release(&sal_epoll_lock);
+}
+
+int sal_epoll_init(void)
+{
+    if (init_ok)
+    {
+        return 0;
+    }
+
+    rt_mutex_init(&sal_epoll_lock, "sal_ep", RT_IPC_FLAG_PRIO);
+    init_ok = RT_TRUE;
+
+    return 0;
+}
+
+#endif /* SAL_USING_EPOLL */
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+
+#include <sal_socket.h>
+#include <sal_netbuf.h>
+
+#define DBG_TAG              "sal.nbuf"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef SAL_USING_NETBUF
+
+#define SAL_NETBUF_HEAD_SIZE           RT_ALIGN(sizeof(struct sal_netbuf), RT_ALIGN_SIZE)
+#define SAL_NETBUF_STRIDE              (SAL_NETBUF_HEAD_SIZE + RT_ALIGN(SAL_NETBUF_BLOCK_SIZE, RT_ALIGN_SIZE))
+#define SAL_NETBUF_DATA(nb)            ((rt_uint8_t *)(nb) + SAL_NETBUF_HEAD_SIZE)
+#define SAL_NETBUF_END(nb)             (SAL_NETBUF_DATA(nb) + SAL_NETBUF_BLOCK_SIZE)
+
+ALIGN(RT_ALIGN_SIZE) static rt_uint8_t netbuf_pool[SAL_NETBUF_BLOCK_NUM * SAL_NETBUF_STRIDE];
+/* the free blocks are linked by the next field */
+static struct sal_netbuf *netbuf_free_list = RT_NULL;
+static struct sal_netbuf_stats netbuf_stats;
+static rt_bool_t netbuf_init_ok = RT_FALSE;
+
+int sal_netbuf_init(void)
+{
+    struct sal_netbuf *nb;
+    int i;
+
+    if (netbuf_init_ok)
+    {
+        return 0;
+    }
+
+    netbuf_free_list = RT_NULL;
+    for (i = SAL_NETBUF_BLOCK_NUM - 1; i >= 0; i--)
+    {
+        nb = (struct sal_netbuf *) &netbuf_pool[i * SAL_NETBUF_STRIDE];
+        nb->next = netbuf_free_list;
+        netbuf_free_list = nb;
+    }
+
+    rt_memset(&netbuf_stats, 0x00, sizeof(netbuf_stats));
+    netbuf_stats.total = SAL_NETBUF_BLOCK_NUM;
+    netbuf_init_ok = RT_TRUE;
+
+    return 0;
+}
+
+/**
+ * This function will allocate an empty network buffer with one reference.
+ * It never blocks and can be called in the interrupt context.
+ *
+ * @return the network buffer, RT_NULL if the pool is empty
+ */
+struct sal_netbuf *sal_netbuf_alloc(void)
+{
+    struct sal_netbuf *nb;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    nb = netbuf_free_list;
+    if (nb == RT_NULL)
+    {
+        netbuf_stats.fail++;
+        rt_hw_interrupt_enable(level);
+        return RT_NULL;
+    }
+
+    netbuf_free_list = nb->next;
+    netbuf_stats.alloc++;
+    if (++netbuf_stats.used > netbuf_stats.peak)
+    {
+        netbuf_stats.peak = netbuf_stats.used;
+    }
+    rt_hw_interrupt_enable(level);
+
+    nb->next = RT_NULL;
+    nb->payload = SAL_NETBUF_DATA(nb);
+    nb->len = 0;
+    nb->ref = 1;
+
+    return nb;
+}
+
+/**
+ * This function will add a reference to the network buffer chain.
+ *
+ * @param nb the first network buffer of the chain
+ */
+void sal_netbuf_ref(struct sal_netbuf *nb)
+{
+    rt_base_t level;
+
+    RT_ASSERT(nb);
+
+    level = rt_hw_interrupt_disable();
+    RT_ASSERT(nb->ref > 0);
+    nb->ref++;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will drop a reference to the network buffer chain. The buffers from the
+ * head of the chain are returned to the pool until one is still referenced elsewhere.
+ *
+ * @param nb the first network buffer of the chain
+ *
+ * @return the number of network buffers returned to the pool
+ */
+int sal_netbuf_free(struct sal_netbuf *nb)
+{
+    struct sal_netbuf *next;
+    rt_base_t level;
+    int count = 0;
+
+    while (nb)
+    {
+        level = rt_hw_interrupt_disable();
+        RT_ASSERT(nb->ref > 0);
+        if (--nb->ref > 0)
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        next = nb->next;
+        nb->next = netbuf_free_list;
+        netbuf_free_list = nb;
+        netbuf_stats.used--;
+        rt_hw_interrupt_enable(level);
+
+        count++;
+        nb = next;
+    }
+
+    return count;
+}
+
+/**
+ * This function will link a network buffer chain to the end of another one.
+ * The reference of the caller to the tail chain is taken over by the head chain.
+ *
+ * @param head the chain to be extended
+ * @param tail the chain to be linked
+ */
+void sal_netbuf_cat(struct sal_netbuf *head, struct sal_netbuf *tail)
+{
+    RT_ASSERT(head);
+
+    while (head->next)
+    {
+        head = head->next;
+    }
+    head->next = tail;
+}
+
+/**
+ * This function will copy data to the end of a network buffer chain, the buffers are
+ * allocated as needed. The chain must not be shared by others.
+ *
+ * @param chain the chain, a new chain is allocated if it is RT_NULL
+ * @param data the data to be copied
+ * @param len the data length
+ *
+ * @return the length copied, less than len if the pool is empty
+ */
+rt_size_t sal_netbuf_append(struct sal_netbuf **chain, const void *data, rt_size_t len)
+{
+    struct sal_netbuf *tail;
+    const rt_uint8_t *pos = (const rt_uint8_t *) data;
+    rt_size_t space, copied = 0;
+
+    RT_ASSERT(chain);
+
+    tail = *chain;
+    while (tail && tail->next)
+    {
+        tail = tail->next;
+    }
+
+    while (copied < len)
+    {
+        space = tail ? sal_netbuf_space(tail) : 0;
+        if (space == 0)
+        {
+            struct sal_netbuf *nb = sal_netbuf_alloc();
+
+            if (nb == RT_NULL)
+            {
+                break;
+            }
+
+            if (tail)
+            {
+                tail->next = nb;
+            }
+            else
+            {
+                *chain = nb;
+            }
+            tail = nb;
+            space = SAL_NETBUF_BLOCK_SIZE;
+        }
+
+        if (space > len - copied)
+        {
+            space = len - copied;
+        }
+        rt_memcpy(tail->payload + tail->len, pos + copied, space);
+        tail->len += space;
+        copied += space;
+    }
+
+    return copied;
+}
+
+/**
+ * This function will get the data length of a network buffer chain.
+ *
+ * @param nb the first network buffer of the chain
+ *
+ * @return the data length
+ */
+rt_size_t sal_netbuf_len(const struct sal_netbuf *nb)
+{
+    rt_size_t len = 0;
+
+    for (; nb; nb = nb->next)
+    {
+        len += nb->len;
+    }
+
+    return len;
+}
+
+/**
+ * This function will get the free room after the data of a network buffer, where a message
+ * can be written in place and then added by increasing the length.
+ *
+ * @param nb the network buffer
+ *
+ * @return the free room
+ */
+rt_size_t sal_netbuf_space(const struct sal_netbuf *nb)
+{
+    RT_ASSERT(nb);
+
+    return (rt_size_t)(SAL_NETBUF_END(nb) - (nb->payload + nb->len));
+}
+
+/**
+ * This function will copy the data of a network buffer chain into a flat buffer.
+ *
+ * @param nb the first network buffer of the chain
+ * @param offset the offset in the chain of the first byte copied
+ * @param buf the buffer
+ * @param len the buffer size
+ *
+ * @return the length copied
+ */
+rt_size_t sal_netbuf_copy(const struct sal_netbuf *nb, rt_size_t offset, void *buf, rt_size_t len)
+{
+    rt_uint8_t *pos = (rt_uint8_t *) buf;
+    rt_size_t size, copied = 0;
+
+    for (; nb && copied < len; nb = nb->next)
+    {
+        if (offset >= nb->len)
+        {
+            offset -= nb->len;
+            continue;
+        }
+
+        size = nb->len - offset;
+        if (size > len - copied)
+        {
+            size = len - copied;
+        }
+        rt_memcpy(pos + copied, nb->payload + offset, size);
+        copied += size;
+        offset = 0;
+    }
+
+    return copied;
+}
+
+/**
+ * This function will send a network buffer chain as one message without copying it,
+ * if the protocol of the socket supports sendmsg.
+ *
+ * @param socket the socket descriptor
+ * @param nb the first network buffer of the chain
+ * @param flags the send flags
+ *
+ * @return the number of bytes sent, -1 on failure
+ */
+int sal_netbuf_send(int socket, const struct sal_netbuf *nb, int flags)
+{
+    struct iovec iov[SAL_NETBUF_IOV_MAX];
+    struct msghdr message;
+    int count = 0;
+
+    for (; nb; nb = nb->next)
+    {
+        if (nb->len == 0)
+        {
+            continue;
+        }
+
+        if (count == SAL_NETBUF_IOV_MAX)
+        {
+            LOG_E("network buffer chain is longer than %d buffers.", SAL_NETBUF_IOV_MAX);
+            return -1;
+        }
+
+        iov[count].iov_base = nb->payload;
+        iov[count].iov_len = nb->len;
+        count++;
+    }
+
+    rt_memset(&message, 0x00, sizeof(message));
+    message.msg_iov = iov;
+    message.msg_iovlen = count;
+
+    return sal_sendmsg(socket, &message, flags);
+}
+
+/**
+ * This function will get the usage statistics of the network buffer pool.
+ *
+ * @param stats the statistics snapshot
+ */
+void sal_netbuf_get_stats(struct sal_netbuf_stats *stats)
+{
+    rt_base_t level;
+
+    RT_ASSERT(stats);
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(stats, &netbuf_stats, sizeof(struct sal_netbuf_stats));
+    rt_hw_interrupt_enable(level);
+}
+
+#ifdef RT_USING_FINSH
+static int sal_netbuf_list(void)
+{
+    struct sal_netbuf_stats stats;
+
+    sal_netbuf_get_stats(&stats);
+    rt_kprintf("block size: %d bytes, blocks: %d, used: %d, peak: %d\n",
+               SAL_NETBUF_BLOCK_SIZE, stats.total, stats.used, stats.peak);
+    rt_kprintf("allocated: %d, failed: %d, pool memory: %d bytes\n",
+               stats.alloc, stats.fail, sizeof(netbuf_pool));
+
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(sal_netbuf_list, netbuf, show the network buffer pool usage);
+#endif /* RT_USING_FINSH */
+
+#endif /* SAL_USING_NETBUF */
@@ -0,0 +1,601 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+
+#include <sal_socket.h>
+#include <sal_netdb.h>
+#include <sal.h>
+#include <netdev.h>
+
+#ifdef SAL_USING_NETDB_CACHE
+
+#ifndef SAL_NETDB_CACHE_NUM
+#define SAL_NETDB_CACHE_NUM            8
+#endif
+
+/* lifetime of resolved and failed names in seconds */
+#ifndef SAL_NETDB_CACHE_TTL
+#define SAL_NETDB_CACHE_TTL            300
+#endif
+#ifndef SAL_NETDB_CACHE_NEG_TTL
+#define SAL_NETDB_CACHE_NEG_TTL        10
+#endif
+
+/* the number of getaddrinfo() results served from the cache and not freed yet */
+#ifndef SAL_NETDB_CACHE_AI_NUM
+#define SAL_NETDB_CACHE_AI_NUM         4
+#endif
+
+enum sal_netdb_cache_state
+{
+    SAL_NETDB_CACHE_EMPTY,
+    SAL_NETDB_CACHE_RESOLVED,
+    SAL_NETDB_CACHE_FAILED,
+};
+
+struct sal_netdb_cache_entry
+{
+    char name[SAL_NETDB_CACHE_NAME_LEN];
+    rt_uint8_t state;
+    rt_uint32_t hits;
+    rt_tick_t expire;                  /* the tick the entry becomes stale */
+    rt_tick_t used;                    /* the last hit, the oldest is replaced first */
+
+    /* gethostbyname() result, host_len is 0 if not resolved by this way yet */
+    int host_type;
+    int host_len;
+    rt_uint8_t host_addr[SAL_NETDB_CACHE_ADDR_LEN];
+
+    /* getaddrinfo() result with the port cleared, ai_addrlen is 0 if not resolved by this way yet */
+    int ai_family;
+    socklen_t ai_addrlen;
+    struct sockaddr_storage ai_addr;
+};
+
+/* getaddrinfo() result handed out on a cache hit */
+struct sal_netdb_cache_ai
+{
+    struct addrinfo ai;
+    struct sockaddr_storage addr;
+    rt_bool_t used;
+};
+
+static struct sal_netdb_cache_entry cache_table[SAL_NETDB_CACHE_NUM];
+static struct sal_netdb_cache_ai cache_ai_pool[SAL_NETDB_CACHE_AI_NUM];
+static struct rt_mutex cache_lock;
+static rt_bool_t cache_init_ok = RT_FALSE;
+
+static rt_uint32_t cache_hits, cache_neg_hits, cache_misses;
+
+/* numeric addresses resolve without a query and are not worth a cache entry */
+static rt_bool_t sal_netdb_cache_skip_name(const char *name)
+{
+    const char *p;
+
+    if (name == RT_NULL || cache_init_ok == RT_FALSE || rt_strlen(name) >= SAL_NETDB_CACHE_NAME_LEN)
+    {
+        return RT_TRUE;
+    }
+
+    for (p = name; *p; p++)
+    {
+        if (*p == ':')
+        {
+            return RT_TRUE;
+        }
+        if ((*p < '0' || *p > '9') && *p != '.')
+        {
+            return RT_FALSE;
+        }
+    }
+
+    return RT_TRUE;
+}
+
+/* parse a numeric service name, return -1 if the cache can't serve it */
+static int sal_netdb_cache_port(const char *servname)
+{
+    const char *p;
+    int port = 0;
+
+    if (servname == RT_NULL)
+    {
+        return 0;
+    }
+
+    for (p = servname; *p; p++)
+    {
+        if (*p < '0' || *p > '9' || port > 0xFFFF)
+        {
+            return -1;
+        }
+        port = port * 10 + (*p - '0');
+    }
+
+    return (p == servname || port > 0xFFFF) ? -1 : port;
+}
+
+static void sal_netdb_cache_set_port(struct sockaddr *addr, int port)
+{
+#if NETDEV_IPV6
+    if (addr->sa_family == AF_INET6)
+    {
+        ((struct sockaddr_in6 *) addr)->sin6_port = htons((uint16_t) port);
+        return;
+    }
+#endif
+
+    ((struct sockaddr_in *) addr)->sin_port = htons((uint16_t) port);
+}
+
+/* find a fresh entry by name, stale entries are emptied on the way. Must hold the cache lock. */
+static struct sal_netdb_cache_entry *sal_netdb_cache_find(const char *name)
+{
+    struct sal_netdb_cache_entry *entry;
+    rt_tick_t now = rt_tick_get();
+    int i;
+
+    for (i = 0; i < SAL_NETDB_CACHE_NUM; i++)
+    {
+        entry = &cache_table[i];
+        if (entry->state == SAL_NETDB_CACHE_EMPTY)
+        {
+            continue;
+        }
+
+        if ((rt_int32_t)(entry->expire - now) <= 0)
+        {
+            entry->state = SAL_NETDB_CACHE_EMPTY;
+            continue;
+        }
+
+        if (rt_strcasecmp(entry->name, name) == 0)
+        {
+            return entry;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* get the entry of a name to fill in, replacing the least recently used one if full. Must hold the cache lock. */
+static struct sal_netdb_cache_entry *sal_netdb_cache_alloc(const char *name)
+{
+    struct sal_netdb_cache_entry *entry, *victim = RT_NULL;
+    rt_tick_t now = rt_tick_get();
+    int i;
+
+    entry = sal_netdb_cache_find(name);
+    if (entry)
+    {
+        return entry;
+    }
+
+    for (i = 0; i < SAL_NETDB_CACHE_NUM; i++)
+    {
+        entry = &cache_table[i];
+        if (entry->state == SAL_NETDB_CACHE_EMPTY)
+        {
+            victim = entry;
+            break;
+        }
+
+        if (victim == RT_NULL || now - entry->used > now - victim->used)
+        {
+            victim = entry;
+        }
+    }
+
+    rt_memset(victim, 0x00, sizeof(struct sal_netdb_cache_entry));
+    rt_strncpy(victim->name, name, SAL_NETDB_CACHE_NAME_LEN - 1);
+    victim->used = now;
+
+    return victim;
+}
+
+static void sal_netdb_cache_set_state(struct sal_netdb_cache_entry *entry, enum sal_netdb_cache_state state)
+{
+    int ttl = (state == SAL_NETDB_CACHE_RESOLVED) ? SAL_NETDB_CACHE_TTL : SAL_NETDB_CACHE_NEG_TTL;
+
+    entry->state = state;
+    entry->expire = rt_tick_get() + rt_tick_from_millisecond(ttl * 1000);
+}
+
+/**
+ * This function will look up a host name in the cache and fill the host entry with the
+ * address list and name stored in the buffer.
+ *
+ * @param name the host name
+ * @param ret the host entry to fill in
+ * @param buf the buffer for the address list and name
+ * @param buflen the buffer size, SAL_NETDB_CACHE_HOSTBUF_SIZE is always enough
+ *
+ * @return 1: hit, -1: the name failed to resolve recently, 0: not cached
+ */
+int sal_netdb_cache_gethostbyname(const char *name, struct hostent *ret, char *buf, size_t buflen)
+{
+    struct sal_netdb_cache_entry *entry;
+    char **addr_list;
+    char *addr, *host_name;
+    size_t pad, name_len;
+    int result = 0;
+
+    if (sal_netdb_cache_skip_name(name))
+    {
+        return 0;
+    }
+
+    /* address list, empty alias list, address and name, the pointers aligned */
+    pad = (sizeof(char *) - ((rt_ubase_t) buf % sizeof(char *))) % sizeof(char *);
+    name_len = rt_strlen(name) + 1;
+
+    rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+
+    entry = sal_netdb_cache_find(name);
+    if (entry && entry->state == SAL_NETDB_CACHE_FAILED)
+    {
+        result = -1;
+    }
+    else if (entry && entry->host_len > 0 &&
+             buflen >= pad + 3 * sizeof(char *) + entry->host_len + name_len)
+    {
+        addr_list = (char **) (buf + pad);
+        addr = (char *) &addr_list[3];
+        host_name = addr + entry->host_len;
+
+        rt_memcpy(addr, entry->host_addr, entry->host_len);
+        rt_memcpy(host_name, name, name_len);
+        addr_list[0] = addr;
+        addr_list[1] = RT_NULL;
+        addr_list[2] = RT_NULL;
+
+        ret->h_name = host_name;
+        ret->h_aliases = &addr_list[2];
+        ret->h_addrtype = entry->host_type;
+        ret->h_length = entry->host_len;
+        ret->h_addr_list = addr_list;
+        result = 1;
+    }
+
+    if (result != 0)
+    {
+        entry->hits++;
+        entry->used = rt_tick_get();
+        (result > 0) ? cache_hits++ : cache_neg_hits++;
+    }
+    else
+    {
+        cache_misses++;
+    }
+
+    rt_mutex_release(&cache_lock);
+
+    return result;
+}
+
+/**
+ * This function will store the gethostbyname() result of a host name. A failed lookup is
+ * only remembered while the network interface device link is up, a device not attached
+ * yet must not keep names from resolving.
+ *
+ * @param netdev the network interface device the lookup went through
+ * @param name the host name
+ * @param host the lookup result, RT_NULL if the lookup failed
+ */
+void sal_netdb_cache_put_host(struct netdev *netdev, const char *name, const struct hostent *host)
+{
+    struct sal_netdb_cache_entry *entry;
+
+    if (sal_netdb_cache_skip_name(name))
+    {
+        return;
+    }
+
+    if (host == RT_NULL || host->h_addr_list == RT_NULL || host->h_addr_list[0] == RT_NULL)
+    {
+        if (netdev == RT_NULL || !netdev_is_link_up(netdev))
+        {
+            return;
+        }
+
+        rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+        entry = sal_netdb_cache_alloc(name);
+        if (entry->state != SAL_NETDB_CACHE_RESOLVED)
+        {
+            sal_netdb_cache_set_state(entry, SAL_NETDB_CACHE_FAILED);
+        }
+        rt_mutex_release(&cache_lock);
+        return;
+    }
+
+    if (host->h_length <= 0 || host->h_length > SAL_NETDB_CACHE_ADDR_LEN)
+    {
+        return;
+    }
+
+    rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+    entry = sal_netdb_cache_alloc(name);
+    entry->host_type = host->h_addrtype;
+    entry->host_len = host->h_length;
+    rt_memcpy(entry->host_addr, host->h_addr_list[0], host->h_length);
+    sal_netdb_cache_set_state(entry, SAL_NETDB_CACHE_RESOLVED);
+    rt_mutex_release(&cache_lock);
+}
+
+/**
+ * This function will look up a host name in the cache and return a getaddrinfo() result
+ * taken from a static pool, the result must be released by sal_freeaddrinfo().
+ *
+ * @return 1: hit, -1: the name failed to resolve recently, 0: not cached or not
+ *         served by the cache (canonical name, service name, pool exhausted)
+ */
+int sal_netdb_cache_getaddrinfo(const char *nodename, const char *servname,
+                                const struct addrinfo *hints, struct addrinfo **res)
+{
+    struct sal_netdb_cache_entry *entry;
+    struct sal_netdb_cache_ai *cache_ai = RT_NULL;
+    int port, i, result = 0;
+
+    port = sal_netdb_cache_port(servname);
+    if (sal_netdb_cache_skip_name(nodename) || port < 0 || (hints && (hints->ai_flags & AI_CANONNAME)))
+    {
+        return 0;
+    }
+
+    rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+
+    entry = sal_netdb_cache_find(nodename);
+    if (entry && entry->state == SAL_NETDB_CACHE_FAILED)
+    {
+        result = -1;
+    }
+    else if (entry && entry->ai_addrlen > 0 &&
+             (hints == RT_NULL || hints->ai_family == AF_UNSPEC || hints->ai_family == entry->ai_family))
+    {
+        for (i = 0; i < SAL_NETDB_CACHE_AI_NUM; i++)
+        {
+            if (cache_ai_pool[i].used == RT_FALSE)
+            {
+                cache_ai = &cache_ai_pool[i];
+                break;
+            }
+        }
+    }
+
+    if (cache_ai)
+    {
+        rt_memset(&cache_ai->ai, 0x00, sizeof(struct addrinfo));
+        rt_memcpy(&cache_ai->addr, &entry->ai_addr, entry->ai_addrlen);
+        sal_netdb_cache_set_port((struct sockaddr *) &cache_ai->addr, port);
+
+        cache_ai->ai.ai_family = entry->ai_family;
+        cache_ai->ai.ai_addrlen = entry->ai_addrlen;
+        cache_ai->ai.ai_addr = (struct sockaddr *) &cache_ai->addr;
+        if (hints)
+        {
+            cache_ai->ai.ai_socktype = hints->ai_socktype;
+            cache_ai->ai.ai_protocol = hints->ai_protocol;
+        }
+        cache_ai->used = RT_TRUE;
+        *res = &cache_ai->ai;
+        result = 1;
+    }
+
+    if (result != 0)
+    {
+        entry->hits++;
+        entry->used = rt_tick_get();
+        (result > 0) ? cache_hits++ : cache_neg_hits++;
+    }
+    else
+    {
+        cache_misses++;
+    }
+
+    rt_mutex_release(&cache_lock);
+
+    return result;
+}
+
+/**
+ * This function will store the first address of a getaddrinfo() result, or remember the
+ * failure of a name lookup as sal_netdb_cache_put_host() does.
+ *
+ * @param result the getaddrinfo() return value
+ * @param res the getaddrinfo() result if it succeeded
+ */
+void sal_netdb_cache_put_addrinfo(struct netdev *netdev, const char *nodename, const char *servname,
+                                  const struct addrinfo *hints, int result, const struct addrinfo *res)
+{
+    struct sal_netdb_cache_entry *entry;
+
+    if (sal_netdb_cache_skip_name(nodename) || sal_netdb_cache_port(servname) < 0 ||
+        (hints && (hints->ai_flags & AI_CANONNAME)))
+    {
+        return;
+    }
+
+    if (result != 0)
+    {
+        /* only a failed name lookup is remembered, not a wrong family or service */
+        if (result != EAI_FAIL || netdev == RT_NULL || !netdev_is_link_up(netdev) ||
+            (hints && hints->ai_family != AF_UNSPEC))
+        {
+            return;
+        }
+
+        rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+        entry = sal_netdb_cache_alloc(nodename);
+        if (entry->state != SAL_NETDB_CACHE_RESOLVED)
+        {
+            sal_netdb_cache_set_state(entry, SAL_NETDB_CACHE_FAILED);
+        }
+        rt_mutex_release(&cache_lock);
+        return;
+    }
+
+    if (res == RT_NULL || res->ai_addr == RT_NULL ||
+        res->ai_addrlen == 0 || res->ai_addrlen > sizeof(struct sockaddr_storage))
+    {
+        return;
+    }
+
+    rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+    entry = sal_netdb_cache_alloc(nodename);
+    entry->ai_family = res->ai_family;
+    entry->ai_addrlen = res->ai_addrlen;
+    rt_memcpy(&entry->ai_addr, res->ai_addr, res->ai_addrlen);
+    sal_netdb_cache_set_port((struct sockaddr *) &entry->ai_addr, 0);
+    sal_netdb_cache_set_state(entry, SAL_NETDB_CACHE_RESOLVED);
+    rt_mutex_release(&cache_lock);
+}
+
+/**
+ * This function will release a getaddrinfo() result served from the cache.
+ *
+ * @return RT_TRUE if the result came from the cache, RT_FALSE if it belongs to a protocol family
+ */
+rt_bool_t sal_netdb_cache_freeaddrinfo(struct addrinfo *ai)
+{
+    struct sal_netdb_cache_ai *cache_ai = (struct sal_netdb_cache_ai *) ai;
+
+    if (cache_ai < &cache_ai_pool[0] || cache_ai >= &cache_ai_pool[SAL_NETDB_CACHE_AI_NUM])
+    {
+        return RT_FALSE;
+    }
+
+    rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+    cache_ai->used = RT_FALSE;
+    rt_mutex_release(&cache_lock);
+
+    return RT_TRUE;
+}
+
+/**
+ * This function will drop the cached result of a host name.
+ *
+ * @param name the host name, RT_NULL to drop all names
+ */
+void sal_netdb_cache_flush(const char *name)
+{
+    int i;
+
+    if (cache_init_ok == RT_FALSE)
+    {
+        return;
+    }
+
+    rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+    for (i = 0; i < SAL_NETDB_CACHE_NUM; i++)
+    {
+        if (name == RT_NULL || rt_strcasecmp(cache_table[i].name, name) == 0)
+        {
+            cache_table[i].state = SAL_NETDB_CACHE_EMPTY;
+        }
+    }
+    rt_mutex_release(&cache_lock);
+}
+
+int sal_netdb_cache_init(void)
+{
+    if (cache_init_ok)
+    {
+        return 0;
+    }
+
+    rt_memset(cache_table, 0x00, sizeof(cache_table));
+    rt_memset(cache_ai_pool, 0x00, sizeof(cache_ai_pool));
+    rt_mutex_init(&cache_lock, "sal_dns", RT_IPC_FLAG_PRIO);
+    cache_init_ok = RT_TRUE;
+
+    return 0;
+}
+
+#ifdef RT_USING_FINSH
+static void sal_netdb_cache_list(void)
+{
+    struct sal_netdb_cache_entry *entry;
+    const struct sockaddr_in *sin;
+    ip4_addr_t addr;
+    char addr_str[16];
+    rt_tick_t now;
+    int i;
+
+    rt_mutex_take(&cache_lock, RT_WAITING_FOREVER);
+
+    now = rt_tick_get();
+    rt_kprintf("name                             state    address          ttl(s)  hits\n");
+    rt_kprintf("-------------------------------- -------- ---------------- ------- ----------\n");
+    for (i = 0; i < SAL_NETDB_CACHE_NUM; i++)
+    {
+        entry = &cache_table[i];
+        if (entry->state == SAL_NETDB_CACHE_EMPTY || (rt_int32_t)(entry->expire - now) <= 0)
+        {
+            continue;
+        }
+
+        if (entry->state == SAL_NETDB_CACHE_FAILED)
+        {
+            rt_strncpy(addr_str, "-", sizeof(addr_str));
+        }
+        else if (entry->ai_addrlen > 0 && entry->ai_family != AF_INET6)
+        {
+            sin = (const struct sockaddr_in *) &entry->ai_addr;
+            rt_memcpy(&addr, &sin->sin_addr, sizeof(addr));
+            netdev_ip4addr_ntoa_r(&addr, addr_str, sizeof(addr_str));
+        }
+        else if (entry->host_len >= (int) sizeof(addr) && entry->host_type != AF_INET6)
+        {
+            rt_memcpy(&addr, entry->host_addr, sizeof(addr));
+            netdev_ip4addr_ntoa_r(&addr, addr_str, sizeof(addr_str));
+        }
+        else
+        {
+            rt_strncpy(addr_str, "(IPv6)", sizeof(addr_str));
+        }
+
+        rt_kprintf("%-32.32s %-8s %-16s %-7d %d\n", entry->name,
+                   entry->state == SAL_NETDB_CACHE_RESOLVED ? "resolved" : "failed",
+                   addr_str, (int)((entry->expire - now) / RT_TICK_PER_SECOND), entry->hits);
+    }
+    rt_kprintf("hits: %d, failed hits: %d, misses: %d\n", cache_hits, cache_neg_hits, cache_misses);
+
+    rt_mutex_release(&cache_lock);
+}
+
+int sal_netdb_cache(int argc, char **argv)
+{
+    if (cache_init_ok == RT_FALSE)
+    {
+        rt_kprintf("Socket Abstraction Layer is not initialized.\n");
+        return -1;
+    }
+
+    if (argc == 1)
+    {
+        sal_netdb_cache_list();
+    }
+    else if (argc <= 3 && rt_strcmp(argv[1], "flush") == 0)
+    {
+        sal_netdb_cache_flush(argc == 3 ? argv[2] : RT_NULL);
+    }
+    else
+    {
+        rt_kprintf("bad parameter! input: dns_cache [flush [host_name]]\n");
+        return -1;
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(sal_netdb_cache, dns_cache, list or flush the name resolving cache);
+#endif /* RT_USING_FINSH */
+
+#endif /* SAL_USING_NETDB_CACHE */
@@ -7,6 +7,9 @@
  * Date           Author       Notes
  * 2018-05-23     ChenYong     First version
  * 2018-11-12     ChenYong     Add TLS support
+ * 2026-10-16     RT-Thread    Add name resolving cache
+ * 2026-10-16     RT-Thread    Add epoll readiness interface
+ * 2026-10-16     RT-Thread    Add sal_sendmsg and network buffer pool
  */
 
 #include <rtthread.h>
@@ -19,6 +22,9 @@
 #include <sal_tls.h>
 #endif
 #include <sal.h>
+#ifdef SAL_USING_NETBUF
+#include <sal_netbuf.h>
+#endif
 #include <netdev.h>
 
 #ifdef SAL_INTERNET_CHECK
@@ -137,6 +143,16 @@ int sal_init(void)
     /* create sal socket lock */
     rt_mutex_init(&sal_core_lock, "sal_lock", RT_IPC_FLAG_PRIO);
 
+#ifdef SAL_USING_NETDB_CACHE
+    sal_netdb_cache_init();
+#endif
+#ifdef SAL_USING_EPOLL
+    sal_epoll_init();
+#endif
+#ifdef SAL_USING_NETBUF
+    sal_netbuf_init();
+#endif
+
     LOG_I("Socket Abstraction Layer initialize success.");
     init_ok = RT_TRUE;
 
@@ -933,6 +949,182 @@ int sal_sendto(int socket, const void *dataptr, size_t size, int flags,
 #endif
 }
 
+static int sal_sendmsg_part(int socket, const void *data, size_t size, int flags, int *sent)
+{
+    int ret;
+
+    ret = sal_sendto(socket, data, size, flags, RT_NULL, 0);
+    if (ret > 0)
+    {
+        *sent += ret;
+    }
+
+    return (ret == (int) size) ? 0 : -1;
+}
+
+/* send the buffers of a stream by sendto, the small ones are gathered into a network buffer block */
+static int sal_sendmsg_stream(int socket, const struct msghdr *message, int flags)
+{
+#ifdef SAL_USING_NETBUF
+    struct sal_netbuf *nb = sal_netbuf_alloc();
+    size_t pending = 0, size;
+#endif
+    const uint8_t *data;
+    size_t left;
+    int i, result = 0, sent = 0;
+
+    for (i = 0; i < message->msg_iovlen && result == 0; i++)
+    {
+        data = (const uint8_t *) message->msg_iov[i].iov_base;
+        left = message->msg_iov[i].iov_len;
+
+        while (left > 0 && result == 0)
+        {
+#ifdef SAL_USING_NETBUF
+            /* fill up the block, so every send but the last one carries a full block */
+            if (nb && (pending > 0 || left < SAL_NETBUF_BLOCK_SIZE))
+            {
+                size = SAL_NETBUF_BLOCK_SIZE - pending;
+                if (size > left)
+                {
+                    size = left;
+                }
+                rt_memcpy(nb->payload + pending, data, size);
+                pending += size;
+                data += size;
+                left -= size;
+
+                if (pending == SAL_NETBUF_BLOCK_SIZE)
+                {
+                    result = sal_sendmsg_part(socket, nb->payload, pending, flags, &sent);
+                    pending = 0;
+                }
+                continue;
+            }
+#endif
+            /* the rest of a large buffer is sent as it is */
+            result = sal_sendmsg_part(socket, data, left, flags, &sent);
+            left = 0;
+        }
+    }
+
+#ifdef SAL_USING_NETBUF
+    if (result == 0 && pending > 0)
+    {
+        result = sal_sendmsg_part(socket, nb->payload, pending, flags, &sent);
+    }
+
+    if (nb)
+    {
+        sal_netbuf_free(nb);
+    }
+#endif
+
+    /* a failed send ends the stream message, report the bytes sent before it */
+    return (result == 0 || sent > 0) ? sent : -1;
+}
+
+/**
+ * This function will send the buffers of a message as one datagram or one piece of stream.
+ * The protocols supporting sendmsg take the buffers as they are. For the others the buffers
+ * are sent by sendto: a stream gathers the small buffers into a network buffer block, a
+ * datagram is gathered into a block, or a heap buffer if it is too large.
+ *
+ * @param socket the socket descriptor
+ * @param message the buffers and the destination address
+ * @param flags the send flags
+ *
+ * @return the number of bytes sent, -1 on failure
+ */
+int sal_sendmsg(int socket, const struct msghdr *message, int flags)
+{
+    struct sal_socket *sock;
+    struct sal_proto_family *pf;
+#ifdef SAL_USING_NETBUF
+    struct sal_netbuf *nb = RT_NULL;
+#endif
+    uint8_t *data, *pos;
+    size_t size = 0;
+    int i, ret;
+
+    if (message == RT_NULL || message->msg_iovlen < 0 || message->msg_iovlen > IOV_MAX ||
+            (message->msg_iovlen > 0 && message->msg_iov == RT_NULL))
+    {
+        return -1;
+    }
+
+    /* get the socket object by socket descriptor */
+    SAL_SOCKET_OBJ_GET(sock, socket);
+
+    /* check the network interface is up status  */
+    SAL_NETDEV_IS_UP(sock->netdev);
+
+    pf = (struct sal_proto_family *) sock->netdev->sal_user_data;
+#ifdef SAL_USING_TLS
+    if (pf->skt_ops->sendmsg && !SAL_SOCKOPS_PROTO_TLS_VALID(sock, send))
+#else
+    if (pf->skt_ops->sendmsg)
+#endif
+    {
+        return pf->skt_ops->sendmsg((int) sock->user_data, message, flags);
+    }
+
+    /* a single buffer needs no gathering */
+    if (message->msg_iovlen <= 1)
+    {
+        return sal_sendto(socket, message->msg_iovlen ? message->msg_iov[0].iov_base : RT_NULL,
+                          message->msg_iovlen ? message->msg_iov[0].iov_len : 0, flags,
+                          (const struct sockaddr *) message->msg_name, message->msg_namelen);
+    }
+
+    if (sock->type == SOCK_STREAM)
+    {
+        return sal_sendmsg_stream(socket, message, flags);
+    }
+
+    for (i = 0; i < message->msg_iovlen; i++)
+    {
+        size += message->msg_iov[i].iov_len;
+    }
+
+#ifdef SAL_USING_NETBUF
+    if (size <= SAL_NETBUF_BLOCK_SIZE && (nb = sal_netbuf_alloc()) != RT_NULL)
+    {
+        data = nb->payload;
+    }
+    else
+#endif
+    {
+        data = rt_malloc(size);
+        if (data == RT_NULL)
+        {
+            LOG_E("No memory to gather %d bytes.", size);
+            return -1;
+        }
+    }
+
+    for (i = 0, pos = data; i < message->msg_iovlen; i++)
+    {
+        rt_memcpy(pos, message->msg_iov[i].iov_base, message->msg_iov[i].iov_len);
+        pos += message->msg_iov[i].iov_len;
+    }
+
+    ret = sal_sendto(socket, data, size, flags, (const struct sockaddr *) message->msg_name, message->msg_namelen);
+
+#ifdef SAL_USING_NETBUF
+    if (nb)
+    {
+        sal_netbuf_free(nb);
+    }
+    else
+#endif
+    {
+        rt_free(data);
+    }
+
+    return ret;
+}
+
 int sal_socket(int domain, int type, int protocol)
 {
     int retval;
@@ -1001,6 +1193,11 @@ int sal_closesocket(int socket)
     /* valid the network interface socket opreation */
     SAL_NETDEV_SOCKETOPS_VALID(sock->netdev, pf, closesocket);
 
+#ifdef SAL_USING_EPOLL
+    /* the protocol family frees the socket wait queue the epoll instances are hooked on */
+    sal_epoll_socket_close(socket);
+#endif
+
     if (pf->skt_ops->closesocket((int) sock->user_data) == 0)
     {
 #ifdef SAL_USING_TLS
@@ -1062,10 +1259,22 @@ struct hostent *sal_gethostbyname(const char *name)
 {
     struct netdev *netdev = netdev_default;
     struct sal_proto_family *pf;
+    struct hostent *host = RT_NULL;
+#ifdef SAL_USING_NETDB_CACHE
+    static struct hostent cache_host;
+    static char cache_host_buf[SAL_NETDB_CACHE_HOSTBUF_SIZE];
+    int cached;
+
+    cached = sal_netdb_cache_gethostbyname(name, &cache_host, cache_host_buf, sizeof(cache_host_buf));
+    if (cached != 0)
+    {
+        return (cached > 0) ? &cache_host : RT_NULL;
+    }
+#endif
 
     if (SAL_NETDEV_NETDBOPS_VALID(netdev, pf, gethostbyname))
     {
-        return pf->netdb_ops->gethostbyname(name);
+        host = pf->netdb_ops->gethostbyname(name);
     }
     else
     {
@@ -1073,11 +1282,19 @@ struct hostent *sal_gethostbyname(const char *name)
         netdev = netdev_get_first_by_flags(NETDEV_FLAG_UP);
         if (SAL_NETDEV_NETDBOPS_VALID(netdev, pf, gethostbyname))
         {
-            return pf->netdb_ops->gethostbyname(name);
+            host = pf->netdb_ops->gethostbyname(name);
+        }
+        else
+        {
+            return RT_NULL;
         }
     }
 
-    return RT_NULL;
+#ifdef SAL_USING_NETDB_CACHE
+    sal_netdb_cache_put_host(netdev, name, host);
+#endif
+
+    return host;
 }
 
 int sal_gethostbyname_r(const char *name, struct hostent *ret, char *buf,
@@ -1085,10 +1302,22 @@ int sal_gethostbyname_r(const char *name, struct hostent *ret, char *buf,
 {
     struct netdev *netdev = netdev_default;
     struct sal_proto_family *pf;
+    int res;
+#ifdef SAL_USING_NETDB_CACHE
+    int cached;
+
+    cached = sal_netdb_cache_gethostbyname(name, ret, buf, buflen);
+    if (cached != 0)
+    {
+        *result = (cached > 0) ? ret : RT_NULL;
+        *h_errnop = (cached > 0) ? 0 : HOST_NOT_FOUND;
+        return (cached > 0) ? 0 : -1;
+    }
+#endif
 
     if (SAL_NETDEV_NETDBOPS_VALID(netdev, pf, gethostbyname_r))
     {
-        return pf->netdb_ops->gethostbyname_r(name, ret, buf, buflen, result, h_errnop);
+        res = pf->netdb_ops->gethostbyname_r(name, ret, buf, buflen, result, h_errnop);
     }
     else
     {
@@ -1096,11 +1325,23 @@ int sal_gethostbyname_r(const char *name, struct hostent *ret, char *buf,
         netdev = netdev_get_first_by_flags(NETDEV_FLAG_UP);
         if (SAL_NETDEV_NETDBOPS_VALID(netdev, pf, gethostbyname_r))
         {
-            return pf->netdb_ops->gethostbyname_r(name, ret, buf, buflen, result, h_errnop);
+            res = pf->netdb_ops->gethostbyname_r(name, ret, buf, buflen, result, h_errnop);
+        }
+        else
+        {
+            return -1;
         }
     }
 
-    return -1;
+#ifdef SAL_USING_NETDB_CACHE
+    /* a short buffer fails as well, only successful lookups are stored from here */
+    if (res == 0 && *result)
+    {
+        sal_netdb_cache_put_host(netdev, name, *result);
+    }
+#endif
+
+    return res;
 }
 
 int sal_getaddrinfo(const char *nodename,
@@ -1113,6 +1354,15 @@ int sal_getaddrinfo(const char *nodename,
     int     ret = 0;
     rt_uint32_t i = 0;
 
+#ifdef SAL_USING_NETDB_CACHE
+    /* results served from the cache are not recorded, sal_freeaddrinfo() recognizes them */
+    ret = sal_netdb_cache_getaddrinfo(nodename, servname, hints, res);
+    if (ret != 0)
+    {
+        return (ret > 0) ? 0 : EAI_FAIL;
+    }
+#endif
+
     if (SAL_NETDEV_NETDBOPS_VALID(netdev, pf, getaddrinfo))
     {
         ret = pf->netdb_ops->getaddrinfo(nodename, servname, hints, res);
@@ -1127,10 +1377,14 @@ int sal_getaddrinfo(const char *nodename,
         }
         else
         {
-            ret = -1;
+            return -1;
         }
     }
 
+#ifdef SAL_USING_NETDB_CACHE
+    sal_netdb_cache_put_addrinfo(netdev, nodename, servname, hints, ret, (ret == 0) ? *res : RT_NULL);
+#endif
+
     if(ret == RT_EOK)
     {
         /*record the netdev and res*/
@@ -1157,6 +1411,13 @@ void sal_freeaddrinfo(struct addrinfo *ai)
     struct sal_proto_family *pf = RT_NULL;
     rt_uint32_t  i = 0;
 
+#ifdef SAL_USING_NETDB_CACHE
+    if (sal_netdb_cache_freeaddrinfo(ai))
+    {
+        return;
+    }
+#endif
+
     /*when use the multi netdev, it must free the ai use the getaddrinfo netdev */
     for(i = 0; i < SAL_SOCKETS_NUM; i++)
     {
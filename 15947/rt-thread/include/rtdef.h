@@ -41,6 +41,8 @@
  * 2022-01-01     Gabriel      improve hooking method
  * 2022-01-07     Gabriel      move some __on_rt_xxxxx_hook to dedicated c source files
  * 2022-01-12     Meco Man     remove RT_THREAD_BLOCK
+ * 2026-10-16     RT-Thread    add the hashed name index of kernel objects
+ * 2026-10-16     RT-Thread    add the TLSF memory object
  */
 
 #ifndef __RT_DEF_H__
@@ -388,6 +390,9 @@ struct rt_object
     void      *module_id;                               /**< id of application module */
 #endif
     rt_list_t  list;                                    /**< list node of kernel object */
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_t hash_node;                               /**< node in the name hash bucket */
+#endif
 };
 typedef struct rt_object *rt_object_t;                  /**< Type for kernel objects. */
 
@@ -435,6 +440,9 @@ struct rt_object_information
     enum rt_object_class_type type;                     /**< object class type */
     rt_list_t                 object_list;              /**< object list */
     rt_size_t                 object_size;              /**< object size */
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_t                hash_table[RT_OBJECT_HASH_SIZE]; /**< name hash buckets */
+#endif
 };
 
 /**
@@ -853,6 +861,25 @@ typedef rt_mem_t rt_smem_t;
 typedef rt_mem_t rt_slab_t;
 #endif
 
+#ifdef RT_USING_TLSF
+typedef rt_mem_t rt_tlsf_t;
+
+/**
+ * statistics of a TLSF memory object
+ */
+struct rt_tlsf_stats
+{
+    rt_size_t               total;                      /**< memory size */
+    rt_size_t               used;                       /**< size used */
+    rt_size_t               max_used;                   /**< maximum usage */
+    rt_size_t               largest_free;               /**< largest block of the highest free size class */
+    rt_size_t               free_blocks;                /**< number of free blocks */
+    rt_uint16_t             pools;                      /**< number of memory regions */
+    rt_uint32_t             alloc_count;                /**< successful allocations */
+    rt_uint32_t             fail_count;                 /**< failed allocations */
+};
+#endif
+
 #ifdef RT_USING_MEMHEAP
 /**
  * memory item on the heap
@@ -278,6 +278,19 @@ void *rt_page_alloc(rt_size_t npages);
 void rt_page_free(void *addr, rt_size_t npages);
 #endif
 
+#if defined(RT_USING_TLSF) && defined(RT_USING_TLSF_AS_HEAP)
+rt_err_t rt_system_heap_add(void *begin_addr, void *end_addr);
+#endif
+
+#ifdef RT_USING_MEMPROF
+void rt_memprof_alloc(void *ptr, rt_size_t size, void *caller);
+void rt_memprof_realloc(void *rmem, void *nptr, rt_size_t newsize, void *caller);
+void rt_memprof_free(void *ptr);
+void rt_memprof_set_sample(rt_uint32_t period);
+void rt_memprof_reset(void);
+void rt_memprof_dump(void);
+#endif
+
 #ifdef RT_USING_HOOK
 void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
@@ -329,6 +342,19 @@ void *rt_slab_realloc(rt_slab_t m, void *ptr, rt_size_t size);
 void rt_slab_free(rt_slab_t m, void *ptr);
 #endif
 
+#ifdef RT_USING_TLSF
+/**
+ * TLSF memory object interface
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size);
+rt_err_t rt_tlsf_add_pool(rt_tlsf_t m, void *begin_addr, rt_size_t size);
+rt_err_t rt_tlsf_detach(rt_tlsf_t m);
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size);
+void *rt_tlsf_realloc(rt_tlsf_t m, void *rmem, rt_size_t newsize);
+void rt_tlsf_free(rt_tlsf_t m, void *rmem);
+void rt_tlsf_info(rt_tlsf_t m, struct rt_tlsf_stats *stats);
+#endif
+
 /**@}*/
 
 /**
@@ -0,0 +1,690 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Replays allocation traces on the kernel heap allocators, small memory, memheap, slab and
+ * TLSF, and compares failures, fragmentation and the time of each call, see README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <rtthread.h>
+
+#define BENCH_MAX_IDS           65536
+#define BENCH_CHECKPOINTS       32
+#define BENCH_ROUNDS            5
+
+enum bench_op_type
+{
+    BENCH_OP_MALLOC = 'm',
+    BENCH_OP_FREE = 'f',
+    BENCH_OP_REALLOC = 'r',
+};
+
+struct bench_op
+{
+    rt_uint8_t type;
+    rt_uint32_t id;
+    rt_uint32_t size;
+};
+
+struct bench_trace
+{
+    const char *name;
+    struct bench_op *ops;
+    unsigned long count;
+    unsigned long capacity;
+};
+
+struct bench_allocator
+{
+    const char *name;
+    void (*init)(void *begin_addr, rt_size_t size);
+    void (*detach)(void);
+    void *(*alloc)(rt_size_t size);
+    void *(*realloc)(void *ptr, rt_size_t size);
+    void (*free)(void *ptr);
+    rt_size_t (*used)(void);
+};
+
+struct bench_result
+{
+    unsigned long fails;
+    unsigned long allocs;
+    unsigned long frees;
+    unsigned long corrupt;
+    rt_size_t peak_live;
+    rt_size_t peak_used;
+    rt_size_t largest_end;
+    double frag_max;
+    double frag_end;
+    double alloc_mean;
+    double alloc_p999;
+    double alloc_max;
+    double free_mean;
+    double free_max;
+};
+
+static void *bench_slot_ptr[BENCH_MAX_IDS];
+static rt_uint32_t bench_slot_size[BENCH_MAX_IDS];
+static double bench_timer_overhead;
+
+/* the allocators, each on its own heap object over the same memory */
+
+static rt_smem_t bench_smem;
+static struct rt_memheap bench_memheap;
+static rt_slab_t bench_slab;
+static rt_tlsf_t bench_tlsf;
+
+static void smem_init(void *begin_addr, rt_size_t size) { bench_smem = rt_smem_init("small", begin_addr, size); }
+static void smem_detach(void) { rt_smem_detach(bench_smem); }
+static void *smem_alloc(rt_size_t size) { return rt_smem_alloc(bench_smem, size); }
+static void *smem_realloc(void *ptr, rt_size_t size) { return rt_smem_realloc(bench_smem, ptr, size); }
+static void smem_free(void *ptr) { rt_smem_free(ptr); }
+static rt_size_t smem_used(void) { return bench_smem->used; }
+
+static void memheap_init(void *begin_addr, rt_size_t size) { rt_memheap_init(&bench_memheap, "memheap", begin_addr, size); }
+static void memheap_detach(void) { rt_memheap_detach(&bench_memheap); }
+static void *memheap_alloc(rt_size_t size) { return rt_memheap_alloc(&bench_memheap, size); }
+static void *memheap_realloc(void *ptr, rt_size_t size) { return rt_memheap_realloc(&bench_memheap, ptr, size); }
+static void memheap_free(void *ptr) { rt_memheap_free(ptr); }
+static rt_size_t memheap_used(void) { return bench_memheap.pool_size - bench_memheap.available_size; }
+
+static void slab_init(void *begin_addr, rt_size_t size) { bench_slab = rt_slab_init("slab", begin_addr, size); }
+static void slab_detach(void) { rt_slab_detach(bench_slab); }
+static void *slab_alloc(rt_size_t size) { return rt_slab_alloc(bench_slab, size); }
+static void *slab_realloc(void *ptr, rt_size_t size) { return rt_slab_realloc(bench_slab, ptr, size); }
+static void slab_free(void *ptr) { rt_slab_free(bench_slab, ptr); }
+static rt_size_t slab_used(void) { return bench_slab->used; }
+
+static void tlsf_init(void *begin_addr, rt_size_t size) { bench_tlsf = rt_tlsf_init("tlsf", begin_addr, size); }
+static void tlsf_detach(void) { rt_tlsf_detach(bench_tlsf); }
+static void *tlsf_alloc(rt_size_t size) { return rt_tlsf_alloc(bench_tlsf, size); }
+static void *tlsf_realloc(void *ptr, rt_size_t size) { return rt_tlsf_realloc(bench_tlsf, ptr, size); }
+static void tlsf_free(void *ptr) { rt_tlsf_free(bench_tlsf, ptr); }
+static rt_size_t tlsf_used(void) { return bench_tlsf->used; }
+
+static const struct bench_allocator bench_allocators[] =
+{
+    { "small", smem_init, smem_detach, smem_alloc, smem_realloc, smem_free, smem_used },
+    { "memheap", memheap_init, memheap_detach, memheap_alloc, memheap_realloc, memheap_free, memheap_used },
+    { "slab", slab_init, slab_detach, slab_alloc, slab_realloc, slab_free, slab_used },
+    { "tlsf", tlsf_init, tlsf_detach, tlsf_alloc, tlsf_realloc, tlsf_free, tlsf_used },
+};
+#define BENCH_ALLOCATOR_NUM     (sizeof(bench_allocators) / sizeof(bench_allocators[0]))
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_timer_calibrate(void)
+{
+    double t0, t1, best = 1e9;
+    int i;
+
+    for (i = 0; i < 10000; i++)
+    {
+        t0 = bench_now_ns();
+        t1 = bench_now_ns();
+        if (t1 - t0 < best)
+        {
+            best = t1 - t0;
+        }
+    }
+    bench_timer_overhead = best;
+}
+
+/* traces */
+
+static void trace_add(struct bench_trace *trace, int type, rt_uint32_t id, rt_uint32_t size)
+{
+    if (trace->count == trace->capacity)
+    {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 4096;
+        trace->ops = realloc(trace->ops, trace->capacity * sizeof(struct bench_op));
+    }
+    trace->ops[trace->count].type = (rt_uint8_t) type;
+    trace->ops[trace->count].id = id;
+    trace->ops[trace->count].size = size;
+    trace->count++;
+}
+
+/* the identifiers not in use, so a generator never runs out of them */
+static rt_uint32_t trace_ids[BENCH_MAX_IDS];
+static int trace_id_top;
+
+static void trace_ids_reset(void)
+{
+    int i;
+
+    for (i = 0; i < BENCH_MAX_IDS; i++)
+    {
+        trace_ids[i] = BENCH_MAX_IDS - 1 - i;
+    }
+    trace_id_top = BENCH_MAX_IDS;
+}
+
+static rt_uint32_t trace_id_get(void)
+{
+    return trace_ids[--trace_id_top];
+}
+
+static void trace_id_put(rt_uint32_t id)
+{
+    trace_ids[trace_id_top++] = id;
+}
+
+static rt_uint32_t trace_range(unsigned int *seed, rt_uint32_t min, rt_uint32_t max)
+{
+    return min + rand_r(seed) % (max - min + 1);
+}
+
+/*
+ * The application: each cycle builds a cJSON document of small objects, prints it into a
+ * buffer grown by realloc, frees the document and queues the printed payload until the
+ * PUBACK of the fourth next cycle. Log strings live for a few cycles. Now and then a thread
+ * is created with its stack and deleted later, and a long lived object is left behind.
+ */
+static void trace_gen_pv(struct bench_trace *trace, unsigned long count, unsigned int seed)
+{
+    rt_uint32_t doc[48], queue[4] = { 0 }, logs[8] = { 0 }, thread[2] = { 0 }, thread_stack[2] = { 0 };
+    rt_uint32_t longlived = 0, size, printed;
+    int items, i, cycle;
+
+    trace->name = "pv";
+    trace_ids_reset();
+
+    for (cycle = 0; trace->count < count; cycle++)
+    {
+        /* the cJSON document */
+        items = trace_range(&seed, 8, 48);
+        for (i = 0; i < items; i++)
+        {
+            doc[i] = trace_id_get();
+            trace_add(trace, BENCH_OP_MALLOC, doc[i], trace_range(&seed, 16, 64));
+        }
+
+        /* cJSON_PrintUnformatted() grows its buffer */
+        printed = trace_id_get();
+        size = 64;
+        trace_add(trace, BENCH_OP_MALLOC, printed, size);
+        while (size < 200 + (rt_uint32_t) items * 6)
+        {
+            size *= 2;
+            trace_add(trace, BENCH_OP_REALLOC, printed, size);
+        }
+        trace_add(trace, BENCH_OP_REALLOC, printed, 200 + items * 6);
+
+        for (i = items - 1; i >= 0; i--)
+        {
+            trace_add(trace, BENCH_OP_FREE, doc[i], 0);
+            trace_id_put(doc[i]);
+        }
+
+        /* the publish queue holds the payload until the PUBACK */
+        if (queue[cycle % 4])
+        {
+            trace_add(trace, BENCH_OP_FREE, queue[cycle % 4], 0);
+            trace_id_put(queue[cycle % 4]);
+        }
+        queue[cycle % 4] = printed;
+
+        /* log strings */
+        i = rand_r(&seed) % 8;
+        if (logs[i])
+        {
+            trace_add(trace, BENCH_OP_FREE, logs[i], 0);
+            trace_id_put(logs[i]);
+        }
+        logs[i] = trace_id_get();
+        trace_add(trace, BENCH_OP_MALLOC, logs[i], trace_range(&seed, 24, 160));
+
+        /* a worker thread: the thread object and its stack */
+        if (cycle % 97 == 0)
+        {
+            i = (cycle / 97) % 2;
+            if (thread[i])
+            {
+                trace_add(trace, BENCH_OP_FREE, thread_stack[i], 0);
+                trace_add(trace, BENCH_OP_FREE, thread[i], 0);
+                trace_id_put(thread_stack[i]);
+                trace_id_put(thread[i]);
+            }
+            thread[i] = trace_id_get();
+            thread_stack[i] = trace_id_get();
+            trace_add(trace, BENCH_OP_MALLOC, thread[i], 128);
+            trace_add(trace, BENCH_OP_MALLOC, thread_stack[i], trace_range(&seed, 1, 4) * 1024);
+        }
+
+        /* a long lived object, e.g. a cached topic or a timer */
+        if (cycle % 251 == 0 && longlived < 48)
+        {
+            trace_add(trace, BENCH_OP_MALLOC, trace_id_get(), trace_range(&seed, 32, 256));
+            longlived++;
+        }
+    }
+}
+
+/*
+ * Random sizes between 8 and 2048 bytes, spread evenly over the powers of two, with
+ * random lifetimes. The live set stays around target bytes, which fragments the heap.
+ */
+static void trace_gen_random(struct bench_trace *trace, unsigned long count, unsigned int seed, rt_size_t target)
+{
+    static rt_uint32_t live[BENCH_MAX_IDS];
+    static rt_uint32_t live_size[BENCH_MAX_IDS];
+    rt_size_t live_bytes = 0;
+    int live_num = 0, i;
+    rt_uint32_t id, size;
+
+    trace->name = "random";
+    trace_ids_reset();
+
+    while (trace->count < count)
+    {
+        if (live_num > 0 && (live_bytes > target || rand_r(&seed) % 4 == 0))
+        {
+            i = rand_r(&seed) % live_num;
+            if (rand_r(&seed) % 16 == 0)
+            {
+                /* resize */
+                size = 8 << (rand_r(&seed) % 8);
+                size += rand_r(&seed) % size;
+                trace_add(trace, BENCH_OP_REALLOC, live[i], size);
+                live_bytes = live_bytes - live_size[i] + size;
+                live_size[i] = size;
+                continue;
+            }
+            trace_add(trace, BENCH_OP_FREE, live[i], 0);
+            trace_id_put(live[i]);
+            live_bytes -= live_size[i];
+            live_num--;
+            live[i] = live[live_num];
+            live_size[i] = live_size[live_num];
+        }
+        else if (live_num < BENCH_MAX_IDS)
+        {
+            size = 8 << (rand_r(&seed) % 8);
+            size += rand_r(&seed) % size;
+            id = trace_id_get();
+            trace_add(trace, BENCH_OP_MALLOC, id, size);
+            live[live_num] = id;
+            live_size[live_num] = size;
+            live_num++;
+            live_bytes += size;
+        }
+    }
+}
+
+/* a trace file: one call per line, "m <id> <size>", "r <id> <size>" or "f <id>" */
+static int trace_load(struct bench_trace *trace, const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[128], type;
+    unsigned long id, size;
+    int n;
+
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    trace->name = path;
+    while (fgets(line, sizeof(line), fp))
+    {
+        size = 0;
+        n = sscanf(line, " %c %lu %lu", &type, &id, &size);
+        if (n < 2 || line[0] == '#')
+        {
+            continue;
+        }
+        if (id >= BENCH_MAX_IDS || (type != BENCH_OP_MALLOC && type != BENCH_OP_FREE && type != BENCH_OP_REALLOC))
+        {
+            printf("%s: bad line: %s", path, line);
+            continue;
+        }
+        trace_add(trace, type, (rt_uint32_t) id, (rt_uint32_t) size);
+    }
+    fclose(fp);
+
+    return trace->count ? 0 : -1;
+}
+
+/* replay */
+
+/* the largest block the allocator can give now */
+static rt_size_t bench_largest(const struct bench_allocator *allocator, rt_size_t heap_size)
+{
+    rt_size_t low = 0, high = heap_size, mid;
+    void *ptr;
+
+    while (low < high)
+    {
+        mid = (low + high + 1) / 2;
+        ptr = allocator->alloc(mid);
+        if (ptr)
+        {
+            allocator->free(ptr);
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    return low;
+}
+
+/* each block is filled with a byte of its identifier, which must be intact when it is freed */
+static int bench_check(rt_uint32_t id)
+{
+    const rt_uint8_t *ptr = bench_slot_ptr[id];
+    rt_uint32_t size = bench_slot_size[id];
+
+    return ptr[0] == (rt_uint8_t) id && ptr[size - 1] == (rt_uint8_t) id && ptr[size / 2] == (rt_uint8_t) id;
+}
+
+static void bench_replay(const struct bench_allocator *allocator, const struct bench_trace *trace,
+                         void *heap_mem, rt_size_t heap_size, float *latency, struct bench_result *res)
+{
+    rt_size_t live = 0, used, largest;
+    unsigned long i, step = trace->count / BENCH_CHECKPOINTS;
+    double t0, t1, frag;
+    void *ptr;
+
+    memset(bench_slot_ptr, 0, sizeof(bench_slot_ptr));
+    allocator->init(heap_mem, heap_size);
+
+    for (i = 0; i < trace->count; i++)
+    {
+        const struct bench_op *op = &trace->ops[i];
+
+        switch (op->type)
+        {
+        case BENCH_OP_MALLOC:
+            t0 = bench_now_ns();
+            ptr = allocator->alloc(op->size);
+            t1 = bench_now_ns();
+            if (ptr == RT_NULL)
+            {
+                res->fails++;
+                latency[i] = -1;
+                break;
+            }
+            latency[i] = t1 - t0;
+            memset(ptr, (rt_uint8_t) op->id, op->size);
+            bench_slot_ptr[op->id] = ptr;
+            bench_slot_size[op->id] = op->size;
+            live += op->size;
+            break;
+
+        case BENCH_OP_REALLOC:
+            if (bench_slot_ptr[op->id] && !bench_check(op->id))
+            {
+                res->corrupt++;
+            }
+            t0 = bench_now_ns();
+            ptr = allocator->realloc(bench_slot_ptr[op->id], op->size);
+            t1 = bench_now_ns();
+            if (ptr == RT_NULL)
+            {
+                /* the old block is kept */
+                res->fails++;
+                latency[i] = -1;
+                break;
+            }
+            latency[i] = t1 - t0;
+            if (bench_slot_ptr[op->id])
+            {
+                if (((rt_uint8_t *) ptr)[0] != (rt_uint8_t) op->id)
+                {
+                    res->corrupt++;
+                }
+                live -= bench_slot_size[op->id];
+            }
+            memset(ptr, (rt_uint8_t) op->id, op->size);
+            bench_slot_ptr[op->id] = ptr;
+            bench_slot_size[op->id] = op->size;
+            live += op->size;
+            break;
+
+        case BENCH_OP_FREE:
+            if (bench_slot_ptr[op->id] == RT_NULL)
+            {
+                latency[i] = -1;
+                break;
+            }
+            if (!bench_check(op->id))
+            {
+                res->corrupt++;
+            }
+            t0 = bench_now_ns();
+            allocator->free(bench_slot_ptr[op->id]);
+            t1 = bench_now_ns();
+            latency[i] = t1 - t0;
+            bench_slot_ptr[op->id] = RT_NULL;
+            live -= bench_slot_size[op->id];
+            break;
+        }
+
+        if (live > res->peak_live)
+        {
+            res->peak_live = live;
+        }
+        /* the heaps count their peak too, but the probes below would raise it */
+        used = allocator->used();
+        if (used > res->peak_used)
+        {
+            res->peak_used = used;
+        }
+
+        /* fragmentation: the largest block against the memory not requested */
+        if (step && i % step == step - 1)
+        {
+            largest = bench_largest(allocator, heap_size);
+            frag = 1.0 - (double) largest / (heap_size - live);
+            if (frag > res->frag_max)
+            {
+                res->frag_max = frag;
+            }
+            res->frag_end = frag;
+            res->largest_end = largest;
+        }
+    }
+
+    for (i = 0; i < BENCH_MAX_IDS; i++)
+    {
+        if (bench_slot_ptr[i])
+        {
+            allocator->free(bench_slot_ptr[i]);
+        }
+    }
+    allocator->detach();
+}
+
+static int bench_cmp_float(const void *a, const void *b)
+{
+    float x = *(const float *) a, y = *(const float *) b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * The trace is replayed BENCH_ROUNDS times, which makes the same calls with the same
+ * blocks. The time of a call is the shortest of the rounds, the host noise is left out.
+ */
+static void bench_run(const struct bench_allocator *allocator, const struct bench_trace *trace,
+                      void *heap_mem, rt_size_t heap_size, struct bench_result *res)
+{
+    float *latency = malloc(trace->count * sizeof(float));
+    float *best = malloc(trace->count * sizeof(float));
+    float *sorted = malloc(trace->count * sizeof(float));
+    unsigned long i, n;
+    double sum;
+    int round, free_num = 0;
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        memset(res, 0, sizeof(*res));
+        bench_replay(allocator, trace, heap_mem, heap_size, latency, res);
+        for (i = 0; i < trace->count; i++)
+        {
+            if (round == 0 || latency[i] < best[i])
+            {
+                best[i] = latency[i];
+            }
+        }
+    }
+
+    /* the calls that gave or took a block */
+    n = 0;
+    sum = 0;
+    for (i = 0; i < trace->count; i++)
+    {
+        float ns = best[i] - bench_timer_overhead;
+
+        if (best[i] < 0)
+        {
+            continue;
+        }
+        if (ns < 0)
+        {
+            ns = 0;
+        }
+        if (trace->ops[i].type == BENCH_OP_FREE)
+        {
+            res->free_mean += ns;
+            if (ns > res->free_max)
+            {
+                res->free_max = ns;
+            }
+            res->frees++;
+            free_num++;
+            continue;
+        }
+        sorted[n++] = ns;
+        sum += ns;
+    }
+    res->allocs = n;
+    if (n)
+    {
+        qsort(sorted, n, sizeof(float), bench_cmp_float);
+        res->alloc_mean = sum / n;
+        res->alloc_p999 = sorted[(n * 999) / 1000];
+        res->alloc_max = sorted[n - 1];
+    }
+    if (free_num)
+    {
+        res->free_mean /= free_num;
+    }
+
+    free(latency);
+    free(best);
+    free(sorted);
+}
+
+static void bench_trace_run(const struct bench_trace *trace, rt_size_t heap_size)
+{
+    struct bench_result res;
+    void *heap_mem;
+    int i;
+
+    printf("\ntrace %s: %lu calls, heap %lu bytes\n", trace->name, trace->count, (unsigned long) heap_size);
+    printf("allocator  failures  peak live  peak used  largest  frag%%max  frag%%end  "
+           "alloc ns: mean  p99.9    max  free ns: mean    max\n");
+
+    for (i = 0; i < (int) BENCH_ALLOCATOR_NUM; i++)
+    {
+        heap_mem = malloc(heap_size);
+        bench_run(&bench_allocators[i], trace, heap_mem, heap_size, &res);
+        printf("%-10s %8lu %10lu %10lu %8lu %9.1f %9.1f %15.1f %6.1f %6.0f %14.1f %6.0f%s\n",
+               bench_allocators[i].name, res.fails, (unsigned long) res.peak_live,
+               (unsigned long) res.peak_used, (unsigned long) res.largest_end,
+               res.frag_max * 100, res.frag_end * 100, res.alloc_mean, res.alloc_p999, res.alloc_max,
+               res.free_mean, res.free_max, res.corrupt ? "  CORRUPTED" : "");
+        free(heap_mem);
+    }
+}
+
+static void bench_usage(const char *name)
+{
+    printf("usage: %s [-t pv|random|<trace file>] [-n calls] [-H heap_bytes] [-s seed]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    const char *trace_name = RT_NULL;
+    unsigned long count = 200000;
+    rt_size_t heap_size = 512 * 1024;
+    unsigned int seed = 1;
+    struct bench_trace trace;
+    int c;
+
+    while ((c = getopt(argc, argv, "t:n:H:s:h")) != -1)
+    {
+        switch (c)
+        {
+        case 't': trace_name = optarg; break;
+        case 'n': count = strtoul(optarg, NULL, 0); break;
+        case 'H': heap_size = strtoul(optarg, NULL, 0); break;
+        case 's': seed = strtoul(optarg, NULL, 0); break;
+        default:
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (count == 0 || heap_size < 4096)
+    {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    bench_timer_calibrate();
+    printf("timer overhead %.0f ns, subtracted; the time of a call is the shortest of %d rounds\n",
+           bench_timer_overhead, BENCH_ROUNDS);
+
+    if (trace_name == RT_NULL || strcmp(trace_name, "pv") == 0)
+    {
+        memset(&trace, 0, sizeof(trace));
+        trace_gen_pv(&trace, count, seed);
+        bench_trace_run(&trace, heap_size);
+        free(trace.ops);
+    }
+    if (trace_name == RT_NULL || strcmp(trace_name, "random") == 0)
+    {
+        memset(&trace, 0, sizeof(trace));
+        trace_gen_random(&trace, count, seed, heap_size / 2);
+        bench_trace_run(&trace, heap_size);
+        free(trace.ops);
+    }
+    if (trace_name && strcmp(trace_name, "pv") != 0 && strcmp(trace_name, "random") != 0)
+    {
+        memset(&trace, 0, sizeof(trace));
+        if (trace_load(&trace, trace_name) != 0)
+        {
+            return 1;
+        }
+        bench_trace_run(&trace, heap_size);
+        free(trace.ops);
+    }
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The kernel services used by object.c, the heap allocators and timer.c. The benchmarks
+ * run in one thread, so the interrupt lock, the scheduler lock and the heap semaphore have
+ * nothing to do. The tick only moves with rt_tick_set(), and the timer thread never runs:
+ * the timer benchmark calls rt_soft_timer_check() itself. There is no idle thread either,
+ * the tickless simulation calls rt_tickless_idle() itself.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#include <rtthread.h>
+#include <rthw.h>
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    (void) level;
+}
+
+void rt_enter_critical(void)
+{
+}
+
+void rt_exit_critical(void)
+{
+}
+
+void *rt_malloc(rt_size_t size)
+{
+    return malloc(size);
+}
+
+void rt_free(void *ptr)
+{
+    free(ptr);
+}
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    (void) flag;
+
+    rt_object_init(&(sem->parent.parent), RT_Object_Class_Semaphore, name);
+    sem->value = (rt_uint16_t) value;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    rt_object_detach(&(sem->parent.parent));
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    (void) sem;
+    (void) time;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    (void) sem;
+
+    return RT_EOK;
+}
+
+void rt_set_errno(rt_err_t error)
+{
+    (void) error;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    return RT_NULL;
+}
+
+rt_err_t rt_thread_init(struct rt_thread *thread, const char *name, void (*entry)(void *parameter),
+                        void *parameter, void *stack_start, rt_uint32_t stack_size,
+                        rt_uint8_t priority, rt_uint32_t tick)
+{
+    (void) name;
+    (void) entry;
+    (void) parameter;
+    (void) stack_start;
+    (void) stack_size;
+    (void) priority;
+    (void) tick;
+
+    thread->stat = RT_THREAD_INIT;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    (void) thread;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_suspend(rt_thread_t thread)
+{
+    (void) thread;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_resume(rt_thread_t thread)
+{
+    (void) thread;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick)
+{
+    (void) tick;
+
+    return RT_EOK;
+}
+
+void rt_schedule(void)
+{
+}
+
+rt_err_t rt_thread_idle_sethook(void (*hook)(void))
+{
+    (void) hook;
+
+    return RT_EOK;
+}
+
+static rt_tick_t _host_tick;
+
+rt_tick_t rt_tick_get(void)
+{
+    return _host_tick;
+}
+
+void rt_tick_set(rt_tick_t tick)
+{
+    _host_tick = tick;
+}
+
+int __rt_ffs(int value)
+{
+    return __builtin_ffs(value);
+}
+
+int rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, fmt);
+    length = vprintf(fmt, args);
+    va_end(args);
+
+    return length;
+}
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    printf("(%s) assertion failed at function:%s, line number:%lu\n", ex, func, (unsigned long) line);
+    abort();
+}
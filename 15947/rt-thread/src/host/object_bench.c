@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Lookup cost of rt_object_find() with a few hundred objects of one type, with the
+ * object list or with the hashed name index, see README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <rtthread.h>
+
+/* the devices of the board, registered at boot before the others */
+static const char *bench_board_names[] =
+{
+    "pin", "adc1", "uart1", "uart4", "spi1", "spi10", "air720",
+};
+#define BENCH_BOARD_NUM         (sizeof(bench_board_names) / sizeof(bench_board_names[0]))
+
+#define BENCH_MAX_OBJECTS       1000
+
+struct bench_options
+{
+    int count;
+    unsigned long rounds;
+    unsigned int seed;
+};
+
+struct bench_entry
+{
+    char name[RT_NAME_MAX];
+    rt_object_t object;
+    rt_bool_t is_static;
+};
+
+static struct rt_device bench_static[BENCH_MAX_OBJECTS];
+static struct bench_entry bench_entries[BENCH_MAX_OBJECTS];
+static int bench_num;
+volatile rt_ubase_t bench_sink_sum;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* the objects alternate between static ones, rt_object_init(), and rt_object_allocate() */
+static void bench_add(int index, const char *name, rt_bool_t is_static)
+{
+    struct bench_entry *entry = &bench_entries[index];
+
+    snprintf(entry->name, sizeof(entry->name), "%s", name);
+    entry->is_static = is_static;
+    if (is_static)
+    {
+        rt_object_init(&bench_static[index].parent, RT_Object_Class_Device, name);
+        entry->object = &bench_static[index].parent;
+    }
+    else
+    {
+        entry->object = rt_object_allocate(RT_Object_Class_Device, name);
+    }
+}
+
+static void bench_remove(int index)
+{
+    struct bench_entry *entry = &bench_entries[index];
+
+    if (entry->is_static)
+    {
+        rt_object_detach(entry->object);
+    }
+    else
+    {
+        rt_object_delete(entry->object);
+    }
+    entry->object = RT_NULL;
+}
+
+static void bench_populate(const struct bench_options *opt)
+{
+    char name[RT_NAME_MAX];
+    int i;
+
+    for (i = 0; i < opt->count; i++)
+    {
+        if (i < (int) BENCH_BOARD_NUM)
+        {
+            bench_add(i, bench_board_names[i], RT_TRUE);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "dev%d", i);
+            bench_add(i, name, i & 1);
+        }
+    }
+    bench_num = opt->count;
+}
+
+/*
+ * Remove and add again a quarter of the objects under new names, then check that every
+ * object is found and every removed name is not.
+ */
+static int bench_churn_check(const struct bench_options *opt)
+{
+    unsigned int seed = opt->seed;
+    char old_name[RT_NAME_MAX], name[RT_NAME_MAX];
+    int i, index, errors = 0;
+
+    for (i = 0; i < bench_num / 4; i++)
+    {
+        index = BENCH_BOARD_NUM + rand_r(&seed) % (bench_num - BENCH_BOARD_NUM);
+        memcpy(old_name, bench_entries[index].name, RT_NAME_MAX);
+        bench_remove(index);
+        if (rt_object_find(old_name, RT_Object_Class_Device) != RT_NULL)
+        {
+            errors++;
+        }
+        snprintf(name, sizeof(name), "new%d", i % 1000);
+        bench_add(index, name, bench_entries[index].is_static);
+    }
+
+    for (i = 0; i < bench_num; i++)
+    {
+        if (rt_object_find(bench_entries[i].name, RT_Object_Class_Device) != bench_entries[i].object)
+        {
+            errors++;
+        }
+    }
+    if (rt_object_find("nodev", RT_Object_Class_Device) != RT_NULL)
+    {
+        errors++;
+    }
+
+    return errors;
+}
+
+/* names compared by a lookup: the position in the object list or in the hash bucket */
+static void bench_compares(double *mean, int *worst, int *buckets)
+{
+    struct rt_object_information *information = rt_object_get_information(RT_Object_Class_Device);
+    unsigned long total = 0;
+    int len;
+
+    *worst = 0;
+    *buckets = 0;
+#ifdef RT_USING_OBJECT_HASH
+    {
+        rt_slist_t *node;
+        int i;
+
+        for (i = 0; i < RT_OBJECT_HASH_SIZE; i++)
+        {
+            len = 0;
+            rt_slist_for_each(node, &(information->hash_table[i]))
+            {
+                len++;
+                total += len;
+            }
+            if (len > *worst)
+            {
+                *worst = len;
+            }
+            if (len > 0)
+            {
+                (*buckets)++;
+            }
+        }
+    }
+#else
+    {
+        rt_list_t *node;
+
+        len = 0;
+        rt_list_for_each(node, &(information->object_list))
+        {
+            len++;
+            total += len;
+        }
+        *worst = len;
+        *buckets = 1;
+    }
+#endif /* RT_USING_OBJECT_HASH */
+    *mean = bench_num ? (double) total / bench_num : 0;
+}
+
+/* ns per lookup of the same name, rt_device_find("adc1") of the sampler */
+static double bench_lookup_one(const char *name, unsigned long rounds)
+{
+    unsigned long i;
+    double start;
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        bench_sink_sum += (rt_ubase_t) rt_object_find(name, RT_Object_Class_Device);
+    }
+
+    return (bench_now() - start) * 1e9 / rounds;
+}
+
+/* ns per lookup of every object in turn */
+static double bench_lookup_all(unsigned long rounds)
+{
+    unsigned long i;
+    double start;
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        bench_sink_sum += (rt_ubase_t) rt_object_find(bench_entries[i % bench_num].name, RT_Object_Class_Device);
+    }
+
+    return (bench_now() - start) * 1e9 / rounds;
+}
+
+static void bench_usage(const char *name)
+{
+    printf("usage: %s [-n objects] [-r lookups] [-s seed]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    struct bench_options opt;
+    double mean, adc, all, missing;
+    int c, worst, buckets, errors;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.count = 300;
+    opt.rounds = 2000000;
+    opt.seed = 1;
+
+    while ((c = getopt(argc, argv, "n:r:s:h")) != -1)
+    {
+        switch (c)
+        {
+        case 'n': opt.count = atoi(optarg); break;
+        case 'r': opt.rounds = strtoul(optarg, NULL, 0); break;
+        case 's': opt.seed = strtoul(optarg, NULL, 0); break;
+        default:
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (opt.count < (int) BENCH_BOARD_NUM + 4 || opt.count > BENCH_MAX_OBJECTS || opt.rounds == 0)
+    {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    bench_populate(&opt);
+    errors = bench_churn_check(&opt);
+
+#ifdef RT_USING_OBJECT_HASH
+    printf("%d devices, hashed name index of %d buckets\n", bench_num, RT_OBJECT_HASH_SIZE);
+#else
+    printf("%d devices, object list\n", bench_num);
+#endif /* RT_USING_OBJECT_HASH */
+
+    bench_compares(&mean, &worst, &buckets);
+    adc = bench_lookup_one("adc1", opt.rounds);
+    all = bench_lookup_all(opt.rounds);
+    missing = bench_lookup_one("nodev", opt.rounds);
+
+    printf("names compared: mean %.2f, worst %d, buckets in use %d\n", mean, worst, buckets);
+    printf("ns per lookup: \"adc1\" %.1f, every device %.1f, missing name %.1f\n", adc, all, missing);
+    printf("check after removing and adding %d objects: %s\n", bench_num / 4, errors ? "FAILED" : "ok");
+
+    return errors ? 1 : 0;
+}
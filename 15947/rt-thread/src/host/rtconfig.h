@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Configuration of the host build in place of the BSP rtconfig.h, with the object types
+ * of the board, every heap allocator and the soft timers. RT_USING_OBJECT_HASH is set by
+ * the Makefile for object_bench_hash, the bucket number can be overridden from the make
+ * command line, e.g. make H="-DRT_OBJECT_HASH_SIZE=32". In the same way, the Makefile sets
+ * RT_USING_TIMER_WHEEL for timer_bench_wheel, and T overrides its size. The idle hook is
+ * for the tickless idle of tickless_sim.
+ */
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_USING_TIMER_SOFT
+#define RT_USING_IDLE_HOOK
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_EVENT
+#define RT_USING_MAILBOX
+#define RT_USING_MESSAGEQUEUE
+#define RT_USING_MEMPOOL
+#define RT_USING_SMALL_MEM
+#define RT_USING_SLAB
+#define RT_USING_MEMHEAP
+#define RT_MEMHEAP_FAST_MODE
+#define RT_USING_TLSF
+#define RT_USING_HEAP
+#define RT_USING_DEVICE
+#define RT_USING_CONSOLE
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMSET
+#define RT_KSERVICE_USING_STDLIB_MEMCPY
+
+#ifdef RT_USING_TIMER_WHEEL
+#ifndef RT_TIMER_WHEEL_SLOT_BITS
+#define RT_TIMER_WHEEL_SLOT_BITS 6
+#endif
+#ifndef RT_TIMER_WHEEL_LEVEL
+#define RT_TIMER_WHEEL_LEVEL 4
+#endif
+#endif
+
+#ifdef RT_USING_OBJECT_HASH
+#ifndef RT_OBJECT_HASH_SIZE
+#define RT_OBJECT_HASH_SIZE 16
+#endif
+#endif
+
+#endif /* RT_CONFIG_H__ */
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * The tickless idle of components/drivers/pm/tickless.c on a simulated clock: a core clock
+ * of 480 MHz with its SysTick, and a low power counter. Threads sleep 1 to 60 s, other
+ * interrupts come at random. Each timeout and each tick is checked against the simulated
+ * time, see README.md.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <drivers/tickless.h>
+
+#define SIM_CORE_HZ             480000000ULL
+#define SIM_TICK_CYCLES         (SIM_CORE_HZ / RT_TICK_PER_SECOND)
+#define SIM_NEVER               (~0ULL)
+/* the code from a read of the counter to SysTick, and the wake up from WFI, at most */
+#define SIM_CODE_CYCLES         200
+#define SIM_WAKE_CYCLES         50
+#define SIM_MAX_FREQS           8
+#define SIM_MAX_THREADS         64
+/* the timers started by the threads the other interrupts wake up */
+#define SIM_MAX_SHORT           32
+
+struct sim_options
+{
+    rt_uint32_t freqs[SIM_MAX_FREQS];
+    int freq_num;
+    int bits;
+    unsigned long seconds;
+    int threads;
+    unsigned long irq_ms;
+    rt_tick_t start_tick;
+    unsigned int seed;
+};
+
+struct sim_timer
+{
+    struct rt_timer timer;
+    rt_uint64_t due;                /* the tick the timer is due, counted from the start */
+    rt_bool_t thread;               /* a thread sleeping 1 to 60 s, started again each time */
+    rt_bool_t running;
+};
+
+struct sim_result
+{
+    unsigned long expired;
+    unsigned long early;
+    double late_total;
+    rt_uint64_t late_max;
+    rt_uint64_t early_max;
+    rt_int64_t error_min;
+    rt_int64_t error_max;
+    /* the error at the ticks of the first and of the last tenth of the run */
+    double first_total;
+    unsigned long first_num;
+    double last_total;
+    unsigned long last_num;
+    unsigned long tick_irqs;
+    unsigned long sleeps;
+    rt_uint64_t busy;
+};
+
+/* the simulated time and hardware, in core cycles */
+static rt_uint64_t sim_now;
+static rt_uint64_t sim_tick_last;   /* the start of the current tick */
+static rt_uint64_t sim_tick_due;    /* the tick interrupt, SIM_NEVER when stopped */
+static rt_uint64_t sim_alarm_due;
+static rt_uint64_t sim_irq_due;
+static rt_uint64_t sim_busy_until;
+static rt_uint32_t sim_freq;
+static rt_uint32_t sim_mask;
+
+/* rt_tick counted from the start without the wrap */
+static rt_uint64_t sim_ticks;
+static rt_tick_t sim_tick_seen;
+
+static rt_uint64_t sim_end;
+static const struct sim_options *sim_opt;
+static struct sim_result *sim_res;
+static struct sim_timer sim_timers[SIM_MAX_THREADS + SIM_MAX_SHORT];
+
+static rt_uint64_t sim_rand(rt_uint64_t max)
+{
+    return ((rt_uint64_t)rand() << 31 | (rt_uint64_t)rand()) % max;
+}
+
+static rt_uint64_t sim_ticks_now(void)
+{
+    sim_ticks += (rt_tick_t)(rt_tick_get() - sim_tick_seen);
+    sim_tick_seen = rt_tick_get();
+    return sim_ticks;
+}
+
+/* the time since the start of the tick rt_tick is in, negative if rt_tick is ahead */
+static rt_int64_t sim_check_tick(void)
+{
+    rt_int64_t error = (rt_int64_t)(sim_now - sim_ticks_now() * SIM_TICK_CYCLES);
+
+    if (error < sim_res->error_min)
+        sim_res->error_min = error;
+    if (error > sim_res->error_max)
+        sim_res->error_max = error;
+
+    return error;
+}
+
+static rt_uint32_t sim_counter(void)
+{
+    /* a read across the clock domains */
+    sim_now += SIM_CORE_HZ / 10000000;
+
+    return (rt_uint32_t)((unsigned __int128)sim_now * sim_freq / SIM_CORE_HZ) & sim_mask;
+}
+
+static rt_err_t sim_alarm(rt_uint32_t value)
+{
+    rt_uint64_t count = (rt_uint64_t)((unsigned __int128)sim_now * sim_freq / SIM_CORE_HZ);
+    rt_uint32_t now = (rt_uint32_t)count & sim_mask;
+
+    /* the same test as drv_tickless.c */
+    if (((now - value) & sim_mask) < (sim_mask >> 3))
+        return -RT_ETIMEOUT;
+
+    count += (value - now) & sim_mask;
+    sim_alarm_due = (rt_uint64_t)(((unsigned __int128)count * SIM_CORE_HZ + sim_freq - 1) / sim_freq);
+
+    return RT_EOK;
+}
+
+static rt_uint32_t sim_tick_stop(void)
+{
+    rt_uint64_t cycles;
+
+    /* the code since the read of the counter */
+    sim_now += sim_rand(SIM_CODE_CYCLES);
+
+    /* a pending tick is in the time since the last tick */
+    cycles = sim_now - sim_tick_last;
+    sim_tick_due = SIM_NEVER;
+
+    return (rt_uint32_t)((cycles * sim_freq + SIM_TICK_CYCLES / 2) / SIM_TICK_CYCLES);
+}
+
+static void sim_tick_start(rt_uint32_t phase)
+{
+    rt_uint64_t cycles = ((rt_uint64_t)phase * SIM_TICK_CYCLES + sim_freq / 2) / sim_freq;
+
+    if (cycles >= SIM_TICK_CYCLES)
+        cycles = SIM_TICK_CYCLES - 1;
+    /* the code since the read of the counter */
+    sim_now += sim_rand(SIM_CODE_CYCLES);
+    sim_tick_last = sim_now - cycles;
+    sim_tick_due = sim_tick_last + SIM_TICK_CYCLES;
+}
+
+static void sim_sleep(void)
+{
+    rt_uint64_t wake = sim_irq_due;
+
+    if (sim_tick_due < wake)
+        wake = sim_tick_due;
+    if (sim_alarm_due < wake)
+        wake = sim_alarm_due;
+    if (wake > sim_now)
+    {
+        /* the wake up of the core */
+        sim_now = wake + sim_rand(SIM_WAKE_CYCLES);
+    }
+    if (sim_alarm_due <= sim_now)
+        sim_alarm_due = SIM_NEVER;
+    sim_res->sleeps++;
+}
+
+static const struct rt_tickless_ops sim_ops =
+{
+    sim_counter,
+    sim_alarm,
+    sim_tick_stop,
+    sim_tick_start,
+    sim_sleep,
+};
+
+static void sim_start(struct sim_timer *st, rt_tick_t timeout)
+{
+    rt_timer_control(&st->timer, RT_TIMER_CTRL_SET_TIME, &timeout);
+    st->due = sim_ticks_now() + timeout;
+    st->running = RT_TRUE;
+    rt_timer_start(&st->timer);
+}
+
+static void sim_busy(rt_uint64_t cycles)
+{
+    if (sim_busy_until < sim_now)
+        sim_busy_until = sim_now;
+    sim_busy_until += cycles;
+    sim_res->busy += cycles;
+}
+
+static void sim_timeout(void *parameter)
+{
+    struct sim_timer *st = parameter;
+    rt_uint64_t due = st->due * SIM_TICK_CYCLES;
+
+    sim_res->expired++;
+    if (sim_now < due)
+    {
+        sim_res->early++;
+        if (due - sim_now > sim_res->early_max)
+            sim_res->early_max = due - sim_now;
+    }
+    else
+    {
+        sim_res->late_total += sim_now - due;
+        if (sim_now - due > sim_res->late_max)
+            sim_res->late_max = sim_now - due;
+    }
+
+    st->running = RT_FALSE;
+    if (st->thread)
+    {
+        /* the thread samples and publishes for 0.1 to 3 ms, and sleeps again */
+        sim_busy(SIM_CORE_HZ / 10000 + sim_rand(SIM_CORE_HZ * 3 / 1000));
+        sim_start(st, RT_TICK_PER_SECOND + sim_rand(59 * RT_TICK_PER_SECOND));
+    }
+}
+
+static void sim_tick_isr(void)
+{
+    rt_int64_t error;
+
+    sim_res->tick_irqs++;
+    rt_tick_set(rt_tick_get() + 1);
+    sim_tick_last = sim_tick_due;
+    sim_tick_due += SIM_TICK_CYCLES;
+
+    /* on a tick, the error is how late the periodic tick is */
+    error = sim_check_tick();
+    if (sim_now < sim_end / 10)
+    {
+        sim_res->first_total += error;
+        sim_res->first_num++;
+    }
+    else if (sim_now >= sim_end - sim_end / 10)
+    {
+        sim_res->last_total += error;
+        sim_res->last_num++;
+    }
+    rt_timer_check();
+}
+
+static void sim_irq_isr(void)
+{
+    int i;
+
+    sim_irq_due = sim_now + 1 + sim_rand(2 * sim_opt->irq_ms * SIM_CORE_HZ / 1000);
+
+    /* one in two wakes a thread up, which waits 10 to 100 ms for an answer */
+    if (rand() % 2)
+        return;
+    sim_busy(SIM_CORE_HZ / 50000 + sim_rand(SIM_CORE_HZ / 2000));
+    for (i = SIM_MAX_THREADS; i < SIM_MAX_THREADS + SIM_MAX_SHORT; i++)
+    {
+        if (!sim_timers[i].running)
+        {
+            sim_start(&sim_timers[i], RT_TICK_PER_SECOND / 100 + sim_rand(RT_TICK_PER_SECOND / 10));
+            break;
+        }
+    }
+}
+
+static void sim_run(const struct sim_options *opt, rt_uint32_t freq, struct sim_result *res)
+{
+    rt_uint64_t next;
+    char name[16];
+    int i;
+
+    memset(res, 0, sizeof(*res));
+    res->error_min = INT64_MAX;
+    res->error_max = INT64_MIN;
+    sim_end = (rt_uint64_t)opt->seconds * SIM_CORE_HZ;
+    sim_opt = opt;
+    sim_res = res;
+    srand(opt->seed);
+
+    sim_now = 0;
+    sim_tick_last = 0;
+    sim_tick_due = SIM_TICK_CYCLES;
+    sim_alarm_due = SIM_NEVER;
+    sim_busy_until = 0;
+    sim_freq = freq;
+    sim_mask = opt->bits >= 32 ? 0xFFFFFFFF : (1U << opt->bits) - 1;
+    rt_tick_set(opt->start_tick);
+    sim_ticks = 0;
+    sim_tick_seen = opt->start_tick;
+    sim_irq_due = sim_rand(2 * opt->irq_ms * SIM_CORE_HZ / 1000);
+
+    rt_system_timer_init();
+    rt_tickless_init(&sim_ops, freq, sim_mask);
+
+    for (i = 0; i < SIM_MAX_THREADS + SIM_MAX_SHORT; i++)
+    {
+        if (i >= opt->threads && i < SIM_MAX_THREADS)
+            continue;
+        snprintf(name, sizeof(name), "t%d", i);
+        rt_timer_init(&sim_timers[i].timer, name, sim_timeout, &sim_timers[i], 1,
+                      RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+        sim_timers[i].thread = i < SIM_MAX_THREADS;
+        sim_timers[i].running = RT_FALSE;
+        if (sim_timers[i].thread)
+            sim_start(&sim_timers[i], 1 + sim_rand(60 * RT_TICK_PER_SECOND));
+    }
+
+    while (sim_now < sim_end)
+    {
+        if (sim_busy_until > sim_now)
+        {
+            /* a thread runs, the interrupts come on time */
+            next = sim_busy_until;
+            if (sim_tick_due < next)
+                next = sim_tick_due;
+            if (sim_irq_due < next)
+                next = sim_irq_due;
+            sim_now = next;
+        }
+        else
+        {
+            /* the idle thread */
+            rt_tickless_idle();
+            sim_check_tick();
+        }
+
+        if (sim_now >= sim_tick_due)
+            sim_tick_isr();
+        if (sim_now >= sim_irq_due)
+            sim_irq_isr();
+    }
+
+    for (i = 0; i < SIM_MAX_THREADS + SIM_MAX_SHORT; i++)
+    {
+        if (i >= opt->threads && i < SIM_MAX_THREADS)
+            continue;
+        rt_timer_detach(&sim_timers[i].timer);
+    }
+}
+
+static void sim_usage(const char *name)
+{
+    printf("usage: %s [-f hz,hz,...] [-b bits] [-t seconds] [-n threads] [-i ms] [-T tick] [-s seed]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    struct sim_options opt;
+    struct sim_result res;
+    struct rt_tickless_stat stat;
+    char *list, *token;
+    double us = 1e6 / SIM_CORE_HZ, drift;
+    int c, i;
+
+    memset(&opt, 0, sizeof(opt));
+    list = RT_NULL;
+    opt.bits = 16;
+    opt.seconds = 86400;
+    opt.threads = 8;
+    opt.irq_ms = 500;
+    /* the tick wraps after an hour */
+    opt.start_tick = (rt_tick_t)(0 - 3600 * RT_TICK_PER_SECOND);
+    opt.seed = 1;
+
+    while ((c = getopt(argc, argv, "f:b:t:n:i:T:s:h")) != -1)
+    {
+        switch (c)
+        {
+        case 'f': list = optarg; break;
+        case 'b': opt.bits = atoi(optarg); break;
+        case 't': opt.seconds = strtoul(optarg, NULL, 0); break;
+        case 'n': opt.threads = atoi(optarg); break;
+        case 'i': opt.irq_ms = strtoul(optarg, NULL, 0); break;
+        case 'T': opt.start_tick = (rt_tick_t)strtoul(optarg, NULL, 0); break;
+        case 's': opt.seed = strtoul(optarg, NULL, 0); break;
+        default:
+            sim_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    for (token = strtok(list ? list : strdup("32768,1000"), ",");
+         token && opt.freq_num < SIM_MAX_FREQS;
+         token = strtok(RT_NULL, ","))
+    {
+        opt.freqs[opt.freq_num] = strtoul(token, NULL, 0);
+        if (opt.freqs[opt.freq_num] < RT_TICK_PER_SECOND)
+        {
+            sim_usage(argv[0]);
+            return 1;
+        }
+        opt.freq_num++;
+    }
+    if (opt.freq_num == 0 || opt.bits < 8 || opt.bits > 32 || opt.seconds == 0 ||
+        opt.threads < 1 || opt.threads > SIM_MAX_THREADS || opt.irq_ms == 0)
+    {
+        sim_usage(argv[0]);
+        return 1;
+    }
+
+    printf("%lu s from tick %lu, %d threads, an interrupt each %lu ms, counter of %d bits\n",
+           opt.seconds, (unsigned long)opt.start_tick, opt.threads, opt.irq_ms, opt.bits);
+    printf("counter Hz  timeouts  late us: mean     max  early  early us: max  tick error us: min     max"
+           "  drift ppm  tick irq/s  sleeps/s  slept%%  busy%%\n");
+
+    for (i = 0; i < opt.freq_num; i++)
+    {
+        sim_run(&opt, opt.freqs[i], &res);
+        rt_tickless_get_stat(&stat);
+        /* the means of the first and the last tenth are 9/10 of the run apart */
+        drift = res.first_num && res.last_num ?
+                (res.last_total / res.last_num - res.first_total / res.first_num) /
+                (0.9 * opt.seconds * SIM_CORE_HZ) * 1e6 : 0;
+        printf("%10lu  %8lu  %13.1f  %6.1f  %5lu  %13.1f  %17.1f  %6.1f  %9.3f  %10.2f  %8.2f  %6.2f  %5.2f\n",
+               (unsigned long)opt.freqs[i], res.expired,
+               res.expired > res.early ? res.late_total / (res.expired - res.early) * us : 0,
+               res.late_max * us, res.early, res.early_max * us,
+               res.error_min * us, res.error_max * us, drift,
+               (double)res.tick_irqs / opt.seconds, (double)res.sleeps / opt.seconds,
+               100.0 * stat.ticks / ((rt_uint64_t)opt.seconds * RT_TICK_PER_SECOND),
+               100.0 * res.busy / ((rt_uint64_t)opt.seconds * SIM_CORE_HZ));
+    }
+
+    return 0;
+}
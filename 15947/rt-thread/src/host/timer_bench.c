@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Stress test of the kernel timers with 1000 to 10000 timers: the cost of starting a
+ * timer and of the timer checks of each tick, with the skip list or the timing wheel
+ * RT_USING_TIMER_WHEEL, across a wrap of the tick. Every timeout is checked against the
+ * tick it was due, see README.md.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <rtthread.h>
+
+#define BENCH_MAX_TIMERS        20000
+#define BENCH_MAX_COUNTS        16
+/* the longest sleep of the tickless phase */
+#define BENCH_SLEEP_MAX         1000
+
+/* the check of the timer thread, in timer.c */
+void rt_soft_timer_check(void);
+
+struct bench_options
+{
+    int counts[BENCH_MAX_COUNTS];
+    int count_num;
+    unsigned long ticks;
+    unsigned long wakeups;
+    rt_tick_t start_tick;
+    unsigned int seed;
+};
+
+struct bench_timer
+{
+    struct rt_timer timer;
+    rt_tick_t due;                  /* the tick the timer is due, if it runs */
+    rt_bool_t running;
+};
+
+struct bench_result
+{
+    double start_ns;
+    double restart_ns;
+    double tick_mean;
+    double tick_p999;
+    double tick_max;
+    double expiry_ns;
+    double expired_per_tick;
+    double next_ns;
+    double sleep_mean;
+    unsigned long spurious;
+    unsigned long early;
+    unsigned long late;
+    unsigned long missed;
+    unsigned long next_early;
+    unsigned long next_late;
+};
+
+static struct bench_timer bench_timers[BENCH_MAX_TIMERS];
+static rt_bool_t bench_tickless;
+static unsigned long bench_expired;
+static unsigned long bench_early;
+static unsigned long bench_late;
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+/*
+ * 1 to 16384 ticks, spread evenly over the powers of two, and one in 64 up to 10 minutes.
+ * In the tickless phase, 1 to 5 seconds.
+ */
+static rt_tick_t bench_timeout(void)
+{
+    if (bench_tickless)
+    {
+        return RT_TICK_PER_SECOND + rand() % (4 * RT_TICK_PER_SECOND);
+    }
+    if (rand() % 64 == 0)
+    {
+        return 1 + rand() % (600 * RT_TICK_PER_SECOND);
+    }
+    return 1 + rand() % (1 << (rand() % 15));
+}
+
+static void bench_start(struct bench_timer *bt, rt_tick_t timeout)
+{
+    rt_timer_control(&bt->timer, RT_TIMER_CTRL_SET_TIME, &timeout);
+    bt->due = rt_tick_get() + timeout;
+    bt->running = RT_TRUE;
+    rt_timer_start(&bt->timer);
+}
+
+static void bench_timeout_func(void *parameter)
+{
+    struct bench_timer *bt = parameter;
+    rt_tick_t now = rt_tick_get();
+
+    bench_expired++;
+    if (!bt->running || (now - bt->due) >= RT_TICK_MAX / 2)
+    {
+        bench_early++;
+    }
+    else if (now != bt->due && !bench_tickless)
+    {
+        /* the tick moves by one with a check each time, a timeout is never late */
+        bench_late++;
+    }
+
+    if (bt->timer.parent.flag & RT_TIMER_FLAG_PERIODIC)
+    {
+        /* started again by the kernel after this function */
+        bt->due = now + bt->timer.init_tick;
+    }
+    else if (rand() % 2)
+    {
+        /* started again from its timeout function */
+        bench_start(bt, bench_timeout());
+    }
+    else
+    {
+        bt->running = RT_FALSE;
+    }
+}
+
+static void bench_tick(rt_tick_t ticks)
+{
+    rt_tick_set(rt_tick_get() + ticks);
+    rt_timer_check();
+    rt_soft_timer_check();
+}
+
+/* the earliest due tick of the running hard timers, or RT_TICK_MAX */
+static rt_tick_t bench_hard_earliest(int count)
+{
+    rt_tick_t now = rt_tick_get(), earliest = RT_TICK_MAX;
+    rt_bool_t found = RT_FALSE;
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        struct bench_timer *bt = &bench_timers[i];
+
+        if (!bt->running || (bt->timer.parent.flag & RT_TIMER_FLAG_SOFT_TIMER))
+            continue;
+        if (!found || bt->due - now < earliest - now)
+        {
+            earliest = bt->due;
+            found = RT_TRUE;
+        }
+    }
+    return earliest;
+}
+
+static void bench_run(const struct bench_options *opt, int count, struct bench_result *res)
+{
+    double t0, t1, *samples, restart_total = 0, check_total = 0, next_total = 0, sleep_total = 0;
+    unsigned long restarts = 0, expired = 0, tick, wakeup;
+    rt_uint8_t flag;
+    char name[16];
+    int i;
+
+    memset(res, 0, sizeof(*res));
+    samples = malloc(opt->ticks * sizeof(double));
+    srand(opt->seed);
+    bench_tickless = RT_FALSE;
+    bench_expired = bench_early = bench_late = 0;
+
+    rt_tick_set(opt->start_tick);
+    rt_system_timer_init();
+    rt_system_timer_thread_init();
+
+    /* one timer in 8 is periodic, one in 4 is a soft timer */
+    for (i = 0; i < count; i++)
+    {
+        flag = (i % 8 == 0) ? RT_TIMER_FLAG_PERIODIC : RT_TIMER_FLAG_ONE_SHOT;
+        if (i % 4 == 3)
+            flag |= RT_TIMER_FLAG_SOFT_TIMER;
+        snprintf(name, sizeof(name), "t%d", i);
+        rt_timer_init(&bench_timers[i].timer, name, bench_timeout_func, &bench_timers[i], 1, flag);
+        bench_timers[i].running = RT_FALSE;
+    }
+
+    t0 = bench_now_ns();
+    for (i = 0; i < count; i++)
+    {
+        bench_start(&bench_timers[i], bench_timeout());
+    }
+    t1 = bench_now_ns();
+    res->start_ns = (t1 - t0) / count;
+
+    /* each tick, one timer in 100 is started again before its timeout, then the check */
+    for (tick = 0; tick < opt->ticks; tick++)
+    {
+        int restart_num = count / 100 + 1;
+        struct bench_timer *restart[BENCH_MAX_TIMERS / 100 + 1];
+        rt_tick_t timeout[BENCH_MAX_TIMERS / 100 + 1];
+
+        for (i = 0; i < restart_num; i++)
+        {
+            restart[i] = &bench_timers[rand() % count];
+            timeout[i] = bench_timeout();
+        }
+        t0 = bench_now_ns();
+        for (i = 0; i < restart_num; i++)
+        {
+            bench_start(restart[i], timeout[i]);
+        }
+        t1 = bench_now_ns();
+        restart_total += t1 - t0;
+        restarts += restart_num;
+
+        expired = bench_expired;
+        t0 = bench_now_ns();
+        bench_tick(1);
+        t1 = bench_now_ns();
+        samples[tick] = t1 - t0;
+        check_total += t1 - t0;
+        res->expired_per_tick += bench_expired - expired;
+    }
+
+    /* no running timer may be past its due tick */
+    for (i = 0; i < count; i++)
+    {
+        if (bench_timers[i].running && (rt_tick_get() - bench_timers[i].due) < RT_TICK_MAX / 2)
+            res->missed++;
+    }
+
+    res->restart_ns = restart_total / restarts;
+    res->tick_mean = check_total / opt->ticks;
+    res->expiry_ns = check_total / (res->expired_per_tick ? res->expired_per_tick : 1);
+    res->expired_per_tick /= opt->ticks;
+    qsort(samples, opt->ticks, sizeof(double), bench_cmp_double);
+    res->tick_p999 = samples[(unsigned long)(opt->ticks * 0.999)];
+    res->tick_max = samples[opt->ticks - 1];
+    res->early = bench_early;
+    res->late = bench_late;
+
+    /*
+     * tickless: one timer in 100 is left, with timeouts of seconds, and the tick moves to
+     * the next timeout the kernel gives
+     */
+    bench_tickless = RT_TRUE;
+    for (i = 0; i < count; i++)
+    {
+        if (i % 100 == 0)
+        {
+            bench_start(&bench_timers[i], bench_timeout());
+        }
+        else
+        {
+            rt_timer_stop(&bench_timers[i].timer);
+            bench_timers[i].running = RT_FALSE;
+        }
+    }
+    for (wakeup = 0; wakeup < opt->wakeups; wakeup++)
+    {
+        rt_tick_t now = rt_tick_get(), next, earliest, sleep;
+
+        t0 = bench_now_ns();
+        next = rt_timer_next_timeout_tick();
+        t1 = bench_now_ns();
+        next_total += t1 - t0;
+
+        /*
+         * the next timeout is the one of the earliest hard timer, a timeout beyond the
+         * timing wheel counts from the tick it is placed again
+         */
+        earliest = bench_hard_earliest(count);
+        if (next - now < earliest - now)
+            res->next_early++;
+        else if (next != earliest)
+            res->next_late++;
+
+        sleep = next - now;
+        if (sleep == 0 || sleep >= RT_TICK_MAX / 2)
+            sleep = 1;
+        if (sleep > BENCH_SLEEP_MAX)
+            sleep = BENCH_SLEEP_MAX;
+        sleep_total += sleep;
+
+        expired = bench_expired;
+        bench_tick(sleep);
+        if (bench_expired == expired)
+            res->spurious++;
+    }
+    res->next_ns = next_total / opt->wakeups;
+    res->sleep_mean = sleep_total / opt->wakeups;
+    res->early = bench_early;
+
+    for (i = 0; i < count; i++)
+    {
+        rt_timer_detach(&bench_timers[i].timer);
+    }
+    free(samples);
+}
+
+static void bench_usage(const char *name)
+{
+    printf("usage: %s [-n timers[,timers...]] [-t ticks] [-w wakeups] [-T start_tick] [-s seed]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    struct bench_options opt;
+    struct bench_result res;
+    char *list, *token;
+    int c, i;
+
+    memset(&opt, 0, sizeof(opt));
+    list = RT_NULL;
+    opt.ticks = 20000;
+    opt.wakeups = 20000;
+    /* the tick wraps during the run */
+    opt.start_tick = (rt_tick_t)(0 - 10000);
+    opt.seed = 1;
+
+    while ((c = getopt(argc, argv, "n:t:w:T:s:h")) != -1)
+    {
+        switch (c)
+        {
+        case 'n': list = optarg; break;
+        case 't': opt.ticks = strtoul(optarg, NULL, 0); break;
+        case 'w': opt.wakeups = strtoul(optarg, NULL, 0); break;
+        case 'T': opt.start_tick = (rt_tick_t)strtoul(optarg, NULL, 0); break;
+        case 's': opt.seed = strtoul(optarg, NULL, 0); break;
+        default:
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    for (token = strtok(list ? list : strdup("1000,2000,5000,10000"), ",");
+         token && opt.count_num < BENCH_MAX_COUNTS;
+         token = strtok(RT_NULL, ","))
+    {
+        opt.counts[opt.count_num] = atoi(token);
+        if (opt.counts[opt.count_num] <= 0 || opt.counts[opt.count_num] > BENCH_MAX_TIMERS)
+        {
+            bench_usage(argv[0]);
+            return 1;
+        }
+        opt.count_num++;
+    }
+    if (opt.count_num == 0 || opt.ticks == 0 || opt.wakeups == 0)
+    {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+#ifdef RT_USING_TIMER_WHEEL
+    printf("timing wheel of %d levels of %d slots", RT_TIMER_WHEEL_LEVEL, 1 << RT_TIMER_WHEEL_SLOT_BITS);
+#else
+    printf("skip list of %d levels", RT_TIMER_SKIP_LIST_LEVEL);
+#endif
+    printf(", %lu ticks from tick %lu, %lu tickless wakeups\n",
+           opt.ticks, (unsigned long)opt.start_tick, opt.wakeups);
+    printf("timers  start ns  restart ns  tick ns: mean  p99.9     max  expired/tick  ns/expiry"
+           "  next ns  sleep  spurious  early  late  missed  next early  next late\n");
+
+    for (i = 0; i < opt.count_num; i++)
+    {
+        bench_run(&opt, opt.counts[i], &res);
+        printf("%6d %9.1f %11.1f %14.1f %6.0f %7.0f %13.2f %10.1f %8.1f %6.1f %9lu %6lu %5lu %7lu %11lu %10lu\n",
+               opt.counts[i], res.start_ns, res.restart_ns, res.tick_mean, res.tick_p999, res.tick_max,
+               res.expired_per_tick, res.expiry_ns, res.next_ns, res.sleep_mean, res.spurious,
+               res.early, res.late, res.missed, res.next_early, res.next_late);
+    }
+
+    return 0;
+}
@@ -20,6 +20,8 @@
  * 2021-02-28     Meco Man     add RT_KSERVICE_USING_STDLIB
  * 2021-12-20     Meco Man     implement rt_strcpy()
  * 2022-01-07     Gabriel      add __on_rt_assert_hook
+ * 2026-10-16     RT-Thread    add TLSF as system heap and rt_system_heap_add()
+ * 2026-10-16     RT-Thread    report the heap calls to the allocation profiler
  */
 
 #include <rtthread.h>
@@ -1345,6 +1347,28 @@ void rt_free_sethook(void (*hook)(void *ptr))
 static struct rt_mutex _lock;
 #endif
 
+#ifdef RT_USING_MEMPROF
+/* the return address of the heap function is the call site of the allocation */
+#if defined(__CC_ARM)
+#define _MEM_CALLER()   __return_address()
+#elif defined(__GNUC__)
+#define _MEM_CALLER()   __builtin_return_address(0)
+#else
+#define _MEM_CALLER()   RT_NULL
+#endif
+#define _MEM_PROF_ALLOC(_ptr, _size, _caller)   \
+    rt_memprof_alloc(_ptr, _size, _caller)
+#define _MEM_PROF_REALLOC(_ptr, _nptr, _newsize, _caller)   \
+    rt_memprof_realloc(_ptr, _nptr, _newsize, _caller)
+#define _MEM_PROF_FREE(_ptr)    \
+    rt_memprof_free(_ptr)
+#else
+#define _MEM_CALLER()   RT_NULL
+#define _MEM_PROF_ALLOC(_ptr, _size, _caller)
+#define _MEM_PROF_REALLOC(_ptr, _nptr, _newsize, _caller)
+#define _MEM_PROF_FREE(_ptr)
+#endif /* RT_USING_MEMPROF */
+
 rt_inline void _heap_lock_init(void)
 {
 #if defined(RT_USING_HEAP_ISR)
@@ -1439,6 +1463,27 @@ rt_inline void _slab_info(rt_size_t *total,
 #define _MEM_FREE(_ptr) \
     rt_slab_free(system_heap, _ptr)
 #define _MEM_INFO       _slab_info
+#elif defined(RT_USING_TLSF_AS_HEAP)
+static rt_tlsf_t system_heap;
+rt_inline void _tlsf_info(rt_size_t *total,
+    rt_size_t *used, rt_size_t *max_used)
+{
+    if (total)
+        *total = system_heap->total;
+    if (used)
+        *used = system_heap->used;
+    if (max_used)
+        *max_used = system_heap->max;
+}
+#define _MEM_INIT(_name, _start, _size) \
+    system_heap = rt_tlsf_init(_name, _start, _size)
+#define _MEM_MALLOC(_size)  \
+    rt_tlsf_alloc(system_heap, _size)
+#define _MEM_REALLOC(_ptr, _newsize)    \
+    rt_tlsf_realloc(system_heap, _ptr, _newsize)
+#define _MEM_FREE(_ptr) \
+    rt_tlsf_free(system_heap, _ptr)
+#define _MEM_INFO       _tlsf_info
 #else
 #define _MEM_INIT(...)
 #define _MEM_MALLOC(...)     RT_NULL
@@ -1467,14 +1512,39 @@ RT_WEAK void rt_system_heap_init(void *begin_addr, void *end_addr)
     _heap_lock_init();
 }
 
+#if defined(RT_USING_TLSF_AS_HEAP)
 /**
- * @brief Allocate a block of memory with a minimum of 'size' bytes.
+ * @brief This function will add another memory region to the system heap,
+ *        e.g. an external SDRAM.
  *
- * @param size is the minimum size of the requested block in bytes.
+ * @param begin_addr the beginning address of the memory region.
  *
- * @return the pointer to allocated memory or NULL if no free memory was found.
+ * @param end_addr the end address of the memory region.
+ *
+ * @return RT_EOK on success, or an error code of rt_tlsf_add_pool().
  */
-RT_WEAK void *rt_malloc(rt_size_t size)
+rt_err_t rt_system_heap_add(void *begin_addr, void *end_addr)
+{
+    rt_base_t level;
+    rt_err_t result;
+
+    RT_ASSERT(system_heap != RT_NULL);
+    RT_ASSERT((rt_ubase_t)end_addr > (rt_ubase_t)begin_addr);
+
+    /* Enter critical zone */
+    level = _heap_lock();
+    result = rt_tlsf_add_pool(system_heap, begin_addr,
+                              (rt_ubase_t)end_addr - (rt_ubase_t)begin_addr);
+    /* Exit critical zone */
+    _heap_unlock(level);
+
+    return result;
+}
+RTM_EXPORT(rt_system_heap_add);
+#endif /* RT_USING_TLSF_AS_HEAP */
+
+/* the allocation of rt_malloc(), rt_calloc() and rt_malloc_align() for the caller */
+static void *_heap_malloc(rt_size_t size, void *caller)
 {
     rt_base_t level;
     void *ptr;
@@ -1483,12 +1553,33 @@ RT_WEAK void *rt_malloc(rt_size_t size)
     level = _heap_lock();
     /* allocate memory block from system heap */
     ptr = _MEM_MALLOC(size);
+    _MEM_PROF_ALLOC(ptr, size, caller);
     /* Exit critical zone */
     _heap_unlock(level);
     /* call 'rt_malloc' hook */
     RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
     return ptr;
 }
+
+#ifdef RT_USING_MEMPROF
+/* record the caller of rt_calloc() and rt_malloc_align(), not the function itself */
+#define _HEAP_MALLOC(_size)     _heap_malloc(_size, _MEM_CALLER())
+#else
+/* keep going through rt_malloc(), it may be overridden */
+#define _HEAP_MALLOC(_size)     rt_malloc(_size)
+#endif /* RT_USING_MEMPROF */
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+RT_WEAK void *rt_malloc(rt_size_t size)
+{
+    return _heap_malloc(size, _MEM_CALLER());
+}
 RTM_EXPORT(rt_malloc);
 
 /**
@@ -1509,6 +1600,7 @@ RT_WEAK void *rt_realloc(void *rmem, rt_size_t newsize)
     level = _heap_lock();
     /* Change the size of previously allocated memory block */
     nptr = _MEM_REALLOC(rmem, newsize);
+    _MEM_PROF_REALLOC(rmem, nptr, newsize, _MEM_CALLER());
     /* Exit critical zone */
     _heap_unlock(level);
     return nptr;
@@ -1533,7 +1625,7 @@ RT_WEAK void *rt_calloc(rt_size_t count, rt_size_t size)
     void *p;
 
     /* allocate 'count' objects of size 'size' */
-    p = rt_malloc(count * size);
+    p = _HEAP_MALLOC(count * size);
     /* zero the memory */
     if (p)
     {
@@ -1557,6 +1649,7 @@ RT_WEAK void rt_free(void *rmem)
     RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
     /* Enter critical zone */
     level = _heap_lock();
+    _MEM_PROF_FREE(rmem);
     _MEM_FREE(rmem);
     /* Exit critical zone */
     _heap_unlock(level);
@@ -1643,7 +1736,7 @@ RT_WEAK void *rt_malloc_align(rt_size_t size, rt_size_t align)
     /* get total aligned size */
     align_size = ((size + uintptr_size) & ~uintptr_size) + align;
     /* allocate memory block from heap */
-    ptr = rt_malloc(align_size);
+    ptr = _HEAP_MALLOC(align_size);
     if (ptr != RT_NULL)
     {
         /* the allocated memory block is aligned */
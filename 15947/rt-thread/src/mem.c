@@ -12,6 +12,7 @@
  * 2010-10-14     Bernard      fix rt_realloc issue when realloc a NULL pointer.
  * 2017-07-14     armink       fix rt_realloc issue when new size is 0
  * 2018-10-02     Bernard      Add 64bit support
+ * 2026-10-16     RT-Thread    fix the pool pointer mask on 64-bit CPUs
  */
 
 /*
@@ -91,7 +92,7 @@ struct rt_small_mem
 #define MIN_SIZE 12
 #endif /* ARCH_CPU_64BIT */
 
-#define MEM_MASK             0xfffffffe
+#define MEM_MASK             ((~(rt_ubase_t)0) - 1)
 #define MEM_USED()         ((((rt_base_t)(small_mem)) & MEM_MASK) | 0x1)
 #define MEM_FREED()        ((((rt_base_t)(small_mem)) & MEM_MASK) | 0x0)
 #define MEM_ISUSED(_mem)   \
@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Heap allocation profiler.
+ *
+ * rt_malloc(), rt_realloc() and rt_free() report every call with the return address of
+ * their caller, the call site, while they hold the heap lock, so the tables below need no
+ * lock of their own. The call sites are kept in a table hashed by address, the profiled
+ * blocks in a table hashed by block address. Both have a fixed size and a lookup probes
+ * at most MEMPROF_PROBE_MAX entries. With a sample period of N, one allocation in N is
+ * profiled and the others cost a counter increment.
+ *
+ * The report lists the call sites by live bytes. A host script, tools/memprof.py, turns
+ * the addresses into functions and lines with the ELF file.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_MEMPROF)
+
+#define MEMPROF_PROBE_MAX           8
+#define MEMPROF_LIFETIME_NUM        8
+/* a block table entry that was freed, a lookup goes on past it */
+#define MEMPROF_FREED               ((void *)1)
+
+struct memprof_site
+{
+    void                       *caller;                         /**< return address of the call */
+    rt_uint32_t                 allocs;                         /**< profiled allocations */
+    rt_uint32_t                 frees;                          /**< profiled blocks freed */
+    rt_uint32_t                 fails;                          /**< failed allocations */
+    rt_uint32_t                 live_blocks;                    /**< profiled blocks not freed */
+    rt_size_t                   live_bytes;                     /**< bytes of the live blocks */
+    rt_size_t                   peak_bytes;                     /**< most live bytes */
+    rt_uint32_t                 lifetime[MEMPROF_LIFETIME_NUM]; /**< frees by lifetime */
+
+    /* filled by the report */
+    rt_size_t                   pinned_bytes;                   /**< live bytes older than RT_MEMPROF_PIN_AGE */
+    rt_tick_t                   oldest;                         /**< age of the oldest live block */
+};
+
+struct memprof_block
+{
+    void                       *ptr;                            /**< address of the block */
+    rt_size_t                   size;                           /**< requested size */
+    rt_tick_t                   tick;                           /**< time of the allocation */
+    rt_uint16_t                 site;                           /**< index of the call site */
+};
+
+/* the lifetime classes: 10 ms, 100 ms, 1 s, 10 s, 1 min, 10 min, 1 h and longer */
+static const rt_tick_t _lifetime_limit[MEMPROF_LIFETIME_NUM - 1] =
+{
+    RT_TICK_PER_SECOND / 100, RT_TICK_PER_SECOND / 10, RT_TICK_PER_SECOND,
+    10 * RT_TICK_PER_SECOND, 60 * RT_TICK_PER_SECOND, 600 * RT_TICK_PER_SECOND,
+    3600 * RT_TICK_PER_SECOND,
+};
+
+/* the site 0 takes the calls of the sites that find no room */
+static struct memprof_site _sites[RT_MEMPROF_SITE_NUM];
+static struct memprof_block _blocks[RT_MEMPROF_BLOCK_NUM];
+static rt_uint16_t _order[RT_MEMPROF_SITE_NUM];
+
+static rt_uint32_t _sample_period = RT_MEMPROF_SAMPLE_PERIOD;
+static rt_uint32_t _sample_count;
+static rt_uint32_t _allocations;
+static rt_uint32_t _untracked;
+static rt_uint32_t _site_overflow;
+static rt_tick_t _start_tick;
+
+rt_inline rt_uint32_t _memprof_hash(const void *addr)
+{
+    rt_uint32_t key = (rt_uint32_t)((rt_ubase_t)addr >> 1);
+
+    /* Fibonacci hashing, the high bits mix all the bits of the address */
+    return (key * 2654435761u) >> 16;
+}
+
+static struct memprof_site *_site_get(void *caller)
+{
+    struct memprof_site *site;
+    rt_uint32_t index;
+    int probe;
+
+    index = _memprof_hash(caller) % (RT_MEMPROF_SITE_NUM - 1);
+    for (probe = 0; probe < MEMPROF_PROBE_MAX; probe ++)
+    {
+        site = &_sites[index + 1];
+        if (site->caller == caller)
+            return site;
+        if (site->caller == RT_NULL)
+        {
+            site->caller = caller;
+            return site;
+        }
+        index = (index + 1) % (RT_MEMPROF_SITE_NUM - 1);
+    }
+
+    _site_overflow ++;
+    return &_sites[0];
+}
+
+static struct memprof_block *_block_find(void *ptr)
+{
+    struct memprof_block *block;
+    rt_uint32_t index;
+    int probe;
+
+    index = _memprof_hash(ptr) % RT_MEMPROF_BLOCK_NUM;
+    for (probe = 0; probe < MEMPROF_PROBE_MAX; probe ++)
+    {
+        block = &_blocks[index];
+        if (block->ptr == ptr)
+            return block;
+        if (block->ptr == RT_NULL)
+            break;
+        index = (index + 1) % RT_MEMPROF_BLOCK_NUM;
+    }
+
+    return RT_NULL;
+}
+
+static struct memprof_block *_block_insert(void *ptr)
+{
+    struct memprof_block *block;
+    rt_uint32_t index;
+    int probe;
+
+    index = _memprof_hash(ptr) % RT_MEMPROF_BLOCK_NUM;
+    for (probe = 0; probe < MEMPROF_PROBE_MAX; probe ++)
+    {
+        block = &_blocks[index];
+        if (block->ptr == RT_NULL || block->ptr == MEMPROF_FREED)
+        {
+            block->ptr = ptr;
+            return block;
+        }
+        index = (index + 1) % RT_MEMPROF_BLOCK_NUM;
+    }
+
+    return RT_NULL;
+}
+
+static void _site_add(struct memprof_site *site, rt_size_t size)
+{
+    site->live_blocks ++;
+    site->live_bytes += size;
+    if (site->live_bytes > site->peak_bytes)
+        site->peak_bytes = site->live_bytes;
+}
+
+static void _site_remove(struct memprof_site *site, struct memprof_block *block)
+{
+    rt_tick_t lifetime = rt_tick_get() - block->tick;
+    int index;
+
+    for (index = 0; index < MEMPROF_LIFETIME_NUM - 1; index ++)
+    {
+        if (lifetime < _lifetime_limit[index])
+            break;
+    }
+
+    site->frees ++;
+    site->lifetime[index] ++;
+    site->live_blocks --;
+    site->live_bytes -= block->size;
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * @brief This function will record an allocation of the system heap. It is called by
+ *        rt_malloc() with the heap locked.
+ *
+ * @param ptr the allocated block, or RT_NULL if the allocation failed.
+ *
+ * @param size the requested size.
+ *
+ * @param caller the return address of the allocation, which is its call site.
+ */
+void rt_memprof_alloc(void *ptr, rt_size_t size, void *caller)
+{
+    struct memprof_site *site;
+    struct memprof_block *block;
+
+    _allocations ++;
+    /* the failures are rare, they are always counted */
+    if (ptr == RT_NULL)
+    {
+        if (size > 0)
+            _site_get(caller)->fails ++;
+        return;
+    }
+
+    if (_sample_period == 0 || ++ _sample_count < _sample_period)
+        return;
+    _sample_count = 0;
+
+    block = _block_insert(ptr);
+    if (block == RT_NULL)
+    {
+        _untracked ++;
+        return;
+    }
+
+    site = _site_get(caller);
+    block->size = size;
+    block->tick = rt_tick_get();
+    block->site = (rt_uint16_t)(site - _sites);
+    site->allocs ++;
+    _site_add(site, size);
+}
+
+/**
+ * @brief This function will record a reallocation of the system heap. It is called by
+ *        rt_realloc() with the heap locked. A profiled block keeps its call site and its
+ *        time of allocation.
+ *
+ * @param rmem the block before the reallocation.
+ *
+ * @param nptr the block after the reallocation, or RT_NULL.
+ *
+ * @param newsize the requested size.
+ *
+ * @param caller the return address of the reallocation.
+ */
+void rt_memprof_realloc(void *rmem, void *nptr, rt_size_t newsize, void *caller)
+{
+    struct memprof_block *block, *moved;
+    struct memprof_site *site;
+    rt_tick_t tick;
+
+    if (rmem == RT_NULL)
+    {
+        rt_memprof_alloc(nptr, newsize, caller);
+        return;
+    }
+    if (newsize == 0)
+    {
+        rt_memprof_free(rmem);
+        return;
+    }
+    if (nptr == RT_NULL)
+    {
+        /* the old block is kept */
+        _allocations ++;
+        _site_get(caller)->fails ++;
+        return;
+    }
+
+    block = _block_find(rmem);
+    if (block == RT_NULL)
+    {
+        rt_memprof_alloc(nptr, newsize, caller);
+        return;
+    }
+
+    _allocations ++;
+    site = &_sites[block->site];
+    site->live_bytes -= block->size;
+    site->live_blocks --;
+    _site_add(site, newsize);
+    block->size = newsize;
+    if (nptr != rmem)
+    {
+        moved = _block_insert(nptr);
+        if (moved == RT_NULL)
+        {
+            /* the block is no longer profiled */
+            _untracked ++;
+            site->allocs --;
+            site->live_blocks --;
+            site->live_bytes -= newsize;
+        }
+        else
+        {
+            tick = block->tick;
+            moved->size = newsize;
+            moved->tick = tick;
+            moved->site = block->site;
+        }
+        block->ptr = MEMPROF_FREED;
+    }
+}
+
+/**
+ * @brief This function will record a free of the system heap. It is called by rt_free()
+ *        with the heap locked.
+ *
+ * @param ptr the freed block.
+ */
+void rt_memprof_free(void *ptr)
+{
+    struct memprof_block *block;
+
+    if (ptr == RT_NULL)
+        return;
+
+    block = _block_find(ptr);
+    if (block == RT_NULL)
+        return;
+
+    _site_remove(&_sites[block->site], block);
+    block->ptr = MEMPROF_FREED;
+}
+
+/**
+ * @brief This function will set the sample period of the profiler.
+ *
+ * @param period profile one allocation out of period, 0 stops the profiling of new
+ *        allocations. The profiled blocks are still followed until they are freed.
+ */
+void rt_memprof_set_sample(rt_uint32_t period)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    _sample_period = period;
+    _sample_count = 0;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_memprof_set_sample);
+
+/**
+ * @brief This function will clear the call sites and forget the profiled blocks.
+ *
+ * @note A call of the heap in progress in another thread may still count on a cleared
+ *       call site.
+ */
+void rt_memprof_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(_sites, 0, sizeof(_sites));
+    rt_memset(_blocks, 0, sizeof(_blocks));
+    _sample_count = 0;
+    _allocations = 0;
+    _untracked = 0;
+    _site_overflow = 0;
+    _start_tick = rt_tick_get();
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_memprof_reset);
+
+static void _memprof_sort(int count)
+{
+    rt_uint16_t index;
+    int i, j;
+
+    /* insertion sort by live bytes, then by allocations */
+    for (i = 1; i < count; i ++)
+    {
+        index = _order[i];
+        for (j = i; j > 0; j --)
+        {
+            struct memprof_site *a = &_sites[_order[j - 1]], *b = &_sites[index];
+
+            if (a->live_bytes > b->live_bytes ||
+                (a->live_bytes == b->live_bytes && a->allocs >= b->allocs))
+                break;
+            _order[j] = _order[j - 1];
+        }
+        _order[j] = index;
+    }
+}
+
+static void _memprof_heaps(void)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_memory *mem;
+
+    rt_kprintf("heap     algorithm      total       used   max used  largest free  frag%%\n");
+#ifdef RT_USING_MEMHEAP
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node = node->next)
+    {
+        struct rt_memheap *heap = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+
+        rt_kprintf("%-*.*s %-9s %10lu %10lu %10lu             -      -\n", RT_NAME_MAX, RT_NAME_MAX,
+                   heap->parent.name, "memheap", (unsigned long)heap->pool_size,
+                   (unsigned long)(heap->pool_size - heap->available_size),
+                   (unsigned long)heap->max_used_size);
+    }
+#endif /* RT_USING_MEMHEAP */
+
+    information = rt_object_get_information(RT_Object_Class_Memory);
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node = node->next)
+    {
+        mem = (struct rt_memory *)rt_list_entry(node, struct rt_object, list);
+        rt_kprintf("%-*.*s %-9s %10lu %10lu %10lu", RT_NAME_MAX, RT_NAME_MAX, mem->parent.name,
+                   mem->algorithm, (unsigned long)mem->total, (unsigned long)mem->used,
+                   (unsigned long)mem->max);
+#ifdef RT_USING_TLSF
+        if (rt_strcmp(mem->algorithm, "tlsf") == 0)
+        {
+            struct rt_tlsf_stats stats;
+            rt_base_t level;
+
+            level = rt_hw_interrupt_disable();
+            rt_tlsf_info((rt_tlsf_t)mem, &stats);
+            rt_hw_interrupt_enable(level);
+            /* the part of the free memory not in the largest block */
+            rt_kprintf("    %10lu  %5lu\n", (unsigned long)stats.largest_free,
+                       stats.total > stats.used ?
+                       (unsigned long)(100 - (rt_uint64_t)stats.largest_free * 100 / (stats.total - stats.used)) : 0);
+            continue;
+        }
+#endif /* RT_USING_TLSF */
+        rt_kprintf("             -      -\n");
+    }
+}
+
+/**
+ * @brief This function will print the call sites by live bytes, then the heaps.
+ *
+ * @note The tables are read while the heap is in use, a line may mix counts taken before
+ *       and after a call.
+ */
+void rt_memprof_dump(void)
+{
+    struct memprof_site *site;
+    struct memprof_block *block;
+    rt_tick_t now, age, elapsed;
+    int count, i, j;
+
+    now = rt_tick_get();
+    elapsed = now - _start_tick;
+
+    count = 0;
+    for (i = 0; i < RT_MEMPROF_SITE_NUM; i ++)
+    {
+        site = &_sites[i];
+        site->pinned_bytes = 0;
+        site->oldest = 0;
+        if (site->caller != RT_NULL || site->allocs != 0 || site->fails != 0)
+            _order[count ++] = (rt_uint16_t)i;
+    }
+    for (i = 0; i < RT_MEMPROF_BLOCK_NUM; i ++)
+    {
+        block = &_blocks[i];
+        if (block->ptr == RT_NULL || block->ptr == MEMPROF_FREED)
+            continue;
+        site = &_sites[block->site];
+        age = now - block->tick;
+        if (age > site->oldest)
+            site->oldest = age;
+        if (age >= RT_MEMPROF_PIN_AGE * RT_TICK_PER_SECOND)
+            site->pinned_bytes += block->size;
+    }
+    _memprof_sort(count);
+
+    rt_kprintf("memprof: %lu s, sample 1/%lu, %d sites, %lu allocations, %lu untracked, %lu sites overflowed\n",
+               (unsigned long)(elapsed / RT_TICK_PER_SECOND), (unsigned long)_sample_period, count,
+               (unsigned long)_allocations, (unsigned long)_untracked, (unsigned long)_site_overflow);
+    rt_kprintf("caller        allocs    frees  fails   live   live B   peak B pinned B oldest s  alloc/min"
+               "  <10ms <100ms    <1s   <10s   <1m  <10m   <1h  >=1h\n");
+    for (i = 0; i < count; i ++)
+    {
+        site = &_sites[_order[i]];
+        rt_kprintf("0x%08lx %9lu %8lu %6lu %6lu %8lu %8lu %8lu %8lu %10lu",
+                   (unsigned long)(rt_ubase_t)site->caller, (unsigned long)site->allocs,
+                   (unsigned long)site->frees, (unsigned long)site->fails,
+                   (unsigned long)site->live_blocks, (unsigned long)site->live_bytes,
+                   (unsigned long)site->peak_bytes, (unsigned long)site->pinned_bytes,
+                   (unsigned long)(site->oldest / RT_TICK_PER_SECOND),
+                   elapsed ? (unsigned long)((rt_uint64_t)site->allocs * 60 * RT_TICK_PER_SECOND / elapsed) : 0);
+        for (j = 0; j < MEMPROF_LIFETIME_NUM; j ++)
+        {
+            rt_kprintf(" %6lu", (unsigned long)site->lifetime[j]);
+        }
+        rt_kprintf("\n");
+    }
+
+    _memprof_heaps();
+}
+RTM_EXPORT(rt_memprof_dump);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+#include <stdlib.h>
+
+static void memprof(int argc, char **argv)
+{
+    if (argc == 1)
+    {
+        rt_memprof_dump();
+    }
+    else if (argc == 2 && rt_strcmp(argv[1], "reset") == 0)
+    {
+        rt_memprof_reset();
+    }
+    else if (argc == 3 && rt_strcmp(argv[1], "sample") == 0)
+    {
+        rt_memprof_set_sample((rt_uint32_t)atoi(argv[2]));
+    }
+    else
+    {
+        rt_kprintf("Usage:\n");
+        rt_kprintf("memprof                 - show the call sites of the heap\n");
+        rt_kprintf("memprof reset           - clear the call sites\n");
+        rt_kprintf("memprof sample <period> - profile one allocation out of period, 0 stops\n");
+    }
+}
+MSH_CMD_EXPORT(memprof, heap allocation profiler);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_MEMPROF */
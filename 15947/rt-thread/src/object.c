@@ -14,6 +14,7 @@
  * 2017-12-10     Bernard      Add object_info enum.
  * 2018-01-25     Bernard      Fix the object find issue when enable MODULE.
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to object.c
+ * 2026-10-16     RT-Thread    add the hashed name index of object container
  */
 
 #include <rtthread.h>
@@ -216,6 +217,25 @@ void rt_object_put_sethook(void (*hook)(struct rt_object *object))
 /**@}*/
 #endif /* RT_USING_HOOK */
 
+#ifdef RT_USING_OBJECT_HASH
+/*
+ * The name hash of an object, only the first RT_NAME_MAX characters are used as the
+ * names are compared by rt_strncmp(name, RT_NAME_MAX) too.
+ */
+static rt_slist_t *_object_hash_bucket(struct rt_object_information *information, const char *name)
+{
+    rt_uint32_t hash = 5381;
+    int index;
+
+    for (index = 0; index < RT_NAME_MAX && name[index] != '\0'; index ++)
+    {
+        hash = (hash << 5) + hash + (rt_uint8_t)name[index];
+    }
+
+    return &(information->hash_table[hash % RT_OBJECT_HASH_SIZE]);
+}
+#endif /* RT_USING_OBJECT_HASH */
+
 /**
  * @addtogroup KernelObject
  */
@@ -383,6 +403,10 @@ void rt_object_init(struct rt_object         *object,
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        /* the latest object goes first, as in the object list */
+        rt_slist_insert(_object_hash_bucket(information, object->name), &(object->hash_node));
+#endif /* RT_USING_OBJECT_HASH */
     }
 
     /* unlock interrupt */
@@ -398,12 +422,21 @@ void rt_object_init(struct rt_object         *object,
 void rt_object_detach(rt_object_t object)
 {
     register rt_base_t temp;
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object_information *information;
+#endif /* RT_USING_OBJECT_HASH */
 
     /* object check */
     RT_ASSERT(object != RT_NULL);
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
+#ifdef RT_USING_OBJECT_HASH
+    information = rt_object_get_information((enum rt_object_class_type)
+                                            (object->type & ~RT_Object_Class_Static));
+    RT_ASSERT(information != RT_NULL);
+#endif /* RT_USING_OBJECT_HASH */
+
     /* reset object type */
     object->type = 0;
 
@@ -412,6 +445,9 @@ void rt_object_detach(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_remove(_object_hash_bucket(information, object->name), &(object->hash_node));
+#endif /* RT_USING_OBJECT_HASH */
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -479,6 +515,10 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        /* the latest object goes first, as in the object list */
+        rt_slist_insert(_object_hash_bucket(information, object->name), &(object->hash_node));
+#endif /* RT_USING_OBJECT_HASH */
     }
 
     /* unlock interrupt */
@@ -496,6 +536,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
 void rt_object_delete(rt_object_t object)
 {
     register rt_base_t temp;
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object_information *information;
+#endif /* RT_USING_OBJECT_HASH */
 
     /* object check */
     RT_ASSERT(object != RT_NULL);
@@ -503,6 +546,11 @@ void rt_object_delete(rt_object_t object)
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
+#ifdef RT_USING_OBJECT_HASH
+    information = rt_object_get_information((enum rt_object_class_type)object->type);
+    RT_ASSERT(information != RT_NULL);
+#endif /* RT_USING_OBJECT_HASH */
+
     /* reset object type */
     object->type = RT_Object_Class_Null;
 
@@ -511,6 +559,9 @@ void rt_object_delete(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_remove(_object_hash_bucket(information, object->name), &(object->hash_node));
+#endif /* RT_USING_OBJECT_HASH */
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -569,11 +620,19 @@ rt_uint8_t rt_object_get_type(rt_object_t object)
  * in object container.
  *
  * @note this function shall not be invoked in interrupt status.
+ *
+ * @note with RT_USING_OBJECT_HASH, only the objects in the hash bucket of the name are
+ *       compared, instead of every object of the type.
  */
 rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 {
     struct rt_object *object = RT_NULL;
+#ifdef RT_USING_OBJECT_HASH
+    rt_slist_t *bucket = RT_NULL;
+    rt_slist_t *node = RT_NULL;
+#else
     struct rt_list_node *node = RT_NULL;
+#endif /* RT_USING_OBJECT_HASH */
     struct rt_object_information *information = RT_NULL;
 
     information = rt_object_get_information((enum rt_object_class_type)type);
@@ -584,6 +643,31 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     /* which is invoke in interrupt status */
     RT_DEBUG_NOT_IN_INTERRUPT;
 
+#ifdef RT_USING_OBJECT_HASH
+    /* the bucket is worked out before the scheduler is locked */
+    bucket = _object_hash_bucket(information, name);
+
+    /* enter critical */
+    rt_enter_critical();
+
+    /* try to find object */
+    rt_slist_for_each(node, bucket)
+    {
+        object = rt_slist_entry(node, struct rt_object, hash_node);
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            /* leave critical */
+            rt_exit_critical();
+
+            return object;
+        }
+    }
+
+    /* leave critical */
+    rt_exit_critical();
+
+    return RT_NULL;
+#else
     /* enter critical */
     rt_enter_critical();
 
@@ -604,6 +688,7 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     rt_exit_critical();
 
     return RT_NULL;
+#endif /* RT_USING_OBJECT_HASH */
 }
 
 /**@}*/
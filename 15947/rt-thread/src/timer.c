@@ -18,13 +18,50 @@
  *                             timeout function.
  * 2021-08-15     supperthomas add the comment
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to timer.c
+ * 2026-10-16     RT-Thread    add the hierarchical timing wheel RT_USING_TIMER_WHEEL
  */
 
 #include <rtthread.h>
 #include <rthw.h>
 
+#ifdef RT_USING_TIMER_WHEEL
+#if RT_TIMER_WHEEL_LEVEL * RT_TIMER_WHEEL_SLOT_BITS > 32
+#error "RT_TIMER_WHEEL_LEVEL * RT_TIMER_WHEEL_SLOT_BITS must not exceed the 32 bits of a tick"
+#endif
+
+#define _WHEEL_SLOT_NUM                 (1u << RT_TIMER_WHEEL_SLOT_BITS)
+#define _WHEEL_SLOT_MASK                (_WHEEL_SLOT_NUM - 1)
+#define _WHEEL_MAP_NUM                  ((_WHEEL_SLOT_NUM + 31) / 32)
+/* a slot of the level spans 1 << _WHEEL_SHIFT(level) ticks */
+#define _WHEEL_SHIFT(level)             ((level) * RT_TIMER_WHEEL_SLOT_BITS)
+/* the furthest timeout the wheel holds, a later one waits in the top level */
+#if RT_TIMER_WHEEL_LEVEL * RT_TIMER_WHEEL_SLOT_BITS < 32
+#define _WHEEL_SPAN_MAX                 ((1u << _WHEEL_SHIFT(RT_TIMER_WHEEL_LEVEL)) - 1)
+#else
+#define _WHEEL_SPAN_MAX                 RT_TICK_MAX
+#endif
+/* the row of a timer on the wheel, the one the timer checks use as well */
+#define _WHEEL_ROW                      (RT_TIMER_SKIP_LIST_LEVEL - 1)
+
+/*
+ * The timers due within 2^SLOT_BITS ticks are in the slots of level 0, one slot for each
+ * tick. The slots of level n span 2^(n * SLOT_BITS) ticks each. When level 0 comes round
+ * to its slot 0, the current slot of level 1 is cascaded: its timers are placed again, in
+ * level 0. The current slot of level 2 is cascaded when level 1 comes round, and so on.
+ */
+struct rt_timer_wheel
+{
+    rt_tick_t   tick;                                           /* the next tick to check */
+    rt_uint32_t map[RT_TIMER_WHEEL_LEVEL][_WHEEL_MAP_NUM];      /* the slots that may hold timers */
+    rt_list_t   slot[RT_TIMER_WHEEL_LEVEL][_WHEEL_SLOT_NUM];
+};
+
+/* hard timer wheel, an array of one, so that it is passed like the skip list heads */
+static struct rt_timer_wheel _timer_list[1];
+#else
 /* hard timer list */
 static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_USING_TIMER_WHEEL */
 
 #ifdef RT_USING_TIMER_SOFT
 
@@ -42,7 +79,11 @@ static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 /* soft timer status */
 static rt_uint8_t _soft_timer_status = RT_SOFT_TIMER_IDLE;
 /* soft timer list */
+#ifdef RT_USING_TIMER_WHEEL
+static struct rt_timer_wheel _soft_timer_list[1];
+#else
 static rt_list_t _soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_USING_TIMER_WHEEL */
 static struct rt_thread _timer_thread;
 ALIGN(RT_ALIGN_SIZE)
 static rt_uint8_t _timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
@@ -143,6 +184,267 @@ static void _timer_init(rt_timer_t timer,
     }
 }
 
+#ifdef RT_USING_TIMER_WHEEL
+rt_inline void _wheel_mark(struct rt_timer_wheel *wheel, int level, rt_uint32_t index)
+{
+    wheel->map[level][index >> 5] |= 1u << (index & 31);
+}
+
+rt_inline void _wheel_unmark(struct rt_timer_wheel *wheel, int level, rt_uint32_t index)
+{
+    wheel->map[level][index >> 5] &= ~(1u << (index & 31));
+}
+
+/**
+ * @brief Find the first marked slot of a level, from a slot on and round the wheel
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param level is the level of the wheel
+ *
+ * @param index is the slot to start from
+ *
+ * @return the slot, or -1 if no slot of the level is marked
+ */
+static int _wheel_find(struct rt_timer_wheel *wheel, int level, rt_uint32_t index)
+{
+    rt_uint32_t bits, word;
+    int n;
+
+    /* the word of index is looked at twice: the slots from index on, then the ones before */
+    for (n = 0; n <= _WHEEL_MAP_NUM; n++)
+    {
+        word = ((index >> 5) + n) % _WHEEL_MAP_NUM;
+        bits = wheel->map[level][word];
+        if (n == 0)
+            bits &= ~0u << (index & 31);
+        else if (n == _WHEEL_MAP_NUM)
+            bits &= ~(~0u << (index & 31));
+
+        if (bits != 0)
+            return (int)(word * 32) + __rt_ffs((int)bits) - 1;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Initialize a timing wheel, from the current tick on
+ *
+ * @param wheel is the timing wheel
+ */
+static void _timer_list_init(struct rt_timer_wheel *wheel)
+{
+    int level, index;
+
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        for (index = 0; index < _WHEEL_SLOT_NUM; index++)
+        {
+            rt_list_init(&wheel->slot[level][index]);
+        }
+    }
+    rt_memset(wheel->map, 0, sizeof(wheel->map));
+    wheel->tick = rt_tick_get();
+}
+
+/**
+ * @brief Put a timer in the slot of its timeout tick, it takes a constant time
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param timer is the timer, not on any list
+ */
+static void _timer_list_insert(struct rt_timer_wheel *wheel, rt_timer_t timer)
+{
+    rt_tick_t timeout_tick, delta;
+    rt_uint32_t index;
+    int level;
+
+    timeout_tick = timer->timeout_tick;
+    delta = timeout_tick - wheel->tick;
+    if (delta >= RT_TICK_MAX / 2)
+    {
+        /* the timeout is past, the timer is due at the next check */
+        timeout_tick = wheel->tick;
+        delta = 0;
+    }
+    else if (delta > _WHEEL_SPAN_MAX)
+    {
+        /* beyond the wheel, wait in the furthest slot and be placed again from there */
+        timeout_tick = wheel->tick + _WHEEL_SPAN_MAX;
+        delta = _WHEEL_SPAN_MAX;
+    }
+
+    for (level = 0; level < RT_TIMER_WHEEL_LEVEL - 1; level++)
+    {
+        if ((delta >> _WHEEL_SHIFT(level + 1)) == 0)
+            break;
+    }
+
+    index = (timeout_tick >> _WHEEL_SHIFT(level)) & _WHEEL_SLOT_MASK;
+    /* the timers of a slot run in the order they were put in */
+    rt_list_insert_before(&wheel->slot[level][index], &(timer->row[_WHEEL_ROW]));
+    _wheel_mark(wheel, level, index);
+}
+
+/**
+ * @brief Cascade the current slot of each level that has come round, wheel->tick is a
+ *        multiple of the span of a level 1 slot.
+ *
+ * @param wheel is the timing wheel
+ */
+static void _wheel_cascade(struct rt_timer_wheel *wheel)
+{
+    struct rt_timer *t;
+    rt_list_t *head;
+    rt_uint32_t index;
+    int level;
+
+    for (level = 1; level < RT_TIMER_WHEEL_LEVEL; level++)
+    {
+        index = (wheel->tick >> _WHEEL_SHIFT(level)) & _WHEEL_SLOT_MASK;
+        head = &wheel->slot[level][index];
+
+        _wheel_unmark(wheel, level, index);
+        while (!rt_list_isempty(head))
+        {
+            t = rt_list_entry(head->next, struct rt_timer, row[_WHEEL_ROW]);
+            rt_list_remove(&(t->row[_WHEEL_ROW]));
+            _timer_list_insert(wheel, t);
+        }
+
+        /* the next level turns only when this one comes round */
+        if (index != 0)
+            break;
+    }
+}
+
+/**
+ * @brief Get the first timer due at current_tick. The wheel moves on to current_tick,
+ *        over the empty slots, and cascades the higher levels on its way.
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param current_tick is the current tick
+ *
+ * @return the first due timer, or RT_NULL if no timer is due
+ */
+static struct rt_timer *_timer_list_first(struct rt_timer_wheel *wheel, rt_tick_t current_tick)
+{
+    rt_uint32_t index;
+    rt_tick_t step;
+    int next;
+
+    /* the ticks up to current_tick, with a tick that can wrap */
+    while ((current_tick - wheel->tick) < RT_TICK_MAX / 2)
+    {
+        index = wheel->tick & _WHEEL_SLOT_MASK;
+        if (index == 0)
+        {
+            /* cascading again while the slot is checked finds nothing to move */
+            _wheel_cascade(wheel);
+        }
+
+        if (!rt_list_isempty(&wheel->slot[0][index]))
+        {
+            return rt_list_entry(wheel->slot[0][index].next, struct rt_timer, row[_WHEEL_ROW]);
+        }
+        _wheel_unmark(wheel, 0, index);
+
+        /* skip to the next slot in use, or to the next cascade, in one step */
+        next = _wheel_find(wheel, 0, index);
+        if (next > (int)index)
+            step = next - index;
+        else
+            step = _WHEEL_SLOT_NUM - index;
+        if (step > current_tick - wheel->tick)
+            step = current_tick - wheel->tick + 1;
+        wheel->tick += step;
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * @brief Find the next timeout tick of a timing wheel. The slots of a level span ranges of
+ *        ticks in the order of the wheel, so the earliest timer of a level is in its first
+ *        slot in use, and only the slots that can beat the levels below are looked through.
+ *        A timeout beyond the wheel counts as the tick its slot is cascaded.
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param timeout_tick is the next timer's ticks
+ *
+ * @return  Return the operation status. If the return value is RT_EOK, the function is successfully executed.
+ *          If the return value is any other values, it means this operation failed.
+ */
+static rt_err_t _timer_list_next_timeout(struct rt_timer_wheel *wheel, rt_tick_t *timeout_tick)
+{
+    struct rt_timer *t;
+    rt_list_t *node;
+    rt_tick_t delta, nearest;
+    rt_uint32_t index, start, distance;
+    register rt_base_t level;
+    int lvl, slot;
+
+    nearest = RT_TICK_MAX;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (lvl = 0; lvl < RT_TIMER_WHEEL_LEVEL; lvl++)
+    {
+        index = (wheel->tick >> _WHEEL_SHIFT(lvl)) & _WHEEL_SLOT_MASK;
+        /* the current slot of a higher level was cascaded, unless wheel->tick starts it */
+        start = index;
+        if (lvl > 0 && (wheel->tick & ((1u << _WHEEL_SHIFT(lvl)) - 1)) != 0)
+            start = (index + 1) & _WHEEL_SLOT_MASK;
+
+        /* the marks of the slots emptied by rt_timer_stop() are cleared here */
+        while ((slot = _wheel_find(wheel, lvl, start)) >= 0 &&
+               rt_list_isempty(&wheel->slot[lvl][slot]))
+        {
+            _wheel_unmark(wheel, lvl, slot);
+        }
+        if (slot < 0)
+            continue;
+
+        /* the tick the slot is due, or cascaded */
+        distance = (slot - index) & _WHEEL_SLOT_MASK;
+        if (distance == 0 && start != index)
+            distance = _WHEEL_SLOT_NUM;
+        delta = (((wheel->tick >> _WHEEL_SHIFT(lvl)) + distance) << _WHEEL_SHIFT(lvl)) - wheel->tick;
+        if (delta >= nearest)
+            continue;
+
+        if (lvl == 0)
+        {
+            /* a level 0 slot holds the timers of a single tick */
+            nearest = delta;
+            continue;
+        }
+        for (node = wheel->slot[lvl][slot].next; node != &wheel->slot[lvl][slot]; node = node->next)
+        {
+            t = rt_list_entry(node, struct rt_timer, row[_WHEEL_ROW]);
+            /* a timeout beyond the wheel is placed again when the slot is cascaded */
+            if (t->timeout_tick - wheel->tick - delta >= (1u << _WHEEL_SHIFT(lvl)))
+                nearest = delta;
+            else if (t->timeout_tick - wheel->tick < nearest)
+                nearest = t->timeout_tick - wheel->tick;
+        }
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    if (nearest == RT_TICK_MAX)
+        return -RT_ERROR;
+
+    *timeout_tick = wheel->tick + nearest;
+    return RT_EOK;
+}
+#else
 /**
  * @brief  Find the next emtpy timer ticks
  *
@@ -179,6 +481,102 @@ static rt_err_t _timer_list_next_timeout(rt_list_t timer_list[], rt_tick_t *time
     return -RT_ERROR;
 }
 
+/**
+ * @brief Insert a timer in the skip list, after the timers of the same timeout
+ *
+ * @param timer_list is the array of time list
+ *
+ * @param timer is the timer, not on any list
+ */
+static void _timer_list_insert(rt_list_t timer_list[], rt_timer_t timer)
+{
+    unsigned int row_lvl;
+    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
+    unsigned int tst_nr;
+    static unsigned int random_nr;
+
+    row_head[0]  = &timer_list[0];
+    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
+             row_head[row_lvl]  = row_head[row_lvl]->next)
+        {
+            struct rt_timer *t;
+            rt_list_t *p = row_head[row_lvl]->next;
+
+            /* fix up the entry pointer */
+            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
+
+            /* If we have two timers that timeout at the same time, it's
+             * preferred that the timer inserted early get called early.
+             * So insert the new timer to the end the the some-timeout timer
+             * list.
+             */
+            if ((t->timeout_tick - timer->timeout_tick) == 0)
+            {
+                continue;
+            }
+            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
+            {
+                break;
+            }
+        }
+        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
+            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
+    }
+
+    /* Interestingly, this super simple timer insert counter works very very
+     * well on distributing the list height uniformly. By means of "very very
+     * well", I mean it beats the randomness of timer->timeout_tick very easily
+     * (actually, the timeout_tick is not random and easy to be attacked). */
+    random_nr++;
+    tst_nr = random_nr;
+
+    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
+                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
+            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
+                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
+        else
+            break;
+        /* Shift over the bits we have tested. Works well with 1 bit and 2
+         * bits. */
+        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
+    }
+}
+
+/**
+ * @brief Get the first timer of the list if it is due at current_tick
+ *
+ * @param timer_list is the array of time list
+ *
+ * @param current_tick is the current tick
+ *
+ * @return the first due timer, or RT_NULL if no timer is due
+ */
+static struct rt_timer *_timer_list_first(rt_list_t timer_list[], rt_tick_t current_tick)
+{
+    struct rt_timer *t;
+
+    if (rt_list_isempty(&timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+        return RT_NULL;
+
+    t = rt_list_entry(timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
+                      struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+
+    /*
+     * It supposes that the new tick shall less than the half duration of
+     * tick max.
+     */
+    if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
+        return t;
+
+    return RT_NULL;
+}
+#endif /* RT_USING_TIMER_WHEEL */
+
 /**
  * @brief Remove the timer
  *
@@ -194,7 +592,7 @@ rt_inline void _timer_remove(rt_timer_t timer)
     }
 }
 
-#if RT_DEBUG_TIMER
+#if RT_DEBUG_TIMER && !defined(RT_USING_TIMER_WHEEL)
 /**
  * @brief The number of timer
  *
@@ -233,7 +631,7 @@ void rt_timer_dump(rt_list_t timer_heads[])
     }
     rt_kprintf("\n");
 }
-#endif /* RT_DEBUG_TIMER */
+#endif /* RT_DEBUG_TIMER && !defined(RT_USING_TIMER_WHEEL) */
 
 /**
  * @addtogroup Clock
@@ -396,13 +794,8 @@ RTM_EXPORT(rt_timer_delete);
  */
 rt_err_t rt_timer_start(rt_timer_t timer)
 {
-    unsigned int row_lvl;
-    rt_list_t *timer_list;
     register rt_base_t level;
     register rt_bool_t need_schedule;
-    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
-    unsigned int tst_nr;
-    static unsigned int random_nr;
 
     /* parameter check */
     RT_ASSERT(timer != RT_NULL);
@@ -425,64 +818,13 @@ rt_err_t rt_timer_start(rt_timer_t timer)
     if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
     {
         /* insert timer to soft timer list */
-        timer_list = _soft_timer_list;
+        _timer_list_insert(_soft_timer_list, timer);
     }
     else
 #endif /* RT_USING_TIMER_SOFT */
     {
         /* insert timer to system timer list */
-        timer_list = _timer_list;
-    }
-
-    row_head[0]  = &timer_list[0];
-    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
-    {
-        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
-             row_head[row_lvl]  = row_head[row_lvl]->next)
-        {
-            struct rt_timer *t;
-            rt_list_t *p = row_head[row_lvl]->next;
-
-            /* fix up the entry pointer */
-            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
-
-            /* If we have two timers that timeout at the same time, it's
-             * preferred that the timer inserted early get called early.
-             * So insert the new timer to the end the the some-timeout timer
-             * list.
-             */
-            if ((t->timeout_tick - timer->timeout_tick) == 0)
-            {
-                continue;
-            }
-            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
-            {
-                break;
-            }
-        }
-        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
-            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
-    }
-
-    /* Interestingly, this super simple timer insert counter works very very
-     * well on distributing the list height uniformly. By means of "very very
-     * well", I mean it beats the randomness of timer->timeout_tick very easily
-     * (actually, the timeout_tick is not random and easy to be attacked). */
-    random_nr++;
-    tst_nr = random_nr;
-
-    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
-                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
-    {
-        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
-            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
-                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
-        else
-            break;
-        /* Shift over the bits we have tested. Works well with 1 bit and 2
-         * bits. */
-        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
+        _timer_list_insert(_timer_list, timer);
     }
 
     timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
@@ -630,51 +972,40 @@ void rt_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+    while ((t = _timer_list_first(_timer_list, current_tick)) != RT_NULL)
     {
-        t = rt_list_entry(_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
-                          struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
-
-        /*
-         * It supposes that the new tick shall less than the half duration of
-         * tick max.
-         */
-        if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
-        {
-            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+        RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
 
-            /* remove timer from timer list firstly */
-            _timer_remove(t);
-            if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
-            {
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-            }
-            /* add timer to temporary list  */
-            rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            /* call timeout function */
-            t->timeout_func(t->parameter);
+        /* remove timer from timer list firstly */
+        _timer_remove(t);
+        if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
+        {
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+        /* add timer to temporary list  */
+        rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        /* call timeout function */
+        t->timeout_func(t->parameter);
 
-            /* re-get tick */
-            current_tick = rt_tick_get();
+        /* re-get tick */
+        current_tick = rt_tick_get();
 
-            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
-            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+        RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
 
-            /* Check whether the timer object is detached or started again */
-            if (rt_list_isempty(&list))
-            {
-                continue;
-            }
-            rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
-                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
-            {
-                /* start it */
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-                rt_timer_start(t);
-            }
+        /* Check whether the timer object is detached or started again */
+        if (rt_list_isempty(&list))
+        {
+            continue;
+        }
+        rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+            (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            /* start it */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            rt_timer_start(t);
         }
-        else break;
     }
 
     /* enable interrupt */
@@ -714,59 +1045,52 @@ void rt_soft_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+    while (1)
     {
-        t = rt_list_entry(_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
-                            struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
-
         current_tick = rt_tick_get();
 
-        /*
-         * It supposes that the new tick shall less than the half duration of
-         * tick max.
-         */
-        if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
-        {
-            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+        t = _timer_list_first(_soft_timer_list, current_tick);
+        if (t == RT_NULL)
+            break; /* not check anymore */
 
-            /* remove timer from timer list firstly */
-            _timer_remove(t);
-            if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
-            {
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-            }
-            /* add timer to temporary list  */
-            rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
 
-            _soft_timer_status = RT_SOFT_TIMER_BUSY;
-            /* enable interrupt */
-            rt_hw_interrupt_enable(level);
+        /* remove timer from timer list firstly */
+        _timer_remove(t);
+        if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
+        {
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+        /* add timer to temporary list  */
+        rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
 
-            /* call timeout function */
-            t->timeout_func(t->parameter);
+        _soft_timer_status = RT_SOFT_TIMER_BUSY;
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
 
-            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
-            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+        /* call timeout function */
+        t->timeout_func(t->parameter);
 
-            /* disable interrupt */
-            level = rt_hw_interrupt_disable();
+        RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
 
-            _soft_timer_status = RT_SOFT_TIMER_IDLE;
-            /* Check whether the timer object is detached or started again */
-            if (rt_list_isempty(&list))
-            {
-                continue;
-            }
-            rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
-                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
-            {
-                /* start it */
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-                rt_timer_start(t);
-            }
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        _soft_timer_status = RT_SOFT_TIMER_IDLE;
+        /* Check whether the timer object is detached or started again */
+        if (rt_list_isempty(&list))
+        {
+            continue;
+        }
+        rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+            (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            /* start it */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            rt_timer_start(t);
         }
-        else break; /* not check anymore */
     }
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
@@ -820,12 +1144,16 @@ static void _timer_thread_entry(void *parameter)
  */
 void rt_system_timer_init(void)
 {
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_list_init(_timer_list);
+#else
     int i;
 
     for (i = 0; i < sizeof(_timer_list) / sizeof(_timer_list[0]); i++)
     {
         rt_list_init(_timer_list + i);
     }
+#endif /* RT_USING_TIMER_WHEEL */
 }
 
 /**
@@ -836,6 +1164,9 @@ void rt_system_timer_init(void)
 void rt_system_timer_thread_init(void)
 {
 #ifdef RT_USING_TIMER_SOFT
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_list_init(_soft_timer_list);
+#else
     int i;
 
     for (i = 0;
@@ -844,6 +1175,7 @@ void rt_system_timer_thread_init(void)
     {
         rt_list_init(_soft_timer_list + i);
     }
+#endif /* RT_USING_TIMER_WHEEL */
 
     /* start software timer thread */
     rt_thread_init(&_timer_thread,
@@ -0,0 +1,836 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+/*
+ * Two-Level Segregated Fit memory allocator.
+ *
+ * The free blocks are kept in lists by size class: the first level is the power of two
+ * of the size, the second level splits it into TLSF_SL_COUNT linear classes. Two bitmaps
+ * tell which lists are not empty, so an allocation finds a free block large enough with
+ * two bit scans, and a free merges with the physical neighbours at once. Both take the
+ * same time whatever the number of blocks in the heap.
+ *
+ * The algorithm is the one of M. Masmano, I. Ripoll, A. Crespo and J. Real, "TLSF: a New
+ * Dynamic Memory Allocator for Real-Time Systems", ECRTS 2004.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_TLSF)
+
+/* the number of second level lists of a first level, as a power of two */
+#define TLSF_SL_INDEX_COUNT_LOG2    4
+/* the blocks are smaller than 1 << TLSF_FL_INDEX_MAX */
+#ifndef TLSF_FL_INDEX_MAX
+#define TLSF_FL_INDEX_MAX           26
+#endif
+
+/*
+ * The data of a block starts one word after the data of the previous one ends, so the
+ * blocks are aligned to the word size, which must cover RT_ALIGN_SIZE.
+ */
+#ifdef ARCH_CPU_64BIT
+#define TLSF_ALIGN_SIZE             8
+#define TLSF_ALIGN_SIZE_LOG2        3
+#else
+#define TLSF_ALIGN_SIZE             4
+#define TLSF_ALIGN_SIZE_LOG2        2
+#endif /* ARCH_CPU_64BIT */
+
+#if RT_ALIGN_SIZE > TLSF_ALIGN_SIZE
+#error "TLSF aligns the blocks to the word size, RT_ALIGN_SIZE is larger"
+#endif
+
+#define TLSF_SL_COUNT               (1 << TLSF_SL_INDEX_COUNT_LOG2)
+#define TLSF_FL_INDEX_SHIFT         (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_FL_COUNT               (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+/* the blocks smaller than this are all in the first level 0, by steps of the alignment */
+#define TLSF_SMALL_BLOCK_SIZE       (1 << TLSF_FL_INDEX_SHIFT)
+
+/**
+ * block header of the heap
+ *
+ * prev_phys is only valid if the previous block is free, it is stored in the last word of
+ * that block. The data of a used block starts at next_free, so a used block takes one
+ * word, the size, more than its data.
+ */
+struct rt_tlsf_block
+{
+    struct rt_tlsf_block       *prev_phys;         /**< the previous block, if it is free */
+    rt_size_t                   size;              /**< data size, and the TLSF_BLOCK_*_FREE bits */
+    struct rt_tlsf_block       *next_free;         /**< next block of the free list */
+    struct rt_tlsf_block       *prev_free;         /**< previous block of the free list */
+};
+
+#define TLSF_BLOCK_FREE             0x1
+#define TLSF_BLOCK_PREV_FREE        0x2
+#define TLSF_BLOCK_FLAGS            (TLSF_BLOCK_FREE | TLSF_BLOCK_PREV_FREE)
+
+#define TLSF_BLOCK_OVERHEAD         (sizeof(rt_size_t))
+#define TLSF_BLOCK_START_OFFSET     (sizeof(struct rt_tlsf_block *) + sizeof(rt_size_t))
+/* a free block holds the free list pointers and the prev_phys of the next block */
+#define TLSF_BLOCK_SIZE_MIN         RT_ALIGN(sizeof(struct rt_tlsf_block) - sizeof(struct rt_tlsf_block *), TLSF_ALIGN_SIZE)
+#define TLSF_BLOCK_SIZE_MAX         ((rt_size_t)1 << TLSF_FL_INDEX_MAX)
+/* the first block and the end sentinel of a pool */
+#define TLSF_POOL_OVERHEAD          (2 * TLSF_BLOCK_OVERHEAD)
+
+/**
+ * Base structure of TLSF memory object
+ */
+struct rt_tlsf
+{
+    struct rt_memory            parent;                                 /**< inherit from rt_memory */
+    struct rt_tlsf_block        block_null;                             /**< end of every free list */
+    rt_uint32_t                 fl_bitmap;                              /**< first level lists not empty */
+    rt_uint32_t                 sl_bitmap[TLSF_FL_COUNT];               /**< second level lists not empty */
+    struct rt_tlsf_block       *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];   /**< free lists */
+
+    rt_uint16_t                 pool_count;                             /**< memory regions of the heap */
+    rt_size_t                   free_blocks;                            /**< blocks in the free lists */
+    rt_uint32_t                 alloc_count;                            /**< successful allocations */
+    rt_uint32_t                 fail_count;                             /**< failed allocations */
+};
+
+rt_inline int _tlsf_fls(rt_uint32_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return word ? 31 - __builtin_clz(word) : -1;
+#else
+    int bit = 31;
+
+    if (word == 0) return -1;
+    if (!(word & 0xffff0000)) { word <<= 16; bit -= 16; }
+    if (!(word & 0xff000000)) { word <<= 8; bit -= 8; }
+    if (!(word & 0xf0000000)) { word <<= 4; bit -= 4; }
+    if (!(word & 0xc0000000)) { word <<= 2; bit -= 2; }
+    if (!(word & 0x80000000)) { bit -= 1; }
+
+    return bit;
+#endif
+}
+
+rt_inline int _tlsf_ffs(rt_uint32_t word)
+{
+    return _tlsf_fls(word & (~word + 1));
+}
+
+rt_inline rt_size_t _block_size(const struct rt_tlsf_block *block)
+{
+    return block->size & ~(rt_size_t)TLSF_BLOCK_FLAGS;
+}
+
+rt_inline void _block_set_size(struct rt_tlsf_block *block, rt_size_t size)
+{
+    block->size = size | (block->size & TLSF_BLOCK_FLAGS);
+}
+
+rt_inline rt_bool_t _block_is_last(const struct rt_tlsf_block *block)
+{
+    return _block_size(block) == 0;
+}
+
+rt_inline rt_bool_t _block_is_free(const struct rt_tlsf_block *block)
+{
+    return (block->size & TLSF_BLOCK_FREE) ? RT_TRUE : RT_FALSE;
+}
+
+rt_inline rt_bool_t _block_is_prev_free(const struct rt_tlsf_block *block)
+{
+    return (block->size & TLSF_BLOCK_PREV_FREE) ? RT_TRUE : RT_FALSE;
+}
+
+rt_inline void *_block_to_ptr(const struct rt_tlsf_block *block)
+{
+    return (rt_uint8_t *)block + TLSF_BLOCK_START_OFFSET;
+}
+
+rt_inline struct rt_tlsf_block *_block_from_ptr(const void *ptr)
+{
+    return (struct rt_tlsf_block *)((rt_uint8_t *)ptr - TLSF_BLOCK_START_OFFSET);
+}
+
+/* the next block starts in the last word of the data of this one */
+rt_inline struct rt_tlsf_block *_block_next(const struct rt_tlsf_block *block)
+{
+    RT_ASSERT(!_block_is_last(block));
+
+    return (struct rt_tlsf_block *)((rt_uint8_t *)_block_to_ptr(block) +
+                                    _block_size(block) - TLSF_BLOCK_OVERHEAD);
+}
+
+rt_inline struct rt_tlsf_block *_block_link_next(struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = _block_next(block);
+
+    next->prev_phys = block;
+
+    return next;
+}
+
+rt_inline void _block_mark_as_free(struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = _block_link_next(block);
+
+    next->size |= TLSF_BLOCK_PREV_FREE;
+    block->size |= TLSF_BLOCK_FREE;
+}
+
+rt_inline void _block_mark_as_used(struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = _block_next(block);
+
+    next->size &= ~(rt_size_t)TLSF_BLOCK_PREV_FREE;
+    block->size &= ~(rt_size_t)TLSF_BLOCK_FREE;
+}
+
+/* the size of a request: aligned, at least the size of a free block */
+rt_inline rt_size_t _adjust_request_size(rt_size_t size)
+{
+    rt_size_t aligned;
+
+    if (size == 0 || size >= TLSF_BLOCK_SIZE_MAX)
+        return 0;
+
+    aligned = RT_ALIGN(size, TLSF_ALIGN_SIZE);
+    if (aligned < TLSF_BLOCK_SIZE_MIN)
+        aligned = TLSF_BLOCK_SIZE_MIN;
+
+    return aligned;
+}
+
+/* the lists of a size */
+rt_inline void _mapping_insert(rt_size_t size, int *fli, int *sli)
+{
+    int fl, sl;
+
+    if (size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        fl = 0;
+        sl = (int)size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_COUNT);
+    }
+    else
+    {
+        fl = _tlsf_fls((rt_uint32_t)size);
+        sl = (int)(size >> (fl - TLSF_SL_INDEX_COUNT_LOG2)) ^ (1 << TLSF_SL_INDEX_COUNT_LOG2);
+        fl -= (TLSF_FL_INDEX_SHIFT - 1);
+    }
+    *fli = fl;
+    *sli = sl;
+}
+
+/* the first lists whose every block holds the size: the size is rounded up to the next class */
+rt_inline void _mapping_search(rt_size_t size, int *fli, int *sli)
+{
+    if (size >= TLSF_SMALL_BLOCK_SIZE)
+    {
+        size += ((rt_size_t)1 << (_tlsf_fls((rt_uint32_t)size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    _mapping_insert(size, fli, sli);
+}
+
+static struct rt_tlsf_block *_search_suitable_block(struct rt_tlsf *tlsf, int *fli, int *sli)
+{
+    int fl = *fli;
+    int sl = *sli;
+    rt_uint32_t sl_map, fl_map;
+
+    /* a block of this first level, in the same or a larger second level list */
+    sl_map = tlsf->sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map)
+    {
+        /* none: the smallest block of a larger first level */
+        fl_map = (fl + 1 < 32) ? tlsf->fl_bitmap & (~0U << (fl + 1)) : 0;
+        if (!fl_map)
+            return RT_NULL;
+
+        fl = _tlsf_ffs(fl_map);
+        *fli = fl;
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    RT_ASSERT(sl_map != 0);
+    sl = _tlsf_ffs(sl_map);
+    *sli = sl;
+
+    return tlsf->blocks[fl][sl];
+}
+
+static void _remove_free_block(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, int fl, int sl)
+{
+    struct rt_tlsf_block *prev = block->prev_free;
+    struct rt_tlsf_block *next = block->next_free;
+
+    RT_ASSERT(prev != RT_NULL && next != RT_NULL);
+    next->prev_free = prev;
+    prev->next_free = next;
+
+    if (tlsf->blocks[fl][sl] == block)
+    {
+        tlsf->blocks[fl][sl] = next;
+        if (next == &tlsf->block_null)
+        {
+            tlsf->sl_bitmap[fl] &= ~(1U << sl);
+            if (!tlsf->sl_bitmap[fl])
+            {
+                tlsf->fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+    tlsf->free_blocks --;
+}
+
+static void _insert_free_block(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, int fl, int sl)
+{
+    struct rt_tlsf_block *current = tlsf->blocks[fl][sl];
+
+    RT_ASSERT(current != RT_NULL);
+    block->next_free = current;
+    block->prev_free = &tlsf->block_null;
+    current->prev_free = block;
+
+    RT_ASSERT(((rt_ubase_t)_block_to_ptr(block) & (TLSF_ALIGN_SIZE - 1)) == 0);
+
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= (1U << fl);
+    tlsf->sl_bitmap[fl] |= (1U << sl);
+    tlsf->free_blocks ++;
+}
+
+rt_inline void _block_remove(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    int fl, sl;
+
+    _mapping_insert(_block_size(block), &fl, &sl);
+    _remove_free_block(tlsf, block, fl, sl);
+}
+
+rt_inline void _block_insert(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    int fl, sl;
+
+    _mapping_insert(_block_size(block), &fl, &sl);
+    _insert_free_block(tlsf, block, fl, sl);
+}
+
+rt_inline rt_bool_t _block_can_split(struct rt_tlsf_block *block, rt_size_t size)
+{
+    return _block_size(block) >= sizeof(struct rt_tlsf_block) + size;
+}
+
+/* split the block at size, the remaining part is returned as a free block */
+static struct rt_tlsf_block *_block_split(struct rt_tlsf_block *block, rt_size_t size)
+{
+    struct rt_tlsf_block *remaining;
+    rt_size_t remain_size;
+
+    remaining = (struct rt_tlsf_block *)((rt_uint8_t *)_block_to_ptr(block) + size - TLSF_BLOCK_OVERHEAD);
+    remain_size = _block_size(block) - (size + TLSF_BLOCK_OVERHEAD);
+
+    RT_ASSERT(((rt_ubase_t)_block_to_ptr(remaining) & (TLSF_ALIGN_SIZE - 1)) == 0);
+    RT_ASSERT(remain_size >= TLSF_BLOCK_SIZE_MIN);
+
+    remaining->size = remain_size;
+    _block_set_size(block, size);
+    _block_mark_as_free(remaining);
+
+    return remaining;
+}
+
+/* the block takes the next one, which must be free and out of the free lists */
+static struct rt_tlsf_block *_block_absorb(struct rt_tlsf_block *prev, struct rt_tlsf_block *block)
+{
+    RT_ASSERT(!_block_is_last(prev));
+
+    prev->size += _block_size(block) + TLSF_BLOCK_OVERHEAD;
+    _block_link_next(prev);
+
+    return prev;
+}
+
+static struct rt_tlsf_block *_block_merge_prev(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *prev;
+
+    if (_block_is_prev_free(block))
+    {
+        prev = block->prev_phys;
+        RT_ASSERT(prev != RT_NULL);
+        RT_ASSERT(_block_is_free(prev));
+        _block_remove(tlsf, prev);
+        block = _block_absorb(prev, block);
+    }
+
+    return block;
+}
+
+static struct rt_tlsf_block *_block_merge_next(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = _block_next(block);
+
+    if (_block_is_free(next))
+    {
+        RT_ASSERT(!_block_is_last(block));
+        _block_remove(tlsf, next);
+        block = _block_absorb(block, next);
+    }
+
+    return block;
+}
+
+/* give the end of a free block back to the free lists */
+static void _block_trim_free(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, rt_size_t size)
+{
+    struct rt_tlsf_block *remaining;
+
+    RT_ASSERT(_block_is_free(block));
+    if (_block_can_split(block, size))
+    {
+        remaining = _block_split(block, size);
+        _block_link_next(block);
+        remaining->size |= TLSF_BLOCK_PREV_FREE;
+        _block_insert(tlsf, remaining);
+    }
+}
+
+/* give the end of a used block back to the free lists */
+static void _block_trim_used(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, rt_size_t size)
+{
+    struct rt_tlsf_block *remaining;
+
+    RT_ASSERT(!_block_is_free(block));
+    if (_block_can_split(block, size))
+    {
+        remaining = _block_split(block, size);
+        remaining->size &= ~(rt_size_t)TLSF_BLOCK_PREV_FREE;
+        remaining = _block_merge_next(tlsf, remaining);
+        _block_insert(tlsf, remaining);
+    }
+}
+
+static void *_block_prepare_used(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, rt_size_t size)
+{
+    _block_trim_free(tlsf, block, size);
+    _block_mark_as_used(block);
+
+    tlsf->parent.used += _block_size(block) + TLSF_BLOCK_OVERHEAD;
+    if (tlsf->parent.max < tlsf->parent.used)
+        tlsf->parent.max = tlsf->parent.used;
+    tlsf->alloc_count ++;
+
+    return _block_to_ptr(block);
+}
+
+/**
+ * @brief This function will initialize a TLSF memory object on a memory region. The
+ *        object is placed at the beginning of the region.
+ *
+ * @param name is the name of the TLSF memory object.
+ *
+ * @param begin_addr the beginning address of memory.
+ *
+ * @param size is the size of the memory.
+ *
+ * @return Return a pointer to the memory object. When the return value is RT_NULL, it means the init failed.
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size)
+{
+    struct rt_tlsf *tlsf;
+    rt_ubase_t begin_align, pool_addr, end_addr;
+    int fl, sl;
+
+    begin_align = RT_ALIGN((rt_ubase_t)begin_addr, TLSF_ALIGN_SIZE);
+    pool_addr = RT_ALIGN(begin_align + sizeof(struct rt_tlsf), TLSF_ALIGN_SIZE);
+    end_addr = (rt_ubase_t)begin_addr + size;
+
+    if (end_addr <= pool_addr ||
+        end_addr - pool_addr < TLSF_POOL_OVERHEAD + TLSF_BLOCK_SIZE_MIN)
+    {
+        rt_kprintf("tlsf init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_ubase_t)begin_addr, (rt_ubase_t)begin_addr + size);
+
+        return RT_NULL;
+    }
+
+    tlsf = (struct rt_tlsf *)begin_align;
+    rt_memset(tlsf, 0, sizeof(*tlsf));
+    /* initialize TLSF memory object */
+    rt_object_init(&(tlsf->parent.parent), RT_Object_Class_Memory, name);
+    tlsf->parent.algorithm = "tlsf";
+    tlsf->parent.address = pool_addr;
+
+    tlsf->block_null.next_free = &tlsf->block_null;
+    tlsf->block_null.prev_free = &tlsf->block_null;
+    for (fl = 0; fl < TLSF_FL_COUNT; fl ++)
+    {
+        for (sl = 0; sl < TLSF_SL_COUNT; sl ++)
+        {
+            tlsf->blocks[fl][sl] = &tlsf->block_null;
+        }
+    }
+
+    if (rt_tlsf_add_pool(&tlsf->parent, (void *)pool_addr, end_addr - pool_addr) != RT_EOK)
+    {
+        rt_object_detach(&(tlsf->parent.parent));
+
+        return RT_NULL;
+    }
+
+    return &tlsf->parent;
+}
+RTM_EXPORT(rt_tlsf_init);
+
+/**
+ * @brief This function will add another memory region to a TLSF memory object, e.g. an
+ *        external SDRAM to the internal SRAM. The blocks are allocated from every region.
+ *
+ * @param m the TLSF memory object.
+ *
+ * @param begin_addr the beginning address of memory.
+ *
+ * @param size is the size of the memory. A region larger than the largest block of
+ *        TLSF_FL_INDEX_MAX is cut down to it.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if the region is too small.
+ */
+rt_err_t rt_tlsf_add_pool(rt_tlsf_t m, void *begin_addr, rt_size_t size)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block, *next;
+    rt_ubase_t begin_align, end_align;
+    rt_size_t pool_size;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    tlsf = (struct rt_tlsf *)m;
+    begin_align = RT_ALIGN((rt_ubase_t)begin_addr, TLSF_ALIGN_SIZE);
+    end_align = RT_ALIGN_DOWN((rt_ubase_t)begin_addr + size, TLSF_ALIGN_SIZE);
+    if (end_align <= begin_align + TLSF_POOL_OVERHEAD + TLSF_BLOCK_SIZE_MIN)
+    {
+        return -RT_EINVAL;
+    }
+
+    pool_size = end_align - begin_align - TLSF_POOL_OVERHEAD;
+    if (pool_size >= TLSF_BLOCK_SIZE_MAX)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("tlsf pool of %d bytes cut to %d\n",
+                                    pool_size, TLSF_BLOCK_SIZE_MAX - TLSF_ALIGN_SIZE));
+        pool_size = TLSF_BLOCK_SIZE_MAX - TLSF_ALIGN_SIZE;
+    }
+
+    /*
+     * The pool is one free block followed by a used sentinel of size 0. The prev_phys of
+     * the first block would be before the pool, it is never used as nothing is before it.
+     */
+    block = (struct rt_tlsf_block *)(begin_align - TLSF_BLOCK_OVERHEAD);
+    block->size = pool_size;
+    block->size |= TLSF_BLOCK_FREE;
+    block->size &= ~(rt_size_t)TLSF_BLOCK_PREV_FREE;
+    _block_insert(tlsf, block);
+
+    next = _block_link_next(block);
+    next->size = TLSF_BLOCK_PREV_FREE;
+
+    tlsf->parent.total += pool_size + TLSF_BLOCK_OVERHEAD;
+    tlsf->pool_count ++;
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("tlsf add pool 0x%x, size %d\n", begin_align, pool_size));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_tlsf_add_pool);
+
+/**
+ * @brief This function will remove a TLSF memory object from the system.
+ *
+ * @param m the TLSF memory object.
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_tlsf_detach(rt_tlsf_t m)
+{
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    rt_object_detach(&(m->parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_tlsf_detach);
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes, in a bounded time.
+ *
+ * @param m the TLSF memory object.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+    rt_size_t adjust;
+    int fl, sl;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    tlsf = (struct rt_tlsf *)m;
+    adjust = _adjust_request_size(size);
+    if (adjust == 0)
+    {
+        if (size != 0)
+            tlsf->fail_count ++;
+
+        return RT_NULL;
+    }
+
+    _mapping_search(adjust, &fl, &sl);
+    block = RT_NULL;
+    if (fl < TLSF_FL_COUNT)
+    {
+        block = _search_suitable_block(tlsf, &fl, &sl);
+    }
+    if (block == RT_NULL || block == &tlsf->block_null)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("no memory\n"));
+        tlsf->fail_count ++;
+
+        return RT_NULL;
+    }
+
+    RT_ASSERT(_block_size(block) >= adjust);
+    _remove_free_block(tlsf, block, fl, sl);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("allocate memory at 0x%x, size: %d\n",
+                                (rt_ubase_t)_block_to_ptr(block), adjust));
+
+    return _block_prepare_used(tlsf, block, adjust);
+}
+RTM_EXPORT(rt_tlsf_alloc);
+
+/**
+ * @brief This function will change the size of previously allocated memory block. The
+ *        block grows in place if the next block is free and large enough.
+ *
+ * @param m the TLSF memory object.
+ *
+ * @param rmem is the pointer to memory allocated by rt_tlsf_alloc.
+ *
+ * @param newsize is the required new size.
+ *
+ * @return the changed memory block address.
+ */
+void *rt_tlsf_realloc(rt_tlsf_t m, void *rmem, rt_size_t newsize)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block, *next;
+    rt_size_t cursize, combined, adjust;
+    void *nmem;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    tlsf = (struct rt_tlsf *)m;
+    if (newsize == 0)
+    {
+        rt_tlsf_free(m, rmem);
+        return RT_NULL;
+    }
+
+    /* allocate a new memory block */
+    if (rmem == RT_NULL)
+        return rt_tlsf_alloc(m, newsize);
+
+    block = _block_from_ptr(rmem);
+    RT_ASSERT(!_block_is_free(block));
+
+    next = _block_next(block);
+    cursize = _block_size(block);
+    combined = cursize + _block_size(next) + TLSF_BLOCK_OVERHEAD;
+    adjust = _adjust_request_size(newsize);
+    if (adjust == 0)
+    {
+        tlsf->fail_count ++;
+
+        return RT_NULL;
+    }
+
+    if (adjust > cursize && (!_block_is_free(next) || adjust > combined))
+    {
+        /* expand memory */
+        nmem = rt_tlsf_alloc(m, newsize);
+        if (nmem != RT_NULL)
+        {
+            rt_memcpy(nmem, rmem, cursize < newsize ? cursize : newsize);
+            rt_tlsf_free(m, rmem);
+        }
+
+        return nmem;
+    }
+
+    tlsf->parent.used -= cursize;
+    if (adjust > cursize)
+    {
+        /* take the next free block */
+        _block_merge_next(tlsf, block);
+        _block_mark_as_used(block);
+    }
+    /* give back what is not needed */
+    _block_trim_used(tlsf, block, adjust);
+
+    tlsf->parent.used += _block_size(block);
+    if (tlsf->parent.max < tlsf->parent.used)
+        tlsf->parent.max = tlsf->parent.used;
+
+    return rmem;
+}
+RTM_EXPORT(rt_tlsf_realloc);
+
+/**
+ * @brief This function will release the previously allocated memory block by
+ *        rt_tlsf_alloc, merging it with the free blocks next to it.
+ *
+ * @param m the TLSF memory object.
+ *
+ * @param rmem the address of memory which will be released.
+ */
+void rt_tlsf_free(rt_tlsf_t m, void *rmem)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+
+    if (rmem == RT_NULL)
+        return;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+    RT_ASSERT((((rt_ubase_t)rmem) & (TLSF_ALIGN_SIZE - 1)) == 0);
+
+    tlsf = (struct rt_tlsf *)m;
+    block = _block_from_ptr(rmem);
+    /* the block has to be in a used state */
+    RT_ASSERT(!_block_is_free(block));
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("release memory 0x%x, size: %d\n",
+                                (rt_ubase_t)rmem, _block_size(block)));
+
+    tlsf->parent.used -= _block_size(block) + TLSF_BLOCK_OVERHEAD;
+
+    _block_mark_as_free(block);
+    block = _block_merge_prev(tlsf, block);
+    block = _block_merge_next(tlsf, block);
+    _block_insert(tlsf, block);
+}
+RTM_EXPORT(rt_tlsf_free);
+
+/**
+ * @brief This function will get the statistics of a TLSF memory object.
+ *
+ * @param m the TLSF memory object.
+ *
+ * @param stats the statistics. largest_free is the largest block of the highest non empty
+ *        size class, which is the largest free block within one class.
+ */
+void rt_tlsf_info(rt_tlsf_t m, struct rt_tlsf_stats *stats)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+    int fl, sl;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(stats != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+
+    tlsf = (struct rt_tlsf *)m;
+    stats->total = tlsf->parent.total;
+    stats->used = tlsf->parent.used;
+    stats->max_used = tlsf->parent.max;
+    stats->free_blocks = tlsf->free_blocks;
+    stats->pools = tlsf->pool_count;
+    stats->alloc_count = tlsf->alloc_count;
+    stats->fail_count = tlsf->fail_count;
+    stats->largest_free = 0;
+
+    if (tlsf->fl_bitmap)
+    {
+        fl = _tlsf_fls(tlsf->fl_bitmap);
+        sl = _tlsf_fls(tlsf->sl_bitmap[fl]);
+        for (block = tlsf->blocks[fl][sl]; block != &tlsf->block_null; block = block->next_free)
+        {
+            if (_block_size(block) > stats->largest_free)
+                stats->largest_free = _block_size(block);
+        }
+    }
+}
+RTM_EXPORT(rt_tlsf_info);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+int tlsfinfo(int argc, char **argv)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_object *object;
+    struct rt_tlsf_stats stats;
+    rt_base_t level;
+    char *name;
+
+    name = argc > 1 ? argv[1] : RT_NULL;
+    /* get mem object */
+    information = rt_object_get_information(RT_Object_Class_Memory);
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        /* find the specified object */
+        if (name != RT_NULL && rt_strncmp(name, object->name, RT_NAME_MAX) != 0)
+            continue;
+        /* only the TLSF memory objects */
+        if (rt_strcmp(((rt_mem_t)object)->algorithm, "tlsf") != 0)
+            continue;
+
+        level = rt_hw_interrupt_disable();
+        rt_tlsf_info((rt_tlsf_t)object, &stats);
+        rt_hw_interrupt_enable(level);
+
+        rt_kprintf("\nname        : %.*s\n", RT_NAME_MAX, object->name);
+        rt_kprintf("pools       : %d\n", stats.pools);
+        rt_kprintf("total       : %d\n", stats.total);
+        rt_kprintf("used        : %d\n", stats.used);
+        rt_kprintf("max_used    : %d\n", stats.max_used);
+        rt_kprintf("free blocks : %d\n", stats.free_blocks);
+        rt_kprintf("largest free: %d\n", stats.largest_free);
+        rt_kprintf("allocated   : %d, failed: %d\n", stats.alloc_count, stats.fail_count);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(tlsfinfo, show the TLSF memory heap statistics);
+#endif /* RT_USING_FINSH */
+
+/**@}*/
+
+#endif /* defined (RT_USING_TLSF) */
@@ -0,0 +1,111 @@
+#
+# Copyright (c) 2006-2022, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-16     RT-Thread    the first version
+#
+
+"""
+Symbolize the report of the msh command memprof.
+
+Save the console output of memprof to a file, then:
+
+    python memprof.py memprof.log rtthread.elf
+    python memprof.py memprof.log rtthread.elf --addr2line arm-none-eabi-addr2line
+
+Each call site is printed with its function and source line. With a sample period of N,
+the counts are those of one allocation in N, the estimated totals are N times larger.
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+HEADER = re.compile(r'memprof: (\d+) s, sample 1/(\d+), (\d+) sites')
+SITE = re.compile(r'^0x([0-9a-fA-F]+)((?:\s+\d+)+)\s*$')
+COLUMNS = ['allocs', 'frees', 'fails', 'live', 'live_bytes', 'peak_bytes', 'pinned_bytes',
+           'oldest', 'alloc_min', '<10ms', '<100ms', '<1s', '<10s', '<1m', '<10m', '<1h', '>=1h']
+
+
+def parse(lines):
+    """Return the sample period, the uptime and the call sites of the last report."""
+    period, seconds, sites = 1, 0, []
+    for line in lines:
+        line = line.strip()
+        match = HEADER.search(line)
+        if match:
+            seconds, period = int(match.group(1)), int(match.group(2))
+            sites = []
+            continue
+        match = SITE.match(line)
+        if match:
+            values = [int(v) for v in match.group(2).split()]
+            if len(values) != len(COLUMNS):
+                continue
+            site = dict(zip(COLUMNS, values))
+            site['address'] = int(match.group(1), 16)
+            sites.append(site)
+    return period, seconds, sites
+
+
+def symbolize(addresses, elf, addr2line):
+    """Map each return address to 'function file:line' of its call instruction."""
+    names = {}
+    # a return address is the instruction after the call, and has bit 0 set in Thumb code
+    calls = [(address & ~1) - 1 if address > 1 else 0 for address in addresses]
+    try:
+        output = subprocess.check_output([addr2line, '-f', '-C', '-e', elf] +
+                                         ['0x%x' % call for call in calls])
+    except (OSError, subprocess.CalledProcessError) as error:
+        sys.stderr.write('%s: %s\n' % (addr2line, error))
+        return names
+    lines = output.decode(errors='replace').splitlines()
+    for index, address in enumerate(addresses):
+        if address == 0:
+            names[address] = '(other call sites)'
+            continue
+        function, location = lines[2 * index], lines[2 * index + 1]
+        names[address] = '%s %s' % (function, location.split('/')[-1])
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Symbolize the report of memprof.')
+    parser.add_argument('report', type=argparse.FileType('r'), help='console output of memprof')
+    parser.add_argument('elf', help='ELF file of the firmware')
+    parser.add_argument('--addr2line', default='arm-none-eabi-addr2line', help='addr2line of the toolchain')
+    args = parser.parse_args()
+
+    period, seconds, sites = parse(args.report)
+    if not sites:
+        sys.stderr.write('no memprof report in %s\n' % args.report.name)
+        return 1
+
+    names = symbolize([site['address'] for site in sites], args.elf, args.addr2line)
+    print('%d s, sample 1/%d, %d call sites' % (seconds, period, len(sites)))
+    print('%10s %8s %6s %9s %9s %9s %8s  %s' % ('allocs', 'live', 'fails', 'live B', 'peak B',
+                                               'pinned B', 'oldest s', 'call site'))
+    for site in sites:
+        print('%10d %8d %6d %9d %9d %9d %8d  %s' % (
+            site['allocs'] * period, site['live'] * period, site['fails'],
+            site['live_bytes'] * period, site['peak_bytes'] * period, site['pinned_bytes'] * period,
+            site['oldest'], names.get(site['address'], '0x%08x' % site['address'])))
+
+    print('\nlifetime of the freed blocks, %:')
+    print('%6s %6s %6s %6s %6s %6s %6s %6s  %s' % tuple(COLUMNS[9:] + ['call site']))
+    for site in sites:
+        freed = sum(site[column] for column in COLUMNS[9:])
+        if freed == 0:
+            continue
+        print('%6d %6d %6d %6d %6d %6d %6d %6d  %s' % tuple(
+            [site[column] * 100 // freed for column in COLUMNS[9:]] +
+            [names.get(site['address'], '0x%08x' % site['address'])]))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -19,6 +19,8 @@
 #define RT_USING_TIMER_SOFT
 #define RT_TIMER_THREAD_PRIO 4
 #define RT_TIMER_THREAD_STACK_SIZE 512
+#define RT_USING_OBJECT_HASH
+#define RT_OBJECT_HASH_SIZE 16
 
 /* kservice optimization */
 
@@ -38,10 +40,10 @@
 /* Memory Management */
 
 #define RT_USING_MEMPOOL
+#define RT_USING_TLSF
 #define RT_USING_MEMHEAP
 #define RT_MEMHEAP_FAST_MODE
-#define RT_USING_MEMHEAP_AS_HEAP
-#define RT_USING_MEMHEAP_AUTO_BINDING
+#define RT_USING_TLSF_AS_HEAP
 #define RT_USING_HEAP
 /* end of Memory Management */
 
@@ -86,6 +88,12 @@
 #define DFS_FD_MAX 16
 #define RT_USING_DFS_DEVFS
 #define RT_USING_DFS_ROMFS
+#define RT_USING_FAL
+#define FAL_DEBUG_CONFIG
+#define FAL_DEBUG 1
+#define FAL_PART_HAS_TABLE_CFG
+#define FAL_USING_SFUD_PORT
+#define FAL_USING_NOR_FLASH_DEV_NAME "norflash0"
 
 /* Device Drivers */
 
@@ -144,6 +152,14 @@
 #define SAL_USING_AT
 /* end of protocol stack implement */
 #define SAL_USING_POSIX
+#define SAL_USING_EPOLL
+#define SAL_USING_NETDB_CACHE
+#define SAL_NETDB_CACHE_NUM 8
+#define SAL_NETDB_CACHE_TTL 300
+#define SAL_NETDB_CACHE_NEG_TTL 10
+#define SAL_USING_NETBUF
+#define SAL_NETBUF_BLOCK_SIZE 512
+#define SAL_NETBUF_BLOCK_NUM 8
 #define RT_USING_NETDEV
 #define NETDEV_USING_IFCONFIG
 #define NETDEV_USING_PING
@@ -404,6 +420,8 @@
 /* Onboard Peripheral */
 
 #define BSP_USING_USB_TO_USART
+#define BSP_USING_SPI_FLASH
+#define BSP_USING_PV_TELEMETRY_FLASH
 /* end of Onboard Peripheral */
 
 /* On-chip Peripheral */
@@ -411,9 +429,13 @@
 #define BSP_USING_GPIO
 #define BSP_USING_ADC
 #define BSP_USING_ADC1
+#define BSP_ADC1_USING_DMA
+#define BSP_ADC_USING_DMA
 #define BSP_USING_UART
 #define BSP_USING_UART1
 #define BSP_USING_UART4
+#define BSP_USING_SPI
+#define BSP_USING_SPI1
 /* end of On-chip Peripheral */
 /* end of Hardware Drivers Config */
 